@@ -0,0 +1,412 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents an area that needs to be redrawn as a small set of disjoint Rectangles.
+
+#ifndef GTYPES_DIRTY_REGION_H
+#define GTYPES_DIRTY_REGION_H
+
+#include <vector>
+
+#include "gtypesExport.h"
+#include "Rectangle.h"
+
+namespace gtypes
+{
+	/// @brief Represents an area that needs to be redrawn as a small set of disjoint Rectangles.
+	/// @note An added Rectangle is merged with the existing ones if their bounding box covers no more than the merge area
+	/// outside of them, e.g. when they overlap a lot or share an edge. Otherwise the existing Rectangles are cut away from it
+	/// so that nothing is redrawn twice.
+	/// @note When there are more Rectangles than the maximum, the two whose bounding box wastes the least area are merged
+	/// until the count fits again. Every Rectangle that the bounding box overlaps is merged as well.
+	/// @note Uses the same test as Rectangle::intersects(), Rectangles that only touch stay separate unless they can be
+	/// merged without waste.
+	template <typename T>
+	class DirtyRegion
+	{
+	public:
+		/// @brief Constructor.
+		/// @param[in] maxCount Maximum number of Rectangles, at least 1.
+		/// @param[in] mergeArea Area outside of the Rectangles that a merge may cover, e.g. the cost of one more draw call.
+		inline DirtyRegion(int maxCount = 16, double mergeArea = 0.0) :
+			bounded(false),
+			maxCount(maxCount > 1 ? maxCount : 1),
+			mergeArea(mergeArea)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] bounds Added Rectangles are clipped to this area, e.g. the screen.
+		/// @param[in] maxCount Maximum number of Rectangles, at least 1.
+		/// @param[in] mergeArea Area outside of the Rectangles that a merge may cover, e.g. the cost of one more draw call.
+		inline DirtyRegion(const Rectangle<T>& bounds, int maxCount = 16, double mergeArea = 0.0) :
+			bounds(bounds),
+			bounded(true),
+			maxCount(maxCount > 1 ? maxCount : 1),
+			mergeArea(mergeArea)
+		{
+		}
+
+		/// @return The area added Rectangles are clipped to.
+		inline const Rectangle<T>& getBounds() const { return this->bounds; }
+		/// @return True if added Rectangles are clipped.
+		inline bool isBounded() const { return this->bounded; }
+		/// @return The maximum number of Rectangles.
+		inline int getMaxCount() const { return this->maxCount; }
+		/// @return The area outside of the Rectangles that a merge may cover.
+		inline double getMergeArea() const { return this->mergeArea; }
+		/// @brief Sets the area outside of the Rectangles that a merge may cover.
+		/// @param[in] value The new value.
+		/// @note Only affects later additions.
+		inline void setMergeArea(double value) { this->mergeArea = value; }
+		/// @return The number of Rectangles.
+		inline int getCount() const { return (int)this->rectangles.size(); }
+		/// @return True if there is nothing to redraw.
+		inline bool isEmpty() const { return (this->rectangles.size() == 0); }
+		/// @return The disjoint Rectangles to redraw in no particular order.
+		inline const std::vector<Rectangle<T> >& getRectangles() const { return this->rectangles; }
+		/// @return The area to redraw.
+		inline double getArea() const
+		{
+			double result = 0.0;
+			for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+			{
+				result += (double)this->rectangles[i].w * this->rectangles[i].h;
+			}
+			return result;
+		}
+		/// @return The bounding box of all Rectangles, an empty Rectangle if there are none.
+		inline Rectangle<T> getExtent() const
+		{
+			if (this->rectangles.size() == 0)
+			{
+				return Rectangle<T>();
+			}
+			Rectangle<T> result = this->rectangles[0];
+			for (unsigned int i = 1; i < this->rectangles.size(); ++i)
+			{
+				result = _unite(result, this->rectangles[i]);
+			}
+			return result;
+		}
+
+		/// @brief Sets the area added Rectangles are clipped to and clips the existing ones.
+		/// @param[in] value The new area.
+		inline void setBounds(const Rectangle<T>& value)
+		{
+			this->bounds = value;
+			this->bounded = true;
+			int size = 0;
+			for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+			{
+				this->rectangles[size] = this->rectangles[i];
+				this->rectangles[size].clip(value);
+				if (this->rectangles[size].w > 0 && this->rectangles[size].h > 0)
+				{
+					++size;
+				}
+			}
+			this->rectangles.resize(size);
+		}
+		/// @brief Sets the maximum number of Rectangles and merges Rectangles until they fit.
+		/// @param[in] value The new maximum, at least 1.
+		inline void setMaxCount(int value)
+		{
+			this->maxCount = (value > 1 ? value : 1);
+			this->_reduce();
+		}
+		/// @brief Removes all Rectangles, e.g. after the redraw.
+		/// @note Keeps the allocated memory.
+		inline void clear()
+		{
+			this->rectangles.clear();
+		}
+
+		/// @brief Adds an area that needs to be redrawn.
+		/// @param[in] rectangle The Rectangle.
+		/// @return True if the region changed, false if the Rectangle was empty or inside one of the Rectangles.
+		inline bool add(const Rectangle<T>& rectangle)
+		{
+			Rectangle<T> clipped = rectangle;
+			if (this->bounded)
+			{
+				clipped.clip(this->bounds);
+			}
+			if (clipped.w <= 0 || clipped.h <= 0)
+			{
+				return false;
+			}
+			for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+			{
+				if (this->rectangles[i].contains(clipped))
+				{
+					return false;
+				}
+			}
+			this->_insert(clipped);
+			this->_reduce();
+			return true;
+		}
+		/// @brief Adds areas that need to be redrawn.
+		/// @param[in] rectangles The Rectangles.
+		/// @param[in] count Number of Rectangles.
+		/// @return True if the region changed.
+		inline bool add(const Rectangle<T>* rectangles, int count)
+		{
+			bool result = false;
+			for (int i = 0; i < count; ++i)
+			{
+				result |= this->add(rectangles[i]);
+			}
+			return result;
+		}
+		/// @brief Checks whether an area needs to be redrawn.
+		/// @param[in] rectangle The Rectangle.
+		/// @return True if the Rectangle intersects the region.
+		inline bool isDirty(const Rectangle<T>& rectangle) const
+		{
+			for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+			{
+				if (this->rectangles[i].intersects(rectangle))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+	protected:
+		/// @brief The area added Rectangles are clipped to.
+		Rectangle<T> bounds;
+		/// @brief Whether added Rectangles are clipped.
+		bool bounded;
+		/// @brief Maximum number of Rectangles.
+		int maxCount;
+		/// @brief Area outside of the Rectangles that a merge may cover.
+		double mergeArea;
+		/// @brief The disjoint Rectangles.
+		std::vector<Rectangle<T> > rectangles;
+
+		/// @brief Adds a Rectangle that is not covered by a single existing one and keeps the Rectangles disjoint.
+		/// @param[in] rectangle The Rectangle.
+		inline void _insert(const Rectangle<T>& rectangle)
+		{
+			Rectangle<T> current = rectangle;
+			Rectangle<T> box;
+			Rectangle<T> bestBox;
+			double waste = 0.0;
+			double bestWaste = 0.0;
+			bool found = true;
+			while (found)
+			{
+				found = false;
+				for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+				{
+					waste = this->_calcMergeWaste(current, i, box);
+					if (waste <= this->mergeArea && (!found || waste < bestWaste))
+					{
+						found = true;
+						bestWaste = waste;
+						bestBox = box;
+					}
+				}
+				if (found)
+				{
+					// the box already contains everything it overlaps
+					current = bestBox;
+					this->_removeIntersecting(current);
+				}
+			}
+			// whatever could not be merged is cut away so that nothing is redrawn twice
+			std::vector<Rectangle<T> > pieces(1, current);
+			std::vector<Rectangle<T> > cut;
+			for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+			{
+				if (!this->rectangles[i].intersects(current))
+				{
+					continue;
+				}
+				cut.clear();
+				for (unsigned int j = 0; j < pieces.size(); ++j)
+				{
+					_subtract(pieces[j], this->rectangles[i], cut);
+				}
+				pieces.swap(cut);
+			}
+			if (pieces.size() == 1 && pieces[0] == current)
+			{
+				this->rectangles.push_back(current);
+				return;
+			}
+			// pieces can still be merged with their neighbors, e.g. along a shared edge
+			for (unsigned int i = 0; i < pieces.size(); ++i)
+			{
+				this->_insert(pieces[i]);
+			}
+		}
+		/// @brief Merges the cheapest Rectangles until there are no more than the maximum.
+		inline void _reduce()
+		{
+			Rectangle<T> box;
+			Rectangle<T> bestBox;
+			double waste = 0.0;
+			double bestWaste = 0.0;
+			while ((int)this->rectangles.size() > this->maxCount)
+			{
+				bestWaste = -1.0;
+				for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+				{
+					for (unsigned int j = i + 1; j < this->rectangles.size(); ++j)
+					{
+						waste = this->_calcMergeWaste(this->rectangles[i], j, box);
+						if (bestWaste < 0.0 || waste < bestWaste)
+						{
+							bestWaste = waste;
+							bestBox = box;
+						}
+					}
+				}
+				this->_removeIntersecting(bestBox);
+				this->rectangles.push_back(bestBox);
+			}
+		}
+		/// @brief Calculates the bounding box of a Rectangle and an existing one, grown until it contains every existing
+		/// Rectangle it overlaps.
+		/// @param[in] rectangle The Rectangle, may be one of the existing ones.
+		/// @param[in] index Index of the existing Rectangle.
+		/// @param[out] result Receives the bounding box.
+		/// @return The area of the bounding box that is not covered by the Rectangles it contains.
+		inline double _calcMergeWaste(const Rectangle<T>& rectangle, unsigned int index, Rectangle<T>& result) const
+		{
+			const Rectangle<T>& other = this->rectangles[index];
+			result = _unite(rectangle, other);
+			bool grown = true;
+			while (grown)
+			{
+				grown = false;
+				for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+				{
+					if (this->rectangles[i].intersects(result) && !result.contains(this->rectangles[i]))
+					{
+						result = _unite(result, this->rectangles[i]);
+						grown = true;
+					}
+				}
+			}
+			// Rectangles in a row or column with a shared or overlapping edge merge exactly, floats would round otherwise
+			bool alignedX = (rectangle.x == other.x && rectangle.w == other.w && rectangle.y <= other.bottom() && other.y <= rectangle.bottom());
+			bool alignedY = (rectangle.y == other.y && rectangle.h == other.h && rectangle.x <= other.right() && other.x <= rectangle.right());
+			// the existing Rectangles are disjoint, so only their overlaps with the new one are counted twice
+			double covered = (double)rectangle.w * rectangle.h;
+			int otherCount = 0;
+			for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+			{
+				if (result.intersects(this->rectangles[i]))
+				{
+					covered += (double)this->rectangles[i].w * this->rectangles[i].h - _calcOverlap(rectangle, this->rectangles[i]);
+					if (i != index && this->rectangles[i] != rectangle)
+					{
+						++otherCount;
+					}
+				}
+			}
+			if ((alignedX || alignedY) && otherCount == 0)
+			{
+				return 0.0;
+			}
+			double waste = (double)result.w * result.h - covered;
+			return (waste > 0.0 ? waste : 0.0);
+		}
+		/// @brief Removes all Rectangles that intersect a Rectangle.
+		/// @param[in] rectangle The Rectangle.
+		inline void _removeIntersecting(const Rectangle<T>& rectangle)
+		{
+			int size = 0;
+			for (unsigned int i = 0; i < this->rectangles.size(); ++i)
+			{
+				if (!this->rectangles[i].intersects(rectangle))
+				{
+					this->rectangles[size] = this->rectangles[i];
+					++size;
+				}
+			}
+			this->rectangles.resize(size);
+		}
+		/// @brief Calculates the bounding box of two Rectangles.
+		/// @param[in] a The first Rectangle.
+		/// @param[in] b The second Rectangle.
+		/// @return The bounding box.
+		inline static Rectangle<T> _unite(const Rectangle<T>& a, const Rectangle<T>& b)
+		{
+			T left = (a.x < b.x ? a.x : b.x);
+			T top = (a.y < b.y ? a.y : b.y);
+			T right = (a.right() > b.right() ? a.right() : b.right());
+			T bottom = (a.bottom() > b.bottom() ? a.bottom() : b.bottom());
+			return Rectangle<T>(left, top, right - left, bottom - top);
+		}
+		/// @brief Calculates the overlapping area of two Rectangles.
+		/// @param[in] a The first Rectangle.
+		/// @param[in] b The second Rectangle.
+		/// @return The overlapping area, 0 if they do not intersect.
+		inline static double _calcOverlap(const Rectangle<T>& a, const Rectangle<T>& b)
+		{
+			if (!a.intersects(b))
+			{
+				return 0.0;
+			}
+			Rectangle<T> overlap = a.clipped(b);
+			return (double)overlap.w * overlap.h;
+		}
+		/// @brief Cuts a Rectangle out of another one.
+		/// @param[in] rectangle The Rectangle to cut.
+		/// @param[in] cutter The Rectangle to cut out.
+		/// @param[out] result Receives up to 4 disjoint pieces, the bands above and below span the whole width.
+		inline static void _subtract(const Rectangle<T>& rectangle, const Rectangle<T>& cutter, std::vector<Rectangle<T> >& result)
+		{
+			if (!rectangle.intersects(cutter))
+			{
+				result.push_back(rectangle);
+				return;
+			}
+			T top = rectangle.y;
+			T bottom = rectangle.bottom();
+			if (cutter.y > top)
+			{
+				result.push_back(Rectangle<T>(rectangle.x, top, rectangle.w, cutter.y - top));
+				top = cutter.y;
+			}
+			if (cutter.bottom() < bottom)
+			{
+				result.push_back(Rectangle<T>(rectangle.x, cutter.bottom(), rectangle.w, bottom - cutter.bottom()));
+				bottom = cutter.bottom();
+			}
+			if (cutter.x > rectangle.x)
+			{
+				result.push_back(Rectangle<T>(rectangle.x, top, cutter.x - rectangle.x, bottom - top));
+			}
+			if (cutter.right() < rectangle.right())
+			{
+				result.push_back(Rectangle<T>(cutter.right(), top, rectangle.right() - cutter.right(), bottom - top));
+			}
+		}
+
+	};
+
+}
+
+/// @brief Typedef for simpler code.
+typedef gtypes::DirtyRegion<int> gdirtyregioni;
+/// @brief Typedef for simpler code.
+typedef const gtypes::DirtyRegion<int>& cgdirtyregioni;
+/// @brief Typedef for simpler code.
+typedef gtypes::DirtyRegion<float> gdirtyregionf;
+/// @brief Typedef for simpler code.
+typedef const gtypes::DirtyRegion<float>& cgdirtyregionf;
+
+#endif
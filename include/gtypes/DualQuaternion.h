@@ -0,0 +1,240 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents a dual quaternion for rigid transformations.
+
+#ifndef GTYPES_DUAL_QUATERNION_H
+#define GTYPES_DUAL_QUATERNION_H
+
+#include "gtypesExport.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+namespace gtypes
+{
+	class Matrix4;
+
+	/// @brief Represents a dual quaternion for rigid transformations, a rotation followed by a translation.
+	/// @note A unit DualQuaternion needs 32 bytes instead of the 48 bytes of a 4x3 matrix and blends without the volume
+	/// loss of linear blend skinning (candy-wrapper artifacts).
+	class gtypesExport DualQuaternion
+	{
+	public:
+		/// @brief Real part, the rotation.
+		Quaternion real;
+		/// @brief Dual part, half of the translation multiplied with the rotation.
+		Quaternion dual;
+
+		/// @brief Basic constructor, creates the identity transformation.
+		inline DualQuaternion() :
+			real(0.0f, 0.0f, 0.0f, 1.0f),
+			dual(0.0f, 0.0f, 0.0f, 0.0f)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] real Real part.
+		/// @param[in] dual Dual part.
+		inline DualQuaternion(const Quaternion& real, const Quaternion& dual) :
+			real(real),
+			dual(dual)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] rotation The unit Quaternion rotation.
+		/// @param[in] translation The Vector3 translation applied after the rotation.
+		inline DualQuaternion(const Quaternion& rotation, const Vector3<float>& translation) :
+			real(rotation),
+			dual(Quaternion(translation * 0.5f, 0.0f) * rotation)
+		{
+		}
+		/// @brief Sets the values of the DualQuaternion.
+		/// @param[in] real Real part.
+		/// @param[in] dual Dual part.
+		inline void set(const Quaternion& real, const Quaternion& dual)
+		{
+			this->real = real;
+			this->dual = dual;
+		}
+		/// @brief Sets the values of the DualQuaternion.
+		/// @param[in] rotation The unit Quaternion rotation.
+		/// @param[in] translation The Vector3 translation applied after the rotation.
+		inline void set(const Quaternion& rotation, const Vector3<float>& translation)
+		{
+			this->real = rotation;
+			this->dual = Quaternion(translation * 0.5f, 0.0f) * rotation;
+		}
+
+		/// @return The rotation of the unit DualQuaternion.
+		inline Quaternion rotation() const
+		{
+			return this->real;
+		}
+		/// @return Calculates the translation of the unit DualQuaternion.
+		/// @note Calculates 2 * dual * real^-1 without the full Quaternion product.
+		inline Vector3<float> translation() const
+		{
+			return Vector3<float>(2.0f * (this->real.w * this->dual.x - this->dual.w * this->real.x + (this->real.y * this->dual.z - this->real.z * this->dual.y)),
+				2.0f * (this->real.w * this->dual.y - this->dual.w * this->real.y + (this->real.z * this->dual.x - this->real.x * this->dual.z)),
+				2.0f * (this->real.w * this->dual.z - this->dual.w * this->real.z + (this->real.x * this->dual.y - this->real.y * this->dual.x)));
+		}
+
+		/// @brief Normalizes the current DualQuaternion.
+		/// @note Both parts are divided by the length of the real part and the dual part is made orthogonal to the real part.
+		inline void normalize()
+		{
+			float length = this->real.length();
+			if (length != 0.0f)
+			{
+				float inverse = 1.0f / length;
+				this->real *= inverse;
+				this->dual *= inverse;
+				this->dual -= this->real * this->real.dot(this->dual);
+			}
+		}
+		/// @brief Creates a normalized DualQuaternion from this DualQuaternion.
+		/// @return The normalized DualQuaternion.
+		inline DualQuaternion normalized() const
+		{
+			DualQuaternion result(*this);
+			result.normalize();
+			return result;
+		}
+		/// @brief Inverses the current unit DualQuaternion.
+		/// @note The inverse of a unit DualQuaternion is its Quaternion conjugate.
+		inline void inverse()
+		{
+			this->real.conjugate();
+			this->dual.conjugate();
+		}
+		/// @brief Creates an inversed DualQuaternion from this unit DualQuaternion.
+		/// @return The inversed DualQuaternion.
+		inline DualQuaternion inversed() const
+		{
+			DualQuaternion result(*this);
+			result.inverse();
+			return result;
+		}
+		/// @brief Transforms a point with this unit DualQuaternion.
+		/// @param[in] point The Vector3 point.
+		/// @return The rotated and translated Vector3.
+		inline Vector3<float> transformPoint(const Vector3<float>& point) const
+		{
+			return (this->real.rotate(point) + this->translation());
+		}
+		/// @brief Transforms a direction or normal with this unit DualQuaternion.
+		/// @param[in] normal The Vector3 normal.
+		/// @return The rotated Vector3, the translation does not apply.
+		inline Vector3<float> transformNormal(const Vector3<float>& normal) const
+		{
+			return this->real.rotate(normal);
+		}
+		/// @brief Skins vertices with dual quaternion blending (DLB) of their bone influences.
+		/// @param[in] bones The unit DualQuaternions of the bones.
+		/// @param[in] boneIndices The bone indices, influenceCount consecutive entries for every vertex.
+		/// @param[in] boneWeights The bone weights, influenceCount consecutive entries for every vertex.
+		/// @param[in] influenceCount Number of bone influences of every vertex.
+		/// @param[in] positions The Vector3 positions.
+		/// @param[in] normals The Vector3 normals, can be NULL.
+		/// @param[out] resultPositions Receives the transformed positions, may be the same array as positions.
+		/// @param[out] resultNormals Receives the transformed normals, may be the same array as normals, ignored if normals is NULL.
+		/// @param[in] count Number of vertices.
+		/// @note Every vertex blends its bones like blend() and transforms its position and normal with the result.
+		/// @note Normalizes with the fast reciprocal square root like Quaternion::normalizeFast(), the weights do not need to add
+		/// up to 1. Vertices with a total weight of 0 stay unchanged.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		static void skin(const DualQuaternion* bones, const int* boneIndices, const float* boneWeights, int influenceCount,
+			const Vector3<float>* positions, const Vector3<float>* normals, Vector3<float>* resultPositions, Vector3<float>* resultNormals, int count);
+
+		/// @brief Creates a Matrix4 from this unit DualQuaternion.
+		/// @return The Matrix4.
+		/// @note mat4() * point is the same as transformPoint(point). This differs from Quaternion::mat4(), which holds the
+		/// transposed rotation.
+		Matrix4 mat4() const;
+
+		/// @brief Combines two DualQuaternions.
+		/// @param[in] other The other DualQuaternion.
+		/// @return The DualQuaternion that applies other first and then this DualQuaternion.
+		inline DualQuaternion operator*(const DualQuaternion& other) const
+		{
+			return DualQuaternion(this->real * other.real, this->real * other.dual + this->dual * other.real);
+		}
+		/// @brief Multiplies both parts with a factor.
+		/// @param[in] factor The factor.
+		/// @return The resulting DualQuaternion.
+		inline DualQuaternion operator*(float factor) const
+		{
+			return DualQuaternion(this->real * factor, this->dual * factor);
+		}
+		/// @brief Adds two DualQuaternions.
+		/// @param[in] other The other DualQuaternion.
+		/// @return The resulting DualQuaternion.
+		inline DualQuaternion operator+(const DualQuaternion& other) const
+		{
+			return DualQuaternion(this->real + other.real, this->dual + other.dual);
+		}
+		/// @brief Combines this DualQuaternion with another one.
+		/// @param[in] other The other DualQuaternion, applied first.
+		/// @return A copy of this DualQuaternion.
+		inline DualQuaternion operator*=(const DualQuaternion& other)
+		{
+			(*this) = (*this) * other;
+			return (*this);
+		}
+		/// @brief Checks if two DualQuaternions are equal.
+		/// @param[in] other The other DualQuaternion.
+		/// @return True if the two DualQuaternions are equal.
+		/// @note Beware of floating point errors.
+		inline bool operator==(const DualQuaternion& other) const
+		{
+			return (this->real == other.real && this->dual == other.dual);
+		}
+		/// @brief Checks if two DualQuaternions are not equal.
+		/// @param[in] other The other DualQuaternion.
+		/// @return True if the two DualQuaternions are not equal.
+		/// @note Beware of floating point errors.
+		inline bool operator!=(const DualQuaternion& other) const
+		{
+			return !(*this == other);
+		}
+
+		/// @brief Blends two unit DualQuaternions.
+		/// @param[in] a First unit DualQuaternion.
+		/// @param[in] b Second unit DualQuaternion.
+		/// @param[in] factor The blend factor from 0 to 1.
+		/// @return The normalized blend.
+		/// @note b is negated if the rotations are on opposite hemispheres so the blend takes the shorter path.
+		inline static DualQuaternion blend(const DualQuaternion& a, const DualQuaternion& b, float factor)
+		{
+			float weight = (a.real.dot(b.real) < 0.0f ? -factor : factor);
+			return (a * (1.0f - factor) + b * weight).normalized();
+		}
+		/// @brief Blends unit DualQuaternions with weights (dual quaternion linear blending).
+		/// @param[in] dualQuaternions The unit DualQuaternions.
+		/// @param[in] weights The weight of every DualQuaternion, they do not need to add up to 1.
+		/// @param[in] count Number of DualQuaternions.
+		/// @return The normalized blend, the identity if count is 0.
+		/// @note DualQuaternions on the opposite hemisphere of the first one are negated.
+		static DualQuaternion blend(const DualQuaternion* dualQuaternions, const float* weights, int count);
+		/// @brief Creates a DualQuaternion from a rigid transformation Matrix4.
+		/// @param[in] matrix The Matrix4 without scale or shear.
+		/// @return The DualQuaternion.
+		/// @note Inverse of mat4().
+		static DualQuaternion fromMatrix(const Matrix4& matrix);
+
+	};
+
+}
+
+/// @brief Alias for simpler code.
+typedef gtypes::DualQuaternion gdualquat;
+/// @brief Alias for simpler code.
+typedef const gtypes::DualQuaternion& cgdualquat;
+
+#endif
@@ -0,0 +1,680 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides opt-in expression templates for component-wise vector arithmetic on single values and arrays.
+
+#ifndef GTYPES_EXPRESSION_H
+#define GTYPES_EXPRESSION_H
+
+#include "gtypesExport.h"
+#include "Quaternion.h"
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+namespace gtypes
+{
+	/// @brief Describes a type that can be used in expressions.
+	/// @note Specializations define ComponentType, Dimensions and whether component-wise multiplication and division are valid.
+	template <typename V>
+	struct ExpressionTraits;
+
+	template <typename T>
+	struct ExpressionTraits<Vector2<T> >
+	{
+		typedef T ComponentType;
+		enum { Dimensions = 2, ComponentWise = 1 };
+	};
+
+	template <typename T>
+	struct ExpressionTraits<Vector3<T> >
+	{
+		typedef T ComponentType;
+		enum { Dimensions = 3, ComponentWise = 1 };
+	};
+
+	template <typename T>
+	struct ExpressionTraits<Vector4<T> >
+	{
+		typedef T ComponentType;
+		enum { Dimensions = 4, ComponentWise = 1 };
+	};
+
+	/// @note Quaternions only support addition, subtraction, negation and scaling since their product is not component-wise.
+	template <>
+	struct ExpressionTraits<Quaternion>
+	{
+		typedef float ComponentType;
+		enum { Dimensions = 4, ComponentWise = 0 };
+	};
+
+	template <typename V>
+	struct ExpressionTraits<const V> : public ExpressionTraits<V>
+	{
+	};
+
+	/// @brief Base class of all expressions.
+	/// @note Every expression E provides VectorType, ComponentType, Dimensions, IsScalar, get(index, component) and size().
+	/// @note size() returns -1 for expressions that don't depend on an array index, e.g. single values and scalars.
+	template <typename E>
+	class Expression
+	{
+	public:
+		/// @brief Gets the actual expression.
+		/// @return The actual expression.
+		inline const E& self() const { return static_cast<const E&>(*this); }
+
+	};
+
+	/// @brief Combines the sizes of two expression terms.
+	/// @param[in] first Size of the first term.
+	/// @param[in] second Size of the second term.
+	/// @return The smaller size, ignoring terms that don't depend on an array index.
+	inline int _expressionSize(int first, int second)
+	{
+		if (first < 0)
+		{
+			return second;
+		}
+		if (second < 0 || first < second)
+		{
+			return first;
+		}
+		return second;
+	}
+
+	/// @brief Tells whether two expressions have the same number of components. Scalars match any expression.
+	template <typename L, typename R>
+	struct _ExpressionDimensionsMatch
+	{
+		enum { Value = (L::IsScalar || R::IsScalar || (int)L::Dimensions == (int)R::Dimensions) };
+	};
+
+	/// @brief Fails to compile if expressions with different numbers of components are combined or assigned.
+	template <bool Matching>
+	struct _ExpressionDimensionsCheck;
+
+	template <>
+	struct _ExpressionDimensionsCheck<true>
+	{
+		static inline void check() { }
+	};
+
+	/// @brief Evaluates an expression that doesn't depend on an array index into a single value.
+	/// @param[in] expression The expression.
+	/// @return The resulting value.
+	template <typename E>
+	inline typename E::VectorType evaluate(const Expression<E>& expression)
+	{
+		typename E::VectorType result;
+		typename E::ComponentType* data = (typename E::ComponentType*)&result.x;
+		for (int c = 0; c < E::Dimensions; ++c)
+		{
+			data[c] = expression.self().get(0, c);
+		}
+		return result;
+	}
+
+	/// @brief Expression term with a single value.
+	/// @note The value is copied so that the term can safely outlive a temporary it was created from.
+	template <typename V>
+	class ExpressionValue : public Expression<ExpressionValue<V> >
+	{
+	public:
+		typedef V VectorType;
+		typedef typename ExpressionTraits<V>::ComponentType ComponentType;
+		enum { Dimensions = ExpressionTraits<V>::Dimensions, IsScalar = 0 };
+
+		/// @brief Constructor.
+		/// @param[in] value The value.
+		inline ExpressionValue(const V& value) : value(value) { }
+
+		/// @brief Gets a component.
+		/// @param[in] index Ignored.
+		/// @param[in] component The component index.
+		inline ComponentType get(int /*index*/, int component) const { return (&this->value.x)[component]; }
+		/// @brief Gets the size of the expression.
+		inline int size() const { return -1; }
+		/// @brief Evaluates this expression.
+		inline operator V() const { return evaluate(*this); }
+
+	protected:
+		/// @brief The value.
+		V value;
+
+	};
+
+	/// @brief Expression term with a scalar that is broadcast to all components.
+	template <typename T>
+	class ExpressionScalar : public Expression<ExpressionScalar<T> >
+	{
+	public:
+		typedef void VectorType;
+		typedef T ComponentType;
+		enum { Dimensions = 1, IsScalar = 1 };
+
+		/// @brief Constructor.
+		/// @param[in] value The scalar.
+		inline ExpressionScalar(T value) : value(value) { }
+
+		/// @brief Gets the scalar.
+		/// @param[in] index Ignored.
+		/// @param[in] component Ignored.
+		inline T get(int /*index*/, int /*component*/) const { return this->value; }
+		/// @brief Gets the size of the expression.
+		inline int size() const { return -1; }
+
+	protected:
+		/// @brief The scalar.
+		T value;
+
+	};
+
+	/// @brief Expression term over an array of values (AoS). Can also be assigned to.
+	/// @note Use a const V to create a read-only term.
+	template <typename V>
+	class ExpressionArray : public Expression<ExpressionArray<V> >
+	{
+	public:
+		typedef V VectorType;
+		typedef typename ExpressionTraits<V>::ComponentType ComponentType;
+		enum { Dimensions = ExpressionTraits<V>::Dimensions, IsScalar = 0 };
+
+		/// @brief Constructor.
+		/// @param[in] data The array.
+		/// @param[in] count Number of elements.
+		inline ExpressionArray(V* data, int count) : data(data), count(count) { }
+		/// @brief Copy constructor.
+		/// @param[in] other The other array term.
+		/// @note This copies the array reference, not the elements.
+		inline ExpressionArray(const ExpressionArray<V>& other) : data(other.data), count(other.count) { }
+
+		/// @brief Gets a component.
+		/// @param[in] index The element index.
+		/// @param[in] component The component index.
+		inline ComponentType get(int index, int component) const { return (&this->data[index].x)[component]; }
+		/// @brief Gets the size of the expression.
+		inline int size() const { return this->count; }
+
+		/// @brief Evaluates an expression into the array in a single pass.
+		/// @param[in] expression The expression.
+		/// @return This array term.
+		/// @note If the expression is shorter than this array, only the elements it covers are assigned.
+		template <typename E>
+		inline ExpressionArray<V>& operator=(const Expression<E>& expression)
+		{
+			_ExpressionDimensionsCheck<_ExpressionDimensionsMatch<ExpressionArray<V>, E>::Value != 0>::check();
+			const E& e = expression.self();
+			int size = _expressionSize(this->count, e.size());
+			for (int i = 0; i < size; ++i)
+			{
+				ComponentType* components = (ComponentType*)&this->data[i].x;
+				for (int c = 0; c < Dimensions; ++c)
+				{
+					components[c] = (ComponentType)e.get(i, c);
+				}
+			}
+			return (*this);
+		}
+		/// @brief Evaluates another array term into this array.
+		/// @param[in] other The other array term.
+		/// @return This array term.
+		/// @note This copies the elements, not the array reference.
+		inline ExpressionArray<V>& operator=(const ExpressionArray<V>& other)
+		{
+			return (*this = static_cast<const Expression<ExpressionArray<V> >&>(other));
+		}
+		/// @brief Adds an expression to the array in a single pass.
+		/// @param[in] expression The expression.
+		/// @return This array term.
+		/// @note If the expression is shorter than this array, only the elements it covers are changed.
+		template <typename E>
+		inline ExpressionArray<V>& operator+=(const Expression<E>& expression)
+		{
+			_ExpressionDimensionsCheck<_ExpressionDimensionsMatch<ExpressionArray<V>, E>::Value != 0>::check();
+			const E& e = expression.self();
+			int size = _expressionSize(this->count, e.size());
+			for (int i = 0; i < size; ++i)
+			{
+				ComponentType* components = (ComponentType*)&this->data[i].x;
+				for (int c = 0; c < Dimensions; ++c)
+				{
+					components[c] = (ComponentType)(components[c] + e.get(i, c));
+				}
+			}
+			return (*this);
+		}
+		/// @brief Subtracts an expression from the array in a single pass.
+		/// @param[in] expression The expression.
+		/// @return This array term.
+		/// @note If the expression is shorter than this array, only the elements it covers are changed.
+		template <typename E>
+		inline ExpressionArray<V>& operator-=(const Expression<E>& expression)
+		{
+			_ExpressionDimensionsCheck<_ExpressionDimensionsMatch<ExpressionArray<V>, E>::Value != 0>::check();
+			const E& e = expression.self();
+			int size = _expressionSize(this->count, e.size());
+			for (int i = 0; i < size; ++i)
+			{
+				ComponentType* components = (ComponentType*)&this->data[i].x;
+				for (int c = 0; c < Dimensions; ++c)
+				{
+					components[c] = (ComponentType)(components[c] - e.get(i, c));
+				}
+			}
+			return (*this);
+		}
+		/// @brief Multiplies the array with a factor.
+		/// @param[in] factor The factor.
+		/// @return This array term.
+		template <typename S>
+		inline ExpressionArray<V>& operator*=(S factor)
+		{
+			return (*this = *this * factor);
+		}
+
+	protected:
+		/// @brief The array.
+		V* data;
+		/// @brief Number of elements.
+		int count;
+
+	};
+
+	/// @brief Picks the vector type of an SoA expression term.
+	template <typename T, int N>
+	struct _ExpressionSoaVectorType;
+
+	template <typename T>
+	struct _ExpressionSoaVectorType<T, 2>
+	{
+		typedef Vector2<T> Type;
+	};
+
+	template <typename T>
+	struct _ExpressionSoaVectorType<T, 3>
+	{
+		typedef Vector3<T> Type;
+	};
+
+	template <typename T>
+	struct _ExpressionSoaVectorType<T, 4>
+	{
+		typedef Vector4<T> Type;
+	};
+
+	/// @brief Expression term over separate component arrays (SoA). Can also be assigned to.
+	/// @note N = 2, 3 and 4 evaluate to Vector2, Vector3 and Vector4 respectively.
+	template <typename T, int N>
+	class ExpressionSoa : public Expression<ExpressionSoa<T, N> >
+	{
+	public:
+		typedef typename _ExpressionSoaVectorType<T, N>::Type VectorType;
+		typedef T ComponentType;
+		enum { Dimensions = N, IsScalar = 0 };
+
+		/// @brief Constructor.
+		/// @param[in] components The N component arrays.
+		/// @param[in] count Number of elements.
+		inline ExpressionSoa(T* const components[N], int count) : count(count)
+		{
+			for (int c = 0; c < N; ++c)
+			{
+				this->components[c] = components[c];
+			}
+		}
+		/// @brief Copy constructor.
+		/// @param[in] other The other SoA term.
+		/// @note This copies the array references, not the elements.
+		inline ExpressionSoa(const ExpressionSoa<T, N>& other) : count(other.count)
+		{
+			for (int c = 0; c < N; ++c)
+			{
+				this->components[c] = other.components[c];
+			}
+		}
+
+		/// @brief Gets a component.
+		/// @param[in] index The element index.
+		/// @param[in] component The component index.
+		inline T get(int index, int component) const { return this->components[component][index]; }
+		/// @brief Gets the size of the expression.
+		inline int size() const { return this->count; }
+
+		/// @brief Evaluates an expression into the arrays in a single pass per component.
+		/// @param[in] expression The expression.
+		/// @return This SoA term.
+		/// @note If the expression is shorter than these arrays, only the elements it covers are assigned.
+		template <typename E>
+		inline ExpressionSoa<T, N>& operator=(const Expression<E>& expression)
+		{
+			_ExpressionDimensionsCheck<_ExpressionDimensionsMatch<ExpressionSoa<T, N>, E>::Value != 0>::check();
+			const E& e = expression.self();
+			int size = _expressionSize(this->count, e.size());
+			for (int c = 0; c < N; ++c)
+			{
+				T* data = this->components[c];
+				for (int i = 0; i < size; ++i)
+				{
+					data[i] = (T)e.get(i, c);
+				}
+			}
+			return (*this);
+		}
+		/// @brief Evaluates another SoA term into these arrays.
+		/// @param[in] other The other SoA term.
+		/// @return This SoA term.
+		/// @note This copies the elements, not the array references.
+		inline ExpressionSoa<T, N>& operator=(const ExpressionSoa<T, N>& other)
+		{
+			return (*this = static_cast<const Expression<ExpressionSoa<T, N> >&>(other));
+		}
+		/// @brief Adds an expression to the arrays in a single pass per component.
+		/// @param[in] expression The expression.
+		/// @return This SoA term.
+		/// @note If the expression is shorter than these arrays, only the elements it covers are changed.
+		template <typename E>
+		inline ExpressionSoa<T, N>& operator+=(const Expression<E>& expression)
+		{
+			_ExpressionDimensionsCheck<_ExpressionDimensionsMatch<ExpressionSoa<T, N>, E>::Value != 0>::check();
+			const E& e = expression.self();
+			int size = _expressionSize(this->count, e.size());
+			for (int c = 0; c < N; ++c)
+			{
+				T* data = this->components[c];
+				for (int i = 0; i < size; ++i)
+				{
+					data[i] = (T)(data[i] + e.get(i, c));
+				}
+			}
+			return (*this);
+		}
+		/// @brief Subtracts an expression from the arrays in a single pass per component.
+		/// @param[in] expression The expression.
+		/// @return This SoA term.
+		/// @note If the expression is shorter than these arrays, only the elements it covers are changed.
+		template <typename E>
+		inline ExpressionSoa<T, N>& operator-=(const Expression<E>& expression)
+		{
+			_ExpressionDimensionsCheck<_ExpressionDimensionsMatch<ExpressionSoa<T, N>, E>::Value != 0>::check();
+			const E& e = expression.self();
+			int size = _expressionSize(this->count, e.size());
+			for (int c = 0; c < N; ++c)
+			{
+				T* data = this->components[c];
+				for (int i = 0; i < size; ++i)
+				{
+					data[i] = (T)(data[i] - e.get(i, c));
+				}
+			}
+			return (*this);
+		}
+		/// @brief Multiplies the arrays with a factor.
+		/// @param[in] factor The factor.
+		/// @return This SoA term.
+		template <typename S>
+		inline ExpressionSoa<T, N>& operator*=(S factor)
+		{
+			return (*this = *this * factor);
+		}
+
+	protected:
+		/// @brief The component arrays.
+		T* components[N];
+		/// @brief Number of elements.
+		int count;
+
+	};
+
+	/// @brief Picks the vector type of a binary expression.
+	template <typename L, typename R, bool LeftScalar>
+	struct _ExpressionVectorType
+	{
+		typedef typename L::VectorType Type;
+	};
+
+	template <typename L, typename R>
+	struct _ExpressionVectorType<L, R, true>
+	{
+		typedef typename R::VectorType Type;
+	};
+
+	/// @brief Component-wise addition.
+	/// @note Like the operators of the vector types, the result is computed in the promoted type and cast back to the left type.
+	struct ExpressionAdd { template <typename T, typename S> static inline T apply(T a, S b) { return (T)(a + b); } };
+	/// @brief Component-wise subtraction.
+	struct ExpressionSubtract { template <typename T, typename S> static inline T apply(T a, S b) { return (T)(a - b); } };
+	/// @brief Component-wise multiplication.
+	struct ExpressionMultiply { template <typename T, typename S> static inline T apply(T a, S b) { return (T)(a * b); } };
+	/// @brief Component-wise division.
+	struct ExpressionDivide { template <typename T, typename S> static inline T apply(T a, S b) { return (T)(a / b); } };
+
+	/// @brief Binary expression node.
+	template <typename L, typename R, typename Op>
+	class ExpressionBinary : public Expression<ExpressionBinary<L, R, Op> >
+	{
+	public:
+		typedef typename _ExpressionVectorType<L, R, L::IsScalar != 0>::Type VectorType;
+		typedef typename L::ComponentType ComponentType;
+		enum { Dimensions = (L::IsScalar ? (int)R::Dimensions : (int)L::Dimensions), IsScalar = 0 };
+
+		/// @brief Constructor.
+		/// @param[in] left Left operand.
+		/// @param[in] right Right operand.
+		/// @note Fails to compile if neither operand is a scalar and their numbers of components differ.
+		inline ExpressionBinary(const L& left, const R& right) : left(left), right(right)
+		{
+			_ExpressionDimensionsCheck<_ExpressionDimensionsMatch<L, R>::Value != 0>::check();
+		}
+
+		/// @brief Gets a component.
+		/// @param[in] index The element index.
+		/// @param[in] component The component index.
+		inline ComponentType get(int index, int component) const
+		{
+			return Op::apply(this->left.get(index, component), this->right.get(index, component));
+		}
+		/// @brief Gets the size of the expression.
+		/// @note Operands of different sizes are only evaluated over the elements both of them cover.
+		inline int size() const { return _expressionSize(this->left.size(), this->right.size()); }
+		/// @brief Evaluates this expression.
+		/// @note Only valid if the expression doesn't depend on an array index.
+		inline operator VectorType() const { return evaluate(*this); }
+
+	protected:
+		/// @brief Left operand.
+		L left;
+		/// @brief Right operand.
+		R right;
+
+	};
+
+	/// @brief Negation expression node.
+	template <typename E>
+	class ExpressionNegate : public Expression<ExpressionNegate<E> >
+	{
+	public:
+		typedef typename E::VectorType VectorType;
+		typedef typename E::ComponentType ComponentType;
+		enum { Dimensions = E::Dimensions, IsScalar = 0 };
+
+		/// @brief Constructor.
+		/// @param[in] operand The operand.
+		inline ExpressionNegate(const E& operand) : operand(operand) { }
+
+		/// @brief Gets a component.
+		/// @param[in] index The element index.
+		/// @param[in] component The component index.
+		inline ComponentType get(int index, int component) const { return -this->operand.get(index, component); }
+		/// @brief Gets the size of the expression.
+		inline int size() const { return this->operand.size(); }
+		/// @brief Evaluates this expression.
+		/// @note Only valid if the expression doesn't depend on an array index.
+		inline operator VectorType() const { return evaluate(*this); }
+
+	protected:
+		/// @brief The operand.
+		E operand;
+
+	};
+
+	/// @brief Tells whether an expression supports component-wise multiplication and division. Scalars always do.
+	template <typename E, bool Scalar = (E::IsScalar != 0)>
+	struct _ExpressionComponentWise
+	{
+		enum { Value = ExpressionTraits<typename E::VectorType>::ComponentWise };
+	};
+
+	template <typename E>
+	struct _ExpressionComponentWise<E, true>
+	{
+		enum { Value = 1 };
+	};
+
+	/// @brief Fails to compile if a product or quotient with a non-component-wise type is created.
+	template <bool ComponentWise>
+	struct _ExpressionComponentWiseCheck;
+
+	template <>
+	struct _ExpressionComponentWiseCheck<true>
+	{
+		static inline void check() { }
+	};
+
+	/// @brief Restricts scalar factors to arithmetic types so they don't collide with expression operands.
+	template <typename S>
+	struct _ExpressionFactor
+	{
+	};
+
+	template <> struct _ExpressionFactor<char> { typedef char Type; };
+	template <> struct _ExpressionFactor<unsigned char> { typedef unsigned char Type; };
+	template <> struct _ExpressionFactor<short> { typedef short Type; };
+	template <> struct _ExpressionFactor<unsigned short> { typedef unsigned short Type; };
+	template <> struct _ExpressionFactor<int> { typedef int Type; };
+	template <> struct _ExpressionFactor<unsigned int> { typedef unsigned int Type; };
+	template <> struct _ExpressionFactor<long> { typedef long Type; };
+	template <> struct _ExpressionFactor<unsigned long> { typedef unsigned long Type; };
+	template <> struct _ExpressionFactor<float> { typedef float Type; };
+	template <> struct _ExpressionFactor<double> { typedef double Type; };
+
+	/// @brief Creates an expression term from a single value.
+	/// @param[in] value The value.
+	/// @return The expression term.
+	template <typename V>
+	inline ExpressionValue<V> lazy(const V& value)
+	{
+		return ExpressionValue<V>(value);
+	}
+	/// @brief Creates an assignable expression term from an array.
+	/// @param[in] data The array.
+	/// @param[in] count Number of elements.
+	/// @return The expression term.
+	template <typename V>
+	inline ExpressionArray<V> lazy(V* data, int count)
+	{
+		return ExpressionArray<V>(data, count);
+	}
+	/// @brief Creates an assignable 2D expression term from separate component arrays.
+	/// @param[in] x X component array.
+	/// @param[in] y Y component array.
+	/// @param[in] count Number of elements.
+	/// @return The expression term.
+	template <typename T>
+	inline ExpressionSoa<T, 2> lazy(T* x, T* y, int count)
+	{
+		T* components[2] = { x, y };
+		return ExpressionSoa<T, 2>(components, count);
+	}
+	/// @brief Creates an assignable 3D expression term from separate component arrays.
+	/// @param[in] x X component array.
+	/// @param[in] y Y component array.
+	/// @param[in] z Z component array.
+	/// @param[in] count Number of elements.
+	/// @return The expression term.
+	template <typename T>
+	inline ExpressionSoa<T, 3> lazy(T* x, T* y, T* z, int count)
+	{
+		T* components[3] = { x, y, z };
+		return ExpressionSoa<T, 3>(components, count);
+	}
+	/// @brief Creates an assignable 4D expression term from separate component arrays.
+	/// @param[in] x X component array.
+	/// @param[in] y Y component array.
+	/// @param[in] z Z component array.
+	/// @param[in] w W component array.
+	/// @param[in] count Number of elements.
+	/// @return The expression term.
+	template <typename T>
+	inline ExpressionSoa<T, 4> lazy(T* x, T* y, T* z, T* w, int count)
+	{
+		T* components[4] = { x, y, z, w };
+		return ExpressionSoa<T, 4>(components, count);
+	}
+
+	/// @brief Adds two expressions.
+	template <typename L, typename R>
+	inline ExpressionBinary<L, R, ExpressionAdd> operator+(const Expression<L>& left, const Expression<R>& right)
+	{
+		return ExpressionBinary<L, R, ExpressionAdd>(left.self(), right.self());
+	}
+	/// @brief Subtracts two expressions.
+	template <typename L, typename R>
+	inline ExpressionBinary<L, R, ExpressionSubtract> operator-(const Expression<L>& left, const Expression<R>& right)
+	{
+		return ExpressionBinary<L, R, ExpressionSubtract>(left.self(), right.self());
+	}
+	/// @brief Multiplies two expressions component-wise.
+	/// @note Not available if either operand is a Quaternion.
+	template <typename L, typename R>
+	inline ExpressionBinary<L, R, ExpressionMultiply> operator*(const Expression<L>& left, const Expression<R>& right)
+	{
+		_ExpressionComponentWiseCheck<(_ExpressionComponentWise<L>::Value && _ExpressionComponentWise<R>::Value)>::check();
+		return ExpressionBinary<L, R, ExpressionMultiply>(left.self(), right.self());
+	}
+	/// @brief Divides two expressions component-wise.
+	/// @note Not available if either operand is a Quaternion.
+	template <typename L, typename R>
+	inline ExpressionBinary<L, R, ExpressionDivide> operator/(const Expression<L>& left, const Expression<R>& right)
+	{
+		_ExpressionComponentWiseCheck<(_ExpressionComponentWise<L>::Value && _ExpressionComponentWise<R>::Value)>::check();
+		return ExpressionBinary<L, R, ExpressionDivide>(left.self(), right.self());
+	}
+	/// @brief Multiplies an expression with a factor.
+	/// @note The factor keeps its type, e.g. a float factor on int vectors is not truncated before the multiplication.
+	template <typename E, typename S>
+	inline ExpressionBinary<E, ExpressionScalar<typename _ExpressionFactor<S>::Type>, ExpressionMultiply> operator*(const Expression<E>& expression, S factor)
+	{
+		return ExpressionBinary<E, ExpressionScalar<S>, ExpressionMultiply>(expression.self(), ExpressionScalar<S>(factor));
+	}
+	/// @brief Multiplies an expression with a factor.
+	/// @note The factor keeps its type, e.g. a float factor on int vectors is not truncated before the multiplication.
+	template <typename E, typename S>
+	inline ExpressionBinary<E, ExpressionScalar<typename _ExpressionFactor<S>::Type>, ExpressionMultiply> operator*(S factor, const Expression<E>& expression)
+	{
+		return ExpressionBinary<E, ExpressionScalar<S>, ExpressionMultiply>(expression.self(), ExpressionScalar<S>(factor));
+	}
+	/// @brief Divides an expression with a factor.
+	/// @note The factor keeps its type, e.g. a float factor on int vectors is not truncated before the division.
+	template <typename E, typename S>
+	inline ExpressionBinary<E, ExpressionScalar<typename _ExpressionFactor<S>::Type>, ExpressionDivide> operator/(const Expression<E>& expression, S factor)
+	{
+		return ExpressionBinary<E, ExpressionScalar<S>, ExpressionDivide>(expression.self(), ExpressionScalar<S>(factor));
+	}
+	/// @brief Negates an expression.
+	template <typename E>
+	inline ExpressionNegate<E> operator-(const Expression<E>& expression)
+	{
+		return ExpressionNegate<E>(expression.self());
+	}
+
+}
+
+#endif
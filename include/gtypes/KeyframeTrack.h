@@ -0,0 +1,489 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents an animation track of Vector3 or Quaternion keys.
+
+#ifndef GTYPES_KEYFRAME_TRACK_H
+#define GTYPES_KEYFRAME_TRACK_H
+
+#include <algorithm>
+#include <vector>
+
+#include "gtypesExport.h"
+#include "PackedQuaternion.h"
+#include "PackedVector3.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+/// @brief Number of tracks that KeyframeTrack::sample() gathers for one call of the batch interpolation kernels.
+#define KEYFRAME_BATCH_SIZE 32
+
+namespace gtypes
+{
+	/// @brief Interpolation modes of a KeyframeTrack.
+	enum KeyframeInterpolation
+	{
+		/// @brief Linear interpolation, normalized linear interpolation for Quaternions.
+		KeyframeInterpolationLinear = 0,
+		/// @brief Spherical linear interpolation for Quaternions, the same as KeyframeInterpolationLinear for Vector3s.
+		KeyframeInterpolationSlerp,
+		/// @brief Catmull-Rom spline through the keys, the tangents come from the neighboring keys and their times.
+		KeyframeInterpolationCatmullRom
+	};
+
+	/// @brief The playback position of one animation instance on a KeyframeTrack.
+	/// @note Tracks can be shared by many instances, every instance keeps its own cursor per track.
+	class KeyframeCursor
+	{
+	public:
+		/// @brief Index of the first key of the last sampled segment.
+		int index;
+
+		/// @brief Basic constructor, starts at the first key.
+		inline KeyframeCursor() : index(0)
+		{
+		}
+
+	};
+
+	/// @brief Defines how a KeyframeTrack interpolates and compresses its values.
+	/// @note Specialized for Vector3<float> and Quaternion.
+	template <typename T>
+	class KeyframeTraits;
+
+	/// @brief Defines how a KeyframeTrack interpolates and compresses Vector3 values.
+	template <>
+	class KeyframeTraits<Vector3<float> >
+	{
+	public:
+		/// @brief Compressed key, quantized to 16 bits per coordinate within the bounds of the track.
+		typedef Unorm16Vector3 Packed;
+
+		/// @return The value of a track without keys.
+		inline static Vector3<float> getDefault()
+		{
+			return Vector3<float>();
+		}
+		/// @brief Compresses values.
+		/// @param[in] values The values.
+		/// @param[out] packed Receives the compressed values.
+		/// @param[in] count Number of values.
+		/// @param[out] minimum Receives the minimum of the values.
+		/// @param[out] maximum Receives the maximum of the values.
+		inline static void encode(const Vector3<float>* values, Packed* packed, int count, Vector3<float>& minimum, Vector3<float>& maximum)
+		{
+			minimum = maximum = (count > 0 ? values[0] : Vector3<float>());
+			for (int i = 1; i < count; ++i)
+			{
+				minimum.set(std::min(minimum.x, values[i].x), std::min(minimum.y, values[i].y), std::min(minimum.z, values[i].z));
+				maximum.set(std::max(maximum.x, values[i].x), std::max(maximum.y, values[i].y), std::max(maximum.z, values[i].z));
+			}
+			Unorm16Vector3::encode(values, packed, count, minimum, maximum);
+		}
+		/// @brief Decompresses a value.
+		/// @param[in] packed The compressed value.
+		/// @param[in] minimum The minimum of the values.
+		/// @param[in] maximum The maximum of the values.
+		/// @return The value.
+		inline static Vector3<float> decode(const Packed& packed, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			return packed.toVector3(minimum, maximum);
+		}
+		/// @brief Interpolates between two values.
+		/// @param[in] a First value.
+		/// @param[in] b Second value.
+		/// @param[in] factor The interpolation factor from 0 to 1.
+		/// @param[in] interpolation The interpolation mode, both modes interpolate linearly.
+		/// @return The interpolated value.
+		inline static Vector3<float> interpolate(const Vector3<float>& a, const Vector3<float>& b, float factor, KeyframeInterpolation /*interpolation*/)
+		{
+			return (a + (b - a) * factor);
+		}
+		/// @brief Interpolates the values of two arrays index by index.
+		/// @param[in] a The first values.
+		/// @param[in] b The second values.
+		/// @param[in] factors The interpolation factor of every index.
+		/// @param[out] result Receives the interpolated values.
+		/// @param[in] count Number of values.
+		/// @param[in] interpolation The interpolation mode, both modes interpolate linearly.
+		inline static void interpolate(const Vector3<float>* a, const Vector3<float>* b, const float* factors, Vector3<float>* result, int count, KeyframeInterpolation /*interpolation*/)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = a[i] + (b[i] - a[i]) * factors[i];
+			}
+		}
+		/// @brief Prepares a neighboring value for component-wise interpolation.
+		/// @param[in] reference The reference value.
+		/// @param[in] value The neighboring value.
+		/// @return The value unchanged.
+		inline static Vector3<float> align(const Vector3<float>& /*reference*/, const Vector3<float>& value)
+		{
+			return value;
+		}
+		/// @brief Finishes a component-wise interpolation.
+		/// @param[in] value The interpolated value.
+		/// @return The value unchanged.
+		inline static Vector3<float> finish(const Vector3<float>& value)
+		{
+			return value;
+		}
+
+	};
+
+	/// @brief Defines how a KeyframeTrack interpolates and compresses Quaternion values.
+	template <>
+	class KeyframeTraits<Quaternion>
+	{
+	public:
+		/// @brief Compressed key, the smallest-three encoding in 48 bits.
+		typedef SmallestThree48Quaternion Packed;
+
+		/// @return The value of a track without keys.
+		inline static Quaternion getDefault()
+		{
+			return Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+		}
+		/// @brief Compresses values.
+		/// @param[in] values The unit Quaternions.
+		/// @param[out] packed Receives the compressed values.
+		/// @param[in] count Number of values.
+		/// @param[out] minimum Not used.
+		/// @param[out] maximum Not used.
+		inline static void encode(const Quaternion* values, Packed* packed, int count, Vector3<float>& /*minimum*/, Vector3<float>& /*maximum*/)
+		{
+			SmallestThree48Quaternion::encode(values, packed, count);
+		}
+		/// @brief Decompresses a value.
+		/// @param[in] packed The compressed value.
+		/// @param[in] minimum Not used.
+		/// @param[in] maximum Not used.
+		/// @return The unit Quaternion.
+		inline static Quaternion decode(const Packed& packed, const Vector3<float>& /*minimum*/, const Vector3<float>& /*maximum*/)
+		{
+			return packed.toQuaternion();
+		}
+		/// @brief Interpolates between two values.
+		/// @param[in] a First unit Quaternion.
+		/// @param[in] b Second unit Quaternion.
+		/// @param[in] factor The interpolation factor from 0 to 1.
+		/// @param[in] interpolation Quaternion::slerp() for KeyframeInterpolationSlerp, Quaternion::nlerp() otherwise.
+		/// @return The interpolated value.
+		inline static Quaternion interpolate(const Quaternion& a, const Quaternion& b, float factor, KeyframeInterpolation interpolation)
+		{
+			return (interpolation == KeyframeInterpolationSlerp ? Quaternion::slerp(a, b, factor) : Quaternion::nlerp(a, b, factor));
+		}
+		/// @brief Interpolates the values of two arrays index by index.
+		/// @param[in] a The first unit Quaternions.
+		/// @param[in] b The second unit Quaternions.
+		/// @param[in] factors The interpolation factor of every index.
+		/// @param[out] result Receives the interpolated values.
+		/// @param[in] count Number of values.
+		/// @param[in] interpolation The batch Quaternion::slerp() for KeyframeInterpolationSlerp, the batch Quaternion::nlerp() otherwise.
+		inline static void interpolate(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count, KeyframeInterpolation interpolation)
+		{
+			if (interpolation == KeyframeInterpolationSlerp)
+			{
+				Quaternion::slerp(a, b, factors, result, count);
+			}
+			else
+			{
+				Quaternion::nlerp(a, b, factors, result, count);
+			}
+		}
+		/// @brief Prepares a neighboring value for component-wise interpolation.
+		/// @param[in] reference The reference value.
+		/// @param[in] value The neighboring value.
+		/// @return The value negated if needed to be on the same hemisphere as the reference.
+		inline static Quaternion align(const Quaternion& reference, const Quaternion& value)
+		{
+			return (reference.dot(value) < 0.0f ? -value : value);
+		}
+		/// @brief Finishes a component-wise interpolation.
+		/// @param[in] value The interpolated value.
+		/// @return The normalized value.
+		inline static Quaternion finish(const Quaternion& value)
+		{
+			return value.normalized();
+		}
+
+	};
+
+	/// @brief Represents an animation track of Vector3 or Quaternion keys.
+	/// @note The key times and values are stored in separate contiguous arrays. Sampling with a KeyframeCursor starts the
+	/// search at the segment of the previous sample, so forward playback only needs a comparison or two instead of a binary
+	/// search per track and frame.
+	/// @note Times before the first or after the last key return the first or last value.
+	template <typename T>
+	class KeyframeTrack
+	{
+	public:
+		/// @brief The compressed key type.
+		typedef typename KeyframeTraits<T>::Packed Packed;
+
+		/// @brief Basic constructor, creates a track without keys.
+		inline KeyframeTrack() :
+			interpolation(KeyframeInterpolationLinear),
+			compressed(false)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] times The key times in ascending order.
+		/// @param[in] values The key values.
+		/// @param[in] count Number of keys.
+		/// @param[in] interpolation The interpolation mode.
+		inline KeyframeTrack(const float* times, const T* values, int count, KeyframeInterpolation interpolation = KeyframeInterpolationLinear) :
+			interpolation(KeyframeInterpolationLinear),
+			compressed(false)
+		{
+			this->set(times, values, count, interpolation);
+		}
+
+		/// @brief Sets the keys of the track.
+		/// @param[in] times The key times in ascending order.
+		/// @param[in] values The key values.
+		/// @param[in] count Number of keys.
+		/// @param[in] interpolation The interpolation mode.
+		/// @note The track is uncompressed afterwards.
+		inline void set(const float* times, const T* values, int count, KeyframeInterpolation interpolation = KeyframeInterpolationLinear)
+		{
+			this->times.assign(times, times + count);
+			this->values.assign(values, values + count);
+			this->packedValues.clear();
+			this->interpolation = interpolation;
+			this->compressed = false;
+		}
+		/// @brief Sets the keys of the track.
+		/// @param[in] times The key times in ascending order.
+		/// @param[in] values The key values, as many as times.
+		/// @param[in] interpolation The interpolation mode.
+		/// @note The track is uncompressed afterwards.
+		inline void set(const std::vector<float>& times, const std::vector<T>& values, KeyframeInterpolation interpolation = KeyframeInterpolationLinear)
+		{
+			this->set(times.size() > 0 ? &times[0] : NULL, values.size() > 0 ? &values[0] : NULL, (int)times.size(), interpolation);
+		}
+
+		/// @return The number of keys.
+		inline int getCount() const { return (int)this->times.size(); }
+		/// @return The interpolation mode.
+		inline KeyframeInterpolation getInterpolation() const { return this->interpolation; }
+		/// @brief Sets the interpolation mode.
+		/// @param[in] value The interpolation mode.
+		inline void setInterpolation(KeyframeInterpolation value) { this->interpolation = value; }
+		/// @return True if the values are stored compressed.
+		inline bool isCompressed() const { return this->compressed; }
+		/// @return The time of the first key, 0 without keys.
+		inline float getStartTime() const { return (this->times.size() > 0 ? this->times.front() : 0.0f); }
+		/// @return The time of the last key, 0 without keys.
+		inline float getEndTime() const { return (this->times.size() > 0 ? this->times.back() : 0.0f); }
+		/// @param[in] index Index of the key.
+		/// @return The time of the key.
+		inline float getTime(int index) const { return this->times[index]; }
+		/// @param[in] index Index of the key.
+		/// @return The value of the key, decompressed if needed.
+		inline T getValue(int index) const
+		{
+			return (this->compressed ? KeyframeTraits<T>::decode(this->packedValues[index], this->minimum, this->maximum) : this->values[index]);
+		}
+
+		/// @brief Replaces the values with their compressed form.
+		/// @note Vector3 keys are quantized to 16 bits within the bounds of the track, Quaternion keys use the smallest-three
+		/// encoding in 48 bits. Sampling decompresses the keys it needs.
+		inline void compress()
+		{
+			if (!this->compressed)
+			{
+				this->packedValues.resize(this->values.size());
+				if (this->values.size() > 0)
+				{
+					KeyframeTraits<T>::encode(&this->values[0], &this->packedValues[0], (int)this->values.size(), this->minimum, this->maximum);
+				}
+				std::vector<T>().swap(this->values);
+				this->compressed = true;
+			}
+		}
+
+		/// @brief Samples the track.
+		/// @param[in] time The time.
+		/// @return The interpolated value.
+		/// @note Uses a binary search, sample(float, KeyframeCursor&) is faster for playback.
+		inline T sample(float time) const
+		{
+			KeyframeCursor cursor;
+			cursor.index = -1;
+			return this->sample(time, cursor);
+		}
+		/// @brief Samples the track at a time close to the previous sample of the cursor.
+		/// @param[in] time The time.
+		/// @param[in,out] cursor The cursor of the animation instance, moves to the sampled segment.
+		/// @return The interpolated value.
+		/// @note Moving forward by a few keys costs a comparison per key, other jumps use a binary search.
+		inline T sample(float time, KeyframeCursor& cursor) const
+		{
+			int count = (int)this->times.size();
+			if (count < 2)
+			{
+				return (count == 1 ? this->getValue(0) : KeyframeTraits<T>::getDefault());
+			}
+			cursor.index = this->_findSegment(time, cursor.index);
+			float factor = this->_getFactor(cursor.index, time);
+			if (this->interpolation == KeyframeInterpolationCatmullRom)
+			{
+				return this->_sampleCatmullRom(cursor.index, factor);
+			}
+			return KeyframeTraits<T>::interpolate(this->getValue(cursor.index), this->getValue(cursor.index + 1), factor, this->interpolation);
+		}
+		/// @brief Samples many tracks at the same time, e.g. all channels of a skeleton.
+		/// @param[in] tracks The tracks.
+		/// @param[in,out] cursors The cursor of every track.
+		/// @param[in] count Number of tracks.
+		/// @param[in] time The time.
+		/// @param[out] result Receives the interpolated value of every track.
+		/// @note The key pairs of linear and slerp tracks are gathered and interpolated with the batch kernels, e.g.
+		/// the batch Quaternion::slerp(), so the results can differ slightly from sample(float, KeyframeCursor&).
+		static void sample(const KeyframeTrack<T>* tracks, KeyframeCursor* cursors, int count, float time, T* result)
+		{
+			T a[KEYFRAME_BATCH_SIZE];
+			T b[KEYFRAME_BATCH_SIZE];
+			T interpolated[KEYFRAME_BATCH_SIZE];
+			float factors[KEYFRAME_BATCH_SIZE];
+			int indices[KEYFRAME_BATCH_SIZE];
+			// one pass per mode over every chunk of tracks so each kernel call has a single mode
+			for (int start = 0; start < count; start += KEYFRAME_BATCH_SIZE)
+			{
+				int end = std::min(start + KEYFRAME_BATCH_SIZE, count);
+				for (int mode = KeyframeInterpolationLinear; mode <= KeyframeInterpolationSlerp; ++mode)
+				{
+					int gathered = 0;
+					for (int i = start; i < end; ++i)
+					{
+						const KeyframeTrack<T>& track = tracks[i];
+						if (track.interpolation == (KeyframeInterpolation)mode && track.times.size() >= 2)
+						{
+							int index = track._findSegment(time, cursors[i].index);
+							cursors[i].index = index;
+							a[gathered] = track.getValue(index);
+							b[gathered] = track.getValue(index + 1);
+							factors[gathered] = track._getFactor(index, time);
+							indices[gathered] = i;
+							++gathered;
+						}
+					}
+					if (gathered > 0)
+					{
+						KeyframeTraits<T>::interpolate(a, b, factors, interpolated, gathered, (KeyframeInterpolation)mode);
+						for (int i = 0; i < gathered; ++i)
+						{
+							result[indices[i]] = interpolated[i];
+						}
+					}
+				}
+				for (int i = start; i < end; ++i)
+				{
+					if (tracks[i].interpolation == KeyframeInterpolationCatmullRom || tracks[i].times.size() < 2)
+					{
+						result[i] = tracks[i].sample(time, cursors[i]);
+					}
+				}
+			}
+		}
+
+	protected:
+		/// @brief Interpolation mode.
+		KeyframeInterpolation interpolation;
+		/// @brief Whether the values are stored in packedValues.
+		bool compressed;
+		/// @brief The key times in ascending order.
+		std::vector<float> times;
+		/// @brief The key values, empty if compressed.
+		std::vector<T> values;
+		/// @brief The compressed key values, empty if not compressed.
+		std::vector<Packed> packedValues;
+		/// @brief Minimum of the Vector3 values, set when compressing.
+		Vector3<float> minimum;
+		/// @brief Maximum of the Vector3 values, set when compressing.
+		Vector3<float> maximum;
+
+		/// @brief Finds the segment of a time, needs at least 2 keys.
+		/// @param[in] time The time.
+		/// @param[in] index The segment of the previous sample, an invalid index starts a binary search.
+		/// @return The index of the first key of the segment, from 0 to getCount() - 2.
+		inline int _findSegment(float time, int index) const
+		{
+			int last = (int)this->times.size() - 2;
+			if (index >= 0 && index <= last && time >= this->times[index])
+			{
+				// forward playback usually stays in the segment or moves to one of the next ones
+				for (int i = 0; i < 4 && index < last && time >= this->times[index + 1]; ++i)
+				{
+					++index;
+				}
+				if (index == last || time < this->times[index + 1])
+				{
+					return index;
+				}
+			}
+			// the first key greater than time ends the segment, the last segment also holds all later times
+			return (int)(std::upper_bound(this->times.begin() + 1, this->times.end() - 1, time) - this->times.begin()) - 1;
+		}
+		/// @brief Calculates the interpolation factor within a segment.
+		/// @param[in] index The index of the first key of the segment.
+		/// @param[in] time The time.
+		/// @return The factor clamped to 0 to 1.
+		inline float _getFactor(int index, float time) const
+		{
+			float duration = this->times[index + 1] - this->times[index];
+			if (duration <= 0.0f)
+			{
+				return 1.0f;
+			}
+			float factor = (time - this->times[index]) / duration;
+			return (factor > 0.0f ? (factor < 1.0f ? factor : 1.0f) : 0.0f);
+		}
+		/// @brief Evaluates the Catmull-Rom segment as a cubic Hermite curve.
+		/// @param[in] index The index of the first key of the segment.
+		/// @param[in] factor The factor within the segment.
+		/// @return The interpolated value.
+		/// @note The tangents are the differences of the neighboring keys scaled by the segment duration over their time span,
+		/// so uneven key spacing does not overshoot. The first and last keys use their own value as the missing neighbor.
+		inline T _sampleCatmullRom(int index, float factor) const
+		{
+			int last = (int)this->times.size() - 1;
+			int previous = (index > 0 ? index - 1 : index);
+			int next = (index + 2 <= last ? index + 2 : index + 1);
+			T p1 = this->getValue(index);
+			T p0 = KeyframeTraits<T>::align(p1, this->getValue(previous));
+			T p2 = KeyframeTraits<T>::align(p1, this->getValue(index + 1));
+			T p3 = KeyframeTraits<T>::align(p2, this->getValue(next));
+			float duration = this->times[index + 1] - this->times[index];
+			float span1 = this->times[index + 1] - this->times[previous];
+			float span2 = this->times[next] - this->times[index];
+			T tangent1 = (p2 - p0) * (span1 > 0.0f ? duration / span1 : 0.0f);
+			T tangent2 = (p3 - p1) * (span2 > 0.0f ? duration / span2 : 0.0f);
+			float squared = factor * factor;
+			float cubed = squared * factor;
+			return KeyframeTraits<T>::finish(p1 * (2.0f * cubed - 3.0f * squared + 1.0f) + tangent1 * (cubed - 2.0f * squared + factor) +
+				p2 * (3.0f * squared - 2.0f * cubed) + tangent2 * (cubed - squared));
+		}
+
+	};
+
+}
+
+/// @brief Typedef for simpler code.
+typedef gtypes::KeyframeTrack<gtypes::Vector3<float> > gtrack3f;
+/// @brief Typedef for simpler code.
+typedef const gtypes::KeyframeTrack<gtypes::Vector3<float> >& cgtrack3f;
+/// @brief Typedef for simpler code.
+typedef gtypes::KeyframeTrack<gtypes::Quaternion> gtrackq;
+/// @brief Typedef for simpler code.
+typedef const gtypes::KeyframeTrack<gtypes::Quaternion>& cgtrackq;
+
+#endif
@@ -22,6 +22,7 @@
 #include "Quaternion.h"
 #include "Rectangle.h"
 #include "Vector3.h"
+#include "Vector4.h"
 
 namespace gtypes
 {
@@ -598,9 +599,21 @@ namespace gtypes
 				this->data[1] * vector.x + this->data[5] * vector.y + this->data[9] * vector.z + this->data[13],
 				this->data[2] * vector.x + this->data[6] * vector.y + this->data[10] * vector.z + this->data[14]);
 		}
+		/// @brief Multiplies a Matrix4 with a Vector4.
+		/// @param[in] vector The Vector4.
+		/// @return The resulting Vector4.
+		/// @note This is a full homogeneous transformation, the W coordinate is not assumed to be 1.
+		inline Vector4<float> operator*(const Vector4<float>& vector) const
+		{
+			Vector4<float> result;
+			simd::transform4(this->data, &vector.x, &result.x);
+			return result;
+		}
 		/// @brief Multiplies a Matrix4 with a Quaternion.
 		/// @param[in] quaternion The Quaternion.
 		/// @return The resulting Quaternion.
+		/// @note Quaternions are not meant to be transformed like this, use Vector4 for 4D transformations.
+		/// @see operator*(const Vector4<float>&)
 		inline Quaternion operator*(const Quaternion& quaternion) const
 		{
 			return Quaternion(this->data[0] * quaternion.x + this->data[4] * quaternion.y + this->data[8] * quaternion.z + this->data[12] * quaternion.w,
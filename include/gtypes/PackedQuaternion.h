@@ -0,0 +1,214 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents compact storage formats for unit Quaternions.
+
+#ifndef GTYPES_PACKED_QUATERNION_H
+#define GTYPES_PACKED_QUATERNION_H
+
+#include "gtypesExport.h"
+#include "gtypesSimd.h"
+#include "Quaternion.h"
+
+namespace gtypes
+{
+	/// @brief Represents a unit Quaternion with smallest-three encoding in 29 bits.
+	/// @note q and -q are the same rotation, so the Quaternion is negated if needed to make its largest component positive.
+	/// That component is dropped and restored from the unit length when decoding. The other three lie in [-1/sqrt(2), 1/sqrt(2)]
+	/// and are stored as 9-bit signed normalized integers in the bits 0-8, 9-17 and 18-26 (in x, y, z, w order without the
+	/// largest one), the bits 27-28 hold the index of the largest component. The bits 29-31 are always 0 so the value can be
+	/// written into a bit stream with 29 bits. The maximum error of a component is 1 / (2 * 255 * sqrt(2)) (1.4e-3) before the
+	/// largest component is restored.
+	/// @note Quaternions have to be normalized before encoding, the decoded Quaternions have unit length.
+	class gtypesExport SmallestThree29Quaternion
+	{
+	public:
+		/// @brief The packed bits.
+		unsigned int value;
+
+		/// @brief Basic constructor.
+		/// @note Decodes as the identity rotation.
+		inline SmallestThree29Quaternion() : value(0x1BFDFEFFu)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] quaternion The unit Quaternion to encode.
+		inline SmallestThree29Quaternion(const Quaternion& quaternion)
+		{
+			this->set(quaternion);
+		}
+
+		/// @brief Encodes a unit Quaternion.
+		/// @param[in] quaternion The unit Quaternion.
+		void set(const Quaternion& quaternion);
+		/// @return The decoded unit Quaternion.
+		Quaternion toQuaternion() const;
+
+		/// @brief Encodes an array of unit Quaternions.
+		/// @param[in] quaternions The unit Quaternions.
+		/// @param[out] result Receives the encoded Quaternions.
+		/// @param[in] count Number of Quaternions.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(). The results are identical on all levels.
+		inline static void encode(const Quaternion* quaternions, SmallestThree29Quaternion* result, int count)
+		{
+			simd::getKernels().encodeSmallestThree29Quaternion(quaternions, result, count);
+		}
+		/// @brief Decodes an array of unit Quaternions.
+		/// @param[in] packed The encoded Quaternions.
+		/// @param[out] result Receives the unit Quaternions.
+		/// @param[in] count Number of Quaternions.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		inline static void decode(const SmallestThree29Quaternion* packed, Quaternion* result, int count)
+		{
+			simd::getKernels().decodeSmallestThree29Quaternion(packed, result, count);
+		}
+
+	};
+
+	/// @brief Represents a unit Quaternion with smallest-three encoding in 32 bits.
+	/// @note Same encoding as SmallestThree29Quaternion with 10-bit components in the bits 0-9, 10-19 and 20-29 and the index
+	/// of the largest component in the bits 30-31. The maximum error of a component is 1 / (2 * 511 * sqrt(2)) (6.9e-4).
+	/// @note Supports delta compression against a previously sent state with encodeDelta() and decodeDelta().
+	class gtypesExport SmallestThree32Quaternion
+	{
+	public:
+		/// @brief The packed bits.
+		unsigned int value;
+
+		/// @brief Basic constructor.
+		/// @note Decodes as the identity rotation.
+		inline SmallestThree32Quaternion() : value(0xDFF7FDFFu)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] quaternion The unit Quaternion to encode.
+		inline SmallestThree32Quaternion(const Quaternion& quaternion)
+		{
+			this->set(quaternion);
+		}
+
+		/// @brief Encodes a unit Quaternion.
+		/// @param[in] quaternion The unit Quaternion.
+		void set(const Quaternion& quaternion);
+		/// @return The decoded unit Quaternion.
+		Quaternion toQuaternion() const;
+
+		/// @brief Encodes an array of unit Quaternions.
+		/// @param[in] quaternions The unit Quaternions.
+		/// @param[out] result Receives the encoded Quaternions.
+		/// @param[in] count Number of Quaternions.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(). The results are identical on all levels.
+		inline static void encode(const Quaternion* quaternions, SmallestThree32Quaternion* result, int count)
+		{
+			simd::getKernels().encodeSmallestThree32Quaternion(quaternions, result, count);
+		}
+		/// @brief Decodes an array of unit Quaternions.
+		/// @param[in] packed The encoded Quaternions.
+		/// @param[out] result Receives the unit Quaternions.
+		/// @param[in] count Number of Quaternions.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		inline static void decode(const SmallestThree32Quaternion* packed, Quaternion* result, int count)
+		{
+			simd::getKernels().decodeSmallestThree32Quaternion(packed, result, count);
+		}
+
+		/// @brief Gets the maximum number of bytes written by encodeDelta().
+		/// @param[in] count Number of encoded Quaternions.
+		/// @return The maximum number of bytes.
+		inline static int getMaximumDeltaSize(int count)
+		{
+			return ((count + 3) / 4 + count * 4);
+		}
+		/// @brief Compresses encoded Quaternions losslessly against baselines, e.g. the last state the receiver acknowledged.
+		/// @param[in] packed The encoded Quaternions.
+		/// @param[in] baselines The encoded baseline of every Quaternion.
+		/// @param[in] count Number of Quaternions.
+		/// @param[out] buffer Receives the compressed data, needs at least getMaximumDeltaSize(count) bytes.
+		/// @return The number of bytes written.
+		/// @note Every Quaternion gets a 2-bit tag, 4 tags per byte at the start of the buffer. The tag selects 0 bytes if the
+		/// Quaternion is equal to its baseline, 2 bytes with 5-bit component differences, 3 bytes with 8-bit component differences
+		/// or the 4 bytes of the full value. Differences are only used if the largest component did not change.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(). The results are identical on all levels.
+		inline static int encodeDelta(const SmallestThree32Quaternion* packed, const SmallestThree32Quaternion* baselines, int count, unsigned char* buffer)
+		{
+			return simd::getKernels().encodeDeltaSmallestThree32Quaternion(packed, baselines, count, buffer);
+		}
+		/// @brief Decompresses encoded Quaternions created by encodeDelta().
+		/// @param[in] buffer The compressed data.
+		/// @param[in] size Number of bytes available in the buffer.
+		/// @param[in] baselines The encoded baseline of every Quaternion, the same ones used by encodeDelta().
+		/// @param[out] result Receives the encoded Quaternions, may be the same array as baselines.
+		/// @param[in] count Number of Quaternions.
+		/// @return The number of bytes read or -1 if the buffer is too small.
+		/// @note Never reads outside of the buffer, so data from the network can be passed directly.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(), SSSE3 byte shuffles on SSE4.1 and above.
+		inline static int decodeDelta(const unsigned char* buffer, int size, const SmallestThree32Quaternion* baselines, SmallestThree32Quaternion* result, int count)
+		{
+			return simd::getKernels().decodeDeltaSmallestThree32Quaternion(buffer, size, baselines, result, count);
+		}
+
+	};
+
+	/// @brief Represents a unit Quaternion with smallest-three encoding in 48 bits.
+	/// @note Same encoding as SmallestThree29Quaternion with 15-bit components in the bits 0-14 of x, y and z. Bit 15 of x and y
+	/// holds bit 0 and 1 of the index of the largest component, bit 15 of z is always 0. The maximum error of a component is
+	/// 1 / (2 * 16383 * sqrt(2)) (2.2e-5).
+	class gtypesExport SmallestThree48Quaternion
+	{
+	public:
+		/// @brief First of the three smallest components and bit 0 of the index.
+		unsigned short x;
+		/// @brief Second of the three smallest components and bit 1 of the index.
+		unsigned short y;
+		/// @brief Third of the three smallest components.
+		unsigned short z;
+
+		/// @brief Basic constructor.
+		/// @note Decodes as the identity rotation.
+		inline SmallestThree48Quaternion() : x(0xBFFF), y(0xBFFF), z(0x3FFF)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] quaternion The unit Quaternion to encode.
+		inline SmallestThree48Quaternion(const Quaternion& quaternion)
+		{
+			this->set(quaternion);
+		}
+
+		/// @brief Encodes a unit Quaternion.
+		/// @param[in] quaternion The unit Quaternion.
+		void set(const Quaternion& quaternion);
+		/// @return The decoded unit Quaternion.
+		Quaternion toQuaternion() const;
+
+		/// @brief Encodes an array of unit Quaternions.
+		/// @param[in] quaternions The unit Quaternions.
+		/// @param[out] result Receives the encoded Quaternions.
+		/// @param[in] count Number of Quaternions.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(). The results are identical on all levels.
+		inline static void encode(const Quaternion* quaternions, SmallestThree48Quaternion* result, int count)
+		{
+			simd::getKernels().encodeSmallestThree48Quaternion(quaternions, result, count);
+		}
+		/// @brief Decodes an array of unit Quaternions.
+		/// @param[in] packed The encoded Quaternions.
+		/// @param[out] result Receives the unit Quaternions.
+		/// @param[in] count Number of Quaternions.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		inline static void decode(const SmallestThree48Quaternion* packed, Quaternion* result, int count)
+		{
+			simd::getKernels().decodeSmallestThree48Quaternion(packed, result, count);
+		}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,261 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents compact storage formats for float Vector3s.
+
+#ifndef GTYPES_PACKED_VECTOR3_H
+#define GTYPES_PACKED_VECTOR3_H
+
+#include "gtypesExport.h"
+#include "gtypesSimd.h"
+#include "Vector3.h"
+
+namespace gtypes
+{
+	/// @brief Represents a Vector3 stored as 3 IEEE 754 half-precision floats in 6 bytes.
+	/// @note Conversions round to nearest even. The relative error is below 2^-11 (4.9e-4) for magnitudes between
+	/// 6.1e-5 and 65504, smaller values lose precision as subnormals and larger ones become infinity.
+	class gtypesExport HalfVector3
+	{
+	public:
+		/// @brief X coordinate as half.
+		unsigned short x;
+		/// @brief Y coordinate as half.
+		unsigned short y;
+		/// @brief Z coordinate as half.
+		unsigned short z;
+
+		/// @brief Basic constructor.
+		inline HalfVector3() : x(0), y(0), z(0)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] vector The Vector3 to encode.
+		inline HalfVector3(const Vector3<float>& vector)
+		{
+			this->set(vector);
+		}
+
+		/// @brief Encodes a Vector3.
+		/// @param[in] vector The Vector3.
+		inline void set(const Vector3<float>& vector)
+		{
+			this->x = HalfVector3::fromFloat(vector.x);
+			this->y = HalfVector3::fromFloat(vector.y);
+			this->z = HalfVector3::fromFloat(vector.z);
+		}
+		/// @return The decoded Vector3.
+		inline Vector3<float> toVector3() const
+		{
+			return Vector3<float>(HalfVector3::toFloat(this->x), HalfVector3::toFloat(this->y), HalfVector3::toFloat(this->z));
+		}
+
+		/// @brief Converts a float to half.
+		/// @param[in] value The float.
+		/// @return The half.
+		/// @note Every NaN becomes the quiet NaN 0x7E00 with the same sign, its payload is dropped.
+		static unsigned short fromFloat(float value);
+		/// @brief Converts a half to float.
+		/// @param[in] value The half.
+		/// @return The float.
+		/// @note The conversion is exact.
+		static float toFloat(unsigned short value);
+
+		/// @brief Encodes an array of Vector3s.
+		/// @param[in] vectors The Vector3s.
+		/// @param[out] result Receives the encoded Vector3s.
+		/// @param[in] count Number of Vector3s.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(), F16C on AVX2 and above. The results are identical on all levels.
+		inline static void encode(const Vector3<float>* vectors, HalfVector3* result, int count)
+		{
+			simd::getKernels().encodeHalfVector3(vectors, result, count);
+		}
+		/// @brief Decodes an array of Vector3s.
+		/// @param[in] packed The encoded Vector3s.
+		/// @param[out] result Receives the Vector3s.
+		/// @param[in] count Number of Vector3s.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(), F16C on AVX2 and above.
+		inline static void decode(const HalfVector3* packed, Vector3<float>* result, int count)
+		{
+			simd::getKernels().decodeHalfVector3(packed, result, count);
+		}
+
+	};
+
+	/// @brief Represents a Vector3 within known bounds stored as 3 16-bit unsigned normalized integers in 6 bytes.
+	/// @note The bounds are not stored, they have to be passed when encoding and decoding. Components outside of the
+	/// bounds are clamped. The maximum error of a component is half of a quantization step, (maximum - minimum) / 131070,
+	/// plus float rounding.
+	class gtypesExport Unorm16Vector3
+	{
+	public:
+		/// @brief Quantized X coordinate.
+		unsigned short x;
+		/// @brief Quantized Y coordinate.
+		unsigned short y;
+		/// @brief Quantized Z coordinate.
+		unsigned short z;
+
+		/// @brief Basic constructor.
+		inline Unorm16Vector3() : x(0), y(0), z(0)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] vector The Vector3 to encode.
+		/// @param[in] minimum Lower bounds of the components.
+		/// @param[in] maximum Upper bounds of the components.
+		inline Unorm16Vector3(const Vector3<float>& vector, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			this->set(vector, minimum, maximum);
+		}
+
+		/// @brief Encodes a Vector3.
+		/// @param[in] vector The Vector3.
+		/// @param[in] minimum Lower bounds of the components.
+		/// @param[in] maximum Upper bounds of the components.
+		void set(const Vector3<float>& vector, const Vector3<float>& minimum, const Vector3<float>& maximum);
+		/// @brief Decodes the Vector3.
+		/// @param[in] minimum Lower bounds of the components used for encoding.
+		/// @param[in] maximum Upper bounds of the components used for encoding.
+		/// @return The decoded Vector3.
+		Vector3<float> toVector3(const Vector3<float>& minimum, const Vector3<float>& maximum) const;
+
+		/// @brief Encodes an array of Vector3s.
+		/// @param[in] vectors The Vector3s.
+		/// @param[out] result Receives the encoded Vector3s.
+		/// @param[in] count Number of Vector3s.
+		/// @param[in] minimum Lower bounds of the components.
+		/// @param[in] maximum Upper bounds of the components.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(). The results are identical on all levels.
+		inline static void encode(const Vector3<float>* vectors, Unorm16Vector3* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			simd::getKernels().encodeUnorm16Vector3(vectors, result, count, minimum, maximum);
+		}
+		/// @brief Decodes an array of Vector3s.
+		/// @param[in] packed The encoded Vector3s.
+		/// @param[out] result Receives the Vector3s.
+		/// @param[in] count Number of Vector3s.
+		/// @param[in] minimum Lower bounds of the components used for encoding.
+		/// @param[in] maximum Upper bounds of the components used for encoding.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		inline static void decode(const Unorm16Vector3* packed, Vector3<float>* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			simd::getKernels().decodeUnorm16Vector3(packed, result, count, minimum, maximum);
+		}
+
+	};
+
+	/// @brief Represents a unit Vector3 stored with octahedral encoding as 2 16-bit signed normalized integers in 4 bytes.
+	/// @note The sphere is projected onto an octahedron which is unfolded into a square. The maximum angle between a unit
+	/// Vector3 and its decoded version is below 0.004 degrees. Vector3s do not need to be normalized before encoding,
+	/// zero-length Vector3s decode as (0, 0, 1).
+	class gtypesExport OctahedralVector3
+	{
+	public:
+		/// @brief Quantized X coordinate on the unfolded octahedron.
+		short x;
+		/// @brief Quantized Y coordinate on the unfolded octahedron.
+		short y;
+
+		/// @brief Basic constructor.
+		/// @note Decodes as (0, 0, 1).
+		inline OctahedralVector3() : x(0), y(0)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] vector The Vector3 to encode.
+		inline OctahedralVector3(const Vector3<float>& vector)
+		{
+			this->set(vector);
+		}
+
+		/// @brief Encodes the direction of a Vector3.
+		/// @param[in] vector The Vector3.
+		void set(const Vector3<float>& vector);
+		/// @return The decoded unit Vector3.
+		Vector3<float> toVector3() const;
+
+		/// @brief Encodes the directions of an array of Vector3s.
+		/// @param[in] vectors The Vector3s.
+		/// @param[out] result Receives the encoded Vector3s.
+		/// @param[in] count Number of Vector3s.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(). The results are identical on all levels.
+		inline static void encode(const Vector3<float>* vectors, OctahedralVector3* result, int count)
+		{
+			simd::getKernels().encodeOctahedralVector3(vectors, result, count);
+		}
+		/// @brief Decodes an array of unit Vector3s.
+		/// @param[in] packed The encoded Vector3s.
+		/// @param[out] result Receives the unit Vector3s.
+		/// @param[in] count Number of Vector3s.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		inline static void decode(const OctahedralVector3* packed, Vector3<float>* result, int count)
+		{
+			simd::getKernels().decodeOctahedralVector3(packed, result, count);
+		}
+
+	};
+
+	/// @brief Represents a Vector3 with components in [-1, 1] stored as 10:10:10:2 in 4 bytes.
+	/// @note X, Y and Z are 10-bit signed normalized integers in the bits 0-9, 10-19 and 20-29, the bits 30-31 hold an
+	/// additional 2-bit unsigned value W, e.g. the handedness of a tangent. This is the layout of GL_INT_2_10_10_10_REV.
+	/// Components outside of [-1, 1] are clamped. The maximum error of a component is 1 / 1022 (9.8e-4).
+	class gtypesExport Snorm10Vector3
+	{
+	public:
+		/// @brief The packed bits.
+		unsigned int value;
+
+		/// @brief Basic constructor.
+		inline Snorm10Vector3() : value(0)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] vector The Vector3 to encode.
+		/// @param[in] w The 2-bit value W from 0 to 3.
+		inline Snorm10Vector3(const Vector3<float>& vector, int w = 0)
+		{
+			this->set(vector, w);
+		}
+
+		/// @return The 2-bit value W.
+		inline int getW() const { return (int)(this->value >> 30); }
+		/// @brief Encodes a Vector3.
+		/// @param[in] vector The Vector3.
+		/// @param[in] w The 2-bit value W from 0 to 3.
+		void set(const Vector3<float>& vector, int w = 0);
+		/// @return The decoded Vector3.
+		Vector3<float> toVector3() const;
+
+		/// @brief Encodes an array of Vector3s.
+		/// @param[in] vectors The Vector3s.
+		/// @param[out] result Receives the encoded Vector3s.
+		/// @param[in] count Number of Vector3s.
+		/// @param[in] w The 2-bit value W from 0 to 3 used for all Vector3s.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(). The results are identical on all levels.
+		inline static void encode(const Vector3<float>* vectors, Snorm10Vector3* result, int count, int w = 0)
+		{
+			simd::getKernels().encodeSnorm10Vector3(vectors, result, count, w);
+		}
+		/// @brief Decodes an array of Vector3s.
+		/// @param[in] packed The encoded Vector3s.
+		/// @param[out] result Receives the Vector3s.
+		/// @param[in] count Number of Vector3s.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		inline static void decode(const Snorm10Vector3* packed, Vector3<float>* result, int count)
+		{
+			simd::getKernels().decodeSnorm10Vector3(packed, result, count);
+		}
+
+	};
+
+}
+
+#endif
@@ -14,14 +14,25 @@
 #define GTYPES_QUATERNION_H
 
 #include "gtypesExport.h"
+#include "gtypesSimd.h"
 #include "gtypesUtil.h"
 #include "Matrix3.h"
 #include "Vector3.h"
+#include "Vector4.h"
 
 namespace gtypes
 {
 	class Matrix4;
 
+	/// @brief Integration modes of Quaternion::integrate().
+	enum QuaternionIntegration
+	{
+		/// @brief Adds the first-order derivative, accurate for small rotations per time step.
+		QuaternionIntegrationFirstOrder = 0,
+		/// @brief Applies the exponential map of the rotation, exact for any angle of a constant angular velocity.
+		QuaternionIntegrationExponential
+	};
+
 	/// @brief Represents a quaternion.
 	class gtypesExport Quaternion
 	{
@@ -65,6 +76,15 @@ namespace gtypes
 			w(w)
 		{
 		}
+		/// @brief Constructor.
+		/// @param[in] v Vector4.
+		inline Quaternion(const Vector4<float>& v) :
+			x(v.x),
+			y(v.y),
+			z(v.z),
+			w(v.w)
+		{
+		}
 		/// @brief Sets the values of the Quaternion.
 		/// @param[in] x X value.
 		/// @param[in] y Y value.
@@ -91,14 +111,14 @@ namespace gtypes
 		/// @return Calculates the length of the Quaternion.
 		inline float length() const
 		{
-			return (float)sqrt(this->x * this->x + this->y * this->y + this->z * this->z + this->w * this->w);
+			return sqrtf(simd::dot4(&this->x, &this->x));
 		}
 		/// @return Calculates the squared length of the Quaternion.
 		/// @note Use this if you don't need the actual length as it's faster than length().
 		/// @see length()
 		inline float squaredLength() const
 		{
-			return (this->x * this->x + this->y * this->y + this->z * this->z + this->w * this->w);
+			return simd::dot4(&this->x, &this->x);
 		}
 		
 		/// @brief Normalizes the current Quaternion.
@@ -107,11 +127,7 @@ namespace gtypes
 			float length = this->length();
 			if (length != 0.0f)
 			{
-				length = 1.0f / length;
-				this->x *= length;
-				this->y *= length;
-				this->z *= length;
-				this->w *= length;
+				simd::scale4(&this->x, 1.0f / length, &this->x);
 			}
 		}
 		/// @brief Creates a normalized Quaternion from this Quaternion.
@@ -122,11 +138,44 @@ namespace gtypes
 			result.normalize();
 			return result;
 		}
+		/// @brief Normalizes the current Quaternion using a fast reciprocal square root approximation.
+		/// @note The maximum relative error is below 2^-21 (5e-7), use normalize() if exact results are required.
+		/// @see normalize
+		/// @see simd::rsqrt
+		inline void normalizeFast()
+		{
+			float squaredLength = this->squaredLength();
+			if (squaredLength != 0.0f)
+			{
+				simd::scale4(&this->x, simd::rsqrt(squaredLength), &this->x);
+			}
+		}
+		/// @brief Creates a normalized Quaternion from this Quaternion using a fast reciprocal square root approximation.
+		/// @return The normalized Quaternion.
+		/// @note The maximum relative error is below 2^-21 (5e-7), use normalized() if exact results are required.
+		/// @see normalized
+		inline Quaternion normalizedFast() const
+		{
+			float squaredLength = this->squaredLength();
+			if (squaredLength == 0.0f)
+			{
+				return (*this);
+			}
+			return ((*this) * simd::rsqrt(squaredLength));
+		}
+		/// @brief Normalizes an array of Quaternions using a fast reciprocal square root approximation.
+		/// @param[in,out] quaternions The Quaternions.
+		/// @param[in] count Number of Quaternions.
+		/// @note Zero-length Quaternions stay unchanged.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see normalizeFast()
+		static void normalizeFast(Quaternion* quaternions, int count);
 		/// @brief Inverses the current Quaternion.
 		inline void inverse()
 		{
-			float squaredLength = 1.0f / this->squaredLength();
-			this->set(-this->x * squaredLength, -this->y * squaredLength, -this->z * squaredLength, this->w * squaredLength);
+			float inverse = 1.0f / this->squaredLength();
+			float factors[4] = { -inverse, -inverse, -inverse, inverse };
+			simd::mul4(&this->x, factors, &this->x);
 		}
 		/// @brief Creates an inversed Quaternion from this Quaternion.
 		/// @return The inversed Quaternion.
@@ -151,14 +200,91 @@ namespace gtypes
 			result.conjugate();
 			return result;
 		}
+		/// @brief Calculates the natural logarithm of this Quaternion.
+		/// @return The logarithm, the rotation axis scaled by half the rotation angle and the logarithm of the length as w.
+		/// @note The w of the logarithm of a unit Quaternion is 0.
+		/// @see exp
+		Quaternion log() const;
+		/// @brief Calculates the exponential of this Quaternion.
+		/// @return The exponential, the inverse of log().
+		/// @note The exponential of a Quaternion with a w of 0 is a unit Quaternion.
+		/// @see log
+		Quaternion exp() const;
 		/// @brief Calculates the dot-product between this and another Quaternion.
 		/// @param[in] other The other Quaternion.
 		/// @return The dot-product.
 		inline float dot(const Quaternion& other) const
 		{
-			return (this->x * other.x + this->y * other.y + this->z * other.z + this->w * other.w);
-		}
+			return simd::dot4(&this->x, &other.x);
+		}
+		/// @brief Rotates a Vector3 with this Quaternion.
+		/// @param[in] vector The Vector3.
+		/// @return The rotated Vector3.
+		/// @note Calculates q * v * q^-1 for a unit Quaternion as v + w * t + q x t with t = 2 * (q x v) in 15 multiplications
+		/// without building a Matrix3. The rotation direction is the same as in fromAxisAngle(), mat3() * vector rotates
+		/// in the opposite direction because mat3() holds the transposed rotation.
+		inline Vector3<float> rotate(const Vector3<float>& vector) const
+		{
+			float tx = this->y * vector.z - this->z * vector.y;
+			float ty = this->z * vector.x - this->x * vector.z;
+			float tz = this->x * vector.y - this->y * vector.x;
+			tx += tx;
+			ty += ty;
+			tz += tz;
+			return Vector3<float>(vector.x + this->w * tx + (this->y * tz - this->z * ty),
+				vector.y + this->w * ty + (this->z * tx - this->x * tz),
+				vector.z + this->w * tz + (this->x * ty - this->y * tx));
+		}
+		/// @brief Rotates an array of Vector3s with one Quaternion.
+		/// @param[in] quaternion The unit Quaternion.
+		/// @param[in] vectors The Vector3s.
+		/// @param[out] result Receives the rotated Vector3s, may be the same array as vectors.
+		/// @param[in] count Number of Vector3s.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see rotate(const Vector3<float>&)
+		static void rotate(const Quaternion& quaternion, const Vector3<float>* vectors, Vector3<float>* result, int count);
+		/// @brief Rotates every Vector3 of an array with the Quaternion at the same index.
+		/// @param[in] quaternions The unit Quaternions.
+		/// @param[in] vectors The Vector3s.
+		/// @param[out] result Receives the rotated Vector3s, may be the same array as vectors.
+		/// @param[in] count Number of Quaternions and Vector3s.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see rotate(const Vector3<float>&)
+		static void rotate(const Quaternion* quaternions, const Vector3<float>* vectors, Vector3<float>* result, int count);
+		/// @brief Multiplies the Quaternions of two arrays index by index.
+		/// @param[in] a The left Quaternions.
+		/// @param[in] b The right Quaternions.
+		/// @param[out] result Receives a[i] * b[i], may be the same array as a or b.
+		/// @param[in] count Number of Quaternions.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		static void multiply(const Quaternion* a, const Quaternion* b, Quaternion* result, int count);
+		/// @brief Rotates this unit Quaternion by an angular velocity over a time step and normalizes it.
+		/// @param[in] angularVelocity The angular velocity in radians per second, the axis is in the parent space.
+		/// @param[in] dt The time step in seconds.
+		/// @param[in] integration The integration mode.
+		/// @note The derivative is 0.5 * Quaternion(angularVelocity, 0) * q. The first-order mode adds it scaled by dt, the
+		/// exponential mode multiplies with exp(Quaternion(angularVelocity * dt * 0.5, 0)) which is the same as a rotation
+		/// around the axis of angularVelocity by its length times dt.
+		void integrate(const Vector3<float>& angularVelocity, float dt, QuaternionIntegration integration = QuaternionIntegrationFirstOrder);
+		/// @brief Integrates the angular velocities of many bodies over a time step, e.g. the orientations of a simulation.
+		/// @param[in,out] quaternions The unit Quaternions.
+		/// @param[in] angularVelocities The angular velocity of every Quaternion in radians per second.
+		/// @param[in] dt The time step in seconds.
+		/// @param[in] count Number of Quaternions.
+		/// @param[in] integration The integration mode.
+		/// @note Both modes calculate the new Quaternion as cosine * q + scale * Quaternion(angularVelocity, 0) * q in a
+		/// single pass and normalize it with the fast reciprocal square root like normalizeFast().
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see integrate(const Vector3<float>&, float, QuaternionIntegration)
+		static void integrate(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count,
+			QuaternionIntegration integration = QuaternionIntegrationFirstOrder);
 
+		/// @brief Creates a Vector4 from this Quaternion.
+		/// @return The Vector4.
+		inline Vector4<float> vec4() const
+		{
+			return Vector4<float>(this->x, this->y, this->z, this->w);
+		}
 		/// @brief Creates a Matrix3 from this Quaternion
 		/// @return The Matrix3.
 		inline Matrix3 mat3() const
@@ -183,6 +309,12 @@ namespace gtypes
 		/// @param[in] position The Vector3 position in the Matrix4.
 		/// @return The Matrix4.
 		Matrix4 mat4(const Vector3<float>& position) const;
+		/// @brief Converts this unit Quaternion to Euler angles.
+		/// @return The yaw angle in [-pi, pi], the pitch angle in [-pi / 2, pi / 2] and the roll angle in [-pi, pi] in radians
+		/// stored in x, y and z.
+		/// @note The inverse of fromEulerAngles(). When the pitch is close to +-pi / 2 yaw and roll rotate around the same axis,
+		/// the roll is set to 0 and the yaw holds the whole rotation around that axis.
+		Vector3<float> toEulerAngles() const;
 		
 		/// @brief Creates an negated Quaternion.
 		/// @return Negated Quaternion.
@@ -211,10 +343,9 @@ namespace gtypes
 		/// @return The resulting Quaternion.
 		inline Quaternion operator*(const Quaternion& other) const
 		{
-			return Quaternion(this->w * other.x + this->x * other.w + this->y * other.z - this->z * other.y,
-				this->w * other.y - this->x * other.z + this->y * other.w + this->z * other.x,
-				this->w * other.z + this->x * other.y - this->y * other.x + this->z * other.w,
-				this->w * other.w - this->x * other.x - this->y * other.y - this->z * other.z);
+			Quaternion result;
+			simd::multiplyQuaternion4(&this->x, &other.x, &result.x);
+			return result;
 		}
 		/// @brief Multiplies Quaternion with a factor.
 		/// @param[in] factor The factor.
@@ -261,14 +392,7 @@ namespace gtypes
 		/// @return A copy of this Quaternion.
 		inline Quaternion operator*=(const Quaternion& other)
 		{
-			float x = this->x;
-			float y = this->y;
-			float z = this->z;
-			float w = this->w;
-			this->x = w * other.x + x * other.w + y * other.z - z * other.y;
-			this->y = w * other.y - x * other.z + y * other.w + z * other.x;
-			this->z = w * other.z + x * other.y - y * other.x + z * other.w;
-			this->w = w * other.w - x * other.x - y * other.y - z * other.z;
+			simd::multiplyQuaternion4(&this->x, &other.x, &this->x);
 			return (*this);
 		}
 		/// @brief Multiplies this Quaternion with a factor.
@@ -310,24 +434,65 @@ namespace gtypes
 			return !(*this == other);
 		}
 
-		/// @brief Creates a Quaternion as s Spherical Linear intERPolation between two other Quaternions.
-		/// @param[in] a First Quaternion.
-		/// @param[in] b Second Quaternion.
-		/// @param[in] factor The slerp factor.
+		/// @brief Creates a Quaternion as a Spherical Linear intERPolation between two other Quaternions.
+		/// @param[in] a First unit Quaternion.
+		/// @param[in] b Second unit Quaternion.
+		/// @param[in] factor The slerp factor from 0 to 1.
 		/// @return The slerped Quaternion.
-		inline static Quaternion slerp(const Quaternion& a, const Quaternion& b, float factor)
-		{
-			float theta = (float)acos(a.dot(b));
-			float sinTheta = (float)sin(theta);
-			float w1 = 1.0f - factor;
-			float w2 = factor;
-			if (sinTheta > G_E_TOLERANCE)
-			{
-				w1 = (float)(sin(1.0f - factor) * theta) / sinTheta;
-				w2 = (float)(sin(factor) * theta) / sinTheta;
-			}
-			return Quaternion(a * w1 + b * w2);
-		}
+		/// @note Interpolates along the shorter arc, b is negated if the dot-product is negative.
+		/// @note Uses a polynomial series instead of acos() and sin() so the calculation has no branches and needs no
+		/// trigonometric functions. The maximum error of the interpolation weights is below 1e-6 for all angles.
+		static Quaternion slerp(const Quaternion& a, const Quaternion& b, float factor);
+		/// @brief Spherically interpolates the Quaternions of two arrays index by index, e.g. to blend two poses.
+		/// @param[in] a The first unit Quaternions.
+		/// @param[in] b The second unit Quaternions.
+		/// @param[in] factors The slerp factor of every index.
+		/// @param[out] result Receives the slerped Quaternions, may be the same array as a or b.
+		/// @param[in] count Number of Quaternions.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see slerp(const Quaternion&, const Quaternion&, float)
+		static void slerp(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count);
+		/// @brief Creates a Quaternion as a normalized linear interpolation between two other Quaternions.
+		/// @param[in] a First unit Quaternion.
+		/// @param[in] b Second unit Quaternion.
+		/// @param[in] factor The interpolation factor from 0 to 1.
+		/// @return The interpolated Quaternion.
+		/// @note Interpolates along the shorter arc like slerp(). Faster than slerp(), but the angular velocity is not
+		/// constant, the error is largest for large angles between a and b.
+		inline static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float factor)
+		{
+			float weight = (a.dot(b) < 0.0f ? -factor : factor);
+			return (a * (1.0f - factor) + b * weight).normalized();
+		}
+		/// @brief Linearly interpolates and normalizes the Quaternions of two arrays index by index, e.g. to blend two poses.
+		/// @param[in] a The first unit Quaternions.
+		/// @param[in] b The second unit Quaternions.
+		/// @param[in] factors The interpolation factor of every index.
+		/// @param[out] result Receives the interpolated Quaternions, may be the same array as a or b.
+		/// @param[in] count Number of Quaternions.
+		/// @note Normalizes with the fast reciprocal square root like normalizeFast().
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see nlerp(const Quaternion&, const Quaternion&, float)
+		static void nlerp(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count);
+		/// @brief Creates a Quaternion as a spherical quadrangle interpolation (SQUAD) between two other Quaternions.
+		/// @param[in] a First unit Quaternion.
+		/// @param[in] b Second unit Quaternion.
+		/// @param[in] controlA The inner control point of a from squadControl().
+		/// @param[in] controlB The inner control point of b from squadControl().
+		/// @param[in] factor The interpolation factor from 0 to 1.
+		/// @return The interpolated Quaternion.
+		/// @note Chained segments have a continuous angular velocity at the keys, unlike chained slerp().
+		/// @note Like Shoemake's SQUAD, the outer interpolation follows the arc between its ends even if it is the longer one,
+		/// so the curve stays continuous when keys are more than 90 degrees apart.
+		/// @see QuaternionSpline
+		static Quaternion squad(const Quaternion& a, const Quaternion& b, const Quaternion& controlA, const Quaternion& controlB, float factor);
+		/// @brief Calculates the inner control point of a key for squad().
+		/// @param[in] previous The previous unit Quaternion key.
+		/// @param[in] current The unit Quaternion key.
+		/// @param[in] next The next unit Quaternion key.
+		/// @return The inner control point, in the same hemisphere as current.
+		/// @note The neighbors are negated if needed so the control point does not depend on their signs.
+		static Quaternion squadControl(const Quaternion& previous, const Quaternion& current, const Quaternion& next);
 		/// @brief Creates a Quaternion from a rotation around an axis.
 		/// @param[in] ax X coordinate of the axis.
 		/// @param[in] ay Y coordinate of the axis.
@@ -347,18 +512,74 @@ namespace gtypes
 			float theta = (float)DEG_TO_RAD(angle) * 0.5f;
 			return Quaternion(axis.normalized() * (float)sin(theta), (float)cos(theta));
 		}
+		/// @brief Creates a Quaternion from a rotation Matrix3.
+		/// @param[in] matrix The Matrix3 in the layout of mat3(), without scale or shear.
+		/// @return The unit Quaternion, the inverse of mat3().
+		/// @note Shepperd's method, the largest of w, x, y and z is calculated from the diagonal and divides the others so
+		/// the result stays accurate for all rotations. The largest component is always positive. The result is normalized,
+		/// so matrices that drifted slightly from orthonormal still give unit Quaternions.
+		static Quaternion fromMatrix(const Matrix3& matrix);
+		/// @brief Creates a Quaternion from the rotation of a Matrix4.
+		/// @param[in] matrix The Matrix4 in the layout of mat4(), the translation is ignored.
+		/// @return The unit Quaternion, the inverse of mat4().
+		/// @see fromMatrix(const Matrix3&)
+		static Quaternion fromMatrix(const Matrix4& matrix);
+		/// @brief Creates Quaternions from an array of rotation Matrix3s, e.g. the orientations of a physics engine.
+		/// @param[in] matrices The Matrix3s in the layout of mat3().
+		/// @param[out] result Receives the unit Quaternions.
+		/// @param[in] count Number of Matrix3s.
+		/// @note All four cases of Shepperd's method are calculated and blended by the largest component instead of branching.
+		/// The normalization uses the fast reciprocal square root like normalizeFast().
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see fromMatrix(const Matrix3&)
+		static void fromMatrix(const Matrix3* matrices, Quaternion* result, int count);
+		/// @brief Creates Quaternions from the rotations of an array of Matrix4s.
+		/// @param[in] matrices The Matrix4s in the layout of mat4().
+		/// @param[out] result Receives the unit Quaternions.
+		/// @param[in] count Number of Matrix4s.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see fromMatrix(const Matrix3*, Quaternion*, int)
+		static void fromMatrix(const Matrix4* matrices, Quaternion* result, int count);
 		/// @brief Creates a Quaternion from Euler angles.
-		/// @param[in] yaw The "yaw" angle.
-		/// @param[in] pitch The "pitch" angle.
-		/// @param[in] roll The "roll" angle.
+		/// @param[in] yaw The "yaw" angle in radians.
+		/// @param[in] pitch The "pitch" angle in radians.
+		/// @param[in] roll The "roll" angle in radians.
 		/// @return The Quaternion.
+		/// @note The result is the product of the rotations -yaw around the Y axis, -pitch around the X axis and -roll around
+		/// the Z axis in that order, expanded into a closed form with one sine and cosine per half angle.
+		/// @see toEulerAngles
 		inline static Quaternion fromEulerAngles(float yaw, float pitch, float roll)
 		{
-			Quaternion y(0.0f, -(float)sin(yaw * 0.5f), 0.0f, (float)cos(yaw * 0.5f));
-			Quaternion p(-(float)sin(pitch * 0.5f), 0.0f, 0.0f, (float)cos(pitch * 0.5f));
-			Quaternion r(0.0f, 0.0f, -(float)sin(roll * 0.5), (float)cos(roll * 0.5f));
-			return (y * p * r);
-		}
+			float sy = sinf(yaw * 0.5f);
+			float cy = cosf(yaw * 0.5f);
+			float sp = sinf(pitch * 0.5f);
+			float cp = cosf(pitch * 0.5f);
+			float sr = sinf(roll * 0.5f);
+			float cr = cosf(roll * 0.5f);
+			float cycp = cy * cp;
+			float sysp = sy * sp;
+			float cysp = cy * sp;
+			float sycp = sy * cp;
+			return Quaternion(-(cysp * cr - sycp * sr), -(sycp * cr + cysp * sr), -(cycp * sr + sysp * cr), cycp * cr - sysp * sr);
+		}
+		/// @brief Creates Quaternions from an array of Euler angles, e.g. orientation samples of input devices.
+		/// @param[in] angles The yaw, pitch and roll angles in radians stored in x, y and z.
+		/// @param[out] result Receives the Quaternions.
+		/// @param[in] count Number of Quaternions.
+		/// @note Calculates the sines and cosines with polynomials after reducing the half angles by multiples of pi / 2. The
+		/// maximum absolute error of a component is below 5e-7 for angles within [-1000, 1000].
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see fromEulerAngles(float, float, float)
+		static void fromEulerAngles(const Vector3<float>* angles, Quaternion* result, int count);
+		/// @brief Converts unit Quaternions to Euler angles.
+		/// @param[in] quaternions The unit Quaternions.
+		/// @param[out] angles Receives the yaw, pitch and roll angles in radians in x, y and z.
+		/// @param[in] count Number of Quaternions.
+		/// @note Uses the fast polynomial approximation of simd::atan2Fast() for all three angles, the maximum error is below
+		/// 1e-5 radians away from the gimbal lock.
+		/// @note Uses the SIMD kernel of the current simd::getLevel().
+		/// @see toEulerAngles()
+		static void toEulerAngles(const Quaternion* quaternions, Vector3<float>* angles, int count);
 
 	};
 
@@ -0,0 +1,257 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents a smooth rotation curve through Quaternion keys.
+
+#ifndef GTYPES_QUATERNION_SPLINE_H
+#define GTYPES_QUATERNION_SPLINE_H
+
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+#include "gtypesExport.h"
+#include "Quaternion.h"
+
+namespace gtypes
+{
+	/// @brief Represents a smooth rotation curve through Quaternion keys, e.g. the orientation of a camera rail.
+	/// @note Uses spherical quadrangle interpolation (SQUAD), the inner control points are calculated once when the keys
+	/// are set so sampling needs 3 slerps and no logarithms.
+	/// @note The segments are reparametrized by their rotation angle like the arc lengths of CatmullRomSpline3, so the
+	/// parameter moves through all segments at a similar angular velocity.
+	class gtypesExport QuaternionSpline
+	{
+	public:
+		/// @brief Basic Constructor.
+		inline QuaternionSpline() :
+			closed(false),
+			length(0.0),
+			_prevIndex(0)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] quaternions Unit Quaternion keys to define the QuaternionSpline.
+		/// @param[in] closed Whether the QuaternionSpline is closed.
+		inline QuaternionSpline(const std::vector<Quaternion>& quaternions, bool closed) :
+			closed(false),
+			length(0.0),
+			_prevIndex(0)
+		{
+			this->set(quaternions, closed);
+		}
+		/// @brief Constructor.
+		/// @param[in] quaternions Array of unit Quaternion keys to define the QuaternionSpline.
+		/// @param[in] n Number of keys in quaternions.
+		/// @param[in] closed Whether the QuaternionSpline is closed.
+		inline QuaternionSpline(const Quaternion quaternions[], int n, bool closed) :
+			closed(false),
+			length(0.0),
+			_prevIndex(0)
+		{
+			this->set(quaternions, n, closed);
+		}
+
+		/// @brief Sets the QuaternionSpline's keys.
+		/// @param[in] quaternions Unit Quaternion keys to define the QuaternionSpline.
+		/// @param[in] closed Whether the QuaternionSpline is closed.
+		inline void set(const std::vector<Quaternion>& quaternions, bool closed)
+		{
+			this->set(quaternions.size() > 0 ? &quaternions[0] : NULL, (int)quaternions.size(), closed);
+		}
+		/// @brief Sets the QuaternionSpline's keys.
+		/// @param[in] quaternions Array of unit Quaternion keys to define the QuaternionSpline.
+		/// @param[in] n Number of keys in quaternions.
+		/// @param[in] closed Whether the QuaternionSpline is closed.
+		/// @note Every key is negated if needed to be in the same hemisphere as the previous one, so each segment takes the
+		/// shorter arc. A closed QuaternionSpline repeats the first key at the end.
+		inline void set(const Quaternion quaternions[], int n, bool closed)
+		{
+			this->points.assign(quaternions, quaternions + n);
+			this->controls.clear();
+			this->lengths.clear();
+			this->_arcLengths.clear();
+			this->closed = closed;
+			this->length = 0.0;
+			this->_prevIndex = 0;
+			if (n == 0)
+			{
+				return;
+			}
+			if (this->closed && n > 1)
+			{
+				this->points.push_back(this->points[0]);
+			}
+			for (unsigned int i = 1; i < this->points.size(); ++i)
+			{
+				if (this->points[i].dot(this->points[i - 1]) < 0.0f)
+				{
+					this->points[i] = -this->points[i];
+				}
+			}
+			this->_calcControls();
+			this->_calcLength();
+		}
+
+		/// @return The total rotation angle of all segments in radians.
+		inline double getLength() const { return this->length; }
+		/// @return True if the QuaternionSpline is closed.
+		inline bool isClosed() const { return this->closed; }
+		/// @return The keys in the hemisphere of their previous key, with the first key repeated at the end if closed.
+		inline const std::vector<Quaternion>& getPoints() const { return this->points; }
+		/// @return The inner control point of every key.
+		inline const std::vector<Quaternion>& getControls() const { return this->controls; }
+
+		/// @brief Calculates the rotation at a point on the QuaternionSpline.
+		/// @param[in] t Segment range position.
+		/// @return Unit Quaternion rotation.
+		/// @note t is in range [0,1], values outside wrap around if the QuaternionSpline is closed and are clamped otherwise.
+		/// @note Starts the segment search at the segment of the previous call, so playback in either direction needs a
+		/// comparison or two instead of a search.
+		inline Quaternion calcRotation(double t)
+		{
+			if (this->points.size() < 2)
+			{
+				return (this->points.size() == 1 ? this->points[0] : Quaternion(0.0f, 0.0f, 0.0f, 1.0f));
+			}
+			if (this->closed)
+			{
+				t -= floor(t);
+			}
+			else
+			{
+				t = (t > 0.0 ? (t < 1.0 ? t : 1.0) : 0.0);
+			}
+			int index = this->_findSegment(t);
+			double start = (index > 0 ? this->_arcLengths[index - 1] : 0.0);
+			double range = this->_arcLengths[index] - start;
+			float factor = (range > 0.0 ? (float)((t - start) / range) : 0.0f);
+			factor = (factor < 1.0f ? factor : 1.0f);
+			return Quaternion::squad(this->points[index], this->points[index + 1], this->controls[index], this->controls[index + 1], factor);
+		}
+
+	protected:
+		/// @brief Whether the QuaternionSpline is closed.
+		bool closed;
+		/// @brief The total rotation angle in radians.
+		double length;
+		/// @brief The keys defining the QuaternionSpline.
+		std::vector<Quaternion> points;
+		/// @brief The inner control point of every key.
+		std::vector<Quaternion> controls;
+		/// @brief The rotation angles of all segments in radians.
+		std::vector<double> lengths;
+
+		/// @brief Pre-calculates the inner control points of all keys.
+		/// @note The first and last keys of an open QuaternionSpline are their own control points, so the curve starts and
+		/// ends like a slerp.
+		inline void _calcControls()
+		{
+			int last = (int)this->points.size() - 1;
+			this->controls.resize(this->points.size());
+			for (int i = 0; i <= last; ++i)
+			{
+				if (this->closed && last > 0)
+				{
+					// the first and last keys are the same rotation, their neighbors come from the other end
+					const Quaternion& previous = this->points[i > 0 ? i - 1 : last - 1];
+					const Quaternion& next = this->points[i < last ? i + 1 : 1];
+					this->controls[i] = Quaternion::squadControl(previous, this->points[i], next);
+				}
+				else if (i == 0 || i == last)
+				{
+					this->controls[i] = this->points[i];
+				}
+				else
+				{
+					this->controls[i] = Quaternion::squadControl(this->points[i - 1], this->points[i], this->points[i + 1]);
+				}
+			}
+		}
+		/// @brief Pre-calculates the rotation angles of all segments and their range of the parameter.
+		/// @return The total rotation angle.
+		/// @note Segments split the parameter evenly if all keys are the same rotation.
+		inline double _calcLength()
+		{
+			this->length = 0.0;
+			this->lengths.clear();
+			for (unsigned int i = 1; i < this->points.size(); ++i)
+			{
+				Quaternion difference = this->points[i - 1].conjugated() * this->points[i];
+				float sine = sqrtf(difference.x * difference.x + difference.y * difference.y + difference.z * difference.z);
+				this->lengths.push_back(2.0 * atan2((double)sine, (double)fabsf(difference.w)));
+				this->length += this->lengths.back();
+			}
+			this->_arcLengthReparametrization();
+			return this->length;
+		}
+		/// @brief Reparametrizes the segments by their rotation angles.
+		inline void _arcLengthReparametrization()
+		{
+			this->_arcLengths.clear();
+			double prevLength = 0.0;
+			for (unsigned int i = 0; i < this->lengths.size(); ++i)
+			{
+				prevLength += (this->length > 0.0 ? this->lengths[i] / this->length : 1.0 / this->lengths.size());
+				this->_arcLengths.push_back(prevLength);
+			}
+			if (this->_arcLengths.size() > 0)
+			{
+				this->_arcLengths.back() = 1.0;
+			}
+		}
+		/// @brief Finds the segment of a parameter, needs at least 2 keys.
+		/// @param[in] t Segment range position in [0,1].
+		/// @return The index of the first key of the segment.
+		inline int _findSegment(double t)
+		{
+			int last = (int)this->_arcLengths.size() - 1;
+			int index = (this->_prevIndex <= last ? this->_prevIndex : last);
+			// playback usually stays in the segment or moves to one of the neighboring ones
+			for (int i = 0; i < 2; ++i)
+			{
+				if (index > 0 && t < this->_arcLengths[index - 1])
+				{
+					--index;
+				}
+				else if (index < last && t >= this->_arcLengths[index])
+				{
+					++index;
+				}
+			}
+			if ((index == 0 || t >= this->_arcLengths[index - 1]) && (index == last || t < this->_arcLengths[index]))
+			{
+				this->_prevIndex = index;
+				return index;
+			}
+			// the first end greater than t is the segment, the last segment also holds t = 1
+			index = (int)(std::upper_bound(this->_arcLengths.begin(), this->_arcLengths.end() - 1, t) - this->_arcLengths.begin());
+			this->_prevIndex = index;
+			return index;
+		}
+
+	private:
+		/// @brief Previously stored segment index for the segment search.
+		/// @note Used internally only.
+		int _prevIndex;
+		/// @brief The parameter at the end of every segment.
+		/// @note Used internally only.
+		std::vector<double> _arcLengths;
+
+	};
+
+}
+
+/// @brief Alias for simpler code.
+typedef gtypes::QuaternionSpline gquatspline;
+/// @brief Alias for simpler code.
+typedef const gtypes::QuaternionSpline& cgquatspline;
+
+#endif
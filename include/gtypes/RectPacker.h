@@ -0,0 +1,188 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents a bin packer that places Rectangles into a fixed area, e.g. glyphs and sprites into a texture atlas.
+
+#ifndef GTYPES_RECT_PACKER_H
+#define GTYPES_RECT_PACKER_H
+
+#include <vector>
+
+#include "gtypesExport.h"
+#include "Rectangle.h"
+#include "RectQuadtree.h"
+#include "Vector2.h"
+
+namespace gtypes
+{
+	/// @brief Represents a bin packer that places Rectangles into a fixed area, e.g. glyphs and sprites into a texture atlas.
+	/// @note MaxRects keeps a list of the maximal free rectangles that may overlap each other and places every Rectangle into
+	/// the best one, see Jylanki, "A Thousand Ways to Pack the Bin" (2010). Skyline only keeps the top edge of the used area
+	/// and places every Rectangle as low as possible, which is faster but wastes the space below overhangs.
+	/// @note Rectangles can be inserted one by one, e.g. for a dynamic glyph cache, or in a batch that is sorted by size
+	/// first for a better fit.
+	class gtypesExport RectPacker
+	{
+	public:
+		/// @brief The packing algorithm.
+		enum Method
+		{
+			/// @brief MaxRects, chooses the free rectangle with the smallest leftover on the shorter side.
+			MethodMaxRectsBestShortSideFit = 0,
+			/// @brief MaxRects, chooses the position that touches the most edges of the area and of placed Rectangles.
+			MethodMaxRectsContactPoint,
+			/// @brief Skyline, chooses the lowest position and the best fitting skyline segment on ties.
+			MethodSkyline
+		};
+
+		/// @brief Constructor.
+		/// @param[in] width Width of the area.
+		/// @param[in] height Height of the area.
+		/// @param[in] method The packing algorithm.
+		/// @param[in] rotationAllowed Whether Rectangles may be rotated by 90 degrees.
+		RectPacker(int width = 0, int height = 0, Method method = MethodMaxRectsBestShortSideFit, bool rotationAllowed = false);
+
+		/// @return The width of the area.
+		inline int getWidth() const { return this->width; }
+		/// @return The height of the area.
+		inline int getHeight() const { return this->height; }
+		/// @return The packing algorithm.
+		inline Method getMethod() const { return this->method; }
+		/// @return True if Rectangles may be rotated by 90 degrees.
+		inline bool isRotationAllowed() const { return this->rotationAllowed; }
+		/// @brief Sets whether Rectangles may be rotated by 90 degrees.
+		/// @param[in] value The new value.
+		/// @note Only affects later insertions.
+		inline void setRotationAllowed(bool value) { this->rotationAllowed = value; }
+		/// @return The number of placed Rectangles.
+		inline int getCount() const { return this->count; }
+		/// @return The area covered by placed Rectangles.
+		inline long long getUsedArea() const { return this->usedArea; }
+		/// @return The smallest Rectangle at the origin that contains all placed Rectangles, e.g. to trim an atlas.
+		inline Rectangle<int> getUsedBounds() const { return Rectangle<int>(0, 0, this->usedRight, this->usedBottom); }
+		/// @return The used area relative to the whole area in [0,1].
+		float getOccupancy() const;
+		/// @return The used area relative to getUsedBounds() in [0,1].
+		float getUsedBoundsOccupancy() const;
+
+		/// @brief Removes all Rectangles and changes the size of the area.
+		/// @param[in] width Width of the area.
+		/// @param[in] height Height of the area.
+		void reset(int width, int height);
+		/// @brief Removes all Rectangles and changes the size of the area and the packing algorithm.
+		/// @param[in] width Width of the area.
+		/// @param[in] height Height of the area.
+		/// @param[in] method The packing algorithm.
+		void reset(int width, int height, Method method);
+
+		/// @brief Places a Rectangle.
+		/// @param[in] width Width of the Rectangle.
+		/// @param[in] height Height of the Rectangle.
+		/// @param[out] result Receives the placed Rectangle, width and height are swapped if it was rotated.
+		/// @return True if the Rectangle fit, result is an empty Rectangle otherwise.
+		bool insert(int width, int height, Rectangle<int>& result);
+		/// @brief Places many Rectangles, the larger ones first.
+		/// @param[in] sizes The widths and heights of the Rectangles.
+		/// @param[in] count Number of Rectangles.
+		/// @param[out] results Receives the placed Rectangles in the order of sizes, those that did not fit are empty.
+		/// @return Number of Rectangles that fit.
+		/// @note Sorting by the longer side first leaves the small Rectangles to fill the gaps, which usually packs a lot
+		/// tighter than inserting in random order.
+		int insert(const Vector2<int>* sizes, int count, Rectangle<int>* results);
+		/// @brief Places many Rectangles, the larger ones first.
+		/// @param[in] sizes The widths and heights of the Rectangles.
+		/// @param[out] results Receives the placed Rectangles in the order of sizes, those that did not fit are empty.
+		/// @return Number of Rectangles that fit.
+		inline int insert(const std::vector<Vector2<int> >& sizes, std::vector<Rectangle<int> >& results)
+		{
+			results.resize(sizes.size());
+			return (sizes.size() > 0 ? this->insert(&sizes[0], (int)sizes.size(), &results[0]) : 0);
+		}
+
+	protected:
+		/// @brief A horizontal segment of the top edge of the used area for Skyline.
+		struct SkylineNode
+		{
+			/// @brief Left edge of the segment.
+			int x;
+			/// @brief Height of the used area below the segment.
+			int y;
+			/// @brief Width of the segment.
+			int width;
+		};
+
+		/// @brief Width of the area.
+		int width;
+		/// @brief Height of the area.
+		int height;
+		/// @brief The packing algorithm.
+		Method method;
+		/// @brief Whether Rectangles may be rotated by 90 degrees.
+		bool rotationAllowed;
+		/// @brief Number of placed Rectangles.
+		int count;
+		/// @brief Area covered by placed Rectangles.
+		long long usedArea;
+		/// @brief Right edge of the used bounds.
+		int usedRight;
+		/// @brief Bottom edge of the used bounds.
+		int usedBottom;
+		/// @brief The maximal free rectangles for MaxRects.
+		std::vector<Rectangle<int> > freeRectangles;
+		/// @brief The segments of the skyline from left to right for Skyline.
+		std::vector<SkylineNode> skyline;
+
+		/// @brief Finds the best free rectangle for MaxRects.
+		/// @param[in] width Width of the Rectangle.
+		/// @param[in] height Height of the Rectangle.
+		/// @param[out] result Receives the position and size of the Rectangle.
+		/// @return True if the Rectangle fit.
+		bool _findMaxRects(int width, int height, Rectangle<int>& result);
+		/// @brief Calculates how much of the edges of a Rectangle touches the area edges and placed Rectangles.
+		/// @param[in] rectangle The Rectangle.
+		/// @return Length of the touching edges.
+		int _calcContact(const Rectangle<int>& rectangle);
+		/// @brief Removes a placed Rectangle from the free rectangles for MaxRects.
+		/// @param[in] rectangle The placed Rectangle.
+		void _placeMaxRects(const Rectangle<int>& rectangle);
+		/// @brief Finds the best position for Skyline.
+		/// @param[in] width Width of the Rectangle.
+		/// @param[in] height Height of the Rectangle.
+		/// @param[out] result Receives the position and size of the Rectangle.
+		/// @param[out] index Receives the index of the first segment below the Rectangle.
+		/// @return True if the Rectangle fit.
+		bool _findSkyline(int width, int height, Rectangle<int>& result, int& index) const;
+		/// @brief Calculates how high a Rectangle has to be placed at the left edge of a skyline segment.
+		/// @param[in] index Index of the segment.
+		/// @param[in] width Width of the Rectangle.
+		/// @param[in] height Height of the Rectangle.
+		/// @return The top edge of the Rectangle, -1 if it does not fit.
+		int _fitSkyline(int index, int width, int height) const;
+		/// @brief Raises the skyline over a placed Rectangle.
+		/// @param[in] index Index of the first segment below the Rectangle.
+		/// @param[in] rectangle The placed Rectangle.
+		void _placeSkyline(int index, const Rectangle<int>& rectangle);
+
+	private:
+		/// @brief The placed Rectangles for the contact search of MaxRects.
+		/// @note Used internally only.
+		RectQuadtree<int> _usedRectangles;
+		/// @brief Free rectangles created while placing a Rectangle.
+		/// @note Used internally only.
+		std::vector<Rectangle<int> > _newFreeRectangles;
+		/// @brief Result buffer for the contact search.
+		/// @note Used internally only.
+		std::vector<int> _neighbors;
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,680 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents a loose quadtree over Rectangles for overlap, point and nearest neighbor queries.
+
+#ifndef GTYPES_RECT_QUADTREE_H
+#define GTYPES_RECT_QUADTREE_H
+
+#include <vector>
+
+#include "gtypesExport.h"
+#include "Rectangle.h"
+#include "Vector2.h"
+
+namespace gtypes
+{
+	/// @brief Represents a loose quadtree over Rectangles for overlap, point and nearest neighbor queries.
+	/// @note Every node covers its cell extended by half a cell on each side. A Rectangle is stored in the deepest node
+	/// whose cell is at least as large as the Rectangle and holds its center, so its node follows directly from its size
+	/// and position without searching and nodes never need to be split or merged.
+	/// @note Rectangles with their center outside of the bounds are stored in the root and are checked by every query.
+	/// @note Nodes are created on demand and the children of a node are released once nothing below it is left, the
+	/// released nodes are reused by later insertions.
+	/// @note Queries return the ids from insert() or the indices into the array of the last build().
+	template <typename T>
+	class RectQuadtree
+	{
+	public:
+		/// @brief Basic constructor, creates an empty RectQuadtree with empty bounds that stores everything in the root.
+		inline RectQuadtree() :
+			maxDepth(0),
+			count(0),
+			_freeItem(-1)
+		{
+			this->reset(Rectangle<T>(), 0);
+		}
+		/// @brief Constructor.
+		/// @param[in] bounds The area covered by the cells.
+		/// @param[in] maxDepth Maximum number of levels below the root, clamped to [0,15].
+		inline RectQuadtree(const Rectangle<T>& bounds, int maxDepth = 8) :
+			maxDepth(0),
+			count(0),
+			_freeItem(-1)
+		{
+			this->reset(bounds, maxDepth);
+		}
+
+		/// @return The area covered by the cells.
+		inline const Rectangle<T>& getBounds() const { return this->bounds; }
+		/// @return The maximum number of levels below the root.
+		inline int getMaxDepth() const { return this->maxDepth; }
+		/// @return The number of stored Rectangles.
+		inline int getCount() const { return this->count; }
+		/// @return The number of nodes in use, including the root.
+		inline int getNodeCount() const { return (int)(this->nodes.size() - this->_freeNodes.size() * 4); }
+		/// @param[in] id The id of a Rectangle.
+		/// @return True if id belongs to a stored Rectangle.
+		inline bool isValid(int id) const { return (id >= 0 && id < (int)this->items.size() && this->items[id].node >= 0); }
+		/// @param[in] id The id of a stored Rectangle.
+		/// @return The Rectangle.
+		inline const Rectangle<T>& getRectangle(int id) const { return this->items[id].rectangle; }
+
+		/// @brief Removes all Rectangles and changes the covered area.
+		/// @param[in] bounds The area covered by the cells.
+		/// @param[in] maxDepth Maximum number of levels below the root, clamped to [0,15].
+		inline void reset(const Rectangle<T>& bounds, int maxDepth)
+		{
+			this->bounds = bounds;
+			// cell coordinates of the deepest level have to fit into an int
+			this->maxDepth = (maxDepth > 0 ? (maxDepth < 15 ? maxDepth : 15) : 0);
+			this->clear();
+		}
+		/// @brief Removes all Rectangles.
+		/// @note Keeps the allocated memory.
+		inline void clear()
+		{
+			this->nodes.resize(1);
+			this->nodes[0] = Node();
+			this->items.clear();
+			this->_freeNodes.clear();
+			this->_freeItem = -1;
+			this->count = 0;
+		}
+
+		/// @brief Adds a Rectangle.
+		/// @param[in] rectangle The Rectangle.
+		/// @return The id of the Rectangle, ids of removed Rectangles are reused.
+		inline int insert(const Rectangle<T>& rectangle)
+		{
+			int id = this->_freeItem;
+			if (id >= 0)
+			{
+				this->_freeItem = this->items[id].next;
+			}
+			else
+			{
+				id = (int)this->items.size();
+				this->items.push_back(Item());
+			}
+			Item& item = this->items[id];
+			item.rectangle = rectangle;
+			this->_locate(rectangle, item.depth, item.column, item.row);
+			this->_attach(id, this->_findNode(item.depth, item.column, item.row));
+			++this->count;
+			return id;
+		}
+		/// @brief Removes a Rectangle.
+		/// @param[in] id The id of the Rectangle.
+		/// @return True if the Rectangle was removed, false if id was invalid.
+		inline bool remove(int id)
+		{
+			if (!this->isValid(id))
+			{
+				return false;
+			}
+			int node = this->items[id].node;
+			this->_detach(id);
+			this->_decrement(node);
+			this->items[id].node = -1;
+			this->items[id].next = this->_freeItem;
+			this->_freeItem = id;
+			--this->count;
+			return true;
+		}
+		/// @brief Changes a stored Rectangle.
+		/// @param[in] id The id of the Rectangle.
+		/// @param[in] rectangle The new Rectangle.
+		/// @return True if the Rectangle was changed, false if id was invalid.
+		/// @note Only updates the Rectangle if it stays within the same cell and level, which is the common case for small
+		/// movements. Otherwise it is relinked and only the nodes along the old and the new path are touched.
+		inline bool move(int id, const Rectangle<T>& rectangle)
+		{
+			if (!this->isValid(id))
+			{
+				return false;
+			}
+			int depth = 0;
+			int column = 0;
+			int row = 0;
+			this->_locate(rectangle, depth, column, row);
+			Item& item = this->items[id];
+			item.rectangle = rectangle;
+			if (depth == item.depth && column == item.column && row == item.row)
+			{
+				return true;
+			}
+			item.depth = depth;
+			item.column = column;
+			item.row = row;
+			// counting the new path before uncounting the old one keeps shared ancestors from being released
+			int node = item.node;
+			this->_detach(id);
+			this->_attach(id, this->_findNode(depth, column, row));
+			this->_decrement(node);
+			return true;
+		}
+
+		/// @brief Removes all Rectangles and adds new ones in bulk.
+		/// @param[in] rectangles The Rectangles.
+		/// @param[in] count Number of Rectangles.
+		/// @note The id of every Rectangle is its index in the array, the array does not need to stay valid.
+		/// @note Faster than inserting one by one since the node counts are summed up once at the end.
+		inline void build(const Rectangle<T>* rectangles, int count)
+		{
+			this->clear();
+			this->items.resize(count > 0 ? count : 0);
+			// backwards so the lists of every node are in ascending order
+			for (int i = count - 1; i >= 0; --i)
+			{
+				Item& item = this->items[i];
+				item.rectangle = rectangles[i];
+				this->_locate(rectangles[i], item.depth, item.column, item.row);
+				int node = this->_findNode(item.depth, item.column, item.row);
+				item.node = node;
+				item.previous = -1;
+				item.next = this->nodes[node].first;
+				if (item.next >= 0)
+				{
+					this->items[item.next].previous = i;
+				}
+				this->nodes[node].first = i;
+				++this->nodes[node].count;
+			}
+			// children are always created after their parents
+			for (int i = (int)this->nodes.size() - 1; i > 0; --i)
+			{
+				this->nodes[this->nodes[i].parent].count += this->nodes[i].count;
+			}
+			this->count = (count > 0 ? count : 0);
+		}
+		/// @brief Removes all Rectangles and adds new ones in bulk.
+		/// @param[in] rectangles The Rectangles.
+		inline void build(const std::vector<Rectangle<T> >& rectangles)
+		{
+			this->build(rectangles.size() > 0 ? &rectangles[0] : NULL, (int)rectangles.size());
+		}
+
+		/// @brief Finds all Rectangles intersecting a Rectangle.
+		/// @param[in] rectangle The Rectangle.
+		/// @param[out] result Buffer for the ids.
+		/// @param[in] maxCount Size of the buffer.
+		/// @return Number of Rectangles found, can be larger than maxCount in which case only maxCount ids were written.
+		/// @note Uses the same test as Rectangle::intersects(), touching edges do not count.
+		inline int findIntersecting(const Rectangle<T>& rectangle, int* result, int maxCount) const
+		{
+			if (this->count == 0)
+			{
+				return 0;
+			}
+			return this->_findIntersecting(0, (double)this->bounds.x, (double)this->bounds.y, (double)this->bounds.w, (double)this->bounds.h,
+				rectangle, result, maxCount, 0);
+		}
+		/// @brief Finds all Rectangles intersecting a Rectangle.
+		/// @param[in] rectangle The Rectangle.
+		/// @param[out] result The ids, replaces the previous content.
+		/// @note Uses the same test as Rectangle::intersects(), touching edges do not count.
+		inline void findIntersecting(const Rectangle<T>& rectangle, std::vector<int>& result) const
+		{
+			// the previous capacity is usually enough for repeated queries
+			result.resize(result.capacity() > 0 ? result.capacity() : 16);
+			int found = this->findIntersecting(rectangle, &result[0], (int)result.size());
+			if (found > (int)result.size())
+			{
+				result.resize(found);
+				this->findIntersecting(rectangle, &result[0], found);
+			}
+			result.resize(found);
+		}
+		/// @brief Finds all Rectangles containing a point.
+		/// @param[in] point The point.
+		/// @param[out] result Buffer for the ids.
+		/// @param[in] maxCount Size of the buffer.
+		/// @return Number of Rectangles found, can be larger than maxCount in which case only maxCount ids were written.
+		/// @note Uses the same test as Rectangle::isPointInside(), the right and bottom edges are outside.
+		inline int findAt(const Vector2<T>& point, int* result, int maxCount) const
+		{
+			if (this->count == 0)
+			{
+				return 0;
+			}
+			return this->_findAt(0, (double)this->bounds.x, (double)this->bounds.y, (double)this->bounds.w, (double)this->bounds.h,
+				point, result, maxCount, 0);
+		}
+		/// @brief Finds all Rectangles containing a point.
+		/// @param[in] point The point.
+		/// @param[out] result The ids, replaces the previous content.
+		/// @note Uses the same test as Rectangle::isPointInside(), the right and bottom edges are outside.
+		inline void findAt(const Vector2<T>& point, std::vector<int>& result) const
+		{
+			result.resize(result.capacity() > 0 ? result.capacity() : 16);
+			int found = this->findAt(point, &result[0], (int)result.size());
+			if (found > (int)result.size())
+			{
+				result.resize(found);
+				this->findAt(point, &result[0], found);
+			}
+			result.resize(found);
+		}
+		/// @brief Finds the Rectangles closest to a point.
+		/// @param[in] point The point.
+		/// @param[in] count Maximum number of Rectangles to find.
+		/// @param[out] result Buffer of at least count elements for the ids, sorted from the closest.
+		/// @param[out] squaredDistances Buffer of at least count elements for the squared distances of the found Rectangles.
+		/// @return Number of Rectangles found, the smaller one of count and getCount().
+		/// @note The distance is measured to the closest point of a Rectangle, it is 0 for Rectangles containing the point.
+		/// @note Visits the closer children first and skips every node that is farther away than the last found Rectangle.
+		inline int findNearest(const Vector2<T>& point, int count, int* result, double* squaredDistances) const
+		{
+			if (count <= 0 || this->count == 0)
+			{
+				return 0;
+			}
+			return this->_findNearest(0, (double)this->bounds.x, (double)this->bounds.y, (double)this->bounds.w, (double)this->bounds.h,
+				(double)point.x, (double)point.y, count, result, squaredDistances, 0);
+		}
+
+	protected:
+		/// @brief A node of the tree.
+		struct Node
+		{
+			/// @brief Index of the parent node, -1 for the root.
+			int parent;
+			/// @brief Index of the first of the 4 consecutive children, -1 if there are none.
+			int children;
+			/// @brief Id of the first Rectangle stored in this node, -1 if there is none.
+			int first;
+			/// @brief Number of Rectangles stored in this node and all nodes below it.
+			int count;
+
+			/// @brief Basic constructor.
+			inline Node() : parent(-1), children(-1), first(-1), count(0) { }
+		};
+		/// @brief A stored Rectangle.
+		struct Item
+		{
+			/// @brief The Rectangle.
+			Rectangle<T> rectangle;
+			/// @brief Index of the node, -1 if the id is free.
+			int node;
+			/// @brief Previous Rectangle in the same node, -1 for the first one.
+			int previous;
+			/// @brief Next Rectangle in the same node, -1 for the last one. The next free id if this one is free.
+			int next;
+			/// @brief Level of the node.
+			int depth;
+			/// @brief Column of the cell on its level.
+			int column;
+			/// @brief Row of the cell on its level.
+			int row;
+
+			/// @brief Basic constructor.
+			inline Item() : node(-1), previous(-1), next(-1), depth(0), column(0), row(0) { }
+		};
+
+		/// @brief The area covered by the cells.
+		Rectangle<T> bounds;
+		/// @brief Maximum number of levels below the root.
+		int maxDepth;
+		/// @brief Number of stored Rectangles.
+		int count;
+		/// @brief The nodes, the root is the first one.
+		std::vector<Node> nodes;
+		/// @brief The Rectangles indexed by id.
+		std::vector<Item> items;
+
+		/// @brief Calculates the level and cell of a Rectangle.
+		/// @param[in] rectangle The Rectangle.
+		/// @param[out] depth Level of the node.
+		/// @param[out] column Column of the cell on its level.
+		/// @param[out] row Row of the cell on its level.
+		inline void _locate(const Rectangle<T>& rectangle, int& depth, int& column, int& row) const
+		{
+			depth = 0;
+			column = 0;
+			row = 0;
+			double width = (double)this->bounds.w;
+			double height = (double)this->bounds.h;
+			if (width <= 0.0 || height <= 0.0)
+			{
+				return;
+			}
+			double x = (double)rectangle.x + (double)rectangle.w * 0.5 - (double)this->bounds.x;
+			double y = (double)rectangle.y + (double)rectangle.h * 0.5 - (double)this->bounds.y;
+			// no loose cell holds a Rectangle centered outside of the bounds, NaN ends up in the root as well
+			if (!(x >= 0.0 && y >= 0.0 && x <= width && y <= height))
+			{
+				return;
+			}
+			while (depth < this->maxDepth && (double)rectangle.w <= width * 0.5 && (double)rectangle.h <= height * 0.5)
+			{
+				++depth;
+				width *= 0.5;
+				height *= 0.5;
+			}
+			int last = (1 << depth) - 1;
+			column = (int)(x / width);
+			row = (int)(y / height);
+			column = (column < last ? column : last);
+			row = (row < last ? row : last);
+		}
+		/// @brief Finds the node of a cell and creates the missing nodes on the way.
+		/// @param[in] depth Level of the node.
+		/// @param[in] column Column of the cell on its level.
+		/// @param[in] row Row of the cell on its level.
+		/// @return Index of the node.
+		inline int _findNode(int depth, int column, int row)
+		{
+			int node = 0;
+			for (int level = depth - 1; level >= 0; --level)
+			{
+				if (this->nodes[node].children < 0)
+				{
+					this->_createChildren(node);
+				}
+				node = this->nodes[node].children + (((column >> level) & 1) | (((row >> level) & 1) << 1));
+			}
+			return node;
+		}
+		/// @brief Creates the 4 children of a node, reuses released nodes if possible.
+		/// @param[in] node Index of the node.
+		inline void _createChildren(int node)
+		{
+			int children = (int)this->nodes.size();
+			if (this->_freeNodes.size() > 0)
+			{
+				children = this->_freeNodes.back();
+				this->_freeNodes.pop_back();
+			}
+			else
+			{
+				this->nodes.resize(children + 4);
+			}
+			for (int i = children; i < children + 4; ++i)
+			{
+				this->nodes[i] = Node();
+				this->nodes[i].parent = node;
+			}
+			this->nodes[node].children = children;
+		}
+		/// @brief Releases all nodes below a node.
+		/// @param[in] node Index of the node.
+		inline void _releaseChildren(int node)
+		{
+			int children = this->nodes[node].children;
+			for (int i = children; i < children + 4; ++i)
+			{
+				if (this->nodes[i].children >= 0)
+				{
+					this->_releaseChildren(i);
+				}
+			}
+			this->_freeNodes.push_back(children);
+			this->nodes[node].children = -1;
+		}
+		/// @brief Adds a Rectangle to the front of the list of a node and counts it in the node and all nodes above it.
+		/// @param[in] id The id of the Rectangle.
+		/// @param[in] node Index of the node.
+		inline void _attach(int id, int node)
+		{
+			Item& item = this->items[id];
+			item.node = node;
+			item.previous = -1;
+			item.next = this->nodes[node].first;
+			if (item.next >= 0)
+			{
+				this->items[item.next].previous = id;
+			}
+			this->nodes[node].first = id;
+			for (; node >= 0; node = this->nodes[node].parent)
+			{
+				++this->nodes[node].count;
+			}
+		}
+		/// @brief Removes a Rectangle from the list of its node without changing any counts.
+		/// @param[in] id The id of the Rectangle.
+		inline void _detach(int id)
+		{
+			const Item& item = this->items[id];
+			if (item.previous >= 0)
+			{
+				this->items[item.previous].next = item.next;
+			}
+			else
+			{
+				this->nodes[item.node].first = item.next;
+			}
+			if (item.next >= 0)
+			{
+				this->items[item.next].previous = item.previous;
+			}
+		}
+		/// @brief Uncounts a Rectangle in a node and all nodes above it and releases the nodes below the topmost empty one.
+		/// @param[in] node Index of the node.
+		inline void _decrement(int node)
+		{
+			int empty = -1;
+			for (; node >= 0; node = this->nodes[node].parent)
+			{
+				if (--this->nodes[node].count == 0)
+				{
+					empty = node;
+				}
+			}
+			if (empty >= 0 && this->nodes[empty].children >= 0)
+			{
+				this->_releaseChildren(empty);
+			}
+		}
+		/// @brief Finds all Rectangles intersecting a Rectangle in a node and all nodes below it.
+		/// @param[in] node Index of the node.
+		/// @param[in] x Left edge of the cell.
+		/// @param[in] y Top edge of the cell.
+		/// @param[in] width Width of the cell.
+		/// @param[in] height Height of the cell.
+		/// @param[in] rectangle The Rectangle.
+		/// @param[out] result Buffer for the ids.
+		/// @param[in] maxCount Size of the buffer.
+		/// @param[in] found Number of Rectangles found so far.
+		/// @return Number of Rectangles found.
+		inline int _findIntersecting(int node, double x, double y, double width, double height, const Rectangle<T>& rectangle,
+			int* result, int maxCount, int found) const
+		{
+			const Node& current = this->nodes[node];
+			for (int id = current.first; id >= 0; id = this->items[id].next)
+			{
+				if (this->items[id].rectangle.intersects(rectangle))
+				{
+					if (found < maxCount)
+					{
+						result[found] = id;
+					}
+					++found;
+				}
+			}
+			if (current.children < 0)
+			{
+				return found;
+			}
+			width *= 0.5;
+			height *= 0.5;
+			double left = (double)rectangle.x;
+			double top = (double)rectangle.y;
+			double right = left + (double)rectangle.w;
+			double bottom = top + (double)rectangle.h;
+			for (int i = 0; i < 4; ++i)
+			{
+				double childX = x + (double)(i & 1) * width;
+				double childY = y + (double)(i >> 1) * height;
+				// the loose bounds extend half a cell beyond the cell
+				if (this->nodes[current.children + i].count > 0 && left <= childX + width * 1.5 && right >= childX - width * 0.5 &&
+					top <= childY + height * 1.5 && bottom >= childY - height * 0.5)
+				{
+					found = this->_findIntersecting(current.children + i, childX, childY, width, height, rectangle, result, maxCount, found);
+				}
+			}
+			return found;
+		}
+		/// @brief Finds all Rectangles containing a point in a node and all nodes below it.
+		/// @param[in] node Index of the node.
+		/// @param[in] x Left edge of the cell.
+		/// @param[in] y Top edge of the cell.
+		/// @param[in] width Width of the cell.
+		/// @param[in] height Height of the cell.
+		/// @param[in] point The point.
+		/// @param[out] result Buffer for the ids.
+		/// @param[in] maxCount Size of the buffer.
+		/// @param[in] found Number of Rectangles found so far.
+		/// @return Number of Rectangles found.
+		inline int _findAt(int node, double x, double y, double width, double height, const Vector2<T>& point, int* result,
+			int maxCount, int found) const
+		{
+			const Node& current = this->nodes[node];
+			for (int id = current.first; id >= 0; id = this->items[id].next)
+			{
+				if (this->items[id].rectangle.isPointInside(point.x, point.y))
+				{
+					if (found < maxCount)
+					{
+						result[found] = id;
+					}
+					++found;
+				}
+			}
+			if (current.children < 0)
+			{
+				return found;
+			}
+			width *= 0.5;
+			height *= 0.5;
+			double pointX = (double)point.x;
+			double pointY = (double)point.y;
+			for (int i = 0; i < 4; ++i)
+			{
+				double childX = x + (double)(i & 1) * width;
+				double childY = y + (double)(i >> 1) * height;
+				if (this->nodes[current.children + i].count > 0 && pointX >= childX - width * 0.5 && pointX <= childX + width * 1.5 &&
+					pointY >= childY - height * 0.5 && pointY <= childY + height * 1.5)
+				{
+					found = this->_findAt(current.children + i, childX, childY, width, height, point, result, maxCount, found);
+				}
+			}
+			return found;
+		}
+		/// @brief Finds the Rectangles closest to a point in a node and all nodes below it.
+		/// @param[in] node Index of the node.
+		/// @param[in] x Left edge of the cell.
+		/// @param[in] y Top edge of the cell.
+		/// @param[in] width Width of the cell.
+		/// @param[in] height Height of the cell.
+		/// @param[in] pointX X coordinate of the point.
+		/// @param[in] pointY Y coordinate of the point.
+		/// @param[in] count Maximum number of Rectangles to find.
+		/// @param[in,out] result The ids found so far, sorted from the closest.
+		/// @param[in,out] squaredDistances The squared distances of the Rectangles found so far.
+		/// @param[in] found Number of Rectangles found so far.
+		/// @return Number of Rectangles found.
+		inline int _findNearest(int node, double x, double y, double width, double height, double pointX, double pointY, int count,
+			int* result, double* squaredDistances, int found) const
+		{
+			const Node& current = this->nodes[node];
+			for (int id = current.first; id >= 0; id = this->items[id].next)
+			{
+				const Rectangle<T>& rectangle = this->items[id].rectangle;
+				double distance = _squaredDistance((double)rectangle.x, (double)rectangle.y, (double)rectangle.x + (double)rectangle.w,
+					(double)rectangle.y + (double)rectangle.h, pointX, pointY);
+				if (found < count || distance < squaredDistances[found - 1])
+				{
+					int i = (found < count ? found++ : found - 1);
+					for (; i > 0 && squaredDistances[i - 1] > distance; --i)
+					{
+						squaredDistances[i] = squaredDistances[i - 1];
+						result[i] = result[i - 1];
+					}
+					squaredDistances[i] = distance;
+					result[i] = id;
+				}
+			}
+			if (current.children < 0)
+			{
+				return found;
+			}
+			width *= 0.5;
+			height *= 0.5;
+			int order[4];
+			double distances[4];
+			int size = 0;
+			for (int i = 0; i < 4; ++i)
+			{
+				if (this->nodes[current.children + i].count > 0)
+				{
+					double childX = x + (double)(i & 1) * width;
+					double childY = y + (double)(i >> 1) * height;
+					double distance = _squaredDistance(childX - width * 0.5, childY - height * 0.5, childX + width * 1.5, childY + height * 1.5,
+						pointX, pointY);
+					int j = size++;
+					for (; j > 0 && distances[j - 1] > distance; --j)
+					{
+						distances[j] = distances[j - 1];
+						order[j] = order[j - 1];
+					}
+					distances[j] = distance;
+					order[j] = i;
+				}
+			}
+			for (int i = 0; i < size; ++i)
+			{
+				// the children are sorted so the remaining ones are even farther away
+				if (found == count && distances[i] >= squaredDistances[found - 1])
+				{
+					break;
+				}
+				found = this->_findNearest(current.children + order[i], x + (double)(order[i] & 1) * width, y + (double)(order[i] >> 1) * height,
+					width, height, pointX, pointY, count, result, squaredDistances, found);
+			}
+			return found;
+		}
+		/// @brief Calculates the squared distance between a point and an area.
+		/// @param[in] left Left edge of the area.
+		/// @param[in] top Top edge of the area.
+		/// @param[in] right Right edge of the area.
+		/// @param[in] bottom Bottom edge of the area.
+		/// @param[in] pointX X coordinate of the point.
+		/// @param[in] pointY Y coordinate of the point.
+		/// @return The squared distance, 0 if the point is inside.
+		inline static double _squaredDistance(double left, double top, double right, double bottom, double pointX, double pointY)
+		{
+			double dx = (pointX < left ? left - pointX : (pointX > right ? pointX - right : 0.0));
+			double dy = (pointY < top ? top - pointY : (pointY > bottom ? pointY - bottom : 0.0));
+			return (dx * dx + dy * dy);
+		}
+
+	private:
+		/// @brief First child index of every released group of 4 nodes.
+		/// @note Used internally only.
+		std::vector<int> _freeNodes;
+		/// @brief The first free id, -1 if there is none.
+		/// @note Used internally only.
+		int _freeItem;
+
+	};
+
+}
+
+/// @brief Typedef for simpler code.
+typedef gtypes::RectQuadtree<int> gquadtreei;
+/// @brief Typedef for simpler code.
+typedef const gtypes::RectQuadtree<int>& cgquadtreei;
+/// @brief Typedef for simpler code.
+typedef gtypes::RectQuadtree<float> gquadtreef;
+/// @brief Typedef for simpler code.
+typedef const gtypes::RectQuadtree<float>& cgquadtreef;
+
+#endif
@@ -0,0 +1,593 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents an arbitrary area as disjoint Rectangles sorted into horizontal bands.
+
+#ifndef GTYPES_RECT_REGION_H
+#define GTYPES_RECT_REGION_H
+
+#include <vector>
+
+#include "gtypesExport.h"
+#include "Rectangle.h"
+#include "Vector2.h"
+
+/// @def GTYPES_RECT_REGION_INLINE_COUNT
+/// @brief Number of Rectangles a RectRegion stores without allocating memory.
+#ifndef GTYPES_RECT_REGION_INLINE_COUNT
+	#define GTYPES_RECT_REGION_INLINE_COUNT 8
+#endif
+
+namespace gtypes
+{
+	/// @brief Represents an arbitrary area as disjoint Rectangles sorted into horizontal bands.
+	/// @note The Rectangles are split into bands in which all of them have the same top edge and height. The bands are sorted
+	/// from top to bottom and the Rectangles within a band from left to right. Touching Rectangles within a band and touching
+	/// bands with the same Rectangles are always joined, so equal areas have equal Rectangles.
+	/// @note Union, difference and intersection walk both regions band by band in one linear pass, like the regions of X11.
+	/// @note Up to GTYPES_RECT_REGION_INLINE_COUNT Rectangles are stored inside the object, only larger regions allocate memory.
+	/// @note All edges are half-open like in Rectangle::isPointInside(), Rectangles without area are ignored.
+	template <typename T>
+	class RectRegion
+	{
+	public:
+		/// @brief Basic constructor, creates an empty RectRegion.
+		inline RectRegion() :
+			count(0),
+			_data(_inline),
+			_capacity(GTYPES_RECT_REGION_INLINE_COUNT)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] rectangle The area of the RectRegion.
+		inline RectRegion(const Rectangle<T>& rectangle) :
+			count(0),
+			_data(_inline),
+			_capacity(GTYPES_RECT_REGION_INLINE_COUNT)
+		{
+			if (rectangle.w > 0 && rectangle.h > 0)
+			{
+				this->_data[0] = rectangle;
+				this->extent = rectangle;
+				this->count = 1;
+			}
+		}
+		/// @brief Copy constructor.
+		/// @param[in] other The other RectRegion.
+		inline RectRegion(const RectRegion<T>& other) :
+			count(0),
+			_data(_inline),
+			_capacity(GTYPES_RECT_REGION_INLINE_COUNT)
+		{
+			this->_copy(other);
+		}
+
+		/// @return The number of Rectangles.
+		inline int getCount() const { return this->count; }
+		/// @return True if the area is empty.
+		inline bool isEmpty() const { return (this->count == 0); }
+		/// @return The Rectangles sorted by bands from top to bottom and from left to right.
+		inline const Rectangle<T>* getRectangles() const { return this->_data; }
+		/// @param[in] index The index of a Rectangle.
+		/// @return The Rectangle.
+		inline const Rectangle<T>& getRectangle(int index) const { return this->_data[index]; }
+		/// @return The bounding box, an empty Rectangle if the area is empty.
+		inline const Rectangle<T>& getExtent() const { return this->extent; }
+		/// @return The size of the area.
+		inline double getArea() const
+		{
+			double result = 0.0;
+			for (int i = 0; i < this->count; ++i)
+			{
+				result += (double)this->_data[i].w * this->_data[i].h;
+			}
+			return result;
+		}
+
+		/// @brief Makes the area empty.
+		/// @note Keeps the allocated memory.
+		inline void clear()
+		{
+			this->count = 0;
+			this->extent = Rectangle<T>();
+		}
+		/// @brief Checks a point is inside the area.
+		/// @param[in] x X coordinate.
+		/// @param[in] y Y coordinate.
+		/// @return True if the point is inside the area.
+		/// @note Finds the band with a binary search.
+		inline bool isPointInside(T x, T y) const
+		{
+			if (!this->extent.isPointInside(x, y))
+			{
+				return false;
+			}
+			// first Rectangle below the point, the band of the point ends right before it
+			int low = 0;
+			int high = this->count;
+			int middle = 0;
+			while (low < high)
+			{
+				middle = (low + high) / 2;
+				if (this->_data[middle].y <= y)
+				{
+					low = middle + 1;
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+			if (low == 0)
+			{
+				return false;
+			}
+			T top = this->_data[low - 1].y;
+			for (int i = low - 1; i >= 0 && this->_data[i].y == top; --i)
+			{
+				if (this->_data[i].isPointInside(x, y))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+		/// @brief Checks a point is inside the area.
+		/// @param[in] position The point's position.
+		/// @return True if the point is inside the area.
+		inline bool isPointInside(const Vector2<T>& position) const
+		{
+			return this->isPointInside(position.x, position.y);
+		}
+
+		/// @brief Adds another area to this one.
+		/// @param[in] other The other RectRegion.
+		inline void unite(const RectRegion<T>& other)
+		{
+			this->_apply(other, OperationUnion);
+		}
+		/// @brief Removes another area from this one.
+		/// @param[in] other The other RectRegion.
+		inline void subtract(const RectRegion<T>& other)
+		{
+			this->_apply(other, OperationSubtract);
+		}
+		/// @brief Reduces this area to the part that is also inside another one.
+		/// @param[in] other The other RectRegion.
+		inline void intersect(const RectRegion<T>& other)
+		{
+			this->_apply(other, OperationIntersect);
+		}
+		/// @brief Creates a new RectRegion with the area of this one and another one.
+		/// @param[in] other The other RectRegion.
+		/// @return The new RectRegion.
+		inline RectRegion<T> united(const RectRegion<T>& other) const
+		{
+			RectRegion<T> result;
+			_combine(*this, other, OperationUnion, result);
+			return result;
+		}
+		/// @brief Creates a new RectRegion with the area of this one without another one.
+		/// @param[in] other The other RectRegion.
+		/// @return The new RectRegion.
+		inline RectRegion<T> subtracted(const RectRegion<T>& other) const
+		{
+			RectRegion<T> result;
+			_combine(*this, other, OperationSubtract, result);
+			return result;
+		}
+		/// @brief Creates a new RectRegion with the area that is inside this one and another one.
+		/// @param[in] other The other RectRegion.
+		/// @return The new RectRegion.
+		inline RectRegion<T> intersected(const RectRegion<T>& other) const
+		{
+			RectRegion<T> result;
+			_combine(*this, other, OperationIntersect, result);
+			return result;
+		}
+
+		/// @brief Assignment operator.
+		/// @param[in] other The other RectRegion.
+		/// @return This RectRegion.
+		inline RectRegion<T>& operator=(const RectRegion<T>& other)
+		{
+			if (this != &other)
+			{
+				this->_copy(other);
+			}
+			return (*this);
+		}
+		/// @brief Checks if two RectRegions cover the same area.
+		/// @param[in] other The other RectRegion.
+		/// @return True if the two RectRegions are equal.
+		/// @note Beware of floating point errors.
+		inline bool operator==(const RectRegion<T>& other) const
+		{
+			if (this->count != other.count)
+			{
+				return false;
+			}
+			for (int i = 0; i < this->count; ++i)
+			{
+				if (this->_data[i] != other._data[i])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+		/// @brief Checks if two RectRegions cover different areas.
+		/// @param[in] other The other RectRegion.
+		/// @return True if the two RectRegions are not equal.
+		/// @note Beware of floating point errors.
+		inline bool operator!=(const RectRegion<T>& other) const
+		{
+			return !(*this == other);
+		}
+
+	protected:
+		/// @brief A region operation.
+		enum Operation
+		{
+			/// @brief Keeps what is in either area.
+			OperationUnion = 0,
+			/// @brief Keeps what is in the first area but not in the second one.
+			OperationSubtract,
+			/// @brief Keeps what is in both areas.
+			OperationIntersect
+		};
+
+		/// @brief Number of Rectangles.
+		int count;
+		/// @brief The bounding box.
+		Rectangle<T> extent;
+
+		/// @brief Replaces this area with the result of an operation with another one.
+		/// @param[in] other The other RectRegion.
+		/// @param[in] operation The operation.
+		inline void _apply(const RectRegion<T>& other, Operation operation)
+		{
+			RectRegion<T> result;
+			_combine(*this, other, operation, result);
+			this->_take(result);
+		}
+		/// @brief Copies the Rectangles of another RectRegion.
+		/// @param[in] other The other RectRegion.
+		inline void _copy(const RectRegion<T>& other)
+		{
+			this->_reserve(other.count);
+			for (int i = 0; i < other.count; ++i)
+			{
+				this->_data[i] = other._data[i];
+			}
+			this->count = other.count;
+			this->extent = other.extent;
+		}
+		/// @brief Moves the Rectangles of another RectRegion into this one, allocated memory is taken over.
+		/// @param[in,out] other The other RectRegion, its content is undefined afterwards.
+		inline void _take(RectRegion<T>& other)
+		{
+			if (other._data == other._inline || other._capacity <= this->_capacity)
+			{
+				this->_copy(other);
+				return;
+			}
+			this->_heap.swap(other._heap);
+			this->_data = &this->_heap[0];
+			this->_capacity = other._capacity;
+			this->count = other.count;
+			this->extent = other.extent;
+		}
+		/// @brief Makes sure a number of Rectangles fits into the storage.
+		/// @param[in] capacity Number of Rectangles.
+		inline void _reserve(int capacity)
+		{
+			if (capacity <= this->_capacity)
+			{
+				return;
+			}
+			int newCapacity = this->_capacity * 2;
+			if (newCapacity < capacity)
+			{
+				newCapacity = capacity;
+			}
+			std::vector<Rectangle<T> > heap(newCapacity);
+			for (int i = 0; i < this->count; ++i)
+			{
+				heap[i] = this->_data[i];
+			}
+			this->_heap.swap(heap);
+			this->_data = &this->_heap[0];
+			this->_capacity = newCapacity;
+		}
+		/// @brief Appends a Rectangle to the current band and joins it with the previous one if they touch.
+		/// @param[in] bandStart Index of the first Rectangle of the current band.
+		/// @param[in] left Left edge.
+		/// @param[in] right Right edge.
+		/// @param[in] top Top edge of the band.
+		/// @param[in] bottom Bottom edge of the band.
+		inline void _pushSpan(int bandStart, T left, T right, T top, T bottom)
+		{
+			if (this->count > bandStart && this->_data[this->count - 1].right() >= left)
+			{
+				Rectangle<T>& last = this->_data[this->count - 1];
+				if (right > last.right())
+				{
+					last.w = right - last.x;
+				}
+				return;
+			}
+			this->_reserve(this->count + 1);
+			this->_data[this->count].set(left, top, right - left, bottom - top);
+			++this->count;
+		}
+		/// @brief Finishes the current band and joins it with the previous band if they touch and have the same Rectangles.
+		/// @param[in] bandStart Index of the first Rectangle of the current band.
+		/// @param[in,out] previousBand Index of the first Rectangle of the previous band, -1 if there is none.
+		inline void _finishBand(int bandStart, int& previousBand)
+		{
+			if (this->count == bandStart)
+			{
+				return;
+			}
+			if (previousBand >= 0 && bandStart - previousBand == this->count - bandStart &&
+				this->_data[previousBand].bottom() == this->_data[bandStart].y)
+			{
+				bool same = true;
+				for (int i = 0; i < bandStart - previousBand && same; ++i)
+				{
+					same = (this->_data[previousBand + i].x == this->_data[bandStart + i].x && this->_data[previousBand + i].w == this->_data[bandStart + i].w);
+				}
+				if (same)
+				{
+					T height = this->_data[bandStart].bottom() - this->_data[previousBand].y;
+					for (int i = previousBand; i < bandStart; ++i)
+					{
+						this->_data[i].h = height;
+					}
+					this->count = bandStart;
+					return;
+				}
+			}
+			previousBand = bandStart;
+		}
+		/// @brief Calculates the bounding box of all Rectangles.
+		inline void _updateExtent()
+		{
+			if (this->count == 0)
+			{
+				this->extent = Rectangle<T>();
+				return;
+			}
+			// the first and the last band hold the top and the bottom edge, the sides can be in any band
+			T left = this->_data[0].x;
+			T right = this->_data[0].right();
+			for (int i = 1; i < this->count; ++i)
+			{
+				if (this->_data[i].x < left)
+				{
+					left = this->_data[i].x;
+				}
+				if (this->_data[i].right() > right)
+				{
+					right = this->_data[i].right();
+				}
+			}
+			T top = this->_data[0].y;
+			this->extent.set(left, top, right - left, this->_data[this->count - 1].bottom() - top);
+		}
+		/// @brief Finds the end of a band.
+		/// @param[in] region The RectRegion.
+		/// @param[in] start Index of the first Rectangle of the band.
+		/// @return Index after the last Rectangle of the band.
+		inline static int _findBandEnd(const RectRegion<T>& region, int start)
+		{
+			int result = start + 1;
+			while (result < region.count && region._data[result].y == region._data[start].y)
+			{
+				++result;
+			}
+			return result;
+		}
+		/// @brief Combines the Rectangles of two bands over a vertical section in which neither band changes.
+		/// @param[in] a The first RectRegion.
+		/// @param[in] aStart Index of the first Rectangle of the band of a, equal to aEnd if a has no band there.
+		/// @param[in] aEnd Index after the last Rectangle of the band of a.
+		/// @param[in] b The second RectRegion.
+		/// @param[in] bStart Index of the first Rectangle of the band of b, equal to bEnd if b has no band there.
+		/// @param[in] bEnd Index after the last Rectangle of the band of b.
+		/// @param[in] top Top edge of the section.
+		/// @param[in] bottom Bottom edge of the section.
+		/// @param[in] operation The operation.
+		/// @param[in,out] previousBand Index of the first Rectangle of the previous band in the result, -1 if there is none.
+		inline void _combineBands(const RectRegion<T>& a, int aStart, int aEnd, const RectRegion<T>& b, int bStart, int bEnd, T top, T bottom,
+			Operation operation, int& previousBand)
+		{
+			int bandStart = this->count;
+			int i = aStart;
+			int j = bStart;
+			if (operation == OperationUnion)
+			{
+				// merge by left edge, _pushSpan() joins the overlapping ones
+				while (i < aEnd || j < bEnd)
+				{
+					if (j >= bEnd || (i < aEnd && a._data[i].x <= b._data[j].x))
+					{
+						this->_pushSpan(bandStart, a._data[i].x, a._data[i].right(), top, bottom);
+						++i;
+					}
+					else
+					{
+						this->_pushSpan(bandStart, b._data[j].x, b._data[j].right(), top, bottom);
+						++j;
+					}
+				}
+			}
+			else if (operation == OperationIntersect)
+			{
+				T left = 0;
+				T right = 0;
+				while (i < aEnd && j < bEnd)
+				{
+					left = (a._data[i].x > b._data[j].x ? a._data[i].x : b._data[j].x);
+					right = (a._data[i].right() < b._data[j].right() ? a._data[i].right() : b._data[j].right());
+					if (left < right)
+					{
+						this->_pushSpan(bandStart, left, right, top, bottom);
+					}
+					if (a._data[i].right() < b._data[j].right())
+					{
+						++i;
+					}
+					else
+					{
+						++j;
+					}
+				}
+			}
+			else
+			{
+				T left = 0;
+				T right = 0;
+				for (; i < aEnd; ++i)
+				{
+					left = a._data[i].x;
+					right = a._data[i].right();
+					// the spans of b that end before this span cannot reach the next ones either
+					while (j < bEnd && b._data[j].right() <= left)
+					{
+						++j;
+					}
+					for (int k = j; k < bEnd && b._data[k].x < right; ++k)
+					{
+						if (b._data[k].x > left)
+						{
+							this->_pushSpan(bandStart, left, b._data[k].x, top, bottom);
+						}
+						if (b._data[k].right() > left)
+						{
+							left = b._data[k].right();
+						}
+					}
+					if (left < right)
+					{
+						this->_pushSpan(bandStart, left, right, top, bottom);
+					}
+				}
+			}
+			this->_finishBand(bandStart, previousBand);
+		}
+		/// @brief Combines two areas by walking their bands from top to bottom.
+		/// @param[in] a The first RectRegion.
+		/// @param[in] b The second RectRegion.
+		/// @param[in] operation The operation.
+		/// @param[out] result Receives the combined area, must not be a or b.
+		inline static void _combine(const RectRegion<T>& a, const RectRegion<T>& b, Operation operation, RectRegion<T>& result)
+		{
+			result.clear();
+			int previousBand = -1;
+			int aStart = 0;
+			int aEnd = (a.count > 0 ? _findBandEnd(a, 0) : 0);
+			T aTop = (a.count > 0 ? a._data[0].y : 0);
+			int bStart = 0;
+			int bEnd = (b.count > 0 ? _findBandEnd(b, 0) : 0);
+			T bTop = (b.count > 0 ? b._data[0].y : 0);
+			T bottom = 0;
+			bool aActive = false;
+			bool bActive = false;
+			while (aStart < a.count || bStart < b.count)
+			{
+				// the section ends where either band starts or ends, so both bands stay the same within it
+				aActive = (aStart < a.count && (bStart >= b.count || aTop <= bTop));
+				bActive = (bStart < b.count && (aStart >= a.count || bTop <= aTop));
+				if (aActive && bActive)
+				{
+					bottom = (a._data[aStart].bottom() < b._data[bStart].bottom() ? a._data[aStart].bottom() : b._data[bStart].bottom());
+				}
+				else if (aActive)
+				{
+					bottom = a._data[aStart].bottom();
+					if (bStart < b.count && bTop < bottom)
+					{
+						bottom = bTop;
+					}
+				}
+				else
+				{
+					bottom = b._data[bStart].bottom();
+					if (aStart < a.count && aTop < bottom)
+					{
+						bottom = aTop;
+					}
+				}
+				// sections with only one of the bands need no merging, but they go through the same code to keep it simple
+				if (operation == OperationUnion || (operation == OperationSubtract && aActive) || (aActive && bActive))
+				{
+					result._combineBands(a, aStart, (aActive ? aEnd : aStart), b, bStart, (bActive ? bEnd : bStart),
+						(aActive ? aTop : bTop), bottom, operation, previousBand);
+				}
+				if (aActive)
+				{
+					aTop = bottom;
+					if (aTop >= a._data[aStart].bottom())
+					{
+						aStart = aEnd;
+						if (aStart < a.count)
+						{
+							aEnd = _findBandEnd(a, aStart);
+							aTop = a._data[aStart].y;
+						}
+					}
+				}
+				if (bActive)
+				{
+					bTop = bottom;
+					if (bTop >= b._data[bStart].bottom())
+					{
+						bStart = bEnd;
+						if (bStart < b.count)
+						{
+							bEnd = _findBandEnd(b, bStart);
+							bTop = b._data[bStart].y;
+						}
+					}
+				}
+			}
+			result._updateExtent();
+		}
+
+	private:
+		/// @brief The Rectangles, either the inline storage or the allocated one.
+		/// @note Used internally only.
+		Rectangle<T>* _data;
+		/// @brief Number of Rectangles that fit into the current storage.
+		/// @note Used internally only.
+		int _capacity;
+		/// @brief Storage for small regions.
+		/// @note Used internally only.
+		Rectangle<T> _inline[GTYPES_RECT_REGION_INLINE_COUNT];
+		/// @brief Storage for large regions.
+		/// @note Used internally only.
+		std::vector<Rectangle<T> > _heap;
+
+	};
+
+}
+
+/// @brief Typedef for simpler code.
+typedef gtypes::RectRegion<int> grectregioni;
+/// @brief Typedef for simpler code.
+typedef const gtypes::RectRegion<int>& cgrectregioni;
+/// @brief Typedef for simpler code.
+typedef gtypes::RectRegion<float> grectregionf;
+/// @brief Typedef for simpler code.
+typedef const gtypes::RectRegion<float>& cgrectregionf;
+
+#endif
@@ -0,0 +1,250 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents a bulk loaded, read-only R-tree over Rectangles stored in flat arrays.
+
+#ifndef GTYPES_RECT_TREE_H
+#define GTYPES_RECT_TREE_H
+
+#include <stddef.h>
+#include <vector>
+
+#include "gtypesExport.h"
+#include "Rectangle.h"
+#include "Vector2.h"
+
+namespace gtypes
+{
+	/// @brief Represents a bulk loaded, read-only R-tree over Rectangles stored in flat arrays.
+	/// @note The Rectangles are sorted by the Hilbert keys of their centers and packed into full nodes level by level
+	/// (packed Hilbert R-tree), so there is no slack in the nodes and no pointers. The nodes are stored from the root
+	/// downwards in one array, the Rectangles in another one in Hilbert order.
+	/// @note The keys, the sort and the node bounds of the large lower levels are calculated on multiple threads.
+	/// @note The arrays can be saved into one block of memory and used directly from there with attach(), e.g. from a
+	/// memory-mapped file. The block uses the native byte order.
+	/// @note Available for Rectangle<int> and Rectangle<float>.
+	/// @note Queries return indices into the array that was used in the last build().
+	template <typename T>
+	class gtypesExport RectTree
+	{
+	public:
+		/// @brief A node of the tree.
+		struct Node
+		{
+			/// @brief Bounds of everything below the node.
+			Rectangle<T> bounds;
+			/// @brief Index of the first child node, or of the first Rectangle for nodes on the lowest level.
+			int first;
+			/// @brief Number of children.
+			int count;
+		};
+
+		/// @brief Basic constructor, creates an empty RectTree.
+		RectTree();
+		/// @brief Copy constructor.
+		/// @param[in] other The other RectTree.
+		/// @note A copy of an attached RectTree uses the same memory block.
+		RectTree(const RectTree<T>& other);
+
+		/// @return The number of Rectangles.
+		inline int getCount() const { return this->count; }
+		/// @return The number of nodes.
+		inline int getNodeCount() const { return this->nodeCount; }
+		/// @return The maximum number of children of a node.
+		inline int getNodeSize() const { return this->nodeSize; }
+		/// @return True if the RectTree uses a memory block from attach().
+		inline bool isAttached() const { return this->attached; }
+		/// @return The bounds of all Rectangles.
+		inline Rectangle<T> getBounds() const { return (this->nodeCount > 0 ? this->_nodes[0].bounds : Rectangle<T>()); }
+		/// @return The nodes, starting with the root.
+		inline const Node* getNodes() const { return this->_nodes; }
+
+		/// @brief Builds the tree from an array of Rectangles.
+		/// @param[in] rectangles The Rectangles.
+		/// @param[in] count Number of Rectangles.
+		/// @param[in] nodeSize Maximum number of children of a node, clamped to [2,256].
+		/// @param[in] threadCount Number of threads, 0 for the number of hardware threads.
+		/// @note The Rectangles are copied so the array does not need to stay valid.
+		/// @note Small arrays are built on the calling thread, the threads are only used with C++11 or newer.
+		void build(const Rectangle<T>* rectangles, int count, int nodeSize = 16, int threadCount = 0);
+		/// @brief Builds the tree from Rectangles.
+		/// @param[in] rectangles The Rectangles.
+		/// @param[in] nodeSize Maximum number of children of a node, clamped to [2,256].
+		/// @param[in] threadCount Number of threads, 0 for the number of hardware threads.
+		inline void build(const std::vector<Rectangle<T> >& rectangles, int nodeSize = 16, int threadCount = 0)
+		{
+			this->build(rectangles.size() > 0 ? &rectangles[0] : NULL, (int)rectangles.size(), nodeSize, threadCount);
+		}
+		/// @brief Removes all Rectangles and detaches from a memory block.
+		void clear();
+
+		/// @brief Finds all Rectangles intersecting a Rectangle.
+		/// @param[in] rectangle The Rectangle.
+		/// @param[out] result Buffer for the indices.
+		/// @param[in] maxCount Size of the buffer.
+		/// @return Number of Rectangles found, can be larger than maxCount in which case only maxCount indices were written.
+		/// @note Uses the same test as Rectangle::intersects(), touching edges do not count.
+		int findIntersecting(const Rectangle<T>& rectangle, int* result, int maxCount) const;
+		/// @brief Finds all Rectangles intersecting a Rectangle.
+		/// @param[in] rectangle The Rectangle.
+		/// @param[out] result The indices, replaces the previous content.
+		/// @note Uses the same test as Rectangle::intersects(), touching edges do not count.
+		void findIntersecting(const Rectangle<T>& rectangle, std::vector<int>& result) const;
+		/// @brief Finds all Rectangles hit by a ray.
+		/// @param[in] origin Origin of the ray.
+		/// @param[in] direction Direction of the ray, does not need to be normalized.
+		/// @param[in] maxDistance Maximum distance along the ray in multiples of direction.
+		/// @param[out] result Buffer for the indices.
+		/// @param[in] maxCount Size of the buffer.
+		/// @return Number of Rectangles found, can be larger than maxCount in which case only maxCount indices were written.
+		/// @note The edges of the Rectangles count as hits, Rectangles containing the origin are hit at distance 0.
+		int findOnRay(const Vector2<float>& origin, const Vector2<float>& direction, float maxDistance, int* result, int maxCount) const;
+		/// @brief Finds the first Rectangle hit by a ray.
+		/// @param[in] origin Origin of the ray.
+		/// @param[in] direction Direction of the ray, does not need to be normalized.
+		/// @param[in] maxDistance Maximum distance along the ray in multiples of direction.
+		/// @param[out] distance Receives the distance of the hit in multiples of direction.
+		/// @return The index of the Rectangle, -1 if none was hit in which case distance is not changed.
+		/// @note The edges of the Rectangles count as hits, Rectangles containing the origin are hit at distance 0.
+		/// @note Skips every node that starts behind the closest hit found so far.
+		int findFirstOnRay(const Vector2<float>& origin, const Vector2<float>& direction, float maxDistance, float& distance) const;
+
+		/// @return The size of the memory block written by save().
+		size_t getDataSize() const;
+		/// @brief Writes the tree into a memory block.
+		/// @param[out] data Buffer of at least getDataSize() bytes.
+		void save(unsigned char* data) const;
+		/// @brief Writes the tree into a memory block.
+		/// @param[out] data Receives the memory block, replaces the previous content.
+		inline void save(std::vector<unsigned char>& data) const
+		{
+			data.resize(this->getDataSize());
+			this->save(&data[0]);
+		}
+		/// @brief Copies the tree from a memory block written by save().
+		/// @param[in] data The memory block.
+		/// @param[in] size Size of the memory block.
+		/// @return True if the block is a valid RectTree of the same type, the RectTree is not changed otherwise.
+		/// @note The nodes have to have the layout build() creates for the count and node size, and the indices have to be in range.
+		bool load(const unsigned char* data, size_t size);
+		/// @brief Uses a memory block written by save() without copying it.
+		/// @param[in] data The memory block, has to be aligned to 4 bytes and stay valid while it is used.
+		/// @param[in] size Size of the memory block.
+		/// @return True if the block is a valid RectTree of the same type, the RectTree is not changed otherwise.
+		/// @note The block is checked once like in load() so the queries can trust it.
+		bool attach(const unsigned char* data, size_t size);
+
+		/// @brief Assignment operator.
+		/// @param[in] other The other RectTree.
+		/// @return This RectTree.
+		/// @note A copy of an attached RectTree uses the same memory block.
+		RectTree<T>& operator=(const RectTree<T>& other);
+
+	protected:
+		/// @brief A ray prepared for the slab test.
+		struct Ray
+		{
+			/// @brief X coordinate of the origin.
+			double originX;
+			/// @brief Y coordinate of the origin.
+			double originY;
+			/// @brief X coordinate of the direction.
+			double directionX;
+			/// @brief Y coordinate of the direction.
+			double directionY;
+			/// @brief Reciprocal of directionX.
+			double inverseX;
+			/// @brief Reciprocal of directionY.
+			double inverseY;
+			/// @brief Maximum distance along the ray.
+			double maxDistance;
+		};
+
+		/// @brief Maximum number of children of a node.
+		int nodeSize;
+		/// @brief Number of Rectangles.
+		int count;
+		/// @brief Number of nodes.
+		int nodeCount;
+		/// @brief Index of the first node on the lowest level, the children of these nodes are Rectangles.
+		int leafStart;
+		/// @brief Whether the arrays are in a memory block from attach().
+		bool attached;
+		/// @brief The nodes, starting with the root.
+		std::vector<Node> nodes;
+		/// @brief The Rectangles in Hilbert order.
+		std::vector<Rectangle<T> > rectangles;
+		/// @brief The index in the array of the last build() of every Rectangle.
+		std::vector<int> ids;
+
+		/// @brief Points the arrays used by the queries to the own storage.
+		void _updatePointers();
+		/// @brief Checks a memory block against the layout of build() and reads its sizes.
+		/// @param[in] data The memory block.
+		/// @param[in] size Size of the memory block.
+		/// @param[out] nodeSize Maximum number of children of a node.
+		/// @param[out] count Number of Rectangles.
+		/// @param[out] nodeCount Number of nodes.
+		/// @param[out] leafStart Index of the first node on the lowest level.
+		/// @return True if the block is valid.
+		static bool _readHeader(const unsigned char* data, size_t size, int& nodeSize, int& count, int& nodeCount, int& leafStart);
+		/// @brief Intersects a ray with a Rectangle using the slab test.
+		/// @param[in] ray The ray.
+		/// @param[in] rectangle The Rectangle.
+		/// @param[out] entry Receives the distance where the ray enters the Rectangle.
+		/// @return True if the ray hits the Rectangle within its maximum distance.
+		static bool _intersectRay(const Ray& ray, const Rectangle<T>& rectangle, double& entry);
+		/// @brief Finds all Rectangles intersecting a Rectangle below a node.
+		/// @param[in] node Index of the node.
+		/// @param[in] rectangle The Rectangle.
+		/// @param[out] result Buffer for the indices.
+		/// @param[in] maxCount Size of the buffer.
+		/// @param[in] found Number of Rectangles found so far.
+		/// @return Number of Rectangles found.
+		int _findIntersecting(int node, const Rectangle<T>& rectangle, int* result, int maxCount, int found) const;
+		/// @brief Finds all Rectangles hit by a ray below a node.
+		/// @param[in] node Index of the node.
+		/// @param[in] ray The ray.
+		/// @param[out] result Buffer for the indices.
+		/// @param[in] maxCount Size of the buffer.
+		/// @param[in] found Number of Rectangles found so far.
+		/// @return Number of Rectangles found.
+		int _findOnRay(int node, const Ray& ray, int* result, int maxCount, int found) const;
+		/// @brief Finds the first Rectangle hit by a ray below a node.
+		/// @param[in] node Index of the node.
+		/// @param[in,out] ray The ray, its maximum distance is reduced to the closest hit.
+		/// @param[in,out] best Index of the closest Rectangle found so far.
+		void _findFirstOnRay(int node, Ray& ray, int& best) const;
+
+	private:
+		/// @brief The nodes used by the queries, either the own storage or an attached memory block.
+		/// @note Used internally only.
+		const Node* _nodes;
+		/// @brief The Rectangles used by the queries.
+		/// @note Used internally only.
+		const Rectangle<T>* _rectangles;
+		/// @brief The indices used by the queries.
+		/// @note Used internally only.
+		const int* _ids;
+
+	};
+
+}
+
+/// @brief Typedef for simpler code.
+typedef gtypes::RectTree<int> grecttreei;
+/// @brief Typedef for simpler code.
+typedef const gtypes::RectTree<int>& cgrecttreei;
+/// @brief Typedef for simpler code.
+typedef gtypes::RectTree<float> grecttreef;
+/// @brief Typedef for simpler code.
+typedef const gtypes::RectTree<float>& cgrecttreef;
+
+#endif
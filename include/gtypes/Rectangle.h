@@ -14,6 +14,7 @@
 #define GTYPES_RECTANGLE_H
 
 #include "gtypesExport.h"
+#include "gtypesSimd.h"
 #include "Vector2.h"
 
 namespace gtypes
@@ -330,6 +331,128 @@ namespace gtypes
 		{
 			return (x >= this->x && y >= this->y && x < this->x + this->w && y < this->y + this->h);
 		}
+		/// @brief Checks which points of an array are inside the Rectangle.
+		/// @param[in] points The points.
+		/// @param[in] count Number of points.
+		/// @param[out] mask Receives one bit per point, bit i % 32 of mask[i / 32] is set if points[i] is inside.
+		/// Needs (count + 31) / 32 elements, unused bits of the last element are 0.
+		/// @note Uses the same test as isPointInside(). The float version uses the SIMD kernel of the current simd::getLevel().
+		inline void maskPointsInside(const Vector2<T>* points, int count, unsigned int* mask) const
+		{
+			Rectangle<T>::maskPointsInside(this, 1, points, count, mask);
+		}
+		/// @brief Checks which points given as separate coordinate arrays are inside the Rectangle.
+		/// @param[in] x The X coordinates.
+		/// @param[in] y The Y coordinates.
+		/// @param[in] count Number of points.
+		/// @param[out] mask Receives one bit per point, bit i % 32 of mask[i / 32] is set if point i is inside.
+		/// Needs (count + 31) / 32 elements, unused bits of the last element are 0.
+		/// @note Uses the same test as isPointInside(). The float version uses the SIMD kernel of the current simd::getLevel().
+		inline void maskPointsInside(const T* x, const T* y, int count, unsigned int* mask) const
+		{
+			Rectangle<T>::maskPointsInside(this, 1, x, y, count, mask);
+		}
+		/// @brief Finds the points of an array that are inside the Rectangle.
+		/// @param[in] points The points.
+		/// @param[in] count Number of points.
+		/// @param[out] result Receives the indices of the points inside in ascending order. Needs count elements.
+		/// @return Number of points inside.
+		/// @note Uses the same test as isPointInside(). The float version creates a bitmask with the SIMD kernel of the
+		/// current simd::getLevel() and compacts it with simd::compressMask().
+		inline int findPointsInside(const Vector2<T>* points, int count, int* result) const
+		{
+			return Rectangle<T>::findPointsInside(this, 1, points, count, result);
+		}
+		/// @brief Finds the points given as separate coordinate arrays that are inside the Rectangle.
+		/// @param[in] x The X coordinates.
+		/// @param[in] y The Y coordinates.
+		/// @param[in] count Number of points.
+		/// @param[out] result Receives the indices of the points inside in ascending order. Needs count elements.
+		/// @return Number of points inside.
+		/// @note Uses the same test as isPointInside(). The float version creates a bitmask with the SIMD kernel of the
+		/// current simd::getLevel() and compacts it with simd::compressMask().
+		inline int findPointsInside(const T* x, const T* y, int count, int* result) const
+		{
+			return Rectangle<T>::findPointsInside(this, 1, x, y, count, result);
+		}
+		/// @brief Checks which points of an array are inside at least one of several Rectangles.
+		/// @param[in] rectangles The Rectangles.
+		/// @param[in] rectangleCount Number of Rectangles.
+		/// @param[in] points The points.
+		/// @param[in] count Number of points.
+		/// @param[out] mask Receives one bit per point, bit i % 32 of mask[i / 32] is set if points[i] is inside.
+		/// Needs (count + 31) / 32 elements, unused bits of the last element are 0.
+		/// @note Uses the same test as isPointInside(). The float version uses the SIMD kernel of the current simd::getLevel().
+		inline static void maskPointsInside(const Rectangle<T>* rectangles, int rectangleCount, const Vector2<T>* points, int count, unsigned int* mask)
+		{
+			for (int i = 0; i < count; i += 32)
+			{
+				mask[i / 32] = 0;
+			}
+			for (int i = 0; i < count; ++i)
+			{
+				mask[i / 32] |= (Rectangle<T>::_isPointInsideAny(rectangles, rectangleCount, points[i].x, points[i].y) ? 1u : 0u) << (i % 32);
+			}
+		}
+		/// @brief Checks which points given as separate coordinate arrays are inside at least one of several Rectangles.
+		/// @param[in] rectangles The Rectangles.
+		/// @param[in] rectangleCount Number of Rectangles.
+		/// @param[in] x The X coordinates.
+		/// @param[in] y The Y coordinates.
+		/// @param[in] count Number of points.
+		/// @param[out] mask Receives one bit per point, bit i % 32 of mask[i / 32] is set if point i is inside.
+		/// Needs (count + 31) / 32 elements, unused bits of the last element are 0.
+		/// @note Uses the same test as isPointInside(). The float version uses the SIMD kernel of the current simd::getLevel().
+		inline static void maskPointsInside(const Rectangle<T>* rectangles, int rectangleCount, const T* x, const T* y, int count, unsigned int* mask)
+		{
+			for (int i = 0; i < count; i += 32)
+			{
+				mask[i / 32] = 0;
+			}
+			for (int i = 0; i < count; ++i)
+			{
+				mask[i / 32] |= (Rectangle<T>::_isPointInsideAny(rectangles, rectangleCount, x[i], y[i]) ? 1u : 0u) << (i % 32);
+			}
+		}
+		/// @brief Finds the points of an array that are inside at least one of several Rectangles.
+		/// @param[in] rectangles The Rectangles.
+		/// @param[in] rectangleCount Number of Rectangles.
+		/// @param[in] points The points.
+		/// @param[in] count Number of points.
+		/// @param[out] result Receives the indices of the points inside in ascending order. Needs count elements.
+		/// @return Number of points inside.
+		/// @note Uses the same test as isPointInside(). The float version creates a bitmask with the SIMD kernel of the
+		/// current simd::getLevel() and compacts it with simd::compressMask().
+		inline static int findPointsInside(const Rectangle<T>* rectangles, int rectangleCount, const Vector2<T>* points, int count, int* result)
+		{
+			int found = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				result[found] = i;
+				found += (Rectangle<T>::_isPointInsideAny(rectangles, rectangleCount, points[i].x, points[i].y) ? 1 : 0);
+			}
+			return found;
+		}
+		/// @brief Finds the points given as separate coordinate arrays that are inside at least one of several Rectangles.
+		/// @param[in] rectangles The Rectangles.
+		/// @param[in] rectangleCount Number of Rectangles.
+		/// @param[in] x The X coordinates.
+		/// @param[in] y The Y coordinates.
+		/// @param[in] count Number of points.
+		/// @param[out] result Receives the indices of the points inside in ascending order. Needs count elements.
+		/// @return Number of points inside.
+		/// @note Uses the same test as isPointInside(). The float version creates a bitmask with the SIMD kernel of the
+		/// current simd::getLevel() and compacts it with simd::compressMask().
+		inline static int findPointsInside(const Rectangle<T>* rectangles, int rectangleCount, const T* x, const T* y, int count, int* result)
+		{
+			int found = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				result[found] = i;
+				found += (Rectangle<T>::_isPointInsideAny(rectangles, rectangleCount, x[i], y[i]) ? 1 : 0);
+			}
+			return found;
+		}
 
 		/// @brief Creates a new Rectangle that was moved along a vector.
 		/// @param[in] vector Vector by which to move the Rectangle.
@@ -500,7 +623,51 @@ namespace gtypes
 			return (this->w * this->h < other.w * other.h);
 		}
 
+	protected:
+		/// @brief Checks if a point is inside at least one of several Rectangles.
+		/// @param[in] rectangles The Rectangles.
+		/// @param[in] rectangleCount Number of Rectangles.
+		/// @param[in] x X coordinate.
+		/// @param[in] y Y coordinate.
+		/// @return True if the point is inside at least one Rectangle.
+		inline static bool _isPointInsideAny(const Rectangle<T>* rectangles, int rectangleCount, T x, T y)
+		{
+			for (int i = 0; i < rectangleCount; ++i)
+			{
+				if (rectangles[i].isPointInside(x, y))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
 	};
+
+	template <>
+	inline void Rectangle<float>::maskPointsInside(const Rectangle<float>* rectangles, int rectangleCount, const Vector2<float>* points, int count, unsigned int* mask)
+	{
+		simd::getKernels().maskInRectangles2f(&points[0].x, &points[0].y, 2, count, rectangles, rectangleCount, mask);
+	}
+
+	template <>
+	inline void Rectangle<float>::maskPointsInside(const Rectangle<float>* rectangles, int rectangleCount, const float* x, const float* y, int count, unsigned int* mask)
+	{
+		simd::getKernels().maskInRectangles2f(x, y, 1, count, rectangles, rectangleCount, mask);
+	}
+
+	template <>
+	inline int Rectangle<float>::findPointsInside(const Rectangle<float>* rectangles, int rectangleCount, const Vector2<float>* points, int count, int* result)
+	{
+		return simd::getKernels().findInRectangles2f(&points[0].x, &points[0].y, 2, count, rectangles, rectangleCount, result);
+	}
+
+	template <>
+	inline int Rectangle<float>::findPointsInside(const Rectangle<float>* rectangles, int rectangleCount, const float* x, const float* y, int count, int* result)
+	{
+		return simd::getKernels().findInRectangles2f(x, y, 1, count, rectangles, rectangleCount, result);
+	}
+
 }
 
 /// @brief Typedef for simpler code.
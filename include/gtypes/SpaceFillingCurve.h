@@ -0,0 +1,286 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides Morton and Hilbert curve keys and sorting of positions by spatial locality.
+
+#ifndef GTYPES_SPACE_FILLING_CURVE_H
+#define GTYPES_SPACE_FILLING_CURVE_H
+
+#include <vector>
+
+#include "gtypesExport.h"
+#include "gtypesSimd.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+/// @def GTYPES_BMI2
+/// @brief Defined when the compiler targets BMI2 on x64 so the single value Morton functions use pdep and pext.
+#if (defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))) && (defined(__x86_64__) || defined(_M_X64))
+	#define GTYPES_BMI2
+	#include <immintrin.h>
+#endif
+
+namespace gtypes
+{
+	/// @brief Provides Morton and Hilbert curve keys and sorting of positions by spatial locality.
+	/// @note Both curves map 2D and 3D grid cells to 64-bit keys so that cells close to each other mostly get close keys.
+	/// Sorting data by these keys makes neighbor queries and rendering more cache-friendly. Morton keys only interleave
+	/// the bits of the coordinates and are very cheap, Hilbert keys cost more but never jump between distant cells.
+	/// @note Vector2<int> keys use all 32 bits of both coordinates, the sign bit is flipped so negative coordinates keep
+	/// their order. Vector3<int> keys use 21 bits of each coordinate, coordinates have to be in [-2^20, 2^20).
+	class gtypesExport SpaceFillingCurve
+	{
+	public:
+		/// @brief The curve used for keys.
+		enum Curve
+		{
+			/// @brief Morton curve, also called Z-order.
+			CurveMorton,
+			/// @brief Hilbert curve.
+			CurveHilbert
+		};
+
+		/// @brief Gets the Morton key of a 2D grid cell.
+		/// @param[in] vector The cell coordinates.
+		/// @return The Morton key, the bits of y are the odd bits.
+		inline static unsigned long long encodeMorton(const Vector2<int>& vector)
+		{
+			return (SpaceFillingCurve::_spread2((unsigned int)vector.x ^ 0x80000000u) | (SpaceFillingCurve::_spread2((unsigned int)vector.y ^ 0x80000000u) << 1));
+		}
+		/// @brief Gets the Morton key of a 3D grid cell.
+		/// @param[in] vector The cell coordinates, each in [-2^20, 2^20).
+		/// @return The Morton key, the bits of x, y and z repeat in this order from the lowest bit.
+		inline static unsigned long long encodeMorton(const Vector3<int>& vector)
+		{
+			return (SpaceFillingCurve::_spread3(((unsigned int)vector.x + 0x100000u) & 0x1FFFFFu) | (SpaceFillingCurve::_spread3(((unsigned int)vector.y + 0x100000u) & 0x1FFFFFu) << 1) |
+				(SpaceFillingCurve::_spread3(((unsigned int)vector.z + 0x100000u) & 0x1FFFFFu) << 2));
+		}
+		/// @brief Gets the 2D grid cell of a Morton key.
+		/// @param[in] key The Morton key.
+		/// @return The cell coordinates.
+		inline static Vector2<int> decodeMorton2(unsigned long long key)
+		{
+			return Vector2<int>((int)(SpaceFillingCurve::_compact2(key) ^ 0x80000000u), (int)(SpaceFillingCurve::_compact2(key >> 1) ^ 0x80000000u));
+		}
+		/// @brief Gets the 3D grid cell of a Morton key.
+		/// @param[in] key The Morton key.
+		/// @return The cell coordinates.
+		inline static Vector3<int> decodeMorton3(unsigned long long key)
+		{
+			return Vector3<int>((int)SpaceFillingCurve::_compact3(key) - 0x100000, (int)SpaceFillingCurve::_compact3(key >> 1) - 0x100000,
+				(int)SpaceFillingCurve::_compact3(key >> 2) - 0x100000);
+		}
+		/// @brief Gets the Hilbert key of a 2D grid cell.
+		/// @param[in] vector The cell coordinates.
+		/// @return The Hilbert key.
+		static unsigned long long encodeHilbert(const Vector2<int>& vector);
+		/// @brief Gets the Hilbert key of a 3D grid cell.
+		/// @param[in] vector The cell coordinates, each in [-2^20, 2^20).
+		/// @return The Hilbert key.
+		static unsigned long long encodeHilbert(const Vector3<int>& vector);
+		/// @brief Gets the 2D grid cell of a Hilbert key.
+		/// @param[in] key The Hilbert key.
+		/// @return The cell coordinates.
+		static Vector2<int> decodeHilbert2(unsigned long long key);
+		/// @brief Gets the 3D grid cell of a Hilbert key.
+		/// @param[in] key The Hilbert key.
+		/// @return The cell coordinates.
+		static Vector3<int> decodeHilbert3(unsigned long long key);
+
+		/// @brief Gets the Morton keys of an array of 2D grid cells.
+		/// @param[in] vectors The cell coordinates.
+		/// @param[out] keys Receives the Morton keys.
+		/// @param[in] count Number of cells.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(), BMI2 pdep on AVX2 and above.
+		inline static void encodeMorton(const Vector2<int>* vectors, unsigned long long* keys, int count)
+		{
+			simd::getKernels().encodeMorton2i(vectors, keys, count);
+		}
+		/// @brief Gets the Morton keys of an array of 3D grid cells.
+		/// @param[in] vectors The cell coordinates, each in [-2^20, 2^20).
+		/// @param[out] keys Receives the Morton keys.
+		/// @param[in] count Number of cells.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(), BMI2 pdep on AVX2 and above.
+		inline static void encodeMorton(const Vector3<int>* vectors, unsigned long long* keys, int count)
+		{
+			simd::getKernels().encodeMorton3i(vectors, keys, count);
+		}
+		/// @brief Gets the 2D grid cells of an array of Morton keys.
+		/// @param[in] keys The Morton keys.
+		/// @param[out] result Receives the cell coordinates.
+		/// @param[in] count Number of keys.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(), BMI2 pext on AVX2 and above.
+		inline static void decodeMorton(const unsigned long long* keys, Vector2<int>* result, int count)
+		{
+			simd::getKernels().decodeMorton2i(keys, result, count);
+		}
+		/// @brief Gets the 3D grid cells of an array of Morton keys.
+		/// @param[in] keys The Morton keys.
+		/// @param[out] result Receives the cell coordinates.
+		/// @param[in] count Number of keys.
+		/// @note Uses the SIMD kernel of the current simd::getLevel(), BMI2 pext on AVX2 and above.
+		inline static void decodeMorton(const unsigned long long* keys, Vector3<int>* result, int count)
+		{
+			simd::getKernels().decodeMorton3i(keys, result, count);
+		}
+		/// @brief Gets the Hilbert keys of an array of 2D grid cells.
+		/// @param[in] vectors The cell coordinates.
+		/// @param[out] keys Receives the Hilbert keys.
+		/// @param[in] count Number of cells.
+		static void encodeHilbert(const Vector2<int>* vectors, unsigned long long* keys, int count);
+		/// @brief Gets the Hilbert keys of an array of 3D grid cells.
+		/// @param[in] vectors The cell coordinates, each in [-2^20, 2^20).
+		/// @param[out] keys Receives the Hilbert keys.
+		/// @param[in] count Number of cells.
+		static void encodeHilbert(const Vector3<int>* vectors, unsigned long long* keys, int count);
+
+		/// @brief Gets the locality keys of an array of positions.
+		/// @param[in] positions The positions.
+		/// @param[in] count Number of positions.
+		/// @param[out] keys Receives the keys.
+		/// @param[in] curve The curve.
+		/// @note The bounds of the positions are split into 2^21 cells along the longest side.
+		static void computeKeys(const Vector2<float>* positions, int count, unsigned long long* keys, Curve curve = CurveMorton);
+		/// @brief Gets the locality keys of an array of positions.
+		/// @param[in] positions The positions.
+		/// @param[in] count Number of positions.
+		/// @param[out] keys Receives the keys.
+		/// @param[in] curve The curve.
+		/// @note The bounds of the positions are split into 2^21 cells along the longest side.
+		static void computeKeys(const Vector3<float>* positions, int count, unsigned long long* keys, Curve curve = CurveMorton);
+		/// @brief Gets the locality keys of an array of grid cells.
+		/// @param[in] positions The cell coordinates.
+		/// @param[in] count Number of cells.
+		/// @param[out] keys Receives the keys.
+		/// @param[in] curve The curve.
+		/// @note The coordinates are relative to the bounds of all cells so any int range can be used.
+		static void computeKeys(const Vector2<int>* positions, int count, unsigned long long* keys, Curve curve = CurveMorton);
+		/// @brief Gets the locality keys of an array of grid cells.
+		/// @param[in] positions The cell coordinates.
+		/// @param[in] count Number of cells.
+		/// @param[out] keys Receives the keys.
+		/// @param[in] curve The curve.
+		/// @note The coordinates are relative to the bounds of all cells, larger ranges than 2^21 are scaled down.
+		static void computeKeys(const Vector3<int>* positions, int count, unsigned long long* keys, Curve curve = CurveMorton);
+
+		/// @brief Sorts keys with a stable radix sort.
+		/// @param[in] keys The keys, not modified.
+		/// @param[in] count Number of keys.
+		/// @param[out] permutation Receives the indices of the keys in ascending key order.
+		/// @param[in] threadCount Number of threads, 0 for the number of hardware threads.
+		/// @note Small arrays are sorted on the calling thread, the threads are only used with C++11 or newer.
+		/// @note Sorts 11 bits per pass and skips the passes over bits that are equal in all keys.
+		static void sortKeys(const unsigned long long* keys, int count, int* permutation, int threadCount = 0);
+		/// @brief Reorders an array by a permutation.
+		/// @param[in,out] values The values.
+		/// @param[in] permutation The index in values of every element of the result, e.g. from sortKeys().
+		/// @param[in] count Number of values.
+		/// @note Used to apply the permutation of reorderByLocality() to arrays holding other data of the same elements.
+		template <typename T>
+		inline static void permute(T* values, const int* permutation, int count)
+		{
+			std::vector<T> copy(values, values + count);
+			for (int i = 0; i < count; ++i)
+			{
+				values[i] = copy[permutation[i]];
+			}
+		}
+		/// @brief Sorts positions or grid cells along a space filling curve.
+		/// @param[in,out] positions Array of Vector2<float>, Vector3<float>, Vector2<int> or Vector3<int>.
+		/// @param[in] count Number of positions.
+		/// @param[out] permutation Receives the previous index of every position, replaces the previous content.
+		/// @param[in] curve The curve.
+		/// @param[in] threadCount Number of threads for the sort, 0 for the number of hardware threads.
+		/// @note Equal keys keep their previous order.
+		template <typename T>
+		inline static void reorderByLocality(T* positions, int count, std::vector<int>& permutation, Curve curve = CurveMorton, int threadCount = 0)
+		{
+			permutation.resize(count);
+			if (count == 0)
+			{
+				return;
+			}
+			std::vector<unsigned long long> keys(count);
+			SpaceFillingCurve::computeKeys(positions, count, &keys[0], curve);
+			SpaceFillingCurve::sortKeys(&keys[0], count, &permutation[0], threadCount);
+			SpaceFillingCurve::permute(positions, &permutation[0], count);
+		}
+
+	protected:
+		/// @brief Moves the 32 bits of a value to the even bits.
+		/// @param[in] value The value.
+		/// @return The spread bits.
+		inline static unsigned long long _spread2(unsigned int value)
+		{
+#if defined(GTYPES_BMI2)
+			return _pdep_u64(value, 0x5555555555555555ULL);
+#else
+			unsigned long long result = value;
+			result = (result | (result << 16)) & 0x0000FFFF0000FFFFULL;
+			result = (result | (result << 8)) & 0x00FF00FF00FF00FFULL;
+			result = (result | (result << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+			result = (result | (result << 2)) & 0x3333333333333333ULL;
+			return ((result | (result << 1)) & 0x5555555555555555ULL);
+#endif
+		}
+		/// @brief Gathers the even bits of a value.
+		/// @param[in] value The value.
+		/// @return The gathered 32 bits.
+		inline static unsigned int _compact2(unsigned long long value)
+		{
+#if defined(GTYPES_BMI2)
+			return (unsigned int)_pext_u64(value, 0x5555555555555555ULL);
+#else
+			value &= 0x5555555555555555ULL;
+			value = (value | (value >> 1)) & 0x3333333333333333ULL;
+			value = (value | (value >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+			value = (value | (value >> 4)) & 0x00FF00FF00FF00FFULL;
+			value = (value | (value >> 8)) & 0x0000FFFF0000FFFFULL;
+			return (unsigned int)(value | (value >> 16));
+#endif
+		}
+		/// @brief Moves the 21 bits of a value to every third bit.
+		/// @param[in] value The value.
+		/// @return The spread bits.
+		inline static unsigned long long _spread3(unsigned int value)
+		{
+#if defined(GTYPES_BMI2)
+			return _pdep_u64(value, 0x1249249249249249ULL);
+#else
+			unsigned long long result = value;
+			result = (result | (result << 32)) & 0x001F00000000FFFFULL;
+			result = (result | (result << 16)) & 0x001F0000FF0000FFULL;
+			result = (result | (result << 8)) & 0x100F00F00F00F00FULL;
+			result = (result | (result << 4)) & 0x10C30C30C30C30C3ULL;
+			return ((result | (result << 2)) & 0x1249249249249249ULL);
+#endif
+		}
+		/// @brief Gathers every third bit of a value.
+		/// @param[in] value The value.
+		/// @return The gathered 21 bits.
+		inline static unsigned int _compact3(unsigned long long value)
+		{
+#if defined(GTYPES_BMI2)
+			return (unsigned int)_pext_u64(value, 0x1249249249249249ULL);
+#else
+			value &= 0x1249249249249249ULL;
+			value = (value | (value >> 2)) & 0x10C30C30C30C30C3ULL;
+			value = (value | (value >> 4)) & 0x100F00F00F00F00FULL;
+			value = (value | (value >> 8)) & 0x001F0000FF0000FFULL;
+			value = (value | (value >> 16)) & 0x001F00000000FFFFULL;
+			return (unsigned int)((value | (value >> 32)) & 0x1FFFFFULL);
+#endif
+		}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,128 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents a uniform spatial hash grid over 3D points for neighbor queries.
+
+#ifndef GTYPES_SPATIAL_HASH_GRID_3_H
+#define GTYPES_SPATIAL_HASH_GRID_3_H
+
+#include <vector>
+
+#include "gtypesExport.h"
+#include "Vector3.h"
+
+namespace gtypes
+{
+	/// @brief Represents a uniform spatial hash grid over 3D points for neighbor queries.
+	/// @note The grid is rebuilt in bulk from an array of positions, the points are counting-sorted by their hashed cells
+	/// into contiguous ranges. The grid is unbounded, cells are hashed into a table so empty space costs nothing.
+	/// @note Queries return indices into the array that was used in the last rebuild.
+	class gtypesExport SpatialHashGrid3
+	{
+	public:
+		/// @brief Constructor.
+		/// @param[in] cellSize Edge length of a cell, ideally about the typical query radius.
+		/// @param[in] tableSize Number of hash table entries, rounded up to a power of 2. 0 uses a quarter of the point count of every rebuild.
+		SpatialHashGrid3(float cellSize = 1.0f, int tableSize = 0);
+
+		/// @return The edge length of a cell.
+		inline float getCellSize() const { return this->cellSize; }
+		/// @brief Sets the edge length of a cell.
+		/// @param[in] value The new cell size.
+		/// @note Takes effect with the next rebuild().
+		void setCellSize(float value);
+		/// @return The number of points in the grid.
+		inline int getCount() const { return (int)this->entries.size(); }
+
+		/// @brief Rebuilds the grid from an array of positions.
+		/// @param[in] positions The positions.
+		/// @param[in] count Number of positions.
+		/// @note The positions are copied in cell order so the array does not need to stay valid.
+		void rebuild(const Vector3<float>* positions, int count);
+		/// @brief Rebuilds the grid from positions.
+		/// @param[in] positions The positions.
+		inline void rebuild(const std::vector<Vector3<float> >& positions) { this->rebuild(positions.size() > 0 ? &positions[0] : NULL, (int)positions.size()); }
+		/// @brief Removes all points.
+		void clear();
+
+		/// @brief Finds all points in the cells overlapping the bounding cube of a sphere.
+		/// @param[in] center Center of the sphere.
+		/// @param[in] radius Radius of the sphere.
+		/// @param[out] result Buffer for the point indices.
+		/// @param[in] maxCount Size of the buffer.
+		/// @return Number of points found, can be larger than maxCount in which case only maxCount indices were written.
+		/// @note The candidates still need filtering, e.g. with filterInSphere().
+		int findCandidates(const Vector3<float>& center, float radius, int* result, int maxCount) const;
+		/// @brief Finds all points within a sphere.
+		/// @param[in] center Center of the sphere.
+		/// @param[in] radius Radius of the sphere.
+		/// @param[out] result Buffer for the point indices.
+		/// @param[in] maxCount Size of the buffer.
+		/// @return Number of points found, can be larger than maxCount in which case only maxCount indices were written.
+		/// @note The test is inclusive like Vector2::isInCircle().
+		int findInSphere(const Vector3<float>& center, float radius, int* result, int maxCount) const;
+		/// @brief Finds all points within a sphere.
+		/// @param[in] center Center of the sphere.
+		/// @param[in] radius Radius of the sphere.
+		/// @param[out] result The point indices, replaces the previous content.
+		/// @note The test is inclusive like Vector2::isInCircle().
+		void findInSphere(const Vector3<float>& center, float radius, std::vector<int>& result) const;
+
+		/// @brief Filters indexed positions with a sphere.
+		/// @param[in] positions The positions.
+		/// @param[in] indices Indices into positions to check.
+		/// @param[in] count Number of indices.
+		/// @param[in] center Center of the sphere.
+		/// @param[in] radius Radius of the sphere.
+		/// @param[out] result Receives the indices within the sphere, at most count. May be the same buffer as indices.
+		/// @return Number of indices within the sphere.
+		/// @note The test is inclusive like Vector2::isInCircle().
+		static int filterInSphere(const Vector3<float>* positions, const int* indices, int count, const Vector3<float>& center, float radius, int* result);
+
+	protected:
+		/// @brief A point sorted into the grid.
+		struct Entry
+		{
+			/// @brief The position.
+			Vector3<float> position;
+			/// @brief Index in the array of the last rebuild.
+			int index;
+		};
+
+		/// @brief Edge length of a cell.
+		float cellSize;
+		/// @brief Requested hash table size, 0 for automatic.
+		int tableSize;
+		/// @brief Start of each hash table entry in entries, the last element is the total count.
+		std::vector<int> cellStarts;
+		/// @brief The points sorted by hash table entry.
+		std::vector<Entry> entries;
+
+		/// @brief Reciprocal of the cell size.
+		float _inverseCellSize;
+		/// @brief Hash table size - 1.
+		unsigned int _tableMask;
+		/// @brief Hash table entry of each point during rebuild.
+		std::vector<unsigned int> _pointCells;
+
+		/// @brief Scans all cells overlapping the bounding cube of a sphere.
+		/// @param[in] center Center of the sphere.
+		/// @param[in] radius Radius of the sphere.
+		/// @param[in] filter Whether to only return points within the sphere.
+		/// @param[out] result Buffer for the point indices.
+		/// @param[in] maxCount Size of the buffer.
+		/// @return Number of points found.
+		int _find(const Vector3<float>& center, float radius, bool filter, int* result, int maxCount) const;
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,186 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents an incremental sweep-and-prune broadphase that tracks the overlapping pairs of moving Rectangles.
+
+#ifndef GTYPES_SWEEP_AND_PRUNE_H
+#define GTYPES_SWEEP_AND_PRUNE_H
+
+#include <vector>
+
+#include "gtypesExport.h"
+#include "Rectangle.h"
+
+namespace gtypes
+{
+	/// @brief Represents an incremental sweep-and-prune broadphase that tracks the overlapping pairs of moving Rectangles.
+	/// @note Keeps the edges of all Rectangles sorted along both axes. An update() re-sorts them with insertion sort, which is
+	/// close to linear when the Rectangles only move a little between updates, and every swap of a left edge with a right
+	/// edge is exactly where a pair starts or stops overlapping on that axis. The pairs are kept in a hash set.
+	/// @note rebuild() sorts all edges from scratch with a multithreaded radix sort and sweeps once to find all pairs, which is
+	/// cheaper than update() after many Rectangles were inserted or teleported.
+	/// @note Changes only take effect with the next update() or rebuild() which reports the pairs that started and stopped
+	/// overlapping since the last one, including the pairs of removed Rectangles.
+	/// @note Uses the same test as Rectangle::intersects(), touching edges do not count. Widths and heights must not be negative.
+	class gtypesExport SweepAndPrune
+	{
+	public:
+		/// @brief Two overlapping Rectangles.
+		struct Pair
+		{
+			/// @brief The smaller id.
+			int first;
+			/// @brief The larger id.
+			int second;
+		};
+
+		/// @brief Basic constructor, creates an empty SweepAndPrune.
+		SweepAndPrune();
+
+		/// @return The number of Rectangles, including those inserted since the last update.
+		inline int getCount() const { return this->count; }
+		/// @return The number of overlapping pairs at the last update.
+		inline int getPairCount() const { return this->pairCount; }
+		/// @param[in] id The id of a Rectangle.
+		/// @return True if id belongs to a Rectangle that was not removed.
+		inline bool isValid(int id) const { return (id >= 0 && id < (int)this->items.size() && this->items[id].state != StateFree && this->items[id].state != StateRemoved); }
+		/// @param[in] id The id of a valid Rectangle.
+		/// @return The Rectangle.
+		inline const Rectangle<float>& getRectangle(int id) const { return this->items[id].rectangle; }
+
+		/// @brief Adds a Rectangle.
+		/// @param[in] rectangle The Rectangle.
+		/// @return The id of the Rectangle, ids of removed Rectangles are reused after the next update.
+		int insert(const Rectangle<float>& rectangle);
+		/// @brief Removes a Rectangle.
+		/// @param[in] id The id of the Rectangle.
+		/// @return True if the Rectangle was removed, false if id was invalid.
+		bool remove(int id);
+		/// @brief Changes a Rectangle.
+		/// @param[in] id The id of the Rectangle.
+		/// @param[in] rectangle The new Rectangle.
+		/// @return True if the Rectangle was changed, false if id was invalid.
+		bool move(int id, const Rectangle<float>& rectangle);
+		/// @brief Removes all Rectangles and pairs without reporting them.
+		void clear();
+
+		/// @brief Re-sorts the edges incrementally and updates the overlapping pairs.
+		/// @param[out] added Receives the pairs that started overlapping, replaces the previous content.
+		/// @param[out] removed Receives the pairs that stopped overlapping, replaces the previous content.
+		/// @note The cost grows with the number of edges that pass each other, so large jumps and many insertions are better
+		/// handled by rebuild().
+		void update(std::vector<Pair>& added, std::vector<Pair>& removed);
+		/// @brief Sorts the edges from scratch and finds all overlapping pairs again.
+		/// @param[out] added Receives the pairs that started overlapping, replaces the previous content.
+		/// @param[out] removed Receives the pairs that stopped overlapping, replaces the previous content.
+		/// @param[in] threadCount Number of threads for the sort, 0 for the number of hardware threads.
+		/// @note Small sets are sorted on the calling thread, the threads are only used with C++11 or newer.
+		void rebuild(std::vector<Pair>& added, std::vector<Pair>& removed, int threadCount = 0);
+
+		/// @param[in] first The id of a Rectangle.
+		/// @param[in] second The id of another Rectangle.
+		/// @return True if the Rectangles overlapped at the last update.
+		bool isOverlapping(int first, int second) const;
+		/// @brief Gets all overlapping pairs.
+		/// @param[out] result The pairs at the last update in no particular order, replaces the previous content.
+		void getPairs(std::vector<Pair>& result) const;
+
+	protected:
+		/// @brief The state of an id.
+		enum State
+		{
+			/// @brief The id is not used.
+			StateFree = 0,
+			/// @brief The Rectangle was inserted since the last update and has no edges yet.
+			StateInserted,
+			/// @brief The Rectangle has edges.
+			StateActive,
+			/// @brief The Rectangle was removed since the last update and still has edges.
+			StateRemoved
+		};
+
+		/// @brief A Rectangle and its state.
+		struct Item
+		{
+			/// @brief The Rectangle.
+			Rectangle<float> rectangle;
+			/// @brief The state of the id.
+			State state;
+		};
+
+		/// @brief A left or right edge of a Rectangle on one axis.
+		struct Edge
+		{
+			/// @brief The position of the edge.
+			float value;
+			/// @brief The id of the Rectangle shifted left by 1, the lowest bit is set for right edges.
+			int code;
+		};
+
+		/// @brief Number of Rectangles.
+		int count;
+		/// @brief Number of overlapping pairs.
+		int pairCount;
+		/// @brief The Rectangles by id.
+		std::vector<Item> items;
+		/// @brief The edges sorted by position along the x axis.
+		std::vector<Edge> edgesX;
+		/// @brief The edges sorted by position along the y axis.
+		std::vector<Edge> edgesY;
+		/// @brief Hash set of the overlapping pairs, the smaller id is in the upper 32 bits.
+		std::vector<unsigned long long> pairs;
+
+		/// @brief Sets the positions of edges from their Rectangles.
+		/// @param[in,out] edges The edges.
+		/// @param[in] vertical Whether the edges are on the y axis.
+		void _updateEdges(std::vector<Edge>& edges, bool vertical) const;
+		/// @brief Applies the insertions and removals since the last update to the edges.
+		/// @param[out] removed Receives the pairs of removed Rectangles.
+		void _applyChanges(std::vector<Pair>& removed);
+		/// @brief Re-sorts the edges of one axis with insertion sort and updates the pairs on every swap.
+		/// @param[in,out] edges The edges.
+		/// @param[out] added Receives the pairs that started overlapping.
+		/// @param[out] removed Receives the pairs that stopped overlapping.
+		void _sortEdges(std::vector<Edge>& edges, std::vector<Pair>& added, std::vector<Pair>& removed);
+		/// @brief Adds a pair to the hash set.
+		/// @param[in] key The pair.
+		/// @return True if the pair was not in the set yet.
+		bool _insertPair(unsigned long long key);
+		/// @brief Removes a pair from the hash set.
+		/// @param[in] key The pair.
+		/// @return True if the pair was in the set.
+		bool _erasePair(unsigned long long key);
+		/// @brief Checks whether a pair is in the hash set.
+		/// @param[in] key The pair.
+		/// @return True if the pair is in the set.
+		bool _findPair(unsigned long long key) const;
+		/// @brief Resizes the hash set so it can hold a number of pairs.
+		/// @param[in] pairCount Number of pairs.
+		void _reservePairs(int pairCount);
+
+	private:
+		/// @brief Ids of removed Rectangles that can be reused.
+		/// @note Used internally only.
+		std::vector<int> _freeIds;
+		/// @brief Ids of Rectangles inserted since the last update.
+		/// @note Used internally only.
+		std::vector<int> _insertedIds;
+		/// @brief Ids of Rectangles removed since the last update.
+		/// @note Used internally only.
+		std::vector<int> _removedIds;
+		/// @brief Buffer for the pairs found by rebuild().
+		/// @note Used internally only.
+		std::vector<unsigned long long> _foundPairs;
+
+	};
+
+}
+
+#endif
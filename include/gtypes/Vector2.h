@@ -16,6 +16,7 @@
 #include <math.h>
 
 #include "gtypesExport.h"
+#include "gtypesSimd.h"
 #include "gtypesUtil.h"
 
 namespace gtypes
@@ -85,6 +86,14 @@ namespace gtypes
 		{
 			return (float)RAD_TO_DEG(atan2(-this->y, this->x));
 		}
+		/// @return Calculates the angle of the Vector2 using a fast polynomial approximation of atan2().
+		/// @note The maximum error is below 1.5e-4 degrees, use angle() if exact results are required.
+		/// @see angle
+		/// @see simd::atan2Fast
+		inline float angleFast() const
+		{
+			return RAD_TO_DEG_F(simd::atan2Fast((float)-this->y, (float)this->x));
+		}
 		/// @brief Checks if the Vector2 is located within a circle defined by a center and a radius.
 		/// @param[in] centerX Center X coordinate of the circle.
 		/// @param[in] centerY Center Y coordinate of the circle.
@@ -106,6 +115,84 @@ namespace gtypes
 			float dy = (float)this->y - center.y;
 			return (dx * dx + dy * dy <= radius * radius);
 		}
+		/// @brief Checks which Vector2s of an array are located within a circle.
+		/// @param[in] vectors The Vector2s.
+		/// @param[in] count Number of Vector2s.
+		/// @param[in] center Center coordinate of the circle as Vector2.
+		/// @param[in] radius Radius of the circle.
+		/// @param[out] mask Receives one bit per Vector2, bit i % 32 of mask[i / 32] is set if vectors[i] is within the circle.
+		/// Needs (count + 31) / 32 elements, unused bits of the last element are 0.
+		/// @note Uses the same inclusive test as isInCircle(). The float version uses the SIMD kernel of the current simd::getLevel().
+		inline static void maskInCircle(const Vector2<T>* vectors, int count, const Vector2<T>& center, float radius, unsigned int* mask)
+		{
+			for (int i = 0; i < count; i += 32)
+			{
+				mask[i / 32] = 0;
+			}
+			for (int i = 0; i < count; ++i)
+			{
+				mask[i / 32] |= (vectors[i].isInCircle(center, radius) ? 1u : 0u) << (i % 32);
+			}
+		}
+		/// @brief Checks which points given as separate coordinate arrays are located within a circle.
+		/// @param[in] x The X coordinates.
+		/// @param[in] y The Y coordinates.
+		/// @param[in] count Number of points.
+		/// @param[in] center Center coordinate of the circle as Vector2.
+		/// @param[in] radius Radius of the circle.
+		/// @param[out] mask Receives one bit per point, bit i % 32 of mask[i / 32] is set if point i is within the circle.
+		/// Needs (count + 31) / 32 elements, unused bits of the last element are 0.
+		/// @note Uses the same inclusive test as isInCircle(). The float version uses the SIMD kernel of the current simd::getLevel().
+		inline static void maskInCircle(const T* x, const T* y, int count, const Vector2<T>& center, float radius, unsigned int* mask)
+		{
+			for (int i = 0; i < count; i += 32)
+			{
+				mask[i / 32] = 0;
+			}
+			for (int i = 0; i < count; ++i)
+			{
+				mask[i / 32] |= (Vector2<T>(x[i], y[i]).isInCircle(center, radius) ? 1u : 0u) << (i % 32);
+			}
+		}
+		/// @brief Finds the Vector2s of an array that are located within a circle.
+		/// @param[in] vectors The Vector2s.
+		/// @param[in] count Number of Vector2s.
+		/// @param[in] center Center coordinate of the circle as Vector2.
+		/// @param[in] radius Radius of the circle.
+		/// @param[out] result Receives the indices of the Vector2s within the circle in ascending order. Needs count elements.
+		/// @return Number of Vector2s within the circle.
+		/// @note Uses the same inclusive test as isInCircle(). The float version creates a bitmask with the SIMD kernel of
+		/// the current simd::getLevel() and compacts it with simd::compressMask().
+		inline static int findInCircle(const Vector2<T>* vectors, int count, const Vector2<T>& center, float radius, int* result)
+		{
+			int found = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				result[found] = i;
+				found += (vectors[i].isInCircle(center, radius) ? 1 : 0);
+			}
+			return found;
+		}
+		/// @brief Finds the points given as separate coordinate arrays that are located within a circle.
+		/// @param[in] x The X coordinates.
+		/// @param[in] y The Y coordinates.
+		/// @param[in] count Number of points.
+		/// @param[in] center Center coordinate of the circle as Vector2.
+		/// @param[in] radius Radius of the circle.
+		/// @param[out] result Receives the indices of the points within the circle in ascending order. Needs count elements.
+		/// @return Number of points within the circle.
+		/// @note Uses the same inclusive test as isInCircle(). The float version creates a bitmask with the SIMD kernel of
+		/// the current simd::getLevel() and compacts it with simd::compressMask().
+		inline static int findInCircle(const T* x, const T* y, int count, const Vector2<T>& center, float radius, int* result)
+		{
+			int found = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				result[found] = i;
+				found += (Vector2<T>(x[i], y[i]).isInCircle(center, radius) ? 1 : 0);
+			}
+			return found;
+		}
 
 		/// @brief Normalizes the current Vector2.
 		inline void normalize()
@@ -126,6 +213,77 @@ namespace gtypes
 			result.normalize();
 			return result;
 		}
+		/// @brief Normalizes the current Vector2 using a fast reciprocal square root approximation.
+		/// @note The maximum relative error is below 2^-21 (5e-7), use normalize() if exact results are required.
+		/// @see normalize
+		/// @see simd::rsqrt
+		inline void normalizeFast()
+		{
+			float squaredLength = this->squaredLength();
+			if (squaredLength != 0.0f)
+			{
+				float inverse = simd::rsqrt(squaredLength);
+				this->x = (T)(this->x * inverse);
+				this->y = (T)(this->y * inverse);
+			}
+		}
+		/// @brief Creates a normalized Vector2 from this Vector2 using a fast reciprocal square root approximation.
+		/// @return The normalized Vector2.
+		/// @note The maximum relative error is below 2^-21 (5e-7), use normalized() if exact results are required.
+		/// @see normalized
+		inline Vector2<T> normalizedFast() const
+		{
+			float squaredLength = this->squaredLength();
+			if (squaredLength == 0.0f)
+			{
+				return (*this);
+			}
+			float inverse = simd::rsqrt(squaredLength);
+			return Vector2<T>((T)(this->x * inverse), (T)(this->y * inverse));
+		}
+		/// @brief Normalizes an array of Vector2s using a fast reciprocal square root approximation.
+		/// @param[in,out] vectors The Vector2s.
+		/// @param[in] count Number of Vector2s.
+		/// @note Zero-length Vector2s stay unchanged.
+		/// @note The float version uses the SIMD kernel of the current simd::getLevel().
+		/// @see normalizeFast()
+		inline static void normalizeFast(Vector2<T>* vectors, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
+		/// @brief Calculates the angles of an array of Vector2s using a fast polynomial approximation of atan2().
+		/// @param[in] vectors The Vector2s.
+		/// @param[out] angles Receives the angles in degrees.
+		/// @param[in] count Number of Vector2s.
+		/// @note The float version uses the SIMD kernel of the current simd::getLevel().
+		/// @see angleFast()
+		inline static void angles(const Vector2<T>* vectors, float* angles, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				angles[i] = vectors[i].angleFast();
+			}
+		}
+		/// @brief Creates unit Vector2s from an array of angles.
+		/// @param[in] angles The angles in degrees.
+		/// @param[out] vectors Receives the Vector2s, angle() of each one returns the original angle.
+		/// @param[in] count Number of angles.
+		/// @note The float version uses the SIMD kernel of the current simd::getLevel() with polynomial approximations of
+		/// sin() and cos(). The maximum error of a component is below 2e-7 after an exact reduction to [-45, 45] so the
+		/// results are as precise as the float angles themselves. Angles must be within +-1.9e11 degrees.
+		inline static void fromAngles(const float* angles, Vector2<T>* vectors, int count)
+		{
+			float radians = 0.0f;
+			for (int i = 0; i < count; ++i)
+			{
+				radians = DEG_TO_RAD_F(angles[i]);
+				vectors[i].x = (T)cosf(radians);
+				vectors[i].y = (T)-sinf(radians);
+			}
+		}
 		/// @brief Rotates the current Vector2 by an angle.
 		/// @param[in] angle The angle.
 		inline void rotate(float angle)
@@ -331,6 +489,97 @@ namespace gtypes
 		}
 	};
 
+	// float and int specializations that avoid promoting to double
+
+	template <>
+	inline float Vector2<float>::length() const
+	{
+		return sqrtf(this->x * this->x + this->y * this->y);
+	}
+
+	template <>
+	inline float Vector2<int>::length() const
+	{
+		return sqrtf((float)(this->x * this->x + this->y * this->y));
+	}
+
+	template <>
+	inline float Vector2<float>::angle() const
+	{
+		return RAD_TO_DEG_F(atan2f(-this->y, this->x));
+	}
+
+	template <>
+	inline float Vector2<int>::angle() const
+	{
+		return RAD_TO_DEG_F(atan2f((float)-this->y, (float)this->x));
+	}
+
+	template <>
+	inline void Vector2<float>::rotate(float angle)
+	{
+		float radians = DEG_TO_RAD_F(angle);
+		float sinRadians = sinf(radians);
+		float cosRadians = cosf(radians);
+		float oldX = this->x;
+		this->x = cosRadians * oldX - sinRadians * this->y;
+		this->y = sinRadians * oldX + cosRadians * this->y;
+	}
+
+	template <>
+	inline void Vector2<int>::rotate(float angle)
+	{
+		float radians = DEG_TO_RAD_F(angle);
+		float sinRadians = sinf(radians);
+		float cosRadians = cosf(radians);
+		float oldX = (float)this->x;
+		float oldY = (float)this->y;
+		this->x = (int)(cosRadians * oldX - sinRadians * oldY);
+		this->y = (int)(sinRadians * oldX + cosRadians * oldY);
+	}
+
+	template <>
+	inline void Vector2<float>::normalizeFast(Vector2<float>* vectors, int count)
+	{
+		simd::getKernels().normalizeFastVector2f(vectors, count);
+	}
+
+	template <>
+	inline void Vector2<float>::angles(const Vector2<float>* vectors, float* angles, int count)
+	{
+		simd::getKernels().anglesVector2f(vectors, angles, count);
+	}
+
+	template <>
+	inline void Vector2<float>::fromAngles(const float* angles, Vector2<float>* vectors, int count)
+	{
+		simd::getKernels().fromAnglesVector2f(angles, vectors, count);
+	}
+
+	template <>
+	inline void Vector2<float>::maskInCircle(const Vector2<float>* vectors, int count, const Vector2<float>& center, float radius, unsigned int* mask)
+	{
+		simd::getKernels().maskInCircle2f(&vectors[0].x, &vectors[0].y, 2, count, center.x, center.y, radius, mask);
+	}
+
+	template <>
+	inline void Vector2<float>::maskInCircle(const float* x, const float* y, int count, const Vector2<float>& center, float radius, unsigned int* mask)
+	{
+		simd::getKernels().maskInCircle2f(x, y, 1, count, center.x, center.y, radius, mask);
+	}
+
+	template <>
+	inline int Vector2<float>::findInCircle(const Vector2<float>* vectors, int count, const Vector2<float>& center, float radius, int* result)
+	{
+		return simd::getKernels().findInCircle2f(&vectors[0].x, &vectors[0].y, 2, count, center.x, center.y, radius, result);
+	}
+
+	template <>
+	inline int Vector2<float>::findInCircle(const float* x, const float* y, int count, const Vector2<float>& center, float radius, int* result)
+	{
+		return simd::getKernels().findInCircle2f(x, y, 1, count, center.x, center.y, radius, result);
+	}
+
 }
 
 /// @brief Typedef for simpler code.
@@ -349,4 +598,23 @@ typedef const gtypes::Vector2<double>& cgvec2d;
 /// @brief Alias for simpler code.
 #define gvec2 gtypes::Vector2
 
+#ifdef GTYPES_STD_HASH
+namespace std
+{
+	/// @brief Hash for Vector2 so it can be used as key in unordered containers.
+	/// @note Equal Vector2s have equal hashes, 0 and -0 components included.
+	template <typename T>
+	struct hash<gtypes::Vector2<T> >
+	{
+		inline size_t operator()(const gtypes::Vector2<T>& vector) const
+		{
+			size_t result = std::hash<T>()(vector.x);
+			gtypes::hashCombine(result, vector.y);
+			return result;
+		}
+	};
+
+}
+#endif
+
 #endif
@@ -16,6 +16,7 @@
 #include <math.h>
 
 #include "gtypesExport.h"
+#include "gtypesSimd.h"
 #include "Vector2.h"
 
 namespace gtypes
@@ -126,6 +127,48 @@ namespace gtypes
 			result.normalize();
 			return result;
 		}
+		/// @brief Normalizes the current Vector3 using a fast reciprocal square root approximation.
+		/// @note The maximum relative error is below 2^-21 (5e-7), use normalize() if exact results are required.
+		/// @see normalize
+		/// @see simd::rsqrt
+		inline void normalizeFast()
+		{
+			float squaredLength = this->squaredLength();
+			if (squaredLength != 0.0f)
+			{
+				float inverse = simd::rsqrt(squaredLength);
+				this->x = (T)(this->x * inverse);
+				this->y = (T)(this->y * inverse);
+				this->z = (T)(this->z * inverse);
+			}
+		}
+		/// @brief Creates a normalized Vector3 from this Vector3 using a fast reciprocal square root approximation.
+		/// @return The normalized Vector3.
+		/// @note The maximum relative error is below 2^-21 (5e-7), use normalized() if exact results are required.
+		/// @see normalized
+		inline Vector3<T> normalizedFast() const
+		{
+			float squaredLength = this->squaredLength();
+			if (squaredLength == 0.0f)
+			{
+				return (*this);
+			}
+			float inverse = simd::rsqrt(squaredLength);
+			return Vector3<T>((T)(this->x * inverse), (T)(this->y * inverse), (T)(this->z * inverse));
+		}
+		/// @brief Normalizes an array of Vector3s using a fast reciprocal square root approximation.
+		/// @param[in,out] vectors The Vector3s.
+		/// @param[in] count Number of Vector3s.
+		/// @note Zero-length Vector3s stay unchanged.
+		/// @note The float version uses the SIMD kernel of the current simd::getLevel().
+		/// @see normalizeFast()
+		inline static void normalizeFast(Vector3<T>* vectors, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
 		/// @brief Calculates the dot-product between this and another Vector3.
 		/// @param[in] other The other Vector3.
 		/// @return The dot-product.
@@ -346,6 +389,26 @@ namespace gtypes
 		
 	};
 
+	// float and int specializations that avoid promoting to double
+
+	template <>
+	inline float Vector3<float>::length() const
+	{
+		return sqrtf(this->x * this->x + this->y * this->y + this->z * this->z);
+	}
+
+	template <>
+	inline float Vector3<int>::length() const
+	{
+		return sqrtf((float)(this->x * this->x + this->y * this->y + this->z * this->z));
+	}
+
+	template <>
+	inline void Vector3<float>::normalizeFast(Vector3<float>* vectors, int count)
+	{
+		simd::getKernels().normalizeFastVector3f(vectors, count);
+	}
+
 }
 
 /// @brief Typedef for simpler code.
@@ -364,4 +427,24 @@ typedef const gtypes::Vector3<double>& cgvec3d;
 /// @brief Alias for simpler code.
 #define gvec3 gtypes::Vector3
 
+#ifdef GTYPES_STD_HASH
+namespace std
+{
+	/// @brief Hash for Vector3 so it can be used as key in unordered containers.
+	/// @note Equal Vector3s have equal hashes, 0 and -0 components included.
+	template <typename T>
+	struct hash<gtypes::Vector3<T> >
+	{
+		inline size_t operator()(const gtypes::Vector3<T>& vector) const
+		{
+			size_t result = std::hash<T>()(vector.x);
+			gtypes::hashCombine(result, vector.y);
+			gtypes::hashCombine(result, vector.z);
+			return result;
+		}
+	};
+
+}
+#endif
+
 #endif
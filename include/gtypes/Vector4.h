@@ -0,0 +1,524 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Represents a 4D (homogeneous) vector.
+
+#ifndef GTYPES_VECTOR_4_H
+#define GTYPES_VECTOR_4_H
+
+#include <math.h>
+
+#include "gtypesExport.h"
+#include "gtypesSimd.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+namespace gtypes
+{
+	/// @brief Represents a 4D (homogeneous) vector.
+	/// @note Vector4<float> has exactly the size and layout of one 128-bit SIMD register and its basic operations use SIMD where available.
+	/// @note No extra alignment is enforced so the type can be stored in std::vector and plain arrays. SIMD loads and stores are unaligned.
+	template <typename T>
+	class Vector4
+	{
+	public:
+		/// @brief X coordinate.
+		T x;
+		/// @brief Y coordinate.
+		T y;
+		/// @brief Z coordinate.
+		T z;
+		/// @brief W coordinate.
+		T w;
+
+		/// @brief Basic constructor.
+		inline Vector4() :
+			x(0),
+			y(0),
+			z(0),
+			w(0)
+		{
+		}
+		/// @brief Advanced copy constructor.
+		template <typename S>
+		inline Vector4(const Vector4<S>& other) :
+			x((T)other.x),
+			y((T)other.y),
+			z((T)other.z),
+			w((T)other.w)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] x X coordinate.
+		/// @param[in] y Y coordinate.
+		/// @param[in] z Z coordinate.
+		/// @param[in] w W coordinate.
+		inline Vector4(T x, T y, T z, T w) :
+			x(x),
+			y(y),
+			z(z),
+			w(w)
+		{
+		}
+		/// @brief Constructor.
+		/// @param[in] v Vector3.
+		/// @param[in] w W coordinate.
+		/// @note Use w = 1 for points and w = 0 for directions.
+		inline Vector4(const Vector3<T>& v, T w) :
+			x(v.x),
+			y(v.y),
+			z(v.z),
+			w(w)
+		{
+		}
+		/// @brief Sets the values of the Vector4.
+		/// @param[in] x X coordinate.
+		/// @param[in] y Y coordinate.
+		/// @param[in] z Z coordinate.
+		/// @param[in] w W coordinate.
+		inline void set(T x, T y, T z, T w)
+		{
+			this->x = x;
+			this->y = y;
+			this->z = z;
+			this->w = w;
+		}
+		/// @brief Sets the values of the Vector4.
+		/// @param[in] v Vector3.
+		/// @param[in] w W coordinate.
+		inline void set(const Vector3<T>& v, T w)
+		{
+			this->x = v.x;
+			this->y = v.y;
+			this->z = v.z;
+			this->w = w;
+		}
+
+		/// @brief Gets the X, Y and Z coordinates.
+		/// @return The Vector3 made of the X, Y and Z coordinates.
+		inline Vector3<T> xyz() const
+		{
+			return Vector3<T>(this->x, this->y, this->z);
+		}
+		/// @brief Gets the X and Y coordinates.
+		/// @return The Vector2 made of the X and Y coordinates.
+		inline Vector2<T> xy() const
+		{
+			return Vector2<T>(this->x, this->y);
+		}
+		/// @brief Projects this homogeneous Vector4 back into 3D space by dividing with W.
+		/// @return The projected Vector3.
+		/// @note If W is 0, X, Y and Z are returned unchanged.
+		inline Vector3<T> project() const
+		{
+			if (this->w == 0)
+			{
+				return Vector3<T>(this->x, this->y, this->z);
+			}
+			return Vector3<T>((T)(this->x / this->w), (T)(this->y / this->w), (T)(this->z / this->w));
+		}
+		/// @brief Creates a swizzled Vector4 from this Vector4.
+		/// @return The swizzled Vector4.
+		/// @note Template parameters are component indices with 0 = X, 1 = Y, 2 = Z and 3 = W, e.g. swizzled<3, 2, 1, 0>() reverses the components.
+		template <int X, int Y, int Z, int W>
+		inline Vector4<T> swizzled() const
+		{
+			const T* data = &this->x;
+			return Vector4<T>(data[X & 3], data[Y & 3], data[Z & 3], data[W & 3]);
+		}
+
+		/// @brief Checks if this is a zero-length vector.
+		/// @return True if this is a zero-length vector.
+		inline bool isNull() const
+		{
+			return (this->x == 0 && this->y == 0 && this->z == 0 && this->w == 0);
+		}
+
+		/// @return Calculates the length of the Vector4.
+		inline float length() const
+		{
+			return (float)sqrt(this->x * this->x + this->y * this->y + this->z * this->z + this->w * this->w);
+		}
+		/// @return Calculates the squared length of the Vector4.
+		/// @note Use this if you don't need the actual length as it's faster than length().
+		/// @see length
+		inline float squaredLength() const
+		{
+			return (float)this->dot(*this);
+		}
+
+		/// @brief Normalizes the current Vector4.
+		inline void normalize()
+		{
+			float length = this->length();
+			if (length != 0.0f)
+			{
+				length = 1.0f / length;
+				this->x = (T)(this->x * length);
+				this->y = (T)(this->y * length);
+				this->z = (T)(this->z * length);
+				this->w = (T)(this->w * length);
+			}
+		}
+		/// @brief Creates a normalized Vector4 from this Vector4.
+		/// @return The normalized Vector4.
+		inline Vector4<T> normalized() const
+		{
+			Vector4<T> result(*this);
+			result.normalize();
+			return result;
+		}
+		/// @brief Normalizes the current Vector4 using a fast reciprocal square root approximation.
+		/// @note The maximum relative error is below 2^-21 (5e-7), use normalize() if exact results are required.
+		/// @see normalize
+		/// @see simd::rsqrt
+		inline void normalizeFast()
+		{
+			float squaredLength = this->squaredLength();
+			if (squaredLength != 0.0f)
+			{
+				*this = *this * simd::rsqrt(squaredLength);
+			}
+		}
+		/// @brief Creates a normalized Vector4 from this Vector4 using a fast reciprocal square root approximation.
+		/// @return The normalized Vector4.
+		/// @note The maximum relative error is below 2^-21 (5e-7), use normalized() if exact results are required.
+		/// @see normalized
+		inline Vector4<T> normalizedFast() const
+		{
+			float squaredLength = this->squaredLength();
+			if (squaredLength == 0.0f)
+			{
+				return (*this);
+			}
+			return (*this * simd::rsqrt(squaredLength));
+		}
+		/// @brief Calculates the dot-product between this and another Vector4.
+		/// @param[in] other The other Vector4.
+		/// @return The dot-product.
+		inline T dot(const Vector4<T>& other) const
+		{
+			return (this->x * other.x + this->y * other.y + this->z * other.z + this->w * other.w);
+		}
+		/// @brief Creates a Vector4 with the component-wise minimum of this and another Vector4.
+		/// @param[in] other The other Vector4.
+		/// @return The component-wise minimum.
+		inline Vector4<T> componentMin(const Vector4<T>& other) const
+		{
+			return Vector4<T>((this->x < other.x ? this->x : other.x), (this->y < other.y ? this->y : other.y),
+				(this->z < other.z ? this->z : other.z), (this->w < other.w ? this->w : other.w));
+		}
+		/// @brief Creates a Vector4 with the component-wise maximum of this and another Vector4.
+		/// @param[in] other The other Vector4.
+		/// @return The component-wise maximum.
+		inline Vector4<T> componentMax(const Vector4<T>& other) const
+		{
+			return Vector4<T>((this->x > other.x ? this->x : other.x), (this->y > other.y ? this->y : other.y),
+				(this->z > other.z ? this->z : other.z), (this->w > other.w ? this->w : other.w));
+		}
+
+		/// @brief Creates an inverted Vector4.
+		/// @return Inverted Vector4.
+		inline Vector4<T> operator-() const
+		{
+			return Vector4<T>(-this->x, -this->y, -this->z, -this->w);
+		}
+		/// @brief Adds two Vector4s.
+		/// @param[in] other The other Vector4.
+		/// @return The resulting Vector4.
+		template <typename S>
+		inline Vector4<T> operator+(const Vector4<S>& other) const
+		{
+			return Vector4<T>((T)(this->x + other.x), (T)(this->y + other.y), (T)(this->z + other.z), (T)(this->w + other.w));
+		}
+		/// @brief Subtracts two Vector4s.
+		/// @param[in] other The other Vector4.
+		/// @return The resulting Vector4.
+		template <typename S>
+		inline Vector4<T> operator-(const Vector4<S>& other) const
+		{
+			return Vector4<T>((T)(this->x - other.x), (T)(this->y - other.y), (T)(this->z - other.z), (T)(this->w - other.w));
+		}
+		/// @brief Multiplies two Vector4s.
+		/// @param[in] other The other Vector4.
+		/// @return The resulting Vector4.
+		template <typename S>
+		inline Vector4<T> operator*(const Vector4<S>& other) const
+		{
+			return Vector4<T>((T)(this->x * other.x), (T)(this->y * other.y), (T)(this->z * other.z), (T)(this->w * other.w));
+		}
+		/// @brief Divides two Vector4s.
+		/// @param[in] other The other Vector4.
+		/// @return The resulting Vector4.
+		template <typename S>
+		inline Vector4<T> operator/(const Vector4<S>& other) const
+		{
+			return Vector4<T>((T)(this->x / other.x), (T)(this->y / other.y), (T)(this->z / other.z), (T)(this->w / other.w));
+		}
+		/// @brief Multiplies Vector4 with a factor.
+		/// @param[in] factor The factor.
+		/// @return The resulting Vector4.
+		template <typename S>
+		inline Vector4<T> operator*(S factor) const
+		{
+			return Vector4<T>((T)(this->x * factor), (T)(this->y * factor), (T)(this->z * factor), (T)(this->w * factor));
+		}
+		/// @brief Divides Vector4 with a factor.
+		/// @param[in] factor The factor.
+		/// @return The resulting Vector4.
+		inline Vector4<T> operator/(int factor) const
+		{
+			return Vector4<T>((T)(this->x / factor), (T)(this->y / factor), (T)(this->z / factor), (T)(this->w / factor));
+		}
+		/// @brief Divides Vector4 with a factor.
+		/// @param[in] factor The factor.
+		/// @return The resulting Vector4.
+		inline Vector4<T> operator/(float factor) const
+		{
+			return (*this * (1.0f / factor));
+		}
+		/// @brief Divides Vector4 with a factor.
+		/// @param[in] factor The factor.
+		/// @return The resulting Vector4.
+		inline Vector4<T> operator/(double factor) const
+		{
+			return (*this * (1.0 / factor));
+		}
+		/// @brief Sets this Vector4 to another one.
+		/// @param[in] other The other Vector4.
+		/// @return This Vector4.
+		template <typename S>
+		inline Vector4<T> operator=(const Vector4<S>& other)
+		{
+			this->x = (T)other.x;
+			this->y = (T)other.y;
+			this->z = (T)other.z;
+			this->w = (T)other.w;
+			return (*this);
+		}
+		/// @brief Adds another Vector4 to this one.
+		/// @param[in] other The other Vector4.
+		/// @return A copy of this Vector4.
+		template <typename S>
+		inline Vector4<T> operator+=(const Vector4<S>& other)
+		{
+			*this = *this + other;
+			return (*this);
+		}
+		/// @brief Subtracts another Vector4 to this one.
+		/// @param[in] other The other Vector4.
+		/// @return A copy of this Vector4.
+		template <typename S>
+		inline Vector4<T> operator-=(const Vector4<S>& other)
+		{
+			*this = *this - other;
+			return (*this);
+		}
+		/// @brief Multiplies this Vector4 with another one.
+		/// @param[in] other The other Vector4.
+		/// @return A copy of this Vector4.
+		template <typename S>
+		inline Vector4<T> operator*=(const Vector4<S>& other)
+		{
+			*this = *this * other;
+			return (*this);
+		}
+		/// @brief Divides this Vector4 with another one.
+		/// @param[in] other The other Vector4.
+		/// @return A copy of this Vector4.
+		template <typename S>
+		inline Vector4<T> operator/=(const Vector4<S>& other)
+		{
+			*this = *this / other;
+			return (*this);
+		}
+		/// @brief Multiplies this Vector4 with a factor.
+		/// @param[in] factor The factor.
+		/// @return A copy of this Vector4.
+		template <typename S>
+		inline Vector4<T> operator*=(S factor)
+		{
+			*this = *this * factor;
+			return (*this);
+		}
+		/// @brief Divides this Vector4 with a factor.
+		/// @param[in] factor The factor.
+		/// @return A copy of this Vector4.
+		inline Vector4<T> operator/=(int factor)
+		{
+			*this = *this / factor;
+			return (*this);
+		}
+		/// @brief Divides this Vector4 with a factor.
+		/// @param[in] factor The factor.
+		/// @return A copy of this Vector4.
+		inline Vector4<T> operator/=(float factor)
+		{
+			*this = *this / factor;
+			return (*this);
+		}
+		/// @brief Divides this Vector4 with a factor.
+		/// @param[in] factor The factor.
+		/// @return A copy of this Vector4.
+		inline Vector4<T> operator/=(double factor)
+		{
+			*this = *this / factor;
+			return (*this);
+		}
+		/// @brief Checks if two Vector4s are equal.
+		/// @param[in] other The other Vector4.
+		/// @return True if the two Vector4s are equal.
+		/// @note Beware of floating point errors.
+		inline bool operator==(const Vector4<T>& other) const
+		{
+			return (this->x == other.x && this->y == other.y && this->z == other.z && this->w == other.w);
+		}
+		/// @brief Checks if two Vector4s are not equal.
+		/// @param[in] other The other Vector4.
+		/// @return True if the two Vector4s are not equal.
+		/// @note Beware of floating point errors.
+		inline bool operator!=(const Vector4<T>& other) const
+		{
+			return !(*this == other);
+		}
+
+	};
+
+	// SIMD implementations for Vector4<float>
+
+	template <>
+	inline float Vector4<float>::dot(const Vector4<float>& other) const
+	{
+		return simd::dot4(&this->x, &other.x);
+	}
+
+	template <>
+	inline float Vector4<float>::length() const
+	{
+		return sqrtf(simd::dot4(&this->x, &this->x));
+	}
+
+	template <>
+	inline float Vector4<int>::length() const
+	{
+		return sqrtf((float)(this->x * this->x + this->y * this->y + this->z * this->z + this->w * this->w));
+	}
+
+	template <>
+	inline void Vector4<float>::normalize()
+	{
+		float length = this->length();
+		if (length != 0.0f)
+		{
+			simd::scale4(&this->x, 1.0f / length, &this->x);
+		}
+	}
+
+	template <>
+	inline Vector4<float> Vector4<float>::componentMin(const Vector4<float>& other) const
+	{
+		Vector4<float> result;
+		simd::min4(&this->x, &other.x, &result.x);
+		return result;
+	}
+
+	template <>
+	inline Vector4<float> Vector4<float>::componentMax(const Vector4<float>& other) const
+	{
+		Vector4<float> result;
+		simd::max4(&this->x, &other.x, &result.x);
+		return result;
+	}
+
+	template <>
+	template <>
+	inline Vector4<float> Vector4<float>::operator+(const Vector4<float>& other) const
+	{
+		Vector4<float> result;
+		simd::add4(&this->x, &other.x, &result.x);
+		return result;
+	}
+
+	template <>
+	template <>
+	inline Vector4<float> Vector4<float>::operator-(const Vector4<float>& other) const
+	{
+		Vector4<float> result;
+		simd::sub4(&this->x, &other.x, &result.x);
+		return result;
+	}
+
+	template <>
+	template <>
+	inline Vector4<float> Vector4<float>::operator*(const Vector4<float>& other) const
+	{
+		Vector4<float> result;
+		simd::mul4(&this->x, &other.x, &result.x);
+		return result;
+	}
+
+	template <>
+	template <>
+	inline Vector4<float> Vector4<float>::operator/(const Vector4<float>& other) const
+	{
+		Vector4<float> result;
+		simd::div4(&this->x, &other.x, &result.x);
+		return result;
+	}
+
+	template <>
+	template <>
+	inline Vector4<float> Vector4<float>::operator*(float factor) const
+	{
+		Vector4<float> result;
+		simd::scale4(&this->x, factor, &result.x);
+		return result;
+	}
+
+}
+
+/// @brief Typedef for simpler code.
+typedef gtypes::Vector4<int> gvec4i;
+/// @brief Typedef for simpler code.
+typedef const gtypes::Vector4<int>& cgvec4i;
+/// @brief Typedef for simpler code.
+typedef gtypes::Vector4<float> gvec4f;
+/// @brief Typedef for simpler code.
+typedef const gtypes::Vector4<float>& cgvec4f;
+/// @brief Typedef for simpler code.
+typedef gtypes::Vector4<double> gvec4d;
+/// @brief Typedef for simpler code.
+typedef const gtypes::Vector4<double>& cgvec4d;
+
+/// @brief Alias for simpler code.
+#define gvec4 gtypes::Vector4
+
+#ifdef GTYPES_STD_HASH
+namespace std
+{
+	/// @brief Hash for Vector4 so it can be used as key in unordered containers.
+	/// @note Equal Vector4s have equal hashes, 0 and -0 components included.
+	template <typename T>
+	struct hash<gtypes::Vector4<T> >
+	{
+		inline size_t operator()(const gtypes::Vector4<T>& vector) const
+		{
+			size_t result = std::hash<T>()(vector.x);
+			gtypes::hashCombine(result, vector.y);
+			gtypes::hashCombine(result, vector.z);
+			gtypes::hashCombine(result, vector.w);
+			return result;
+		}
+	};
+
+}
+#endif
+
+#endif
@@ -0,0 +1,503 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides SIMD detection macros, basic 4-float SIMD helpers and the runtime dispatch of batch kernels.
+
+#ifndef GTYPES_SIMD_H
+#define GTYPES_SIMD_H
+
+#include <math.h>
+
+#include "gtypesExport.h"
+
+/// @def GTYPES_SIMD_SSE
+/// @brief Defined when SSE2 intrinsics are available at compile time.
+/// @def GTYPES_SIMD_NEON
+/// @brief Defined when NEON intrinsics are available at compile time.
+/// @note Define GTYPES_NO_SIMD to force the scalar implementations.
+#ifndef GTYPES_NO_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define GTYPES_SIMD_SSE
+		#include <emmintrin.h>
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM) || defined(_M_ARM64)
+		#define GTYPES_SIMD_NEON
+		#include <arm_neon.h>
+	#endif
+#endif
+
+namespace gtypes
+{
+	template <typename T> class Vector2;
+	template <typename T> class Vector3;
+	template <typename T> class Rectangle;
+	class Matrix3;
+	class Matrix4;
+	class Quaternion;
+	class DualQuaternion;
+	class HalfVector3;
+	class Unorm16Vector3;
+	class OctahedralVector3;
+	class Snorm10Vector3;
+	class SmallestThree29Quaternion;
+	class SmallestThree32Quaternion;
+	class SmallestThree48Quaternion;
+
+	/// @brief Basic SIMD helpers working on 4 consecutive floats.
+	/// @note All loads and stores are unaligned so they can be used directly on members of the existing types.
+	namespace simd
+	{
+		/// @brief Adds 4 floats.
+		/// @param[in] a First operand.
+		/// @param[in] b Second operand.
+		/// @param[out] out The result.
+		inline void add4(const float* a, const float* b, float* out)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#elif defined(GTYPES_SIMD_NEON)
+			vst1q_f32(out, vaddq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+			out[0] = a[0] + b[0];
+			out[1] = a[1] + b[1];
+			out[2] = a[2] + b[2];
+			out[3] = a[3] + b[3];
+#endif
+		}
+		/// @brief Subtracts 4 floats.
+		/// @param[in] a First operand.
+		/// @param[in] b Second operand.
+		/// @param[out] out The result.
+		inline void sub4(const float* a, const float* b, float* out)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			_mm_storeu_ps(out, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#elif defined(GTYPES_SIMD_NEON)
+			vst1q_f32(out, vsubq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+			out[0] = a[0] - b[0];
+			out[1] = a[1] - b[1];
+			out[2] = a[2] - b[2];
+			out[3] = a[3] - b[3];
+#endif
+		}
+		/// @brief Multiplies 4 floats.
+		/// @param[in] a First operand.
+		/// @param[in] b Second operand.
+		/// @param[out] out The result.
+		inline void mul4(const float* a, const float* b, float* out)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			_mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#elif defined(GTYPES_SIMD_NEON)
+			vst1q_f32(out, vmulq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+			out[0] = a[0] * b[0];
+			out[1] = a[1] * b[1];
+			out[2] = a[2] * b[2];
+			out[3] = a[3] * b[3];
+#endif
+		}
+		/// @brief Divides 4 floats.
+		/// @param[in] a First operand.
+		/// @param[in] b Second operand.
+		/// @param[out] out The result.
+		inline void div4(const float* a, const float* b, float* out)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			_mm_storeu_ps(out, _mm_div_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+			out[0] = a[0] / b[0];
+			out[1] = a[1] / b[1];
+			out[2] = a[2] / b[2];
+			out[3] = a[3] / b[3];
+#endif
+		}
+		/// @brief Multiplies 4 floats with a factor.
+		/// @param[in] a The operand.
+		/// @param[in] factor The factor.
+		/// @param[out] out The result.
+		inline void scale4(const float* a, float factor, float* out)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			_mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(factor)));
+#elif defined(GTYPES_SIMD_NEON)
+			vst1q_f32(out, vmulq_n_f32(vld1q_f32(a), factor));
+#else
+			out[0] = a[0] * factor;
+			out[1] = a[1] * factor;
+			out[2] = a[2] * factor;
+			out[3] = a[3] * factor;
+#endif
+		}
+		/// @brief Calculates the component-wise minimum of 4 floats.
+		/// @param[in] a First operand.
+		/// @param[in] b Second operand.
+		/// @param[out] out The result.
+		inline void min4(const float* a, const float* b, float* out)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			_mm_storeu_ps(out, _mm_min_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#elif defined(GTYPES_SIMD_NEON)
+			vst1q_f32(out, vminq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+			out[0] = (a[0] < b[0] ? a[0] : b[0]);
+			out[1] = (a[1] < b[1] ? a[1] : b[1]);
+			out[2] = (a[2] < b[2] ? a[2] : b[2]);
+			out[3] = (a[3] < b[3] ? a[3] : b[3]);
+#endif
+		}
+		/// @brief Calculates the component-wise maximum of 4 floats.
+		/// @param[in] a First operand.
+		/// @param[in] b Second operand.
+		/// @param[out] out The result.
+		inline void max4(const float* a, const float* b, float* out)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			_mm_storeu_ps(out, _mm_max_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#elif defined(GTYPES_SIMD_NEON)
+			vst1q_f32(out, vmaxq_f32(vld1q_f32(a), vld1q_f32(b)));
+#else
+			out[0] = (a[0] > b[0] ? a[0] : b[0]);
+			out[1] = (a[1] > b[1] ? a[1] : b[1]);
+			out[2] = (a[2] > b[2] ? a[2] : b[2]);
+			out[3] = (a[3] > b[3] ? a[3] : b[3]);
+#endif
+		}
+		/// @brief Calculates the dot-product of 4 floats.
+		/// @param[in] a First operand.
+		/// @param[in] b Second operand.
+		/// @return The dot-product.
+		inline float dot4(const float* a, const float* b)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			__m128 m = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+			m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+			m = _mm_add_ss(m, _mm_movehl_ps(m, m));
+			return _mm_cvtss_f32(m);
+#elif defined(GTYPES_SIMD_NEON)
+			float32x4_t m = vmulq_f32(vld1q_f32(a), vld1q_f32(b));
+			float32x2_t s = vadd_f32(vget_low_f32(m), vget_high_f32(m));
+			return vget_lane_f32(vpadd_f32(s, s), 0);
+#else
+			return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+#endif
+		}
+		/// @brief Calculates a fast approximation of 1 / sqrt(value).
+		/// @param[in] value The value.
+		/// @return The approximated reciprocal square root.
+		/// @note Uses the hardware reciprocal square root estimate with one Newton-Raphson refinement step (two on NEON).
+		/// @note The maximum relative error is below 2^-21 (5e-7). Without SIMD support the exact 1 / sqrt(value) is used.
+		/// @note The result is undefined if value is 0 or negative.
+		inline float rsqrt(float value)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			__m128 v = _mm_set_ss(value);
+			__m128 y = _mm_rsqrt_ss(v);
+			// y * (1.5 - 0.5 * value * y * y)
+			__m128 yy = _mm_mul_ss(y, y);
+			y = _mm_mul_ss(y, _mm_sub_ss(_mm_set_ss(1.5f), _mm_mul_ss(_mm_mul_ss(v, _mm_set_ss(0.5f)), yy)));
+			return _mm_cvtss_f32(y);
+#elif defined(GTYPES_SIMD_NEON)
+			float32x2_t v = vdup_n_f32(value);
+			float32x2_t y = vrsqrte_f32(v);
+			// the NEON estimate is less precise so 2 refinement steps are needed for the same error bound
+			y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+			y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+			return vget_lane_f32(y, 0);
+#else
+			return (1.0f / sqrtf(value));
+#endif
+		}
+#if defined(GTYPES_SIMD_SSE)
+		/// @brief Calculates fast approximations of 1 / sqrt(value) for 4 squared lengths.
+		/// @param[in] squaredLengths The squared lengths.
+		/// @return The approximated reciprocal square roots.
+		/// @note Lanes with a squared length of 0 return 1 so zero-length vectors stay unchanged when scaled.
+		/// @see rsqrt
+		inline __m128 rsqrtNonZero(__m128 squaredLengths)
+		{
+			__m128 one = _mm_set1_ps(1.0f);
+			__m128 nonZero = _mm_cmpgt_ps(squaredLengths, _mm_setzero_ps());
+			__m128 y = _mm_rsqrt_ps(squaredLengths);
+			y = _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(squaredLengths, _mm_set1_ps(0.5f)), _mm_mul_ps(y, y))));
+			return _mm_or_ps(_mm_and_ps(nonZero, y), _mm_andnot_ps(nonZero, one));
+		}
+#elif defined(GTYPES_SIMD_NEON)
+		/// @brief Calculates fast approximations of 1 / sqrt(value) for 4 squared lengths.
+		/// @param[in] squaredLengths The squared lengths.
+		/// @return The approximated reciprocal square roots.
+		/// @note Lanes with a squared length of 0 return 1 so zero-length vectors stay unchanged when scaled.
+		/// @see rsqrt
+		inline float32x4_t rsqrtNonZero(float32x4_t squaredLengths)
+		{
+			uint32x4_t nonZero = vcgtq_f32(squaredLengths, vdupq_n_f32(0.0f));
+			float32x4_t y = vrsqrteq_f32(squaredLengths);
+			y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(squaredLengths, y), y));
+			y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(squaredLengths, y), y));
+			return vbslq_f32(nonZero, y, vdupq_n_f32(1.0f));
+		}
+#endif
+		/// @brief Calculates a fast polynomial approximation of atan2(y, x).
+		/// @param[in] y The y coordinate.
+		/// @param[in] x The x coordinate.
+		/// @return The angle in radians in the range [-pi, pi].
+		/// @note The maximum absolute error is below 2.5e-6 radians (1.5e-4 degrees).
+		/// @note The sign of y is kept like in atan2() including -0, but x = -0 is treated like x = 0. atan2Fast(0, 0) is 0.
+		inline float atan2Fast(float y, float x)
+		{
+			float absX = fabsf(x);
+			float absY = fabsf(y);
+			float maxValue = (absX > absY ? absX : absY);
+			float minValue = (absX > absY ? absY : absX);
+			float t = (maxValue > 0.0f ? minValue / maxValue : 0.0f);
+			float s = t * t;
+			// odd minimax polynomial of atan(t) for t in [0, 1]
+			float result = ((((-0.01172120f * s + 0.05265332f) * s - 0.11643287f) * s + 0.19354346f) * s - 0.33262347f) * s + 0.99997726f;
+			result *= t;
+			if (absY > absX)
+			{
+				result = 1.57079637f - result;
+			}
+			if (x < 0.0f)
+			{
+				result = 3.14159274f - result;
+			}
+			// copies the sign bit of y so -0 behaves like in atan2()
+			union
+			{
+				float f;
+				unsigned int i;
+			} sign, value;
+			sign.f = y;
+			value.f = result;
+			value.i |= (sign.i & 0x80000000u);
+			return value.f;
+		}
+		/// @brief Transforms 4 floats with a column-major 4x4 matrix.
+		/// @param[in] m The 16 matrix values.
+		/// @param[in] v The 4 vector values.
+		/// @param[out] out The result.
+		/// @note out must not overlap with v.
+		inline void transform4(const float* m, const float* v, float* out)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			__m128 result = _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(v[0]));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1])));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2])));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(v[3])));
+			_mm_storeu_ps(out, result);
+#elif defined(GTYPES_SIMD_NEON)
+			float32x4_t result = vmulq_n_f32(vld1q_f32(m), v[0]);
+			result = vmlaq_n_f32(result, vld1q_f32(m + 4), v[1]);
+			result = vmlaq_n_f32(result, vld1q_f32(m + 8), v[2]);
+			result = vmlaq_n_f32(result, vld1q_f32(m + 12), v[3]);
+			vst1q_f32(out, result);
+#else
+			out[0] = m[0] * v[0] + m[4] * v[1] + m[8] * v[2] + m[12] * v[3];
+			out[1] = m[1] * v[0] + m[5] * v[1] + m[9] * v[2] + m[13] * v[3];
+			out[2] = m[2] * v[0] + m[6] * v[1] + m[10] * v[2] + m[14] * v[3];
+			out[3] = m[3] * v[0] + m[7] * v[1] + m[11] * v[2] + m[15] * v[3];
+#endif
+		}
+		/// @brief Calculates the Hamilton product of two quaternions stored as x, y, z, w.
+		/// @param[in] a First quaternion.
+		/// @param[in] b Second quaternion.
+		/// @param[out] out The result.
+		/// @note out may overlap with a or b.
+		inline void multiplyQuaternion4(const float* a, const float* b, float* out)
+		{
+#if defined(GTYPES_SIMD_SSE)
+			// every component of a scales b with permuted and negated components
+			__m128 qa = _mm_loadu_ps(a);
+			__m128 qb = _mm_loadu_ps(b);
+			__m128 result = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(3, 3, 3, 3)), qb);
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(0, 0, 0, 0)),
+				_mm_xor_ps(_mm_shuffle_ps(qb, qb, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f))));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(1, 1, 1, 1)),
+				_mm_xor_ps(_mm_shuffle_ps(qb, qb, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f))));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(2, 2, 2, 2)),
+				_mm_xor_ps(_mm_shuffle_ps(qb, qb, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f))));
+			_mm_storeu_ps(out, result);
+#elif defined(GTYPES_SIMD_NEON)
+			static const float signs[12] = { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f };
+			float32x4_t qa = vld1q_f32(a);
+			float32x4_t qb = vld1q_f32(b);
+			float32x4_t swapped = vrev64q_f32(qb); // y x w z
+			float32x4_t result = vmulq_n_f32(qb, vgetq_lane_f32(qa, 3));
+			result = vmlaq_n_f32(result, vmulq_f32(vcombine_f32(vget_high_f32(swapped), vget_low_f32(swapped)), vld1q_f32(signs)), vgetq_lane_f32(qa, 0));
+			result = vmlaq_n_f32(result, vmulq_f32(vextq_f32(qb, qb, 2), vld1q_f32(signs + 4)), vgetq_lane_f32(qa, 1));
+			result = vmlaq_n_f32(result, vmulq_f32(swapped, vld1q_f32(signs + 8)), vgetq_lane_f32(qa, 2));
+			vst1q_f32(out, result);
+#else
+			float x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+			float y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+			float z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+			float w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+			out[0] = x;
+			out[1] = y;
+			out[2] = z;
+			out[3] = w;
+#endif
+		}
+
+		/// @brief Instruction set levels used for the runtime dispatch of batch kernels.
+		/// @note The x86 levels are ordered, each one includes all lower ones.
+		enum Level
+		{
+			/// @brief Plain C++ without SIMD intrinsics.
+			LevelScalar = 0,
+			/// @brief SSE2 (x86).
+			LevelSse2,
+			/// @brief SSE4.1 (x86).
+			LevelSse41,
+			/// @brief AVX2 with FMA, F16C and BMI2 (x86).
+			LevelAvx2,
+			/// @brief AVX-512 Foundation (x86).
+			LevelAvx512,
+			/// @brief NEON (ARM).
+			LevelNeon,
+			/// @brief Number of levels.
+			LevelCount
+		};
+
+		/// @brief Function pointer table with one implementation of every batch kernel.
+		/// @note The public batch functions (e.g. Vector3<float>::normalizeFast(Vector3<float>*, int)) call through this table.
+		struct Kernels
+		{
+			/// @brief Kernel of Vector2<float>::normalizeFast(Vector2<float>*, int).
+			void (*normalizeFastVector2f)(Vector2<float>* vectors, int count);
+			/// @brief Kernel of Vector2<float>::angles(const Vector2<float>*, float*, int).
+			void (*anglesVector2f)(const Vector2<float>* vectors, float* angles, int count);
+			/// @brief Kernel of Vector2<float>::fromAngles(const float*, Vector2<float>*, int).
+			void (*fromAnglesVector2f)(const float* angles, Vector2<float>* vectors, int count);
+			/// @brief Kernel of Vector3<float>::normalizeFast(Vector3<float>*, int).
+			void (*normalizeFastVector3f)(Vector3<float>* vectors, int count);
+			/// @brief Kernel of Quaternion::normalizeFast(Quaternion*, int).
+			void (*normalizeFastQuaternion)(Quaternion* quaternions, int count);
+			/// @brief Kernel of Quaternion::multiply().
+			void (*multiplyQuaternion)(const Quaternion* a, const Quaternion* b, Quaternion* result, int count);
+			/// @brief Kernel of Quaternion::slerp(const Quaternion*, const Quaternion*, const float*, Quaternion*, int).
+			void (*slerpQuaternion)(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count);
+			/// @brief Kernel of Quaternion::nlerp(const Quaternion*, const Quaternion*, const float*, Quaternion*, int).
+			void (*nlerpQuaternion)(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count);
+			/// @brief Kernel of Quaternion::rotate(const Quaternion&, const Vector3<float>*, Vector3<float>*, int).
+			void (*rotateVector3f)(const Quaternion& quaternion, const Vector3<float>* vectors, Vector3<float>* result, int count);
+			/// @brief Kernel of Quaternion::rotate(const Quaternion*, const Vector3<float>*, Vector3<float>*, int).
+			void (*rotateVector3fPaired)(const Quaternion* quaternions, const Vector3<float>* vectors, Vector3<float>* result, int count);
+			/// @brief Kernel of Quaternion::fromEulerAngles(const Vector3<float>*, Quaternion*, int).
+			void (*fromEulerAnglesQuaternion)(const Vector3<float>* angles, Quaternion* result, int count);
+			/// @brief Kernel of Quaternion::toEulerAngles(const Quaternion*, Vector3<float>*, int).
+			void (*toEulerAnglesQuaternion)(const Quaternion* quaternions, Vector3<float>* angles, int count);
+			/// @brief Kernel of Quaternion::fromMatrix(const Matrix3*, Quaternion*, int).
+			void (*fromMatrix3Quaternion)(const Matrix3* matrices, Quaternion* result, int count);
+			/// @brief Kernel of Quaternion::fromMatrix(const Matrix4*, Quaternion*, int).
+			void (*fromMatrix4Quaternion)(const Matrix4* matrices, Quaternion* result, int count);
+			/// @brief Kernel of Quaternion::integrate() with QuaternionIntegrationFirstOrder.
+			void (*integrateQuaternion)(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count);
+			/// @brief Kernel of Quaternion::integrate() with QuaternionIntegrationExponential.
+			void (*integrateExponentialQuaternion)(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count);
+			/// @brief Kernel of DualQuaternion::skin().
+			void (*skinDualQuaternion)(const DualQuaternion* bones, const int* boneIndices, const float* boneWeights, int influenceCount,
+				const Vector3<float>* positions, const Vector3<float>* normals, Vector3<float>* resultPositions, Vector3<float>* resultNormals, int count);
+			/// @brief Kernel of compressMask().
+			int (*compressMask)(const unsigned int* mask, int count, int offset, int* indices);
+			/// @brief Kernel of Vector2<float>::maskInCircle(), stride is 2 for Vector2 arrays and 1 for separate arrays.
+			void (*maskInCircle2f)(const float* x, const float* y, int stride, int count, float centerX, float centerY, float radius, unsigned int* mask);
+			/// @brief Kernel of Vector2<float>::findInCircle(), stride is 2 for Vector2 arrays and 1 for separate arrays.
+			int (*findInCircle2f)(const float* x, const float* y, int stride, int count, float centerX, float centerY, float radius, int* result);
+			/// @brief Kernel of Rectangle<float>::maskPointsInside(), stride is 2 for Vector2 arrays and 1 for separate arrays.
+			void (*maskInRectangles2f)(const float* x, const float* y, int stride, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask);
+			/// @brief Kernel of Rectangle<float>::findPointsInside(), stride is 2 for Vector2 arrays and 1 for separate arrays.
+			int (*findInRectangles2f)(const float* x, const float* y, int stride, int count, const Rectangle<float>* rectangles, int rectangleCount, int* result);
+			/// @brief Kernel of HalfVector3::encode().
+			void (*encodeHalfVector3)(const Vector3<float>* vectors, HalfVector3* result, int count);
+			/// @brief Kernel of HalfVector3::decode().
+			void (*decodeHalfVector3)(const HalfVector3* packed, Vector3<float>* result, int count);
+			/// @brief Kernel of Unorm16Vector3::encode().
+			void (*encodeUnorm16Vector3)(const Vector3<float>* vectors, Unorm16Vector3* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum);
+			/// @brief Kernel of Unorm16Vector3::decode().
+			void (*decodeUnorm16Vector3)(const Unorm16Vector3* packed, Vector3<float>* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum);
+			/// @brief Kernel of OctahedralVector3::encode().
+			void (*encodeOctahedralVector3)(const Vector3<float>* vectors, OctahedralVector3* result, int count);
+			/// @brief Kernel of OctahedralVector3::decode().
+			void (*decodeOctahedralVector3)(const OctahedralVector3* packed, Vector3<float>* result, int count);
+			/// @brief Kernel of Snorm10Vector3::encode().
+			void (*encodeSnorm10Vector3)(const Vector3<float>* vectors, Snorm10Vector3* result, int count, int w);
+			/// @brief Kernel of Snorm10Vector3::decode().
+			void (*decodeSnorm10Vector3)(const Snorm10Vector3* packed, Vector3<float>* result, int count);
+			/// @brief Kernel of SmallestThree29Quaternion::encode().
+			void (*encodeSmallestThree29Quaternion)(const Quaternion* quaternions, SmallestThree29Quaternion* result, int count);
+			/// @brief Kernel of SmallestThree29Quaternion::decode().
+			void (*decodeSmallestThree29Quaternion)(const SmallestThree29Quaternion* packed, Quaternion* result, int count);
+			/// @brief Kernel of SmallestThree32Quaternion::encode().
+			void (*encodeSmallestThree32Quaternion)(const Quaternion* quaternions, SmallestThree32Quaternion* result, int count);
+			/// @brief Kernel of SmallestThree32Quaternion::decode().
+			void (*decodeSmallestThree32Quaternion)(const SmallestThree32Quaternion* packed, Quaternion* result, int count);
+			/// @brief Kernel of SmallestThree32Quaternion::encodeDelta().
+			int (*encodeDeltaSmallestThree32Quaternion)(const SmallestThree32Quaternion* packed, const SmallestThree32Quaternion* baselines, int count, unsigned char* buffer);
+			/// @brief Kernel of SmallestThree32Quaternion::decodeDelta().
+			int (*decodeDeltaSmallestThree32Quaternion)(const unsigned char* buffer, int size, const SmallestThree32Quaternion* baselines, SmallestThree32Quaternion* result, int count);
+			/// @brief Kernel of SmallestThree48Quaternion::encode().
+			void (*encodeSmallestThree48Quaternion)(const Quaternion* quaternions, SmallestThree48Quaternion* result, int count);
+			/// @brief Kernel of SmallestThree48Quaternion::decode().
+			void (*decodeSmallestThree48Quaternion)(const SmallestThree48Quaternion* packed, Quaternion* result, int count);
+			/// @brief Kernel of SpaceFillingCurve::encodeMorton(const Vector2<int>*, unsigned long long*, int).
+			void (*encodeMorton2i)(const Vector2<int>* vectors, unsigned long long* keys, int count);
+			/// @brief Kernel of SpaceFillingCurve::decodeMorton(const unsigned long long*, Vector2<int>*, int).
+			void (*decodeMorton2i)(const unsigned long long* keys, Vector2<int>* result, int count);
+			/// @brief Kernel of SpaceFillingCurve::encodeMorton(const Vector3<int>*, unsigned long long*, int).
+			void (*encodeMorton3i)(const Vector3<int>* vectors, unsigned long long* keys, int count);
+			/// @brief Kernel of SpaceFillingCurve::decodeMorton(const unsigned long long*, Vector3<int>*, int).
+			void (*decodeMorton3i)(const unsigned long long* keys, Vector3<int>* result, int count);
+		};
+
+		/// @brief Gets the highest level supported by the CPU and the OS.
+		/// @return The highest supported level.
+		/// @note Detected once at startup using cpuid on x86.
+		gtypesFnExport Level getSupportedLevel();
+		/// @brief Gets the level currently used by the batch kernels.
+		/// @return The current level.
+		/// @note Defaults to the supported level unless the environment variable GTYPES_SIMD_LEVEL is set to one of
+		/// "scalar", "sse2", "sse4.1", "avx2", "avx512" or "neon". A requested level above the supported one is lowered.
+		gtypesFnExport Level getLevel();
+		/// @brief Sets the level used by the batch kernels.
+		/// @param[in] level The new level.
+		/// @return True if the level is supported and was set.
+		/// @note Not thread-safe with concurrently running batch kernels, meant for tests and benchmarks.
+		gtypesFnExport bool setLevel(Level level);
+		/// @brief Checks whether a level is supported by the CPU and the OS.
+		/// @param[in] level The level.
+		/// @return True if the level is supported.
+		gtypesFnExport bool isLevelSupported(Level level);
+		/// @brief Gets the name of a level as used by GTYPES_SIMD_LEVEL.
+		/// @param[in] level The level.
+		/// @return The name of the level.
+		gtypesFnExport const char* getLevelName(Level level);
+		/// @brief Gets the kernel table of the current level.
+		/// @return The kernel table.
+		gtypesFnExport const Kernels& getKernels();
+
+		/// @brief Converts a bitmask into the list of the set bit indices.
+		/// @param[in] mask The bitmask, bit i % 32 of mask[i / 32] stands for index i.
+		/// @param[in] count Number of bits, the bits after count must be 0.
+		/// @param[in] offset Added to every index.
+		/// @param[out] indices Receives the indices in ascending order, needs space for count elements even if fewer bits are set.
+		/// @return Number of set bits.
+		/// @note Uses the SIMD kernel of the current getLevel(), with stream compaction instead of a branch per bit.
+		inline int compressMask(const unsigned int* mask, int count, int offset, int* indices)
+		{
+			return getKernels().compressMask(mask, count, offset, indices);
+		}
+
+	}
+
+}
+
+#endif
@@ -21,6 +21,14 @@
 /// @param[in] radians Angle in radians.
 /// @return Angle in degrees.
 #define RAD_TO_DEG(radians) ((radians) * 57.295779513082320876798154814105)
+/// @brief Converts degrees into radians without promoting to double.
+/// @param[in] degrees Angle in degrees.
+/// @return Angle in radians.
+#define DEG_TO_RAD_F(degrees) ((degrees) * 0.0174532925199432957692f)
+/// @brief Converts radians into degrees without promoting to double.
+/// @param[in] radians Angle in radians.
+/// @return Angle in degrees.
+#define RAD_TO_DEG_F(radians) ((radians) * 57.2957795130823208768f)
 
 /// @brief gtypes e-tolerance.
 #define G_E_TOLERANCE 0.000001
@@ -32,4 +40,25 @@
 /// @brief Provides a simpler syntax to iterate through an std::map.
 #define foreach_stdmap(type_key, type_value, name, container) for (std::map<type_key, type_value>::iterator name = container.begin(); name != container.end(); ++name)
 
+/// @def GTYPES_STD_HASH
+/// @brief Defined when std::hash is available and the gtypes vector types specialize it for unordered containers.
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+	#define GTYPES_STD_HASH
+	#include <functional>
+	#include <stddef.h>
+
+namespace gtypes
+{
+	/// @brief Combines the hash of a value into an existing hash.
+	/// @param[in,out] seed The existing hash.
+	/// @param[in] value The value.
+	template <typename T>
+	inline void hashCombine(size_t& seed, const T& value)
+	{
+		seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	}
+
+}
+#endif
+
 #endif
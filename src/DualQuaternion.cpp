@@ -0,0 +1,470 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <math.h>
+
+#include "gtypesSimd.h"
+#include "gtypesSimdKernels.h"
+#include "DualQuaternion.h"
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+namespace gtypes
+{
+	Matrix4 DualQuaternion::mat4() const
+	{
+		float xx = this->real.x * this->real.x;
+		float yy = this->real.y * this->real.y;
+		float zz = this->real.z * this->real.z;
+		float xy = this->real.x * this->real.y;
+		float xz = this->real.x * this->real.z;
+		float yz = this->real.y * this->real.z;
+		float wx = this->real.w * this->real.x;
+		float wy = this->real.w * this->real.y;
+		float wz = this->real.w * this->real.z;
+		Vector3<float> translation = this->translation();
+		return Matrix4(1.0f - 2.0f * (yy + zz),	2.0f * (xy + wz),			2.0f * (xz - wy),			0.0f,
+					   2.0f * (xy - wz),		1.0f - 2.0f * (xx + zz),	2.0f * (yz + wx),			0.0f,
+					   2.0f * (xz + wy),		2.0f * (yz - wx),			1.0f - 2.0f * (xx + yy),	0.0f,
+					   translation.x,			translation.y,				translation.z,				1.0f);
+	}
+
+	DualQuaternion DualQuaternion::blend(const DualQuaternion* dualQuaternions, const float* weights, int count)
+	{
+		if (count <= 0)
+		{
+			return DualQuaternion();
+		}
+		DualQuaternion result(Quaternion(0.0f, 0.0f, 0.0f, 0.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+		for (int i = 0; i < count; ++i)
+		{
+			float weight = (dualQuaternions[0].real.dot(dualQuaternions[i].real) < 0.0f ? -weights[i] : weights[i]);
+			result.real += dualQuaternions[i].real * weight;
+			result.dual += dualQuaternions[i].dual * weight;
+		}
+		result.normalize();
+		return result;
+	}
+
+	DualQuaternion DualQuaternion::fromMatrix(const Matrix4& matrix)
+	{
+		// mat4() is the transposed rotation of the one used here
+		const float* m = matrix.data;
+		Quaternion rotation = Quaternion::fromMatrix(matrix).conjugated();
+		return DualQuaternion(rotation, Vector3<float>(m[12], m[13], m[14]));
+	}
+
+	void DualQuaternion::skin(const DualQuaternion* bones, const int* boneIndices, const float* boneWeights, int influenceCount,
+		const Vector3<float>* positions, const Vector3<float>* normals, Vector3<float>* resultPositions, Vector3<float>* resultNormals, int count)
+	{
+		simd::getKernels().skinDualQuaternion(bones, boneIndices, boneWeights, influenceCount, positions, normals, resultPositions, resultNormals, count);
+	}
+
+	namespace simd
+	{
+		// skins a single vertex, also used for the remainders of the SIMD kernels
+		static inline void _skinVertex(const DualQuaternion* bones, const int* boneIndices, const float* boneWeights, int influenceCount,
+			const Vector3<float>* positions, const Vector3<float>* normals, Vector3<float>* resultPositions, Vector3<float>* resultNormals, int index)
+		{
+			const int* indices = &boneIndices[index * influenceCount];
+			const float* weights = &boneWeights[index * influenceCount];
+			DualQuaternion blended(Quaternion(0.0f, 0.0f, 0.0f, 0.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+			for (int j = 0; j < influenceCount; ++j)
+			{
+				const DualQuaternion& bone = bones[indices[j]];
+				float weight = (bones[indices[0]].real.dot(bone.real) < 0.0f ? -weights[j] : weights[j]);
+				blended.real += bone.real * weight;
+				blended.dual += bone.dual * weight;
+			}
+			float squaredLength = blended.real.squaredLength();
+			if (squaredLength != 0.0f)
+			{
+				float inverse = rsqrt(squaredLength);
+				blended.real *= inverse;
+				blended.dual *= inverse;
+			}
+			resultPositions[index] = blended.transformPoint(positions[index]);
+			if (normals != NULL)
+			{
+				resultNormals[index] = blended.transformNormal(normals[index]);
+			}
+		}
+
+		static void skinDualQuaternionScalar(const DualQuaternion* bones, const int* boneIndices, const float* boneWeights, int influenceCount,
+			const Vector3<float>* positions, const Vector3<float>* normals, Vector3<float>* resultPositions, Vector3<float>* resultNormals, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				_skinVertex(bones, boneIndices, boneWeights, influenceCount, positions, normals, resultPositions, resultNormals, i);
+			}
+		}
+
+#if defined(GTYPES_SIMD_SSE)
+		// loads 4 Quaternions from arbitrary addresses and transposes them to SoA
+		static inline void _load4Sse2(const float* q0, const float* q1, const float* q2, const float* q3, __m128& x, __m128& y, __m128& z, __m128& w)
+		{
+			x = _mm_loadu_ps(q0);
+			y = _mm_loadu_ps(q1);
+			z = _mm_loadu_ps(q2);
+			w = _mm_loadu_ps(q3);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+		}
+
+		static void skinDualQuaternionSse2(const DualQuaternion* bones, const int* boneIndices, const float* boneWeights, int influenceCount,
+			const Vector3<float>* positions, const Vector3<float>* normals, Vector3<float>* resultPositions, Vector3<float>* resultNormals, int count)
+		{
+			__m128 zero = _mm_setzero_ps();
+			int i = 0;
+			// 4 vertices at once, the bones of every influence are gathered and transposed to SoA
+			for (; i + 4 <= count; i += 4)
+			{
+				const int* indices = &boneIndices[i * influenceCount];
+				const float* weights = &boneWeights[i * influenceCount];
+				__m128 rx = zero;
+				__m128 ry = zero;
+				__m128 rz = zero;
+				__m128 rw = zero;
+				__m128 dx = zero;
+				__m128 dy = zero;
+				__m128 dz = zero;
+				__m128 dw = zero;
+				__m128 firstX = zero;
+				__m128 firstY = zero;
+				__m128 firstZ = zero;
+				__m128 firstW = zero;
+				for (int j = 0; j < influenceCount; ++j)
+				{
+					const DualQuaternion& bone0 = bones[indices[j]];
+					const DualQuaternion& bone1 = bones[indices[influenceCount + j]];
+					const DualQuaternion& bone2 = bones[indices[influenceCount * 2 + j]];
+					const DualQuaternion& bone3 = bones[indices[influenceCount * 3 + j]];
+					__m128 bx;
+					__m128 by;
+					__m128 bz;
+					__m128 bw;
+					_load4Sse2(&bone0.real.x, &bone1.real.x, &bone2.real.x, &bone3.real.x, bx, by, bz, bw);
+					if (j == 0)
+					{
+						firstX = bx;
+						firstY = by;
+						firstZ = bz;
+						firstW = bw;
+					}
+					__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(firstX, bx), _mm_mul_ps(firstY, by)), _mm_add_ps(_mm_mul_ps(firstZ, bz), _mm_mul_ps(firstW, bw)));
+					__m128 weight = _mm_setr_ps(weights[j], weights[influenceCount + j], weights[influenceCount * 2 + j], weights[influenceCount * 3 + j]);
+					// bones on the opposite hemisphere of the first bone are negated through the sign bit of the weight
+					weight = _mm_xor_ps(weight, _mm_and_ps(_mm_cmplt_ps(dot, zero), _mm_set1_ps(-0.0f)));
+					rx = _mm_add_ps(rx, _mm_mul_ps(bx, weight));
+					ry = _mm_add_ps(ry, _mm_mul_ps(by, weight));
+					rz = _mm_add_ps(rz, _mm_mul_ps(bz, weight));
+					rw = _mm_add_ps(rw, _mm_mul_ps(bw, weight));
+					_load4Sse2(&bone0.dual.x, &bone1.dual.x, &bone2.dual.x, &bone3.dual.x, bx, by, bz, bw);
+					dx = _mm_add_ps(dx, _mm_mul_ps(bx, weight));
+					dy = _mm_add_ps(dy, _mm_mul_ps(by, weight));
+					dz = _mm_add_ps(dz, _mm_mul_ps(bz, weight));
+					dw = _mm_add_ps(dw, _mm_mul_ps(bw, weight));
+				}
+				__m128 squaredLengths = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+				__m128 inverse = rsqrtNonZero(squaredLengths);
+				rx = _mm_mul_ps(rx, inverse);
+				ry = _mm_mul_ps(ry, inverse);
+				rz = _mm_mul_ps(rz, inverse);
+				rw = _mm_mul_ps(rw, inverse);
+				dx = _mm_mul_ps(dx, inverse);
+				dy = _mm_mul_ps(dy, inverse);
+				dz = _mm_mul_ps(dz, inverse);
+				dw = _mm_mul_ps(dw, inverse);
+				__m128 tx = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dx), _mm_mul_ps(dw, rx)), _mm_sub_ps(_mm_mul_ps(ry, dz), _mm_mul_ps(rz, dy)));
+				__m128 ty = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dy), _mm_mul_ps(dw, ry)), _mm_sub_ps(_mm_mul_ps(rz, dx), _mm_mul_ps(rx, dz)));
+				__m128 tz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dz), _mm_mul_ps(dw, rz)), _mm_sub_ps(_mm_mul_ps(rx, dy), _mm_mul_ps(ry, dx)));
+				__m128 x;
+				__m128 y;
+				__m128 z;
+				load3(&positions[i].x, x, y, z);
+				rotate3(rx, ry, rz, rw, x, y, z);
+				store3(&resultPositions[i].x, _mm_add_ps(x, _mm_add_ps(tx, tx)), _mm_add_ps(y, _mm_add_ps(ty, ty)), _mm_add_ps(z, _mm_add_ps(tz, tz)));
+				if (normals != NULL)
+				{
+					load3(&normals[i].x, x, y, z);
+					rotate3(rx, ry, rz, rw, x, y, z);
+					store3(&resultNormals[i].x, x, y, z);
+				}
+			}
+			for (; i < count; ++i)
+			{
+				_skinVertex(bones, boneIndices, boneWeights, influenceCount, positions, normals, resultPositions, resultNormals, i);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void skinDualQuaternionAvx2(const DualQuaternion* bones, const int* boneIndices, const float* boneWeights, int influenceCount,
+			const Vector3<float>* positions, const Vector3<float>* normals, Vector3<float>* resultPositions, Vector3<float>* resultNormals, int count)
+		{
+			const float* base = &bones[0].real.x;
+			__m256 zero = _mm256_setzero_ps();
+			__m256i strides = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(influenceCount));
+			int i = 0;
+			// 8 vertices at once, the bone components of every influence are gathered directly in SoA layout
+			for (; i + 8 <= count; i += 8)
+			{
+				const int* indices = &boneIndices[i * influenceCount];
+				const float* weights = &boneWeights[i * influenceCount];
+				__m256 r[4] = { zero, zero, zero, zero };
+				__m256 d[4] = { zero, zero, zero, zero };
+				__m256 first[4] = { zero, zero, zero, zero };
+				for (int j = 0; j < influenceCount; ++j)
+				{
+					// a DualQuaternion is 8 floats, real part first
+					__m256i offsets = _mm256_slli_epi32(_mm256_i32gather_epi32(indices + j, strides, 4), 3);
+					__m256 b[4];
+					for (int k = 0; k < 4; ++k)
+					{
+						b[k] = _mm256_i32gather_ps(base + k, offsets, 4);
+					}
+					if (j == 0)
+					{
+						for (int k = 0; k < 4; ++k)
+						{
+							first[k] = b[k];
+						}
+					}
+					__m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(first[0], b[0]), _mm256_mul_ps(first[1], b[1])),
+						_mm256_add_ps(_mm256_mul_ps(first[2], b[2]), _mm256_mul_ps(first[3], b[3])));
+					__m256 weight = _mm256_i32gather_ps(weights + j, strides, 4);
+					weight = _mm256_xor_ps(weight, _mm256_and_ps(_mm256_cmp_ps(dot, zero, _CMP_LT_OQ), _mm256_set1_ps(-0.0f)));
+					for (int k = 0; k < 4; ++k)
+					{
+						r[k] = _mm256_fmadd_ps(b[k], weight, r[k]);
+						d[k] = _mm256_fmadd_ps(_mm256_i32gather_ps(base + 4 + k, offsets, 4), weight, d[k]);
+					}
+				}
+				__m256 squaredLengths = _mm256_fmadd_ps(r[0], r[0], _mm256_fmadd_ps(r[1], r[1], _mm256_fmadd_ps(r[2], r[2], _mm256_mul_ps(r[3], r[3]))));
+				__m256 inverse = rsqrtNonZero(squaredLengths);
+				for (int k = 0; k < 4; ++k)
+				{
+					r[k] = _mm256_mul_ps(r[k], inverse);
+					d[k] = _mm256_mul_ps(d[k], inverse);
+				}
+				__m256 tx = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(r[3], d[0]), _mm256_mul_ps(d[3], r[0])), _mm256_sub_ps(_mm256_mul_ps(r[1], d[2]), _mm256_mul_ps(r[2], d[1])));
+				__m256 ty = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(r[3], d[1]), _mm256_mul_ps(d[3], r[1])), _mm256_sub_ps(_mm256_mul_ps(r[2], d[0]), _mm256_mul_ps(r[0], d[2])));
+				__m256 tz = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(r[3], d[2]), _mm256_mul_ps(d[3], r[2])), _mm256_sub_ps(_mm256_mul_ps(r[0], d[1]), _mm256_mul_ps(r[1], d[0])));
+				__m256 x;
+				__m256 y;
+				__m256 z;
+				load3(&positions[i].x, x, y, z);
+				rotate3(r[0], r[1], r[2], r[3], x, y, z);
+				store3(&resultPositions[i].x, _mm256_add_ps(x, _mm256_add_ps(tx, tx)), _mm256_add_ps(y, _mm256_add_ps(ty, ty)), _mm256_add_ps(z, _mm256_add_ps(tz, tz)));
+				if (normals != NULL)
+				{
+					load3(&normals[i].x, x, y, z);
+					rotate3(r[0], r[1], r[2], r[3], x, y, z);
+					store3(&resultNormals[i].x, x, y, z);
+				}
+			}
+			for (; i < count; ++i)
+			{
+				_skinVertex(bones, boneIndices, boneWeights, influenceCount, positions, normals, resultPositions, resultNormals, i);
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_AVX512)
+		GTYPES_TARGET_AVX512 static void skinDualQuaternionAvx512(const DualQuaternion* bones, const int* boneIndices, const float* boneWeights, int influenceCount,
+			const Vector3<float>* positions, const Vector3<float>* normals, Vector3<float>* resultPositions, Vector3<float>* resultNormals, int count)
+		{
+			const float* base = &bones[0].real.x;
+			__m512 zero = _mm512_setzero_ps();
+			__m512i strides = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(influenceCount));
+			int i = 0;
+			// 16 vertices at once, same approach as the AVX2 version
+			for (; i + 16 <= count; i += 16)
+			{
+				const int* indices = &boneIndices[i * influenceCount];
+				const float* weights = &boneWeights[i * influenceCount];
+				__m512 r[4] = { zero, zero, zero, zero };
+				__m512 d[4] = { zero, zero, zero, zero };
+				__m512 first[4] = { zero, zero, zero, zero };
+				for (int j = 0; j < influenceCount; ++j)
+				{
+					__m512i offsets = _mm512_slli_epi32(_mm512_i32gather_epi32(strides, indices + j, 4), 3);
+					__m512 b[4];
+					for (int k = 0; k < 4; ++k)
+					{
+						b[k] = _mm512_i32gather_ps(offsets, base + k, 4);
+					}
+					if (j == 0)
+					{
+						for (int k = 0; k < 4; ++k)
+						{
+							first[k] = b[k];
+						}
+					}
+					__m512 dot = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(first[0], b[0]), _mm512_mul_ps(first[1], b[1])),
+						_mm512_add_ps(_mm512_mul_ps(first[2], b[2]), _mm512_mul_ps(first[3], b[3])));
+					__m512 weight = _mm512_i32gather_ps(strides, weights + j, 4);
+					weight = _mm512_mask_sub_ps(weight, _mm512_cmp_ps_mask(dot, zero, _CMP_LT_OQ), zero, weight);
+					for (int k = 0; k < 4; ++k)
+					{
+						r[k] = _mm512_fmadd_ps(b[k], weight, r[k]);
+						d[k] = _mm512_fmadd_ps(_mm512_i32gather_ps(offsets, base + 4 + k, 4), weight, d[k]);
+					}
+				}
+				__m512 squaredLengths = _mm512_fmadd_ps(r[0], r[0], _mm512_fmadd_ps(r[1], r[1], _mm512_fmadd_ps(r[2], r[2], _mm512_mul_ps(r[3], r[3]))));
+				__m512 inverse = rsqrtNonZero(squaredLengths);
+				for (int k = 0; k < 4; ++k)
+				{
+					r[k] = _mm512_mul_ps(r[k], inverse);
+					d[k] = _mm512_mul_ps(d[k], inverse);
+				}
+				__m512 tx = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(r[3], d[0]), _mm512_mul_ps(d[3], r[0])), _mm512_sub_ps(_mm512_mul_ps(r[1], d[2]), _mm512_mul_ps(r[2], d[1])));
+				__m512 ty = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(r[3], d[1]), _mm512_mul_ps(d[3], r[1])), _mm512_sub_ps(_mm512_mul_ps(r[2], d[0]), _mm512_mul_ps(r[0], d[2])));
+				__m512 tz = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(r[3], d[2]), _mm512_mul_ps(d[3], r[2])), _mm512_sub_ps(_mm512_mul_ps(r[0], d[1]), _mm512_mul_ps(r[1], d[0])));
+				__m512 x;
+				__m512 y;
+				__m512 z;
+				load3(&positions[i].x, x, y, z);
+				rotate3(r[0], r[1], r[2], r[3], x, y, z);
+				store3(&resultPositions[i].x, _mm512_add_ps(x, _mm512_add_ps(tx, tx)), _mm512_add_ps(y, _mm512_add_ps(ty, ty)), _mm512_add_ps(z, _mm512_add_ps(tz, tz)));
+				if (normals != NULL)
+				{
+					load3(&normals[i].x, x, y, z);
+					rotate3(r[0], r[1], r[2], r[3], x, y, z);
+					store3(&resultNormals[i].x, x, y, z);
+				}
+			}
+			for (; i < count; ++i)
+			{
+				_skinVertex(bones, boneIndices, boneWeights, influenceCount, positions, normals, resultPositions, resultNormals, i);
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_NEON)
+		// loads 4 Quaternions from arbitrary addresses and transposes them to SoA
+		static inline float32x4x4_t _load4Neon(const float* q0, const float* q1, const float* q2, const float* q3)
+		{
+			float32x4x2_t a = vtrnq_f32(vld1q_f32(q0), vld1q_f32(q1)); // x0 x1 z0 z1, y0 y1 w0 w1
+			float32x4x2_t b = vtrnq_f32(vld1q_f32(q2), vld1q_f32(q3)); // x2 x3 z2 z3, y2 y3 w2 w3
+			float32x4x4_t result;
+			result.val[0] = vcombine_f32(vget_low_f32(a.val[0]), vget_low_f32(b.val[0]));
+			result.val[1] = vcombine_f32(vget_low_f32(a.val[1]), vget_low_f32(b.val[1]));
+			result.val[2] = vcombine_f32(vget_high_f32(a.val[0]), vget_high_f32(b.val[0]));
+			result.val[3] = vcombine_f32(vget_high_f32(a.val[1]), vget_high_f32(b.val[1]));
+			return result;
+		}
+
+		static void skinDualQuaternionNeon(const DualQuaternion* bones, const int* boneIndices, const float* boneWeights, int influenceCount,
+			const Vector3<float>* positions, const Vector3<float>* normals, Vector3<float>* resultPositions, Vector3<float>* resultNormals, int count)
+		{
+			float32x4_t zero = vdupq_n_f32(0.0f);
+			int i = 0;
+			// 4 vertices at once, the bones of every influence are gathered and transposed to SoA
+			for (; i + 4 <= count; i += 4)
+			{
+				const int* indices = &boneIndices[i * influenceCount];
+				const float* weights = &boneWeights[i * influenceCount];
+				float32x4x4_t r;
+				float32x4x4_t d;
+				float32x4x4_t first;
+				for (int k = 0; k < 4; ++k)
+				{
+					r.val[k] = zero;
+					d.val[k] = zero;
+					first.val[k] = zero;
+				}
+				for (int j = 0; j < influenceCount; ++j)
+				{
+					const DualQuaternion& bone0 = bones[indices[j]];
+					const DualQuaternion& bone1 = bones[indices[influenceCount + j]];
+					const DualQuaternion& bone2 = bones[indices[influenceCount * 2 + j]];
+					const DualQuaternion& bone3 = bones[indices[influenceCount * 3 + j]];
+					float32x4x4_t b = _load4Neon(&bone0.real.x, &bone1.real.x, &bone2.real.x, &bone3.real.x);
+					if (j == 0)
+					{
+						first = b;
+					}
+					float32x4_t dot = vmulq_f32(first.val[0], b.val[0]);
+					dot = vmlaq_f32(dot, first.val[1], b.val[1]);
+					dot = vmlaq_f32(dot, first.val[2], b.val[2]);
+					dot = vmlaq_f32(dot, first.val[3], b.val[3]);
+					float weightValues[4] = { weights[j], weights[influenceCount + j], weights[influenceCount * 2 + j], weights[influenceCount * 3 + j] };
+					float32x4_t weight = vld1q_f32(weightValues);
+					weight = vbslq_f32(vcltq_f32(dot, zero), vnegq_f32(weight), weight);
+					float32x4x4_t c = _load4Neon(&bone0.dual.x, &bone1.dual.x, &bone2.dual.x, &bone3.dual.x);
+					for (int k = 0; k < 4; ++k)
+					{
+						r.val[k] = vmlaq_f32(r.val[k], b.val[k], weight);
+						d.val[k] = vmlaq_f32(d.val[k], c.val[k], weight);
+					}
+				}
+				float32x4_t squaredLengths = vmulq_f32(r.val[0], r.val[0]);
+				squaredLengths = vmlaq_f32(squaredLengths, r.val[1], r.val[1]);
+				squaredLengths = vmlaq_f32(squaredLengths, r.val[2], r.val[2]);
+				squaredLengths = vmlaq_f32(squaredLengths, r.val[3], r.val[3]);
+				float32x4_t inverse = rsqrtNonZero(squaredLengths);
+				for (int k = 0; k < 4; ++k)
+				{
+					r.val[k] = vmulq_f32(r.val[k], inverse);
+					d.val[k] = vmulq_f32(d.val[k], inverse);
+				}
+				float32x4_t tx = vaddq_f32(vsubq_f32(vmulq_f32(r.val[3], d.val[0]), vmulq_f32(d.val[3], r.val[0])), vsubq_f32(vmulq_f32(r.val[1], d.val[2]), vmulq_f32(r.val[2], d.val[1])));
+				float32x4_t ty = vaddq_f32(vsubq_f32(vmulq_f32(r.val[3], d.val[1]), vmulq_f32(d.val[3], r.val[1])), vsubq_f32(vmulq_f32(r.val[2], d.val[0]), vmulq_f32(r.val[0], d.val[2])));
+				float32x4_t tz = vaddq_f32(vsubq_f32(vmulq_f32(r.val[3], d.val[2]), vmulq_f32(d.val[3], r.val[2])), vsubq_f32(vmulq_f32(r.val[0], d.val[1]), vmulq_f32(r.val[1], d.val[0])));
+				float32x4x3_t v = vld3q_f32(&positions[i].x);
+				rotate3(r.val[0], r.val[1], r.val[2], r.val[3], v);
+				v.val[0] = vaddq_f32(v.val[0], vaddq_f32(tx, tx));
+				v.val[1] = vaddq_f32(v.val[1], vaddq_f32(ty, ty));
+				v.val[2] = vaddq_f32(v.val[2], vaddq_f32(tz, tz));
+				vst3q_f32(&resultPositions[i].x, v);
+				if (normals != NULL)
+				{
+					v = vld3q_f32(&normals[i].x);
+					rotate3(r.val[0], r.val[1], r.val[2], r.val[3], v);
+					vst3q_f32(&resultNormals[i].x, v);
+				}
+			}
+			for (; i < count; ++i)
+			{
+				_skinVertex(bones, boneIndices, boneWeights, influenceCount, positions, normals, resultPositions, resultNormals, i);
+			}
+		}
+#endif
+
+		void registerDualQuaternionKernels(Kernels& kernels, Level level)
+		{
+			switch (level)
+			{
+			case LevelScalar:
+				kernels.skinDualQuaternion = &skinDualQuaternionScalar;
+				break;
+#if defined(GTYPES_SIMD_SSE)
+			case LevelSse2:
+				kernels.skinDualQuaternion = &skinDualQuaternionSse2;
+				break;
+			case LevelAvx2:
+				kernels.skinDualQuaternion = &skinDualQuaternionAvx2;
+				break;
+#endif
+#if defined(GTYPES_SIMD_AVX512)
+			case LevelAvx512:
+				kernels.skinDualQuaternion = &skinDualQuaternionAvx512;
+				break;
+#endif
+#if defined(GTYPES_SIMD_NEON)
+			case LevelNeon:
+				kernels.skinDualQuaternion = &skinDualQuaternionNeon;
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+
+	}
+
+}
@@ -0,0 +1,1145 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <math.h>
+
+#include "gtypesSimd.h"
+#include "gtypesSimdKernels.h"
+#include "PackedQuaternion.h"
+#include "Quaternion.h"
+
+namespace gtypes
+{
+	// finds the largest absolute component with ties going to the lower index and quantizes the other three to limit steps
+	// per 1 / sqrt(2), the clamping and rounding are the same as in PackedVector3 so every level produces the same bits
+	static inline unsigned int _encodeSmallestThree(const Quaternion& quaternion, int limit, unsigned int* values)
+	{
+		const float* components = &quaternion.x;
+		unsigned int index = 0;
+		float largest = fabsf(components[0]);
+		for (unsigned int i = 1; i < 4; ++i)
+		{
+			if (fabsf(components[i]) > largest)
+			{
+				index = i;
+				largest = fabsf(components[i]);
+			}
+		}
+		float maximum = (float)limit;
+		float scale = maximum * 1.41421356f;
+		if (components[index] < 0.0f)
+		{
+			scale = -scale;
+		}
+		int count = 0;
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			if (i != index)
+			{
+				float value = components[i] * scale;
+				value = (value > -maximum ? value : -maximum);
+				value = (value < maximum ? value : maximum);
+				values[count] = (unsigned int)((int)(value + (value >= 0.0f ? 0.5f : -0.5f)) + limit);
+				++count;
+			}
+		}
+		return index;
+	}
+
+	// restores the largest component from the unit length
+	static inline Quaternion _decodeSmallestThree(unsigned int index, unsigned int a, unsigned int b, unsigned int c, int limit)
+	{
+		float factor = 1.0f / ((float)limit * 1.41421356f);
+		float first = (float)((int)a - limit) * factor;
+		float second = (float)((int)b - limit) * factor;
+		float third = (float)((int)c - limit) * factor;
+		float squared = 1.0f - (first * first + second * second + third * third);
+		float largest = (squared > 0.0f ? sqrtf(squared) : 0.0f);
+		switch (index)
+		{
+		case 0:
+			return Quaternion(largest, first, second, third);
+		case 1:
+			return Quaternion(first, largest, second, third);
+		case 2:
+			return Quaternion(first, second, largest, third);
+		default:
+			break;
+		}
+		return Quaternion(first, second, third, largest);
+	}
+
+	// packs the three components and the index into the lowest 3 * Bits + 2 bits
+	template <int Bits>
+	static inline unsigned int _packSmallestThree(const Quaternion& quaternion)
+	{
+		unsigned int values[3];
+		unsigned int index = _encodeSmallestThree(quaternion, (1 << (Bits - 1)) - 1, values);
+		return (values[0] | (values[1] << Bits) | (values[2] << (Bits * 2)) | (index << (Bits * 3)));
+	}
+
+	template <int Bits>
+	static inline Quaternion _unpackSmallestThree(unsigned int value)
+	{
+		unsigned int mask = (1u << Bits) - 1;
+		return _decodeSmallestThree(value >> (Bits * 3), value & mask, (value >> Bits) & mask, (value >> (Bits * 2)) & mask, (1 << (Bits - 1)) - 1);
+	}
+
+	void SmallestThree29Quaternion::set(const Quaternion& quaternion)
+	{
+		this->value = _packSmallestThree<9>(quaternion);
+	}
+
+	Quaternion SmallestThree29Quaternion::toQuaternion() const
+	{
+		return _unpackSmallestThree<9>(this->value);
+	}
+
+	void SmallestThree32Quaternion::set(const Quaternion& quaternion)
+	{
+		this->value = _packSmallestThree<10>(quaternion);
+	}
+
+	Quaternion SmallestThree32Quaternion::toQuaternion() const
+	{
+		return _unpackSmallestThree<10>(this->value);
+	}
+
+	void SmallestThree48Quaternion::set(const Quaternion& quaternion)
+	{
+		unsigned int values[3];
+		unsigned int index = _encodeSmallestThree(quaternion, 16383, values);
+		this->x = (unsigned short)(values[0] | ((index & 1) << 15));
+		this->y = (unsigned short)(values[1] | ((index >> 1) << 15));
+		this->z = (unsigned short)values[2];
+	}
+
+	Quaternion SmallestThree48Quaternion::toQuaternion() const
+	{
+		return _decodeSmallestThree((this->x >> 15) | ((this->y >> 15) << 1), this->x & 0x7FFF, this->y & 0x7FFF, this->z, 16383);
+	}
+
+	namespace simd
+	{
+		// payload bytes of the delta tags: equal, 5-bit differences, 8-bit differences, full value
+		static const int deltaTagSizes[4] = { 0, 2, 3, 4 };
+		// lookup tables of the delta kernels indexed by the control byte of 4 Quaternions, filled before the kernels are
+		// registered, 0x80 selects a zero byte
+		static int deltaLengths[256];
+		static unsigned char deltaDecodeShuffles[256][16];
+		static unsigned char deltaEncodeShuffles[256][16];
+
+		static void _buildDeltaTables()
+		{
+			for (int i = 0; i < 256; ++i)
+			{
+				for (int j = 0; j < 16; ++j)
+				{
+					deltaDecodeShuffles[i][j] = 0x80;
+					deltaEncodeShuffles[i][j] = 0x80;
+				}
+				int offset = 0;
+				for (int j = 0; j < 4; ++j)
+				{
+					int size = deltaTagSizes[(i >> (j * 2)) & 3];
+					for (int k = 0; k < size; ++k)
+					{
+						deltaDecodeShuffles[i][j * 4 + k] = (unsigned char)(offset + k);
+						deltaEncodeShuffles[i][offset + k] = (unsigned char)(j * 4 + k);
+					}
+					offset += size;
+				}
+				deltaLengths[i] = offset;
+			}
+		}
+
+		// adds the differences to the 10-bit components of the baseline, the index stays the same
+		static inline unsigned int _applyDelta(unsigned int baseline, int d0, int d1, int d2)
+		{
+			return (((baseline + d0) & 0x3FF) | ((((baseline >> 10) + d1) & 0x3FF) << 10) | ((((baseline >> 20) + d2) & 0x3FF) << 20) | (baseline & 0xC0000000u));
+		}
+
+		// encodes up to 4 Quaternions, writes their payload to data and returns the control byte
+		static unsigned int _encodeDeltaGroup(const SmallestThree32Quaternion* packed, const SmallestThree32Quaternion* baselines, int count, unsigned char*& data)
+		{
+			unsigned int control = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				unsigned int value = packed[i].value;
+				unsigned int baseline = baselines[i].value;
+				unsigned int tag = 3;
+				unsigned int payload = value;
+				if (value == baseline)
+				{
+					tag = 0;
+				}
+				else if ((value >> 30) == (baseline >> 30))
+				{
+					int d0 = (int)(value & 0x3FF) - (int)(baseline & 0x3FF);
+					int d1 = (int)((value >> 10) & 0x3FF) - (int)((baseline >> 10) & 0x3FF);
+					int d2 = (int)((value >> 20) & 0x3FF) - (int)((baseline >> 20) & 0x3FF);
+					if (d0 >= -16 && d0 < 16 && d1 >= -16 && d1 < 16 && d2 >= -16 && d2 < 16)
+					{
+						tag = 1;
+						payload = (unsigned int)(d0 + 16) | ((unsigned int)(d1 + 16) << 5) | ((unsigned int)(d2 + 16) << 10);
+					}
+					else if (d0 >= -128 && d0 < 128 && d1 >= -128 && d1 < 128 && d2 >= -128 && d2 < 128)
+					{
+						tag = 2;
+						payload = (unsigned int)(d0 + 128) | ((unsigned int)(d1 + 128) << 8) | ((unsigned int)(d2 + 128) << 16);
+					}
+				}
+				control |= tag << (i * 2);
+				for (int j = 0; j < deltaTagSizes[tag]; ++j)
+				{
+					*data = (unsigned char)(payload >> (j * 8));
+					++data;
+				}
+			}
+			return control;
+		}
+
+		// decodes up to 4 Quaternions, returns the data behind their payload or NULL if the payload does not fit before end
+		static const unsigned char* _decodeDeltaGroup(unsigned int control, const unsigned char* data, const unsigned char* end,
+			const SmallestThree32Quaternion* baselines, SmallestThree32Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				unsigned int tag = (control >> (i * 2)) & 3;
+				int size = deltaTagSizes[tag];
+				if (end - data < size)
+				{
+					return NULL;
+				}
+				unsigned int payload = 0;
+				for (int j = 0; j < size; ++j)
+				{
+					payload |= (unsigned int)data[j] << (j * 8);
+				}
+				data += size;
+				unsigned int baseline = baselines[i].value;
+				switch (tag)
+				{
+				case 0:
+					result[i].value = baseline;
+					break;
+				case 1:
+					result[i].value = _applyDelta(baseline, (int)(payload & 0x1F) - 16, (int)((payload >> 5) & 0x1F) - 16, (int)((payload >> 10) & 0x1F) - 16);
+					break;
+				case 2:
+					result[i].value = _applyDelta(baseline, (int)(payload & 0xFF) - 128, (int)((payload >> 8) & 0xFF) - 128, (int)(payload >> 16) - 128);
+					break;
+				default:
+					result[i].value = payload;
+					break;
+				}
+			}
+			return data;
+		}
+
+		static void encodeSmallestThree29QuaternionScalar(const Quaternion* quaternions, SmallestThree29Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i].set(quaternions[i]);
+			}
+		}
+
+		static void decodeSmallestThree29QuaternionScalar(const SmallestThree29Quaternion* packed, Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = packed[i].toQuaternion();
+			}
+		}
+
+		static void encodeSmallestThree32QuaternionScalar(const Quaternion* quaternions, SmallestThree32Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i].set(quaternions[i]);
+			}
+		}
+
+		static void decodeSmallestThree32QuaternionScalar(const SmallestThree32Quaternion* packed, Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = packed[i].toQuaternion();
+			}
+		}
+
+		static int encodeDeltaSmallestThree32QuaternionScalar(const SmallestThree32Quaternion* packed, const SmallestThree32Quaternion* baselines, int count, unsigned char* buffer)
+		{
+			// all control bytes come first so the payload of a group starts right behind the previous one
+			unsigned char* data = buffer + (count + 3) / 4;
+			for (int i = 0; i < count; i += 4)
+			{
+				buffer[i / 4] = (unsigned char)_encodeDeltaGroup(&packed[i], &baselines[i], (count - i < 4 ? count - i : 4), data);
+			}
+			return (int)(data - buffer);
+		}
+
+		static int decodeDeltaSmallestThree32QuaternionScalar(const unsigned char* buffer, int size, const SmallestThree32Quaternion* baselines, SmallestThree32Quaternion* result, int count)
+		{
+			int controlSize = (count + 3) / 4;
+			if (size < controlSize)
+			{
+				return -1;
+			}
+			const unsigned char* data = buffer + controlSize;
+			const unsigned char* end = buffer + size;
+			for (int i = 0; i < count && data != NULL; i += 4)
+			{
+				data = _decodeDeltaGroup(buffer[i / 4], data, end, &baselines[i], &result[i], (count - i < 4 ? count - i : 4));
+			}
+			return (data != NULL ? (int)(data - buffer) : -1);
+		}
+
+		static void encodeSmallestThree48QuaternionScalar(const Quaternion* quaternions, SmallestThree48Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i].set(quaternions[i]);
+			}
+		}
+
+		static void decodeSmallestThree48QuaternionScalar(const SmallestThree48Quaternion* packed, Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = packed[i].toQuaternion();
+			}
+		}
+
+#if defined(GTYPES_SIMD_SSE)
+		// _encodeSmallestThree() for 4 Quaternions in SoA layout, returns the indices of the largest components
+		static inline __m128i _encodeSmallestThreeSse2(__m128 x, __m128 y, __m128 z, __m128 w, int limit, __m128i& v0, __m128i& v1, __m128i& v2)
+		{
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			__m128 absX = _mm_andnot_ps(signMask, x);
+			__m128 absY = _mm_andnot_ps(signMask, y);
+			__m128 absZ = _mm_andnot_ps(signMask, z);
+			__m128 largest = _mm_max_ps(_mm_max_ps(absX, absY), _mm_max_ps(absZ, _mm_andnot_ps(signMask, w)));
+			// the first component equal to the largest one wins like in the scalar version
+			__m128 isX = _mm_cmpeq_ps(absX, largest);
+			__m128 isXY = _mm_or_ps(isX, _mm_cmpeq_ps(absY, largest));
+			__m128 isXYZ = _mm_or_ps(isXY, _mm_cmpeq_ps(absZ, largest));
+			__m128 selected = _mm_or_ps(_mm_and_ps(isX, x), _mm_andnot_ps(isX, y));
+			selected = _mm_or_ps(_mm_and_ps(isXY, selected), _mm_andnot_ps(isXY, z));
+			selected = _mm_or_ps(_mm_and_ps(isXYZ, selected), _mm_andnot_ps(isXYZ, w));
+			__m128 maximum = _mm_set1_ps((float)limit);
+			__m128 minimum = _mm_set1_ps(-(float)limit);
+			__m128 scale = _mm_xor_ps(_mm_set1_ps((float)limit * 1.41421356f), _mm_and_ps(_mm_cmplt_ps(selected, _mm_setzero_ps()), signMask));
+			__m128 values[3];
+			values[0] = _mm_or_ps(_mm_and_ps(isX, y), _mm_andnot_ps(isX, x));
+			values[1] = _mm_or_ps(_mm_and_ps(isXY, z), _mm_andnot_ps(isXY, y));
+			values[2] = _mm_or_ps(_mm_and_ps(isXYZ, w), _mm_andnot_ps(isXYZ, z));
+			__m128i quantized[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				__m128 value = _mm_min_ps(_mm_max_ps(_mm_mul_ps(values[i], scale), minimum), maximum);
+				__m128 half = _mm_or_ps(_mm_and_ps(value, signMask), _mm_set1_ps(0.5f));
+				quantized[i] = _mm_add_epi32(_mm_cvttps_epi32(_mm_add_ps(value, half)), _mm_set1_epi32(limit));
+			}
+			v0 = quantized[0];
+			v1 = quantized[1];
+			v2 = quantized[2];
+			// 3 plus the masks, which are -1 where set
+			__m128i index = _mm_add_epi32(_mm_castps_si128(isX), _mm_add_epi32(_mm_castps_si128(isXY), _mm_castps_si128(isXYZ)));
+			return _mm_add_epi32(index, _mm_set1_epi32(3));
+		}
+
+		// _decodeSmallestThree() for 4 Quaternions, returns them in SoA layout
+		static inline void _decodeSmallestThreeSse2(__m128i index, __m128i a, __m128i b, __m128i c, int limit, __m128& x, __m128& y, __m128& z, __m128& w)
+		{
+			__m128 factor = _mm_set1_ps(1.0f / ((float)limit * 1.41421356f));
+			__m128i offset = _mm_set1_epi32(limit);
+			__m128 first = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(a, offset)), factor);
+			__m128 second = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(b, offset)), factor);
+			__m128 third = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(c, offset)), factor);
+			__m128 squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(first, first), _mm_mul_ps(second, second)), _mm_mul_ps(third, third));
+			__m128 largest = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), squared), _mm_setzero_ps()));
+			__m128 isX = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_setzero_si128()));
+			__m128 isY = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)));
+			__m128 isZ = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)));
+			__m128 isW = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)));
+			__m128 isXY = _mm_or_ps(isX, isY);
+			x = _mm_or_ps(_mm_and_ps(isX, largest), _mm_andnot_ps(isX, first));
+			y = _mm_or_ps(_mm_and_ps(isX, first), _mm_andnot_ps(isX, _mm_or_ps(_mm_and_ps(isY, largest), _mm_andnot_ps(isY, second))));
+			z = _mm_or_ps(_mm_and_ps(isXY, second), _mm_andnot_ps(isXY, _mm_or_ps(_mm_and_ps(isZ, largest), _mm_andnot_ps(isZ, third))));
+			w = _mm_or_ps(_mm_and_ps(isW, largest), _mm_andnot_ps(isW, third));
+		}
+
+		template <int Bits, typename T>
+		static void _encodeSmallestThreeSse2(const Quaternion* quaternions, T* result, int count)
+		{
+			__m128 x;
+			__m128 y;
+			__m128 z;
+			__m128 w;
+			__m128i v0;
+			__m128i v1;
+			__m128i v2;
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				load4(&quaternions[i].x, x, y, z, w);
+				__m128i index = _encodeSmallestThreeSse2(x, y, z, w, (1 << (Bits - 1)) - 1, v0, v1, v2);
+				__m128i values = _mm_or_si128(_mm_or_si128(v0, _mm_slli_epi32(v1, Bits)), _mm_or_si128(_mm_slli_epi32(v2, Bits * 2), _mm_slli_epi32(index, Bits * 3)));
+				_mm_storeu_si128((__m128i*)&result[i].value, values);
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(quaternions[i]);
+			}
+		}
+
+		template <int Bits, typename T>
+		static void _decodeSmallestThreeSse2(const T* packed, Quaternion* result, int count)
+		{
+			__m128i mask = _mm_set1_epi32((1 << Bits) - 1);
+			__m128 x;
+			__m128 y;
+			__m128 z;
+			__m128 w;
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i values = _mm_loadu_si128((const __m128i*)&packed[i].value);
+				_decodeSmallestThreeSse2(_mm_srli_epi32(values, Bits * 3), _mm_and_si128(values, mask), _mm_and_si128(_mm_srli_epi32(values, Bits), mask),
+					_mm_and_si128(_mm_srli_epi32(values, Bits * 2), mask), (1 << (Bits - 1)) - 1, x, y, z, w);
+				store4(&result[i].x, x, y, z, w);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toQuaternion();
+			}
+		}
+
+		static void encodeSmallestThree29QuaternionSse2(const Quaternion* quaternions, SmallestThree29Quaternion* result, int count)
+		{
+			_encodeSmallestThreeSse2<9>(quaternions, result, count);
+		}
+
+		static void decodeSmallestThree29QuaternionSse2(const SmallestThree29Quaternion* packed, Quaternion* result, int count)
+		{
+			_decodeSmallestThreeSse2<9>(packed, result, count);
+		}
+
+		static void encodeSmallestThree32QuaternionSse2(const Quaternion* quaternions, SmallestThree32Quaternion* result, int count)
+		{
+			_encodeSmallestThreeSse2<10>(quaternions, result, count);
+		}
+
+		static void decodeSmallestThree32QuaternionSse2(const SmallestThree32Quaternion* packed, Quaternion* result, int count)
+		{
+			_decodeSmallestThreeSse2<10>(packed, result, count);
+		}
+
+		static void encodeSmallestThree48QuaternionSse2(const Quaternion* quaternions, SmallestThree48Quaternion* result, int count)
+		{
+			__m128 x;
+			__m128 y;
+			__m128 z;
+			__m128 w;
+			__m128i v0;
+			__m128i v1;
+			__m128i v2;
+			unsigned int values[3][4];
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				load4(&quaternions[i].x, x, y, z, w);
+				__m128i index = _encodeSmallestThreeSse2(x, y, z, w, 16383, v0, v1, v2);
+				_mm_storeu_si128((__m128i*)values[0], _mm_or_si128(v0, _mm_slli_epi32(_mm_and_si128(index, _mm_set1_epi32(1)), 15)));
+				_mm_storeu_si128((__m128i*)values[1], _mm_or_si128(v1, _mm_slli_epi32(_mm_srli_epi32(index, 1), 15)));
+				_mm_storeu_si128((__m128i*)values[2], v2);
+				// SSE2 has no 16-bit shuffle across the register, the 3 shorts of each Quaternion are written one by one
+				for (int j = 0; j < 4; ++j)
+				{
+					result[i + j].x = (unsigned short)values[0][j];
+					result[i + j].y = (unsigned short)values[1][j];
+					result[i + j].z = (unsigned short)values[2][j];
+				}
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(quaternions[i]);
+			}
+		}
+
+		static void decodeSmallestThree48QuaternionSse2(const SmallestThree48Quaternion* packed, Quaternion* result, int count)
+		{
+			__m128i lowMask = _mm_set1_epi32(0x7FFF);
+			__m128 x;
+			__m128 y;
+			__m128 z;
+			__m128 w;
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				// the 24 bytes as shorts 0-7 and 4-11, byte shifts move x and y or y and z of each Quaternion into one 32 bit lane
+				__m128i low = _mm_loadu_si128((const __m128i*)&packed[i].x);
+				__m128i high = _mm_loadu_si128((const __m128i*)((const unsigned char*)&packed[i] + 8));
+				__m128i xy = _mm_unpacklo_epi64(_mm_unpacklo_epi32(low, _mm_srli_si128(low, 6)), _mm_unpacklo_epi32(_mm_srli_si128(high, 4), _mm_srli_si128(high, 10)));
+				__m128i yz = _mm_unpacklo_epi64(_mm_unpacklo_epi32(_mm_srli_si128(low, 2), _mm_srli_si128(low, 8)), _mm_unpacklo_epi32(_mm_srli_si128(high, 6), _mm_srli_si128(high, 12)));
+				__m128i index = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(xy, 15), _mm_set1_epi32(1)), _mm_slli_epi32(_mm_srli_epi32(xy, 31), 1));
+				_decodeSmallestThreeSse2(index, _mm_and_si128(xy, lowMask), _mm_and_si128(_mm_srli_epi32(xy, 16), lowMask), _mm_srli_epi32(yz, 16), 16383, x, y, z, w);
+				store4(&result[i].x, x, y, z, w);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toQuaternion();
+			}
+		}
+
+		GTYPES_TARGET_SSE41 static int encodeDeltaSmallestThree32QuaternionSse41(const SmallestThree32Quaternion* packed, const SmallestThree32Quaternion* baselines, int count, unsigned char* buffer)
+		{
+			__m128i mask = _mm_set1_epi32(0x3FF);
+			__m128i smallBias = _mm_set1_epi32(16);
+			__m128i mediumBias = _mm_set1_epi32(128);
+			__m128i zero = _mm_setzero_si128();
+			unsigned char* data = buffer + (count + 3) / 4;
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i value = _mm_loadu_si128((const __m128i*)&packed[i].value);
+				__m128i baseline = _mm_loadu_si128((const __m128i*)&baselines[i].value);
+				__m128i d0 = _mm_sub_epi32(_mm_and_si128(value, mask), _mm_and_si128(baseline, mask));
+				__m128i d1 = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(value, 10), mask), _mm_and_si128(_mm_srli_epi32(baseline, 10), mask));
+				__m128i d2 = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(value, 20), mask), _mm_and_si128(_mm_srli_epi32(baseline, 20), mask));
+				__m128i sameIndex = _mm_cmpeq_epi32(_mm_srli_epi32(value, 30), _mm_srli_epi32(baseline, 30));
+				__m128i small0 = _mm_add_epi32(d0, smallBias);
+				__m128i small1 = _mm_add_epi32(d1, smallBias);
+				__m128i small2 = _mm_add_epi32(d2, smallBias);
+				__m128i medium0 = _mm_add_epi32(d0, mediumBias);
+				__m128i medium1 = _mm_add_epi32(d1, mediumBias);
+				__m128i medium2 = _mm_add_epi32(d2, mediumBias);
+				// a biased difference fits if no bits above the field are set, negative ones have all of them set
+				__m128i isSmall = _mm_and_si128(sameIndex, _mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(_mm_or_si128(small0, small1), small2), _mm_set1_epi32(~0x1F)), zero));
+				__m128i isMedium = _mm_and_si128(sameIndex, _mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(_mm_or_si128(medium0, medium1), medium2), _mm_set1_epi32(~0xFF)), zero));
+				// 3 + isMedium + isSmall with the masks as -1, a small difference is also a medium one
+				__m128i tags = _mm_andnot_si128(_mm_cmpeq_epi32(value, baseline), _mm_add_epi32(_mm_add_epi32(_mm_set1_epi32(3), isMedium), isSmall));
+				__m128i payload = _mm_blendv_epi8(value, _mm_or_si128(_mm_or_si128(medium0, _mm_slli_epi32(medium1, 8)), _mm_slli_epi32(medium2, 16)), isMedium);
+				payload = _mm_blendv_epi8(payload, _mm_or_si128(_mm_or_si128(small0, _mm_slli_epi32(small1, 5)), _mm_slli_epi32(small2, 10)), isSmall);
+				__m128i control = _mm_mullo_epi32(tags, _mm_setr_epi32(1, 4, 16, 64));
+				control = _mm_or_si128(control, _mm_shuffle_epi32(control, _MM_SHUFFLE(1, 0, 3, 2)));
+				control = _mm_or_si128(control, _mm_shuffle_epi32(control, _MM_SHUFFLE(2, 3, 0, 1)));
+				int bits = _mm_cvtsi128_si32(control);
+				buffer[i / 4] = (unsigned char)bits;
+				// a full group writes at most 16 bytes so the whole store stays within getMaximumDeltaSize()
+				_mm_storeu_si128((__m128i*)data, _mm_shuffle_epi8(payload, _mm_loadu_si128((const __m128i*)deltaEncodeShuffles[bits])));
+				data += deltaLengths[bits];
+			}
+			if (i < count)
+			{
+				buffer[i / 4] = (unsigned char)_encodeDeltaGroup(&packed[i], &baselines[i], count - i, data);
+			}
+			return (int)(data - buffer);
+		}
+
+		GTYPES_TARGET_SSE41 static int decodeDeltaSmallestThree32QuaternionSse41(const unsigned char* buffer, int size, const SmallestThree32Quaternion* baselines, SmallestThree32Quaternion* result, int count)
+		{
+			int controlSize = (count + 3) / 4;
+			if (size < controlSize)
+			{
+				return -1;
+			}
+			__m128i mask = _mm_set1_epi32(0x3FF);
+			__m128i smallMask = _mm_set1_epi32(0x1F);
+			__m128i mediumMask = _mm_set1_epi32(0xFF);
+			__m128i smallBias = _mm_set1_epi32(16);
+			__m128i mediumBias = _mm_set1_epi32(128);
+			const unsigned char* data = buffer + controlSize;
+			const unsigned char* end = buffer + size;
+			int i = 0;
+			// the payload of a group is at most 16 bytes, the last groups are decoded like in the scalar version when the
+			// unaligned load would read past the end of the buffer
+			for (; i + 4 <= count && end - data >= 16; i += 4)
+			{
+				int control = buffer[i / 4];
+				__m128i payload = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), _mm_loadu_si128((const __m128i*)deltaDecodeShuffles[control]));
+				__m128i tags = _mm_setr_epi32(control & 3, (control >> 2) & 3, (control >> 4) & 3, control >> 6);
+				__m128i isSmall = _mm_cmpeq_epi32(tags, _mm_set1_epi32(1));
+				__m128i isMedium = _mm_cmpeq_epi32(tags, _mm_set1_epi32(2));
+				__m128i baseline = _mm_loadu_si128((const __m128i*)&baselines[i].value);
+				__m128i d0 = _mm_or_si128(_mm_and_si128(isSmall, _mm_sub_epi32(_mm_and_si128(payload, smallMask), smallBias)),
+					_mm_and_si128(isMedium, _mm_sub_epi32(_mm_and_si128(payload, mediumMask), mediumBias)));
+				__m128i d1 = _mm_or_si128(_mm_and_si128(isSmall, _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(payload, 5), smallMask), smallBias)),
+					_mm_and_si128(isMedium, _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(payload, 8), mediumMask), mediumBias)));
+				__m128i d2 = _mm_or_si128(_mm_and_si128(isSmall, _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(payload, 10), smallMask), smallBias)),
+					_mm_and_si128(isMedium, _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(payload, 16), mediumMask), mediumBias)));
+				__m128i value = _mm_and_si128(_mm_add_epi32(baseline, d0), mask);
+				value = _mm_or_si128(value, _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(_mm_srli_epi32(baseline, 10), d1), mask), 10));
+				value = _mm_or_si128(value, _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(_mm_srli_epi32(baseline, 20), d2), mask), 20));
+				value = _mm_or_si128(value, _mm_and_si128(baseline, _mm_set1_epi32((int)0xC0000000u)));
+				value = _mm_blendv_epi8(value, payload, _mm_cmpeq_epi32(tags, _mm_set1_epi32(3)));
+				_mm_storeu_si128((__m128i*)&result[i].value, value);
+				data += deltaLengths[control];
+			}
+			for (; i < count && data != NULL; i += 4)
+			{
+				data = _decodeDeltaGroup(buffer[i / 4], data, end, &baselines[i], &result[i], (count - i < 4 ? count - i : 4));
+			}
+			return (data != NULL ? (int)(data - buffer) : -1);
+		}
+
+		// _encodeSmallestThreeSse2() for 8 Quaternions
+		GTYPES_TARGET_AVX2 static inline __m256i _encodeSmallestThreeAvx2(__m256 x, __m256 y, __m256 z, __m256 w, int limit, __m256i& v0, __m256i& v1, __m256i& v2)
+		{
+			__m256 signMask = _mm256_set1_ps(-0.0f);
+			__m256 absX = _mm256_andnot_ps(signMask, x);
+			__m256 absY = _mm256_andnot_ps(signMask, y);
+			__m256 absZ = _mm256_andnot_ps(signMask, z);
+			__m256 largest = _mm256_max_ps(_mm256_max_ps(absX, absY), _mm256_max_ps(absZ, _mm256_andnot_ps(signMask, w)));
+			__m256 isX = _mm256_cmp_ps(absX, largest, _CMP_EQ_OQ);
+			__m256 isXY = _mm256_or_ps(isX, _mm256_cmp_ps(absY, largest, _CMP_EQ_OQ));
+			__m256 isXYZ = _mm256_or_ps(isXY, _mm256_cmp_ps(absZ, largest, _CMP_EQ_OQ));
+			__m256 selected = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(w, z, isXYZ), y, isXY), x, isX);
+			__m256 maximum = _mm256_set1_ps((float)limit);
+			__m256 minimum = _mm256_set1_ps(-(float)limit);
+			__m256 scale = _mm256_xor_ps(_mm256_set1_ps((float)limit * 1.41421356f), _mm256_and_ps(_mm256_cmp_ps(selected, _mm256_setzero_ps(), _CMP_LT_OQ), signMask));
+			__m256 values[3];
+			values[0] = _mm256_blendv_ps(x, y, isX);
+			values[1] = _mm256_blendv_ps(y, z, isXY);
+			values[2] = _mm256_blendv_ps(z, w, isXYZ);
+			__m256i quantized[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				__m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(values[i], scale), minimum), maximum);
+				__m256 half = _mm256_or_ps(_mm256_and_ps(value, signMask), _mm256_set1_ps(0.5f));
+				quantized[i] = _mm256_add_epi32(_mm256_cvttps_epi32(_mm256_add_ps(value, half)), _mm256_set1_epi32(limit));
+			}
+			v0 = quantized[0];
+			v1 = quantized[1];
+			v2 = quantized[2];
+			__m256i index = _mm256_add_epi32(_mm256_castps_si256(isX), _mm256_add_epi32(_mm256_castps_si256(isXY), _mm256_castps_si256(isXYZ)));
+			return _mm256_add_epi32(index, _mm256_set1_epi32(3));
+		}
+
+		// _decodeSmallestThreeSse2() for 8 Quaternions
+		GTYPES_TARGET_AVX2 static inline void _decodeSmallestThreeAvx2(__m256i index, __m256i a, __m256i b, __m256i c, int limit, __m256& x, __m256& y, __m256& z, __m256& w)
+		{
+			__m256 factor = _mm256_set1_ps(1.0f / ((float)limit * 1.41421356f));
+			__m256i offset = _mm256_set1_epi32(limit);
+			__m256 first = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(a, offset)), factor);
+			__m256 second = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(b, offset)), factor);
+			__m256 third = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(c, offset)), factor);
+			__m256 squared = _mm256_fmadd_ps(third, third, _mm256_fmadd_ps(second, second, _mm256_mul_ps(first, first)));
+			__m256 largest = _mm256_sqrt_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), squared), _mm256_setzero_ps()));
+			__m256 isX = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_setzero_si256()));
+			__m256 isY = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(1)));
+			__m256 isZ = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(2)));
+			__m256 isW = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(3)));
+			x = _mm256_blendv_ps(first, largest, isX);
+			y = _mm256_blendv_ps(_mm256_blendv_ps(second, largest, isY), first, isX);
+			z = _mm256_blendv_ps(_mm256_blendv_ps(third, largest, isZ), second, _mm256_or_ps(isX, isY));
+			w = _mm256_blendv_ps(third, largest, isW);
+		}
+
+		// load4() leaves Quaternion 2 * k + l at position 4 * l + k, the packed values are permuted to and from that order
+		template <int Bits, typename T>
+		GTYPES_TARGET_AVX2 static void _encodeSmallestThreeAvx2(const Quaternion* quaternions, T* result, int count)
+		{
+			__m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			__m256 x;
+			__m256 y;
+			__m256 z;
+			__m256 w;
+			__m256i v0;
+			__m256i v1;
+			__m256i v2;
+			int i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				load4(&quaternions[i].x, x, y, z, w);
+				__m256i index = _encodeSmallestThreeAvx2(x, y, z, w, (1 << (Bits - 1)) - 1, v0, v1, v2);
+				__m256i values = _mm256_or_si256(_mm256_or_si256(v0, _mm256_slli_epi32(v1, Bits)), _mm256_or_si256(_mm256_slli_epi32(v2, Bits * 2), _mm256_slli_epi32(index, Bits * 3)));
+				_mm256_storeu_si256((__m256i*)&result[i].value, _mm256_permutevar8x32_epi32(values, order));
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(quaternions[i]);
+			}
+		}
+
+		template <int Bits, typename T>
+		GTYPES_TARGET_AVX2 static void _decodeSmallestThreeAvx2(const T* packed, Quaternion* result, int count)
+		{
+			__m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			__m256i mask = _mm256_set1_epi32((1 << Bits) - 1);
+			__m256 x;
+			__m256 y;
+			__m256 z;
+			__m256 w;
+			int i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256i values = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)&packed[i].value), order);
+				_decodeSmallestThreeAvx2(_mm256_srli_epi32(values, Bits * 3), _mm256_and_si256(values, mask), _mm256_and_si256(_mm256_srli_epi32(values, Bits), mask),
+					_mm256_and_si256(_mm256_srli_epi32(values, Bits * 2), mask), (1 << (Bits - 1)) - 1, x, y, z, w);
+				store4(&result[i].x, x, y, z, w);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toQuaternion();
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void encodeSmallestThree29QuaternionAvx2(const Quaternion* quaternions, SmallestThree29Quaternion* result, int count)
+		{
+			_encodeSmallestThreeAvx2<9>(quaternions, result, count);
+		}
+
+		GTYPES_TARGET_AVX2 static void decodeSmallestThree29QuaternionAvx2(const SmallestThree29Quaternion* packed, Quaternion* result, int count)
+		{
+			_decodeSmallestThreeAvx2<9>(packed, result, count);
+		}
+
+		GTYPES_TARGET_AVX2 static void encodeSmallestThree32QuaternionAvx2(const Quaternion* quaternions, SmallestThree32Quaternion* result, int count)
+		{
+			_encodeSmallestThreeAvx2<10>(quaternions, result, count);
+		}
+
+		GTYPES_TARGET_AVX2 static void decodeSmallestThree32QuaternionAvx2(const SmallestThree32Quaternion* packed, Quaternion* result, int count)
+		{
+			_decodeSmallestThreeAvx2<10>(packed, result, count);
+		}
+#endif
+
+#if defined(GTYPES_SIMD_AVX512)
+		// _encodeSmallestThreeSse2() for 16 Quaternions
+		GTYPES_TARGET_AVX512 static inline __m512i _encodeSmallestThreeAvx512(__m512 x, __m512 y, __m512 z, __m512 w, int limit, __m512i& v0, __m512i& v1, __m512i& v2)
+		{
+			__m512i signMask = _mm512_set1_epi32((int)0x80000000u);
+			__m512 absX = _mm512_abs_ps(x);
+			__m512 absY = _mm512_abs_ps(y);
+			__m512 absZ = _mm512_abs_ps(z);
+			__m512 largest = _mm512_max_ps(_mm512_max_ps(absX, absY), _mm512_max_ps(absZ, _mm512_abs_ps(w)));
+			__mmask16 isX = _mm512_cmp_ps_mask(absX, largest, _CMP_EQ_OQ);
+			__mmask16 isXY = (__mmask16)(isX | _mm512_cmp_ps_mask(absY, largest, _CMP_EQ_OQ));
+			__mmask16 isXYZ = (__mmask16)(isXY | _mm512_cmp_ps_mask(absZ, largest, _CMP_EQ_OQ));
+			__m512 selected = _mm512_mask_blend_ps(isX, _mm512_mask_blend_ps(isXY, _mm512_mask_blend_ps(isXYZ, w, z), y), x);
+			__m512 maximum = _mm512_set1_ps((float)limit);
+			__m512 minimum = _mm512_set1_ps(-(float)limit);
+			__m512i scaleBits = _mm512_castps_si512(_mm512_set1_ps((float)limit * 1.41421356f));
+			__m512 scale = _mm512_castsi512_ps(_mm512_mask_xor_epi32(scaleBits, _mm512_cmp_ps_mask(selected, _mm512_setzero_ps(), _CMP_LT_OQ), scaleBits, signMask));
+			__m512 values[3];
+			values[0] = _mm512_mask_blend_ps(isX, x, y);
+			values[1] = _mm512_mask_blend_ps(isXY, y, z);
+			values[2] = _mm512_mask_blend_ps(isXYZ, z, w);
+			__m512i quantized[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				__m512 value = _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(values[i], scale), minimum), maximum);
+				__m512 half = _mm512_castsi512_ps(_mm512_or_si512(_mm512_and_si512(_mm512_castps_si512(value), signMask), _mm512_castps_si512(_mm512_set1_ps(0.5f))));
+				quantized[i] = _mm512_add_epi32(_mm512_cvttps_epi32(_mm512_add_ps(value, half)), _mm512_set1_epi32(limit));
+			}
+			v0 = quantized[0];
+			v1 = quantized[1];
+			v2 = quantized[2];
+			__m512i one = _mm512_set1_epi32(1);
+			__m512i index = _mm512_sub_epi32(_mm512_set1_epi32(3), _mm512_maskz_mov_epi32(isX, one));
+			index = _mm512_sub_epi32(index, _mm512_maskz_mov_epi32(isXY, one));
+			return _mm512_sub_epi32(index, _mm512_maskz_mov_epi32(isXYZ, one));
+		}
+
+		// _decodeSmallestThreeSse2() for 16 Quaternions
+		GTYPES_TARGET_AVX512 static inline void _decodeSmallestThreeAvx512(__m512i index, __m512i a, __m512i b, __m512i c, int limit, __m512& x, __m512& y, __m512& z, __m512& w)
+		{
+			__m512 factor = _mm512_set1_ps(1.0f / ((float)limit * 1.41421356f));
+			__m512i offset = _mm512_set1_epi32(limit);
+			__m512 first = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_sub_epi32(a, offset)), factor);
+			__m512 second = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_sub_epi32(b, offset)), factor);
+			__m512 third = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_sub_epi32(c, offset)), factor);
+			__m512 squared = _mm512_fmadd_ps(third, third, _mm512_fmadd_ps(second, second, _mm512_mul_ps(first, first)));
+			__m512 largest = _mm512_sqrt_ps(_mm512_max_ps(_mm512_sub_ps(_mm512_set1_ps(1.0f), squared), _mm512_setzero_ps()));
+			__mmask16 isX = _mm512_cmpeq_epi32_mask(index, _mm512_setzero_si512());
+			__mmask16 isY = _mm512_cmpeq_epi32_mask(index, _mm512_set1_epi32(1));
+			__mmask16 isZ = _mm512_cmpeq_epi32_mask(index, _mm512_set1_epi32(2));
+			__mmask16 isW = _mm512_cmpeq_epi32_mask(index, _mm512_set1_epi32(3));
+			x = _mm512_mask_blend_ps(isX, first, largest);
+			y = _mm512_mask_blend_ps(isX, _mm512_mask_blend_ps(isY, second, largest), first);
+			z = _mm512_mask_blend_ps((__mmask16)(isX | isY), _mm512_mask_blend_ps(isZ, third, largest), second);
+			w = _mm512_mask_blend_ps(isW, third, largest);
+		}
+
+		// load4() leaves Quaternion 4 * k + l at position 4 * l + k, the same permutation restores the original order
+		template <int Bits, typename T>
+		GTYPES_TARGET_AVX512 static void _encodeSmallestThreeAvx512(const Quaternion* quaternions, T* result, int count)
+		{
+			__m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+			__m512 x;
+			__m512 y;
+			__m512 z;
+			__m512 w;
+			__m512i v0;
+			__m512i v1;
+			__m512i v2;
+			int i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				load4(&quaternions[i].x, x, y, z, w);
+				__m512i index = _encodeSmallestThreeAvx512(x, y, z, w, (1 << (Bits - 1)) - 1, v0, v1, v2);
+				__m512i values = _mm512_or_si512(_mm512_or_si512(v0, _mm512_slli_epi32(v1, Bits)), _mm512_or_si512(_mm512_slli_epi32(v2, Bits * 2), _mm512_slli_epi32(index, Bits * 3)));
+				_mm512_storeu_si512(&result[i].value, _mm512_permutexvar_epi32(order, values));
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(quaternions[i]);
+			}
+		}
+
+		template <int Bits, typename T>
+		GTYPES_TARGET_AVX512 static void _decodeSmallestThreeAvx512(const T* packed, Quaternion* result, int count)
+		{
+			__m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+			__m512i mask = _mm512_set1_epi32((1 << Bits) - 1);
+			__m512 x;
+			__m512 y;
+			__m512 z;
+			__m512 w;
+			int i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512i values = _mm512_permutexvar_epi32(order, _mm512_loadu_si512(&packed[i].value));
+				_decodeSmallestThreeAvx512(_mm512_srli_epi32(values, Bits * 3), _mm512_and_si512(values, mask), _mm512_and_si512(_mm512_srli_epi32(values, Bits), mask),
+					_mm512_and_si512(_mm512_srli_epi32(values, Bits * 2), mask), (1 << (Bits - 1)) - 1, x, y, z, w);
+				store4(&result[i].x, x, y, z, w);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toQuaternion();
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void encodeSmallestThree29QuaternionAvx512(const Quaternion* quaternions, SmallestThree29Quaternion* result, int count)
+		{
+			_encodeSmallestThreeAvx512<9>(quaternions, result, count);
+		}
+
+		GTYPES_TARGET_AVX512 static void decodeSmallestThree29QuaternionAvx512(const SmallestThree29Quaternion* packed, Quaternion* result, int count)
+		{
+			_decodeSmallestThreeAvx512<9>(packed, result, count);
+		}
+
+		GTYPES_TARGET_AVX512 static void encodeSmallestThree32QuaternionAvx512(const Quaternion* quaternions, SmallestThree32Quaternion* result, int count)
+		{
+			_encodeSmallestThreeAvx512<10>(quaternions, result, count);
+		}
+
+		GTYPES_TARGET_AVX512 static void decodeSmallestThree32QuaternionAvx512(const SmallestThree32Quaternion* packed, Quaternion* result, int count)
+		{
+			_decodeSmallestThreeAvx512<10>(packed, result, count);
+		}
+#endif
+
+#if defined(GTYPES_SIMD_NEON)
+		// _encodeSmallestThreeSse2() for 4 Quaternions
+		static inline uint32x4_t _encodeSmallestThreeNeon(float32x4x4_t q, int limit, uint32x4_t& v0, uint32x4_t& v1, uint32x4_t& v2)
+		{
+			float32x4_t absX = vabsq_f32(q.val[0]);
+			float32x4_t absY = vabsq_f32(q.val[1]);
+			float32x4_t absZ = vabsq_f32(q.val[2]);
+			float32x4_t largest = vmaxq_f32(vmaxq_f32(absX, absY), vmaxq_f32(absZ, vabsq_f32(q.val[3])));
+			uint32x4_t isX = vceqq_f32(absX, largest);
+			uint32x4_t isXY = vorrq_u32(isX, vceqq_f32(absY, largest));
+			uint32x4_t isXYZ = vorrq_u32(isXY, vceqq_f32(absZ, largest));
+			float32x4_t selected = vbslq_f32(isX, q.val[0], vbslq_f32(isXY, q.val[1], vbslq_f32(isXYZ, q.val[2], q.val[3])));
+			float32x4_t maximum = vdupq_n_f32((float)limit);
+			float32x4_t minimum = vdupq_n_f32(-(float)limit);
+			float32x4_t scale = vdupq_n_f32((float)limit * 1.41421356f);
+			scale = vbslq_f32(vcltq_f32(selected, vdupq_n_f32(0.0f)), vnegq_f32(scale), scale);
+			float32x4_t values[3];
+			values[0] = vbslq_f32(isX, q.val[1], q.val[0]);
+			values[1] = vbslq_f32(isXY, q.val[2], q.val[1]);
+			values[2] = vbslq_f32(isXYZ, q.val[3], q.val[2]);
+			uint32x4_t quantized[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				float32x4_t value = vminq_f32(vmaxq_f32(vmulq_f32(values[i], scale), minimum), maximum);
+				float32x4_t half = vbslq_f32(vdupq_n_u32(0x80000000u), value, vdupq_n_f32(0.5f));
+				quantized[i] = vreinterpretq_u32_s32(vaddq_s32(vcvtq_s32_f32(vaddq_f32(value, half)), vdupq_n_s32(limit)));
+			}
+			v0 = quantized[0];
+			v1 = quantized[1];
+			v2 = quantized[2];
+			return vaddq_u32(vdupq_n_u32(3), vaddq_u32(isX, vaddq_u32(isXY, isXYZ)));
+		}
+
+		// _decodeSmallestThreeSse2() for 4 Quaternions
+		static inline float32x4x4_t _decodeSmallestThreeNeon(uint32x4_t index, uint32x4_t a, uint32x4_t b, uint32x4_t c, int limit)
+		{
+			float factor = 1.0f / ((float)limit * 1.41421356f);
+			int32x4_t offset = vdupq_n_s32(limit);
+			float32x4_t first = vmulq_n_f32(vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(a), offset)), factor);
+			float32x4_t second = vmulq_n_f32(vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(b), offset)), factor);
+			float32x4_t third = vmulq_n_f32(vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(c), offset)), factor);
+			float32x4_t squared = vmlaq_f32(vmlaq_f32(vmulq_f32(first, first), second, second), third, third);
+			float32x4_t largest = vsqrtq_f32(vmaxq_f32(vsubq_f32(vdupq_n_f32(1.0f), squared), vdupq_n_f32(0.0f)));
+			uint32x4_t isX = vceqq_u32(index, vdupq_n_u32(0));
+			uint32x4_t isY = vceqq_u32(index, vdupq_n_u32(1));
+			uint32x4_t isZ = vceqq_u32(index, vdupq_n_u32(2));
+			uint32x4_t isW = vceqq_u32(index, vdupq_n_u32(3));
+			float32x4x4_t q;
+			q.val[0] = vbslq_f32(isX, largest, first);
+			q.val[1] = vbslq_f32(isX, first, vbslq_f32(isY, largest, second));
+			q.val[2] = vbslq_f32(vorrq_u32(isX, isY), second, vbslq_f32(isZ, largest, third));
+			q.val[3] = vbslq_f32(isW, largest, third);
+			return q;
+		}
+
+		template <int Bits, typename T>
+		static void _encodeSmallestThreeNeon(const Quaternion* quaternions, T* result, int count)
+		{
+			uint32x4_t v0;
+			uint32x4_t v1;
+			uint32x4_t v2;
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				uint32x4_t index = _encodeSmallestThreeNeon(vld4q_f32(&quaternions[i].x), (1 << (Bits - 1)) - 1, v0, v1, v2);
+				uint32x4_t values = vorrq_u32(vorrq_u32(v0, vshlq_n_u32(v1, Bits)), vorrq_u32(vshlq_n_u32(v2, Bits * 2), vshlq_n_u32(index, Bits * 3)));
+				vst1q_u32(&result[i].value, values);
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(quaternions[i]);
+			}
+		}
+
+		template <int Bits, typename T>
+		static void _decodeSmallestThreeNeon(const T* packed, Quaternion* result, int count)
+		{
+			uint32x4_t mask = vdupq_n_u32((1u << Bits) - 1);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				uint32x4_t values = vld1q_u32(&packed[i].value);
+				vst4q_f32(&result[i].x, _decodeSmallestThreeNeon(vshrq_n_u32(values, Bits * 3), vandq_u32(values, mask), vandq_u32(vshrq_n_u32(values, Bits), mask),
+					vandq_u32(vshrq_n_u32(values, Bits * 2), mask), (1 << (Bits - 1)) - 1));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toQuaternion();
+			}
+		}
+
+		static void encodeSmallestThree29QuaternionNeon(const Quaternion* quaternions, SmallestThree29Quaternion* result, int count)
+		{
+			_encodeSmallestThreeNeon<9>(quaternions, result, count);
+		}
+
+		static void decodeSmallestThree29QuaternionNeon(const SmallestThree29Quaternion* packed, Quaternion* result, int count)
+		{
+			_decodeSmallestThreeNeon<9>(packed, result, count);
+		}
+
+		static void encodeSmallestThree32QuaternionNeon(const Quaternion* quaternions, SmallestThree32Quaternion* result, int count)
+		{
+			_encodeSmallestThreeNeon<10>(quaternions, result, count);
+		}
+
+		static void decodeSmallestThree32QuaternionNeon(const SmallestThree32Quaternion* packed, Quaternion* result, int count)
+		{
+			_decodeSmallestThreeNeon<10>(packed, result, count);
+		}
+
+		static void encodeSmallestThree48QuaternionNeon(const Quaternion* quaternions, SmallestThree48Quaternion* result, int count)
+		{
+			uint32x4_t v0;
+			uint32x4_t v1;
+			uint32x4_t v2;
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				uint32x4_t index = _encodeSmallestThreeNeon(vld4q_f32(&quaternions[i].x), 16383, v0, v1, v2);
+				uint16x4x3_t values;
+				values.val[0] = vmovn_u32(vorrq_u32(v0, vshlq_n_u32(vandq_u32(index, vdupq_n_u32(1)), 15)));
+				values.val[1] = vmovn_u32(vorrq_u32(v1, vshlq_n_u32(vshrq_n_u32(index, 1), 15)));
+				values.val[2] = vmovn_u32(v2);
+				vst3_u16(&result[i].x, values);
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(quaternions[i]);
+			}
+		}
+
+		static void decodeSmallestThree48QuaternionNeon(const SmallestThree48Quaternion* packed, Quaternion* result, int count)
+		{
+			uint32x4_t lowMask = vdupq_n_u32(0x7FFF);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				uint16x4x3_t values = vld3_u16(&packed[i].x);
+				uint32x4_t x = vmovl_u16(values.val[0]);
+				uint32x4_t y = vmovl_u16(values.val[1]);
+				uint32x4_t index = vorrq_u32(vshrq_n_u32(x, 15), vshlq_n_u32(vshrq_n_u32(y, 15), 1));
+				vst4q_f32(&result[i].x, _decodeSmallestThreeNeon(index, vandq_u32(x, lowMask), vandq_u32(y, lowMask), vmovl_u16(values.val[2]), 16383));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toQuaternion();
+			}
+		}
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+		// the byte shuffles need the table lookup of AArch64, the SSE4.1 versions describe the steps
+		static int encodeDeltaSmallestThree32QuaternionNeon(const SmallestThree32Quaternion* packed, const SmallestThree32Quaternion* baselines, int count, unsigned char* buffer)
+		{
+			static const unsigned int tagFactors[4] = { 1, 4, 16, 64 };
+			uint32x4_t mask = vdupq_n_u32(0x3FF);
+			uint32x4_t factors = vld1q_u32(tagFactors);
+			unsigned char* data = buffer + (count + 3) / 4;
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				uint32x4_t value = vld1q_u32(&packed[i].value);
+				uint32x4_t baseline = vld1q_u32(&baselines[i].value);
+				int32x4_t d0 = vreinterpretq_s32_u32(vsubq_u32(vandq_u32(value, mask), vandq_u32(baseline, mask)));
+				int32x4_t d1 = vreinterpretq_s32_u32(vsubq_u32(vandq_u32(vshrq_n_u32(value, 10), mask), vandq_u32(vshrq_n_u32(baseline, 10), mask)));
+				int32x4_t d2 = vreinterpretq_s32_u32(vsubq_u32(vandq_u32(vshrq_n_u32(value, 20), mask), vandq_u32(vshrq_n_u32(baseline, 20), mask)));
+				uint32x4_t sameIndex = vceqq_u32(vshrq_n_u32(value, 30), vshrq_n_u32(baseline, 30));
+				uint32x4_t small0 = vreinterpretq_u32_s32(vaddq_s32(d0, vdupq_n_s32(16)));
+				uint32x4_t small1 = vreinterpretq_u32_s32(vaddq_s32(d1, vdupq_n_s32(16)));
+				uint32x4_t small2 = vreinterpretq_u32_s32(vaddq_s32(d2, vdupq_n_s32(16)));
+				uint32x4_t medium0 = vreinterpretq_u32_s32(vaddq_s32(d0, vdupq_n_s32(128)));
+				uint32x4_t medium1 = vreinterpretq_u32_s32(vaddq_s32(d1, vdupq_n_s32(128)));
+				uint32x4_t medium2 = vreinterpretq_u32_s32(vaddq_s32(d2, vdupq_n_s32(128)));
+				uint32x4_t isSmall = vandq_u32(sameIndex, vcltq_u32(vorrq_u32(vorrq_u32(small0, small1), small2), vdupq_n_u32(32)));
+				uint32x4_t isMedium = vandq_u32(sameIndex, vcltq_u32(vorrq_u32(vorrq_u32(medium0, medium1), medium2), vdupq_n_u32(256)));
+				uint32x4_t tags = vbicq_u32(vaddq_u32(vaddq_u32(vdupq_n_u32(3), isMedium), isSmall), vceqq_u32(value, baseline));
+				uint32x4_t payload = vbslq_u32(isMedium, vorrq_u32(vorrq_u32(medium0, vshlq_n_u32(medium1, 8)), vshlq_n_u32(medium2, 16)), value);
+				payload = vbslq_u32(isSmall, vorrq_u32(vorrq_u32(small0, vshlq_n_u32(small1, 5)), vshlq_n_u32(small2, 10)), payload);
+				unsigned int bits = vaddvq_u32(vmulq_u32(tags, factors));
+				buffer[i / 4] = (unsigned char)bits;
+				vst1q_u8(data, vqtbl1q_u8(vreinterpretq_u8_u32(payload), vld1q_u8(deltaEncodeShuffles[bits])));
+				data += deltaLengths[bits];
+			}
+			if (i < count)
+			{
+				buffer[i / 4] = (unsigned char)_encodeDeltaGroup(&packed[i], &baselines[i], count - i, data);
+			}
+			return (int)(data - buffer);
+		}
+
+		static int decodeDeltaSmallestThree32QuaternionNeon(const unsigned char* buffer, int size, const SmallestThree32Quaternion* baselines, SmallestThree32Quaternion* result, int count)
+		{
+			int controlSize = (count + 3) / 4;
+			if (size < controlSize)
+			{
+				return -1;
+			}
+			uint32x4_t mask = vdupq_n_u32(0x3FF);
+			uint32x4_t smallMask = vdupq_n_u32(0x1F);
+			uint32x4_t mediumMask = vdupq_n_u32(0xFF);
+			const unsigned char* data = buffer + controlSize;
+			const unsigned char* end = buffer + size;
+			unsigned int tagValues[4];
+			int i = 0;
+			for (; i + 4 <= count && end - data >= 16; i += 4)
+			{
+				unsigned int control = buffer[i / 4];
+				uint32x4_t payload = vreinterpretq_u32_u8(vqtbl1q_u8(vld1q_u8(data), vld1q_u8(deltaDecodeShuffles[control])));
+				tagValues[0] = control & 3;
+				tagValues[1] = (control >> 2) & 3;
+				tagValues[2] = (control >> 4) & 3;
+				tagValues[3] = control >> 6;
+				uint32x4_t tags = vld1q_u32(tagValues);
+				uint32x4_t isSmall = vceqq_u32(tags, vdupq_n_u32(1));
+				uint32x4_t isMedium = vceqq_u32(tags, vdupq_n_u32(2));
+				uint32x4_t baseline = vld1q_u32(&baselines[i].value);
+				uint32x4_t d0 = vorrq_u32(vandq_u32(isSmall, vsubq_u32(vandq_u32(payload, smallMask), vdupq_n_u32(16))),
+					vandq_u32(isMedium, vsubq_u32(vandq_u32(payload, mediumMask), vdupq_n_u32(128))));
+				uint32x4_t d1 = vorrq_u32(vandq_u32(isSmall, vsubq_u32(vandq_u32(vshrq_n_u32(payload, 5), smallMask), vdupq_n_u32(16))),
+					vandq_u32(isMedium, vsubq_u32(vandq_u32(vshrq_n_u32(payload, 8), mediumMask), vdupq_n_u32(128))));
+				uint32x4_t d2 = vorrq_u32(vandq_u32(isSmall, vsubq_u32(vandq_u32(vshrq_n_u32(payload, 10), smallMask), vdupq_n_u32(16))),
+					vandq_u32(isMedium, vsubq_u32(vandq_u32(vshrq_n_u32(payload, 16), mediumMask), vdupq_n_u32(128))));
+				uint32x4_t value = vandq_u32(vaddq_u32(baseline, d0), mask);
+				value = vorrq_u32(value, vshlq_n_u32(vandq_u32(vaddq_u32(vshrq_n_u32(baseline, 10), d1), mask), 10));
+				value = vorrq_u32(value, vshlq_n_u32(vandq_u32(vaddq_u32(vshrq_n_u32(baseline, 20), d2), mask), 20));
+				value = vorrq_u32(value, vandq_u32(baseline, vdupq_n_u32(0xC0000000u)));
+				vst1q_u32(&result[i].value, vbslq_u32(vceqq_u32(tags, vdupq_n_u32(3)), payload, value));
+				data += deltaLengths[control];
+			}
+			for (; i < count && data != NULL; i += 4)
+			{
+				data = _decodeDeltaGroup(buffer[i / 4], data, end, &baselines[i], &result[i], (count - i < 4 ? count - i : 4));
+			}
+			return (data != NULL ? (int)(data - buffer) : -1);
+		}
+#endif
+#endif
+
+		void registerPackedQuaternionKernels(Kernels& kernels, Level level)
+		{
+			switch (level)
+			{
+			case LevelScalar:
+				_buildDeltaTables();
+				kernels.encodeSmallestThree29Quaternion = &encodeSmallestThree29QuaternionScalar;
+				kernels.decodeSmallestThree29Quaternion = &decodeSmallestThree29QuaternionScalar;
+				kernels.encodeSmallestThree32Quaternion = &encodeSmallestThree32QuaternionScalar;
+				kernels.decodeSmallestThree32Quaternion = &decodeSmallestThree32QuaternionScalar;
+				kernels.encodeDeltaSmallestThree32Quaternion = &encodeDeltaSmallestThree32QuaternionScalar;
+				kernels.decodeDeltaSmallestThree32Quaternion = &decodeDeltaSmallestThree32QuaternionScalar;
+				kernels.encodeSmallestThree48Quaternion = &encodeSmallestThree48QuaternionScalar;
+				kernels.decodeSmallestThree48Quaternion = &decodeSmallestThree48QuaternionScalar;
+				break;
+#if defined(GTYPES_SIMD_SSE)
+			case LevelSse2:
+				kernels.encodeSmallestThree29Quaternion = &encodeSmallestThree29QuaternionSse2;
+				kernels.decodeSmallestThree29Quaternion = &decodeSmallestThree29QuaternionSse2;
+				kernels.encodeSmallestThree32Quaternion = &encodeSmallestThree32QuaternionSse2;
+				kernels.decodeSmallestThree32Quaternion = &decodeSmallestThree32QuaternionSse2;
+				kernels.encodeSmallestThree48Quaternion = &encodeSmallestThree48QuaternionSse2;
+				kernels.decodeSmallestThree48Quaternion = &decodeSmallestThree48QuaternionSse2;
+				break;
+			case LevelSse41:
+				kernels.encodeDeltaSmallestThree32Quaternion = &encodeDeltaSmallestThree32QuaternionSse41;
+				kernels.decodeDeltaSmallestThree32Quaternion = &decodeDeltaSmallestThree32QuaternionSse41;
+				break;
+			case LevelAvx2:
+				kernels.encodeSmallestThree29Quaternion = &encodeSmallestThree29QuaternionAvx2;
+				kernels.decodeSmallestThree29Quaternion = &decodeSmallestThree29QuaternionAvx2;
+				kernels.encodeSmallestThree32Quaternion = &encodeSmallestThree32QuaternionAvx2;
+				kernels.decodeSmallestThree32Quaternion = &decodeSmallestThree32QuaternionAvx2;
+				break;
+#endif
+#if defined(GTYPES_SIMD_AVX512)
+			case LevelAvx512:
+				kernels.encodeSmallestThree29Quaternion = &encodeSmallestThree29QuaternionAvx512;
+				kernels.decodeSmallestThree29Quaternion = &decodeSmallestThree29QuaternionAvx512;
+				kernels.encodeSmallestThree32Quaternion = &encodeSmallestThree32QuaternionAvx512;
+				kernels.decodeSmallestThree32Quaternion = &decodeSmallestThree32QuaternionAvx512;
+				break;
+#endif
+#if defined(GTYPES_SIMD_NEON)
+			case LevelNeon:
+				kernels.encodeSmallestThree29Quaternion = &encodeSmallestThree29QuaternionNeon;
+				kernels.decodeSmallestThree29Quaternion = &decodeSmallestThree29QuaternionNeon;
+				kernels.encodeSmallestThree32Quaternion = &encodeSmallestThree32QuaternionNeon;
+				kernels.decodeSmallestThree32Quaternion = &decodeSmallestThree32QuaternionNeon;
+				kernels.encodeSmallestThree48Quaternion = &encodeSmallestThree48QuaternionNeon;
+				kernels.decodeSmallestThree48Quaternion = &decodeSmallestThree48QuaternionNeon;
+#if defined(__aarch64__) || defined(_M_ARM64)
+				kernels.encodeDeltaSmallestThree32Quaternion = &encodeDeltaSmallestThree32QuaternionNeon;
+				kernels.decodeDeltaSmallestThree32Quaternion = &decodeDeltaSmallestThree32QuaternionNeon;
+#endif
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+
+	}
+
+}
@@ -0,0 +1,802 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <math.h>
+
+#include "gtypesSimd.h"
+#include "gtypesSimdKernels.h"
+#include "PackedVector3.h"
+#include "Vector3.h"
+
+namespace gtypes
+{
+	static inline unsigned int _floatBits(float value)
+	{
+		union
+		{
+			float f;
+			unsigned int i;
+		} bits;
+		bits.f = value;
+		return bits.i;
+	}
+
+	static inline float _bitsFloat(unsigned int value)
+	{
+		union
+		{
+			float f;
+			unsigned int i;
+		} bits;
+		bits.i = value;
+		return bits.f;
+	}
+
+	// all quantizers clamp with comparisons that map NaN to the lower bound and round by adding 0.5 with the sign of the
+	// value before truncating, the SIMD kernels use the same steps so every level produces the same bits
+
+	static inline unsigned short _quantizeUnorm16(float value, float minimum, float scale)
+	{
+		float result = (value - minimum) * scale;
+		result = (result > 0.0f ? result : 0.0f);
+		result = (result < 65535.0f ? result : 65535.0f);
+		return (unsigned short)(int)(result + 0.5f);
+	}
+
+	static inline short _quantizeSnorm16(float value)
+	{
+		float result = (value > -1.0f ? value : -1.0f);
+		result = (result < 1.0f ? result : 1.0f) * 32767.0f;
+		return (short)(int)(result + (result >= 0.0f ? 0.5f : -0.5f));
+	}
+
+	static inline unsigned int _quantizeSnorm10(float value)
+	{
+		float result = (value > -1.0f ? value : -1.0f);
+		result = (result < 1.0f ? result : 1.0f) * 511.0f;
+		return ((unsigned int)(int)(result + (result >= 0.0f ? 0.5f : -0.5f)) & 0x3FF);
+	}
+
+	static inline float _dequantizeSnorm10(unsigned int value, int shift)
+	{
+		// moves the 10 bits to the top and shifts them back down arithmetically to extend the sign
+		float result = (float)((int)(value << (22 - shift)) >> 22) * (1.0f / 511.0f);
+		return (result > -1.0f ? result : -1.0f);
+	}
+
+	unsigned short HalfVector3::fromFloat(float value)
+	{
+		unsigned int bits = _floatBits(value);
+		unsigned int sign = bits & 0x80000000u;
+		bits ^= sign;
+		unsigned int result = 0;
+		if (bits >= 0x47800000u) // 65520 and above round to infinity
+		{
+			result = (bits > 0x7F800000u ? 0x7E00 : 0x7C00);
+		}
+		else if (bits < 0x38800000u) // below 2^-14 the half is subnormal
+		{
+			// adding 0.5 aligns the mantissa to the half subnormal bits while the FPU rounds to nearest even
+			result = _floatBits(_bitsFloat(bits) + 0.5f) - 0x3F000000u;
+		}
+		else
+		{
+			// rebiases the exponent, the added 0xFFF plus the lowest kept mantissa bit round to nearest even
+			result = (bits + 0xC8000FFFu + ((bits >> 13) & 1)) >> 13;
+		}
+		return (unsigned short)(result | (sign >> 16));
+	}
+
+	float HalfVector3::toFloat(unsigned short value)
+	{
+		unsigned int bits = ((unsigned int)value & 0x7FFF) << 13;
+		unsigned int exponent = bits & 0x0F800000u;
+		bits += 0x38000000u; // rebias the exponent
+		if (exponent == 0x0F800000u) // infinity or NaN
+		{
+			bits += 0x38000000u;
+		}
+		else if (exponent == 0) // subnormal, renormalized by the FPU
+		{
+			bits = _floatBits(_bitsFloat(bits + 0x00800000u) - 6.103515625e-05f);
+		}
+		return _bitsFloat(bits | (((unsigned int)value & 0x8000) << 16));
+	}
+
+	void Unorm16Vector3::set(const Vector3<float>& vector, const Vector3<float>& minimum, const Vector3<float>& maximum)
+	{
+		this->x = _quantizeUnorm16(vector.x, minimum.x, (maximum.x > minimum.x ? 65535.0f / (maximum.x - minimum.x) : 0.0f));
+		this->y = _quantizeUnorm16(vector.y, minimum.y, (maximum.y > minimum.y ? 65535.0f / (maximum.y - minimum.y) : 0.0f));
+		this->z = _quantizeUnorm16(vector.z, minimum.z, (maximum.z > minimum.z ? 65535.0f / (maximum.z - minimum.z) : 0.0f));
+	}
+
+	Vector3<float> Unorm16Vector3::toVector3(const Vector3<float>& minimum, const Vector3<float>& maximum) const
+	{
+		return Vector3<float>(minimum.x + this->x * ((maximum.x - minimum.x) / 65535.0f), minimum.y + this->y * ((maximum.y - minimum.y) / 65535.0f),
+			minimum.z + this->z * ((maximum.z - minimum.z) / 65535.0f));
+	}
+
+	void OctahedralVector3::set(const Vector3<float>& vector)
+	{
+		float length = fabsf(vector.x) + fabsf(vector.y) + fabsf(vector.z);
+		float inverse = (length > 0.0f ? 1.0f / length : 0.0f);
+		float x = vector.x * inverse;
+		float y = vector.y * inverse;
+		// the lower hemisphere is folded over the diagonals of the square
+		if (vector.z < 0.0f)
+		{
+			float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			y = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = foldedX;
+		}
+		this->x = _quantizeSnorm16(x);
+		this->y = _quantizeSnorm16(y);
+	}
+
+	Vector3<float> OctahedralVector3::toVector3() const
+	{
+		float x = this->x * (1.0f / 32767.0f);
+		float y = this->y * (1.0f / 32767.0f);
+		float z = 1.0f - fabsf(x) - fabsf(y);
+		float fold = (-z > 0.0f ? -z : 0.0f);
+		x += (x >= 0.0f ? -fold : fold);
+		y += (y >= 0.0f ? -fold : fold);
+		float inverse = 1.0f / sqrtf(x * x + y * y + z * z);
+		return Vector3<float>(x * inverse, y * inverse, z * inverse);
+	}
+
+	void Snorm10Vector3::set(const Vector3<float>& vector, int w)
+	{
+		this->value = _quantizeSnorm10(vector.x) | (_quantizeSnorm10(vector.y) << 10) | (_quantizeSnorm10(vector.z) << 20) | ((unsigned int)w << 30);
+	}
+
+	Vector3<float> Snorm10Vector3::toVector3() const
+	{
+		return Vector3<float>(_dequantizeSnorm10(this->value, 0), _dequantizeSnorm10(this->value, 10), _dequantizeSnorm10(this->value, 20));
+	}
+
+	namespace simd
+	{
+		static void encodeHalfVector3Scalar(const Vector3<float>* vectors, HalfVector3* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i].set(vectors[i]);
+			}
+		}
+
+		static void decodeHalfVector3Scalar(const HalfVector3* packed, Vector3<float>* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3();
+			}
+		}
+
+		static void encodeUnorm16Vector3Scalar(const Vector3<float>* vectors, Unorm16Vector3* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i].set(vectors[i], minimum, maximum);
+			}
+		}
+
+		static void decodeUnorm16Vector3Scalar(const Unorm16Vector3* packed, Vector3<float>* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3(minimum, maximum);
+			}
+		}
+
+		static void encodeOctahedralVector3Scalar(const Vector3<float>* vectors, OctahedralVector3* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i].set(vectors[i]);
+			}
+		}
+
+		static void decodeOctahedralVector3Scalar(const OctahedralVector3* packed, Vector3<float>* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3();
+			}
+		}
+
+		static void encodeSnorm10Vector3Scalar(const Vector3<float>* vectors, Snorm10Vector3* result, int count, int w)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i].set(vectors[i], w);
+			}
+		}
+
+		static void decodeSnorm10Vector3Scalar(const Snorm10Vector3* packed, Vector3<float>* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3();
+			}
+		}
+
+#if defined(GTYPES_SIMD_SSE)
+		// HalfVector3::fromFloat() for 4 floats, the halves are returned sign-extended so _mm_packs_epi32() keeps their bits
+		static inline __m128i _floatToHalfSse2(__m128 value)
+		{
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			__m128 sign = _mm_and_ps(value, signMask);
+			__m128 absolute = _mm_xor_ps(value, sign);
+			__m128i bits = _mm_castps_si128(absolute);
+			__m128i special = _mm_or_si128(_mm_and_si128(_mm_castps_si128(_mm_cmpunord_ps(absolute, absolute)), _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+			__m128i regular = _mm_cmpgt_epi32(_mm_set1_epi32(0x47800000), bits);
+			__m128i subnormalMask = _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), bits);
+			__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3F000000));
+			__m128i odd = _mm_srai_epi32(_mm_slli_epi32(bits, 18), 31);
+			__m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, _mm_set1_epi32((int)0xC8000FFFu)), odd), 13);
+			__m128i result = _mm_or_si128(_mm_and_si128(subnormalMask, subnormal), _mm_andnot_si128(subnormalMask, normal));
+			result = _mm_or_si128(_mm_and_si128(regular, result), _mm_andnot_si128(regular, special));
+			return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+		}
+
+		// HalfVector3::toFloat() for 4 zero-extended halves
+		static inline __m128 _halfToFloatSse2(__m128i value)
+		{
+			__m128i exponentMantissa = _mm_and_si128(value, _mm_set1_epi32(0x7FFF));
+			__m128i sign = _mm_slli_epi32(_mm_xor_si128(value, exponentMantissa), 16);
+			// the multiplication rebiases the exponent and renormalizes subnormals
+			__m128 result = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), _mm_castsi128_ps(_mm_set1_epi32(0x77800000)));
+			__m128i infinity = _mm_and_si128(_mm_cmpgt_epi32(exponentMantissa, _mm_set1_epi32(0x7BFF)), _mm_set1_epi32(0x7F800000));
+			return _mm_or_ps(result, _mm_castsi128_ps(_mm_or_si128(sign, infinity)));
+		}
+
+		static void encodeHalfVector3Sse2(const Vector3<float>* vectors, HalfVector3* result, int count)
+		{
+			// the components are converted as one continuous stream of floats
+			const float* input = &vectors[0].x;
+			unsigned short* output = &result[0].x;
+			int size = count * 3;
+			int i = 0;
+			for (; i + 8 <= size; i += 8)
+			{
+				__m128i low = _floatToHalfSse2(_mm_loadu_ps(input + i));
+				__m128i high = _floatToHalfSse2(_mm_loadu_ps(input + i + 4));
+				_mm_storeu_si128((__m128i*)(output + i), _mm_packs_epi32(low, high));
+			}
+			for (; i < size; ++i)
+			{
+				output[i] = HalfVector3::fromFloat(input[i]);
+			}
+		}
+
+		static void decodeHalfVector3Sse2(const HalfVector3* packed, Vector3<float>* result, int count)
+		{
+			const unsigned short* input = &packed[0].x;
+			float* output = &result[0].x;
+			int size = count * 3;
+			int i = 0;
+			for (; i + 8 <= size; i += 8)
+			{
+				__m128i halves = _mm_loadu_si128((const __m128i*)(input + i));
+				_mm_storeu_ps(output + i, _halfToFloatSse2(_mm_unpacklo_epi16(halves, _mm_setzero_si128())));
+				_mm_storeu_ps(output + i + 4, _halfToFloatSse2(_mm_unpackhi_epi16(halves, _mm_setzero_si128())));
+			}
+			for (; i < size; ++i)
+			{
+				output[i] = HalfVector3::toFloat(input[i]);
+			}
+		}
+
+		// _quantizeUnorm16() for 4 floats
+		static inline __m128i _quantizeUnorm16Sse2(__m128 value, __m128 minimum, __m128 scale)
+		{
+			__m128 result = _mm_mul_ps(_mm_sub_ps(value, minimum), scale);
+			result = _mm_min_ps(_mm_max_ps(result, _mm_setzero_ps()), _mm_set1_ps(65535.0f));
+			return _mm_cvttps_epi32(_mm_add_ps(result, _mm_set1_ps(0.5f)));
+		}
+
+		// packs 8 ints from 0 to 65535, SSE2 only has the signed saturating pack so the range is shifted around it
+		static inline __m128i _packUnsigned16Sse2(__m128i low, __m128i high)
+		{
+			__m128i offset = _mm_set1_epi32(32768);
+			return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(low, offset), _mm_sub_epi32(high, offset)), _mm_set1_epi16((short)0x8000));
+		}
+
+		static void encodeUnorm16Vector3Sse2(const Vector3<float>* vectors, Unorm16Vector3* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			Vector3<float> scale((maximum.x > minimum.x ? 65535.0f / (maximum.x - minimum.x) : 0.0f), (maximum.y > minimum.y ? 65535.0f / (maximum.y - minimum.y) : 0.0f),
+				(maximum.z > minimum.z ? 65535.0f / (maximum.z - minimum.z) : 0.0f));
+			// 4 Vector3s at once as a stream of 12 floats, the bounds repeat every 3 registers
+			__m128 minimum0 = _mm_setr_ps(minimum.x, minimum.y, minimum.z, minimum.x);
+			__m128 minimum1 = _mm_setr_ps(minimum.y, minimum.z, minimum.x, minimum.y);
+			__m128 minimum2 = _mm_setr_ps(minimum.z, minimum.x, minimum.y, minimum.z);
+			__m128 scale0 = _mm_setr_ps(scale.x, scale.y, scale.z, scale.x);
+			__m128 scale1 = _mm_setr_ps(scale.y, scale.z, scale.x, scale.y);
+			__m128 scale2 = _mm_setr_ps(scale.z, scale.x, scale.y, scale.z);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const float* input = &vectors[i].x;
+				unsigned short* output = &result[i].x;
+				__m128i values0 = _quantizeUnorm16Sse2(_mm_loadu_ps(input), minimum0, scale0);
+				__m128i values1 = _quantizeUnorm16Sse2(_mm_loadu_ps(input + 4), minimum1, scale1);
+				__m128i values2 = _quantizeUnorm16Sse2(_mm_loadu_ps(input + 8), minimum2, scale2);
+				_mm_storeu_si128((__m128i*)output, _packUnsigned16Sse2(values0, values1));
+				_mm_storel_epi64((__m128i*)(output + 8), _packUnsigned16Sse2(values2, values2));
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(vectors[i], minimum, maximum);
+			}
+		}
+
+		static void decodeUnorm16Vector3Sse2(const Unorm16Vector3* packed, Vector3<float>* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			Vector3<float> step((maximum.x - minimum.x) / 65535.0f, (maximum.y - minimum.y) / 65535.0f, (maximum.z - minimum.z) / 65535.0f);
+			__m128 minimum0 = _mm_setr_ps(minimum.x, minimum.y, minimum.z, minimum.x);
+			__m128 minimum1 = _mm_setr_ps(minimum.y, minimum.z, minimum.x, minimum.y);
+			__m128 minimum2 = _mm_setr_ps(minimum.z, minimum.x, minimum.y, minimum.z);
+			__m128 step0 = _mm_setr_ps(step.x, step.y, step.z, step.x);
+			__m128 step1 = _mm_setr_ps(step.y, step.z, step.x, step.y);
+			__m128 step2 = _mm_setr_ps(step.z, step.x, step.y, step.z);
+			__m128i zero = _mm_setzero_si128();
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const unsigned short* input = &packed[i].x;
+				float* output = &result[i].x;
+				__m128i values = _mm_loadu_si128((const __m128i*)input);
+				__m128i values2 = _mm_loadl_epi64((const __m128i*)(input + 8));
+				_mm_storeu_ps(output, _mm_add_ps(minimum0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(values, zero)), step0)));
+				_mm_storeu_ps(output + 4, _mm_add_ps(minimum1, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(values, zero)), step1)));
+				_mm_storeu_ps(output + 8, _mm_add_ps(minimum2, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(values2, zero)), step2)));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3(minimum, maximum);
+			}
+		}
+
+		// _quantizeSnorm16() and _quantizeSnorm10() for 4 floats
+		static inline __m128i _quantizeSnormSse2(__m128 value, float factor)
+		{
+			__m128 result = _mm_mul_ps(_mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f)), _mm_set1_ps(factor));
+			__m128 half = _mm_or_ps(_mm_and_ps(result, _mm_set1_ps(-0.0f)), _mm_set1_ps(0.5f));
+			return _mm_cvttps_epi32(_mm_add_ps(result, half));
+		}
+
+		// selects a where mask is set, b otherwise
+		static inline __m128 _selectSse2(__m128 mask, __m128 a, __m128 b)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		static void encodeOctahedralVector3Sse2(const Vector3<float>* vectors, OctahedralVector3* result, int count)
+		{
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			__m128 zero = _mm_setzero_ps();
+			__m128 one = _mm_set1_ps(1.0f);
+			__m128 x;
+			__m128 y;
+			__m128 z;
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				load3(&vectors[i].x, x, y, z);
+				__m128 absX = _mm_andnot_ps(signMask, x);
+				__m128 absY = _mm_andnot_ps(signMask, y);
+				__m128 length = _mm_add_ps(_mm_add_ps(absX, absY), _mm_andnot_ps(signMask, z));
+				__m128 inverse = _mm_and_ps(_mm_div_ps(one, length), _mm_cmpgt_ps(length, zero));
+				x = _mm_mul_ps(x, inverse);
+				y = _mm_mul_ps(y, inverse);
+				absX = _mm_mul_ps(absX, inverse);
+				absY = _mm_mul_ps(absY, inverse);
+				__m128 foldedX = _mm_mul_ps(_mm_sub_ps(one, absY), _selectSse2(_mm_cmpge_ps(x, zero), one, _mm_set1_ps(-1.0f)));
+				__m128 foldedY = _mm_mul_ps(_mm_sub_ps(one, absX), _selectSse2(_mm_cmpge_ps(y, zero), one, _mm_set1_ps(-1.0f)));
+				__m128 lower = _mm_cmplt_ps(z, zero);
+				__m128i quantizedX = _quantizeSnormSse2(_selectSse2(lower, foldedX, x), 32767.0f);
+				__m128i quantizedY = _quantizeSnormSse2(_selectSse2(lower, foldedY, y), 32767.0f);
+				_mm_storeu_si128((__m128i*)&result[i].x, _mm_packs_epi32(_mm_unpacklo_epi32(quantizedX, quantizedY), _mm_unpackhi_epi32(quantizedX, quantizedY)));
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(vectors[i]);
+			}
+		}
+
+		static void decodeOctahedralVector3Sse2(const OctahedralVector3* packed, Vector3<float>* result, int count)
+		{
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			__m128 zero = _mm_setzero_ps();
+			__m128 scale = _mm_set1_ps(1.0f / 32767.0f);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i values = _mm_loadu_si128((const __m128i*)&packed[i].x);
+				// sign-extends the 16-bit values, the results are x0 y0 x1 y1 and x2 y2 x3 y3
+				__m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16));
+				__m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16));
+				__m128 x = _mm_mul_ps(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)), scale);
+				__m128 y = _mm_mul_ps(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)), scale);
+				__m128 z = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_andnot_ps(signMask, x)), _mm_andnot_ps(signMask, y));
+				__m128 fold = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+				x = _mm_add_ps(x, _selectSse2(_mm_cmpge_ps(x, zero), _mm_sub_ps(zero, fold), fold));
+				y = _mm_add_ps(y, _selectSse2(_mm_cmpge_ps(y, zero), _mm_sub_ps(zero, fold), fold));
+				__m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z))));
+				store3(&result[i].x, _mm_mul_ps(x, inverse), _mm_mul_ps(y, inverse), _mm_mul_ps(z, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3();
+			}
+		}
+
+		static void encodeSnorm10Vector3Sse2(const Vector3<float>* vectors, Snorm10Vector3* result, int count, int w)
+		{
+			__m128i mask = _mm_set1_epi32(0x3FF);
+			__m128i top = _mm_set1_epi32((int)((unsigned int)w << 30));
+			__m128 x;
+			__m128 y;
+			__m128 z;
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				load3(&vectors[i].x, x, y, z);
+				__m128i values = _mm_or_si128(_mm_and_si128(_quantizeSnormSse2(x, 511.0f), mask), top);
+				values = _mm_or_si128(values, _mm_slli_epi32(_mm_and_si128(_quantizeSnormSse2(y, 511.0f), mask), 10));
+				values = _mm_or_si128(values, _mm_slli_epi32(_mm_and_si128(_quantizeSnormSse2(z, 511.0f), mask), 20));
+				_mm_storeu_si128((__m128i*)&result[i].value, values);
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(vectors[i], w);
+			}
+		}
+
+		static void decodeSnorm10Vector3Sse2(const Snorm10Vector3* packed, Vector3<float>* result, int count)
+		{
+			__m128 scale = _mm_set1_ps(1.0f / 511.0f);
+			__m128 minimum = _mm_set1_ps(-1.0f);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i values = _mm_loadu_si128((const __m128i*)&packed[i].value);
+				__m128 x = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(values, 22), 22)), scale), minimum);
+				__m128 y = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(values, 12), 22)), scale), minimum);
+				__m128 z = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(values, 2), 22)), scale), minimum);
+				store3(&result[i].x, x, y, z);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3();
+			}
+		}
+
+		// F16C keeps the top bits of a NaN payload, this replaces every NaN with the quiet NaN HalfVector3::fromFloat() returns
+		GTYPES_TARGET_AVX2 static inline __m128i _canonicalizeNanF16c(__m128i halves)
+		{
+			__m128i nan = _mm_cmpgt_epi16(_mm_and_si128(halves, _mm_set1_epi16(0x7FFF)), _mm_set1_epi16(0x7C00));
+			__m128i canonical = _mm_or_si128(_mm_and_si128(halves, _mm_set1_epi16((short)0x8000)), _mm_set1_epi16(0x7E00));
+			return _mm_or_si128(_mm_andnot_si128(nan, halves), _mm_and_si128(nan, canonical));
+		}
+
+		GTYPES_TARGET_AVX2 static void encodeHalfVector3Avx2(const Vector3<float>* vectors, HalfVector3* result, int count)
+		{
+			const float* input = &vectors[0].x;
+			unsigned short* output = &result[0].x;
+			int size = count * 3;
+			int i = 0;
+			// F16C converts 8 floats at once with round to nearest even
+			for (; i + 8 <= size; i += 8)
+			{
+				_mm_storeu_si128((__m128i*)(output + i), _canonicalizeNanF16c(_mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT)));
+			}
+			for (; i < size; ++i)
+			{
+				output[i] = HalfVector3::fromFloat(input[i]);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void decodeHalfVector3Avx2(const HalfVector3* packed, Vector3<float>* result, int count)
+		{
+			const unsigned short* input = &packed[0].x;
+			float* output = &result[0].x;
+			int size = count * 3;
+			int i = 0;
+			for (; i + 8 <= size; i += 8)
+			{
+				_mm256_storeu_ps(output + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(input + i))));
+			}
+			for (; i < size; ++i)
+			{
+				output[i] = HalfVector3::toFloat(input[i]);
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_AVX512)
+		GTYPES_TARGET_AVX512 static void encodeHalfVector3Avx512(const Vector3<float>* vectors, HalfVector3* result, int count)
+		{
+			const float* input = &vectors[0].x;
+			unsigned short* output = &result[0].x;
+			int size = count * 3;
+			int i = 0;
+			for (; i + 16 <= size; i += 16)
+			{
+				__m256i halves = _mm512_cvtps_ph(_mm512_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT);
+				// same as _canonicalizeNanF16c() on 16 halves
+				__m256i nan = _mm256_cmpgt_epi16(_mm256_and_si256(halves, _mm256_set1_epi16(0x7FFF)), _mm256_set1_epi16(0x7C00));
+				__m256i canonical = _mm256_or_si256(_mm256_and_si256(halves, _mm256_set1_epi16((short)0x8000)), _mm256_set1_epi16(0x7E00));
+				_mm256_storeu_si256((__m256i*)(output + i), _mm256_or_si256(_mm256_andnot_si256(nan, halves), _mm256_and_si256(nan, canonical)));
+			}
+			for (; i < size; ++i)
+			{
+				output[i] = HalfVector3::fromFloat(input[i]);
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void decodeHalfVector3Avx512(const HalfVector3* packed, Vector3<float>* result, int count)
+		{
+			const unsigned short* input = &packed[0].x;
+			float* output = &result[0].x;
+			int size = count * 3;
+			int i = 0;
+			for (; i + 16 <= size; i += 16)
+			{
+				_mm512_storeu_ps(output + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(input + i))));
+			}
+			for (; i < size; ++i)
+			{
+				output[i] = HalfVector3::toFloat(input[i]);
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_NEON)
+#if defined(__aarch64__) || defined(_M_ARM64)
+		// ARMv7 only has the half conversions with the optional FP16 extension so they are limited to ARM64
+		static void encodeHalfVector3Neon(const Vector3<float>* vectors, HalfVector3* result, int count)
+		{
+			const float* input = &vectors[0].x;
+			unsigned short* output = &result[0].x;
+			int size = count * 3;
+			int i = 0;
+			for (; i + 4 <= size; i += 4)
+			{
+				vst1_u16(output + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(input + i))));
+			}
+			for (; i < size; ++i)
+			{
+				output[i] = HalfVector3::fromFloat(input[i]);
+			}
+		}
+
+		static void decodeHalfVector3Neon(const HalfVector3* packed, Vector3<float>* result, int count)
+		{
+			const unsigned short* input = &packed[0].x;
+			float* output = &result[0].x;
+			int size = count * 3;
+			int i = 0;
+			for (; i + 4 <= size; i += 4)
+			{
+				vst1q_f32(output + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(input + i))));
+			}
+			for (; i < size; ++i)
+			{
+				output[i] = HalfVector3::toFloat(input[i]);
+			}
+		}
+#endif
+
+		// _quantizeUnorm16() for 4 floats
+		static inline uint16x4_t _quantizeUnorm16Neon(float32x4_t value, float minimum, float scale)
+		{
+			float32x4_t result = vmulq_n_f32(vsubq_f32(value, vdupq_n_f32(minimum)), scale);
+			result = vminq_f32(vmaxq_f32(result, vdupq_n_f32(0.0f)), vdupq_n_f32(65535.0f));
+			return vmovn_u32(vcvtq_u32_f32(vaddq_f32(result, vdupq_n_f32(0.5f))));
+		}
+
+		static void encodeUnorm16Vector3Neon(const Vector3<float>* vectors, Unorm16Vector3* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			Vector3<float> scale((maximum.x > minimum.x ? 65535.0f / (maximum.x - minimum.x) : 0.0f), (maximum.y > minimum.y ? 65535.0f / (maximum.y - minimum.y) : 0.0f),
+				(maximum.z > minimum.z ? 65535.0f / (maximum.z - minimum.z) : 0.0f));
+			int i = 0;
+			// the structure loads and stores deinterleave and interleave the components
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x3_t v = vld3q_f32(&vectors[i].x);
+				uint16x4x3_t values;
+				values.val[0] = _quantizeUnorm16Neon(v.val[0], minimum.x, scale.x);
+				values.val[1] = _quantizeUnorm16Neon(v.val[1], minimum.y, scale.y);
+				values.val[2] = _quantizeUnorm16Neon(v.val[2], minimum.z, scale.z);
+				vst3_u16(&result[i].x, values);
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(vectors[i], minimum, maximum);
+			}
+		}
+
+		static void decodeUnorm16Vector3Neon(const Unorm16Vector3* packed, Vector3<float>* result, int count, const Vector3<float>& minimum, const Vector3<float>& maximum)
+		{
+			Vector3<float> step((maximum.x - minimum.x) / 65535.0f, (maximum.y - minimum.y) / 65535.0f, (maximum.z - minimum.z) / 65535.0f);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				uint16x4x3_t values = vld3_u16(&packed[i].x);
+				float32x4x3_t v;
+				v.val[0] = vmlaq_n_f32(vdupq_n_f32(minimum.x), vcvtq_f32_u32(vmovl_u16(values.val[0])), step.x);
+				v.val[1] = vmlaq_n_f32(vdupq_n_f32(minimum.y), vcvtq_f32_u32(vmovl_u16(values.val[1])), step.y);
+				v.val[2] = vmlaq_n_f32(vdupq_n_f32(minimum.z), vcvtq_f32_u32(vmovl_u16(values.val[2])), step.z);
+				vst3q_f32(&result[i].x, v);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3(minimum, maximum);
+			}
+		}
+
+		// _quantizeSnorm16() and _quantizeSnorm10() for 4 floats
+		static inline int32x4_t _quantizeSnormNeon(float32x4_t value, float factor)
+		{
+			float32x4_t result = vmulq_n_f32(vminq_f32(vmaxq_f32(value, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f)), factor);
+			float32x4_t half = vbslq_f32(vdupq_n_u32(0x80000000u), result, vdupq_n_f32(0.5f));
+			return vcvtq_s32_f32(vaddq_f32(result, half));
+		}
+
+		static void encodeOctahedralVector3Neon(const Vector3<float>* vectors, OctahedralVector3* result, int count)
+		{
+			float32x4_t zero = vdupq_n_f32(0.0f);
+			float32x4_t one = vdupq_n_f32(1.0f);
+			float32x4_t minusOne = vdupq_n_f32(-1.0f);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x3_t v = vld3q_f32(&vectors[i].x);
+				float32x4_t length = vaddq_f32(vaddq_f32(vabsq_f32(v.val[0]), vabsq_f32(v.val[1])), vabsq_f32(v.val[2]));
+				float32x4_t inverse = vbslq_f32(vcgtq_f32(length, zero), vdivq_f32(one, length), zero);
+				float32x4_t x = vmulq_f32(v.val[0], inverse);
+				float32x4_t y = vmulq_f32(v.val[1], inverse);
+				float32x4_t foldedX = vmulq_f32(vsubq_f32(one, vabsq_f32(y)), vbslq_f32(vcgeq_f32(x, zero), one, minusOne));
+				float32x4_t foldedY = vmulq_f32(vsubq_f32(one, vabsq_f32(x)), vbslq_f32(vcgeq_f32(y, zero), one, minusOne));
+				uint32x4_t lower = vcltq_f32(v.val[2], zero);
+				int16x4x2_t values;
+				values.val[0] = vmovn_s32(_quantizeSnormNeon(vbslq_f32(lower, foldedX, x), 32767.0f));
+				values.val[1] = vmovn_s32(_quantizeSnormNeon(vbslq_f32(lower, foldedY, y), 32767.0f));
+				vst2_s16(&result[i].x, values);
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(vectors[i]);
+			}
+		}
+
+		static void decodeOctahedralVector3Neon(const OctahedralVector3* packed, Vector3<float>* result, int count)
+		{
+			float32x4_t zero = vdupq_n_f32(0.0f);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				int16x4x2_t values = vld2_s16(&packed[i].x);
+				float32x4_t x = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(values.val[0])), 1.0f / 32767.0f);
+				float32x4_t y = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(values.val[1])), 1.0f / 32767.0f);
+				float32x4_t z = vsubq_f32(vsubq_f32(vdupq_n_f32(1.0f), vabsq_f32(x)), vabsq_f32(y));
+				float32x4_t fold = vmaxq_f32(vnegq_f32(z), zero);
+				x = vaddq_f32(x, vbslq_f32(vcgeq_f32(x, zero), vnegq_f32(fold), fold));
+				y = vaddq_f32(y, vbslq_f32(vcgeq_f32(y, zero), vnegq_f32(fold), fold));
+				float32x4_t inverse = vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(x, x), y, y), z, z)));
+				float32x4x3_t v;
+				v.val[0] = vmulq_f32(x, inverse);
+				v.val[1] = vmulq_f32(y, inverse);
+				v.val[2] = vmulq_f32(z, inverse);
+				vst3q_f32(&result[i].x, v);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3();
+			}
+		}
+
+		static void encodeSnorm10Vector3Neon(const Vector3<float>* vectors, Snorm10Vector3* result, int count, int w)
+		{
+			int32x4_t mask = vdupq_n_s32(0x3FF);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x3_t v = vld3q_f32(&vectors[i].x);
+				uint32x4_t values = vdupq_n_u32((unsigned int)w << 30);
+				values = vorrq_u32(values, vreinterpretq_u32_s32(vandq_s32(_quantizeSnormNeon(v.val[0], 511.0f), mask)));
+				values = vorrq_u32(values, vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(_quantizeSnormNeon(v.val[1], 511.0f), mask)), 10));
+				values = vorrq_u32(values, vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(_quantizeSnormNeon(v.val[2], 511.0f), mask)), 20));
+				vst1q_u32(&result[i].value, values);
+			}
+			for (; i < count; ++i)
+			{
+				result[i].set(vectors[i], w);
+			}
+		}
+
+		static void decodeSnorm10Vector3Neon(const Snorm10Vector3* packed, Vector3<float>* result, int count)
+		{
+			float32x4_t minimum = vdupq_n_f32(-1.0f);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				int32x4_t values = vreinterpretq_s32_u32(vld1q_u32(&packed[i].value));
+				float32x4x3_t v;
+				v.val[0] = vmaxq_f32(vmulq_n_f32(vcvtq_f32_s32(vshrq_n_s32(vshlq_n_s32(values, 22), 22)), 1.0f / 511.0f), minimum);
+				v.val[1] = vmaxq_f32(vmulq_n_f32(vcvtq_f32_s32(vshrq_n_s32(vshlq_n_s32(values, 12), 22)), 1.0f / 511.0f), minimum);
+				v.val[2] = vmaxq_f32(vmulq_n_f32(vcvtq_f32_s32(vshrq_n_s32(vshlq_n_s32(values, 2), 22)), 1.0f / 511.0f), minimum);
+				vst3q_f32(&result[i].x, v);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = packed[i].toVector3();
+			}
+		}
+#endif
+
+		void registerPackedVector3Kernels(Kernels& kernels, Level level)
+		{
+			switch (level)
+			{
+			case LevelScalar:
+				kernels.encodeHalfVector3 = &encodeHalfVector3Scalar;
+				kernels.decodeHalfVector3 = &decodeHalfVector3Scalar;
+				kernels.encodeUnorm16Vector3 = &encodeUnorm16Vector3Scalar;
+				kernels.decodeUnorm16Vector3 = &decodeUnorm16Vector3Scalar;
+				kernels.encodeOctahedralVector3 = &encodeOctahedralVector3Scalar;
+				kernels.decodeOctahedralVector3 = &decodeOctahedralVector3Scalar;
+				kernels.encodeSnorm10Vector3 = &encodeSnorm10Vector3Scalar;
+				kernels.decodeSnorm10Vector3 = &decodeSnorm10Vector3Scalar;
+				break;
+#if defined(GTYPES_SIMD_SSE)
+			case LevelSse2:
+				kernels.encodeHalfVector3 = &encodeHalfVector3Sse2;
+				kernels.decodeHalfVector3 = &decodeHalfVector3Sse2;
+				kernels.encodeUnorm16Vector3 = &encodeUnorm16Vector3Sse2;
+				kernels.decodeUnorm16Vector3 = &decodeUnorm16Vector3Sse2;
+				kernels.encodeOctahedralVector3 = &encodeOctahedralVector3Sse2;
+				kernels.decodeOctahedralVector3 = &decodeOctahedralVector3Sse2;
+				kernels.encodeSnorm10Vector3 = &encodeSnorm10Vector3Sse2;
+				kernels.decodeSnorm10Vector3 = &decodeSnorm10Vector3Sse2;
+				break;
+			case LevelAvx2:
+				kernels.encodeHalfVector3 = &encodeHalfVector3Avx2;
+				kernels.decodeHalfVector3 = &decodeHalfVector3Avx2;
+				break;
+#endif
+#if defined(GTYPES_SIMD_AVX512)
+			case LevelAvx512:
+				kernels.encodeHalfVector3 = &encodeHalfVector3Avx512;
+				kernels.decodeHalfVector3 = &decodeHalfVector3Avx512;
+				break;
+#endif
+#if defined(GTYPES_SIMD_NEON)
+			case LevelNeon:
+#if defined(__aarch64__) || defined(_M_ARM64)
+				kernels.encodeHalfVector3 = &encodeHalfVector3Neon;
+				kernels.decodeHalfVector3 = &decodeHalfVector3Neon;
+#endif
+				kernels.encodeUnorm16Vector3 = &encodeUnorm16Vector3Neon;
+				kernels.decodeUnorm16Vector3 = &decodeUnorm16Vector3Neon;
+				kernels.encodeOctahedralVector3 = &encodeOctahedralVector3Neon;
+				kernels.decodeOctahedralVector3 = &decodeOctahedralVector3Neon;
+				kernels.encodeSnorm10Vector3 = &encodeSnorm10Vector3Neon;
+				kernels.decodeSnorm10Vector3 = &decodeSnorm10Vector3Neon;
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+
+	}
+
+}
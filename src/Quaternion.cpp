@@ -8,15 +8,106 @@
 
 #include <math.h>
 
+#include "gtypesSimd.h"
+#include "gtypesSimdKernels.h"
 #include "Matrix4.h"
 #include "Quaternion.h"
 #include "Vector3.h"
 
+#define SLERP_TERMS 12
+#define EULER_GIMBAL_LOCK 0.99999f
+
 namespace gtypes
 {
+	// coefficients of the series sin(t * theta) / sin(theta) = t * (1 + b1 * (1 + b2 * (1 + ...))) with
+	// b_i = (u_i * t^2 - v_i) * (cos(theta) - 1), u_i = 1 / (i * (2i + 1)) and v_i = i / (2i + 1), the last term is scaled
+	// by 1.8938 to compensate for the truncated terms (D. Eberly, "A Fast and Accurate Algorithm for Computing SLERP")
+	static const float slerpU[SLERP_TERMS] = { 0.333333333f, 0.1f, 0.0476190476f, 0.0277777778f, 0.0181818182f, 0.0128205128f,
+		0.00952380952f, 0.00735294118f, 0.00584795322f, 0.00476190476f, 0.00395256917f, 0.00631266667f };
+	static const float slerpV[SLERP_TERMS] = { 0.333333333f, 0.4f, 0.428571429f, 0.444444444f, 0.454545455f, 0.461538462f,
+		0.466666667f, 0.470588235f, 0.473684211f, 0.476190476f, 0.47826087f, 0.909024f };
+
+	// evaluates the nested series in 3 groups of 4 terms, each group is linear in the value of the groups after it
+	// (1 + b0 * (1 + b1 * (1 + b2 * (1 + b3 * tail))) = s + b0 * b1 * b2 * b3 * tail) so the groups don't wait for each other
+	static inline float _slerpSeries(float squaredFactor, float x)
+	{
+		float b[SLERP_TERMS];
+		for (int i = 0; i < SLERP_TERMS; ++i)
+		{
+			b[i] = (slerpU[i] * squaredFactor - slerpV[i]) * x;
+		}
+		float s0 = 1.0f + b[0] * (1.0f + b[1] * (1.0f + b[2]));
+		float s1 = 1.0f + b[4] * (1.0f + b[5] * (1.0f + b[6]));
+		float s2 = 1.0f + b[8] * (1.0f + b[9] * (1.0f + b[10] * (1.0f + b[11])));
+		return (s0 + (b[0] * b[1]) * (b[2] * b[3]) * (s1 + (b[4] * b[5]) * (b[6] * b[7]) * s2));
+	}
+
+	// slerp along the arc from a to b without moving b into the hemisphere of a, the outer interpolation of squad() needs
+	// this because the dot-product of its moving ends can change its sign within a segment
+	static inline Quaternion _slerpArc(const Quaternion& a, const Quaternion& b, float factor)
+	{
+		float cosTheta = a.dot(b);
+		cosTheta = (cosTheta < 1.0f ? (cosTheta > -1.0f ? cosTheta : -1.0f) : 1.0f);
+		if (cosTheta > 0.9999f)
+		{
+			return (a * (1.0f - factor) + b * factor).normalized();
+		}
+		// opposite ends are the same rotation but have no unique arc between them
+		if (cosTheta < -0.9999f)
+		{
+			return (factor < 0.5f ? a : b);
+		}
+		float theta = acosf(cosTheta);
+		float inverseSinTheta = 1.0f / sinf(theta);
+		return (a * (sinf((1.0f - factor) * theta) * inverseSinTheta) + b * (sinf(factor * theta) * inverseSinTheta));
+	}
+
+	// Shepperd's method on the elements m[row * size + column] in the layout of mat3(), 4 times the largest component comes
+	// from the diagonal and 4 times the others from sums and differences of mirrored elements, the normalization replaces
+	// the division by the largest component
+	static inline Quaternion _fromMatrix(const float* m, int size)
+	{
+		const float* m1 = m + size;
+		const float* m2 = m + size * 2;
+		float tw = (1.0f + m[0]) + (m1[1] + m2[2]);
+		float tx = (1.0f + m[0]) - (m1[1] + m2[2]);
+		float ty = (1.0f + m1[1]) - (m[0] + m2[2]);
+		float tz = (1.0f + m2[2]) - (m[0] + m1[1]);
+		Quaternion result(m[2] + m2[0], m1[2] + m2[1], tz, m1[0] - m[1]);
+		if (tw >= tx && tw >= ty && tw >= tz)
+		{
+			result.set(m2[1] - m1[2], m[2] - m2[0], m1[0] - m[1], tw);
+		}
+		else if (tx >= ty && tx >= tz)
+		{
+			result.set(tx, m[1] + m1[0], m[2] + m2[0], m2[1] - m1[2]);
+		}
+		else if (ty >= tz)
+		{
+			result.set(m[1] + m1[0], ty, m1[2] + m2[1], m[2] - m2[0]);
+		}
+		return result.normalized();
+	}
+
+	Quaternion Quaternion::log() const
+	{
+		float vectorLength = sqrtf(this->x * this->x + this->y * this->y + this->z * this->z);
+		// atan2() stays accurate for angles close to 0 and pi unlike acos()
+		float factor = (vectorLength > 0.0f ? atan2f(vectorLength, this->w) / vectorLength : 0.0f);
+		return Quaternion(this->x * factor, this->y * factor, this->z * factor, 0.5f * logf(this->squaredLength()));
+	}
+
+	Quaternion Quaternion::exp() const
+	{
+		float angle = sqrtf(this->x * this->x + this->y * this->y + this->z * this->z);
+		float scale = expf(this->w);
+		float factor = (angle > 0.0f ? scale * sinf(angle) / angle : scale);
+		return Quaternion(this->x * factor, this->y * factor, this->z * factor, scale * cosf(angle));
+	}
+
 	Matrix4 Quaternion::mat4() const
 	{
-		return Matrix4();
+		return this->mat4(Vector3<float>());
 	}
 
 	Matrix4 Quaternion::mat4(const Vector3<float>& position) const
@@ -36,4 +127,2168 @@ namespace gtypes
 					   position.x,				position.y,					position.z,					1.0f);
 	}
 
+	void Quaternion::normalizeFast(Quaternion* quaternions, int count)
+	{
+		simd::getKernels().normalizeFastQuaternion(quaternions, count);
+	}
+
+	Quaternion Quaternion::slerp(const Quaternion& a, const Quaternion& b, float factor)
+	{
+		float cosTheta = a.dot(b);
+		float sign = 1.0f;
+		if (cosTheta < 0.0f)
+		{
+			cosTheta = -cosTheta;
+			sign = -1.0f;
+		}
+		// rounding can push the dot-product of unit Quaternions slightly above 1
+		float x = (cosTheta < 1.0f ? cosTheta : 1.0f) - 1.0f;
+		float inverseFactor = 1.0f - factor;
+		float weightA = inverseFactor * _slerpSeries(inverseFactor * inverseFactor, x);
+		float weightB = sign * factor * _slerpSeries(factor * factor, x);
+		return (a * weightA + b * weightB);
+	}
+
+	void Quaternion::slerp(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+	{
+		simd::getKernels().slerpQuaternion(a, b, factors, result, count);
+	}
+
+	Quaternion Quaternion::squad(const Quaternion& a, const Quaternion& b, const Quaternion& controlA, const Quaternion& controlB, float factor)
+	{
+		// the inner hemisphere choices stay the same for the whole segment, only the outer one could jump within it
+		return _slerpArc(Quaternion::slerp(a, b, factor), Quaternion::slerp(controlA, controlB, factor), 2.0f * factor * (1.0f - factor));
+	}
+
+	Quaternion Quaternion::squadControl(const Quaternion& previous, const Quaternion& current, const Quaternion& next)
+	{
+		Quaternion inversed = current.conjugated();
+		Quaternion toPrevious = inversed * (current.dot(previous) < 0.0f ? -previous : previous);
+		Quaternion toNext = inversed * (current.dot(next) < 0.0f ? -next : next);
+		return current * ((toPrevious.log() + toNext.log()) * -0.25f).exp();
+	}
+
+	void Quaternion::nlerp(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+	{
+		simd::getKernels().nlerpQuaternion(a, b, factors, result, count);
+	}
+
+	void Quaternion::rotate(const Quaternion& quaternion, const Vector3<float>* vectors, Vector3<float>* result, int count)
+	{
+		simd::getKernels().rotateVector3f(quaternion, vectors, result, count);
+	}
+
+	void Quaternion::rotate(const Quaternion* quaternions, const Vector3<float>* vectors, Vector3<float>* result, int count)
+	{
+		simd::getKernels().rotateVector3fPaired(quaternions, vectors, result, count);
+	}
+
+	void Quaternion::multiply(const Quaternion* a, const Quaternion* b, Quaternion* result, int count)
+	{
+		simd::getKernels().multiplyQuaternion(a, b, result, count);
+	}
+
+	Vector3<float> Quaternion::toEulerAngles() const
+	{
+		float sine = 2.0f * (this->y * this->z - this->w * this->x);
+		float rollY = -2.0f * (this->x * this->y + this->w * this->z);
+		float rollX = 1.0f - 2.0f * (this->x * this->x + this->z * this->z);
+		// the cosine of the pitch from the roll terms stays accurate close to the gimbal lock unlike asin()
+		float pitch = atan2f(sine, sqrtf(rollY * rollY + rollX * rollX));
+		if (fabsf(sine) > EULER_GIMBAL_LOCK)
+		{
+			return Vector3<float>(atan2f(2.0f * (this->x * this->z - this->w * this->y), 1.0f - 2.0f * (this->y * this->y + this->z * this->z)), pitch, 0.0f);
+		}
+		return Vector3<float>(atan2f(-2.0f * (this->x * this->z + this->w * this->y), 1.0f - 2.0f * (this->x * this->x + this->y * this->y)), pitch,
+			atan2f(rollY, rollX));
+	}
+
+	void Quaternion::fromEulerAngles(const Vector3<float>* angles, Quaternion* result, int count)
+	{
+		simd::getKernels().fromEulerAnglesQuaternion(angles, result, count);
+	}
+
+	void Quaternion::toEulerAngles(const Quaternion* quaternions, Vector3<float>* angles, int count)
+	{
+		simd::getKernels().toEulerAnglesQuaternion(quaternions, angles, count);
+	}
+
+	Quaternion Quaternion::fromMatrix(const Matrix3& matrix)
+	{
+		return _fromMatrix(matrix.data, 3);
+	}
+
+	Quaternion Quaternion::fromMatrix(const Matrix4& matrix)
+	{
+		return _fromMatrix(matrix.data, 4);
+	}
+
+	void Quaternion::fromMatrix(const Matrix3* matrices, Quaternion* result, int count)
+	{
+		simd::getKernels().fromMatrix3Quaternion(matrices, result, count);
+	}
+
+	void Quaternion::fromMatrix(const Matrix4* matrices, Quaternion* result, int count)
+	{
+		simd::getKernels().fromMatrix4Quaternion(matrices, result, count);
+	}
+
+	void Quaternion::integrate(const Vector3<float>& angularVelocity, float dt, QuaternionIntegration integration)
+	{
+		float scale = 0.5f * dt;
+		float cosine = 1.0f;
+		if (integration == QuaternionIntegrationExponential)
+		{
+			float angle = angularVelocity.length() * scale;
+			if (angle != 0.0f)
+			{
+				cosine = cosf(angle);
+				scale *= sinf(angle) / angle;
+			}
+		}
+		*this = ((*this) * cosine + Quaternion(angularVelocity, 0.0f) * (*this) * scale).normalized();
+	}
+
+	void Quaternion::integrate(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count, QuaternionIntegration integration)
+	{
+		if (integration == QuaternionIntegrationExponential)
+		{
+			simd::getKernels().integrateExponentialQuaternion(quaternions, angularVelocities, dt, count);
+		}
+		else
+		{
+			simd::getKernels().integrateQuaternion(quaternions, angularVelocities, dt, count);
+		}
+	}
+
+	namespace simd
+	{
+		static void normalizeFastQuaternionScalar(Quaternion* quaternions, int count)
+		{
+			float squaredLength = 0.0f;
+			for (int i = 0; i < count; ++i)
+			{
+				squaredLength = quaternions[i].squaredLength();
+				if (squaredLength != 0.0f)
+				{
+					quaternions[i] *= 1.0f / sqrtf(squaredLength);
+				}
+			}
+		}
+
+		static void multiplyQuaternionScalar(const Quaternion* a, const Quaternion* b, Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				const Quaternion& qa = a[i];
+				const Quaternion& qb = b[i];
+				float x = qa.w * qb.x + qa.x * qb.w + qa.y * qb.z - qa.z * qb.y;
+				float y = qa.w * qb.y - qa.x * qb.z + qa.y * qb.w + qa.z * qb.x;
+				float z = qa.w * qb.z + qa.x * qb.y - qa.y * qb.x + qa.z * qb.w;
+				float w = qa.w * qb.w - qa.x * qb.x - qa.y * qb.y - qa.z * qb.z;
+				result[i].set(x, y, z, w);
+			}
+		}
+
+		static void slerpQuaternionScalar(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = Quaternion::slerp(a[i], b[i], factors[i]);
+			}
+		}
+
+		static void nlerpQuaternionScalar(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			float weight = 0.0f;
+			float squaredLength = 0.0f;
+			for (int i = 0; i < count; ++i)
+			{
+				weight = (a[i].dot(b[i]) < 0.0f ? -factors[i] : factors[i]);
+				result[i] = a[i] * (1.0f - factors[i]) + b[i] * weight;
+				squaredLength = result[i].squaredLength();
+				if (squaredLength != 0.0f)
+				{
+					result[i] *= 1.0f / sqrtf(squaredLength);
+				}
+			}
+		}
+
+		static void rotateVector3fScalar(const Quaternion& quaternion, const Vector3<float>* vectors, Vector3<float>* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = quaternion.rotate(vectors[i]);
+			}
+		}
+
+		static void rotateVector3fPairedScalar(const Quaternion* quaternions, const Vector3<float>* vectors, Vector3<float>* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = quaternions[i].rotate(vectors[i]);
+			}
+		}
+
+		// sin() and cos() of an angle in radians, reduced to [-pi / 4, pi / 4] by the nearest multiple of pi / 2 which is
+		// subtracted in 3 parts so the reduction stays accurate for large angles, same polynomials as the Vector2 kernels
+		static inline void _sinCosFast(float radians, float& sine, float& cosine)
+		{
+			float scaled = radians * 0.636619772f;
+			int quadrant = (int)(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+			float r = ((radians - (float)quadrant * 1.5703125f) - (float)quadrant * 4.837512969970703125e-4f) - (float)quadrant * 7.54978995489188216e-8f;
+			float z = r * r;
+			float s = r + r * z * ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f);
+			float c = 1.0f - 0.5f * z + z * z * ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f);
+			if ((quadrant & 1) != 0)
+			{
+				float swap = s;
+				s = c;
+				c = swap;
+			}
+			sine = ((quadrant & 2) != 0 ? -s : s);
+			cosine = (((quadrant + 1) & 2) != 0 ? -c : c);
+		}
+
+		// same closed form as Quaternion::fromEulerAngles() with _sinCosFast()
+		static inline Quaternion _fromEulerAnglesFast(const Vector3<float>& angles)
+		{
+			float sy = 0.0f;
+			float cy = 0.0f;
+			float sp = 0.0f;
+			float cp = 0.0f;
+			float sr = 0.0f;
+			float cr = 0.0f;
+			_sinCosFast(angles.x * 0.5f, sy, cy);
+			_sinCosFast(angles.y * 0.5f, sp, cp);
+			_sinCosFast(angles.z * 0.5f, sr, cr);
+			float cycp = cy * cp;
+			float sysp = sy * sp;
+			float cysp = cy * sp;
+			float sycp = sy * cp;
+			return Quaternion(-(cysp * cr - sycp * sr), -(sycp * cr + cysp * sr), -(cycp * sr + sysp * cr), cycp * cr - sysp * sr);
+		}
+
+		// same steps as Quaternion::toEulerAngles() with atan2Fast() for all angles
+		static inline Vector3<float> _toEulerAnglesFast(const Quaternion& q)
+		{
+			float sine = 2.0f * (q.y * q.z - q.w * q.x);
+			float rollY = -2.0f * (q.x * q.y + q.w * q.z);
+			float rollX = 1.0f - 2.0f * (q.x * q.x + q.z * q.z);
+			float pitch = atan2Fast(sine, sqrtf(rollY * rollY + rollX * rollX));
+			if (fabsf(sine) > EULER_GIMBAL_LOCK)
+			{
+				return Vector3<float>(atan2Fast(2.0f * (q.x * q.z - q.w * q.y), 1.0f - 2.0f * (q.y * q.y + q.z * q.z)), pitch, 0.0f);
+			}
+			return Vector3<float>(atan2Fast(-2.0f * (q.x * q.z + q.w * q.y), 1.0f - 2.0f * (q.x * q.x + q.y * q.y)), pitch, atan2Fast(rollY, rollX));
+		}
+
+		static void fromEulerAnglesQuaternionScalar(const Vector3<float>* angles, Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = _fromEulerAnglesFast(angles[i]);
+			}
+		}
+
+		static void toEulerAnglesQuaternionScalar(const Quaternion* quaternions, Vector3<float>* angles, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				angles[i] = _toEulerAnglesFast(quaternions[i]);
+			}
+		}
+
+		static void fromMatrix3QuaternionScalar(const Matrix3* matrices, Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = _fromMatrix(matrices[i].data, 3);
+			}
+		}
+
+		static void fromMatrix4QuaternionScalar(const Matrix4* matrices, Quaternion* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = _fromMatrix(matrices[i].data, 4);
+			}
+		}
+
+		// same steps as Quaternion::integrate() with _sinCosFast()
+		template <bool Exponential>
+		static inline void _integrateFast(Quaternion& q, const Vector3<float>& omega, float halfDt)
+		{
+			float scale = halfDt;
+			float cosine = 1.0f;
+			if (Exponential)
+			{
+				float angle = sqrtf(omega.x * omega.x + omega.y * omega.y + omega.z * omega.z) * halfDt;
+				if (angle != 0.0f)
+				{
+					float sine = 0.0f;
+					_sinCosFast(angle, sine, cosine);
+					scale *= sine / angle;
+				}
+			}
+			float x = cosine * q.x + scale * (omega.x * q.w + omega.y * q.z - omega.z * q.y);
+			float y = cosine * q.y + scale * (omega.y * q.w + omega.z * q.x - omega.x * q.z);
+			float z = cosine * q.z + scale * (omega.z * q.w + omega.x * q.y - omega.y * q.x);
+			float w = cosine * q.w - scale * (omega.x * q.x + omega.y * q.y + omega.z * q.z);
+			float squaredLength = x * x + y * y + z * z + w * w;
+			float inverse = (squaredLength != 0.0f ? 1.0f / sqrtf(squaredLength) : 1.0f);
+			q.set(x * inverse, y * inverse, z * inverse, w * inverse);
+		}
+
+		template <bool Exponential>
+		static void _integrateQuaternionScalar(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				_integrateFast<Exponential>(quaternions[i], angularVelocities[i], 0.5f * dt);
+			}
+		}
+
+		static void integrateQuaternionScalar(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionScalar<false>(quaternions, angularVelocities, dt, count);
+		}
+
+		static void integrateExponentialQuaternionScalar(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionScalar<true>(quaternions, angularVelocities, dt, count);
+		}
+
+#if defined(GTYPES_SIMD_SSE)
+		static void normalizeFastQuaternionSse2(Quaternion* quaternions, int count)
+		{
+			int i = 0;
+			// 4 Quaternions at once, transposed to SoA for the length calculation
+			for (; i + 4 <= count; i += 4)
+			{
+				float* data = &quaternions[i].x;
+				__m128 q0 = _mm_loadu_ps(data);
+				__m128 q1 = _mm_loadu_ps(data + 4);
+				__m128 q2 = _mm_loadu_ps(data + 8);
+				__m128 q3 = _mm_loadu_ps(data + 12);
+				__m128 s0 = _mm_mul_ps(q0, q0);
+				__m128 s1 = _mm_mul_ps(q1, q1);
+				__m128 s2 = _mm_mul_ps(q2, q2);
+				__m128 s3 = _mm_mul_ps(q3, q3);
+				_MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+				__m128 inverse = rsqrtNonZero(_mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3)));
+				_mm_storeu_ps(data, _mm_mul_ps(q0, _mm_shuffle_ps(inverse, inverse, _MM_SHUFFLE(0, 0, 0, 0))));
+				_mm_storeu_ps(data + 4, _mm_mul_ps(q1, _mm_shuffle_ps(inverse, inverse, _MM_SHUFFLE(1, 1, 1, 1))));
+				_mm_storeu_ps(data + 8, _mm_mul_ps(q2, _mm_shuffle_ps(inverse, inverse, _MM_SHUFFLE(2, 2, 2, 2))));
+				_mm_storeu_ps(data + 12, _mm_mul_ps(q3, _mm_shuffle_ps(inverse, inverse, _MM_SHUFFLE(3, 3, 3, 3))));
+			}
+			for (; i < count; ++i)
+			{
+				quaternions[i].normalizeFast();
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void normalizeFastQuaternionAvx2(Quaternion* quaternions, int count)
+		{
+			int i = 0;
+			// 4 Quaternions at once, the squares are summed within each 4-float group so no transposing is needed
+			for (; i + 4 <= count; i += 4)
+			{
+				float* data = &quaternions[i].x;
+				__m256 a = _mm256_loadu_ps(data);
+				__m256 b = _mm256_loadu_ps(data + 8);
+				__m256 sa = _mm256_mul_ps(a, a);
+				__m256 sb = _mm256_mul_ps(b, b);
+				sa = _mm256_add_ps(sa, _mm256_permute_ps(sa, _MM_SHUFFLE(2, 3, 0, 1)));
+				sb = _mm256_add_ps(sb, _mm256_permute_ps(sb, _MM_SHUFFLE(2, 3, 0, 1)));
+				sa = _mm256_add_ps(sa, _mm256_permute_ps(sa, _MM_SHUFFLE(1, 0, 3, 2)));
+				sb = _mm256_add_ps(sb, _mm256_permute_ps(sb, _MM_SHUFFLE(1, 0, 3, 2)));
+				_mm256_storeu_ps(data, _mm256_mul_ps(a, rsqrtNonZero(sa)));
+				_mm256_storeu_ps(data + 8, _mm256_mul_ps(b, rsqrtNonZero(sb)));
+			}
+			for (; i < count; ++i)
+			{
+				quaternions[i].normalizeFast();
+			}
+		}
+
+		static void multiplyQuaternionSse2(const Quaternion* a, const Quaternion* b, Quaternion* result, int count)
+		{
+			int i = 0;
+			// 4 Quaternions at once, transposed to SoA so every component is a plain sum of products
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 ax;
+				__m128 ay;
+				__m128 az;
+				__m128 aw;
+				__m128 bx;
+				__m128 by;
+				__m128 bz;
+				__m128 bw;
+				load4(&a[i].x, ax, ay, az, aw);
+				load4(&b[i].x, bx, by, bz, bw);
+				__m128 x = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by));
+				__m128 y = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ax, bz)), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx));
+				__m128 z = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx)), _mm_mul_ps(az, bw));
+				__m128 w = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+				store4(&result[i].x, x, y, z, w);
+			}
+			for (; i < count; ++i)
+			{
+				multiplyQuaternion4(&a[i].x, &b[i].x, &result[i].x);
+			}
+		}
+
+		static void rotateVector3fSse2(const Quaternion& quaternion, const Vector3<float>* vectors, Vector3<float>* result, int count)
+		{
+			__m128 qx = _mm_set1_ps(quaternion.x);
+			__m128 qy = _mm_set1_ps(quaternion.y);
+			__m128 qz = _mm_set1_ps(quaternion.z);
+			__m128 qw = _mm_set1_ps(quaternion.w);
+			int i = 0;
+			// 4 Vector3s at once, deinterleaved to SoA
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 x;
+				__m128 y;
+				__m128 z;
+				load3(&vectors[i].x, x, y, z);
+				rotate3(qx, qy, qz, qw, x, y, z);
+				store3(&result[i].x, x, y, z);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = quaternion.rotate(vectors[i]);
+			}
+		}
+
+		static void rotateVector3fPairedSse2(const Quaternion* quaternions, const Vector3<float>* vectors, Vector3<float>* result, int count)
+		{
+			int i = 0;
+			// 4 Quaternions and Vector3s at once, the Quaternions are transposed to SoA
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 qx;
+				__m128 qy;
+				__m128 qz;
+				__m128 qw;
+				load4(&quaternions[i].x, qx, qy, qz, qw);
+				__m128 x;
+				__m128 y;
+				__m128 z;
+				load3(&vectors[i].x, x, y, z);
+				rotate3(qx, qy, qz, qw, x, y, z);
+				store3(&result[i].x, x, y, z);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = quaternions[i].rotate(vectors[i]);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void multiplyQuaternionAvx2(const Quaternion* a, const Quaternion* b, Quaternion* result, int count)
+		{
+			__m256 signsX = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f);
+			__m256 signsY = _mm256_setr_ps(0.0f, 0.0f, -0.0f, -0.0f, 0.0f, 0.0f, -0.0f, -0.0f);
+			__m256 signsZ = _mm256_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f, -0.0f, 0.0f, 0.0f, -0.0f);
+			int i = 0;
+			// 2 Quaternions at once, one per 128 bit lane, same approach as simd::multiplyQuaternion4()
+			for (; i + 2 <= count; i += 2)
+			{
+				__m256 qa = _mm256_loadu_ps(&a[i].x);
+				__m256 qb = _mm256_loadu_ps(&b[i].x);
+				__m256 product = _mm256_mul_ps(_mm256_permute_ps(qa, _MM_SHUFFLE(3, 3, 3, 3)), qb);
+				product = _mm256_add_ps(product, _mm256_mul_ps(_mm256_permute_ps(qa, _MM_SHUFFLE(0, 0, 0, 0)),
+					_mm256_xor_ps(_mm256_permute_ps(qb, _MM_SHUFFLE(0, 1, 2, 3)), signsX)));
+				product = _mm256_add_ps(product, _mm256_mul_ps(_mm256_permute_ps(qa, _MM_SHUFFLE(1, 1, 1, 1)),
+					_mm256_xor_ps(_mm256_permute_ps(qb, _MM_SHUFFLE(1, 0, 3, 2)), signsY)));
+				product = _mm256_add_ps(product, _mm256_mul_ps(_mm256_permute_ps(qa, _MM_SHUFFLE(2, 2, 2, 2)),
+					_mm256_xor_ps(_mm256_permute_ps(qb, _MM_SHUFFLE(2, 3, 0, 1)), signsZ)));
+				_mm256_storeu_ps(&result[i].x, product);
+			}
+			for (; i < count; ++i)
+			{
+				multiplyQuaternion4(&a[i].x, &b[i].x, &result[i].x);
+			}
+		}
+
+		// evaluates the slerp series like _slerpSeries() for 4 factors
+		static inline __m128 _slerpSeriesSse2(__m128 squaredFactors, __m128 x)
+		{
+			__m128 one = _mm_set1_ps(1.0f);
+			__m128 b[SLERP_TERMS];
+			for (int i = 0; i < SLERP_TERMS; ++i)
+			{
+				b[i] = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(slerpU[i]), squaredFactors), _mm_set1_ps(slerpV[i])), x);
+			}
+			__m128 s0 = _mm_add_ps(one, _mm_mul_ps(b[0], _mm_add_ps(one, _mm_mul_ps(b[1], _mm_add_ps(one, b[2])))));
+			__m128 s1 = _mm_add_ps(one, _mm_mul_ps(b[4], _mm_add_ps(one, _mm_mul_ps(b[5], _mm_add_ps(one, b[6])))));
+			__m128 s2 = _mm_add_ps(one, _mm_mul_ps(b[8], _mm_add_ps(one, _mm_mul_ps(b[9], _mm_add_ps(one, _mm_mul_ps(b[10], _mm_add_ps(one, b[11])))))));
+			__m128 p0 = _mm_mul_ps(_mm_mul_ps(b[0], b[1]), _mm_mul_ps(b[2], b[3]));
+			__m128 p1 = _mm_mul_ps(_mm_mul_ps(b[4], b[5]), _mm_mul_ps(b[6], b[7]));
+			return _mm_add_ps(s0, _mm_mul_ps(p0, _mm_add_ps(s1, _mm_mul_ps(p1, s2))));
+		}
+
+		// calculates the slerp weights of 4 Quaternion pairs from their dot-products, the sign for the shorter arc is
+		// included in weightB
+		static inline void _slerpWeightsSse2(__m128 dot, __m128 factors, __m128& weightA, __m128& weightB)
+		{
+			__m128 one = _mm_set1_ps(1.0f);
+			__m128 sign = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+			__m128 x = _mm_sub_ps(_mm_min_ps(_mm_xor_ps(dot, sign), one), one);
+			__m128 inverseFactors = _mm_sub_ps(one, factors);
+			weightA = _mm_mul_ps(inverseFactors, _slerpSeriesSse2(_mm_mul_ps(inverseFactors, inverseFactors), x));
+			weightB = _mm_xor_ps(_mm_mul_ps(factors, _slerpSeriesSse2(_mm_mul_ps(factors, factors), x)), sign);
+		}
+
+		static void slerpQuaternionSse2(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			int i = 0;
+			// 4 Quaternion pairs at once, transposed to SoA
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 ax;
+				__m128 ay;
+				__m128 az;
+				__m128 aw;
+				__m128 bx;
+				__m128 by;
+				__m128 bz;
+				__m128 bw;
+				load4(&a[i].x, ax, ay, az, aw);
+				load4(&b[i].x, bx, by, bz, bw);
+				__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+				__m128 weightA;
+				__m128 weightB;
+				_slerpWeightsSse2(dot, _mm_loadu_ps(factors + i), weightA, weightB);
+				store4(&result[i].x, _mm_add_ps(_mm_mul_ps(ax, weightA), _mm_mul_ps(bx, weightB)),
+					_mm_add_ps(_mm_mul_ps(ay, weightA), _mm_mul_ps(by, weightB)),
+					_mm_add_ps(_mm_mul_ps(az, weightA), _mm_mul_ps(bz, weightB)),
+					_mm_add_ps(_mm_mul_ps(aw, weightA), _mm_mul_ps(bw, weightB)));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = Quaternion::slerp(a[i], b[i], factors[i]);
+			}
+		}
+
+		static void nlerpQuaternionSse2(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			int i = 0;
+			// 4 Quaternion pairs at once, transposed to SoA
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 ax;
+				__m128 ay;
+				__m128 az;
+				__m128 aw;
+				__m128 bx;
+				__m128 by;
+				__m128 bz;
+				__m128 bw;
+				load4(&a[i].x, ax, ay, az, aw);
+				load4(&b[i].x, bx, by, bz, bw);
+				__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+				__m128 factor = _mm_loadu_ps(factors + i);
+				__m128 weightA = _mm_sub_ps(_mm_set1_ps(1.0f), factor);
+				__m128 weightB = _mm_xor_ps(factor, _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f)));
+				__m128 x = _mm_add_ps(_mm_mul_ps(ax, weightA), _mm_mul_ps(bx, weightB));
+				__m128 y = _mm_add_ps(_mm_mul_ps(ay, weightA), _mm_mul_ps(by, weightB));
+				__m128 z = _mm_add_ps(_mm_mul_ps(az, weightA), _mm_mul_ps(bz, weightB));
+				__m128 w = _mm_add_ps(_mm_mul_ps(aw, weightA), _mm_mul_ps(bw, weightB));
+				__m128 inverse = rsqrtNonZero(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+				store4(&result[i].x, _mm_mul_ps(x, inverse), _mm_mul_ps(y, inverse), _mm_mul_ps(z, inverse), _mm_mul_ps(w, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = Quaternion::nlerp(a[i], b[i], factors[i]);
+			}
+		}
+
+		// sin() and cos() of 4 angles in radians, same steps as _sinCosFast(), the quadrant swaps and negates through masks and sign bits
+		static inline void _sinCosSse2(__m128 radians, __m128& sine, __m128& cosine)
+		{
+			__m128i one = _mm_set1_epi32(1);
+			__m128i two = _mm_set1_epi32(2);
+			__m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(radians, _mm_set1_ps(0.636619772f)));
+			__m128 q = _mm_cvtepi32_ps(quadrant);
+			__m128 r = _mm_sub_ps(radians, _mm_mul_ps(q, _mm_set1_ps(1.5703125f)));
+			r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(4.837512969970703125e-4f)));
+			r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(7.54978995489188216e-8f)));
+			__m128 z = _mm_mul_ps(r, r);
+			__m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+			s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(-1.6666654611e-1f));
+			s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), s));
+			__m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+			c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(4.166664568298827e-2f));
+			c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_mul_ps(_mm_mul_ps(z, z), c));
+			__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+			sine = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+			cosine = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+			sine = _mm_xor_ps(sine, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30)));
+			cosine = _mm_xor_ps(cosine, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30)));
+		}
+
+		// atan2() of 4 coordinate pairs, same steps as atan2Fast() with selects instead of branches
+		static inline __m128 _atan2Sse2(__m128 y, __m128 x)
+		{
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			__m128 zero = _mm_setzero_ps();
+			__m128 absX = _mm_andnot_ps(signMask, x);
+			__m128 absY = _mm_andnot_ps(signMask, y);
+			__m128 maxValue = _mm_max_ps(absX, absY);
+			// 0 / 0 gives NaN, the mask turns it into 0
+			__m128 t = _mm_and_ps(_mm_div_ps(_mm_min_ps(absX, absY), maxValue), _mm_cmpgt_ps(maxValue, zero));
+			__m128 s = _mm_mul_ps(t, t);
+			__m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-0.01172120f), s), _mm_set1_ps(0.05265332f));
+			result = _mm_add_ps(_mm_mul_ps(result, s), _mm_set1_ps(-0.11643287f));
+			result = _mm_add_ps(_mm_mul_ps(result, s), _mm_set1_ps(0.19354346f));
+			result = _mm_add_ps(_mm_mul_ps(result, s), _mm_set1_ps(-0.33262347f));
+			result = _mm_add_ps(_mm_mul_ps(result, s), _mm_set1_ps(0.99997726f));
+			result = _mm_mul_ps(result, t);
+			__m128 mask = _mm_cmpgt_ps(absY, absX);
+			result = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(_mm_set1_ps(1.57079637f), result)), _mm_andnot_ps(mask, result));
+			mask = _mm_cmplt_ps(x, zero);
+			result = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(_mm_set1_ps(3.14159274f), result)), _mm_andnot_ps(mask, result));
+			return _mm_or_ps(result, _mm_and_ps(y, signMask));
+		}
+
+		static void fromEulerAnglesQuaternionSse2(const Vector3<float>* angles, Quaternion* result, int count)
+		{
+			__m128 half = _mm_set1_ps(0.5f);
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			int i = 0;
+			// 4 angle triples at once, deinterleaved by load3()
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 yaw;
+				__m128 pitch;
+				__m128 roll;
+				__m128 sy;
+				__m128 cy;
+				__m128 sp;
+				__m128 cp;
+				__m128 sr;
+				__m128 cr;
+				load3(&angles[i].x, yaw, pitch, roll);
+				_sinCosSse2(_mm_mul_ps(yaw, half), sy, cy);
+				_sinCosSse2(_mm_mul_ps(pitch, half), sp, cp);
+				_sinCosSse2(_mm_mul_ps(roll, half), sr, cr);
+				__m128 cycp = _mm_mul_ps(cy, cp);
+				__m128 sysp = _mm_mul_ps(sy, sp);
+				__m128 cysp = _mm_mul_ps(cy, sp);
+				__m128 sycp = _mm_mul_ps(sy, cp);
+				store4(&result[i].x, _mm_xor_ps(_mm_sub_ps(_mm_mul_ps(cysp, cr), _mm_mul_ps(sycp, sr)), signMask),
+					_mm_xor_ps(_mm_add_ps(_mm_mul_ps(sycp, cr), _mm_mul_ps(cysp, sr)), signMask),
+					_mm_xor_ps(_mm_add_ps(_mm_mul_ps(cycp, sr), _mm_mul_ps(sysp, cr)), signMask),
+					_mm_sub_ps(_mm_mul_ps(cycp, cr), _mm_mul_ps(sysp, sr)));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = _fromEulerAnglesFast(angles[i]);
+			}
+		}
+
+		static void toEulerAnglesQuaternionSse2(const Quaternion* quaternions, Vector3<float>* angles, int count)
+		{
+			__m128 one = _mm_set1_ps(1.0f);
+			__m128 two = _mm_set1_ps(2.0f);
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			int i = 0;
+			// 4 Quaternions at once, the yaw arguments of the gimbal lock are selected before a single atan2()
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 x;
+				__m128 y;
+				__m128 z;
+				__m128 w;
+				load4(&quaternions[i].x, x, y, z, w);
+				__m128 sine = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(y, z), _mm_mul_ps(w, x)));
+				__m128 xx = _mm_mul_ps(x, x);
+				__m128 yy = _mm_mul_ps(y, y);
+				__m128 zz = _mm_mul_ps(z, z);
+				__m128 xz = _mm_mul_ps(x, z);
+				__m128 wy = _mm_mul_ps(w, y);
+				__m128 rollY = _mm_mul_ps(_mm_set1_ps(-2.0f), _mm_add_ps(_mm_mul_ps(x, y), _mm_mul_ps(w, z)));
+				__m128 rollX = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+				__m128 pitch = _atan2Sse2(sine, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(rollY, rollY), _mm_mul_ps(rollX, rollX))));
+				__m128 lock = _mm_cmpgt_ps(_mm_andnot_ps(signMask, sine), _mm_set1_ps(EULER_GIMBAL_LOCK));
+				__m128 yawY = _mm_or_ps(_mm_and_ps(lock, _mm_sub_ps(xz, wy)), _mm_andnot_ps(lock, _mm_xor_ps(_mm_add_ps(xz, wy), signMask)));
+				__m128 yawX = _mm_or_ps(_mm_and_ps(lock, _mm_add_ps(yy, zz)), _mm_andnot_ps(lock, _mm_add_ps(xx, yy)));
+				__m128 yaw = _atan2Sse2(_mm_mul_ps(two, yawY), _mm_sub_ps(one, _mm_mul_ps(two, yawX)));
+				__m128 roll = _mm_andnot_ps(lock, _atan2Sse2(rollY, rollX));
+				store3(&angles[i].x, yaw, pitch, roll);
+			}
+			for (; i < count; ++i)
+			{
+				angles[i] = _toEulerAnglesFast(quaternions[i]);
+			}
+		}
+
+		// the element (row, column) of 4 consecutive matrices with Size rows and columns
+		template <int Size>
+		static inline __m128 _gatherSse2(const float* data, int row, int column)
+		{
+			const float* m = data + row * Size + column;
+			return _mm_setr_ps(m[0], m[Size * Size], m[Size * Size * 2], m[Size * Size * 3]);
+		}
+
+		// a where the mask is set, b everywhere else
+		static inline __m128 _selectSse2(__m128 mask, __m128 a, __m128 b)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		template <typename M, int Size>
+		static void _fromMatrixQuaternionSse2(const M* matrices, Quaternion* result, int count)
+		{
+			__m128 one = _mm_set1_ps(1.0f);
+			int i = 0;
+			// 4 matrices at once, all cases of Shepperd's method are calculated and each case replaces the previous ones
+			// where its diagonal term is the largest, z to w so the priority is the same as in _fromMatrix()
+			for (; i + 4 <= count; i += 4)
+			{
+				const float* m = matrices[i].data;
+				__m128 m00 = _gatherSse2<Size>(m, 0, 0);
+				__m128 m01 = _gatherSse2<Size>(m, 0, 1);
+				__m128 m02 = _gatherSse2<Size>(m, 0, 2);
+				__m128 m10 = _gatherSse2<Size>(m, 1, 0);
+				__m128 m11 = _gatherSse2<Size>(m, 1, 1);
+				__m128 m12 = _gatherSse2<Size>(m, 1, 2);
+				__m128 m20 = _gatherSse2<Size>(m, 2, 0);
+				__m128 m21 = _gatherSse2<Size>(m, 2, 1);
+				__m128 m22 = _gatherSse2<Size>(m, 2, 2);
+				__m128 tw = _mm_add_ps(_mm_add_ps(one, m00), _mm_add_ps(m11, m22));
+				__m128 tx = _mm_sub_ps(_mm_add_ps(one, m00), _mm_add_ps(m11, m22));
+				__m128 ty = _mm_sub_ps(_mm_add_ps(one, m11), _mm_add_ps(m00, m22));
+				__m128 tz = _mm_sub_ps(_mm_add_ps(one, m22), _mm_add_ps(m00, m11));
+				__m128 wx = _mm_sub_ps(m21, m12);
+				__m128 wy = _mm_sub_ps(m02, m20);
+				__m128 wz = _mm_sub_ps(m10, m01);
+				__m128 xy = _mm_add_ps(m01, m10);
+				__m128 xz = _mm_add_ps(m02, m20);
+				__m128 yz = _mm_add_ps(m12, m21);
+				__m128 maximum = _mm_max_ps(_mm_max_ps(tw, tx), _mm_max_ps(ty, tz));
+				__m128 mask = _mm_cmpge_ps(ty, maximum);
+				__m128 x = _selectSse2(mask, xy, xz);
+				__m128 y = _selectSse2(mask, ty, yz);
+				__m128 z = _selectSse2(mask, yz, tz);
+				__m128 w = _selectSse2(mask, wy, wz);
+				mask = _mm_cmpge_ps(tx, maximum);
+				x = _selectSse2(mask, tx, x);
+				y = _selectSse2(mask, xy, y);
+				z = _selectSse2(mask, xz, z);
+				w = _selectSse2(mask, wx, w);
+				mask = _mm_cmpge_ps(tw, maximum);
+				x = _selectSse2(mask, wx, x);
+				y = _selectSse2(mask, wy, y);
+				z = _selectSse2(mask, wz, z);
+				w = _selectSse2(mask, tw, w);
+				__m128 inverse = rsqrtNonZero(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+				store4(&result[i].x, _mm_mul_ps(x, inverse), _mm_mul_ps(y, inverse), _mm_mul_ps(z, inverse), _mm_mul_ps(w, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = _fromMatrix(matrices[i].data, Size);
+			}
+		}
+
+		static void fromMatrix3QuaternionSse2(const Matrix3* matrices, Quaternion* result, int count)
+		{
+			_fromMatrixQuaternionSse2<Matrix3, 3>(matrices, result, count);
+		}
+
+		static void fromMatrix4QuaternionSse2(const Matrix4* matrices, Quaternion* result, int count)
+		{
+			_fromMatrixQuaternionSse2<Matrix4, 4>(matrices, result, count);
+		}
+
+		template <bool Exponential>
+		static void _integrateQuaternionSse2(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			__m128 halfDt = _mm_set1_ps(0.5f * dt);
+			__m128 one = _mm_set1_ps(1.0f);
+			int i = 0;
+			// 4 Quaternions at once, both modes scale q and the derivative by their own factors so the integration and the
+			// renormalization are a single pass
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 x;
+				__m128 y;
+				__m128 z;
+				__m128 w;
+				__m128 ox;
+				__m128 oy;
+				__m128 oz;
+				load4(&quaternions[i].x, x, y, z, w);
+				load3(&angularVelocities[i].x, ox, oy, oz);
+				__m128 scale = halfDt;
+				__m128 cosine = one;
+				if (Exponential)
+				{
+					__m128 angle = _mm_mul_ps(_mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy)), _mm_mul_ps(oz, oz))), halfDt);
+					__m128 sine;
+					_sinCosSse2(angle, sine, cosine);
+					// sin(angle) / angle is 1 at 0
+					scale = _mm_mul_ps(scale, _selectSse2(_mm_cmpneq_ps(angle, _mm_setzero_ps()), _mm_div_ps(sine, angle), one));
+				}
+				__m128 dx = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(ox, w), _mm_mul_ps(oy, z)), _mm_mul_ps(oz, y));
+				__m128 dy = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(oy, w), _mm_mul_ps(oz, x)), _mm_mul_ps(ox, z));
+				__m128 dz = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(oz, w), _mm_mul_ps(ox, y)), _mm_mul_ps(oy, x));
+				__m128 dw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ox, x), _mm_mul_ps(oy, y)), _mm_mul_ps(oz, z));
+				x = _mm_add_ps(_mm_mul_ps(cosine, x), _mm_mul_ps(scale, dx));
+				y = _mm_add_ps(_mm_mul_ps(cosine, y), _mm_mul_ps(scale, dy));
+				z = _mm_add_ps(_mm_mul_ps(cosine, z), _mm_mul_ps(scale, dz));
+				w = _mm_sub_ps(_mm_mul_ps(cosine, w), _mm_mul_ps(scale, dw));
+				__m128 inverse = rsqrtNonZero(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+				store4(&quaternions[i].x, _mm_mul_ps(x, inverse), _mm_mul_ps(y, inverse), _mm_mul_ps(z, inverse), _mm_mul_ps(w, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				_integrateFast<Exponential>(quaternions[i], angularVelocities[i], 0.5f * dt);
+			}
+		}
+
+		static void integrateQuaternionSse2(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionSse2<false>(quaternions, angularVelocities, dt, count);
+		}
+
+		static void integrateExponentialQuaternionSse2(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionSse2<true>(quaternions, angularVelocities, dt, count);
+		}
+
+		// evaluates the slerp series like _slerpSeries() for 8 factors
+		GTYPES_TARGET_AVX2 static inline __m256 _slerpSeriesAvx2(__m256 squaredFactors, __m256 x)
+		{
+			__m256 one = _mm256_set1_ps(1.0f);
+			__m256 b[SLERP_TERMS];
+			for (int i = 0; i < SLERP_TERMS; ++i)
+			{
+				b[i] = _mm256_mul_ps(_mm256_fmsub_ps(_mm256_set1_ps(slerpU[i]), squaredFactors, _mm256_set1_ps(slerpV[i])), x);
+			}
+			__m256 s0 = _mm256_fmadd_ps(b[0], _mm256_fmadd_ps(b[1], _mm256_add_ps(one, b[2]), one), one);
+			__m256 s1 = _mm256_fmadd_ps(b[4], _mm256_fmadd_ps(b[5], _mm256_add_ps(one, b[6]), one), one);
+			__m256 s2 = _mm256_fmadd_ps(b[8], _mm256_fmadd_ps(b[9], _mm256_fmadd_ps(b[10], _mm256_add_ps(one, b[11]), one), one), one);
+			__m256 p0 = _mm256_mul_ps(_mm256_mul_ps(b[0], b[1]), _mm256_mul_ps(b[2], b[3]));
+			__m256 p1 = _mm256_mul_ps(_mm256_mul_ps(b[4], b[5]), _mm256_mul_ps(b[6], b[7]));
+			return _mm256_fmadd_ps(p0, _mm256_fmadd_ps(p1, s2, s1), s0);
+		}
+
+		// calculates the slerp weights like _slerpWeightsSse2() for 8 Quaternion pairs
+		GTYPES_TARGET_AVX2 static inline void _slerpWeightsAvx2(__m256 dot, __m256 factors, __m256& weightA, __m256& weightB)
+		{
+			__m256 one = _mm256_set1_ps(1.0f);
+			__m256 sign = _mm256_and_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f));
+			__m256 x = _mm256_sub_ps(_mm256_min_ps(_mm256_xor_ps(dot, sign), one), one);
+			__m256 inverseFactors = _mm256_sub_ps(one, factors);
+			weightA = _mm256_mul_ps(inverseFactors, _slerpSeriesAvx2(_mm256_mul_ps(inverseFactors, inverseFactors), x));
+			weightB = _mm256_xor_ps(_mm256_mul_ps(factors, _slerpSeriesAvx2(_mm256_mul_ps(factors, factors), x)), sign);
+		}
+
+		GTYPES_TARGET_AVX2 static void slerpQuaternionAvx2(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			__m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			int i = 0;
+			// 8 Quaternion pairs at once, the factors are permuted to the order left by load4()
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 ax;
+				__m256 ay;
+				__m256 az;
+				__m256 aw;
+				__m256 bx;
+				__m256 by;
+				__m256 bz;
+				__m256 bw;
+				load4(&a[i].x, ax, ay, az, aw);
+				load4(&b[i].x, bx, by, bz, bw);
+				__m256 dot = _mm256_fmadd_ps(aw, bw, _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx))));
+				__m256 weightA;
+				__m256 weightB;
+				_slerpWeightsAvx2(dot, _mm256_permutevar8x32_ps(_mm256_loadu_ps(factors + i), order), weightA, weightB);
+				store4(&result[i].x, _mm256_fmadd_ps(bx, weightB, _mm256_mul_ps(ax, weightA)),
+					_mm256_fmadd_ps(by, weightB, _mm256_mul_ps(ay, weightA)),
+					_mm256_fmadd_ps(bz, weightB, _mm256_mul_ps(az, weightA)),
+					_mm256_fmadd_ps(bw, weightB, _mm256_mul_ps(aw, weightA)));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = Quaternion::slerp(a[i], b[i], factors[i]);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void nlerpQuaternionAvx2(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			__m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			int i = 0;
+			// 8 Quaternion pairs at once, the factors are permuted to the order left by load4()
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 ax;
+				__m256 ay;
+				__m256 az;
+				__m256 aw;
+				__m256 bx;
+				__m256 by;
+				__m256 bz;
+				__m256 bw;
+				load4(&a[i].x, ax, ay, az, aw);
+				load4(&b[i].x, bx, by, bz, bw);
+				__m256 dot = _mm256_fmadd_ps(aw, bw, _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx))));
+				__m256 factor = _mm256_permutevar8x32_ps(_mm256_loadu_ps(factors + i), order);
+				__m256 weightA = _mm256_sub_ps(_mm256_set1_ps(1.0f), factor);
+				__m256 weightB = _mm256_xor_ps(factor, _mm256_and_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f)));
+				__m256 x = _mm256_fmadd_ps(bx, weightB, _mm256_mul_ps(ax, weightA));
+				__m256 y = _mm256_fmadd_ps(by, weightB, _mm256_mul_ps(ay, weightA));
+				__m256 z = _mm256_fmadd_ps(bz, weightB, _mm256_mul_ps(az, weightA));
+				__m256 w = _mm256_fmadd_ps(bw, weightB, _mm256_mul_ps(aw, weightA));
+				__m256 inverse = rsqrtNonZero(_mm256_fmadd_ps(w, w, _mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)))));
+				store4(&result[i].x, _mm256_mul_ps(x, inverse), _mm256_mul_ps(y, inverse), _mm256_mul_ps(z, inverse), _mm256_mul_ps(w, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = Quaternion::nlerp(a[i], b[i], factors[i]);
+			}
+		}
+
+		// sin() and cos() of 8 angles in radians, same steps as _sinCosSse2()
+		GTYPES_TARGET_AVX2 static inline void _sinCosAvx2(__m256 radians, __m256& sine, __m256& cosine)
+		{
+			__m256i one = _mm256_set1_epi32(1);
+			__m256i two = _mm256_set1_epi32(2);
+			__m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(radians, _mm256_set1_ps(0.636619772f)));
+			__m256 q = _mm256_cvtepi32_ps(quadrant);
+			__m256 r = _mm256_fnmadd_ps(q, _mm256_set1_ps(1.5703125f), radians);
+			r = _mm256_fnmadd_ps(q, _mm256_set1_ps(4.837512969970703125e-4f), r);
+			r = _mm256_fnmadd_ps(q, _mm256_set1_ps(7.54978995489188216e-8f), r);
+			__m256 z = _mm256_mul_ps(r, r);
+			__m256 s = _mm256_fmadd_ps(_mm256_set1_ps(-1.9515295891e-4f), z, _mm256_set1_ps(8.3321608736e-3f));
+			s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(-1.6666654611e-1f));
+			s = _mm256_fmadd_ps(_mm256_mul_ps(r, z), s, r);
+			__m256 c = _mm256_fmadd_ps(_mm256_set1_ps(2.443315711809948e-5f), z, _mm256_set1_ps(-1.388731625493765e-3f));
+			c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(4.166664568298827e-2f));
+			c = _mm256_fmadd_ps(_mm256_mul_ps(z, z), c, _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, _mm256_set1_ps(1.0f)));
+			__m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, one), one));
+			sine = _mm256_blendv_ps(s, c, swap);
+			cosine = _mm256_blendv_ps(c, s, swap);
+			sine = _mm256_xor_ps(sine, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, two), 30)));
+			cosine = _mm256_xor_ps(cosine, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, one), two), 30)));
+		}
+
+		// atan2() of 8 coordinate pairs, same steps as _atan2Sse2()
+		GTYPES_TARGET_AVX2 static inline __m256 _atan2Avx2(__m256 y, __m256 x)
+		{
+			__m256 signMask = _mm256_set1_ps(-0.0f);
+			__m256 zero = _mm256_setzero_ps();
+			__m256 absX = _mm256_andnot_ps(signMask, x);
+			__m256 absY = _mm256_andnot_ps(signMask, y);
+			__m256 maxValue = _mm256_max_ps(absX, absY);
+			__m256 t = _mm256_and_ps(_mm256_div_ps(_mm256_min_ps(absX, absY), maxValue), _mm256_cmp_ps(maxValue, zero, _CMP_GT_OQ));
+			__m256 s = _mm256_mul_ps(t, t);
+			__m256 result = _mm256_fmadd_ps(_mm256_set1_ps(-0.01172120f), s, _mm256_set1_ps(0.05265332f));
+			result = _mm256_fmadd_ps(result, s, _mm256_set1_ps(-0.11643287f));
+			result = _mm256_fmadd_ps(result, s, _mm256_set1_ps(0.19354346f));
+			result = _mm256_fmadd_ps(result, s, _mm256_set1_ps(-0.33262347f));
+			result = _mm256_fmadd_ps(result, s, _mm256_set1_ps(0.99997726f));
+			result = _mm256_mul_ps(result, t);
+			result = _mm256_blendv_ps(result, _mm256_sub_ps(_mm256_set1_ps(1.57079637f), result), _mm256_cmp_ps(absY, absX, _CMP_GT_OQ));
+			result = _mm256_blendv_ps(result, _mm256_sub_ps(_mm256_set1_ps(3.14159274f), result), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+			return _mm256_or_ps(result, _mm256_and_ps(y, signMask));
+		}
+
+		GTYPES_TARGET_AVX2 static void fromEulerAnglesQuaternionAvx2(const Vector3<float>* angles, Quaternion* result, int count)
+		{
+			__m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			__m256 half = _mm256_set1_ps(0.5f);
+			__m256 signMask = _mm256_set1_ps(-0.0f);
+			int i = 0;
+			// 8 angle triples at once, the halved angles are permuted to the order expected by store4()
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 yaw;
+				__m256 pitch;
+				__m256 roll;
+				__m256 sy;
+				__m256 cy;
+				__m256 sp;
+				__m256 cp;
+				__m256 sr;
+				__m256 cr;
+				load3(&angles[i].x, yaw, pitch, roll);
+				_sinCosAvx2(_mm256_permutevar8x32_ps(_mm256_mul_ps(yaw, half), order), sy, cy);
+				_sinCosAvx2(_mm256_permutevar8x32_ps(_mm256_mul_ps(pitch, half), order), sp, cp);
+				_sinCosAvx2(_mm256_permutevar8x32_ps(_mm256_mul_ps(roll, half), order), sr, cr);
+				__m256 cycp = _mm256_mul_ps(cy, cp);
+				__m256 sysp = _mm256_mul_ps(sy, sp);
+				__m256 cysp = _mm256_mul_ps(cy, sp);
+				__m256 sycp = _mm256_mul_ps(sy, cp);
+				store4(&result[i].x, _mm256_xor_ps(_mm256_fmsub_ps(cysp, cr, _mm256_mul_ps(sycp, sr)), signMask),
+					_mm256_xor_ps(_mm256_fmadd_ps(sycp, cr, _mm256_mul_ps(cysp, sr)), signMask),
+					_mm256_xor_ps(_mm256_fmadd_ps(cycp, sr, _mm256_mul_ps(sysp, cr)), signMask),
+					_mm256_fmsub_ps(cycp, cr, _mm256_mul_ps(sysp, sr)));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = _fromEulerAnglesFast(angles[i]);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void toEulerAnglesQuaternionAvx2(const Quaternion* quaternions, Vector3<float>* angles, int count)
+		{
+			__m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			__m256 one = _mm256_set1_ps(1.0f);
+			__m256 two = _mm256_set1_ps(2.0f);
+			__m256 signMask = _mm256_set1_ps(-0.0f);
+			int i = 0;
+			// 8 Quaternions at once, the angles are permuted back from the order left by load4() before store3()
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 x;
+				__m256 y;
+				__m256 z;
+				__m256 w;
+				load4(&quaternions[i].x, x, y, z, w);
+				__m256 sine = _mm256_mul_ps(two, _mm256_fmsub_ps(y, z, _mm256_mul_ps(w, x)));
+				__m256 xx = _mm256_mul_ps(x, x);
+				__m256 yy = _mm256_mul_ps(y, y);
+				__m256 zz = _mm256_mul_ps(z, z);
+				__m256 xz = _mm256_mul_ps(x, z);
+				__m256 wy = _mm256_mul_ps(w, y);
+				__m256 rollY = _mm256_mul_ps(_mm256_set1_ps(-2.0f), _mm256_fmadd_ps(x, y, _mm256_mul_ps(w, z)));
+				__m256 rollX = _mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one);
+				__m256 pitch = _atan2Avx2(sine, _mm256_sqrt_ps(_mm256_fmadd_ps(rollY, rollY, _mm256_mul_ps(rollX, rollX))));
+				__m256 lock = _mm256_cmp_ps(_mm256_andnot_ps(signMask, sine), _mm256_set1_ps(EULER_GIMBAL_LOCK), _CMP_GT_OQ);
+				__m256 yawY = _mm256_blendv_ps(_mm256_xor_ps(_mm256_add_ps(xz, wy), signMask), _mm256_sub_ps(xz, wy), lock);
+				__m256 yawX = _mm256_blendv_ps(_mm256_add_ps(xx, yy), _mm256_add_ps(yy, zz), lock);
+				__m256 yaw = _atan2Avx2(_mm256_mul_ps(two, yawY), _mm256_fnmadd_ps(two, yawX, one));
+				__m256 roll = _mm256_andnot_ps(lock, _atan2Avx2(rollY, rollX));
+				store3(&angles[i].x, _mm256_permutevar8x32_ps(yaw, order), _mm256_permutevar8x32_ps(pitch, order), _mm256_permutevar8x32_ps(roll, order));
+			}
+			for (; i < count; ++i)
+			{
+				angles[i] = _toEulerAnglesFast(quaternions[i]);
+			}
+		}
+
+		template <typename M, int Size>
+		GTYPES_TARGET_AVX2 static void _fromMatrixQuaternionAvx2(const M* matrices, Quaternion* result, int count)
+		{
+			// the offsets of 8 consecutive matrices in the order expected by store4()
+			__m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7), _mm256_set1_epi32(Size * Size));
+			__m256 one = _mm256_set1_ps(1.0f);
+			int i = 0;
+			// 8 matrices at once, same approach as the SSE2 version
+			for (; i + 8 <= count; i += 8)
+			{
+				const float* m = matrices[i].data;
+				__m256 m00 = _mm256_i32gather_ps(m, offsets, 4);
+				__m256 m01 = _mm256_i32gather_ps(m + 1, offsets, 4);
+				__m256 m02 = _mm256_i32gather_ps(m + 2, offsets, 4);
+				__m256 m10 = _mm256_i32gather_ps(m + Size, offsets, 4);
+				__m256 m11 = _mm256_i32gather_ps(m + Size + 1, offsets, 4);
+				__m256 m12 = _mm256_i32gather_ps(m + Size + 2, offsets, 4);
+				__m256 m20 = _mm256_i32gather_ps(m + Size * 2, offsets, 4);
+				__m256 m21 = _mm256_i32gather_ps(m + Size * 2 + 1, offsets, 4);
+				__m256 m22 = _mm256_i32gather_ps(m + Size * 2 + 2, offsets, 4);
+				__m256 tw = _mm256_add_ps(_mm256_add_ps(one, m00), _mm256_add_ps(m11, m22));
+				__m256 tx = _mm256_sub_ps(_mm256_add_ps(one, m00), _mm256_add_ps(m11, m22));
+				__m256 ty = _mm256_sub_ps(_mm256_add_ps(one, m11), _mm256_add_ps(m00, m22));
+				__m256 tz = _mm256_sub_ps(_mm256_add_ps(one, m22), _mm256_add_ps(m00, m11));
+				__m256 wx = _mm256_sub_ps(m21, m12);
+				__m256 wy = _mm256_sub_ps(m02, m20);
+				__m256 wz = _mm256_sub_ps(m10, m01);
+				__m256 xy = _mm256_add_ps(m01, m10);
+				__m256 xz = _mm256_add_ps(m02, m20);
+				__m256 yz = _mm256_add_ps(m12, m21);
+				__m256 maximum = _mm256_max_ps(_mm256_max_ps(tw, tx), _mm256_max_ps(ty, tz));
+				__m256 mask = _mm256_cmp_ps(ty, maximum, _CMP_GE_OQ);
+				__m256 x = _mm256_blendv_ps(xz, xy, mask);
+				__m256 y = _mm256_blendv_ps(yz, ty, mask);
+				__m256 z = _mm256_blendv_ps(tz, yz, mask);
+				__m256 w = _mm256_blendv_ps(wz, wy, mask);
+				mask = _mm256_cmp_ps(tx, maximum, _CMP_GE_OQ);
+				x = _mm256_blendv_ps(x, tx, mask);
+				y = _mm256_blendv_ps(y, xy, mask);
+				z = _mm256_blendv_ps(z, xz, mask);
+				w = _mm256_blendv_ps(w, wx, mask);
+				mask = _mm256_cmp_ps(tw, maximum, _CMP_GE_OQ);
+				x = _mm256_blendv_ps(x, wx, mask);
+				y = _mm256_blendv_ps(y, wy, mask);
+				z = _mm256_blendv_ps(z, wz, mask);
+				w = _mm256_blendv_ps(w, tw, mask);
+				__m256 inverse = rsqrtNonZero(_mm256_fmadd_ps(w, w, _mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)))));
+				store4(&result[i].x, _mm256_mul_ps(x, inverse), _mm256_mul_ps(y, inverse), _mm256_mul_ps(z, inverse), _mm256_mul_ps(w, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = _fromMatrix(matrices[i].data, Size);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void fromMatrix3QuaternionAvx2(const Matrix3* matrices, Quaternion* result, int count)
+		{
+			_fromMatrixQuaternionAvx2<Matrix3, 3>(matrices, result, count);
+		}
+
+		GTYPES_TARGET_AVX2 static void fromMatrix4QuaternionAvx2(const Matrix4* matrices, Quaternion* result, int count)
+		{
+			_fromMatrixQuaternionAvx2<Matrix4, 4>(matrices, result, count);
+		}
+
+		template <bool Exponential>
+		GTYPES_TARGET_AVX2 static void _integrateQuaternionAvx2(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			__m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			__m256 halfDt = _mm256_set1_ps(0.5f * dt);
+			__m256 one = _mm256_set1_ps(1.0f);
+			int i = 0;
+			// 8 Quaternions at once, the angular velocities are permuted to the order left by load4()
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 x;
+				__m256 y;
+				__m256 z;
+				__m256 w;
+				__m256 ox;
+				__m256 oy;
+				__m256 oz;
+				load4(&quaternions[i].x, x, y, z, w);
+				load3(&angularVelocities[i].x, ox, oy, oz);
+				ox = _mm256_permutevar8x32_ps(ox, order);
+				oy = _mm256_permutevar8x32_ps(oy, order);
+				oz = _mm256_permutevar8x32_ps(oz, order);
+				__m256 scale = halfDt;
+				__m256 cosine = one;
+				if (Exponential)
+				{
+					__m256 angle = _mm256_mul_ps(_mm256_sqrt_ps(_mm256_fmadd_ps(oz, oz, _mm256_fmadd_ps(oy, oy, _mm256_mul_ps(ox, ox)))), halfDt);
+					__m256 sine;
+					_sinCosAvx2(angle, sine, cosine);
+					__m256 nonZero = _mm256_cmp_ps(angle, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+					scale = _mm256_mul_ps(scale, _mm256_blendv_ps(one, _mm256_div_ps(sine, angle), nonZero));
+				}
+				__m256 dx = _mm256_fmsub_ps(ox, w, _mm256_fmsub_ps(oz, y, _mm256_mul_ps(oy, z)));
+				__m256 dy = _mm256_fmsub_ps(oy, w, _mm256_fmsub_ps(ox, z, _mm256_mul_ps(oz, x)));
+				__m256 dz = _mm256_fmsub_ps(oz, w, _mm256_fmsub_ps(oy, x, _mm256_mul_ps(ox, y)));
+				__m256 dw = _mm256_fmadd_ps(oz, z, _mm256_fmadd_ps(oy, y, _mm256_mul_ps(ox, x)));
+				x = _mm256_fmadd_ps(scale, dx, _mm256_mul_ps(cosine, x));
+				y = _mm256_fmadd_ps(scale, dy, _mm256_mul_ps(cosine, y));
+				z = _mm256_fmadd_ps(scale, dz, _mm256_mul_ps(cosine, z));
+				w = _mm256_fnmadd_ps(scale, dw, _mm256_mul_ps(cosine, w));
+				__m256 inverse = rsqrtNonZero(_mm256_fmadd_ps(w, w, _mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)))));
+				store4(&quaternions[i].x, _mm256_mul_ps(x, inverse), _mm256_mul_ps(y, inverse), _mm256_mul_ps(z, inverse), _mm256_mul_ps(w, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				_integrateFast<Exponential>(quaternions[i], angularVelocities[i], 0.5f * dt);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void integrateQuaternionAvx2(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionAvx2<false>(quaternions, angularVelocities, dt, count);
+		}
+
+		GTYPES_TARGET_AVX2 static void integrateExponentialQuaternionAvx2(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionAvx2<true>(quaternions, angularVelocities, dt, count);
+		}
+#endif
+
+#if defined(GTYPES_SIMD_AVX512)
+		GTYPES_TARGET_AVX512 static void normalizeFastQuaternionAvx512(Quaternion* quaternions, int count)
+		{
+			int i = 0;
+			// 8 Quaternions at once, same approach as the AVX2 version
+			for (; i + 8 <= count; i += 8)
+			{
+				float* data = &quaternions[i].x;
+				__m512 a = _mm512_loadu_ps(data);
+				__m512 b = _mm512_loadu_ps(data + 16);
+				__m512 sa = _mm512_mul_ps(a, a);
+				__m512 sb = _mm512_mul_ps(b, b);
+				sa = _mm512_add_ps(sa, _mm512_permute_ps(sa, _MM_SHUFFLE(2, 3, 0, 1)));
+				sb = _mm512_add_ps(sb, _mm512_permute_ps(sb, _MM_SHUFFLE(2, 3, 0, 1)));
+				sa = _mm512_add_ps(sa, _mm512_permute_ps(sa, _MM_SHUFFLE(1, 0, 3, 2)));
+				sb = _mm512_add_ps(sb, _mm512_permute_ps(sb, _MM_SHUFFLE(1, 0, 3, 2)));
+				_mm512_storeu_ps(data, _mm512_mul_ps(a, rsqrtNonZero(sa)));
+				_mm512_storeu_ps(data + 16, _mm512_mul_ps(b, rsqrtNonZero(sb)));
+			}
+			for (; i < count; ++i)
+			{
+				quaternions[i].normalizeFast();
+			}
+		}
+
+		// flips the sign bits set in signs, AVX-512F has no floating point xor
+		GTYPES_TARGET_AVX512 static inline __m512 _flipSigns(__m512 value, __m512i signs)
+		{
+			return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(value), signs));
+		}
+
+		GTYPES_TARGET_AVX512 static void multiplyQuaternionAvx512(const Quaternion* a, const Quaternion* b, Quaternion* result, int count)
+		{
+			__m512i signsX = _mm512_castps_si512(_mm512_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f,
+				0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f));
+			__m512i signsY = _mm512_castps_si512(_mm512_setr_ps(0.0f, 0.0f, -0.0f, -0.0f, 0.0f, 0.0f, -0.0f, -0.0f,
+				0.0f, 0.0f, -0.0f, -0.0f, 0.0f, 0.0f, -0.0f, -0.0f));
+			__m512i signsZ = _mm512_castps_si512(_mm512_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f, -0.0f, 0.0f, 0.0f, -0.0f,
+				-0.0f, 0.0f, 0.0f, -0.0f, -0.0f, 0.0f, 0.0f, -0.0f));
+			int i = 0;
+			// 4 Quaternions at once, same approach as the AVX2 version
+			for (; i + 4 <= count; i += 4)
+			{
+				__m512 qa = _mm512_loadu_ps(&a[i].x);
+				__m512 qb = _mm512_loadu_ps(&b[i].x);
+				__m512 product = _mm512_mul_ps(_mm512_permute_ps(qa, _MM_SHUFFLE(3, 3, 3, 3)), qb);
+				product = _mm512_add_ps(product, _mm512_mul_ps(_mm512_permute_ps(qa, _MM_SHUFFLE(0, 0, 0, 0)),
+					_flipSigns(_mm512_permute_ps(qb, _MM_SHUFFLE(0, 1, 2, 3)), signsX)));
+				product = _mm512_add_ps(product, _mm512_mul_ps(_mm512_permute_ps(qa, _MM_SHUFFLE(1, 1, 1, 1)),
+					_flipSigns(_mm512_permute_ps(qb, _MM_SHUFFLE(1, 0, 3, 2)), signsY)));
+				product = _mm512_add_ps(product, _mm512_mul_ps(_mm512_permute_ps(qa, _MM_SHUFFLE(2, 2, 2, 2)),
+					_flipSigns(_mm512_permute_ps(qb, _MM_SHUFFLE(2, 3, 0, 1)), signsZ)));
+				_mm512_storeu_ps(&result[i].x, product);
+			}
+			for (; i < count; ++i)
+			{
+				multiplyQuaternion4(&a[i].x, &b[i].x, &result[i].x);
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void rotateVector3fAvx512(const Quaternion& quaternion, const Vector3<float>* vectors, Vector3<float>* result, int count)
+		{
+			__m512 qx = _mm512_set1_ps(quaternion.x);
+			__m512 qy = _mm512_set1_ps(quaternion.y);
+			__m512 qz = _mm512_set1_ps(quaternion.z);
+			__m512 qw = _mm512_set1_ps(quaternion.w);
+			int i = 0;
+			// 16 Vector3s at once, deinterleaved to SoA
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512 x;
+				__m512 y;
+				__m512 z;
+				load3(&vectors[i].x, x, y, z);
+				rotate3(qx, qy, qz, qw, x, y, z);
+				store3(&result[i].x, x, y, z);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = quaternion.rotate(vectors[i]);
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void rotateVector3fPairedAvx512(const Quaternion* quaternions, const Vector3<float>* vectors, Vector3<float>* result, int count)
+		{
+			__m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+			int i = 0;
+			// 16 Quaternions and Vector3s at once, a permutation restores the order of the transposed Quaternions
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512 qx;
+				__m512 qy;
+				__m512 qz;
+				__m512 qw;
+				load4(&quaternions[i].x, qx, qy, qz, qw);
+				qx = _mm512_permutexvar_ps(order, qx);
+				qy = _mm512_permutexvar_ps(order, qy);
+				qz = _mm512_permutexvar_ps(order, qz);
+				qw = _mm512_permutexvar_ps(order, qw);
+				__m512 x;
+				__m512 y;
+				__m512 z;
+				load3(&vectors[i].x, x, y, z);
+				rotate3(qx, qy, qz, qw, x, y, z);
+				store3(&result[i].x, x, y, z);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = quaternions[i].rotate(vectors[i]);
+			}
+		}
+		// evaluates the slerp series like _slerpSeries() for 16 factors
+		GTYPES_TARGET_AVX512 static inline __m512 _slerpSeriesAvx512(__m512 squaredFactors, __m512 x)
+		{
+			__m512 one = _mm512_set1_ps(1.0f);
+			__m512 b[SLERP_TERMS];
+			for (int i = 0; i < SLERP_TERMS; ++i)
+			{
+				b[i] = _mm512_mul_ps(_mm512_fmsub_ps(_mm512_set1_ps(slerpU[i]), squaredFactors, _mm512_set1_ps(slerpV[i])), x);
+			}
+			__m512 s0 = _mm512_fmadd_ps(b[0], _mm512_fmadd_ps(b[1], _mm512_add_ps(one, b[2]), one), one);
+			__m512 s1 = _mm512_fmadd_ps(b[4], _mm512_fmadd_ps(b[5], _mm512_add_ps(one, b[6]), one), one);
+			__m512 s2 = _mm512_fmadd_ps(b[8], _mm512_fmadd_ps(b[9], _mm512_fmadd_ps(b[10], _mm512_add_ps(one, b[11]), one), one), one);
+			__m512 p0 = _mm512_mul_ps(_mm512_mul_ps(b[0], b[1]), _mm512_mul_ps(b[2], b[3]));
+			__m512 p1 = _mm512_mul_ps(_mm512_mul_ps(b[4], b[5]), _mm512_mul_ps(b[6], b[7]));
+			return _mm512_fmadd_ps(p0, _mm512_fmadd_ps(p1, s2, s1), s0);
+		}
+
+		// calculates the slerp weights like _slerpWeightsSse2() for 16 Quaternion pairs
+		GTYPES_TARGET_AVX512 static inline void _slerpWeightsAvx512(__m512 dot, __m512 factors, __m512& weightA, __m512& weightB)
+		{
+			__m512 one = _mm512_set1_ps(1.0f);
+			__mmask16 negative = _mm512_cmp_ps_mask(dot, _mm512_setzero_ps(), _CMP_LT_OQ);
+			__m512 x = _mm512_sub_ps(_mm512_min_ps(_mm512_mask_sub_ps(dot, negative, _mm512_setzero_ps(), dot), one), one);
+			__m512 inverseFactors = _mm512_sub_ps(one, factors);
+			weightA = _mm512_mul_ps(inverseFactors, _slerpSeriesAvx512(_mm512_mul_ps(inverseFactors, inverseFactors), x));
+			weightB = _mm512_mul_ps(factors, _slerpSeriesAvx512(_mm512_mul_ps(factors, factors), x));
+			weightB = _mm512_mask_sub_ps(weightB, negative, _mm512_setzero_ps(), weightB);
+		}
+
+		GTYPES_TARGET_AVX512 static void slerpQuaternionAvx512(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			__m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+			int i = 0;
+			// 16 Quaternion pairs at once, the factors are permuted to the order left by load4()
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512 ax;
+				__m512 ay;
+				__m512 az;
+				__m512 aw;
+				__m512 bx;
+				__m512 by;
+				__m512 bz;
+				__m512 bw;
+				load4(&a[i].x, ax, ay, az, aw);
+				load4(&b[i].x, bx, by, bz, bw);
+				__m512 dot = _mm512_fmadd_ps(aw, bw, _mm512_fmadd_ps(az, bz, _mm512_fmadd_ps(ay, by, _mm512_mul_ps(ax, bx))));
+				__m512 weightA;
+				__m512 weightB;
+				_slerpWeightsAvx512(dot, _mm512_permutexvar_ps(order, _mm512_loadu_ps(factors + i)), weightA, weightB);
+				store4(&result[i].x, _mm512_fmadd_ps(bx, weightB, _mm512_mul_ps(ax, weightA)),
+					_mm512_fmadd_ps(by, weightB, _mm512_mul_ps(ay, weightA)),
+					_mm512_fmadd_ps(bz, weightB, _mm512_mul_ps(az, weightA)),
+					_mm512_fmadd_ps(bw, weightB, _mm512_mul_ps(aw, weightA)));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = Quaternion::slerp(a[i], b[i], factors[i]);
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void nlerpQuaternionAvx512(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			__m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+			int i = 0;
+			// 16 Quaternion pairs at once, the factors are permuted to the order left by load4()
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512 ax;
+				__m512 ay;
+				__m512 az;
+				__m512 aw;
+				__m512 bx;
+				__m512 by;
+				__m512 bz;
+				__m512 bw;
+				load4(&a[i].x, ax, ay, az, aw);
+				load4(&b[i].x, bx, by, bz, bw);
+				__m512 dot = _mm512_fmadd_ps(aw, bw, _mm512_fmadd_ps(az, bz, _mm512_fmadd_ps(ay, by, _mm512_mul_ps(ax, bx))));
+				__m512 weightB = _mm512_permutexvar_ps(order, _mm512_loadu_ps(factors + i));
+				__m512 weightA = _mm512_sub_ps(_mm512_set1_ps(1.0f), weightB);
+				weightB = _mm512_mask_sub_ps(weightB, _mm512_cmp_ps_mask(dot, _mm512_setzero_ps(), _CMP_LT_OQ), _mm512_setzero_ps(), weightB);
+				__m512 x = _mm512_fmadd_ps(bx, weightB, _mm512_mul_ps(ax, weightA));
+				__m512 y = _mm512_fmadd_ps(by, weightB, _mm512_mul_ps(ay, weightA));
+				__m512 z = _mm512_fmadd_ps(bz, weightB, _mm512_mul_ps(az, weightA));
+				__m512 w = _mm512_fmadd_ps(bw, weightB, _mm512_mul_ps(aw, weightA));
+				__m512 inverse = rsqrtNonZero(_mm512_fmadd_ps(w, w, _mm512_fmadd_ps(z, z, _mm512_fmadd_ps(y, y, _mm512_mul_ps(x, x)))));
+				store4(&result[i].x, _mm512_mul_ps(x, inverse), _mm512_mul_ps(y, inverse), _mm512_mul_ps(z, inverse), _mm512_mul_ps(w, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = Quaternion::nlerp(a[i], b[i], factors[i]);
+			}
+		}
+
+		// sin() and cos() of 16 angles in radians, same steps as _sinCosSse2() with the swap as blend mask
+		GTYPES_TARGET_AVX512 static inline void _sinCosAvx512(__m512 radians, __m512& sine, __m512& cosine)
+		{
+			__m512i one = _mm512_set1_epi32(1);
+			__m512i two = _mm512_set1_epi32(2);
+			__m512i quadrant = _mm512_cvtps_epi32(_mm512_mul_ps(radians, _mm512_set1_ps(0.636619772f)));
+			__m512 q = _mm512_cvtepi32_ps(quadrant);
+			__m512 r = _mm512_fnmadd_ps(q, _mm512_set1_ps(1.5703125f), radians);
+			r = _mm512_fnmadd_ps(q, _mm512_set1_ps(4.837512969970703125e-4f), r);
+			r = _mm512_fnmadd_ps(q, _mm512_set1_ps(7.54978995489188216e-8f), r);
+			__m512 z = _mm512_mul_ps(r, r);
+			__m512 s = _mm512_fmadd_ps(_mm512_set1_ps(-1.9515295891e-4f), z, _mm512_set1_ps(8.3321608736e-3f));
+			s = _mm512_fmadd_ps(s, z, _mm512_set1_ps(-1.6666654611e-1f));
+			s = _mm512_fmadd_ps(_mm512_mul_ps(r, z), s, r);
+			__m512 c = _mm512_fmadd_ps(_mm512_set1_ps(2.443315711809948e-5f), z, _mm512_set1_ps(-1.388731625493765e-3f));
+			c = _mm512_fmadd_ps(c, z, _mm512_set1_ps(4.166664568298827e-2f));
+			c = _mm512_fmadd_ps(_mm512_mul_ps(z, z), c, _mm512_fnmadd_ps(_mm512_set1_ps(0.5f), z, _mm512_set1_ps(1.0f)));
+			__mmask16 swap = _mm512_test_epi32_mask(quadrant, one);
+			sine = _flipSigns(_mm512_mask_blend_ps(swap, s, c), _mm512_slli_epi32(_mm512_and_si512(quadrant, two), 30));
+			cosine = _flipSigns(_mm512_mask_blend_ps(swap, c, s), _mm512_slli_epi32(_mm512_and_si512(_mm512_add_epi32(quadrant, one), two), 30));
+		}
+
+		// atan2() of 16 coordinate pairs, same steps as _atan2Sse2() with masked subtractions
+		GTYPES_TARGET_AVX512 static inline __m512 _atan2Avx512(__m512 y, __m512 x)
+		{
+			__m512 zero = _mm512_setzero_ps();
+			__m512 absX = _mm512_abs_ps(x);
+			__m512 absY = _mm512_abs_ps(y);
+			__m512 maxValue = _mm512_max_ps(absX, absY);
+			__m512 t = _mm512_maskz_div_ps(_mm512_cmp_ps_mask(maxValue, zero, _CMP_GT_OQ), _mm512_min_ps(absX, absY), maxValue);
+			__m512 s = _mm512_mul_ps(t, t);
+			__m512 result = _mm512_fmadd_ps(_mm512_set1_ps(-0.01172120f), s, _mm512_set1_ps(0.05265332f));
+			result = _mm512_fmadd_ps(result, s, _mm512_set1_ps(-0.11643287f));
+			result = _mm512_fmadd_ps(result, s, _mm512_set1_ps(0.19354346f));
+			result = _mm512_fmadd_ps(result, s, _mm512_set1_ps(-0.33262347f));
+			result = _mm512_fmadd_ps(result, s, _mm512_set1_ps(0.99997726f));
+			result = _mm512_mul_ps(result, t);
+			result = _mm512_mask_sub_ps(result, _mm512_cmp_ps_mask(absY, absX, _CMP_GT_OQ), _mm512_set1_ps(1.57079637f), result);
+			result = _mm512_mask_sub_ps(result, _mm512_cmp_ps_mask(x, zero, _CMP_LT_OQ), _mm512_set1_ps(3.14159274f), result);
+			return _flipSigns(result, _mm512_and_si512(_mm512_castps_si512(y), _mm512_set1_epi32((int)0x80000000u)));
+		}
+
+		GTYPES_TARGET_AVX512 static void fromEulerAnglesQuaternionAvx512(const Vector3<float>* angles, Quaternion* result, int count)
+		{
+			__m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+			__m512i signMask = _mm512_set1_epi32((int)0x80000000u);
+			__m512 half = _mm512_set1_ps(0.5f);
+			int i = 0;
+			// 16 angle triples at once, the halved angles are permuted to the order expected by store4()
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512 yaw;
+				__m512 pitch;
+				__m512 roll;
+				__m512 sy;
+				__m512 cy;
+				__m512 sp;
+				__m512 cp;
+				__m512 sr;
+				__m512 cr;
+				load3(&angles[i].x, yaw, pitch, roll);
+				_sinCosAvx512(_mm512_permutexvar_ps(order, _mm512_mul_ps(yaw, half)), sy, cy);
+				_sinCosAvx512(_mm512_permutexvar_ps(order, _mm512_mul_ps(pitch, half)), sp, cp);
+				_sinCosAvx512(_mm512_permutexvar_ps(order, _mm512_mul_ps(roll, half)), sr, cr);
+				__m512 cycp = _mm512_mul_ps(cy, cp);
+				__m512 sysp = _mm512_mul_ps(sy, sp);
+				__m512 cysp = _mm512_mul_ps(cy, sp);
+				__m512 sycp = _mm512_mul_ps(sy, cp);
+				store4(&result[i].x, _flipSigns(_mm512_fmsub_ps(cysp, cr, _mm512_mul_ps(sycp, sr)), signMask),
+					_flipSigns(_mm512_fmadd_ps(sycp, cr, _mm512_mul_ps(cysp, sr)), signMask),
+					_flipSigns(_mm512_fmadd_ps(cycp, sr, _mm512_mul_ps(sysp, cr)), signMask),
+					_mm512_fmsub_ps(cycp, cr, _mm512_mul_ps(sysp, sr)));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = _fromEulerAnglesFast(angles[i]);
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void toEulerAnglesQuaternionAvx512(const Quaternion* quaternions, Vector3<float>* angles, int count)
+		{
+			// load4() transposes 4x4 blocks, so the same permutation restores the original order
+			__m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+			__m512 one = _mm512_set1_ps(1.0f);
+			__m512 two = _mm512_set1_ps(2.0f);
+			int i = 0;
+			// 16 Quaternions at once, same approach as the AVX2 version
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512 x;
+				__m512 y;
+				__m512 z;
+				__m512 w;
+				load4(&quaternions[i].x, x, y, z, w);
+				__m512 sine = _mm512_mul_ps(two, _mm512_fmsub_ps(y, z, _mm512_mul_ps(w, x)));
+				__m512 xx = _mm512_mul_ps(x, x);
+				__m512 yy = _mm512_mul_ps(y, y);
+				__m512 zz = _mm512_mul_ps(z, z);
+				__m512 xz = _mm512_mul_ps(x, z);
+				__m512 wy = _mm512_mul_ps(w, y);
+				__m512 rollY = _mm512_mul_ps(_mm512_set1_ps(-2.0f), _mm512_fmadd_ps(x, y, _mm512_mul_ps(w, z)));
+				__m512 rollX = _mm512_fnmadd_ps(two, _mm512_add_ps(xx, zz), one);
+				__m512 pitch = _atan2Avx512(sine, _mm512_sqrt_ps(_mm512_fmadd_ps(rollY, rollY, _mm512_mul_ps(rollX, rollX))));
+				__mmask16 lock = _mm512_cmp_ps_mask(_mm512_abs_ps(sine), _mm512_set1_ps(EULER_GIMBAL_LOCK), _CMP_GT_OQ);
+				__m512 yawY = _mm512_mask_blend_ps(lock, _mm512_sub_ps(_mm512_setzero_ps(), _mm512_add_ps(xz, wy)), _mm512_sub_ps(xz, wy));
+				__m512 yawX = _mm512_mask_blend_ps(lock, _mm512_add_ps(xx, yy), _mm512_add_ps(yy, zz));
+				__m512 yaw = _atan2Avx512(_mm512_mul_ps(two, yawY), _mm512_fnmadd_ps(two, yawX, one));
+				__m512 roll = _mm512_maskz_mov_ps((__mmask16)~lock, _atan2Avx512(rollY, rollX));
+				store3(&angles[i].x, _mm512_permutexvar_ps(order, yaw), _mm512_permutexvar_ps(order, pitch), _mm512_permutexvar_ps(order, roll));
+			}
+			for (; i < count; ++i)
+			{
+				angles[i] = _toEulerAnglesFast(quaternions[i]);
+			}
+		}
+
+		template <typename M, int Size>
+		GTYPES_TARGET_AVX512 static void _fromMatrixQuaternionAvx512(const M* matrices, Quaternion* result, int count)
+		{
+			// the offsets of 16 consecutive matrices in the order expected by store4()
+			__m512i offsets = _mm512_mullo_epi32(_mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15), _mm512_set1_epi32(Size * Size));
+			__m512 one = _mm512_set1_ps(1.0f);
+			int i = 0;
+			// 16 matrices at once, same approach as the SSE2 version
+			for (; i + 16 <= count; i += 16)
+			{
+				const float* m = matrices[i].data;
+				__m512 m00 = _mm512_i32gather_ps(offsets, m, 4);
+				__m512 m01 = _mm512_i32gather_ps(offsets, m + 1, 4);
+				__m512 m02 = _mm512_i32gather_ps(offsets, m + 2, 4);
+				__m512 m10 = _mm512_i32gather_ps(offsets, m + Size, 4);
+				__m512 m11 = _mm512_i32gather_ps(offsets, m + Size + 1, 4);
+				__m512 m12 = _mm512_i32gather_ps(offsets, m + Size + 2, 4);
+				__m512 m20 = _mm512_i32gather_ps(offsets, m + Size * 2, 4);
+				__m512 m21 = _mm512_i32gather_ps(offsets, m + Size * 2 + 1, 4);
+				__m512 m22 = _mm512_i32gather_ps(offsets, m + Size * 2 + 2, 4);
+				__m512 tw = _mm512_add_ps(_mm512_add_ps(one, m00), _mm512_add_ps(m11, m22));
+				__m512 tx = _mm512_sub_ps(_mm512_add_ps(one, m00), _mm512_add_ps(m11, m22));
+				__m512 ty = _mm512_sub_ps(_mm512_add_ps(one, m11), _mm512_add_ps(m00, m22));
+				__m512 tz = _mm512_sub_ps(_mm512_add_ps(one, m22), _mm512_add_ps(m00, m11));
+				__m512 wx = _mm512_sub_ps(m21, m12);
+				__m512 wy = _mm512_sub_ps(m02, m20);
+				__m512 wz = _mm512_sub_ps(m10, m01);
+				__m512 xy = _mm512_add_ps(m01, m10);
+				__m512 xz = _mm512_add_ps(m02, m20);
+				__m512 yz = _mm512_add_ps(m12, m21);
+				__m512 maximum = _mm512_max_ps(_mm512_max_ps(tw, tx), _mm512_max_ps(ty, tz));
+				__mmask16 mask = _mm512_cmp_ps_mask(ty, maximum, _CMP_GE_OQ);
+				__m512 x = _mm512_mask_blend_ps(mask, xz, xy);
+				__m512 y = _mm512_mask_blend_ps(mask, yz, ty);
+				__m512 z = _mm512_mask_blend_ps(mask, tz, yz);
+				__m512 w = _mm512_mask_blend_ps(mask, wz, wy);
+				mask = _mm512_cmp_ps_mask(tx, maximum, _CMP_GE_OQ);
+				x = _mm512_mask_blend_ps(mask, x, tx);
+				y = _mm512_mask_blend_ps(mask, y, xy);
+				z = _mm512_mask_blend_ps(mask, z, xz);
+				w = _mm512_mask_blend_ps(mask, w, wx);
+				mask = _mm512_cmp_ps_mask(tw, maximum, _CMP_GE_OQ);
+				x = _mm512_mask_blend_ps(mask, x, wx);
+				y = _mm512_mask_blend_ps(mask, y, wy);
+				z = _mm512_mask_blend_ps(mask, z, wz);
+				w = _mm512_mask_blend_ps(mask, w, tw);
+				__m512 inverse = rsqrtNonZero(_mm512_fmadd_ps(w, w, _mm512_fmadd_ps(z, z, _mm512_fmadd_ps(y, y, _mm512_mul_ps(x, x)))));
+				store4(&result[i].x, _mm512_mul_ps(x, inverse), _mm512_mul_ps(y, inverse), _mm512_mul_ps(z, inverse), _mm512_mul_ps(w, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = _fromMatrix(matrices[i].data, Size);
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void fromMatrix3QuaternionAvx512(const Matrix3* matrices, Quaternion* result, int count)
+		{
+			_fromMatrixQuaternionAvx512<Matrix3, 3>(matrices, result, count);
+		}
+
+		GTYPES_TARGET_AVX512 static void fromMatrix4QuaternionAvx512(const Matrix4* matrices, Quaternion* result, int count)
+		{
+			_fromMatrixQuaternionAvx512<Matrix4, 4>(matrices, result, count);
+		}
+
+		template <bool Exponential>
+		GTYPES_TARGET_AVX512 static void _integrateQuaternionAvx512(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			__m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+			__m512 halfDt = _mm512_set1_ps(0.5f * dt);
+			__m512 one = _mm512_set1_ps(1.0f);
+			int i = 0;
+			// 16 Quaternions at once, the angular velocities are permuted to the order left by load4()
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512 x;
+				__m512 y;
+				__m512 z;
+				__m512 w;
+				__m512 ox;
+				__m512 oy;
+				__m512 oz;
+				load4(&quaternions[i].x, x, y, z, w);
+				load3(&angularVelocities[i].x, ox, oy, oz);
+				ox = _mm512_permutexvar_ps(order, ox);
+				oy = _mm512_permutexvar_ps(order, oy);
+				oz = _mm512_permutexvar_ps(order, oz);
+				__m512 scale = halfDt;
+				__m512 cosine = one;
+				if (Exponential)
+				{
+					__m512 angle = _mm512_mul_ps(_mm512_sqrt_ps(_mm512_fmadd_ps(oz, oz, _mm512_fmadd_ps(oy, oy, _mm512_mul_ps(ox, ox)))), halfDt);
+					__m512 sine;
+					_sinCosAvx512(angle, sine, cosine);
+					__mmask16 nonZero = _mm512_cmp_ps_mask(angle, _mm512_setzero_ps(), _CMP_NEQ_UQ);
+					scale = _mm512_mul_ps(scale, _mm512_mask_div_ps(one, nonZero, sine, angle));
+				}
+				__m512 dx = _mm512_fmsub_ps(ox, w, _mm512_fmsub_ps(oz, y, _mm512_mul_ps(oy, z)));
+				__m512 dy = _mm512_fmsub_ps(oy, w, _mm512_fmsub_ps(ox, z, _mm512_mul_ps(oz, x)));
+				__m512 dz = _mm512_fmsub_ps(oz, w, _mm512_fmsub_ps(oy, x, _mm512_mul_ps(ox, y)));
+				__m512 dw = _mm512_fmadd_ps(oz, z, _mm512_fmadd_ps(oy, y, _mm512_mul_ps(ox, x)));
+				x = _mm512_fmadd_ps(scale, dx, _mm512_mul_ps(cosine, x));
+				y = _mm512_fmadd_ps(scale, dy, _mm512_mul_ps(cosine, y));
+				z = _mm512_fmadd_ps(scale, dz, _mm512_mul_ps(cosine, z));
+				w = _mm512_fnmadd_ps(scale, dw, _mm512_mul_ps(cosine, w));
+				__m512 inverse = rsqrtNonZero(_mm512_fmadd_ps(w, w, _mm512_fmadd_ps(z, z, _mm512_fmadd_ps(y, y, _mm512_mul_ps(x, x)))));
+				store4(&quaternions[i].x, _mm512_mul_ps(x, inverse), _mm512_mul_ps(y, inverse), _mm512_mul_ps(z, inverse), _mm512_mul_ps(w, inverse));
+			}
+			for (; i < count; ++i)
+			{
+				_integrateFast<Exponential>(quaternions[i], angularVelocities[i], 0.5f * dt);
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void integrateQuaternionAvx512(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionAvx512<false>(quaternions, angularVelocities, dt, count);
+		}
+
+		GTYPES_TARGET_AVX512 static void integrateExponentialQuaternionAvx512(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionAvx512<true>(quaternions, angularVelocities, dt, count);
+		}
+#endif
+
+#if defined(GTYPES_SIMD_NEON)
+		static void normalizeFastQuaternionNeon(Quaternion* quaternions, int count)
+		{
+			int i = 0;
+			// 4 Quaternions at once, deinterleaved by the structure load
+			for (; i + 4 <= count; i += 4)
+			{
+				float* data = &quaternions[i].x;
+				float32x4x4_t q = vld4q_f32(data);
+				float32x4_t squaredLengths = vmulq_f32(q.val[0], q.val[0]);
+				squaredLengths = vmlaq_f32(squaredLengths, q.val[1], q.val[1]);
+				squaredLengths = vmlaq_f32(squaredLengths, q.val[2], q.val[2]);
+				squaredLengths = vmlaq_f32(squaredLengths, q.val[3], q.val[3]);
+				float32x4_t inverse = rsqrtNonZero(squaredLengths);
+				q.val[0] = vmulq_f32(q.val[0], inverse);
+				q.val[1] = vmulq_f32(q.val[1], inverse);
+				q.val[2] = vmulq_f32(q.val[2], inverse);
+				q.val[3] = vmulq_f32(q.val[3], inverse);
+				vst4q_f32(data, q);
+			}
+			for (; i < count; ++i)
+			{
+				quaternions[i].normalizeFast();
+			}
+		}
+
+		static void multiplyQuaternionNeon(const Quaternion* a, const Quaternion* b, Quaternion* result, int count)
+		{
+			int i = 0;
+			// 4 Quaternions at once, deinterleaved by the structure loads
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x4_t qa = vld4q_f32(&a[i].x);
+				float32x4x4_t qb = vld4q_f32(&b[i].x);
+				float32x4x4_t product;
+				product.val[0] = vmulq_f32(qa.val[3], qb.val[0]);
+				product.val[0] = vmlaq_f32(product.val[0], qa.val[0], qb.val[3]);
+				product.val[0] = vmlaq_f32(product.val[0], qa.val[1], qb.val[2]);
+				product.val[0] = vmlsq_f32(product.val[0], qa.val[2], qb.val[1]);
+				product.val[1] = vmulq_f32(qa.val[3], qb.val[1]);
+				product.val[1] = vmlsq_f32(product.val[1], qa.val[0], qb.val[2]);
+				product.val[1] = vmlaq_f32(product.val[1], qa.val[1], qb.val[3]);
+				product.val[1] = vmlaq_f32(product.val[1], qa.val[2], qb.val[0]);
+				product.val[2] = vmulq_f32(qa.val[3], qb.val[2]);
+				product.val[2] = vmlaq_f32(product.val[2], qa.val[0], qb.val[1]);
+				product.val[2] = vmlsq_f32(product.val[2], qa.val[1], qb.val[0]);
+				product.val[2] = vmlaq_f32(product.val[2], qa.val[2], qb.val[3]);
+				product.val[3] = vmulq_f32(qa.val[3], qb.val[3]);
+				product.val[3] = vmlsq_f32(product.val[3], qa.val[0], qb.val[0]);
+				product.val[3] = vmlsq_f32(product.val[3], qa.val[1], qb.val[1]);
+				product.val[3] = vmlsq_f32(product.val[3], qa.val[2], qb.val[2]);
+				vst4q_f32(&result[i].x, product);
+			}
+			for (; i < count; ++i)
+			{
+				multiplyQuaternion4(&a[i].x, &b[i].x, &result[i].x);
+			}
+		}
+
+		static void rotateVector3fNeon(const Quaternion& quaternion, const Vector3<float>* vectors, Vector3<float>* result, int count)
+		{
+			float32x4_t qx = vdupq_n_f32(quaternion.x);
+			float32x4_t qy = vdupq_n_f32(quaternion.y);
+			float32x4_t qz = vdupq_n_f32(quaternion.z);
+			float32x4_t qw = vdupq_n_f32(quaternion.w);
+			int i = 0;
+			// 4 Vector3s at once, deinterleaved by the structure load
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x3_t v = vld3q_f32(&vectors[i].x);
+				rotate3(qx, qy, qz, qw, v);
+				vst3q_f32(&result[i].x, v);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = quaternion.rotate(vectors[i]);
+			}
+		}
+
+		static void rotateVector3fPairedNeon(const Quaternion* quaternions, const Vector3<float>* vectors, Vector3<float>* result, int count)
+		{
+			int i = 0;
+			// 4 Quaternions and Vector3s at once, deinterleaved by the structure loads
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x4_t q = vld4q_f32(&quaternions[i].x);
+				float32x4x3_t v = vld3q_f32(&vectors[i].x);
+				rotate3(q.val[0], q.val[1], q.val[2], q.val[3], v);
+				vst3q_f32(&result[i].x, v);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = quaternions[i].rotate(vectors[i]);
+			}
+		}
+		// evaluates the slerp series like _slerpSeries() for 4 factors
+		static inline float32x4_t _slerpSeriesNeon(float32x4_t squaredFactors, float32x4_t x)
+		{
+			float32x4_t one = vdupq_n_f32(1.0f);
+			float32x4_t b[SLERP_TERMS];
+			for (int i = 0; i < SLERP_TERMS; ++i)
+			{
+				b[i] = vmulq_f32(vsubq_f32(vmulq_n_f32(squaredFactors, slerpU[i]), vdupq_n_f32(slerpV[i])), x);
+			}
+			float32x4_t s0 = vmlaq_f32(one, b[0], vmlaq_f32(one, b[1], vaddq_f32(one, b[2])));
+			float32x4_t s1 = vmlaq_f32(one, b[4], vmlaq_f32(one, b[5], vaddq_f32(one, b[6])));
+			float32x4_t s2 = vmlaq_f32(one, b[8], vmlaq_f32(one, b[9], vmlaq_f32(one, b[10], vaddq_f32(one, b[11]))));
+			float32x4_t p0 = vmulq_f32(vmulq_f32(b[0], b[1]), vmulq_f32(b[2], b[3]));
+			float32x4_t p1 = vmulq_f32(vmulq_f32(b[4], b[5]), vmulq_f32(b[6], b[7]));
+			return vmlaq_f32(s0, p0, vmlaq_f32(s1, p1, s2));
+		}
+
+		// calculates the slerp weights like _slerpWeightsSse2() for 4 Quaternion pairs
+		static inline void _slerpWeightsNeon(float32x4_t dot, float32x4_t factors, float32x4_t& weightA, float32x4_t& weightB)
+		{
+			float32x4_t one = vdupq_n_f32(1.0f);
+			uint32x4_t sign = vandq_u32(vcltq_f32(dot, vdupq_n_f32(0.0f)), vdupq_n_u32(0x80000000u));
+			float32x4_t x = vsubq_f32(vminq_f32(vabsq_f32(dot), one), one);
+			float32x4_t inverseFactors = vsubq_f32(one, factors);
+			weightA = vmulq_f32(inverseFactors, _slerpSeriesNeon(vmulq_f32(inverseFactors, inverseFactors), x));
+			weightB = vmulq_f32(factors, _slerpSeriesNeon(vmulq_f32(factors, factors), x));
+			weightB = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(weightB), sign));
+		}
+
+		static void slerpQuaternionNeon(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			int i = 0;
+			// 4 Quaternion pairs at once, deinterleaved by the structure loads
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x4_t qa = vld4q_f32(&a[i].x);
+				float32x4x4_t qb = vld4q_f32(&b[i].x);
+				float32x4_t dot = vmulq_f32(qa.val[0], qb.val[0]);
+				dot = vmlaq_f32(dot, qa.val[1], qb.val[1]);
+				dot = vmlaq_f32(dot, qa.val[2], qb.val[2]);
+				dot = vmlaq_f32(dot, qa.val[3], qb.val[3]);
+				float32x4_t weightA;
+				float32x4_t weightB;
+				_slerpWeightsNeon(dot, vld1q_f32(factors + i), weightA, weightB);
+				for (int j = 0; j < 4; ++j)
+				{
+					qa.val[j] = vmlaq_f32(vmulq_f32(qa.val[j], weightA), qb.val[j], weightB);
+				}
+				vst4q_f32(&result[i].x, qa);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = Quaternion::slerp(a[i], b[i], factors[i]);
+			}
+		}
+
+		static void nlerpQuaternionNeon(const Quaternion* a, const Quaternion* b, const float* factors, Quaternion* result, int count)
+		{
+			int i = 0;
+			// 4 Quaternion pairs at once, deinterleaved by the structure loads
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x4_t qa = vld4q_f32(&a[i].x);
+				float32x4x4_t qb = vld4q_f32(&b[i].x);
+				float32x4_t dot = vmulq_f32(qa.val[0], qb.val[0]);
+				dot = vmlaq_f32(dot, qa.val[1], qb.val[1]);
+				dot = vmlaq_f32(dot, qa.val[2], qb.val[2]);
+				dot = vmlaq_f32(dot, qa.val[3], qb.val[3]);
+				float32x4_t factor = vld1q_f32(factors + i);
+				float32x4_t weightA = vsubq_f32(vdupq_n_f32(1.0f), factor);
+				float32x4_t weightB = vbslq_f32(vcltq_f32(dot, vdupq_n_f32(0.0f)), vnegq_f32(factor), factor);
+				float32x4_t squaredLengths = vdupq_n_f32(0.0f);
+				for (int j = 0; j < 4; ++j)
+				{
+					qa.val[j] = vmlaq_f32(vmulq_f32(qa.val[j], weightA), qb.val[j], weightB);
+					squaredLengths = vmlaq_f32(squaredLengths, qa.val[j], qa.val[j]);
+				}
+				float32x4_t inverse = rsqrtNonZero(squaredLengths);
+				for (int j = 0; j < 4; ++j)
+				{
+					qa.val[j] = vmulq_f32(qa.val[j], inverse);
+				}
+				vst4q_f32(&result[i].x, qa);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = Quaternion::nlerp(a[i], b[i], factors[i]);
+			}
+		}
+
+		// a / b, ARMv7 has no vector division so the reciprocal estimate is refined twice
+		static inline float32x4_t _divide(float32x4_t a, float32x4_t b)
+		{
+#if defined(__aarch64__) || defined(_M_ARM64)
+			return vdivq_f32(a, b);
+#else
+			float32x4_t inverse = vrecpeq_f32(b);
+			inverse = vmulq_f32(inverse, vrecpsq_f32(b, inverse));
+			inverse = vmulq_f32(inverse, vrecpsq_f32(b, inverse));
+			return vmulq_f32(a, inverse);
+#endif
+		}
+
+		// sin() and cos() of 4 angles in radians, same steps as _sinCosSse2()
+		static inline void _sinCosNeon(float32x4_t radians, float32x4_t& sine, float32x4_t& cosine)
+		{
+			int32x4_t one = vdupq_n_s32(1);
+			int32x4_t two = vdupq_n_s32(2);
+			float32x4_t scaled = vmulq_n_f32(radians, 0.636619772f);
+			// the conversion truncates, rounding away from 0 like _sinCosFast()
+			int32x4_t quadrant = vcvtq_s32_f32(vaddq_f32(scaled, vbslq_f32(vcltq_f32(scaled, vdupq_n_f32(0.0f)), vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f))));
+			float32x4_t q = vcvtq_f32_s32(quadrant);
+			float32x4_t r = vmlsq_n_f32(radians, q, 1.5703125f);
+			r = vmlsq_n_f32(r, q, 4.837512969970703125e-4f);
+			r = vmlsq_n_f32(r, q, 7.54978995489188216e-8f);
+			float32x4_t z = vmulq_f32(r, r);
+			float32x4_t s = vmlaq_f32(vdupq_n_f32(8.3321608736e-3f), vdupq_n_f32(-1.9515295891e-4f), z);
+			s = vmlaq_f32(vdupq_n_f32(-1.6666654611e-1f), s, z);
+			s = vmlaq_f32(r, vmulq_f32(r, z), s);
+			float32x4_t c = vmlaq_f32(vdupq_n_f32(-1.388731625493765e-3f), vdupq_n_f32(2.443315711809948e-5f), z);
+			c = vmlaq_f32(vdupq_n_f32(4.166664568298827e-2f), c, z);
+			c = vmlaq_f32(vmlsq_n_f32(vdupq_n_f32(1.0f), z, 0.5f), vmulq_f32(z, z), c);
+			uint32x4_t swap = vtstq_s32(quadrant, one);
+			uint32x4_t sinSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(quadrant, two)), 30);
+			uint32x4_t cosSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(vaddq_s32(quadrant, one), two)), 30);
+			sine = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, c, s)), sinSign));
+			cosine = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, s, c)), cosSign));
+		}
+
+		// atan2() of 4 coordinate pairs, same steps as _atan2Sse2()
+		static inline float32x4_t _atan2Neon(float32x4_t y, float32x4_t x)
+		{
+			float32x4_t zero = vdupq_n_f32(0.0f);
+			float32x4_t absX = vabsq_f32(x);
+			float32x4_t absY = vabsq_f32(y);
+			float32x4_t maxValue = vmaxq_f32(absX, absY);
+			uint32x4_t nonZero = vcgtq_f32(maxValue, zero);
+			float32x4_t t = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(_divide(vminq_f32(absX, absY), maxValue)), nonZero));
+			float32x4_t s = vmulq_f32(t, t);
+			float32x4_t result = vmlaq_f32(vdupq_n_f32(0.05265332f), vdupq_n_f32(-0.01172120f), s);
+			result = vmlaq_f32(vdupq_n_f32(-0.11643287f), result, s);
+			result = vmlaq_f32(vdupq_n_f32(0.19354346f), result, s);
+			result = vmlaq_f32(vdupq_n_f32(-0.33262347f), result, s);
+			result = vmlaq_f32(vdupq_n_f32(0.99997726f), result, s);
+			result = vmulq_f32(result, t);
+			result = vbslq_f32(vcgtq_f32(absY, absX), vsubq_f32(vdupq_n_f32(1.57079637f), result), result);
+			result = vbslq_f32(vcltq_f32(x, zero), vsubq_f32(vdupq_n_f32(3.14159274f), result), result);
+			return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(result), vandq_u32(vreinterpretq_u32_f32(y), vdupq_n_u32(0x80000000u))));
+		}
+
+		static void fromEulerAnglesQuaternionNeon(const Vector3<float>* angles, Quaternion* result, int count)
+		{
+			int i = 0;
+			// 4 angle triples at once, deinterleaved by the structure load
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x3_t v = vld3q_f32(&angles[i].x);
+				float32x4_t sy;
+				float32x4_t cy;
+				float32x4_t sp;
+				float32x4_t cp;
+				float32x4_t sr;
+				float32x4_t cr;
+				_sinCosNeon(vmulq_n_f32(v.val[0], 0.5f), sy, cy);
+				_sinCosNeon(vmulq_n_f32(v.val[1], 0.5f), sp, cp);
+				_sinCosNeon(vmulq_n_f32(v.val[2], 0.5f), sr, cr);
+				float32x4_t cycp = vmulq_f32(cy, cp);
+				float32x4_t sysp = vmulq_f32(sy, sp);
+				float32x4_t cysp = vmulq_f32(cy, sp);
+				float32x4_t sycp = vmulq_f32(sy, cp);
+				float32x4x4_t q;
+				q.val[0] = vmlsq_f32(vmulq_f32(sycp, sr), cysp, cr);
+				q.val[1] = vnegq_f32(vmlaq_f32(vmulq_f32(cysp, sr), sycp, cr));
+				q.val[2] = vnegq_f32(vmlaq_f32(vmulq_f32(sysp, cr), cycp, sr));
+				q.val[3] = vmlsq_f32(vmulq_f32(cycp, cr), sysp, sr);
+				vst4q_f32(&result[i].x, q);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = _fromEulerAnglesFast(angles[i]);
+			}
+		}
+
+		static void toEulerAnglesQuaternionNeon(const Quaternion* quaternions, Vector3<float>* angles, int count)
+		{
+			float32x4_t one = vdupq_n_f32(1.0f);
+			int i = 0;
+			// 4 Quaternions at once, same approach as the SSE2 version
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x4_t q = vld4q_f32(&quaternions[i].x);
+				float32x4_t x = q.val[0];
+				float32x4_t y = q.val[1];
+				float32x4_t z = q.val[2];
+				float32x4_t w = q.val[3];
+				float32x4_t sine = vmulq_n_f32(vmlsq_f32(vmulq_f32(y, z), w, x), 2.0f);
+				float32x4_t xx = vmulq_f32(x, x);
+				float32x4_t yy = vmulq_f32(y, y);
+				float32x4_t zz = vmulq_f32(z, z);
+				float32x4_t xz = vmulq_f32(x, z);
+				float32x4_t wy = vmulq_f32(w, y);
+				float32x4_t rollY = vmulq_n_f32(vmlaq_f32(vmulq_f32(w, z), x, y), -2.0f);
+				float32x4_t rollX = vmlsq_n_f32(one, vaddq_f32(xx, zz), 2.0f);
+				float32x4_t squaredCosine = vmlaq_f32(vmulq_f32(rollX, rollX), rollY, rollY);
+#if defined(__aarch64__) || defined(_M_ARM64)
+				float32x4_t cosine = vsqrtq_f32(squaredCosine);
+#else
+				float32x4_t cosine = vmulq_f32(squaredCosine, rsqrtNonZero(squaredCosine));
+#endif
+				float32x4x3_t v;
+				v.val[1] = _atan2Neon(sine, cosine);
+				uint32x4_t lock = vcgtq_f32(vabsq_f32(sine), vdupq_n_f32(EULER_GIMBAL_LOCK));
+				float32x4_t yawY = vbslq_f32(lock, vsubq_f32(xz, wy), vnegq_f32(vaddq_f32(xz, wy)));
+				float32x4_t yawX = vbslq_f32(lock, vaddq_f32(yy, zz), vaddq_f32(xx, yy));
+				v.val[0] = _atan2Neon(vmulq_n_f32(yawY, 2.0f), vmlsq_n_f32(one, yawX, 2.0f));
+				v.val[2] = vbslq_f32(lock, vdupq_n_f32(0.0f), _atan2Neon(rollY, rollX));
+				vst3q_f32(&angles[i].x, v);
+			}
+			for (; i < count; ++i)
+			{
+				angles[i] = _toEulerAnglesFast(quaternions[i]);
+			}
+		}
+
+		// the element (row, column) of 4 consecutive matrices with Size rows and columns
+		template <int Size>
+		static inline float32x4_t _gatherNeon(const float* data, int row, int column)
+		{
+			const float* m = data + row * Size + column;
+			float values[4] = { m[0], m[Size * Size], m[Size * Size * 2], m[Size * Size * 3] };
+			return vld1q_f32(values);
+		}
+
+		template <typename M, int Size>
+		static void _fromMatrixQuaternionNeon(const M* matrices, Quaternion* result, int count)
+		{
+			float32x4_t one = vdupq_n_f32(1.0f);
+			int i = 0;
+			// 4 matrices at once, same approach as the SSE2 version
+			for (; i + 4 <= count; i += 4)
+			{
+				const float* m = matrices[i].data;
+				float32x4_t m00 = _gatherNeon<Size>(m, 0, 0);
+				float32x4_t m01 = _gatherNeon<Size>(m, 0, 1);
+				float32x4_t m02 = _gatherNeon<Size>(m, 0, 2);
+				float32x4_t m10 = _gatherNeon<Size>(m, 1, 0);
+				float32x4_t m11 = _gatherNeon<Size>(m, 1, 1);
+				float32x4_t m12 = _gatherNeon<Size>(m, 1, 2);
+				float32x4_t m20 = _gatherNeon<Size>(m, 2, 0);
+				float32x4_t m21 = _gatherNeon<Size>(m, 2, 1);
+				float32x4_t m22 = _gatherNeon<Size>(m, 2, 2);
+				float32x4_t tw = vaddq_f32(vaddq_f32(one, m00), vaddq_f32(m11, m22));
+				float32x4_t tx = vsubq_f32(vaddq_f32(one, m00), vaddq_f32(m11, m22));
+				float32x4_t ty = vsubq_f32(vaddq_f32(one, m11), vaddq_f32(m00, m22));
+				float32x4_t tz = vsubq_f32(vaddq_f32(one, m22), vaddq_f32(m00, m11));
+				float32x4_t wx = vsubq_f32(m21, m12);
+				float32x4_t wy = vsubq_f32(m02, m20);
+				float32x4_t wz = vsubq_f32(m10, m01);
+				float32x4_t xy = vaddq_f32(m01, m10);
+				float32x4_t xz = vaddq_f32(m02, m20);
+				float32x4_t yz = vaddq_f32(m12, m21);
+				float32x4_t maximum = vmaxq_f32(vmaxq_f32(tw, tx), vmaxq_f32(ty, tz));
+				uint32x4_t mask = vcgeq_f32(ty, maximum);
+				float32x4_t x = vbslq_f32(mask, xy, xz);
+				float32x4_t y = vbslq_f32(mask, ty, yz);
+				float32x4_t z = vbslq_f32(mask, yz, tz);
+				float32x4_t w = vbslq_f32(mask, wy, wz);
+				mask = vcgeq_f32(tx, maximum);
+				x = vbslq_f32(mask, tx, x);
+				y = vbslq_f32(mask, xy, y);
+				z = vbslq_f32(mask, xz, z);
+				w = vbslq_f32(mask, wx, w);
+				mask = vcgeq_f32(tw, maximum);
+				x = vbslq_f32(mask, wx, x);
+				y = vbslq_f32(mask, wy, y);
+				z = vbslq_f32(mask, wz, z);
+				w = vbslq_f32(mask, tw, w);
+				float32x4_t inverse = rsqrtNonZero(vmlaq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(x, x), y, y), z, z), w, w));
+				float32x4x4_t q;
+				q.val[0] = vmulq_f32(x, inverse);
+				q.val[1] = vmulq_f32(y, inverse);
+				q.val[2] = vmulq_f32(z, inverse);
+				q.val[3] = vmulq_f32(w, inverse);
+				vst4q_f32(&result[i].x, q);
+			}
+			for (; i < count; ++i)
+			{
+				result[i] = _fromMatrix(matrices[i].data, Size);
+			}
+		}
+
+		static void fromMatrix3QuaternionNeon(const Matrix3* matrices, Quaternion* result, int count)
+		{
+			_fromMatrixQuaternionNeon<Matrix3, 3>(matrices, result, count);
+		}
+
+		static void fromMatrix4QuaternionNeon(const Matrix4* matrices, Quaternion* result, int count)
+		{
+			_fromMatrixQuaternionNeon<Matrix4, 4>(matrices, result, count);
+		}
+
+		template <bool Exponential>
+		static void _integrateQuaternionNeon(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			float halfDt = 0.5f * dt;
+			float32x4_t one = vdupq_n_f32(1.0f);
+			int i = 0;
+			// 4 Quaternions at once, same approach as the SSE2 version
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x4_t q = vld4q_f32(&quaternions[i].x);
+				float32x4x3_t omega = vld3q_f32(&angularVelocities[i].x);
+				float32x4_t x = q.val[0];
+				float32x4_t y = q.val[1];
+				float32x4_t z = q.val[2];
+				float32x4_t w = q.val[3];
+				float32x4_t ox = omega.val[0];
+				float32x4_t oy = omega.val[1];
+				float32x4_t oz = omega.val[2];
+				float32x4_t scale = vdupq_n_f32(halfDt);
+				float32x4_t cosine = one;
+				if (Exponential)
+				{
+					float32x4_t squaredLength = vmlaq_f32(vmlaq_f32(vmulq_f32(ox, ox), oy, oy), oz, oz);
+#if defined(__aarch64__) || defined(_M_ARM64)
+					float32x4_t angle = vmulq_n_f32(vsqrtq_f32(squaredLength), halfDt);
+#else
+					float32x4_t angle = vmulq_n_f32(vmulq_f32(squaredLength, rsqrtNonZero(squaredLength)), halfDt);
+#endif
+					float32x4_t sine;
+					_sinCosNeon(angle, sine, cosine);
+					uint32x4_t isZero = vceqq_f32(angle, vdupq_n_f32(0.0f));
+					scale = vmulq_f32(scale, vbslq_f32(isZero, one, _divide(sine, vbslq_f32(isZero, one, angle))));
+				}
+				float32x4_t dx = vmlsq_f32(vmlaq_f32(vmulq_f32(ox, w), oy, z), oz, y);
+				float32x4_t dy = vmlsq_f32(vmlaq_f32(vmulq_f32(oy, w), oz, x), ox, z);
+				float32x4_t dz = vmlsq_f32(vmlaq_f32(vmulq_f32(oz, w), ox, y), oy, x);
+				float32x4_t dw = vmlaq_f32(vmlaq_f32(vmulq_f32(ox, x), oy, y), oz, z);
+				x = vmlaq_f32(vmulq_f32(cosine, x), scale, dx);
+				y = vmlaq_f32(vmulq_f32(cosine, y), scale, dy);
+				z = vmlaq_f32(vmulq_f32(cosine, z), scale, dz);
+				w = vmlsq_f32(vmulq_f32(cosine, w), scale, dw);
+				float32x4_t inverse = rsqrtNonZero(vmlaq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(x, x), y, y), z, z), w, w));
+				q.val[0] = vmulq_f32(x, inverse);
+				q.val[1] = vmulq_f32(y, inverse);
+				q.val[2] = vmulq_f32(z, inverse);
+				q.val[3] = vmulq_f32(w, inverse);
+				vst4q_f32(&quaternions[i].x, q);
+			}
+			for (; i < count; ++i)
+			{
+				_integrateFast<Exponential>(quaternions[i], angularVelocities[i], halfDt);
+			}
+		}
+
+		static void integrateQuaternionNeon(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionNeon<false>(quaternions, angularVelocities, dt, count);
+		}
+
+		static void integrateExponentialQuaternionNeon(Quaternion* quaternions, const Vector3<float>* angularVelocities, float dt, int count)
+		{
+			_integrateQuaternionNeon<true>(quaternions, angularVelocities, dt, count);
+		}
+#endif
+
+		void registerQuaternionKernels(Kernels& kernels, Level level)
+		{
+			switch (level)
+			{
+			case LevelScalar:
+				kernels.normalizeFastQuaternion = &normalizeFastQuaternionScalar;
+				kernels.multiplyQuaternion = &multiplyQuaternionScalar;
+				kernels.slerpQuaternion = &slerpQuaternionScalar;
+				kernels.nlerpQuaternion = &nlerpQuaternionScalar;
+				kernels.fromEulerAnglesQuaternion = &fromEulerAnglesQuaternionScalar;
+				kernels.toEulerAnglesQuaternion = &toEulerAnglesQuaternionScalar;
+				kernels.fromMatrix3Quaternion = &fromMatrix3QuaternionScalar;
+				kernels.fromMatrix4Quaternion = &fromMatrix4QuaternionScalar;
+				kernels.integrateQuaternion = &integrateQuaternionScalar;
+				kernels.integrateExponentialQuaternion = &integrateExponentialQuaternionScalar;
+				kernels.rotateVector3f = &rotateVector3fScalar;
+				kernels.rotateVector3fPaired = &rotateVector3fPairedScalar;
+				break;
+#if defined(GTYPES_SIMD_SSE)
+			case LevelSse2:
+				kernels.normalizeFastQuaternion = &normalizeFastQuaternionSse2;
+				kernels.multiplyQuaternion = &multiplyQuaternionSse2;
+				kernels.slerpQuaternion = &slerpQuaternionSse2;
+				kernels.nlerpQuaternion = &nlerpQuaternionSse2;
+				kernels.fromEulerAnglesQuaternion = &fromEulerAnglesQuaternionSse2;
+				kernels.toEulerAnglesQuaternion = &toEulerAnglesQuaternionSse2;
+				kernels.fromMatrix3Quaternion = &fromMatrix3QuaternionSse2;
+				kernels.fromMatrix4Quaternion = &fromMatrix4QuaternionSse2;
+				kernels.integrateQuaternion = &integrateQuaternionSse2;
+				kernels.integrateExponentialQuaternion = &integrateExponentialQuaternionSse2;
+				kernels.rotateVector3f = &rotateVector3fSse2;
+				kernels.rotateVector3fPaired = &rotateVector3fPairedSse2;
+				break;
+			case LevelAvx2:
+				kernels.normalizeFastQuaternion = &normalizeFastQuaternionAvx2;
+				kernels.multiplyQuaternion = &multiplyQuaternionAvx2;
+				kernels.slerpQuaternion = &slerpQuaternionAvx2;
+				kernels.nlerpQuaternion = &nlerpQuaternionAvx2;
+				kernels.fromEulerAnglesQuaternion = &fromEulerAnglesQuaternionAvx2;
+				kernels.toEulerAnglesQuaternion = &toEulerAnglesQuaternionAvx2;
+				kernels.fromMatrix3Quaternion = &fromMatrix3QuaternionAvx2;
+				kernels.fromMatrix4Quaternion = &fromMatrix4QuaternionAvx2;
+				kernels.integrateQuaternion = &integrateQuaternionAvx2;
+				kernels.integrateExponentialQuaternion = &integrateExponentialQuaternionAvx2;
+				break;
+#endif
+#if defined(GTYPES_SIMD_AVX512)
+			case LevelAvx512:
+				kernels.normalizeFastQuaternion = &normalizeFastQuaternionAvx512;
+				kernels.multiplyQuaternion = &multiplyQuaternionAvx512;
+				kernels.slerpQuaternion = &slerpQuaternionAvx512;
+				kernels.nlerpQuaternion = &nlerpQuaternionAvx512;
+				kernels.fromEulerAnglesQuaternion = &fromEulerAnglesQuaternionAvx512;
+				kernels.toEulerAnglesQuaternion = &toEulerAnglesQuaternionAvx512;
+				kernels.fromMatrix3Quaternion = &fromMatrix3QuaternionAvx512;
+				kernels.fromMatrix4Quaternion = &fromMatrix4QuaternionAvx512;
+				kernels.integrateQuaternion = &integrateQuaternionAvx512;
+				kernels.integrateExponentialQuaternion = &integrateExponentialQuaternionAvx512;
+				kernels.rotateVector3f = &rotateVector3fAvx512;
+				kernels.rotateVector3fPaired = &rotateVector3fPairedAvx512;
+				break;
+#endif
+#if defined(GTYPES_SIMD_NEON)
+			case LevelNeon:
+				kernels.normalizeFastQuaternion = &normalizeFastQuaternionNeon;
+				kernels.multiplyQuaternion = &multiplyQuaternionNeon;
+				kernels.slerpQuaternion = &slerpQuaternionNeon;
+				kernels.nlerpQuaternion = &nlerpQuaternionNeon;
+				kernels.fromEulerAnglesQuaternion = &fromEulerAnglesQuaternionNeon;
+				kernels.toEulerAnglesQuaternion = &toEulerAnglesQuaternionNeon;
+				kernels.fromMatrix3Quaternion = &fromMatrix3QuaternionNeon;
+				kernels.fromMatrix4Quaternion = &fromMatrix4QuaternionNeon;
+				kernels.integrateQuaternion = &integrateQuaternionNeon;
+				kernels.integrateExponentialQuaternion = &integrateExponentialQuaternionNeon;
+				kernels.rotateVector3f = &rotateVector3fNeon;
+				kernels.rotateVector3fPaired = &rotateVector3fPairedNeon;
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+
+	}
+
 }
@@ -0,0 +1,377 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <algorithm>
+#include <vector>
+
+#include "Rectangle.h"
+#include "RectPacker.h"
+#include "RectQuadtree.h"
+#include "Vector2.h"
+
+namespace gtypes
+{
+	// orders Rectangles by their longer side, then by their shorter side, both descending; the index keeps it deterministic
+	struct _SizeOrder
+	{
+		const Vector2<int>* sizes;
+
+		inline bool operator()(int a, int b) const
+		{
+			int longA = std::max(this->sizes[a].x, this->sizes[a].y);
+			int longB = std::max(this->sizes[b].x, this->sizes[b].y);
+			if (longA != longB)
+			{
+				return (longA > longB);
+			}
+			int shortA = std::min(this->sizes[a].x, this->sizes[a].y);
+			int shortB = std::min(this->sizes[b].x, this->sizes[b].y);
+			return (shortA != shortB ? shortA > shortB : a < b);
+		}
+	};
+
+	// length of the overlap of two ranges, 0 if they do not overlap
+	static inline int _overlap(int start1, int end1, int start2, int end2)
+	{
+		int result = std::min(end1, end2) - std::max(start1, start2);
+		return (result > 0 ? result : 0);
+	}
+
+	RectPacker::RectPacker(int width, int height, Method method, bool rotationAllowed) : width(0), height(0), method(method),
+		rotationAllowed(rotationAllowed), count(0), usedArea(0), usedRight(0), usedBottom(0)
+	{
+		this->reset(width, height);
+	}
+
+	float RectPacker::getOccupancy() const
+	{
+		long long area = (long long)this->width * this->height;
+		return (area > 0 ? (float)((double)this->usedArea / area) : 0.0f);
+	}
+
+	float RectPacker::getUsedBoundsOccupancy() const
+	{
+		long long area = (long long)this->usedRight * this->usedBottom;
+		return (area > 0 ? (float)((double)this->usedArea / area) : 0.0f);
+	}
+
+	void RectPacker::reset(int width, int height)
+	{
+		this->width = (width > 0 ? width : 0);
+		this->height = (height > 0 ? height : 0);
+		this->count = 0;
+		this->usedArea = 0;
+		this->usedRight = 0;
+		this->usedBottom = 0;
+		this->freeRectangles.clear();
+		this->skyline.clear();
+		this->_usedRectangles.reset(Rectangle<int>(0, 0, this->width, this->height), 8);
+		if (this->width == 0 || this->height == 0)
+		{
+			return;
+		}
+		this->freeRectangles.push_back(Rectangle<int>(0, 0, this->width, this->height));
+		SkylineNode node;
+		node.x = 0;
+		node.y = 0;
+		node.width = this->width;
+		this->skyline.push_back(node);
+	}
+
+	void RectPacker::reset(int width, int height, Method method)
+	{
+		this->method = method;
+		this->reset(width, height);
+	}
+
+	bool RectPacker::insert(int width, int height, Rectangle<int>& result)
+	{
+		result = Rectangle<int>();
+		if (width <= 0 || height <= 0)
+		{
+			return false;
+		}
+		int index = 0;
+		if (this->method == MethodSkyline)
+		{
+			if (!this->_findSkyline(width, height, result, index))
+			{
+				return false;
+			}
+			this->_placeSkyline(index, result);
+		}
+		else
+		{
+			if (!this->_findMaxRects(width, height, result))
+			{
+				return false;
+			}
+			this->_placeMaxRects(result);
+			// only the contact heuristic needs to look up neighbors
+			if (this->method == MethodMaxRectsContactPoint)
+			{
+				this->_usedRectangles.insert(result);
+			}
+		}
+		++this->count;
+		this->usedArea += (long long)result.w * result.h;
+		this->usedRight = std::max(this->usedRight, result.x + result.w);
+		this->usedBottom = std::max(this->usedBottom, result.y + result.h);
+		return true;
+	}
+
+	int RectPacker::insert(const Vector2<int>* sizes, int count, Rectangle<int>* results)
+	{
+		if (count <= 0)
+		{
+			return 0;
+		}
+		std::vector<int> order(count);
+		for (int i = 0; i < count; ++i)
+		{
+			order[i] = i;
+		}
+		_SizeOrder sizeOrder;
+		sizeOrder.sizes = sizes;
+		std::sort(order.begin(), order.end(), sizeOrder);
+		int result = 0;
+		for (int i = 0; i < count; ++i)
+		{
+			if (this->insert(sizes[order[i]].x, sizes[order[i]].y, results[order[i]]))
+			{
+				++result;
+			}
+		}
+		return result;
+	}
+
+	bool RectPacker::_findMaxRects(int width, int height, Rectangle<int>& result)
+	{
+		// lower scores are better, the contact heuristic negates its score
+		int bestScore = 0;
+		int bestSecondScore = 0;
+		bool found = false;
+		Rectangle<int> candidate;
+		int score = 0;
+		int secondScore = 0;
+		int size = (int)this->freeRectangles.size();
+		for (int i = 0; i < size; ++i)
+		{
+			const Rectangle<int>& space = this->freeRectangles[i];
+			for (int rotated = 0; rotated < 2; ++rotated)
+			{
+				if (rotated == 1 && (!this->rotationAllowed || width == height))
+				{
+					break;
+				}
+				candidate.set(space.x, space.y, (rotated == 0 ? width : height), (rotated == 0 ? height : width));
+				if (candidate.w > space.w || candidate.h > space.h)
+				{
+					continue;
+				}
+				secondScore = std::min(space.w - candidate.w, space.h - candidate.h);
+				if (this->method == MethodMaxRectsContactPoint)
+				{
+					score = -this->_calcContact(candidate);
+				}
+				else
+				{
+					score = secondScore;
+					secondScore = std::max(space.w - candidate.w, space.h - candidate.h);
+				}
+				if (!found || score < bestScore || (score == bestScore && secondScore < bestSecondScore))
+				{
+					found = true;
+					bestScore = score;
+					bestSecondScore = secondScore;
+					result = candidate;
+				}
+			}
+		}
+		return found;
+	}
+
+	int RectPacker::_calcContact(const Rectangle<int>& rectangle)
+	{
+		int result = 0;
+		if (rectangle.x == 0 || rectangle.x + rectangle.w == this->width)
+		{
+			result += rectangle.h;
+		}
+		if (rectangle.y == 0 || rectangle.y + rectangle.h == this->height)
+		{
+			result += rectangle.w;
+		}
+		// placed Rectangles never overlap the free space, so everything intersecting the grown Rectangle touches it
+		this->_usedRectangles.findIntersecting(Rectangle<int>(rectangle.x - 1, rectangle.y - 1, rectangle.w + 2, rectangle.h + 2), this->_neighbors);
+		for (unsigned int i = 0; i < this->_neighbors.size(); ++i)
+		{
+			const Rectangle<int>& used = this->_usedRectangles.getRectangle(this->_neighbors[i]);
+			if (used.x + used.w == rectangle.x || used.x == rectangle.x + rectangle.w)
+			{
+				result += _overlap(used.y, used.y + used.h, rectangle.y, rectangle.y + rectangle.h);
+			}
+			if (used.y + used.h == rectangle.y || used.y == rectangle.y + rectangle.h)
+			{
+				result += _overlap(used.x, used.x + used.w, rectangle.x, rectangle.x + rectangle.w);
+			}
+		}
+		return result;
+	}
+
+	void RectPacker::_placeMaxRects(const Rectangle<int>& rectangle)
+	{
+		this->_newFreeRectangles.clear();
+		int size = (int)this->freeRectangles.size();
+		// every free rectangle overlapping the placed one is replaced by up to 4 maximal pieces around it
+		for (int i = 0; i < size; )
+		{
+			const Rectangle<int> space = this->freeRectangles[i];
+			if (!space.intersects(rectangle))
+			{
+				++i;
+				continue;
+			}
+			if (rectangle.x > space.x)
+			{
+				this->_newFreeRectangles.push_back(Rectangle<int>(space.x, space.y, rectangle.x - space.x, space.h));
+			}
+			if (rectangle.x + rectangle.w < space.x + space.w)
+			{
+				this->_newFreeRectangles.push_back(Rectangle<int>(rectangle.x + rectangle.w, space.y, space.x + space.w - rectangle.x - rectangle.w, space.h));
+			}
+			if (rectangle.y > space.y)
+			{
+				this->_newFreeRectangles.push_back(Rectangle<int>(space.x, space.y, space.w, rectangle.y - space.y));
+			}
+			if (rectangle.y + rectangle.h < space.y + space.h)
+			{
+				this->_newFreeRectangles.push_back(Rectangle<int>(space.x, rectangle.y + rectangle.h, space.w, space.y + space.h - rectangle.y - rectangle.h));
+			}
+			--size;
+			this->freeRectangles[i] = this->freeRectangles[size];
+			this->freeRectangles.pop_back();
+		}
+		// the untouched free rectangles cannot contain each other, so only the new pieces need to be checked against all
+		int newSize = (int)this->_newFreeRectangles.size();
+		for (int i = 0; i < newSize; ++i)
+		{
+			const Rectangle<int>& piece = this->_newFreeRectangles[i];
+			bool contained = false;
+			for (int j = 0; j < newSize && !contained; ++j)
+			{
+				// of two equal pieces only the first one survives
+				contained = (j != i && this->_newFreeRectangles[j].contains(piece) && (j < i || this->_newFreeRectangles[j] != piece));
+			}
+			for (int j = 0; j < size && !contained; ++j)
+			{
+				contained = this->freeRectangles[j].contains(piece);
+			}
+			if (!contained)
+			{
+				this->freeRectangles.push_back(piece);
+			}
+		}
+	}
+
+	bool RectPacker::_findSkyline(int width, int height, Rectangle<int>& result, int& index) const
+	{
+		int bestBottom = 0;
+		int bestWidth = 0;
+		bool found = false;
+		int size = (int)this->skyline.size();
+		int y = 0;
+		int w = 0;
+		int h = 0;
+		for (int i = 0; i < size; ++i)
+		{
+			for (int rotated = 0; rotated < 2; ++rotated)
+			{
+				if (rotated == 1 && (!this->rotationAllowed || width == height))
+				{
+					break;
+				}
+				w = (rotated == 0 ? width : height);
+				h = (rotated == 0 ? height : width);
+				y = this->_fitSkyline(i, w, h);
+				if (y < 0)
+				{
+					continue;
+				}
+				if (!found || y + h < bestBottom || (y + h == bestBottom && this->skyline[i].width < bestWidth))
+				{
+					found = true;
+					bestBottom = y + h;
+					bestWidth = this->skyline[i].width;
+					result.set(this->skyline[i].x, y, w, h);
+					index = i;
+				}
+			}
+		}
+		return found;
+	}
+
+	int RectPacker::_fitSkyline(int index, int width, int height) const
+	{
+		int x = this->skyline[index].x;
+		if (x + width > this->width)
+		{
+			return -1;
+		}
+		// the segments cover the whole width, so the ones below the Rectangle never run out
+		int y = 0;
+		int remaining = width;
+		for (int i = index; remaining > 0; ++i)
+		{
+			y = std::max(y, this->skyline[i].y);
+			if (y + height > this->height)
+			{
+				return -1;
+			}
+			remaining -= this->skyline[i].width;
+		}
+		return y;
+	}
+
+	void RectPacker::_placeSkyline(int index, const Rectangle<int>& rectangle)
+	{
+		SkylineNode node;
+		node.x = rectangle.x;
+		node.y = rectangle.y + rectangle.h;
+		node.width = rectangle.w;
+		this->skyline.insert(this->skyline.begin() + index, node);
+		// cut the segments that are now below the new one
+		int end = rectangle.x + rectangle.w;
+		int i = index + 1;
+		while (i < (int)this->skyline.size() && this->skyline[i].x < end)
+		{
+			int shrink = end - this->skyline[i].x;
+			if (shrink < this->skyline[i].width)
+			{
+				this->skyline[i].x += shrink;
+				this->skyline[i].width -= shrink;
+				break;
+			}
+			this->skyline.erase(this->skyline.begin() + i);
+		}
+		// neighbors at the same height become one segment
+		for (i = 0; i < (int)this->skyline.size() - 1; )
+		{
+			if (this->skyline[i].y == this->skyline[i + 1].y)
+			{
+				this->skyline[i].width += this->skyline[i + 1].width;
+				this->skyline.erase(this->skyline.begin() + i + 1);
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+
+}
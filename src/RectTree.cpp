@@ -0,0 +1,620 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <string.h>
+#include <vector>
+
+#include "gtypesParallel.h"
+#include "Rectangle.h"
+#include "RectTree.h"
+#include "SpaceFillingCurve.h"
+#include "Vector2.h"
+
+// identifies a memory block written by RectTree::save(), reads "GRT1" in little endian
+#define DATA_MAGIC 0x31545247u
+// number of ints in front of the arrays of a memory block
+#define HEADER_SIZE 6
+// the Hilbert keys use 2^20 cells along the longest side of the bounds of all centers
+#define KEY_CELLS 1048575.0
+// below this many Rectangles or nodes per thread, starting a thread costs more than it saves
+#define MINIMUM_RECTANGLES_PER_THREAD 16384
+#define MINIMUM_NODES_PER_THREAD 4096
+
+namespace gtypes
+{
+	// the state shared by the threads of a build step, every thread handles a contiguous range of workCount items
+	template <typename T>
+	struct _RectTreeBuild
+	{
+		const Rectangle<T>* source;
+		double minimumX;
+		double minimumY;
+		double scale;
+		unsigned long long* keys;
+		const int* permutation;
+		Rectangle<T>* rectangles;
+		int* ids;
+		typename RectTree<T>::Node* nodes;
+		int nodeSize;
+		int levelStart;
+		int childStart;
+		int childCount;
+		bool leaves;
+		int workCount;
+		int threadCount;
+	};
+
+	// identifies the coordinate type in a memory block
+	template <typename T>
+	static inline int _typeTag()
+	{
+		return ((int)sizeof(T) | ((T)0.5 != (T)0 ? 0x100 : 0));
+	}
+
+	// quantizes a coordinate into the key cells, NaN ends up in cell 0
+	static inline int _quantize(double value)
+	{
+		value = (value > 0.0 ? value : 0.0);
+		return (int)(value < KEY_CELLS ? value : KEY_CELLS);
+	}
+
+	// the number of nodes of every level from the lowest one up to the root, returns the total number of nodes
+	static int _computeLevels(int count, int nodeSize, std::vector<int>& levelCounts)
+	{
+		int result = 0;
+		int levelCount = count;
+		levelCounts.clear();
+		do
+		{
+			levelCount = (levelCount + nodeSize - 1) / nodeSize;
+			levelCounts.push_back(levelCount);
+			result += levelCount;
+		} while (levelCount > 1);
+		return result;
+	}
+
+	template <typename T>
+	static void _computeKeys(void* data, int index)
+	{
+		_RectTreeBuild<T>* build = (_RectTreeBuild<T>*)data;
+		int begin = (int)((long long)build->workCount * index / build->threadCount);
+		int end = (int)((long long)build->workCount * (index + 1) / build->threadCount);
+		Vector2<int> cell;
+		for (int i = begin; i < end; ++i)
+		{
+			const Rectangle<T>& rectangle = build->source[i];
+			cell.x = _quantize(((double)rectangle.x + (double)rectangle.w * 0.5 - build->minimumX) * build->scale);
+			cell.y = _quantize(((double)rectangle.y + (double)rectangle.h * 0.5 - build->minimumY) * build->scale);
+			build->keys[i] = SpaceFillingCurve::encodeHilbert(cell);
+		}
+	}
+
+	template <typename T>
+	static void _reorder(void* data, int index)
+	{
+		_RectTreeBuild<T>* build = (_RectTreeBuild<T>*)data;
+		int begin = (int)((long long)build->workCount * index / build->threadCount);
+		int end = (int)((long long)build->workCount * (index + 1) / build->threadCount);
+		for (int i = begin; i < end; ++i)
+		{
+			build->rectangles[i] = build->source[build->permutation[i]];
+			build->ids[i] = build->permutation[i];
+		}
+	}
+
+	template <typename T>
+	static void _buildLevel(void* data, int index)
+	{
+		_RectTreeBuild<T>* build = (_RectTreeBuild<T>*)data;
+		int begin = (int)((long long)build->workCount * index / build->threadCount);
+		int end = (int)((long long)build->workCount * (index + 1) / build->threadCount);
+		T left = 0;
+		T top = 0;
+		T right = 0;
+		T bottom = 0;
+		for (int i = begin; i < end; ++i)
+		{
+			typename RectTree<T>::Node& node = build->nodes[build->levelStart + i];
+			int first = i * build->nodeSize;
+			int last = (first + build->nodeSize < build->childCount ? first + build->nodeSize : build->childCount);
+			node.first = build->childStart + first;
+			node.count = last - first;
+			for (int j = node.first; j < node.first + node.count; ++j)
+			{
+				const Rectangle<T>& child = (build->leaves ? build->rectangles[j] : build->nodes[j].bounds);
+				if (j == node.first)
+				{
+					left = child.x;
+					top = child.y;
+					right = child.x + child.w;
+					bottom = child.y + child.h;
+				}
+				else
+				{
+					left = (child.x < left ? child.x : left);
+					top = (child.y < top ? child.y : top);
+					right = (child.x + child.w > right ? child.x + child.w : right);
+					bottom = (child.y + child.h > bottom ? child.y + child.h : bottom);
+				}
+			}
+			node.bounds.set(left, top, right - left, bottom - top);
+		}
+	}
+
+	template <typename T>
+	RectTree<T>::RectTree() : nodeSize(16), count(0), nodeCount(0), leafStart(0), attached(false), _nodes(NULL), _rectangles(NULL), _ids(NULL)
+	{
+	}
+
+	template <typename T>
+	RectTree<T>::RectTree(const RectTree<T>& other) : nodeSize(16), count(0), nodeCount(0), leafStart(0), attached(false), _nodes(NULL), _rectangles(NULL), _ids(NULL)
+	{
+		*this = other;
+	}
+
+	template <typename T>
+	void RectTree<T>::build(const Rectangle<T>* rectangles, int count, int nodeSize, int threadCount)
+	{
+		this->clear();
+		this->nodeSize = (nodeSize > 2 ? (nodeSize < 256 ? nodeSize : 256) : 2);
+		if (count <= 0)
+		{
+			return;
+		}
+		// the keys are relative to the bounds of all centers, the same scale on both axes keeps the cells square
+		double minimumX = (double)rectangles[0].x + (double)rectangles[0].w * 0.5;
+		double minimumY = (double)rectangles[0].y + (double)rectangles[0].h * 0.5;
+		double maximumX = minimumX;
+		double maximumY = minimumY;
+		double x = 0.0;
+		double y = 0.0;
+		for (int i = 1; i < count; ++i)
+		{
+			x = (double)rectangles[i].x + (double)rectangles[i].w * 0.5;
+			y = (double)rectangles[i].y + (double)rectangles[i].h * 0.5;
+			minimumX = (x < minimumX ? x : minimumX);
+			minimumY = (y < minimumY ? y : minimumY);
+			maximumX = (x > maximumX ? x : maximumX);
+			maximumY = (y > maximumY ? y : maximumY);
+		}
+		double extent = (maximumX - minimumX > maximumY - minimumY ? maximumX - minimumX : maximumY - minimumY);
+		std::vector<unsigned long long> keys(count);
+		std::vector<int> permutation(count);
+		_RectTreeBuild<T> build;
+		build.source = rectangles;
+		build.minimumX = minimumX;
+		build.minimumY = minimumY;
+		build.scale = (extent > 0.0 ? KEY_CELLS / extent : 0.0);
+		build.keys = &keys[0];
+		build.workCount = count;
+		build.threadCount = parallel::getThreadCount(threadCount, count, MINIMUM_RECTANGLES_PER_THREAD);
+		parallel::run(build.threadCount, &_computeKeys<T>, &build);
+		SpaceFillingCurve::sortKeys(&keys[0], count, &permutation[0], threadCount);
+		this->rectangles.resize(count);
+		this->ids.resize(count);
+		build.permutation = &permutation[0];
+		build.rectangles = &this->rectangles[0];
+		build.ids = &this->ids[0];
+		parallel::run(build.threadCount, &_reorder<T>, &build);
+		std::vector<int> levelCounts;
+		this->nodeCount = _computeLevels(count, this->nodeSize, levelCounts);
+		this->nodes.resize(this->nodeCount);
+		build.nodes = &this->nodes[0];
+		build.nodeSize = this->nodeSize;
+		build.childStart = 0;
+		build.childCount = count;
+		// the levels are stored from the root downwards, but every level needs the bounds of the one below it
+		int levelStart = this->nodeCount;
+		for (unsigned int i = 0; i < levelCounts.size(); ++i)
+		{
+			levelStart -= levelCounts[i];
+			build.levelStart = levelStart;
+			build.leaves = (i == 0);
+			build.workCount = levelCounts[i];
+			build.threadCount = parallel::getThreadCount(threadCount, levelCounts[i], MINIMUM_NODES_PER_THREAD);
+			parallel::run(build.threadCount, &_buildLevel<T>, &build);
+			build.childStart = levelStart;
+			build.childCount = levelCounts[i];
+		}
+		this->leafStart = this->nodeCount - levelCounts[0];
+		this->count = count;
+		this->_updatePointers();
+	}
+
+	template <typename T>
+	void RectTree<T>::clear()
+	{
+		this->count = 0;
+		this->nodeCount = 0;
+		this->leafStart = 0;
+		this->attached = false;
+		this->nodes.clear();
+		this->rectangles.clear();
+		this->ids.clear();
+		this->_updatePointers();
+	}
+
+	template <typename T>
+	int RectTree<T>::findIntersecting(const Rectangle<T>& rectangle, int* result, int maxCount) const
+	{
+		if (this->nodeCount == 0 || !this->_nodes[0].bounds.intersects(rectangle))
+		{
+			return 0;
+		}
+		return this->_findIntersecting(0, rectangle, result, maxCount, 0);
+	}
+
+	template <typename T>
+	void RectTree<T>::findIntersecting(const Rectangle<T>& rectangle, std::vector<int>& result) const
+	{
+		// the previous capacity is usually enough for repeated queries
+		result.resize(result.capacity() > 0 ? result.capacity() : 16);
+		int found = this->findIntersecting(rectangle, &result[0], (int)result.size());
+		if (found > (int)result.size())
+		{
+			result.resize(found);
+			this->findIntersecting(rectangle, &result[0], found);
+		}
+		result.resize(found);
+	}
+
+	template <typename T>
+	int RectTree<T>::findOnRay(const Vector2<float>& origin, const Vector2<float>& direction, float maxDistance, int* result, int maxCount) const
+	{
+		Ray ray;
+		ray.originX = (double)origin.x;
+		ray.originY = (double)origin.y;
+		ray.directionX = (double)direction.x;
+		ray.directionY = (double)direction.y;
+		ray.inverseX = (direction.x != 0.0f ? 1.0 / ray.directionX : 0.0);
+		ray.inverseY = (direction.y != 0.0f ? 1.0 / ray.directionY : 0.0);
+		ray.maxDistance = (double)maxDistance;
+		double entry = 0.0;
+		if (this->nodeCount == 0 || !_intersectRay(ray, this->_nodes[0].bounds, entry))
+		{
+			return 0;
+		}
+		return this->_findOnRay(0, ray, result, maxCount, 0);
+	}
+
+	template <typename T>
+	int RectTree<T>::findFirstOnRay(const Vector2<float>& origin, const Vector2<float>& direction, float maxDistance, float& distance) const
+	{
+		Ray ray;
+		ray.originX = (double)origin.x;
+		ray.originY = (double)origin.y;
+		ray.directionX = (double)direction.x;
+		ray.directionY = (double)direction.y;
+		ray.inverseX = (direction.x != 0.0f ? 1.0 / ray.directionX : 0.0);
+		ray.inverseY = (direction.y != 0.0f ? 1.0 / ray.directionY : 0.0);
+		ray.maxDistance = (double)maxDistance;
+		double entry = 0.0;
+		if (this->nodeCount == 0 || !_intersectRay(ray, this->_nodes[0].bounds, entry))
+		{
+			return -1;
+		}
+		int best = -1;
+		this->_findFirstOnRay(0, ray, best);
+		if (best >= 0)
+		{
+			distance = (float)ray.maxDistance;
+		}
+		return best;
+	}
+
+	template <typename T>
+	size_t RectTree<T>::getDataSize() const
+	{
+		return (HEADER_SIZE * sizeof(int) + this->nodeCount * sizeof(Node) + this->count * (sizeof(Rectangle<T>) + sizeof(int)));
+	}
+
+	template <typename T>
+	void RectTree<T>::save(unsigned char* data) const
+	{
+		int header[HEADER_SIZE] = { (int)DATA_MAGIC, _typeTag<T>(), this->nodeSize, this->count, this->nodeCount, this->leafStart };
+		memcpy(data, header, sizeof(header));
+		data += sizeof(header);
+		if (this->nodeCount > 0)
+		{
+			memcpy(data, this->_nodes, this->nodeCount * sizeof(Node));
+			data += this->nodeCount * sizeof(Node);
+			memcpy(data, this->_rectangles, this->count * sizeof(Rectangle<T>));
+			data += this->count * sizeof(Rectangle<T>);
+			memcpy(data, this->_ids, this->count * sizeof(int));
+		}
+	}
+
+	template <typename T>
+	bool RectTree<T>::load(const unsigned char* data, size_t size)
+	{
+		int nodeSize = 0;
+		int count = 0;
+		int nodeCount = 0;
+		int leafStart = 0;
+		if (!_readHeader(data, size, nodeSize, count, nodeCount, leafStart))
+		{
+			return false;
+		}
+		this->clear();
+		this->nodeSize = nodeSize;
+		this->count = count;
+		this->nodeCount = nodeCount;
+		this->leafStart = leafStart;
+		if (nodeCount > 0)
+		{
+			this->nodes.resize(nodeCount);
+			this->rectangles.resize(count);
+			this->ids.resize(count);
+			data += HEADER_SIZE * sizeof(int);
+			memcpy((void*)&this->nodes[0], data, nodeCount * sizeof(Node));
+			data += nodeCount * sizeof(Node);
+			memcpy((void*)&this->rectangles[0], data, count * sizeof(Rectangle<T>));
+			data += count * sizeof(Rectangle<T>);
+			memcpy(&this->ids[0], data, count * sizeof(int));
+		}
+		this->_updatePointers();
+		return true;
+	}
+
+	template <typename T>
+	bool RectTree<T>::attach(const unsigned char* data, size_t size)
+	{
+		int nodeSize = 0;
+		int count = 0;
+		int nodeCount = 0;
+		int leafStart = 0;
+		if (((size_t)data & 3) != 0 || !_readHeader(data, size, nodeSize, count, nodeCount, leafStart))
+		{
+			return false;
+		}
+		this->clear();
+		this->nodeSize = nodeSize;
+		this->count = count;
+		this->nodeCount = nodeCount;
+		this->leafStart = leafStart;
+		this->attached = true;
+		if (nodeCount > 0)
+		{
+			data += HEADER_SIZE * sizeof(int);
+			this->_nodes = (const Node*)data;
+			data += nodeCount * sizeof(Node);
+			this->_rectangles = (const Rectangle<T>*)data;
+			data += count * sizeof(Rectangle<T>);
+			this->_ids = (const int*)data;
+		}
+		return true;
+	}
+
+	template <typename T>
+	RectTree<T>& RectTree<T>::operator=(const RectTree<T>& other)
+	{
+		this->nodeSize = other.nodeSize;
+		this->count = other.count;
+		this->nodeCount = other.nodeCount;
+		this->leafStart = other.leafStart;
+		this->attached = other.attached;
+		this->nodes = other.nodes;
+		this->rectangles = other.rectangles;
+		this->ids = other.ids;
+		this->_updatePointers();
+		if (this->attached)
+		{
+			this->_nodes = other._nodes;
+			this->_rectangles = other._rectangles;
+			this->_ids = other._ids;
+		}
+		return (*this);
+	}
+
+	template <typename T>
+	void RectTree<T>::_updatePointers()
+	{
+		this->_nodes = (this->nodes.size() > 0 ? &this->nodes[0] : NULL);
+		this->_rectangles = (this->rectangles.size() > 0 ? &this->rectangles[0] : NULL);
+		this->_ids = (this->ids.size() > 0 ? &this->ids[0] : NULL);
+	}
+
+	template <typename T>
+	bool RectTree<T>::_readHeader(const unsigned char* data, size_t size, int& nodeSize, int& count, int& nodeCount, int& leafStart)
+	{
+		int header[HEADER_SIZE];
+		if (data == NULL || size < sizeof(header))
+		{
+			return false;
+		}
+		memcpy(header, data, sizeof(header));
+		nodeSize = header[2];
+		count = header[3];
+		nodeCount = header[4];
+		leafStart = header[5];
+		if (header[0] != (int)DATA_MAGIC || header[1] != _typeTag<T>() || nodeSize < 2 || nodeSize > 256 || count < 0 || nodeCount < 0 ||
+			(count == 0) != (nodeCount == 0))
+		{
+			return false;
+		}
+		if (size != sizeof(header) + (size_t)nodeCount * sizeof(Node) + (size_t)count * (sizeof(Rectangle<T>) + sizeof(int)))
+		{
+			return false;
+		}
+		if (count == 0)
+		{
+			return (leafStart == 0);
+		}
+		// the layout only depends on count and nodeSize, so every node has to match the one build() creates
+		std::vector<int> levelCounts;
+		if (nodeCount != _computeLevels(count, nodeSize, levelCounts) || leafStart != nodeCount - levelCounts[0])
+		{
+			return false;
+		}
+		Node node;
+		const unsigned char* nodes = data + sizeof(header);
+		int levelStart = nodeCount;
+		int childStart = 0;
+		int childCount = count;
+		for (unsigned int i = 0; i < levelCounts.size(); ++i)
+		{
+			levelStart -= levelCounts[i];
+			for (int j = 0; j < levelCounts[i]; ++j)
+			{
+				memcpy((void*)&node, nodes + (levelStart + j) * sizeof(Node), sizeof(Node));
+				int first = j * nodeSize;
+				if (node.first != childStart + first || node.count != (first + nodeSize < childCount ? nodeSize : childCount - first))
+				{
+					return false;
+				}
+			}
+			childStart = levelStart;
+			childCount = levelCounts[i];
+		}
+		// the ids are returned to the caller, so they have to be valid indices
+		int id = 0;
+		const unsigned char* ids = nodes + nodeCount * sizeof(Node) + count * sizeof(Rectangle<T>);
+		for (int i = 0; i < count; ++i)
+		{
+			memcpy(&id, ids + i * sizeof(int), sizeof(int));
+			if (id < 0 || id >= count)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename T>
+	inline bool RectTree<T>::_intersectRay(const Ray& ray, const Rectangle<T>& rectangle, double& entry)
+	{
+		double minimum = 0.0;
+		double maximum = ray.maxDistance;
+		double enter = 0.0;
+		double leave = 0.0;
+		// a ray parallel to an axis has to start between the edges
+		if (ray.directionX == 0.0)
+		{
+			if ((double)rectangle.x > ray.originX || (double)rectangle.x + (double)rectangle.w < ray.originX)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			enter = ((double)rectangle.x - ray.originX) * ray.inverseX;
+			leave = ((double)rectangle.x + (double)rectangle.w - ray.originX) * ray.inverseX;
+			minimum = (enter < leave ? (enter > minimum ? enter : minimum) : (leave > minimum ? leave : minimum));
+			maximum = (enter < leave ? (leave < maximum ? leave : maximum) : (enter < maximum ? enter : maximum));
+		}
+		if (ray.directionY == 0.0)
+		{
+			if ((double)rectangle.y > ray.originY || (double)rectangle.y + (double)rectangle.h < ray.originY)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			enter = ((double)rectangle.y - ray.originY) * ray.inverseY;
+			leave = ((double)rectangle.y + (double)rectangle.h - ray.originY) * ray.inverseY;
+			minimum = (enter < leave ? (enter > minimum ? enter : minimum) : (leave > minimum ? leave : minimum));
+			maximum = (enter < leave ? (leave < maximum ? leave : maximum) : (enter < maximum ? enter : maximum));
+		}
+		entry = minimum;
+		return (minimum <= maximum);
+	}
+
+	template <typename T>
+	int RectTree<T>::_findIntersecting(int node, const Rectangle<T>& rectangle, int* result, int maxCount, int found) const
+	{
+		const Node& current = this->_nodes[node];
+		int end = current.first + current.count;
+		if (node >= this->leafStart)
+		{
+			for (int i = current.first; i < end; ++i)
+			{
+				if (this->_rectangles[i].intersects(rectangle))
+				{
+					if (found < maxCount)
+					{
+						result[found] = this->_ids[i];
+					}
+					++found;
+				}
+			}
+			return found;
+		}
+		for (int i = current.first; i < end; ++i)
+		{
+			if (this->_nodes[i].bounds.intersects(rectangle))
+			{
+				found = this->_findIntersecting(i, rectangle, result, maxCount, found);
+			}
+		}
+		return found;
+	}
+
+	template <typename T>
+	int RectTree<T>::_findOnRay(int node, const Ray& ray, int* result, int maxCount, int found) const
+	{
+		const Node& current = this->_nodes[node];
+		int end = current.first + current.count;
+		double entry = 0.0;
+		if (node >= this->leafStart)
+		{
+			for (int i = current.first; i < end; ++i)
+			{
+				if (_intersectRay(ray, this->_rectangles[i], entry))
+				{
+					if (found < maxCount)
+					{
+						result[found] = this->_ids[i];
+					}
+					++found;
+				}
+			}
+			return found;
+		}
+		for (int i = current.first; i < end; ++i)
+		{
+			if (_intersectRay(ray, this->_nodes[i].bounds, entry))
+			{
+				found = this->_findOnRay(i, ray, result, maxCount, found);
+			}
+		}
+		return found;
+	}
+
+	template <typename T>
+	void RectTree<T>::_findFirstOnRay(int node, Ray& ray, int& best) const
+	{
+		const Node& current = this->_nodes[node];
+		int end = current.first + current.count;
+		double entry = 0.0;
+		if (node >= this->leafStart)
+		{
+			for (int i = current.first; i < end; ++i)
+			{
+				// equally close Rectangles keep the first one that was found
+				if (_intersectRay(ray, this->_rectangles[i], entry) && (best < 0 || entry < ray.maxDistance))
+				{
+					best = this->_ids[i];
+					ray.maxDistance = entry;
+				}
+			}
+			return;
+		}
+		for (int i = current.first; i < end; ++i)
+		{
+			if (_intersectRay(ray, this->_nodes[i].bounds, entry))
+			{
+				this->_findFirstOnRay(i, ray, best);
+			}
+		}
+	}
+
+	template class RectTree<int>;
+	template class RectTree<float>;
+
+}
@@ -0,0 +1,333 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include "gtypesSimd.h"
+#include "gtypesSimdKernels.h"
+#include "Rectangle.h"
+#include "Vector2.h"
+
+namespace gtypes
+{
+	namespace simd
+	{
+		static void maskInRectangles2fScalar(const float* x, const float* y, int stride, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask)
+		{
+			unsigned int bits = 0;
+			unsigned int inside = 0;
+			int size = 0;
+			float px = 0.0f;
+			float py = 0.0f;
+			for (int i = 0; i < count; i += 32)
+			{
+				size = (count - i < 32 ? count - i : 32);
+				bits = 0;
+				for (int j = 0; j < size; ++j)
+				{
+					px = x[(i + j) * stride];
+					py = y[(i + j) * stride];
+					inside = 0;
+					// same test as Rectangle::isPointInside() without short-circuiting so there are no unpredictable branches
+					for (int k = 0; k < rectangleCount; ++k)
+					{
+						const Rectangle<float>& rectangle = rectangles[k];
+						inside |= (unsigned int)(px >= rectangle.x) & (unsigned int)(py >= rectangle.y) &
+							(unsigned int)(px < rectangle.x + rectangle.w) & (unsigned int)(py < rectangle.y + rectangle.h);
+					}
+					bits |= inside << j;
+				}
+				mask[i / 32] = bits;
+			}
+		}
+
+		// shared by all levels, calls the mask and compress kernels of the current level
+		static int findInRectangles2f(const float* x, const float* y, int stride, int count, const Rectangle<float>* rectangles, int rectangleCount, int* result)
+		{
+			const Kernels& kernels = getKernels();
+			unsigned int mask[32];
+			int found = 0;
+			int size = 0;
+			// blocks of 1024 points keep the mask in the L1 cache between both passes
+			for (int i = 0; i < count; i += 1024)
+			{
+				size = (count - i < 1024 ? count - i : 1024);
+				kernels.maskInRectangles2f(x + i * stride, y + i * stride, stride, size, rectangles, rectangleCount, mask);
+				found += kernels.compressMask(mask, size, i, result + found);
+			}
+			return found;
+		}
+
+#if defined(GTYPES_SIMD_SSE)
+		template <int Stride>
+		static void _maskInRectangles2fSse2(const float* x, const float* y, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask)
+		{
+			__m128 px;
+			__m128 py;
+			unsigned int bits = 0;
+			int i = 0;
+			// one mask word of 32 points per step, 4 points at once against every Rectangle
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = 0;
+				for (int j = 0; j < 32; j += 4)
+				{
+					if (Stride == 2)
+					{
+						__m128 a = _mm_loadu_ps(x + (i + j) * 2);
+						__m128 b = _mm_loadu_ps(x + (i + j) * 2 + 4);
+						px = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+						py = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+					}
+					else
+					{
+						px = _mm_loadu_ps(x + i + j);
+						py = _mm_loadu_ps(y + i + j);
+					}
+					__m128 inside = _mm_setzero_ps();
+					for (int k = 0; k < rectangleCount; ++k)
+					{
+						const Rectangle<float>& rectangle = rectangles[k];
+						__m128 horizontal = _mm_and_ps(_mm_cmpge_ps(px, _mm_set1_ps(rectangle.x)), _mm_cmplt_ps(px, _mm_set1_ps(rectangle.x + rectangle.w)));
+						__m128 vertical = _mm_and_ps(_mm_cmpge_ps(py, _mm_set1_ps(rectangle.y)), _mm_cmplt_ps(py, _mm_set1_ps(rectangle.y + rectangle.h)));
+						inside = _mm_or_ps(inside, _mm_and_ps(horizontal, vertical));
+					}
+					bits |= (unsigned int)_mm_movemask_ps(inside) << j;
+				}
+				mask[i / 32] = bits;
+			}
+			if (i < count)
+			{
+				maskInRectangles2fScalar(x + i * Stride, y + i * Stride, Stride, count - i, rectangles, rectangleCount, mask + i / 32);
+			}
+		}
+
+		static void maskInRectangles2fSse2(const float* x, const float* y, int stride, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask)
+		{
+			if (stride == 2)
+			{
+				_maskInRectangles2fSse2<2>(x, y, count, rectangles, rectangleCount, mask);
+			}
+			else
+			{
+				_maskInRectangles2fSse2<1>(x, y, count, rectangles, rectangleCount, mask);
+			}
+		}
+
+		template <int Stride>
+		GTYPES_TARGET_AVX2 static void _maskInRectangles2fAvx2(const float* x, const float* y, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask)
+		{
+			__m256 px;
+			__m256 py;
+			unsigned int bits = 0;
+			int i = 0;
+			// one mask word of 32 points per step, 8 points at once against every Rectangle
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = 0;
+				for (int j = 0; j < 32; j += 8)
+				{
+					if (Stride == 2)
+					{
+						__m256 a = _mm256_loadu_ps(x + (i + j) * 2);
+						__m256 b = _mm256_loadu_ps(x + (i + j) * 2 + 8);
+						px = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+						py = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+					}
+					else
+					{
+						px = _mm256_loadu_ps(x + i + j);
+						py = _mm256_loadu_ps(y + i + j);
+					}
+					__m256 inside = _mm256_setzero_ps();
+					for (int k = 0; k < rectangleCount; ++k)
+					{
+						const Rectangle<float>& rectangle = rectangles[k];
+						__m256 horizontal = _mm256_and_ps(_mm256_cmp_ps(px, _mm256_set1_ps(rectangle.x), _CMP_GE_OQ),
+							_mm256_cmp_ps(px, _mm256_set1_ps(rectangle.x + rectangle.w), _CMP_LT_OQ));
+						__m256 vertical = _mm256_and_ps(_mm256_cmp_ps(py, _mm256_set1_ps(rectangle.y), _CMP_GE_OQ),
+							_mm256_cmp_ps(py, _mm256_set1_ps(rectangle.y + rectangle.h), _CMP_LT_OQ));
+						inside = _mm256_or_ps(inside, _mm256_and_ps(horizontal, vertical));
+					}
+					if (Stride == 2)
+					{
+						// the in-lane shuffles produced the order 0 1 4 5 2 3 6 7
+						inside = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(inside), _MM_SHUFFLE(3, 1, 2, 0)));
+					}
+					bits |= (unsigned int)_mm256_movemask_ps(inside) << j;
+				}
+				mask[i / 32] = bits;
+			}
+			if (i < count)
+			{
+				maskInRectangles2fScalar(x + i * Stride, y + i * Stride, Stride, count - i, rectangles, rectangleCount, mask + i / 32);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void maskInRectangles2fAvx2(const float* x, const float* y, int stride, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask)
+		{
+			if (stride == 2)
+			{
+				_maskInRectangles2fAvx2<2>(x, y, count, rectangles, rectangleCount, mask);
+			}
+			else
+			{
+				_maskInRectangles2fAvx2<1>(x, y, count, rectangles, rectangleCount, mask);
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_AVX512)
+		template <int Stride>
+		GTYPES_TARGET_AVX512 static void _maskInRectangles2fAvx512(const float* x, const float* y, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask)
+		{
+			__m512i evenIndices = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+			__m512i oddIndices = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+			__m512 px;
+			__m512 py;
+			unsigned int bits = 0;
+			int i = 0;
+			// one mask word of 32 points per step, 16 points at once against every Rectangle, the comparisons are chained through their masks
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = 0;
+				for (int j = 0; j < 32; j += 16)
+				{
+					if (Stride == 2)
+					{
+						__m512 a = _mm512_loadu_ps(x + (i + j) * 2);
+						__m512 b = _mm512_loadu_ps(x + (i + j) * 2 + 16);
+						px = _mm512_permutex2var_ps(a, evenIndices, b);
+						py = _mm512_permutex2var_ps(a, oddIndices, b);
+					}
+					else
+					{
+						px = _mm512_loadu_ps(x + i + j);
+						py = _mm512_loadu_ps(y + i + j);
+					}
+					__mmask16 inside = 0;
+					for (int k = 0; k < rectangleCount; ++k)
+					{
+						const Rectangle<float>& rectangle = rectangles[k];
+						__mmask16 current = _mm512_cmp_ps_mask(px, _mm512_set1_ps(rectangle.x), _CMP_GE_OQ);
+						current = _mm512_mask_cmp_ps_mask(current, px, _mm512_set1_ps(rectangle.x + rectangle.w), _CMP_LT_OQ);
+						current = _mm512_mask_cmp_ps_mask(current, py, _mm512_set1_ps(rectangle.y), _CMP_GE_OQ);
+						current = _mm512_mask_cmp_ps_mask(current, py, _mm512_set1_ps(rectangle.y + rectangle.h), _CMP_LT_OQ);
+						inside = (__mmask16)(inside | current);
+					}
+					bits |= (unsigned int)inside << j;
+				}
+				mask[i / 32] = bits;
+			}
+			if (i < count)
+			{
+				maskInRectangles2fScalar(x + i * Stride, y + i * Stride, Stride, count - i, rectangles, rectangleCount, mask + i / 32);
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void maskInRectangles2fAvx512(const float* x, const float* y, int stride, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask)
+		{
+			if (stride == 2)
+			{
+				_maskInRectangles2fAvx512<2>(x, y, count, rectangles, rectangleCount, mask);
+			}
+			else
+			{
+				_maskInRectangles2fAvx512<1>(x, y, count, rectangles, rectangleCount, mask);
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_NEON)
+		template <int Stride>
+		static void _maskInRectangles2fNeon(const float* x, const float* y, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask)
+		{
+			float32x4_t px;
+			float32x4_t py;
+			unsigned int bits = 0;
+			int i = 0;
+			// one mask word of 32 points per step, 4 points at once against every Rectangle
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = 0;
+				for (int j = 0; j < 32; j += 4)
+				{
+					if (Stride == 2)
+					{
+						float32x4x2_t v = vld2q_f32(x + (i + j) * 2);
+						px = v.val[0];
+						py = v.val[1];
+					}
+					else
+					{
+						px = vld1q_f32(x + i + j);
+						py = vld1q_f32(y + i + j);
+					}
+					uint32x4_t inside = vdupq_n_u32(0);
+					for (int k = 0; k < rectangleCount; ++k)
+					{
+						const Rectangle<float>& rectangle = rectangles[k];
+						uint32x4_t horizontal = vandq_u32(vcgeq_f32(px, vdupq_n_f32(rectangle.x)), vcltq_f32(px, vdupq_n_f32(rectangle.x + rectangle.w)));
+						uint32x4_t vertical = vandq_u32(vcgeq_f32(py, vdupq_n_f32(rectangle.y)), vcltq_f32(py, vdupq_n_f32(rectangle.y + rectangle.h)));
+						inside = vorrq_u32(inside, vandq_u32(horizontal, vertical));
+					}
+					bits |= movemask(inside) << j;
+				}
+				mask[i / 32] = bits;
+			}
+			if (i < count)
+			{
+				maskInRectangles2fScalar(x + i * Stride, y + i * Stride, Stride, count - i, rectangles, rectangleCount, mask + i / 32);
+			}
+		}
+
+		static void maskInRectangles2fNeon(const float* x, const float* y, int stride, int count, const Rectangle<float>* rectangles, int rectangleCount, unsigned int* mask)
+		{
+			if (stride == 2)
+			{
+				_maskInRectangles2fNeon<2>(x, y, count, rectangles, rectangleCount, mask);
+			}
+			else
+			{
+				_maskInRectangles2fNeon<1>(x, y, count, rectangles, rectangleCount, mask);
+			}
+		}
+#endif
+
+		void registerRectangleKernels(Kernels& kernels, Level level)
+		{
+			switch (level)
+			{
+			case LevelScalar:
+				kernels.maskInRectangles2f = &maskInRectangles2fScalar;
+				kernels.findInRectangles2f = &findInRectangles2f;
+				break;
+#if defined(GTYPES_SIMD_SSE)
+			case LevelSse2:
+				kernels.maskInRectangles2f = &maskInRectangles2fSse2;
+				break;
+			case LevelAvx2:
+				kernels.maskInRectangles2f = &maskInRectangles2fAvx2;
+				break;
+#endif
+#if defined(GTYPES_SIMD_AVX512)
+			case LevelAvx512:
+				kernels.maskInRectangles2f = &maskInRectangles2fAvx512;
+				break;
+#endif
+#if defined(GTYPES_SIMD_NEON)
+			case LevelNeon:
+				kernels.maskInRectangles2f = &maskInRectangles2fNeon;
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+
+	}
+
+}
@@ -0,0 +1,522 @@
+/// @file
+/// @version 3.0
+///
+/// @section LICENSE
+///
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <string.h>
+#include <vector>
+
+#include "gtypesParallel.h"
+#include "gtypesSimd.h"
+#include "gtypesSimdKernels.h"
+#include "SpaceFillingCurve.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+// the bits per sort pass, 6 passes cover 64-bit keys and the histograms of all threads stay in the L2 cache
+#define RADIX_BITS 11
+#define RADIX_SIZE (1 << RADIX_BITS)
+// below this many keys per thread, starting a thread costs more than it saves
+#define MINIMUM_KEYS_PER_THREAD 65536
+
+namespace gtypes
+{
+	// one step of Skilling's transform, see "Programming the Hilbert curve" (2004): inverts the lower bits of the first
+	// axis if the bit of the other axis is set, exchanges them otherwise; masks replace the unpredictable branches
+	static inline void _hilbertStep(unsigned int& first, unsigned int& axis, int bit)
+	{
+		unsigned int lower = (1u << bit) - 1;
+		unsigned int set = 0u - ((axis >> bit) & 1);
+		unsigned int swap = (first ^ axis) & lower & ~set;
+		first ^= (lower & set) | swap;
+		axis ^= swap;
+	}
+
+	// the lower bits that have to be flipped after the Gray encoding, bit i is the parity of the bits above i
+	static inline unsigned int _hilbertFlip(unsigned int value)
+	{
+		value >>= 1;
+		value ^= value >> 1;
+		value ^= value >> 2;
+		value ^= value >> 4;
+		value ^= value >> 8;
+		return (value ^ (value >> 16));
+	}
+
+	// transforms the coordinates into the transposed Hilbert index, the key interleaves its bits
+	static inline void _axesToTranspose(unsigned int& x, unsigned int& y, int bits)
+	{
+		for (int bit = bits - 1; bit > 0; --bit)
+		{
+			_hilbertStep(x, x, bit);
+			_hilbertStep(x, y, bit);
+		}
+		y ^= x;
+		unsigned int flip = _hilbertFlip(y);
+		x ^= flip;
+		y ^= flip;
+	}
+
+	static inline void _axesToTranspose(unsigned int& x, unsigned int& y, unsigned int& z, int bits)
+	{
+		for (int bit = bits - 1; bit > 0; --bit)
+		{
+			_hilbertStep(x, x, bit);
+			_hilbertStep(x, y, bit);
+			_hilbertStep(x, z, bit);
+		}
+		y ^= x;
+		z ^= y;
+		unsigned int flip = _hilbertFlip(z);
+		x ^= flip;
+		y ^= flip;
+		z ^= flip;
+	}
+
+	static inline void _transposeToAxes(unsigned int& x, unsigned int& y, int bits)
+	{
+		unsigned int flip = y >> 1;
+		y ^= x;
+		x ^= flip;
+		for (int bit = 1; bit < bits; ++bit)
+		{
+			_hilbertStep(x, y, bit);
+			_hilbertStep(x, x, bit);
+		}
+	}
+
+	static inline void _transposeToAxes(unsigned int& x, unsigned int& y, unsigned int& z, int bits)
+	{
+		unsigned int flip = z >> 1;
+		z ^= y;
+		y ^= x;
+		x ^= flip;
+		for (int bit = 1; bit < bits; ++bit)
+		{
+			_hilbertStep(x, z, bit);
+			_hilbertStep(x, y, bit);
+			_hilbertStep(x, x, bit);
+		}
+	}
+
+	unsigned long long SpaceFillingCurve::encodeHilbert(const Vector2<int>& vector)
+	{
+		unsigned int axes[2] = { (unsigned int)vector.x ^ 0x80000000u, (unsigned int)vector.y ^ 0x80000000u };
+		_axesToTranspose(axes[0], axes[1], 32);
+		// the first axis holds the highest bit of every pair
+		return ((SpaceFillingCurve::_spread2(axes[0]) << 1) | SpaceFillingCurve::_spread2(axes[1]));
+	}
+
+	unsigned long long SpaceFillingCurve::encodeHilbert(const Vector3<int>& vector)
+	{
+		unsigned int axes[3] = { ((unsigned int)vector.x + 0x100000u) & 0x1FFFFFu, ((unsigned int)vector.y + 0x100000u) & 0x1FFFFFu, ((unsigned int)vector.z + 0x100000u) & 0x1FFFFFu };
+		_axesToTranspose(axes[0], axes[1], axes[2], 21);
+		return ((SpaceFillingCurve::_spread3(axes[0]) << 2) | (SpaceFillingCurve::_spread3(axes[1]) << 1) | SpaceFillingCurve::_spread3(axes[2]));
+	}
+
+	Vector2<int> SpaceFillingCurve::decodeHilbert2(unsigned long long key)
+	{
+		unsigned int axes[2] = { SpaceFillingCurve::_compact2(key >> 1), SpaceFillingCurve::_compact2(key) };
+		_transposeToAxes(axes[0], axes[1], 32);
+		return Vector2<int>((int)(axes[0] ^ 0x80000000u), (int)(axes[1] ^ 0x80000000u));
+	}
+
+	Vector3<int> SpaceFillingCurve::decodeHilbert3(unsigned long long key)
+	{
+		unsigned int axes[3] = { SpaceFillingCurve::_compact3(key >> 2), SpaceFillingCurve::_compact3(key >> 1), SpaceFillingCurve::_compact3(key) };
+		_transposeToAxes(axes[0], axes[1], axes[2], 21);
+		return Vector3<int>((int)axes[0] - 0x100000, (int)axes[1] - 0x100000, (int)axes[2] - 0x100000);
+	}
+
+	void SpaceFillingCurve::encodeHilbert(const Vector2<int>* vectors, unsigned long long* keys, int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			keys[i] = SpaceFillingCurve::encodeHilbert(vectors[i]);
+		}
+	}
+
+	void SpaceFillingCurve::encodeHilbert(const Vector3<int>* vectors, unsigned long long* keys, int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			keys[i] = SpaceFillingCurve::encodeHilbert(vectors[i]);
+		}
+	}
+
+	// quantizes a coordinate relative to the bounds into 21 bits, NaN ends up in cell 0
+	static inline unsigned int _quantize21(float value, float minimum, float scale)
+	{
+		float result = (value - minimum) * scale;
+		result = (result > 0.0f ? result : 0.0f);
+		return (unsigned int)(result < 2097151.0f ? result : 2097151.0f);
+	}
+
+	void SpaceFillingCurve::computeKeys(const Vector2<float>* positions, int count, unsigned long long* keys, Curve curve)
+	{
+		if (count <= 0)
+		{
+			return;
+		}
+		Vector2<float> minimum = positions[0];
+		Vector2<float> maximum = positions[0];
+		for (int i = 1; i < count; ++i)
+		{
+			minimum.x = (positions[i].x < minimum.x ? positions[i].x : minimum.x);
+			minimum.y = (positions[i].y < minimum.y ? positions[i].y : minimum.y);
+			maximum.x = (positions[i].x > maximum.x ? positions[i].x : maximum.x);
+			maximum.y = (positions[i].y > maximum.y ? positions[i].y : maximum.y);
+		}
+		// the same scale on all axes keeps the cells square
+		float extent = (maximum.x - minimum.x > maximum.y - minimum.y ? maximum.x - minimum.x : maximum.y - minimum.y);
+		float scale = (extent > 0.0f ? 2097151.0f / extent : 0.0f);
+		unsigned int axes[2] = { 0, 0 };
+		for (int i = 0; i < count; ++i)
+		{
+			axes[0] = _quantize21(positions[i].x, minimum.x, scale);
+			axes[1] = _quantize21(positions[i].y, minimum.y, scale);
+			if (curve == CurveHilbert)
+			{
+				_axesToTranspose(axes[0], axes[1], 21);
+				keys[i] = ((SpaceFillingCurve::_spread2(axes[0]) << 1) | SpaceFillingCurve::_spread2(axes[1]));
+			}
+			else
+			{
+				keys[i] = (SpaceFillingCurve::_spread2(axes[0]) | (SpaceFillingCurve::_spread2(axes[1]) << 1));
+			}
+		}
+	}
+
+	void SpaceFillingCurve::computeKeys(const Vector3<float>* positions, int count, unsigned long long* keys, Curve curve)
+	{
+		if (count <= 0)
+		{
+			return;
+		}
+		Vector3<float> minimum = positions[0];
+		Vector3<float> maximum = positions[0];
+		for (int i = 1; i < count; ++i)
+		{
+			minimum.x = (positions[i].x < minimum.x ? positions[i].x : minimum.x);
+			minimum.y = (positions[i].y < minimum.y ? positions[i].y : minimum.y);
+			minimum.z = (positions[i].z < minimum.z ? positions[i].z : minimum.z);
+			maximum.x = (positions[i].x > maximum.x ? positions[i].x : maximum.x);
+			maximum.y = (positions[i].y > maximum.y ? positions[i].y : maximum.y);
+			maximum.z = (positions[i].z > maximum.z ? positions[i].z : maximum.z);
+		}
+		float extent = (maximum.x - minimum.x > maximum.y - minimum.y ? maximum.x - minimum.x : maximum.y - minimum.y);
+		extent = (maximum.z - minimum.z > extent ? maximum.z - minimum.z : extent);
+		float scale = (extent > 0.0f ? 2097151.0f / extent : 0.0f);
+		unsigned int axes[3] = { 0, 0, 0 };
+		for (int i = 0; i < count; ++i)
+		{
+			axes[0] = _quantize21(positions[i].x, minimum.x, scale);
+			axes[1] = _quantize21(positions[i].y, minimum.y, scale);
+			axes[2] = _quantize21(positions[i].z, minimum.z, scale);
+			if (curve == CurveHilbert)
+			{
+				_axesToTranspose(axes[0], axes[1], axes[2], 21);
+				keys[i] = ((SpaceFillingCurve::_spread3(axes[0]) << 2) | (SpaceFillingCurve::_spread3(axes[1]) << 1) | SpaceFillingCurve::_spread3(axes[2]));
+			}
+			else
+			{
+				keys[i] = (SpaceFillingCurve::_spread3(axes[0]) | (SpaceFillingCurve::_spread3(axes[1]) << 1) | (SpaceFillingCurve::_spread3(axes[2]) << 2));
+			}
+		}
+	}
+
+	void SpaceFillingCurve::computeKeys(const Vector2<int>* positions, int count, unsigned long long* keys, Curve curve)
+	{
+		if (count <= 0)
+		{
+			return;
+		}
+		Vector2<int> minimum = positions[0];
+		for (int i = 1; i < count; ++i)
+		{
+			minimum.x = (positions[i].x < minimum.x ? positions[i].x : minimum.x);
+			minimum.y = (positions[i].y < minimum.y ? positions[i].y : minimum.y);
+		}
+		// relative coordinates always fit into 32 bits
+		unsigned int axes[2] = { 0, 0 };
+		for (int i = 0; i < count; ++i)
+		{
+			axes[0] = (unsigned int)positions[i].x - (unsigned int)minimum.x;
+			axes[1] = (unsigned int)positions[i].y - (unsigned int)minimum.y;
+			if (curve == CurveHilbert)
+			{
+				_axesToTranspose(axes[0], axes[1], 32);
+				keys[i] = ((SpaceFillingCurve::_spread2(axes[0]) << 1) | SpaceFillingCurve::_spread2(axes[1]));
+			}
+			else
+			{
+				keys[i] = (SpaceFillingCurve::_spread2(axes[0]) | (SpaceFillingCurve::_spread2(axes[1]) << 1));
+			}
+		}
+	}
+
+	void SpaceFillingCurve::computeKeys(const Vector3<int>* positions, int count, unsigned long long* keys, Curve curve)
+	{
+		if (count <= 0)
+		{
+			return;
+		}
+		Vector3<int> minimum = positions[0];
+		Vector3<int> maximum = positions[0];
+		for (int i = 1; i < count; ++i)
+		{
+			minimum.x = (positions[i].x < minimum.x ? positions[i].x : minimum.x);
+			minimum.y = (positions[i].y < minimum.y ? positions[i].y : minimum.y);
+			minimum.z = (positions[i].z < minimum.z ? positions[i].z : minimum.z);
+			maximum.x = (positions[i].x > maximum.x ? positions[i].x : maximum.x);
+			maximum.y = (positions[i].y > maximum.y ? positions[i].y : maximum.y);
+			maximum.z = (positions[i].z > maximum.z ? positions[i].z : maximum.z);
+		}
+		unsigned int range = (unsigned int)maximum.x - (unsigned int)minimum.x;
+		range = ((unsigned int)maximum.y - (unsigned int)minimum.y > range ? (unsigned int)maximum.y - (unsigned int)minimum.y : range);
+		range = ((unsigned int)maximum.z - (unsigned int)minimum.z > range ? (unsigned int)maximum.z - (unsigned int)minimum.z : range);
+		int shift = 0;
+		while ((range >> shift) > 0x1FFFFFu)
+		{
+			++shift;
+		}
+		unsigned int axes[3] = { 0, 0, 0 };
+		for (int i = 0; i < count; ++i)
+		{
+			axes[0] = ((unsigned int)positions[i].x - (unsigned int)minimum.x) >> shift;
+			axes[1] = ((unsigned int)positions[i].y - (unsigned int)minimum.y) >> shift;
+			axes[2] = ((unsigned int)positions[i].z - (unsigned int)minimum.z) >> shift;
+			if (curve == CurveHilbert)
+			{
+				_axesToTranspose(axes[0], axes[1], axes[2], 21);
+				keys[i] = ((SpaceFillingCurve::_spread3(axes[0]) << 2) | (SpaceFillingCurve::_spread3(axes[1]) << 1) | SpaceFillingCurve::_spread3(axes[2]));
+			}
+			else
+			{
+				keys[i] = (SpaceFillingCurve::_spread3(axes[0]) | (SpaceFillingCurve::_spread3(axes[1]) << 1) | (SpaceFillingCurve::_spread3(axes[2]) << 2));
+			}
+		}
+	}
+
+	// one pass of the radix sort, every thread handles a contiguous range of the source
+	struct _RadixPass
+	{
+		const unsigned long long* keys;
+		const int* indices;
+		unsigned long long* resultKeys;
+		int* resultIndices;
+		int count;
+		int threadCount;
+		int shift;
+		unsigned int* histograms;
+	};
+
+	static void _radixHistogram(void* data, int index)
+	{
+		_RadixPass* pass = (_RadixPass*)data;
+		int begin = (int)((long long)pass->count * index / pass->threadCount);
+		int end = (int)((long long)pass->count * (index + 1) / pass->threadCount);
+		unsigned int* histogram = &pass->histograms[index * RADIX_SIZE];
+		memset(histogram, 0, RADIX_SIZE * sizeof(unsigned int));
+		const unsigned long long* keys = pass->keys;
+		int shift = pass->shift;
+		for (int i = begin; i < end; ++i)
+		{
+			++histogram[(keys[i] >> shift) & (RADIX_SIZE - 1)];
+		}
+	}
+
+	static void _radixScatter(void* data, int index)
+	{
+		_RadixPass* pass = (_RadixPass*)data;
+		int begin = (int)((long long)pass->count * index / pass->threadCount);
+		int end = (int)((long long)pass->count * (index + 1) / pass->threadCount);
+		unsigned int* offsets = &pass->histograms[index * RADIX_SIZE];
+		const unsigned long long* keys = pass->keys;
+		const int* indices = pass->indices;
+		unsigned long long* resultKeys = pass->resultKeys;
+		int* resultIndices = pass->resultIndices;
+		int shift = pass->shift;
+		unsigned int position = 0;
+		for (int i = begin; i < end; ++i)
+		{
+			position = offsets[(keys[i] >> shift) & (RADIX_SIZE - 1)]++;
+			// the keys are not needed anymore after the last pass
+			if (resultKeys != NULL)
+			{
+				resultKeys[position] = keys[i];
+			}
+			resultIndices[position] = (indices != NULL ? indices[i] : i);
+		}
+	}
+
+	void SpaceFillingCurve::sortKeys(const unsigned long long* keys, int count, int* permutation, int threadCount)
+	{
+		if (count <= 0)
+		{
+			return;
+		}
+		// only the digits with bits that differ between the keys need a pass
+		unsigned long long different = 0;
+		for (int i = 1; i < count; ++i)
+		{
+			different |= keys[i] ^ keys[0];
+		}
+		int shifts[(64 + RADIX_BITS - 1) / RADIX_BITS];
+		int passCount = 0;
+		for (int shift = 0; shift < 64; shift += RADIX_BITS)
+		{
+			if (((different >> shift) & (RADIX_SIZE - 1)) != 0)
+			{
+				shifts[passCount] = shift;
+				++passCount;
+			}
+		}
+		if (passCount == 0)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				permutation[i] = i;
+			}
+			return;
+		}
+		_RadixPass pass;
+		pass.count = count;
+		pass.threadCount = parallel::getThreadCount(threadCount, count, MINIMUM_KEYS_PER_THREAD);
+		std::vector<unsigned int> histograms(pass.threadCount * RADIX_SIZE);
+		pass.histograms = &histograms[0];
+		std::vector<unsigned long long> keyBuffers(passCount > 1 ? count * 2 : 1);
+		std::vector<int> indexBuffer(passCount > 1 ? count : 1);
+		// the passes alternate between the buffers so that the last one writes into permutation
+		int* indices[2] = { permutation, &indexBuffer[0] };
+		int target = (passCount % 2 == 1 ? 0 : 1);
+		pass.keys = keys;
+		pass.indices = NULL;
+		unsigned int offset = 0;
+		unsigned int bucketCount = 0;
+		for (int p = 0; p < passCount; ++p)
+		{
+			pass.shift = shifts[p];
+			pass.resultKeys = (p < passCount - 1 ? &keyBuffers[(p % 2) * count] : NULL);
+			pass.resultIndices = indices[target];
+			parallel::run(pass.threadCount, &_radixHistogram, &pass);
+			// exclusive prefix sum over the digits and, within a digit, over the threads in source order to keep the sort stable
+			offset = 0;
+			for (int digit = 0; digit < RADIX_SIZE; ++digit)
+			{
+				for (int t = 0; t < pass.threadCount; ++t)
+				{
+					bucketCount = histograms[t * RADIX_SIZE + digit];
+					histograms[t * RADIX_SIZE + digit] = offset;
+					offset += bucketCount;
+				}
+			}
+			parallel::run(pass.threadCount, &_radixScatter, &pass);
+			pass.keys = pass.resultKeys;
+			pass.indices = pass.resultIndices;
+			target = 1 - target;
+		}
+	}
+
+	namespace simd
+	{
+		static void encodeMorton2iScalar(const Vector2<int>* vectors, unsigned long long* keys, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				keys[i] = SpaceFillingCurve::encodeMorton(vectors[i]);
+			}
+		}
+
+		static void decodeMorton2iScalar(const unsigned long long* keys, Vector2<int>* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = SpaceFillingCurve::decodeMorton2(keys[i]);
+			}
+		}
+
+		static void encodeMorton3iScalar(const Vector3<int>* vectors, unsigned long long* keys, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				keys[i] = SpaceFillingCurve::encodeMorton(vectors[i]);
+			}
+		}
+
+		static void decodeMorton3iScalar(const unsigned long long* keys, Vector3<int>* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i] = SpaceFillingCurve::decodeMorton3(keys[i]);
+			}
+		}
+
+#if defined(GTYPES_SIMD_SSE) && (defined(__x86_64__) || defined(_M_X64))
+		// pdep and pext only exist for 64-bit operands in 64-bit mode
+		GTYPES_TARGET_AVX2 static void encodeMorton2iAvx2(const Vector2<int>* vectors, unsigned long long* keys, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				keys[i] = _pdep_u64((unsigned int)vectors[i].x ^ 0x80000000u, 0x5555555555555555ULL) | _pdep_u64((unsigned int)vectors[i].y ^ 0x80000000u, 0xAAAAAAAAAAAAAAAAULL);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void decodeMorton2iAvx2(const unsigned long long* keys, Vector2<int>* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i].x = (int)((unsigned int)_pext_u64(keys[i], 0x5555555555555555ULL) ^ 0x80000000u);
+				result[i].y = (int)((unsigned int)_pext_u64(keys[i], 0xAAAAAAAAAAAAAAAAULL) ^ 0x80000000u);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void encodeMorton3iAvx2(const Vector3<int>* vectors, unsigned long long* keys, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				keys[i] = _pdep_u64((unsigned int)vectors[i].x + 0x100000u, 0x1249249249249249ULL) | _pdep_u64((unsigned int)vectors[i].y + 0x100000u, 0x2492492492492492ULL) |
+					_pdep_u64((unsigned int)vectors[i].z + 0x100000u, 0x4924924924924924ULL);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void decodeMorton3iAvx2(const unsigned long long* keys, Vector3<int>* result, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				result[i].x = (int)_pext_u64(keys[i], 0x1249249249249249ULL) - 0x100000;
+				result[i].y = (int)_pext_u64(keys[i], 0x2492492492492492ULL) - 0x100000;
+				result[i].z = (int)_pext_u64(keys[i], 0x4924924924924924ULL) - 0x100000;
+			}
+		}
+#endif
+
+		void registerSpaceFillingCurveKernels(Kernels& kernels, Level level)
+		{
+			switch (level)
+			{
+			case LevelScalar:
+				kernels.encodeMorton2i = &encodeMorton2iScalar;
+				kernels.decodeMorton2i = &decodeMorton2iScalar;
+				kernels.encodeMorton3i = &encodeMorton3iScalar;
+				kernels.decodeMorton3i = &decodeMorton3iScalar;
+				break;
+#if defined(GTYPES_SIMD_SSE) && (defined(__x86_64__) || defined(_M_X64))
+			case LevelAvx2:
+				kernels.encodeMorton2i = &encodeMorton2iAvx2;
+				kernels.decodeMorton2i = &decodeMorton2iAvx2;
+				kernels.encodeMorton3i = &encodeMorton3iAvx2;
+				kernels.decodeMorton3i = &decodeMorton3iAvx2;
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+
+	}
+
+}
@@ -0,0 +1,253 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <vector>
+
+#include "SpatialHashGrid3.h"
+#include "Vector3.h"
+
+// cell coordinates are clamped to +-2^30 so that converting them is defined and loops over cells can't overflow
+#define CELL_COORDINATE_LIMIT 1073741824.0f
+
+namespace gtypes
+{
+	// floor() that is faster than the math library version, clamps infinite and huge values and maps NaN to the lowest cell
+	static inline int _cellCoordinate(float value)
+	{
+		if (!(value > -CELL_COORDINATE_LIMIT))
+		{
+			return -(int)CELL_COORDINATE_LIMIT;
+		}
+		if (value >= CELL_COORDINATE_LIMIT)
+		{
+			return (int)CELL_COORDINATE_LIMIT;
+		}
+		int result = (int)value;
+		return (value < (float)result ? result - 1 : result);
+	}
+
+	// number of cells from minimum to maximum, computed in double since it can exceed the int range
+	static inline double _cellSpan(int minimum, int maximum)
+	{
+		return ((double)maximum - (double)minimum + 1.0);
+	}
+
+	static inline unsigned int _hashCell(int x, int y, int z)
+	{
+		return (((unsigned int)x * 73856093u) ^ ((unsigned int)y * 19349663u) ^ ((unsigned int)z * 83492791u));
+	}
+
+	SpatialHashGrid3::SpatialHashGrid3(float cellSize, int tableSize) : cellSize(1.0f), tableSize(tableSize), _inverseCellSize(1.0f), _tableMask(0)
+	{
+		this->setCellSize(cellSize);
+		this->clear();
+	}
+
+	void SpatialHashGrid3::setCellSize(float value)
+	{
+		this->cellSize = value;
+		this->_inverseCellSize = 1.0f / value;
+	}
+
+	void SpatialHashGrid3::clear()
+	{
+		this->_tableMask = 0;
+		this->cellStarts.assign(2, 0);
+		this->entries.clear();
+	}
+
+	void SpatialHashGrid3::rebuild(const Vector3<float>* positions, int count)
+	{
+		// about 4 points per table entry keeps the table small enough to stay in cache while sorting
+		int requestedSize = (this->tableSize > 0 ? this->tableSize : count / 4);
+		unsigned int size = 1;
+		while (size < (unsigned int)requestedSize)
+		{
+			size <<= 1;
+		}
+		this->_tableMask = size - 1;
+		this->cellStarts.assign(size + 1, 0);
+		this->entries.resize(count);
+		this->_pointCells.resize(count);
+		if (count == 0)
+		{
+			return;
+		}
+		int* starts = &this->cellStarts[0];
+		unsigned int* pointCells = &this->_pointCells[0];
+		float inverse = this->_inverseCellSize;
+		unsigned int mask = this->_tableMask;
+		unsigned int cell = 0;
+		// counting sort: histogram of the hashed cells
+		for (int i = 0; i < count; ++i)
+		{
+			cell = _hashCell(_cellCoordinate(positions[i].x * inverse), _cellCoordinate(positions[i].y * inverse),
+				_cellCoordinate(positions[i].z * inverse)) & mask;
+			pointCells[i] = cell;
+			++starts[cell];
+		}
+		// inclusive prefix sum, every entry now points to the end of its range
+		int sum = 0;
+		for (unsigned int i = 0; i < size; ++i)
+		{
+			sum += starts[i];
+			starts[i] = sum;
+		}
+		starts[size] = count;
+		// scattering backwards moves every entry back to the start of its range and keeps the original order within a cell
+		Entry* entries = &this->entries[0];
+		Entry* entry = NULL;
+		for (int i = count - 1; i >= 0; --i)
+		{
+			entry = &entries[--starts[pointCells[i]]];
+			entry->position = positions[i];
+			entry->index = i;
+		}
+	}
+
+	int SpatialHashGrid3::findCandidates(const Vector3<float>& center, float radius, int* result, int maxCount) const
+	{
+		return this->_find(center, radius, false, result, maxCount);
+	}
+
+	int SpatialHashGrid3::findInSphere(const Vector3<float>& center, float radius, int* result, int maxCount) const
+	{
+		return this->_find(center, radius, true, result, maxCount);
+	}
+
+	void SpatialHashGrid3::findInSphere(const Vector3<float>& center, float radius, std::vector<int>& result) const
+	{
+		if (result.size() < result.capacity())
+		{
+			result.resize(result.capacity());
+		}
+		int count = this->_find(center, radius, true, (result.size() > 0 ? &result[0] : NULL), (int)result.size());
+		if (count > (int)result.size())
+		{
+			result.resize(count);
+			this->_find(center, radius, true, &result[0], count);
+		}
+		result.resize(count);
+	}
+
+	int SpatialHashGrid3::filterInSphere(const Vector3<float>* positions, const int* indices, int count, const Vector3<float>& center, float radius, int* result)
+	{
+		float squaredRadius = radius * radius;
+		float dx = 0.0f;
+		float dy = 0.0f;
+		float dz = 0.0f;
+		int found = 0;
+		int index = 0;
+		for (int i = 0; i < count; ++i)
+		{
+			index = indices[i];
+			dx = positions[index].x - center.x;
+			dy = positions[index].y - center.y;
+			dz = positions[index].z - center.z;
+			result[found] = index;
+			found += (dx * dx + dy * dy + dz * dz <= squaredRadius ? 1 : 0);
+		}
+		return found;
+	}
+
+	int SpatialHashGrid3::_find(const Vector3<float>& center, float radius, bool filter, int* result, int maxCount) const
+	{
+		int count = (int)this->entries.size();
+		if (count == 0)
+		{
+			return 0;
+		}
+		float inverse = this->_inverseCellSize;
+		unsigned int mask = this->_tableMask;
+		int minX = _cellCoordinate((center.x - radius) * inverse);
+		int maxX = _cellCoordinate((center.x + radius) * inverse);
+		int minY = _cellCoordinate((center.y - radius) * inverse);
+		int maxY = _cellCoordinate((center.y + radius) * inverse);
+		int minZ = _cellCoordinate((center.z - radius) * inverse);
+		int maxZ = _cellCoordinate((center.z + radius) * inverse);
+		float squaredRadius = radius * radius;
+		const int* starts = &this->cellStarts[0];
+		const Entry* entries = &this->entries[0];
+		int found = 0;
+		float dx = 0.0f;
+		float dy = 0.0f;
+		float dz = 0.0f;
+		// when the sphere covers more cells than there are table entries, a linear scan is cheaper
+		if (_cellSpan(minX, maxX) * _cellSpan(minY, maxY) * _cellSpan(minZ, maxZ) > (double)mask + 1.0)
+		{
+			int x = 0;
+			int y = 0;
+			int z = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				x = _cellCoordinate(entries[i].position.x * inverse);
+				y = _cellCoordinate(entries[i].position.y * inverse);
+				z = _cellCoordinate(entries[i].position.z * inverse);
+				if (x < minX || x > maxX || y < minY || y > maxY || z < minZ || z > maxZ)
+				{
+					continue;
+				}
+				if (filter)
+				{
+					dx = entries[i].position.x - center.x;
+					dy = entries[i].position.y - center.y;
+					dz = entries[i].position.z - center.z;
+					if (dx * dx + dy * dy + dz * dz > squaredRadius)
+					{
+						continue;
+					}
+				}
+				if (found < maxCount)
+				{
+					result[found] = entries[i].index;
+				}
+				++found;
+			}
+			return found;
+		}
+		unsigned int cell = 0;
+		int end = 0;
+		for (int z = minZ; z <= maxZ; ++z)
+		{
+			for (int y = minY; y <= maxY; ++y)
+			{
+				for (int x = minX; x <= maxX; ++x)
+				{
+					cell = _hashCell(x, y, z) & mask;
+					end = starts[cell + 1];
+					for (int i = starts[cell]; i < end; ++i)
+					{
+						if (filter)
+						{
+							dx = entries[i].position.x - center.x;
+							dy = entries[i].position.y - center.y;
+							dz = entries[i].position.z - center.z;
+							if (dx * dx + dy * dy + dz * dz > squaredRadius)
+							{
+								continue;
+							}
+						}
+						// other cells can share the same table entry, this also prevents duplicates when the entry is visited again
+						if (_cellCoordinate(entries[i].position.x * inverse) != x || _cellCoordinate(entries[i].position.y * inverse) != y ||
+								_cellCoordinate(entries[i].position.z * inverse) != z)
+						{
+							continue;
+						}
+						if (found < maxCount)
+						{
+							result[found] = entries[i].index;
+						}
+						++found;
+					}
+				}
+			}
+		}
+		return found;
+	}
+
+}
@@ -0,0 +1,493 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <vector>
+
+#include "Rectangle.h"
+#include "SpaceFillingCurve.h"
+#include "SweepAndPrune.h"
+
+// marks an unused slot of the pair hash set, the smaller id of a pair is never larger than the other one
+#define EMPTY_PAIR 0xFFFFFFFFFFFFFFFFULL
+// smallest size of the pair hash set
+#define MINIMUM_PAIR_SLOTS 64
+
+namespace gtypes
+{
+	static inline unsigned long long _pairKey(int a, int b)
+	{
+		return (a < b ? ((unsigned long long)a << 32) | (unsigned int)b : ((unsigned long long)b << 32) | (unsigned int)a);
+	}
+
+	static inline SweepAndPrune::Pair _keyPair(unsigned long long key)
+	{
+		SweepAndPrune::Pair result;
+		result.first = (int)(key >> 32);
+		result.second = (int)(key & 0xFFFFFFFFu);
+		return result;
+	}
+
+	// the pair keys are very regular so they are mixed before masking
+	static inline unsigned int _hashPair(unsigned long long key)
+	{
+		key *= 0x9E3779B97F4A7C15ULL;
+		return (unsigned int)(key ^ (key >> 32));
+	}
+
+	// maps a float to an unsigned int with the same order, -0 is folded into +0 first to match the float comparison
+	static inline unsigned int _sortableBits(float value)
+	{
+		union
+		{
+			float f;
+			unsigned int i;
+		} bits;
+		bits.f = value + 0.0f;
+		return ((bits.i & 0x80000000u) != 0 ? ~bits.i : bits.i | 0x80000000u);
+	}
+
+	// right edges come before left edges at the same position so touching Rectangles do not overlap
+	template <typename Edge>
+	static inline bool _isEdgeBefore(const Edge& a, const Edge& b)
+	{
+		return (a.value < b.value || (a.value == b.value && (a.code & 1) > (b.code & 1)));
+	}
+
+	SweepAndPrune::SweepAndPrune() : count(0), pairCount(0)
+	{
+	}
+
+	int SweepAndPrune::insert(const Rectangle<float>& rectangle)
+	{
+		int id = 0;
+		if (this->_freeIds.size() > 0)
+		{
+			id = this->_freeIds.back();
+			this->_freeIds.pop_back();
+		}
+		else
+		{
+			id = (int)this->items.size();
+			this->items.push_back(Item());
+		}
+		this->items[id].rectangle = rectangle;
+		this->items[id].state = StateInserted;
+		this->_insertedIds.push_back(id);
+		++this->count;
+		return id;
+	}
+
+	bool SweepAndPrune::remove(int id)
+	{
+		if (!this->isValid(id))
+		{
+			return false;
+		}
+		// a Rectangle without edges has no pairs yet and its id can be reused right away
+		if (this->items[id].state == StateInserted)
+		{
+			this->items[id].state = StateFree;
+			this->_freeIds.push_back(id);
+		}
+		else
+		{
+			this->items[id].state = StateRemoved;
+			this->_removedIds.push_back(id);
+		}
+		--this->count;
+		return true;
+	}
+
+	bool SweepAndPrune::move(int id, const Rectangle<float>& rectangle)
+	{
+		if (!this->isValid(id))
+		{
+			return false;
+		}
+		this->items[id].rectangle = rectangle;
+		return true;
+	}
+
+	void SweepAndPrune::clear()
+	{
+		this->count = 0;
+		this->pairCount = 0;
+		this->items.clear();
+		this->edgesX.clear();
+		this->edgesY.clear();
+		this->pairs.clear();
+		this->_freeIds.clear();
+		this->_insertedIds.clear();
+		this->_removedIds.clear();
+	}
+
+	void SweepAndPrune::update(std::vector<Pair>& added, std::vector<Pair>& removed)
+	{
+		added.clear();
+		removed.clear();
+		this->_applyChanges(removed);
+		this->_updateEdges(this->edgesX, false);
+		this->_updateEdges(this->edgesY, true);
+		this->_sortEdges(this->edgesX, added, removed);
+		this->_sortEdges(this->edgesY, added, removed);
+	}
+
+	void SweepAndPrune::rebuild(std::vector<Pair>& added, std::vector<Pair>& removed, int threadCount)
+	{
+		added.clear();
+		removed.clear();
+		this->_applyChanges(removed);
+		int size = (int)this->edgesX.size();
+		this->_foundPairs.clear();
+		if (size > 0)
+		{
+			std::vector<unsigned long long> keys(size);
+			std::vector<int> permutation(size);
+			std::vector<Edge> sorted(size);
+			for (int axis = 0; axis < 2; ++axis)
+			{
+				std::vector<Edge>& edges = (axis == 0 ? this->edgesX : this->edgesY);
+				this->_updateEdges(edges, axis == 1);
+				// the lowest bit sorts right edges before left edges at the same position like _isEdgeBefore()
+				for (int i = 0; i < size; ++i)
+				{
+					keys[i] = ((unsigned long long)_sortableBits(edges[i].value) << 1) | (unsigned long long)(1 - (edges[i].code & 1));
+				}
+				SpaceFillingCurve::sortKeys(&keys[0], size, &permutation[0], threadCount);
+				for (int i = 0; i < size; ++i)
+				{
+					sorted[i] = edges[permutation[i]];
+				}
+				edges.swap(sorted);
+			}
+			// sweep along the x axis, every left edge is checked against the Rectangles that are open at that position
+			std::vector<int> open;
+			std::vector<int> openIndices(this->items.size(), -1);
+			int id = 0;
+			int last = 0;
+			for (int i = 0; i < size; ++i)
+			{
+				id = this->edgesX[i].code >> 1;
+				if ((this->edgesX[i].code & 1) != 0)
+				{
+					if (openIndices[id] >= 0)
+					{
+						last = open.back();
+						open[openIndices[id]] = last;
+						openIndices[last] = openIndices[id];
+						open.pop_back();
+						openIndices[id] = -1;
+					}
+					continue;
+				}
+				const Rectangle<float>& rectangle = this->items[id].rectangle;
+				for (unsigned int j = 0; j < open.size(); ++j)
+				{
+					if (rectangle.intersects(this->items[open[j]].rectangle))
+					{
+						this->_foundPairs.push_back(_pairKey(id, open[j]));
+					}
+				}
+				// without width the right edge was already passed
+				if (rectangle.x + rectangle.w > rectangle.x)
+				{
+					openIndices[id] = (int)open.size();
+					open.push_back(id);
+				}
+			}
+		}
+		int foundCount = (int)this->_foundPairs.size();
+		for (int i = 0; i < foundCount; ++i)
+		{
+			if (!this->_findPair(this->_foundPairs[i]))
+			{
+				added.push_back(_keyPair(this->_foundPairs[i]));
+			}
+		}
+		std::vector<unsigned long long> previous;
+		previous.swap(this->pairs);
+		this->pairCount = 0;
+		this->_reservePairs(foundCount);
+		for (int i = 0; i < foundCount; ++i)
+		{
+			this->_insertPair(this->_foundPairs[i]);
+		}
+		for (unsigned int i = 0; i < previous.size(); ++i)
+		{
+			if (previous[i] != EMPTY_PAIR && !this->_findPair(previous[i]))
+			{
+				removed.push_back(_keyPair(previous[i]));
+			}
+		}
+	}
+
+	bool SweepAndPrune::isOverlapping(int first, int second) const
+	{
+		if (first < 0 || second < 0 || first == second)
+		{
+			return false;
+		}
+		return this->_findPair(_pairKey(first, second));
+	}
+
+	void SweepAndPrune::getPairs(std::vector<Pair>& result) const
+	{
+		result.clear();
+		result.reserve(this->pairCount);
+		for (unsigned int i = 0; i < this->pairs.size(); ++i)
+		{
+			if (this->pairs[i] != EMPTY_PAIR)
+			{
+				result.push_back(_keyPair(this->pairs[i]));
+			}
+		}
+	}
+
+	void SweepAndPrune::_updateEdges(std::vector<Edge>& edges, bool vertical) const
+	{
+		int size = (int)edges.size();
+		if (size == 0)
+		{
+			return;
+		}
+		Edge* data = &edges[0];
+		const Item* items = &this->items[0];
+		if (vertical)
+		{
+			for (int i = 0; i < size; ++i)
+			{
+				const Rectangle<float>& rectangle = items[data[i].code >> 1].rectangle;
+				data[i].value = ((data[i].code & 1) != 0 ? rectangle.y + rectangle.h : rectangle.y);
+			}
+		}
+		else
+		{
+			for (int i = 0; i < size; ++i)
+			{
+				const Rectangle<float>& rectangle = items[data[i].code >> 1].rectangle;
+				data[i].value = ((data[i].code & 1) != 0 ? rectangle.x + rectangle.w : rectangle.x);
+			}
+		}
+	}
+
+	void SweepAndPrune::_applyChanges(std::vector<Pair>& removed)
+	{
+		if (this->_removedIds.size() > 0)
+		{
+			// the pairs are collected first since erasing moves other pairs in the hash set
+			this->_foundPairs.clear();
+			for (unsigned int i = 0; i < this->pairs.size(); ++i)
+			{
+				if (this->pairs[i] != EMPTY_PAIR && (this->items[(int)(this->pairs[i] >> 32)].state == StateRemoved ||
+					this->items[(int)(this->pairs[i] & 0xFFFFFFFFu)].state == StateRemoved))
+				{
+					this->_foundPairs.push_back(this->pairs[i]);
+				}
+			}
+			for (unsigned int i = 0; i < this->_foundPairs.size(); ++i)
+			{
+				this->_erasePair(this->_foundPairs[i]);
+				removed.push_back(_keyPair(this->_foundPairs[i]));
+			}
+			// dropping edges keeps the others sorted
+			for (int axis = 0; axis < 2; ++axis)
+			{
+				std::vector<Edge>& edges = (axis == 0 ? this->edgesX : this->edgesY);
+				int size = 0;
+				for (unsigned int i = 0; i < edges.size(); ++i)
+				{
+					if (this->items[edges[i].code >> 1].state != StateRemoved)
+					{
+						edges[size] = edges[i];
+						++size;
+					}
+				}
+				edges.resize(size);
+			}
+			for (unsigned int i = 0; i < this->_removedIds.size(); ++i)
+			{
+				this->items[this->_removedIds[i]].state = StateFree;
+				this->_freeIds.push_back(this->_removedIds[i]);
+			}
+			this->_removedIds.clear();
+		}
+		// new edges are appended after all others, which matches their Rectangles not overlapping anything yet
+		Edge edge;
+		for (unsigned int i = 0; i < this->_insertedIds.size(); ++i)
+		{
+			int id = this->_insertedIds[i];
+			// an id can be listed twice if it was removed and reused before the update
+			if (this->items[id].state != StateInserted)
+			{
+				continue;
+			}
+			this->items[id].state = StateActive;
+			edge.value = 0.0f;
+			edge.code = id << 1;
+			this->edgesX.push_back(edge);
+			this->edgesY.push_back(edge);
+			edge.code |= 1;
+			this->edgesX.push_back(edge);
+			this->edgesY.push_back(edge);
+		}
+		this->_insertedIds.clear();
+	}
+
+	void SweepAndPrune::_sortEdges(std::vector<Edge>& edges, std::vector<Pair>& added, std::vector<Pair>& removed)
+	{
+		int size = (int)edges.size();
+		if (size == 0)
+		{
+			return;
+		}
+		Edge* data = &edges[0];
+		Edge edge;
+		int j = 0;
+		int id = 0;
+		int otherId = 0;
+		unsigned long long key = 0;
+		for (int i = 1; i < size; ++i)
+		{
+			edge = data[i];
+			id = edge.code >> 1;
+			for (j = i; j > 0 && _isEdgeBefore(edge, data[j - 1]); --j)
+			{
+				// insertion sort swaps every pair of edges at most once, only a left edge passing a right edge changes the overlap
+				otherId = data[j - 1].code >> 1;
+				if ((edge.code & 1) != (data[j - 1].code & 1) && id != otherId)
+				{
+					key = _pairKey(id, otherId);
+					if ((edge.code & 1) == 0)
+					{
+						// the other axis may not be sorted yet, but the final Rectangles decide
+						if (this->items[id].rectangle.intersects(this->items[otherId].rectangle) && this->_insertPair(key))
+						{
+							added.push_back(_keyPair(key));
+						}
+					}
+					else if (this->_erasePair(key))
+					{
+						removed.push_back(_keyPair(key));
+					}
+				}
+				data[j] = data[j - 1];
+			}
+			data[j] = edge;
+		}
+	}
+
+	bool SweepAndPrune::_insertPair(unsigned long long key)
+	{
+		this->_reservePairs(this->pairCount + 1);
+		unsigned int mask = (unsigned int)this->pairs.size() - 1;
+		unsigned int slot = _hashPair(key) & mask;
+		while (this->pairs[slot] != EMPTY_PAIR)
+		{
+			if (this->pairs[slot] == key)
+			{
+				return false;
+			}
+			slot = (slot + 1) & mask;
+		}
+		this->pairs[slot] = key;
+		++this->pairCount;
+		return true;
+	}
+
+	bool SweepAndPrune::_erasePair(unsigned long long key)
+	{
+		if (this->pairCount == 0)
+		{
+			return false;
+		}
+		unsigned int mask = (unsigned int)this->pairs.size() - 1;
+		unsigned int slot = _hashPair(key) & mask;
+		while (this->pairs[slot] != key)
+		{
+			if (this->pairs[slot] == EMPTY_PAIR)
+			{
+				return false;
+			}
+			slot = (slot + 1) & mask;
+		}
+		// shift the following pairs of the probe sequence back so that no gap breaks it
+		unsigned int next = slot;
+		unsigned int home = 0;
+		while (true)
+		{
+			next = (next + 1) & mask;
+			if (this->pairs[next] == EMPTY_PAIR)
+			{
+				break;
+			}
+			home = _hashPair(this->pairs[next]) & mask;
+			if (((next - home) & mask) >= ((next - slot) & mask))
+			{
+				this->pairs[slot] = this->pairs[next];
+				slot = next;
+			}
+		}
+		this->pairs[slot] = EMPTY_PAIR;
+		--this->pairCount;
+		return true;
+	}
+
+	bool SweepAndPrune::_findPair(unsigned long long key) const
+	{
+		if (this->pairCount == 0)
+		{
+			return false;
+		}
+		unsigned int mask = (unsigned int)this->pairs.size() - 1;
+		unsigned int slot = _hashPair(key) & mask;
+		while (this->pairs[slot] != EMPTY_PAIR)
+		{
+			if (this->pairs[slot] == key)
+			{
+				return true;
+			}
+			slot = (slot + 1) & mask;
+		}
+		return false;
+	}
+
+	void SweepAndPrune::_reservePairs(int pairCount)
+	{
+		// at most half of the slots are used to keep the probe sequences short
+		unsigned int size = (unsigned int)this->pairs.size();
+		if ((unsigned int)pairCount * 2 <= size)
+		{
+			return;
+		}
+		if (size < MINIMUM_PAIR_SLOTS)
+		{
+			size = MINIMUM_PAIR_SLOTS;
+		}
+		while (size < (unsigned int)pairCount * 2)
+		{
+			size <<= 1;
+		}
+		std::vector<unsigned long long> previous(size, EMPTY_PAIR);
+		previous.swap(this->pairs);
+		unsigned int mask = size - 1;
+		unsigned int slot = 0;
+		for (unsigned int i = 0; i < previous.size(); ++i)
+		{
+			if (previous[i] != EMPTY_PAIR)
+			{
+				slot = _hashPair(previous[i]) & mask;
+				while (this->pairs[slot] != EMPTY_PAIR)
+				{
+					slot = (slot + 1) & mask;
+				}
+				this->pairs[slot] = previous[i];
+			}
+		}
+	}
+
+}
@@ -0,0 +1,781 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <math.h>
+
+#include "gtypesSimd.h"
+#include "gtypesSimdKernels.h"
+#include "Vector2.h"
+
+namespace gtypes
+{
+	namespace simd
+	{
+		static void normalizeFastVector2fScalar(Vector2<float>* vectors, int count)
+		{
+			float squaredLength = 0.0f;
+			for (int i = 0; i < count; ++i)
+			{
+				squaredLength = vectors[i].squaredLength();
+				if (squaredLength != 0.0f)
+				{
+					vectors[i] *= 1.0f / sqrtf(squaredLength);
+				}
+			}
+		}
+
+		// sin() and cos() of an angle in degrees, reduced exactly to [-45, 45] degrees by the nearest multiple of 90
+		static inline void _sinCosFast(float degrees, float& sine, float& cosine)
+		{
+			float scaled = degrees * (1.0f / 90.0f);
+			int quadrant = (int)(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+			float r = DEG_TO_RAD_F(degrees - (float)quadrant * 90.0f);
+			float z = r * r;
+			float s = r + r * z * ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f);
+			float c = 1.0f - 0.5f * z + z * z * ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f);
+			if ((quadrant & 1) != 0)
+			{
+				float swap = s;
+				s = c;
+				c = swap;
+			}
+			sine = ((quadrant & 2) != 0 ? -s : s);
+			cosine = (((quadrant + 1) & 2) != 0 ? -c : c);
+		}
+
+		static void anglesVector2fScalar(const Vector2<float>* vectors, float* angles, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				angles[i] = vectors[i].angleFast();
+			}
+		}
+
+		static void fromAnglesVector2fScalar(const float* angles, Vector2<float>* vectors, int count)
+		{
+			float sine = 0.0f;
+			float cosine = 0.0f;
+			for (int i = 0; i < count; ++i)
+			{
+				_sinCosFast(angles[i], sine, cosine);
+				vectors[i].x = cosine;
+				vectors[i].y = -sine;
+			}
+		}
+
+		static void maskInCircle2fScalar(const float* x, const float* y, int stride, int count, float centerX, float centerY, float radius, unsigned int* mask)
+		{
+			float squaredRadius = radius * radius;
+			float dx = 0.0f;
+			float dy = 0.0f;
+			unsigned int bits = 0;
+			int size = 0;
+			for (int i = 0; i < count; i += 32)
+			{
+				size = (count - i < 32 ? count - i : 32);
+				bits = 0;
+				for (int j = 0; j < size; ++j)
+				{
+					dx = x[(i + j) * stride] - centerX;
+					dy = y[(i + j) * stride] - centerY;
+					bits |= (dx * dx + dy * dy <= squaredRadius ? 1u : 0u) << j;
+				}
+				mask[i / 32] = bits;
+			}
+		}
+
+		// shared by all levels, calls the mask and compress kernels of the current level
+		static int findInCircle2f(const float* x, const float* y, int stride, int count, float centerX, float centerY, float radius, int* result)
+		{
+			const Kernels& kernels = getKernels();
+			unsigned int mask[32];
+			int found = 0;
+			int size = 0;
+			// blocks of 1024 points keep the mask in the L1 cache between both passes
+			for (int i = 0; i < count; i += 1024)
+			{
+				size = (count - i < 1024 ? count - i : 1024);
+				kernels.maskInCircle2f(x + i * stride, y + i * stride, stride, size, centerX, centerY, radius, mask);
+				found += kernels.compressMask(mask, size, i, result + found);
+			}
+			return found;
+		}
+
+#if defined(GTYPES_SIMD_SSE)
+		static void normalizeFastVector2fSse2(Vector2<float>* vectors, int count)
+		{
+			int i = 0;
+			// 4 Vector2s at once, the 8 floats are deinterleaved for the length calculation
+			for (; i + 4 <= count; i += 4)
+			{
+				float* data = &vectors[i].x;
+				__m128 a = _mm_loadu_ps(data); // x0 y0 x1 y1
+				__m128 b = _mm_loadu_ps(data + 4); // x2 y2 x3 y3
+				__m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				__m128 y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+				__m128 inverse = rsqrtNonZero(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+				_mm_storeu_ps(data, _mm_mul_ps(a, _mm_unpacklo_ps(inverse, inverse)));
+				_mm_storeu_ps(data + 4, _mm_mul_ps(b, _mm_unpackhi_ps(inverse, inverse)));
+			}
+			for (; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
+
+		static void anglesVector2fSse2(const Vector2<float>* vectors, float* angles, int count)
+		{
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			__m128 zero = _mm_setzero_ps();
+			int i = 0;
+			// same steps as simd::atan2Fast() with selects instead of branches
+			for (; i + 4 <= count; i += 4)
+			{
+				const float* data = &vectors[i].x;
+				__m128 a = _mm_loadu_ps(data);
+				__m128 b = _mm_loadu_ps(data + 4);
+				__m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				__m128 y = _mm_xor_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), signMask);
+				__m128 absX = _mm_andnot_ps(signMask, x);
+				__m128 absY = _mm_andnot_ps(signMask, y);
+				__m128 maxValue = _mm_max_ps(absX, absY);
+				// 0 / 0 gives NaN, the mask turns it into 0
+				__m128 t = _mm_and_ps(_mm_div_ps(_mm_min_ps(absX, absY), maxValue), _mm_cmpgt_ps(maxValue, zero));
+				__m128 s = _mm_mul_ps(t, t);
+				__m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-0.01172120f), s), _mm_set1_ps(0.05265332f));
+				result = _mm_add_ps(_mm_mul_ps(result, s), _mm_set1_ps(-0.11643287f));
+				result = _mm_add_ps(_mm_mul_ps(result, s), _mm_set1_ps(0.19354346f));
+				result = _mm_add_ps(_mm_mul_ps(result, s), _mm_set1_ps(-0.33262347f));
+				result = _mm_add_ps(_mm_mul_ps(result, s), _mm_set1_ps(0.99997726f));
+				result = _mm_mul_ps(result, t);
+				__m128 mask = _mm_cmpgt_ps(absY, absX);
+				result = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(_mm_set1_ps(1.57079637f), result)), _mm_andnot_ps(mask, result));
+				mask = _mm_cmplt_ps(x, zero);
+				result = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(_mm_set1_ps(3.14159274f), result)), _mm_andnot_ps(mask, result));
+				result = _mm_or_ps(result, _mm_and_ps(y, signMask));
+				_mm_storeu_ps(angles + i, _mm_mul_ps(result, _mm_set1_ps(57.2957795130823208768f)));
+			}
+			for (; i < count; ++i)
+			{
+				angles[i] = vectors[i].angleFast();
+			}
+		}
+
+		static void fromAnglesVector2fSse2(const float* angles, Vector2<float>* vectors, int count)
+		{
+			__m128i one = _mm_set1_epi32(1);
+			__m128i two = _mm_set1_epi32(2);
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			float sine = 0.0f;
+			float cosine = 0.0f;
+			int i = 0;
+			// same steps as _sinCosFast(), the quadrant swaps and negates through masks and sign bits
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 degrees = _mm_loadu_ps(angles + i);
+				__m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(degrees, _mm_set1_ps(1.0f / 90.0f)));
+				__m128 r = _mm_sub_ps(degrees, _mm_mul_ps(_mm_cvtepi32_ps(quadrant), _mm_set1_ps(90.0f)));
+				r = _mm_mul_ps(r, _mm_set1_ps(0.0174532925199432957692f));
+				__m128 z = _mm_mul_ps(r, r);
+				__m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+				s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(-1.6666654611e-1f));
+				s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), s));
+				__m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+				c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(4.166664568298827e-2f));
+				c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_mul_ps(_mm_mul_ps(z, z), c));
+				__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+				__m128 sinValue = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+				__m128 cosValue = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+				// bit 1 of the quadrant moved to the sign bit, y is -sin() so its sign is flipped once more
+				sinValue = _mm_xor_ps(sinValue, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30)));
+				cosValue = _mm_xor_ps(cosValue, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30)));
+				sinValue = _mm_xor_ps(sinValue, signMask);
+				float* data = &vectors[i].x;
+				_mm_storeu_ps(data, _mm_unpacklo_ps(cosValue, sinValue));
+				_mm_storeu_ps(data + 4, _mm_unpackhi_ps(cosValue, sinValue));
+			}
+			for (; i < count; ++i)
+			{
+				_sinCosFast(angles[i], sine, cosine);
+				vectors[i].x = cosine;
+				vectors[i].y = -sine;
+			}
+		}
+
+		// the squared distance is calculated without FMA in all versions so the results match Vector2::isInCircle()
+		template <int Stride>
+		static void _maskInCircle2fSse2(const float* x, const float* y, int count, float centerX, float centerY, float radius, unsigned int* mask)
+		{
+			__m128 cx = _mm_set1_ps(centerX);
+			__m128 cy = _mm_set1_ps(centerY);
+			__m128 squaredRadius = _mm_set1_ps(radius * radius);
+			__m128 dx;
+			__m128 dy;
+			unsigned int bits = 0;
+			int i = 0;
+			// one mask word of 32 points per step, 4 points at once
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = 0;
+				for (int j = 0; j < 32; j += 4)
+				{
+					if (Stride == 2)
+					{
+						__m128 a = _mm_loadu_ps(x + (i + j) * 2);
+						__m128 b = _mm_loadu_ps(x + (i + j) * 2 + 4);
+						dx = _mm_sub_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), cx);
+						dy = _mm_sub_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), cy);
+					}
+					else
+					{
+						dx = _mm_sub_ps(_mm_loadu_ps(x + i + j), cx);
+						dy = _mm_sub_ps(_mm_loadu_ps(y + i + j), cy);
+					}
+					__m128 inside = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), squaredRadius);
+					bits |= (unsigned int)_mm_movemask_ps(inside) << j;
+				}
+				mask[i / 32] = bits;
+			}
+			if (i < count)
+			{
+				maskInCircle2fScalar(x + i * Stride, y + i * Stride, Stride, count - i, centerX, centerY, radius, mask + i / 32);
+			}
+		}
+
+		static void maskInCircle2fSse2(const float* x, const float* y, int stride, int count, float centerX, float centerY, float radius, unsigned int* mask)
+		{
+			if (stride == 2)
+			{
+				_maskInCircle2fSse2<2>(x, y, count, centerX, centerY, radius, mask);
+			}
+			else
+			{
+				_maskInCircle2fSse2<1>(x, y, count, centerX, centerY, radius, mask);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void normalizeFastVector2fAvx2(Vector2<float>* vectors, int count)
+		{
+			int i = 0;
+			// 8 Vector2s at once, x*x and y*y are summed within each pair so no deinterleaving is needed
+			for (; i + 8 <= count; i += 8)
+			{
+				float* data = &vectors[i].x;
+				__m256 a = _mm256_loadu_ps(data);
+				__m256 b = _mm256_loadu_ps(data + 8);
+				__m256 sa = _mm256_mul_ps(a, a);
+				__m256 sb = _mm256_mul_ps(b, b);
+				sa = _mm256_add_ps(sa, _mm256_permute_ps(sa, _MM_SHUFFLE(2, 3, 0, 1)));
+				sb = _mm256_add_ps(sb, _mm256_permute_ps(sb, _MM_SHUFFLE(2, 3, 0, 1)));
+				_mm256_storeu_ps(data, _mm256_mul_ps(a, rsqrtNonZero(sa)));
+				_mm256_storeu_ps(data + 8, _mm256_mul_ps(b, rsqrtNonZero(sb)));
+			}
+			for (; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void anglesVector2fAvx2(const Vector2<float>* vectors, float* angles, int count)
+		{
+			__m256 signMask = _mm256_set1_ps(-0.0f);
+			__m256 zero = _mm256_setzero_ps();
+			int i = 0;
+			// 8 Vector2s at once, the in-lane shuffles put the results in the order 0 1 4 5 2 3 6 7 which is fixed at the end
+			for (; i + 8 <= count; i += 8)
+			{
+				const float* data = &vectors[i].x;
+				__m256 a = _mm256_loadu_ps(data);
+				__m256 b = _mm256_loadu_ps(data + 8);
+				__m256 x = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				__m256 y = _mm256_xor_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), signMask);
+				__m256 absX = _mm256_andnot_ps(signMask, x);
+				__m256 absY = _mm256_andnot_ps(signMask, y);
+				__m256 maxValue = _mm256_max_ps(absX, absY);
+				__m256 t = _mm256_and_ps(_mm256_div_ps(_mm256_min_ps(absX, absY), maxValue), _mm256_cmp_ps(maxValue, zero, _CMP_GT_OQ));
+				__m256 s = _mm256_mul_ps(t, t);
+				__m256 result = _mm256_fmadd_ps(_mm256_set1_ps(-0.01172120f), s, _mm256_set1_ps(0.05265332f));
+				result = _mm256_fmadd_ps(result, s, _mm256_set1_ps(-0.11643287f));
+				result = _mm256_fmadd_ps(result, s, _mm256_set1_ps(0.19354346f));
+				result = _mm256_fmadd_ps(result, s, _mm256_set1_ps(-0.33262347f));
+				result = _mm256_fmadd_ps(result, s, _mm256_set1_ps(0.99997726f));
+				result = _mm256_mul_ps(result, t);
+				result = _mm256_blendv_ps(result, _mm256_sub_ps(_mm256_set1_ps(1.57079637f), result), _mm256_cmp_ps(absY, absX, _CMP_GT_OQ));
+				result = _mm256_blendv_ps(result, _mm256_sub_ps(_mm256_set1_ps(3.14159274f), result), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+				result = _mm256_or_ps(result, _mm256_and_ps(y, signMask));
+				result = _mm256_mul_ps(result, _mm256_set1_ps(57.2957795130823208768f));
+				result = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(result), _MM_SHUFFLE(3, 1, 2, 0)));
+				_mm256_storeu_ps(angles + i, result);
+			}
+			for (; i < count; ++i)
+			{
+				angles[i] = vectors[i].angleFast();
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void fromAnglesVector2fAvx2(const float* angles, Vector2<float>* vectors, int count)
+		{
+			__m256i one = _mm256_set1_epi32(1);
+			__m256i two = _mm256_set1_epi32(2);
+			__m256 signMask = _mm256_set1_ps(-0.0f);
+			float sine = 0.0f;
+			float cosine = 0.0f;
+			int i = 0;
+			// 8 angles at once, same approach as the SSE2 version
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 degrees = _mm256_loadu_ps(angles + i);
+				__m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(degrees, _mm256_set1_ps(1.0f / 90.0f)));
+				__m256 r = _mm256_fnmadd_ps(_mm256_cvtepi32_ps(quadrant), _mm256_set1_ps(90.0f), degrees);
+				r = _mm256_mul_ps(r, _mm256_set1_ps(0.0174532925199432957692f));
+				__m256 z = _mm256_mul_ps(r, r);
+				__m256 s = _mm256_fmadd_ps(_mm256_set1_ps(-1.9515295891e-4f), z, _mm256_set1_ps(8.3321608736e-3f));
+				s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(-1.6666654611e-1f));
+				s = _mm256_fmadd_ps(_mm256_mul_ps(r, z), s, r);
+				__m256 c = _mm256_fmadd_ps(_mm256_set1_ps(2.443315711809948e-5f), z, _mm256_set1_ps(-1.388731625493765e-3f));
+				c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(4.166664568298827e-2f));
+				c = _mm256_fmadd_ps(_mm256_mul_ps(z, z), c, _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, _mm256_set1_ps(1.0f)));
+				__m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, one), one));
+				__m256 sinValue = _mm256_blendv_ps(s, c, swap);
+				__m256 cosValue = _mm256_blendv_ps(c, s, swap);
+				sinValue = _mm256_xor_ps(sinValue, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, two), 30)));
+				cosValue = _mm256_xor_ps(cosValue, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, one), two), 30)));
+				sinValue = _mm256_xor_ps(sinValue, signMask);
+				// the in-lane unpacks give the Vector2s 0 1 4 5 and 2 3 6 7
+				__m256 low = _mm256_unpacklo_ps(cosValue, sinValue);
+				__m256 high = _mm256_unpackhi_ps(cosValue, sinValue);
+				float* data = &vectors[i].x;
+				_mm256_storeu_ps(data, _mm256_permute2f128_ps(low, high, 0x20));
+				_mm256_storeu_ps(data + 8, _mm256_permute2f128_ps(low, high, 0x31));
+			}
+			for (; i < count; ++i)
+			{
+				_sinCosFast(angles[i], sine, cosine);
+				vectors[i].x = cosine;
+				vectors[i].y = -sine;
+			}
+		}
+		template <int Stride>
+		GTYPES_TARGET_AVX2 static void _maskInCircle2fAvx2(const float* x, const float* y, int count, float centerX, float centerY, float radius, unsigned int* mask)
+		{
+			__m256 cx = _mm256_set1_ps(centerX);
+			__m256 cy = _mm256_set1_ps(centerY);
+			__m256 squaredRadius = _mm256_set1_ps(radius * radius);
+			__m256 dx;
+			__m256 dy;
+			unsigned int bits = 0;
+			int i = 0;
+			// one mask word of 32 points per step, 8 points at once
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = 0;
+				for (int j = 0; j < 32; j += 8)
+				{
+					if (Stride == 2)
+					{
+						__m256 a = _mm256_loadu_ps(x + (i + j) * 2);
+						__m256 b = _mm256_loadu_ps(x + (i + j) * 2 + 8);
+						dx = _mm256_sub_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), cx);
+						dy = _mm256_sub_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), cy);
+					}
+					else
+					{
+						dx = _mm256_sub_ps(_mm256_loadu_ps(x + i + j), cx);
+						dy = _mm256_sub_ps(_mm256_loadu_ps(y + i + j), cy);
+					}
+					__m256 inside = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), squaredRadius, _CMP_LE_OQ);
+					if (Stride == 2)
+					{
+						// the in-lane shuffles produced the order 0 1 4 5 2 3 6 7
+						inside = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(inside), _MM_SHUFFLE(3, 1, 2, 0)));
+					}
+					bits |= (unsigned int)_mm256_movemask_ps(inside) << j;
+				}
+				mask[i / 32] = bits;
+			}
+			if (i < count)
+			{
+				maskInCircle2fScalar(x + i * Stride, y + i * Stride, Stride, count - i, centerX, centerY, radius, mask + i / 32);
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void maskInCircle2fAvx2(const float* x, const float* y, int stride, int count, float centerX, float centerY, float radius, unsigned int* mask)
+		{
+			if (stride == 2)
+			{
+				_maskInCircle2fAvx2<2>(x, y, count, centerX, centerY, radius, mask);
+			}
+			else
+			{
+				_maskInCircle2fAvx2<1>(x, y, count, centerX, centerY, radius, mask);
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_AVX512)
+		GTYPES_TARGET_AVX512 static void normalizeFastVector2fAvx512(Vector2<float>* vectors, int count)
+		{
+			int i = 0;
+			// 16 Vector2s at once, same approach as the AVX2 version
+			for (; i + 16 <= count; i += 16)
+			{
+				float* data = &vectors[i].x;
+				__m512 a = _mm512_loadu_ps(data);
+				__m512 b = _mm512_loadu_ps(data + 16);
+				__m512 sa = _mm512_mul_ps(a, a);
+				__m512 sb = _mm512_mul_ps(b, b);
+				sa = _mm512_add_ps(sa, _mm512_permute_ps(sa, _MM_SHUFFLE(2, 3, 0, 1)));
+				sb = _mm512_add_ps(sb, _mm512_permute_ps(sb, _MM_SHUFFLE(2, 3, 0, 1)));
+				_mm512_storeu_ps(data, _mm512_mul_ps(a, rsqrtNonZero(sa)));
+				_mm512_storeu_ps(data + 16, _mm512_mul_ps(b, rsqrtNonZero(sb)));
+			}
+			for (; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void anglesVector2fAvx512(const Vector2<float>* vectors, float* angles, int count)
+		{
+			__m512i signMask = _mm512_set1_epi32((int)0x80000000u);
+			__m512i evenIndices = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+			__m512i oddIndices = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+			__m512 zero = _mm512_setzero_ps();
+			int i = 0;
+			// 16 Vector2s at once, deinterleaved across both registers so no reordering is needed at the end
+			for (; i + 16 <= count; i += 16)
+			{
+				const float* data = &vectors[i].x;
+				__m512 a = _mm512_loadu_ps(data);
+				__m512 b = _mm512_loadu_ps(data + 16);
+				__m512 x = _mm512_permutex2var_ps(a, evenIndices, b);
+				__m512i y = _mm512_xor_si512(_mm512_castps_si512(_mm512_permutex2var_ps(a, oddIndices, b)), signMask);
+				__m512 absX = _mm512_abs_ps(x);
+				__m512 absY = _mm512_abs_ps(_mm512_castsi512_ps(y));
+				__m512 maxValue = _mm512_max_ps(absX, absY);
+				__m512 t = _mm512_maskz_div_ps(_mm512_cmp_ps_mask(maxValue, zero, _CMP_GT_OQ), _mm512_min_ps(absX, absY), maxValue);
+				__m512 s = _mm512_mul_ps(t, t);
+				__m512 result = _mm512_fmadd_ps(_mm512_set1_ps(-0.01172120f), s, _mm512_set1_ps(0.05265332f));
+				result = _mm512_fmadd_ps(result, s, _mm512_set1_ps(-0.11643287f));
+				result = _mm512_fmadd_ps(result, s, _mm512_set1_ps(0.19354346f));
+				result = _mm512_fmadd_ps(result, s, _mm512_set1_ps(-0.33262347f));
+				result = _mm512_fmadd_ps(result, s, _mm512_set1_ps(0.99997726f));
+				result = _mm512_mul_ps(result, t);
+				result = _mm512_mask_sub_ps(result, _mm512_cmp_ps_mask(absY, absX, _CMP_GT_OQ), _mm512_set1_ps(1.57079637f), result);
+				result = _mm512_mask_sub_ps(result, _mm512_cmp_ps_mask(x, zero, _CMP_LT_OQ), _mm512_set1_ps(3.14159274f), result);
+				result = _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(result), _mm512_and_si512(y, signMask)));
+				_mm512_storeu_ps(angles + i, _mm512_mul_ps(result, _mm512_set1_ps(57.2957795130823208768f)));
+			}
+			for (; i < count; ++i)
+			{
+				angles[i] = vectors[i].angleFast();
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void fromAnglesVector2fAvx512(const float* angles, Vector2<float>* vectors, int count)
+		{
+			__m512i one = _mm512_set1_epi32(1);
+			__m512i two = _mm512_set1_epi32(2);
+			__m512i signMask = _mm512_set1_epi32((int)0x80000000u);
+			__m512i lowIndices = _mm512_set_epi32(23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0);
+			__m512i highIndices = _mm512_set_epi32(31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8);
+			float sine = 0.0f;
+			float cosine = 0.0f;
+			int i = 0;
+			// 16 angles at once, same approach as the SSE2 version with the swap as blend mask
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512 degrees = _mm512_loadu_ps(angles + i);
+				__m512i quadrant = _mm512_cvtps_epi32(_mm512_mul_ps(degrees, _mm512_set1_ps(1.0f / 90.0f)));
+				__m512 r = _mm512_fnmadd_ps(_mm512_cvtepi32_ps(quadrant), _mm512_set1_ps(90.0f), degrees);
+				r = _mm512_mul_ps(r, _mm512_set1_ps(0.0174532925199432957692f));
+				__m512 z = _mm512_mul_ps(r, r);
+				__m512 s = _mm512_fmadd_ps(_mm512_set1_ps(-1.9515295891e-4f), z, _mm512_set1_ps(8.3321608736e-3f));
+				s = _mm512_fmadd_ps(s, z, _mm512_set1_ps(-1.6666654611e-1f));
+				s = _mm512_fmadd_ps(_mm512_mul_ps(r, z), s, r);
+				__m512 c = _mm512_fmadd_ps(_mm512_set1_ps(2.443315711809948e-5f), z, _mm512_set1_ps(-1.388731625493765e-3f));
+				c = _mm512_fmadd_ps(c, z, _mm512_set1_ps(4.166664568298827e-2f));
+				c = _mm512_fmadd_ps(_mm512_mul_ps(z, z), c, _mm512_fnmadd_ps(_mm512_set1_ps(0.5f), z, _mm512_set1_ps(1.0f)));
+				__mmask16 swap = _mm512_test_epi32_mask(quadrant, one);
+				__m512i sinValue = _mm512_castps_si512(_mm512_mask_blend_ps(swap, s, c));
+				__m512i cosValue = _mm512_castps_si512(_mm512_mask_blend_ps(swap, c, s));
+				sinValue = _mm512_xor_si512(sinValue, _mm512_slli_epi32(_mm512_and_si512(quadrant, two), 30));
+				cosValue = _mm512_xor_si512(cosValue, _mm512_slli_epi32(_mm512_and_si512(_mm512_add_epi32(quadrant, one), two), 30));
+				sinValue = _mm512_xor_si512(sinValue, signMask);
+				float* data = &vectors[i].x;
+				_mm512_storeu_ps(data, _mm512_permutex2var_ps(_mm512_castsi512_ps(cosValue), lowIndices, _mm512_castsi512_ps(sinValue)));
+				_mm512_storeu_ps(data + 16, _mm512_permutex2var_ps(_mm512_castsi512_ps(cosValue), highIndices, _mm512_castsi512_ps(sinValue)));
+			}
+			for (; i < count; ++i)
+			{
+				_sinCosFast(angles[i], sine, cosine);
+				vectors[i].x = cosine;
+				vectors[i].y = -sine;
+			}
+		}
+		template <int Stride>
+		GTYPES_TARGET_AVX512 static void _maskInCircle2fAvx512(const float* x, const float* y, int count, float centerX, float centerY, float radius, unsigned int* mask)
+		{
+			__m512i evenIndices = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+			__m512i oddIndices = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+			__m512 cx = _mm512_set1_ps(centerX);
+			__m512 cy = _mm512_set1_ps(centerY);
+			__m512 squaredRadius = _mm512_set1_ps(radius * radius);
+			__m512 dx;
+			__m512 dy;
+			unsigned int bits = 0;
+			int i = 0;
+			// one mask word of 32 points per step, 16 points at once
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = 0;
+				for (int j = 0; j < 32; j += 16)
+				{
+					if (Stride == 2)
+					{
+						__m512 a = _mm512_loadu_ps(x + (i + j) * 2);
+						__m512 b = _mm512_loadu_ps(x + (i + j) * 2 + 16);
+						dx = _mm512_sub_ps(_mm512_permutex2var_ps(a, evenIndices, b), cx);
+						dy = _mm512_sub_ps(_mm512_permutex2var_ps(a, oddIndices, b), cy);
+					}
+					else
+					{
+						dx = _mm512_sub_ps(_mm512_loadu_ps(x + i + j), cx);
+						dy = _mm512_sub_ps(_mm512_loadu_ps(y + i + j), cy);
+					}
+					__m512 squaredDistance = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+					bits |= (unsigned int)_mm512_cmp_ps_mask(squaredDistance, squaredRadius, _CMP_LE_OQ) << j;
+				}
+				mask[i / 32] = bits;
+			}
+			if (i < count)
+			{
+				maskInCircle2fScalar(x + i * Stride, y + i * Stride, Stride, count - i, centerX, centerY, radius, mask + i / 32);
+			}
+		}
+
+		GTYPES_TARGET_AVX512 static void maskInCircle2fAvx512(const float* x, const float* y, int stride, int count, float centerX, float centerY, float radius, unsigned int* mask)
+		{
+			if (stride == 2)
+			{
+				_maskInCircle2fAvx512<2>(x, y, count, centerX, centerY, radius, mask);
+			}
+			else
+			{
+				_maskInCircle2fAvx512<1>(x, y, count, centerX, centerY, radius, mask);
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_NEON)
+		static void normalizeFastVector2fNeon(Vector2<float>* vectors, int count)
+		{
+			int i = 0;
+			// 4 Vector2s at once, deinterleaved by the structure load
+			for (; i + 4 <= count; i += 4)
+			{
+				float* data = &vectors[i].x;
+				float32x4x2_t v = vld2q_f32(data);
+				float32x4_t inverse = rsqrtNonZero(vmlaq_f32(vmulq_f32(v.val[0], v.val[0]), v.val[1], v.val[1]));
+				v.val[0] = vmulq_f32(v.val[0], inverse);
+				v.val[1] = vmulq_f32(v.val[1], inverse);
+				vst2q_f32(data, v);
+			}
+			for (; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
+
+		// a / b, ARMv7 has no vector division so the reciprocal estimate is refined twice
+		static inline float32x4_t _divide(float32x4_t a, float32x4_t b)
+		{
+#if defined(__aarch64__) || defined(_M_ARM64)
+			return vdivq_f32(a, b);
+#else
+			float32x4_t inverse = vrecpeq_f32(b);
+			inverse = vmulq_f32(inverse, vrecpsq_f32(b, inverse));
+			inverse = vmulq_f32(inverse, vrecpsq_f32(b, inverse));
+			return vmulq_f32(a, inverse);
+#endif
+		}
+
+		static void anglesVector2fNeon(const Vector2<float>* vectors, float* angles, int count)
+		{
+			uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+			float32x4_t zero = vdupq_n_f32(0.0f);
+			int i = 0;
+			// 4 Vector2s at once, deinterleaved by the structure load
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4x2_t v = vld2q_f32(&vectors[i].x);
+				float32x4_t x = v.val[0];
+				float32x4_t y = vnegq_f32(v.val[1]);
+				float32x4_t absX = vabsq_f32(x);
+				float32x4_t absY = vabsq_f32(y);
+				float32x4_t maxValue = vmaxq_f32(absX, absY);
+				uint32x4_t nonZero = vcgtq_f32(maxValue, zero);
+				float32x4_t t = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(_divide(vminq_f32(absX, absY), maxValue)), nonZero));
+				float32x4_t s = vmulq_f32(t, t);
+				float32x4_t result = vmlaq_f32(vdupq_n_f32(0.05265332f), vdupq_n_f32(-0.01172120f), s);
+				result = vmlaq_f32(vdupq_n_f32(-0.11643287f), result, s);
+				result = vmlaq_f32(vdupq_n_f32(0.19354346f), result, s);
+				result = vmlaq_f32(vdupq_n_f32(-0.33262347f), result, s);
+				result = vmlaq_f32(vdupq_n_f32(0.99997726f), result, s);
+				result = vmulq_f32(result, t);
+				result = vbslq_f32(vcgtq_f32(absY, absX), vsubq_f32(vdupq_n_f32(1.57079637f), result), result);
+				result = vbslq_f32(vcltq_f32(x, zero), vsubq_f32(vdupq_n_f32(3.14159274f), result), result);
+				result = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(result), vandq_u32(vreinterpretq_u32_f32(y), signMask)));
+				vst1q_f32(angles + i, vmulq_n_f32(result, 57.2957795130823208768f));
+			}
+			for (; i < count; ++i)
+			{
+				angles[i] = vectors[i].angleFast();
+			}
+		}
+
+		static void fromAnglesVector2fNeon(const float* angles, Vector2<float>* vectors, int count)
+		{
+			int32x4_t one = vdupq_n_s32(1);
+			int32x4_t two = vdupq_n_s32(2);
+			float sine = 0.0f;
+			float cosine = 0.0f;
+			int i = 0;
+			// 4 angles at once, same approach as the SSE2 version
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4_t degrees = vld1q_f32(angles + i);
+				float32x4_t scaled = vmulq_n_f32(degrees, 1.0f / 90.0f);
+				// the conversion truncates, rounding away from 0 like _sinCosFast()
+				int32x4_t quadrant = vcvtq_s32_f32(vaddq_f32(scaled, vbslq_f32(vcltq_f32(scaled, vdupq_n_f32(0.0f)), vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f))));
+				float32x4_t r = vmlsq_n_f32(degrees, vcvtq_f32_s32(quadrant), 90.0f);
+				r = vmulq_n_f32(r, 0.0174532925199432957692f);
+				float32x4_t z = vmulq_f32(r, r);
+				float32x4_t s = vmlaq_f32(vdupq_n_f32(8.3321608736e-3f), vdupq_n_f32(-1.9515295891e-4f), z);
+				s = vmlaq_f32(vdupq_n_f32(-1.6666654611e-1f), s, z);
+				s = vmlaq_f32(r, vmulq_f32(r, z), s);
+				float32x4_t c = vmlaq_f32(vdupq_n_f32(-1.388731625493765e-3f), vdupq_n_f32(2.443315711809948e-5f), z);
+				c = vmlaq_f32(vdupq_n_f32(4.166664568298827e-2f), c, z);
+				c = vmlaq_f32(vmlsq_n_f32(vdupq_n_f32(1.0f), z, 0.5f), vmulq_f32(z, z), c);
+				uint32x4_t swap = vtstq_s32(quadrant, one);
+				float32x4x2_t v;
+				v.val[0] = vbslq_f32(swap, s, c);
+				v.val[1] = vbslq_f32(swap, c, s);
+				uint32x4_t cosSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(vaddq_s32(quadrant, one), two)), 30);
+				// y is -sin() so its sign is flipped when bit 1 of the quadrant is not set
+				uint32x4_t sinSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(veorq_s32(quadrant, two), two)), 30);
+				v.val[0] = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v.val[0]), cosSign));
+				v.val[1] = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v.val[1]), sinSign));
+				vst2q_f32(&vectors[i].x, v);
+			}
+			for (; i < count; ++i)
+			{
+				_sinCosFast(angles[i], sine, cosine);
+				vectors[i].x = cosine;
+				vectors[i].y = -sine;
+			}
+		}
+		template <int Stride>
+		static void _maskInCircle2fNeon(const float* x, const float* y, int count, float centerX, float centerY, float radius, unsigned int* mask)
+		{
+			float32x4_t cx = vdupq_n_f32(centerX);
+			float32x4_t cy = vdupq_n_f32(centerY);
+			float32x4_t squaredRadius = vdupq_n_f32(radius * radius);
+			float32x4_t dx;
+			float32x4_t dy;
+			unsigned int bits = 0;
+			int i = 0;
+			// one mask word of 32 points per step, 4 points at once
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = 0;
+				for (int j = 0; j < 32; j += 4)
+				{
+					if (Stride == 2)
+					{
+						float32x4x2_t v = vld2q_f32(x + (i + j) * 2);
+						dx = vsubq_f32(v.val[0], cx);
+						dy = vsubq_f32(v.val[1], cy);
+					}
+					else
+					{
+						dx = vsubq_f32(vld1q_f32(x + i + j), cx);
+						dy = vsubq_f32(vld1q_f32(y + i + j), cy);
+					}
+					bits |= movemask(vcleq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), squaredRadius)) << j;
+				}
+				mask[i / 32] = bits;
+			}
+			if (i < count)
+			{
+				maskInCircle2fScalar(x + i * Stride, y + i * Stride, Stride, count - i, centerX, centerY, radius, mask + i / 32);
+			}
+		}
+
+		static void maskInCircle2fNeon(const float* x, const float* y, int stride, int count, float centerX, float centerY, float radius, unsigned int* mask)
+		{
+			if (stride == 2)
+			{
+				_maskInCircle2fNeon<2>(x, y, count, centerX, centerY, radius, mask);
+			}
+			else
+			{
+				_maskInCircle2fNeon<1>(x, y, count, centerX, centerY, radius, mask);
+			}
+		}
+#endif
+
+		void registerVector2Kernels(Kernels& kernels, Level level)
+		{
+			switch (level)
+			{
+			case LevelScalar:
+				kernels.normalizeFastVector2f = &normalizeFastVector2fScalar;
+				kernels.anglesVector2f = &anglesVector2fScalar;
+				kernels.fromAnglesVector2f = &fromAnglesVector2fScalar;
+				kernels.maskInCircle2f = &maskInCircle2fScalar;
+				kernels.findInCircle2f = &findInCircle2f;
+				break;
+#if defined(GTYPES_SIMD_SSE)
+			case LevelSse2:
+				kernels.normalizeFastVector2f = &normalizeFastVector2fSse2;
+				kernels.anglesVector2f = &anglesVector2fSse2;
+				kernels.fromAnglesVector2f = &fromAnglesVector2fSse2;
+				kernels.maskInCircle2f = &maskInCircle2fSse2;
+				break;
+			case LevelAvx2:
+				kernels.normalizeFastVector2f = &normalizeFastVector2fAvx2;
+				kernels.anglesVector2f = &anglesVector2fAvx2;
+				kernels.fromAnglesVector2f = &fromAnglesVector2fAvx2;
+				kernels.maskInCircle2f = &maskInCircle2fAvx2;
+				break;
+#endif
+#if defined(GTYPES_SIMD_AVX512)
+			case LevelAvx512:
+				kernels.normalizeFastVector2f = &normalizeFastVector2fAvx512;
+				kernels.anglesVector2f = &anglesVector2fAvx512;
+				kernels.fromAnglesVector2f = &fromAnglesVector2fAvx512;
+				kernels.maskInCircle2f = &maskInCircle2fAvx512;
+				break;
+#endif
+#if defined(GTYPES_SIMD_NEON)
+			case LevelNeon:
+				kernels.normalizeFastVector2f = &normalizeFastVector2fNeon;
+				kernels.anglesVector2f = &anglesVector2fNeon;
+				kernels.fromAnglesVector2f = &fromAnglesVector2fNeon;
+				kernels.maskInCircle2f = &maskInCircle2fNeon;
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+
+	}
+
+}
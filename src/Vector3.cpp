@@ -0,0 +1,184 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <math.h>
+
+#include "gtypesSimd.h"
+#include "gtypesSimdKernels.h"
+#include "Vector3.h"
+
+namespace gtypes
+{
+	namespace simd
+	{
+		static void normalizeFastVector3fScalar(Vector3<float>* vectors, int count)
+		{
+			float squaredLength = 0.0f;
+			for (int i = 0; i < count; ++i)
+			{
+				squaredLength = vectors[i].squaredLength();
+				if (squaredLength != 0.0f)
+				{
+					vectors[i] *= 1.0f / sqrtf(squaredLength);
+				}
+			}
+		}
+
+#if defined(GTYPES_SIMD_SSE)
+		static void normalizeFastVector3fSse2(Vector3<float>* vectors, int count)
+		{
+			int i = 0;
+			// 4 Vector3s at once, the 12 floats are transposed to SoA for the length calculation
+			for (; i + 4 <= count; i += 4)
+			{
+				float* data = &vectors[i].x;
+				__m128 a = _mm_loadu_ps(data); // x0 y0 z0 x1
+				__m128 b = _mm_loadu_ps(data + 4); // y1 z1 x2 y2
+				__m128 c = _mm_loadu_ps(data + 8); // z2 x3 y3 z3
+				__m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+				__m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+				__m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+				__m128 inverse = rsqrtNonZero(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+				_mm_storeu_ps(data, _mm_mul_ps(a, _mm_shuffle_ps(inverse, inverse, _MM_SHUFFLE(1, 0, 0, 0))));
+				_mm_storeu_ps(data + 4, _mm_mul_ps(b, _mm_shuffle_ps(inverse, inverse, _MM_SHUFFLE(2, 2, 1, 1))));
+				_mm_storeu_ps(data + 8, _mm_mul_ps(c, _mm_shuffle_ps(inverse, inverse, _MM_SHUFFLE(3, 3, 3, 2))));
+			}
+			for (; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
+
+		GTYPES_TARGET_AVX2 static void normalizeFastVector3fAvx2(Vector3<float>* vectors, int count)
+		{
+			int i = 0;
+			// 8 Vector3s at once, the squares of each component are gathered with blends and sorted by vector with a
+			// lane permutation, the resulting reciprocal lengths are then spread back over the interleaved layout
+			for (; i + 8 <= count; i += 8)
+			{
+				float* data = &vectors[i].x;
+				__m256 a = _mm256_loadu_ps(data); // x0 y0 z0 x1 y1 z1 x2 y2
+				__m256 b = _mm256_loadu_ps(data + 8); // z2 x3 y3 z3 x4 y4 z4 x5
+				__m256 c = _mm256_loadu_ps(data + 16); // y5 z5 x6 y6 z6 x7 y7 z7
+				__m256 sa = _mm256_mul_ps(a, a);
+				__m256 sb = _mm256_mul_ps(b, b);
+				__m256 sc = _mm256_mul_ps(c, c);
+				__m256 x = _mm256_blend_ps(_mm256_blend_ps(sa, sb, 0x92), sc, 0x24); // x0 x3 x6 x1 x4 x7 x2 x5
+				__m256 y = _mm256_blend_ps(_mm256_blend_ps(sa, sb, 0x24), sc, 0x49); // y5 y0 y3 y6 y1 y4 y7 y2
+				__m256 z = _mm256_blend_ps(_mm256_blend_ps(sa, sb, 0x49), sc, 0x92); // z2 z5 z0 z3 z6 z1 z4 z7
+				x = _mm256_permutevar8x32_ps(x, _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+				y = _mm256_permutevar8x32_ps(y, _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6));
+				z = _mm256_permutevar8x32_ps(z, _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+				__m256 inverse = rsqrtNonZero(_mm256_add_ps(_mm256_add_ps(x, y), z));
+				_mm256_storeu_ps(data, _mm256_mul_ps(a, _mm256_permutevar8x32_ps(inverse, _mm256_setr_epi32(0, 0, 0, 1, 1, 1, 2, 2))));
+				_mm256_storeu_ps(data + 8, _mm256_mul_ps(b, _mm256_permutevar8x32_ps(inverse, _mm256_setr_epi32(2, 3, 3, 3, 4, 4, 4, 5))));
+				_mm256_storeu_ps(data + 16, _mm256_mul_ps(c, _mm256_permutevar8x32_ps(inverse, _mm256_setr_epi32(5, 5, 6, 6, 6, 7, 7, 7))));
+			}
+			for (; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_AVX512)
+		GTYPES_TARGET_AVX512 static void normalizeFastVector3fAvx512(Vector3<float>* vectors, int count)
+		{
+			int i = 0;
+			// 16 Vector3s at once, each component is gathered from the 48 floats with 2 two-source permutations
+			__m512i x01 = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 0, 0, 0, 0, 0);
+			__m512i x2 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 17, 20, 23, 26, 29);
+			__m512i y01 = _mm512_setr_epi32(1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 0, 0, 0, 0, 0);
+			__m512i y2 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 18, 21, 24, 27, 30);
+			__m512i z01 = _mm512_setr_epi32(2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 0, 0, 0, 0, 0, 0);
+			__m512i z2 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 19, 22, 25, 28, 31);
+			__m512i spreadA = _mm512_setr_epi32(0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5);
+			__m512i spreadB = _mm512_setr_epi32(5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10);
+			__m512i spreadC = _mm512_setr_epi32(10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15);
+			for (; i + 16 <= count; i += 16)
+			{
+				float* data = &vectors[i].x;
+				__m512 a = _mm512_loadu_ps(data);
+				__m512 b = _mm512_loadu_ps(data + 16);
+				__m512 c = _mm512_loadu_ps(data + 32);
+				__m512 sa = _mm512_mul_ps(a, a);
+				__m512 sb = _mm512_mul_ps(b, b);
+				__m512 sc = _mm512_mul_ps(c, c);
+				__m512 x = _mm512_permutex2var_ps(_mm512_permutex2var_ps(sa, x01, sb), x2, sc);
+				__m512 y = _mm512_permutex2var_ps(_mm512_permutex2var_ps(sa, y01, sb), y2, sc);
+				__m512 z = _mm512_permutex2var_ps(_mm512_permutex2var_ps(sa, z01, sb), z2, sc);
+				__m512 inverse = rsqrtNonZero(_mm512_add_ps(_mm512_add_ps(x, y), z));
+				_mm512_storeu_ps(data, _mm512_mul_ps(a, _mm512_permutexvar_ps(spreadA, inverse)));
+				_mm512_storeu_ps(data + 16, _mm512_mul_ps(b, _mm512_permutexvar_ps(spreadB, inverse)));
+				_mm512_storeu_ps(data + 32, _mm512_mul_ps(c, _mm512_permutexvar_ps(spreadC, inverse)));
+			}
+			for (; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
+#endif
+
+#if defined(GTYPES_SIMD_NEON)
+		static void normalizeFastVector3fNeon(Vector3<float>* vectors, int count)
+		{
+			int i = 0;
+			// 4 Vector3s at once, deinterleaved by the structure load
+			for (; i + 4 <= count; i += 4)
+			{
+				float* data = &vectors[i].x;
+				float32x4x3_t v = vld3q_f32(data);
+				float32x4_t squaredLengths = vmulq_f32(v.val[0], v.val[0]);
+				squaredLengths = vmlaq_f32(squaredLengths, v.val[1], v.val[1]);
+				squaredLengths = vmlaq_f32(squaredLengths, v.val[2], v.val[2]);
+				float32x4_t inverse = rsqrtNonZero(squaredLengths);
+				v.val[0] = vmulq_f32(v.val[0], inverse);
+				v.val[1] = vmulq_f32(v.val[1], inverse);
+				v.val[2] = vmulq_f32(v.val[2], inverse);
+				vst3q_f32(data, v);
+			}
+			for (; i < count; ++i)
+			{
+				vectors[i].normalizeFast();
+			}
+		}
+#endif
+
+		void registerVector3Kernels(Kernels& kernels, Level level)
+		{
+			switch (level)
+			{
+			case LevelScalar:
+				kernels.normalizeFastVector3f = &normalizeFastVector3fScalar;
+				break;
+#if defined(GTYPES_SIMD_SSE)
+			case LevelSse2:
+				kernels.normalizeFastVector3f = &normalizeFastVector3fSse2;
+				break;
+			case LevelAvx2:
+				kernels.normalizeFastVector3f = &normalizeFastVector3fAvx2;
+				break;
+#endif
+#if defined(GTYPES_SIMD_AVX512)
+			case LevelAvx512:
+				kernels.normalizeFastVector3f = &normalizeFastVector3fAvx512;
+				break;
+#endif
+#if defined(GTYPES_SIMD_NEON)
+			case LevelNeon:
+				kernels.normalizeFastVector3f = &normalizeFastVector3fNeon;
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+
+	}
+
+}
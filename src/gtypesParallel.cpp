@@ -0,0 +1,63 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include "gtypesParallel.h"
+
+#if defined(GTYPES_THREADS)
+#include <thread>
+#include <vector>
+#endif
+
+namespace gtypes
+{
+	namespace parallel
+	{
+		int getThreadCount(int requested, int workCount, int minimumWorkCount)
+		{
+			int result = requested;
+#if defined(GTYPES_THREADS)
+			if (result <= 0)
+			{
+				result = (int)std::thread::hardware_concurrency();
+			}
+#else
+			result = 1;
+#endif
+			int maximum = workCount / (minimumWorkCount > 0 ? minimumWorkCount : 1);
+			result = (result < maximum ? result : maximum);
+			return (result > 1 ? result : 1);
+		}
+
+		void run(int taskCount, void (*task)(void* data, int index), void* data)
+		{
+#if defined(GTYPES_THREADS)
+			if (taskCount > 1)
+			{
+				std::vector<std::thread> threads;
+				threads.reserve(taskCount - 1);
+				for (int i = 1; i < taskCount; ++i)
+				{
+					threads.push_back(std::thread(task, data, i));
+				}
+				task(data, 0);
+				for (int i = 0; i < (int)threads.size(); ++i)
+				{
+					threads[i].join();
+				}
+				return;
+			}
+#endif
+			for (int i = 0; i < taskCount; ++i)
+			{
+				task(data, i);
+			}
+		}
+
+	}
+
+}
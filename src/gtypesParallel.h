@@ -0,0 +1,43 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Internal helpers to split batch work over threads.
+
+#ifndef GTYPES_PARALLEL_H
+#define GTYPES_PARALLEL_H
+
+/// @def GTYPES_THREADS
+/// @brief Defined when std::thread is available, otherwise all tasks run on the calling thread.
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1700)
+	#define GTYPES_THREADS
+#endif
+
+namespace gtypes
+{
+	namespace parallel
+	{
+		/// @brief Gets the number of threads to use for a job.
+		/// @param[in] requested The requested number of threads, 0 for the number of hardware threads.
+		/// @param[in] workCount Number of work items of the job.
+		/// @param[in] minimumWorkCount Minimum number of work items per thread that makes starting a thread worth it.
+		/// @return The number of threads, at least 1.
+		int getThreadCount(int requested, int workCount, int minimumWorkCount);
+		/// @brief Runs a task for every index from 0 to taskCount - 1 and waits until all are done.
+		/// @param[in] taskCount Number of tasks.
+		/// @param[in] task The task function.
+		/// @param[in] data Passed to every task.
+		/// @note Index 0 runs on the calling thread, all other indices on their own threads.
+		void run(int taskCount, void (*task)(void* data, int index), void* data);
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,433 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "gtypesSimd.h"
+#include "gtypesSimdKernels.h"
+
+#if defined(GTYPES_SIMD_SSE)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace gtypes
+{
+	namespace simd
+	{
+		static const char* levelNames[LevelCount] = { "scalar", "sse2", "sse4.1", "avx2", "avx512", "neon" };
+		static Kernels tables[LevelCount];
+		static Level supportedLevel = LevelScalar;
+		static Level currentLevel = LevelScalar;
+		static bool initialized = false;
+
+#if defined(GTYPES_SIMD_SSE)
+		static void _cpuid(unsigned int leaf, unsigned int subleaf, unsigned int* registers)
+		{
+#if defined(_MSC_VER)
+			__cpuidex((int*)registers, (int)leaf, (int)subleaf);
+#else
+			__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+		}
+
+		static unsigned long long _getXcr0()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			unsigned int eax = 0;
+			unsigned int edx = 0;
+			__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (((unsigned long long)edx << 32) | eax);
+#endif
+		}
+#endif
+
+		static Level _detectLevel()
+		{
+#if defined(GTYPES_SIMD_SSE)
+			unsigned int registers[4] = { 0, 0, 0, 0 };
+			_cpuid(0, 0, registers);
+			unsigned int maxLeaf = registers[0];
+			_cpuid(1, 0, registers);
+			unsigned int ecx = registers[2];
+			unsigned int edx = registers[3];
+			if ((edx & (1 << 26)) == 0)
+			{
+				return LevelScalar;
+			}
+			if ((ecx & (1 << 19)) == 0)
+			{
+				return LevelSse2;
+			}
+			// AVX needs OSXSAVE, AVX and the OS saving the XMM and YMM registers
+			if ((ecx & (1 << 27)) == 0 || (ecx & (1 << 28)) == 0 || maxLeaf < 7)
+			{
+				return LevelSse41;
+			}
+			unsigned long long xcr0 = _getXcr0();
+			if ((xcr0 & 0x6) != 0x6)
+			{
+				return LevelSse41;
+			}
+			// every CPU with FMA also has F16C, both are checked anyway
+			bool fma = ((ecx & (1 << 12)) != 0 && (ecx & (1 << 29)) != 0);
+			_cpuid(7, 0, registers);
+			unsigned int ebx = registers[1];
+			// BMI2 came with AVX2 on Intel and AMD
+			if (!fma || (ebx & (1 << 5)) == 0 || (ebx & (1 << 8)) == 0)
+			{
+				return LevelSse41;
+			}
+			// AVX-512 additionally needs the OS saving the opmask and ZMM registers
+			if ((ebx & (1 << 16)) == 0 || (xcr0 & 0xE6) != 0xE6)
+			{
+				return LevelAvx2;
+			}
+			return LevelAvx512;
+#elif defined(GTYPES_SIMD_NEON)
+			return LevelNeon;
+#else
+			return LevelScalar;
+#endif
+		}
+
+		static bool _isLevelSupported(Level level, Level supported)
+		{
+			if (level == LevelScalar || level == supported)
+			{
+				return true;
+			}
+			if (level == LevelNeon || supported == LevelNeon || level < LevelScalar || level >= LevelCount)
+			{
+				return false;
+			}
+			return (level < supported);
+		}
+
+		// lookup tables of the compressMask() kernels, filled before the kernels are registered
+		static int compressOffsets4[16][4];
+		static unsigned int compressNibbles8[256];
+		static int bitCounts8[256];
+
+		static void _buildCompressTables()
+		{
+			int count = 0;
+			for (int i = 0; i < 256; ++i)
+			{
+				count = 0;
+				compressNibbles8[i] = 0;
+				for (int j = 0; j < 8; ++j)
+				{
+					if ((i & (1 << j)) != 0)
+					{
+						if (i < 16)
+						{
+							compressOffsets4[i][count] = j;
+						}
+						compressNibbles8[i] |= (unsigned int)j << (count * 4);
+						++count;
+					}
+				}
+				bitCounts8[i] = count;
+			}
+		}
+
+		static int compressMaskScalar(const unsigned int* mask, int count, int offset, int* indices)
+		{
+			int found = 0;
+			int size = 0;
+			unsigned int bits = 0;
+			for (int i = 0; i < count; i += 32)
+			{
+				bits = mask[i / 32];
+				if (bits == 0)
+				{
+					continue;
+				}
+				// every index is written, only the set ones advance the output position
+				size = (count - i < 32 ? count - i : 32);
+				for (int j = 0; j < size; ++j)
+				{
+					indices[found] = offset + i + j;
+					found += (int)((bits >> j) & 1);
+				}
+			}
+			return found;
+		}
+
+#if defined(GTYPES_SIMD_SSE)
+		static int compressMaskSse2(const unsigned int* mask, int count, int offset, int* indices)
+		{
+			int found = 0;
+			unsigned int bits = 0;
+			unsigned int nibble = 0;
+			int i = 0;
+			// 4 indices per step, the table moves the selected ones to the front and the store overlaps the next step
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = mask[i / 32];
+				if (bits == 0)
+				{
+					continue;
+				}
+				__m128i base = _mm_set1_epi32(offset + i);
+				for (int j = 0; j < 32; j += 4)
+				{
+					nibble = (bits >> j) & 0xF;
+					_mm_storeu_si128((__m128i*)(indices + found), _mm_add_epi32(base, _mm_loadu_si128((const __m128i*)compressOffsets4[nibble])));
+					found += bitCounts8[nibble];
+					base = _mm_add_epi32(base, _mm_set1_epi32(4));
+				}
+			}
+			if (i < count)
+			{
+				found += compressMaskScalar(mask + i / 32, count - i, offset + i, indices + found);
+			}
+			return found;
+		}
+
+		GTYPES_TARGET_AVX2 static int compressMaskAvx2(const unsigned int* mask, int count, int offset, int* indices)
+		{
+			__m256i shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+			__m256i nibbleMask = _mm256_set1_epi32(0xF);
+			int found = 0;
+			unsigned int bits = 0;
+			unsigned int byte = 0;
+			int i = 0;
+			// 8 indices per step, the packed table entry is expanded with variable shifts
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = mask[i / 32];
+				if (bits == 0)
+				{
+					continue;
+				}
+				for (int j = 0; j < 32; j += 8)
+				{
+					byte = (bits >> j) & 0xFF;
+					__m256i selected = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((int)compressNibbles8[byte]), shifts), nibbleMask);
+					_mm256_storeu_si256((__m256i*)(indices + found), _mm256_add_epi32(selected, _mm256_set1_epi32(offset + i + j)));
+					found += bitCounts8[byte];
+				}
+			}
+			if (i < count)
+			{
+				found += compressMaskScalar(mask + i / 32, count - i, offset + i, indices + found);
+			}
+			return found;
+		}
+#endif
+
+#if defined(GTYPES_SIMD_AVX512)
+		GTYPES_TARGET_AVX512 static int compressMaskAvx512(const unsigned int* mask, int count, int offset, int* indices)
+		{
+			__m512i sequence = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			int found = 0;
+			unsigned int bits = 0;
+			// the compressing store only writes the selected indices so the bits after count need no special handling
+			for (int i = 0; i < count; i += 32)
+			{
+				bits = mask[i / 32];
+				if (bits == 0)
+				{
+					continue;
+				}
+				_mm512_mask_compressstoreu_epi32(indices + found, (__mmask16)(bits & 0xFFFF), _mm512_add_epi32(sequence, _mm512_set1_epi32(offset + i)));
+				found += bitCounts8[bits & 0xFF] + bitCounts8[(bits >> 8) & 0xFF];
+				_mm512_mask_compressstoreu_epi32(indices + found, (__mmask16)(bits >> 16), _mm512_add_epi32(sequence, _mm512_set1_epi32(offset + i + 16)));
+				found += bitCounts8[(bits >> 16) & 0xFF] + bitCounts8[bits >> 24];
+			}
+			return found;
+		}
+#endif
+
+#if defined(GTYPES_SIMD_NEON)
+		static int compressMaskNeon(const unsigned int* mask, int count, int offset, int* indices)
+		{
+			int found = 0;
+			unsigned int bits = 0;
+			unsigned int nibble = 0;
+			int i = 0;
+			// same approach as the SSE2 version
+			for (; i + 32 <= count; i += 32)
+			{
+				bits = mask[i / 32];
+				if (bits == 0)
+				{
+					continue;
+				}
+				int32x4_t base = vdupq_n_s32(offset + i);
+				for (int j = 0; j < 32; j += 4)
+				{
+					nibble = (bits >> j) & 0xF;
+					vst1q_s32(indices + found, vaddq_s32(base, vld1q_s32(compressOffsets4[nibble])));
+					found += bitCounts8[nibble];
+					base = vaddq_s32(base, vdupq_n_s32(4));
+				}
+			}
+			if (i < count)
+			{
+				found += compressMaskScalar(mask + i / 32, count - i, offset + i, indices + found);
+			}
+			return found;
+		}
+#endif
+
+		static void _registerSimdKernels(Kernels& kernels, Level level)
+		{
+			switch (level)
+			{
+			case LevelScalar:
+				kernels.compressMask = &compressMaskScalar;
+				break;
+#if defined(GTYPES_SIMD_SSE)
+			case LevelSse2:
+				kernels.compressMask = &compressMaskSse2;
+				break;
+			case LevelAvx2:
+				kernels.compressMask = &compressMaskAvx2;
+				break;
+#endif
+#if defined(GTYPES_SIMD_AVX512)
+			case LevelAvx512:
+				kernels.compressMask = &compressMaskAvx512;
+				break;
+#endif
+#if defined(GTYPES_SIMD_NEON)
+			case LevelNeon:
+				kernels.compressMask = &compressMaskNeon;
+				break;
+#endif
+			default:
+				break;
+			}
+		}
+
+		static void _registerKernels(Kernels& kernels, Level level)
+		{
+			_registerSimdKernels(kernels, level);
+			registerVector2Kernels(kernels, level);
+			registerVector3Kernels(kernels, level);
+			registerQuaternionKernels(kernels, level);
+			registerDualQuaternionKernels(kernels, level);
+			registerRectangleKernels(kernels, level);
+			registerPackedVector3Kernels(kernels, level);
+			registerPackedQuaternionKernels(kernels, level);
+			registerSpaceFillingCurveKernels(kernels, level);
+		}
+
+		static void _initialize()
+		{
+			_buildCompressTables();
+			// every level starts with the kernels of the level below so kernels without a dedicated version fall back
+			_registerKernels(tables[LevelScalar], LevelScalar);
+			for (int i = LevelSse2; i <= LevelAvx512; ++i)
+			{
+				tables[i] = tables[i - 1];
+				_registerKernels(tables[i], (Level)i);
+			}
+			tables[LevelNeon] = tables[LevelScalar];
+			_registerKernels(tables[LevelNeon], LevelNeon);
+			supportedLevel = _detectLevel();
+			currentLevel = supportedLevel;
+#ifndef _UWP
+			const char* requested = getenv("GTYPES_SIMD_LEVEL");
+			if (requested != NULL)
+			{
+				for (int i = 0; i < LevelCount; ++i)
+				{
+					if (strcmp(requested, levelNames[i]) == 0)
+					{
+						if (_isLevelSupported((Level)i, supportedLevel))
+						{
+							currentLevel = (Level)i;
+						}
+						else if (i != LevelNeon && supportedLevel != LevelNeon)
+						{
+							currentLevel = supportedLevel; // higher x86 level than available
+						}
+						break;
+					}
+				}
+			}
+#endif
+			initialized = true;
+		}
+
+		// makes sure the detection happens during startup rather than in the first batch call
+		static struct _Initializer
+		{
+			_Initializer()
+			{
+				if (!initialized)
+				{
+					_initialize();
+				}
+			}
+		} _initializer;
+
+		Level getSupportedLevel()
+		{
+			if (!initialized)
+			{
+				_initialize();
+			}
+			return supportedLevel;
+		}
+
+		Level getLevel()
+		{
+			if (!initialized)
+			{
+				_initialize();
+			}
+			return currentLevel;
+		}
+
+		bool setLevel(Level level)
+		{
+			if (!isLevelSupported(level))
+			{
+				return false;
+			}
+			currentLevel = level;
+			return true;
+		}
+
+		bool isLevelSupported(Level level)
+		{
+			return _isLevelSupported(level, getSupportedLevel());
+		}
+
+		const char* getLevelName(Level level)
+		{
+			if (level < LevelScalar || level >= LevelCount)
+			{
+				return "";
+			}
+			return levelNames[level];
+		}
+
+		const Kernels& getKernels()
+		{
+			if (!initialized)
+			{
+				_initialize();
+			}
+			return tables[currentLevel];
+		}
+
+	}
+
+}
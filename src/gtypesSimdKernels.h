@@ -0,0 +1,406 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Internal declarations for the batch kernels of the runtime SIMD dispatch.
+
+#ifndef GTYPES_SIMD_KERNELS_H
+#define GTYPES_SIMD_KERNELS_H
+
+#include "gtypesSimd.h"
+
+/// @def GTYPES_TARGET_SSE41
+/// @brief Allows SSE4.1 instructions in a single function.
+/// @def GTYPES_TARGET_AVX2
+/// @brief Allows AVX2, FMA, F16C and BMI2 instructions in a single function.
+/// @def GTYPES_TARGET_AVX512
+/// @brief Allows AVX-512F instructions in a single function.
+/// @def GTYPES_SIMD_AVX512
+/// @brief Defined when the compiler can build the AVX-512 kernels.
+/// @note The kernels of all x86 levels are compiled into the same translation units without global compiler flags and
+/// are only called after the runtime check so the library keeps running on SSE2-only CPUs.
+#if defined(GTYPES_SIMD_SSE)
+	#include <immintrin.h>
+	#if defined(__GNUC__) || defined(__clang__)
+		#define GTYPES_TARGET_SSE41 __attribute__((target("sse4.1")))
+		#define GTYPES_TARGET_AVX2 __attribute__((target("avx2,fma,f16c,bmi2")))
+		#define GTYPES_TARGET_AVX512 __attribute__((target("avx2,fma,f16c,bmi2,avx512f")))
+		#define GTYPES_SIMD_AVX512
+		#if !defined(__clang__) && __GNUC__ == 12
+			// GCC 12 reports its own _mm512_undefined_ps() placeholders as uninitialized (GCC bug 105593)
+			#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+		#endif
+	#else
+		#define GTYPES_TARGET_SSE41
+		#define GTYPES_TARGET_AVX2
+		#define GTYPES_TARGET_AVX512
+		#if defined(_MSC_VER) && _MSC_VER >= 1911
+			#define GTYPES_SIMD_AVX512
+		#endif
+	#endif
+#endif
+
+namespace gtypes
+{
+	namespace simd
+	{
+#if defined(GTYPES_SIMD_SSE)
+		/// @brief Calculates fast approximations of 1 / sqrt(value) for 8 squared lengths.
+		/// @param[in] squaredLengths The squared lengths.
+		/// @return The approximated reciprocal square roots.
+		/// @note Lanes with a squared length of 0 return 1 so zero-length vectors stay unchanged when scaled.
+		GTYPES_TARGET_AVX2 inline __m256 rsqrtNonZero(__m256 squaredLengths)
+		{
+			__m256 nonZero = _mm256_cmp_ps(squaredLengths, _mm256_setzero_ps(), _CMP_GT_OQ);
+			__m256 y = _mm256_rsqrt_ps(squaredLengths);
+			y = _mm256_mul_ps(y, _mm256_fnmadd_ps(_mm256_mul_ps(squaredLengths, _mm256_set1_ps(0.5f)), _mm256_mul_ps(y, y), _mm256_set1_ps(1.5f)));
+			return _mm256_blendv_ps(_mm256_set1_ps(1.0f), y, nonZero);
+		}
+#endif
+#if defined(GTYPES_SIMD_SSE)
+		/// @brief Loads 4 consecutive Vector3s and deinterleaves their components.
+		/// @param[in] data The 12 floats.
+		/// @param[out] x The X components.
+		/// @param[out] y The Y components.
+		/// @param[out] z The Z components.
+		inline void load3(const float* data, __m128& x, __m128& y, __m128& z)
+		{
+			__m128 a = _mm_loadu_ps(data); // x0 y0 z0 x1
+			__m128 b = _mm_loadu_ps(data + 4); // y1 z1 x2 y2
+			__m128 c = _mm_loadu_ps(data + 8); // z2 x3 y3 z3
+			x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 0, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 2, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 1, 0, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+		}
+		/// @brief Interleaves the components of 4 Vector3s and stores them consecutively.
+		/// @param[out] data The 12 floats.
+		/// @param[in] x The X components.
+		/// @param[in] y The Y components.
+		/// @param[in] z The Z components.
+		inline void store3(float* data, __m128 x, __m128 y, __m128 z)
+		{
+			__m128 a = _mm_shuffle_ps(_mm_unpacklo_ps(x, y), _mm_shuffle_ps(z, x, _MM_SHUFFLE(0, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+			__m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(0, 1, 0, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(0, 3, 0, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(0, 3, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			_mm_storeu_ps(data, a);
+			_mm_storeu_ps(data + 4, b);
+			_mm_storeu_ps(data + 8, c);
+		}
+		/// @brief Loads 4 consecutive Quaternions and transposes them to SoA.
+		/// @param[in] data The 16 floats.
+		/// @param[out] x The X components.
+		/// @param[out] y The Y components.
+		/// @param[out] z The Z components.
+		/// @param[out] w The W components.
+		inline void load4(const float* data, __m128& x, __m128& y, __m128& z, __m128& w)
+		{
+			x = _mm_loadu_ps(data);
+			y = _mm_loadu_ps(data + 4);
+			z = _mm_loadu_ps(data + 8);
+			w = _mm_loadu_ps(data + 12);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+		}
+		/// @brief Transposes 4 Quaternions from SoA back and stores them consecutively.
+		/// @param[out] data The 16 floats.
+		/// @param[in] x The X components.
+		/// @param[in] y The Y components.
+		/// @param[in] z The Z components.
+		/// @param[in] w The W components.
+		inline void store4(float* data, __m128 x, __m128 y, __m128 z, __m128 w)
+		{
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_ps(data, x);
+			_mm_storeu_ps(data + 4, y);
+			_mm_storeu_ps(data + 8, z);
+			_mm_storeu_ps(data + 12, w);
+		}
+		/// @brief Rotates 4 Vector3s in SoA layout with the same operation order as Quaternion::rotate().
+		/// @param[in] qx The X components of the unit Quaternions.
+		/// @param[in] qy The Y components of the unit Quaternions.
+		/// @param[in] qz The Z components of the unit Quaternions.
+		/// @param[in] qw The W components of the unit Quaternions.
+		/// @param[in,out] x The X components.
+		/// @param[in,out] y The Y components.
+		/// @param[in,out] z The Z components.
+		inline void rotate3(__m128 qx, __m128 qy, __m128 qz, __m128 qw, __m128& x, __m128& y, __m128& z)
+		{
+			__m128 tx = _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y));
+			__m128 ty = _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z));
+			__m128 tz = _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x));
+			tx = _mm_add_ps(tx, tx);
+			ty = _mm_add_ps(ty, ty);
+			tz = _mm_add_ps(tz, tz);
+			x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+			y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+			z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+		}
+		/// @brief Loads 8 consecutive Vector3s and deinterleaves their components.
+		/// @param[in] data The 24 floats.
+		/// @param[out] x The X components.
+		/// @param[out] y The Y components.
+		/// @param[out] z The Z components.
+		GTYPES_TARGET_AVX2 inline void load3(const float* data, __m256& x, __m256& y, __m256& z)
+		{
+			__m128 x0;
+			__m128 y0;
+			__m128 z0;
+			__m128 x1;
+			__m128 y1;
+			__m128 z1;
+			load3(data, x0, y0, z0);
+			load3(data + 12, x1, y1, z1);
+			x = _mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1);
+			y = _mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1);
+			z = _mm256_insertf128_ps(_mm256_castps128_ps256(z0), z1, 1);
+		}
+		/// @brief Interleaves the components of 8 Vector3s and stores them consecutively.
+		/// @param[out] data The 24 floats.
+		/// @param[in] x The X components.
+		/// @param[in] y The Y components.
+		/// @param[in] z The Z components.
+		GTYPES_TARGET_AVX2 inline void store3(float* data, __m256 x, __m256 y, __m256 z)
+		{
+			store3(data, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+			store3(data + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+		}
+		/// @brief Loads 8 consecutive Quaternions and transposes them to SoA within each 128 bit lane.
+		/// @param[in] data The 32 floats.
+		/// @param[out] x The X components.
+		/// @param[out] y The Y components.
+		/// @param[out] z The Z components.
+		/// @param[out] w The W components.
+		/// @note Quaternion 2 * k + l ends up at position 4 * l + k, store4() restores the original order.
+		GTYPES_TARGET_AVX2 inline void load4(const float* data, __m256& x, __m256& y, __m256& z, __m256& w)
+		{
+			__m256 q0 = _mm256_loadu_ps(data);
+			__m256 q1 = _mm256_loadu_ps(data + 8);
+			__m256 q2 = _mm256_loadu_ps(data + 16);
+			__m256 q3 = _mm256_loadu_ps(data + 24);
+			__m256 t0 = _mm256_unpacklo_ps(q0, q1);
+			__m256 t1 = _mm256_unpackhi_ps(q0, q1);
+			__m256 t2 = _mm256_unpacklo_ps(q2, q3);
+			__m256 t3 = _mm256_unpackhi_ps(q2, q3);
+			x = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+			y = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+			z = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			w = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+		/// @brief Transposes 8 Quaternions loaded with load4() back and stores them consecutively.
+		/// @param[out] data The 32 floats.
+		/// @param[in] x The X components.
+		/// @param[in] y The Y components.
+		/// @param[in] z The Z components.
+		/// @param[in] w The W components.
+		GTYPES_TARGET_AVX2 inline void store4(float* data, __m256 x, __m256 y, __m256 z, __m256 w)
+		{
+			__m256 t0 = _mm256_unpacklo_ps(x, y);
+			__m256 t1 = _mm256_unpackhi_ps(x, y);
+			__m256 t2 = _mm256_unpacklo_ps(z, w);
+			__m256 t3 = _mm256_unpackhi_ps(z, w);
+			_mm256_storeu_ps(data, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm256_storeu_ps(data + 8, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+			_mm256_storeu_ps(data + 16, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm256_storeu_ps(data + 24, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+		}
+		/// @brief Rotates 8 Vector3s in SoA layout with the same operation order as Quaternion::rotate().
+		/// @param[in] qx The X components of the unit Quaternions.
+		/// @param[in] qy The Y components of the unit Quaternions.
+		/// @param[in] qz The Z components of the unit Quaternions.
+		/// @param[in] qw The W components of the unit Quaternions.
+		/// @param[in,out] x The X components.
+		/// @param[in,out] y The Y components.
+		/// @param[in,out] z The Z components.
+		GTYPES_TARGET_AVX2 inline void rotate3(__m256 qx, __m256 qy, __m256 qz, __m256 qw, __m256& x, __m256& y, __m256& z)
+		{
+			__m256 tx = _mm256_sub_ps(_mm256_mul_ps(qy, z), _mm256_mul_ps(qz, y));
+			__m256 ty = _mm256_sub_ps(_mm256_mul_ps(qz, x), _mm256_mul_ps(qx, z));
+			__m256 tz = _mm256_sub_ps(_mm256_mul_ps(qx, y), _mm256_mul_ps(qy, x));
+			tx = _mm256_add_ps(tx, tx);
+			ty = _mm256_add_ps(ty, ty);
+			tz = _mm256_add_ps(tz, tz);
+			x = _mm256_add_ps(_mm256_add_ps(x, _mm256_mul_ps(qw, tx)), _mm256_sub_ps(_mm256_mul_ps(qy, tz), _mm256_mul_ps(qz, ty)));
+			y = _mm256_add_ps(_mm256_add_ps(y, _mm256_mul_ps(qw, ty)), _mm256_sub_ps(_mm256_mul_ps(qz, tx), _mm256_mul_ps(qx, tz)));
+			z = _mm256_add_ps(_mm256_add_ps(z, _mm256_mul_ps(qw, tz)), _mm256_sub_ps(_mm256_mul_ps(qx, ty), _mm256_mul_ps(qy, tx)));
+		}
+#endif
+#if defined(GTYPES_SIMD_AVX512)
+		/// @brief Calculates fast approximations of 1 / sqrt(value) for 16 squared lengths.
+		/// @param[in] squaredLengths The squared lengths.
+		/// @return The approximated reciprocal square roots.
+		/// @note Lanes with a squared length of 0 return 1 so zero-length vectors stay unchanged when scaled.
+		GTYPES_TARGET_AVX512 inline __m512 rsqrtNonZero(__m512 squaredLengths)
+		{
+			__mmask16 nonZero = _mm512_cmp_ps_mask(squaredLengths, _mm512_setzero_ps(), _CMP_GT_OQ);
+			__m512 y = _mm512_rsqrt14_ps(squaredLengths);
+			y = _mm512_mul_ps(y, _mm512_fnmadd_ps(_mm512_mul_ps(squaredLengths, _mm512_set1_ps(0.5f)), _mm512_mul_ps(y, y), _mm512_set1_ps(1.5f)));
+			return _mm512_mask_mov_ps(_mm512_set1_ps(1.0f), nonZero, y);
+		}
+		/// @brief Loads 16 consecutive Vector3s and deinterleaves their components.
+		/// @param[in] data The 48 floats.
+		/// @param[out] x The X components.
+		/// @param[out] y The Y components.
+		/// @param[out] z The Z components.
+		GTYPES_TARGET_AVX512 inline void load3(const float* data, __m512& x, __m512& y, __m512& z)
+		{
+			__m512 a = _mm512_loadu_ps(data);
+			__m512 b = _mm512_loadu_ps(data + 16);
+			__m512 c = _mm512_loadu_ps(data + 32);
+			// each component is gathered with 2 two-source permutations, first from a and b, then from c
+			x = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 0, 0, 0, 0, 0), b),
+				_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 17, 20, 23, 26, 29), c);
+			y = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, _mm512_setr_epi32(1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 0, 0, 0, 0, 0), b),
+				_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 18, 21, 24, 27, 30), c);
+			z = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, _mm512_setr_epi32(2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 0, 0, 0, 0, 0, 0), b),
+				_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 19, 22, 25, 28, 31), c);
+		}
+		/// @brief Interleaves the components of 16 Vector3s and stores them consecutively.
+		/// @param[out] data The 48 floats.
+		/// @param[in] x The X components.
+		/// @param[in] y The Y components.
+		/// @param[in] z The Z components.
+		GTYPES_TARGET_AVX512 inline void store3(float* data, __m512 x, __m512 y, __m512 z)
+		{
+			// X and Y are merged first, Z is filled in by the second permutation
+			_mm512_storeu_ps(data, _mm512_permutex2var_ps(_mm512_permutex2var_ps(x, _mm512_setr_epi32(0, 16, 0, 1, 17, 0, 2, 18, 0, 3, 19, 0, 4, 20, 0, 5), y),
+				_mm512_setr_epi32(0, 1, 16, 3, 4, 17, 6, 7, 18, 9, 10, 19, 12, 13, 20, 15), z));
+			_mm512_storeu_ps(data + 16, _mm512_permutex2var_ps(_mm512_permutex2var_ps(x, _mm512_setr_epi32(21, 0, 6, 22, 0, 7, 23, 0, 8, 24, 0, 9, 25, 0, 10, 26), y),
+				_mm512_setr_epi32(0, 21, 2, 3, 22, 5, 6, 23, 8, 9, 24, 11, 12, 25, 14, 15), z));
+			_mm512_storeu_ps(data + 32, _mm512_permutex2var_ps(_mm512_permutex2var_ps(x, _mm512_setr_epi32(0, 11, 27, 0, 12, 28, 0, 13, 29, 0, 14, 30, 0, 15, 31, 0), y),
+				_mm512_setr_epi32(26, 1, 2, 27, 4, 5, 28, 7, 8, 29, 10, 11, 30, 13, 14, 31), z));
+		}
+		/// @brief Loads 16 consecutive Quaternions and transposes them to SoA within each 128 bit lane.
+		/// @param[in] data The 64 floats.
+		/// @param[out] x The X components.
+		/// @param[out] y The Y components.
+		/// @param[out] z The Z components.
+		/// @param[out] w The W components.
+		/// @note Quaternion 4 * k + l ends up at position 4 * l + k, store4() restores the original order.
+		GTYPES_TARGET_AVX512 inline void load4(const float* data, __m512& x, __m512& y, __m512& z, __m512& w)
+		{
+			__m512 q0 = _mm512_loadu_ps(data);
+			__m512 q1 = _mm512_loadu_ps(data + 16);
+			__m512 q2 = _mm512_loadu_ps(data + 32);
+			__m512 q3 = _mm512_loadu_ps(data + 48);
+			__m512 t0 = _mm512_unpacklo_ps(q0, q1);
+			__m512 t1 = _mm512_unpackhi_ps(q0, q1);
+			__m512 t2 = _mm512_unpacklo_ps(q2, q3);
+			__m512 t3 = _mm512_unpackhi_ps(q2, q3);
+			x = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+			y = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+			z = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			w = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+		/// @brief Transposes 16 Quaternions loaded with load4() back and stores them consecutively.
+		/// @param[out] data The 64 floats.
+		/// @param[in] x The X components.
+		/// @param[in] y The Y components.
+		/// @param[in] z The Z components.
+		/// @param[in] w The W components.
+		GTYPES_TARGET_AVX512 inline void store4(float* data, __m512 x, __m512 y, __m512 z, __m512 w)
+		{
+			__m512 t0 = _mm512_unpacklo_ps(x, y);
+			__m512 t1 = _mm512_unpackhi_ps(x, y);
+			__m512 t2 = _mm512_unpacklo_ps(z, w);
+			__m512 t3 = _mm512_unpackhi_ps(z, w);
+			_mm512_storeu_ps(data, _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm512_storeu_ps(data + 16, _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+			_mm512_storeu_ps(data + 32, _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm512_storeu_ps(data + 48, _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+		}
+		/// @brief Rotates 16 Vector3s in SoA layout with the same operation order as Quaternion::rotate().
+		/// @param[in] qx The X components of the unit Quaternions.
+		/// @param[in] qy The Y components of the unit Quaternions.
+		/// @param[in] qz The Z components of the unit Quaternions.
+		/// @param[in] qw The W components of the unit Quaternions.
+		/// @param[in,out] x The X components.
+		/// @param[in,out] y The Y components.
+		/// @param[in,out] z The Z components.
+		GTYPES_TARGET_AVX512 inline void rotate3(__m512 qx, __m512 qy, __m512 qz, __m512 qw, __m512& x, __m512& y, __m512& z)
+		{
+			__m512 tx = _mm512_sub_ps(_mm512_mul_ps(qy, z), _mm512_mul_ps(qz, y));
+			__m512 ty = _mm512_sub_ps(_mm512_mul_ps(qz, x), _mm512_mul_ps(qx, z));
+			__m512 tz = _mm512_sub_ps(_mm512_mul_ps(qx, y), _mm512_mul_ps(qy, x));
+			tx = _mm512_add_ps(tx, tx);
+			ty = _mm512_add_ps(ty, ty);
+			tz = _mm512_add_ps(tz, tz);
+			x = _mm512_add_ps(_mm512_add_ps(x, _mm512_mul_ps(qw, tx)), _mm512_sub_ps(_mm512_mul_ps(qy, tz), _mm512_mul_ps(qz, ty)));
+			y = _mm512_add_ps(_mm512_add_ps(y, _mm512_mul_ps(qw, ty)), _mm512_sub_ps(_mm512_mul_ps(qz, tx), _mm512_mul_ps(qx, tz)));
+			z = _mm512_add_ps(_mm512_add_ps(z, _mm512_mul_ps(qw, tz)), _mm512_sub_ps(_mm512_mul_ps(qx, ty), _mm512_mul_ps(qy, tx)));
+		}
+#endif
+
+#if defined(GTYPES_SIMD_NEON)
+		/// @brief Packs the lanes of a comparison result into 4 bits like _mm_movemask_ps().
+		/// @param[in] mask The comparison result.
+		/// @return Bit i is set if lane i is set.
+		inline unsigned int movemask(uint32x4_t mask)
+		{
+			static const unsigned int weights[4] = { 1, 2, 4, 8 };
+			uint32x4_t bits = vandq_u32(mask, vld1q_u32(weights));
+			uint32x2_t sum = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+			return vget_lane_u32(vpadd_u32(sum, sum), 0);
+		}
+		/// @brief Rotates 4 Vector3s in SoA layout with the same operation order as Quaternion::rotate().
+		/// @param[in] qx The X components of the unit Quaternions.
+		/// @param[in] qy The Y components of the unit Quaternions.
+		/// @param[in] qz The Z components of the unit Quaternions.
+		/// @param[in] qw The W components of the unit Quaternions.
+		/// @param[in,out] v The components as loaded by vld3q_f32().
+		inline void rotate3(float32x4_t qx, float32x4_t qy, float32x4_t qz, float32x4_t qw, float32x4x3_t& v)
+		{
+			float32x4_t tx = vsubq_f32(vmulq_f32(qy, v.val[2]), vmulq_f32(qz, v.val[1]));
+			float32x4_t ty = vsubq_f32(vmulq_f32(qz, v.val[0]), vmulq_f32(qx, v.val[2]));
+			float32x4_t tz = vsubq_f32(vmulq_f32(qx, v.val[1]), vmulq_f32(qy, v.val[0]));
+			tx = vaddq_f32(tx, tx);
+			ty = vaddq_f32(ty, ty);
+			tz = vaddq_f32(tz, tz);
+			v.val[0] = vaddq_f32(vmlaq_f32(v.val[0], qw, tx), vsubq_f32(vmulq_f32(qy, tz), vmulq_f32(qz, ty)));
+			v.val[1] = vaddq_f32(vmlaq_f32(v.val[1], qw, ty), vsubq_f32(vmulq_f32(qz, tx), vmulq_f32(qx, tz)));
+			v.val[2] = vaddq_f32(vmlaq_f32(v.val[2], qw, tz), vsubq_f32(vmulq_f32(qx, ty), vmulq_f32(qy, tx)));
+		}
+#endif
+
+		/// @brief Registers the Vector2 kernels of a level.
+		/// @param[in,out] kernels The kernel table, already filled with the kernels of the lower level.
+		/// @param[in] level The level.
+		void registerVector2Kernels(Kernels& kernels, Level level);
+		/// @brief Registers the Vector3 kernels of a level.
+		/// @param[in,out] kernels The kernel table, already filled with the kernels of the lower level.
+		/// @param[in] level The level.
+		void registerVector3Kernels(Kernels& kernels, Level level);
+		/// @brief Registers the Quaternion kernels of a level.
+		/// @param[in,out] kernels The kernel table, already filled with the kernels of the lower level.
+		/// @param[in] level The level.
+		void registerQuaternionKernels(Kernels& kernels, Level level);
+		/// @brief Registers the DualQuaternion kernels of a level.
+		/// @param[in,out] kernels The kernel table, already filled with the kernels of the lower level.
+		/// @param[in] level The level.
+		void registerDualQuaternionKernels(Kernels& kernels, Level level);
+		/// @brief Registers the Rectangle kernels of a level.
+		/// @param[in,out] kernels The kernel table, already filled with the kernels of the lower level.
+		/// @param[in] level The level.
+		void registerRectangleKernels(Kernels& kernels, Level level);
+		/// @brief Registers the packed Vector3 kernels of a level.
+		/// @param[in,out] kernels The kernel table, already filled with the kernels of the lower level.
+		/// @param[in] level The level.
+		void registerPackedVector3Kernels(Kernels& kernels, Level level);
+		/// @brief Registers the packed Quaternion kernels of a level.
+		/// @param[in,out] kernels The kernel table, already filled with the kernels of the lower level.
+		/// @param[in] level The level.
+		void registerPackedQuaternionKernels(Kernels& kernels, Level level);
+		/// @brief Registers the SpaceFillingCurve kernels of a level.
+		/// @param[in,out] kernels The kernel table, already filled with the kernels of the lower level.
+		/// @param[in] level The level.
+		void registerSpaceFillingCurveKernels(Kernels& kernels, Level level);
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,124 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS DirtyRegion
+#include <vector>
+
+#include <htest/htest.h>
+
+#include "DirtyRegion.h"
+#include "Rectangle.h"
+
+#include "RectangleFixture.h"
+
+// no two Rectangles of the region overlap
+static bool _isDisjoint(cgdirtyregioni region)
+{
+	const std::vector<grecti>& rectangles = region.getRectangles();
+	for (unsigned int i = 0; i < rectangles.size(); ++i)
+	{
+		for (unsigned int j = i + 1; j < rectangles.size(); ++j)
+		{
+			if (rectangles[i].intersects(rectangles[j]))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// every pixel of the added Rectangles is covered by the region, returns the number of covered pixels in the grid
+static int _checkCoverage(cgdirtyregioni region, const std::vector<grecti>& added, int size, bool& covered)
+{
+	std::vector<char> pixels(size * size, 0);
+	const std::vector<grecti>& rectangles = region.getRectangles();
+	for (unsigned int i = 0; i < rectangles.size(); ++i)
+	{
+		_fillPixels(rectangles[i], size, pixels);
+	}
+	std::vector<char> addedPixels(size * size, 0);
+	for (unsigned int i = 0; i < added.size(); ++i)
+	{
+		_fillPixels(added[i], size, addedPixels);
+	}
+	covered = true;
+	for (unsigned int i = 0; i < pixels.size(); ++i)
+	{
+		covered &= (addedPixels[i] <= pixels[i]);
+	}
+	return _countPixels(pixels);
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(merge)
+{
+	gdirtyregioni region;
+	HTEST_ASSERT(region.add(grecti(0, 0, 10, 10)) && region.add(grecti(10, 0, 10, 10)) && region.getCount() == 1, "add() of Rectangles sharing an edge");
+	HTEST_ASSERT(region.getRectangles()[0] == grecti(0, 0, 20, 10), "add() merges Rectangles sharing an edge");
+	HTEST_ASSERT(region.add(grecti(0, 5, 20, 10)) && region.getCount() == 1 && region.getRectangles()[0] == grecti(0, 0, 20, 15), "add() merges aligned overlapping Rectangles");
+	HTEST_ASSERT(!region.add(grecti(2, 2, 5, 5)) && !region.add(grecti(50, 50, 0, 5)) && region.getCount() == 1, "add() of covered and empty Rectangles");
+	HTEST_ASSERT(region.add(grecti(20, 20, 5, 5)) && region.getCount() == 2 && region.getArea() == 325.0, "add() of a separate Rectangle");
+	HTEST_ASSERT(region.isDirty(grecti(22, 22, 1, 1)) && !region.isDirty(grecti(20, 15, 5, 5)), "isDirty()");
+	HTEST_ASSERT(region.getExtent() == grecti(0, 0, 25, 25), "getExtent()");
+	region.clear();
+	HTEST_ASSERT(region.isEmpty(), "clear()");
+	gdirtyregionf floats;
+	floats.add(grectf(0.0f, 0.0f, 0.1f, 0.3f));
+	floats.add(grectf(0.1f, 0.0f, 0.7f, 0.3f));
+	HTEST_ASSERT(floats.getCount() == 1 && heqf(floats.getRectangles()[0].w, 0.8f), "add() merges float Rectangles sharing an edge");
+}
+
+HTEST_CASE(disjoint)
+{
+	gdirtyregioni region;
+	region.add(grecti(0, 0, 10, 10));
+	region.add(grecti(5, 5, 10, 10));
+	HTEST_ASSERT(_isDisjoint(region) && region.getArea() == 175.0, "add() cuts overlapping Rectangles");
+	region.setMergeArea(60.0);
+	region.add(grecti(9, 9, 10, 10));
+	HTEST_ASSERT(region.getCount() == 1 && region.getRectangles()[0] == grecti(0, 0, 19, 19), "add() merges within the merge area");
+	unsigned int seed = 3;
+	std::vector<grecti> added;
+	gdirtyregioni random(1000);
+	bool resultDisjoint = true;
+	for (int i = 0; i < 300; ++i)
+	{
+		added.push_back(grecti(_random(seed) % 180, _random(seed) % 180, 1 + _random(seed) % 20, 1 + _random(seed) % 20));
+		random.add(added.back());
+		resultDisjoint &= _isDisjoint(random);
+	}
+	bool covered = false;
+	int area = _checkCoverage(random, added, 200, covered);
+	HTEST_ASSERT(resultDisjoint && covered, "add() keeps the Rectangles disjoint and covers everything");
+	HTEST_ASSERT(random.getArea() == (double)area, "add() without a merge area adds no waste");
+}
+
+HTEST_CASE(maxCount)
+{
+	unsigned int seed = 11;
+	std::vector<grecti> added;
+	gdirtyregioni region(grecti(0, 0, 200, 200), 8);
+	bool resultCount = true;
+	for (int i = 0; i < 200; ++i)
+	{
+		added.push_back(grecti((int)(_random(seed) % 220) - 10, (int)(_random(seed) % 220) - 10, 1 + _random(seed) % 12, 1 + _random(seed) % 12));
+		region.add(added.back());
+		resultCount &= (region.getCount() <= 8);
+	}
+	bool covered = false;
+	int area = _checkCoverage(region, added, 200, covered);
+	HTEST_ASSERT(resultCount && _isDisjoint(region) && covered, "add() keeps the count, stays disjoint and covers everything");
+	HTEST_ASSERT(region.getArea() == (double)area && grecti(0, 0, 200, 200).contains(region.getExtent()), "add() clips to the bounds");
+	region.setMaxCount(1);
+	HTEST_ASSERT(region.getCount() == 1 && region.getRectangles()[0] == region.getExtent(), "setMaxCount()");
+	// two small separated Rectangles are cheaper to merge than the large ones
+	gdirtyregioni cheapest(2);
+	cheapest.add(grecti(0, 0, 50, 50));
+	cheapest.add(grecti(100, 100, 2, 2));
+	cheapest.add(grecti(103, 100, 2, 2));
+	HTEST_ASSERT(cheapest.getCount() == 2 && cheapest.isDirty(grecti(102, 100, 1, 1)) && !cheapest.isDirty(grecti(60, 60, 30, 30)), "add() merges the cheapest Rectangles");
+	region.setBounds(grecti(0, 0, 50, 50));
+	HTEST_ASSERT(region.getExtent() == grecti(0, 0, 50, 50) && region.isBounded(), "setBounds()");
+}
+
+HTEST_SUITE_END
@@ -0,0 +1,127 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS DualQuaternion
+#include <htest/htest.h>
+
+#include "DualQuaternion.h"
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+#define E_TOLRANCE 0.0001f
+
+static bool quateqf(const gquat& q1, const gquat& q2)
+{
+	return (heqf(q1.x, q2.x) && heqf(q1.y, q2.y) && heqf(q1.z, q2.z) && heqf(q1.w, q2.w));
+}
+
+static bool veceqf(const gvec3f& v1, const gvec3f& v2)
+{
+	return (heqf(v1.x, v2.x) && heqf(v1.y, v2.y) && heqf(v1.z, v2.z));
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(assignment)
+{
+	gdualquat identity;
+	HTEST_ASSERT(identity.real == gquat(0.0f, 0.0f, 0.0f, 1.0f) && identity.dual == gquat(0.0f, 0.0f, 0.0f, 0.0f), "identity constructor");
+	gquat rotation = gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 90.0f);
+	gdualquat dq(rotation, gvec3f(1.0f, 2.0f, 3.0f));
+	HTEST_ASSERT(dq.rotation() == rotation, "rotation()");
+	HTEST_ASSERT(veceqf(dq.translation(), gvec3f(1.0f, 2.0f, 3.0f)), "translation()");
+	HTEST_ASSERT(veceqf(dq.transformPoint(gvec3f(1.0f, 0.0f, 0.0f)), gvec3f(1.0f, 3.0f, 3.0f)), "transformPoint() rotates, then translates");
+	HTEST_ASSERT(veceqf(dq.transformNormal(gvec3f(1.0f, 0.0f, 0.0f)), gvec3f(0.0f, 1.0f, 0.0f)), "transformNormal() only rotates");
+	gdualquat other;
+	other.set(dq.real, dq.dual);
+	HTEST_ASSERT(other == dq, "set(gquat, gquat)");
+	other.set(rotation, gvec3f(-1.0f, 0.0f, 0.0f));
+	HTEST_ASSERT(other != dq && veceqf(other.translation(), gvec3f(-1.0f, 0.0f, 0.0f)), "set(gquat, gvec3f)");
+}
+
+HTEST_CASE(combine)
+{
+	gdualquat a(gquat::fromAxisAngle(1.0f, 2.0f, 0.5f, 40.0f), gvec3f(3.0f, -1.0f, 2.0f));
+	gdualquat b(gquat::fromAxisAngle(-0.3f, 1.0f, 1.0f, 125.0f), gvec3f(0.5f, 4.0f, -2.0f));
+	gvec3f point(1.5f, -2.0f, 0.25f);
+	HTEST_ASSERT(veceqf((a * b).transformPoint(point), a.transformPoint(b.transformPoint(point))), "operator*() applies the right side first");
+	gdualquat c = a;
+	c *= b;
+	HTEST_ASSERT(c == a * b, "operator*=()");
+	HTEST_ASSERT(veceqf(a.inversed().transformPoint(a.transformPoint(point)), point), "inversed()");
+	gdualquat scaled = a * 3.0f + gdualquat(gquat(0.0f, 0.0f, 0.0f, 0.0f), gquat(0.1f, 0.2f, 0.3f, 0.4f));
+	gdualquat normalized = scaled.normalized();
+	HTEST_ASSERT(heqf(normalized.real.length(), 1.0f) && heqf(normalized.real.dot(normalized.dual), 0.0f), "normalized()");
+	HTEST_ASSERT(quateqf(normalized.real, a.real), "normalized() keeps the rotation");
+}
+
+HTEST_CASE(matrix)
+{
+	gvec3f point(1.5f, -2.0f, 0.25f);
+	// rotations of 180 degrees around each axis use all branches of fromMatrix()
+	gvec3f axes[5] = { gvec3f(1.0f, 2.0f, 0.5f), gvec3f(1.0f, 0.0f, 0.0f), gvec3f(0.0f, 1.0f, 0.0f), gvec3f(0.0f, 0.0f, 1.0f), gvec3f(0.2f, -1.0f, 0.4f) };
+	float angles[5] = { 40.0f, 180.0f, 180.0f, 180.0f, 170.0f };
+	for (int i = 0; i < 5; ++i)
+	{
+		gdualquat dq(gquat::fromAxisAngle(axes[i], angles[i]), gvec3f(3.0f, -1.0f, 2.0f));
+		gmat4 matrix = dq.mat4();
+		HTEST_ASSERT(veceqf(matrix * point, dq.transformPoint(point)), "mat4() * point");
+		gdualquat converted = gdualquat::fromMatrix(matrix);
+		if (converted.real.dot(dq.real) < 0.0f)
+		{
+			converted = converted * -1.0f;
+		}
+		HTEST_ASSERT(quateqf(converted.real, dq.real) && quateqf(converted.dual, dq.dual), "fromMatrix()");
+	}
+}
+
+HTEST_CASE(blend)
+{
+	gdualquat a(gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 20.0f), gvec3f(2.0f, 0.0f, 0.0f));
+	gdualquat b(gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 80.0f), gvec3f(0.0f, 2.0f, 0.0f));
+	gdualquat half = gdualquat::blend(a, b, 0.5f);
+	HTEST_ASSERT(quateqf(half.real, gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 50.0f)), "blend() rotation");
+	HTEST_ASSERT(heqf(half.real.dot(half.dual), 0.0f), "blend() is normalized");
+	HTEST_ASSERT(quateqf(gdualquat::blend(a, b, 0.0f).real, a.real) && quateqf(gdualquat::blend(a, b, 1.0f).dual, b.dual), "blend() end points");
+	gdualquat negated(-b.real, -b.dual);
+	gdualquat shorter = gdualquat::blend(a, negated, 0.5f);
+	HTEST_ASSERT(quateqf(shorter.real, half.real) && quateqf(shorter.dual, half.dual), "blend() shorter path");
+	gdualquat dualQuaternions[3] = { a, negated, a };
+	float weights[3] = { 1.0f, 2.0f, 1.0f };
+	gdualquat blended = gdualquat::blend(dualQuaternions, weights, 3);
+	HTEST_ASSERT(quateqf(blended.real, half.real) && quateqf(blended.dual, half.dual), "blend(const gdualquat*, const float*, int)");
+	HTEST_ASSERT(gdualquat::blend(dualQuaternions, weights, 0) == gdualquat(), "blend() without DualQuaternions");
+}
+
+HTEST_CASE(skin)
+{
+	gdualquat bones[3];
+	bones[0].set(gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 30.0f), gvec3f(1.0f, 0.0f, 0.0f));
+	bones[1].set(gquat::fromAxisAngle(1.0f, 1.0f, 0.0f, 200.0f), gvec3f(0.0f, -2.0f, 1.0f));
+	bones[2].set(gquat::fromAxisAngle(0.0f, 1.0f, 0.0f, -60.0f), gvec3f(0.5f, 0.5f, 0.5f));
+	gvec3f positions[5];
+	gvec3f normals[5];
+	int indices[10] = { 0, 1, 2, 0, 1, 1, 2, 1, 0, 2 };
+	float weights[10] = { 0.75f, 0.25f, 0.5f, 0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 0.3f, 0.3f };
+	for (int i = 0; i < 5; ++i)
+	{
+		positions[i].set(i - 2.0f, 1.0f + i * 0.5f, -0.5f * i);
+		normals[i] = gvec3f(1.0f, i * 0.3f, 0.5f).normalized();
+	}
+	gvec3f resultPositions[5];
+	gvec3f resultNormals[5];
+	gdualquat::skin(bones, indices, weights, 2, positions, normals, resultPositions, resultNormals, 5);
+	bool result = true;
+	for (int i = 0; i < 5; ++i)
+	{
+		gdualquat influences[2] = { bones[indices[i * 2]], bones[indices[i * 2 + 1]] };
+		gdualquat blended = (i == 3 ? gdualquat() : gdualquat::blend(influences, &weights[i * 2], 2));
+		result &= veceqf(resultPositions[i], blended.transformPoint(positions[i]));
+		result &= veceqf(resultNormals[i], blended.transformNormal(normals[i]));
+	}
+	HTEST_ASSERT(result, "skin()");
+	HTEST_ASSERT(resultPositions[3] == positions[3] && resultNormals[3] == normals[3], "skin() keeps vertices without weight");
+	gdualquat::skin(bones, indices, weights, 2, positions, NULL, positions, NULL, 5);
+	HTEST_ASSERT(positions[0] == resultPositions[0] && positions[4] == resultPositions[4], "skin() in place without normals");
+}
+
+HTEST_SUITE_END
@@ -0,0 +1,156 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS Expression
+#include <htest/htest.h>
+
+#include "Expression.h"
+#include "Quaternion.h"
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+#define E_TOLRANCE 0.0001f
+
+static bool vec3eqf(const gvec3f& v1, const gvec3f& v2)
+{
+	return (heqf(v1.x, v2.x) && heqf(v1.y, v2.y) && heqf(v1.z, v2.z));
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(value)
+{
+	gvec3f a(1.0f, 2.0f, 3.0f), b(2.0f, 2.0f, 2.0f), c(0.5f, 0.5f, 0.5f);
+	gvec3f v = gtypes::lazy(a) + gtypes::lazy(b) * 2.0f - gtypes::lazy(c);
+	HTEST_ASSERT(vec3eqf(v, a + b * 2.0f - c), "");
+	v = -(gtypes::lazy(a) * gtypes::lazy(b)) / 2.0f;
+	HTEST_ASSERT(vec3eqf(v, gvec3f(-1.0f, -2.0f, -3.0f)), "negate, multiply and divide");
+	gvec2i i = gtypes::lazy(gvec2i(1, 2)) * 3 + gtypes::lazy(gvec2i(1, 1));
+	HTEST_ASSERT(i == gvec2i(4, 7), "int");
+	gvec3i j(10, 7, -5);
+	HTEST_ASSERT((gvec3i)(gtypes::lazy(j) * 0.5f) == j * 0.5f && (gvec3i)(0.5f * gtypes::lazy(j)) == gvec3i(5, 3, -2), "int with a fractional factor");
+	HTEST_ASSERT((gvec3i)(gtypes::lazy(j) / 0.5f) == gvec3i(20, 14, -10) && (gvec3i)(gtypes::lazy(j) / 2) == j / 2, "int divided by a fractional factor");
+	HTEST_ASSERT((gvec3i)(gtypes::lazy(j) + gtypes::lazy(gvec3f(0.5f, 0.5f, 0.5f)) * 3.0f) == j + gvec3f(1.5f, 1.5f, 1.5f), "int with float operands");
+	gquat q = gtypes::lazy(gquat(1.0f, 2.0f, 3.0f, 4.0f)) + gtypes::lazy(gquat(1.0f, 1.0f, 1.0f, 1.0f)) * 0.5f;
+	HTEST_ASSERT(q == gquat(1.5f, 2.5f, 3.5f, 4.5f), "quaternion");
+}
+
+HTEST_CASE(array)
+{
+	gvec3f positions[5];
+	gvec3f velocities[5];
+	for (int i = 0; i < 5; ++i)
+	{
+		positions[i].set((float)i, 0.0f, 1.0f);
+		velocities[i].set(1.0f, (float)i, -1.0f);
+	}
+	gtypes::lazy(positions, 5) += gtypes::lazy((const gvec3f*)velocities, 5) * 0.5f;
+	for (int i = 0; i < 5; ++i)
+	{
+		HTEST_ASSERT(vec3eqf(positions[i], gvec3f(i + 0.5f, i * 0.5f, 0.5f)), "+=");
+	}
+	gvec3f offset(1.0f, 1.0f, 1.0f);
+	gtypes::lazy(positions, 5) = gtypes::lazy(velocities, 5) - gtypes::lazy(offset);
+	for (int i = 0; i < 5; ++i)
+	{
+		HTEST_ASSERT(vec3eqf(positions[i], gvec3f(0.0f, i - 1.0f, -2.0f)), "= with broadcast value");
+	}
+	gtypes::lazy(positions, 5) = gtypes::lazy(velocities, 5);
+	HTEST_ASSERT(positions[3] == velocities[3], "= with array");
+	gtypes::lazy(positions, 5) = gtypes::lazy(velocities, 5) - gtypes::lazy(offset);
+	gtypes::lazy(positions, 5) *= 2.0f;
+	HTEST_ASSERT(vec3eqf(positions[4], gvec3f(0.0f, 6.0f, -4.0f)), "*=");
+	gvec3f shorter[2] = { gvec3f(1.0f, 1.0f, 1.0f), gvec3f(2.0f, 2.0f, 2.0f) };
+	gtypes::lazy(positions, 5) = gtypes::lazy(velocities, 5) + gtypes::lazy(shorter, 2);
+	HTEST_ASSERT(positions[1] == velocities[1] + shorter[1] && vec3eqf(positions[2], gvec3f(0.0f, 2.0f, -4.0f)), "= with a shorter operand");
+	gtypes::lazy(positions, 5) += gtypes::lazy(shorter, 2);
+	HTEST_ASSERT(positions[0] == velocities[0] + shorter[0] * 2.0f && vec3eqf(positions[2], gvec3f(0.0f, 2.0f, -4.0f)), "+= with a shorter operand");
+	gvec3i counts[3] = { gvec3i(10, 10, 10), gvec3i(3, 3, 3), gvec3i(-7, -7, -7) };
+	gtypes::lazy(counts, 3) *= 0.5f;
+	HTEST_ASSERT(counts[0] == gvec3i(5, 5, 5) && counts[1] == gvec3i(1, 1, 1) && counts[2] == gvec3i(-3, -3, -3), "*= of int with a fractional factor");
+}
+
+HTEST_CASE(soa)
+{
+	float x[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+	float y[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	float z[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	gvec3f velocities[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		velocities[i].set(1.0f, 2.0f, 3.0f);
+	}
+	gtypes::lazy(x, y, z, 4) += gtypes::lazy(velocities, 4) * 2.0f;
+	HTEST_ASSERT(x[3] == 5.0f && y[2] == 4.0f && z[0] == 7.0f, "+= from AoS");
+	gtypes::lazy(velocities, 4) = gtypes::lazy(x, y, z, 4) - gtypes::lazy(x, y, z, 4);
+	HTEST_ASSERT(velocities[1].isNull(), "AoS from SoA");
+	gtypes::lazy(x, y, z, 4) -= gtypes::lazy(velocities, 2) + gtypes::lazy(gvec3f(1.0f, 1.0f, 1.0f));
+	HTEST_ASSERT(x[1] == 2.0f && x[2] == 4.0f && z[3] == 7.0f, "-= with a shorter operand");
+}
+
+HTEST_CASE(temporary)
+{
+	gvec3f a(1.0f, 2.0f, 3.0f);
+	// the expression keeps copies of the temporaries it was created from
+	gtypes::ExpressionBinary<gtypes::ExpressionValue<gvec3f>, gtypes::ExpressionValue<gvec3f>, gtypes::ExpressionAdd> sum = gtypes::lazy(a) + gtypes::lazy(gvec3f(1.0f, 1.0f, 1.0f));
+	gvec3f other(5.0f, 5.0f, 5.0f);
+	gvec3f v = sum;
+	HTEST_ASSERT(vec3eqf(v, gvec3f(2.0f, 3.0f, 4.0f)) && other.x == 5.0f, "value outlives a temporary");
+}
+
+HTEST_CASE(dimensions)
+{
+	gvec4f vectors[3];
+	gquat quaternions[3];
+	gvec2f positions[3];
+	float x[3] = { 1.0f, 2.0f, 3.0f };
+	float y[3] = { 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < 3; ++i)
+	{
+		vectors[i].set((float)i, 1.0f, 2.0f, 3.0f);
+		quaternions[i].set(1.0f, 1.0f, 1.0f, (float)i);
+		positions[i].set(1.0f, (float)i);
+	}
+	gtypes::lazy(vectors, 3) += gtypes::lazy((const gquat*)quaternions, 3) * 2.0f;
+	HTEST_ASSERT(vectors[2] == gvec4f(4.0f, 3.0f, 4.0f, 7.0f), "Vector4 and Quaternion with the same number of components");
+	gtypes::lazy(x, y, 3) = gtypes::lazy(positions, 3) * gtypes::lazy(gvec2f(2.0f, 3.0f));
+	HTEST_ASSERT(x[1] == 2.0f && y[2] == 6.0f, "SoA and AoS with the same number of components");
+	typedef gtypes::ExpressionArray<gvec2f> Array2;
+	typedef gtypes::ExpressionArray<gvec3f> Array3;
+	typedef gtypes::ExpressionArray<gvec4f> Array4;
+	typedef gtypes::ExpressionArray<gquat> ArrayQuaternion;
+	typedef gtypes::ExpressionScalar<float> Scalar;
+	bool matching = (gtypes::_ExpressionDimensionsMatch<Array3, Array3>::Value && gtypes::_ExpressionDimensionsMatch<Array2, Scalar>::Value &&
+		gtypes::_ExpressionDimensionsMatch<Scalar, Array4>::Value);
+	bool different = (!gtypes::_ExpressionDimensionsMatch<Array3, Array2>::Value && !gtypes::_ExpressionDimensionsMatch<Array4, Array3>::Value);
+	bool componentWise = (gtypes::_ExpressionComponentWise<Array4>::Value && gtypes::_ExpressionComponentWise<Scalar>::Value &&
+		!gtypes::_ExpressionComponentWise<ArrayQuaternion>::Value);
+	HTEST_ASSERT(matching, "matching dimensions");
+	HTEST_ASSERT(different, "different dimensions");
+	HTEST_ASSERT(componentWise, "component-wise types");
+}
+
+// each of these has to fail to compile, build with EXPRESSION_REJECT defined as 1 to 5 to check them
+#if defined(EXPRESSION_REJECT)
+HTEST_CASE(rejected)
+{
+	gvec2f vectors2[3];
+	gvec3f vectors3[3];
+	gvec4f vectors4[3];
+	gquat quaternions[3];
+	float x[3];
+	float y[3];
+#if EXPRESSION_REJECT == 1
+	gtypes::lazy(vectors3, 3) = gtypes::lazy(vectors2, 3) + gtypes::lazy(vectors3, 3);
+#elif EXPRESSION_REJECT == 2
+	gtypes::lazy(vectors3, 3) = gtypes::lazy(vectors2, 3);
+#elif EXPRESSION_REJECT == 3
+	gtypes::lazy(x, y, 3) += gtypes::lazy(vectors3, 3);
+#elif EXPRESSION_REJECT == 4
+	gtypes::lazy(vectors4, 3) = gtypes::lazy(vectors4, 3) * gtypes::lazy(quaternions, 3);
+#elif EXPRESSION_REJECT == 5
+	gtypes::lazy(vectors4, 3) = gtypes::lazy(vectors4, 3) / gtypes::lazy(quaternions, 3);
+#endif
+}
+#endif
+
+HTEST_SUITE_END
@@ -0,0 +1,228 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS KeyframeTrack
+#include <math.h>
+
+#include <htest/htest.h>
+
+#include "KeyframeTrack.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+#define E_TOLRANCE 0.0001f
+
+static unsigned long long _random(unsigned long long& seed)
+{
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return seed;
+}
+
+static float _randomFloat(unsigned long long& seed)
+{
+	return (float)(_random(seed) >> 40) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+static gquat _createQuaternion(unsigned long long& seed)
+{
+	float x = _randomFloat(seed);
+	float y = _randomFloat(seed);
+	float z = _randomFloat(seed);
+	return gquat(x, y, z, _randomFloat(seed)).normalized();
+}
+
+static bool _equals(const gvec3f& a, const gvec3f& b, float tolerance)
+{
+	return (fabsf(a.x - b.x) <= tolerance && fabsf(a.y - b.y) <= tolerance && fabsf(a.z - b.z) <= tolerance);
+}
+
+// q and -q are the same rotation
+static bool _equals(const gquat& a, const gquat& b, float tolerance)
+{
+	return (fabsf(a.dot(b)) >= 1.0f - tolerance);
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(linear)
+{
+	float times[4] = { 0.0f, 1.0f, 3.0f, 4.0f };
+	gvec3f values[4] = { gvec3f(0.0f, 0.0f, 0.0f), gvec3f(2.0f, 0.0f, 0.0f), gvec3f(2.0f, 4.0f, 0.0f), gvec3f(2.0f, 4.0f, -1.0f) };
+	gtrack3f empty;
+	HTEST_ASSERT(empty.getCount() == 0 && empty.sample(1.0f) == gvec3f(), "sample() without keys");
+	gtrack3f single(times, values + 1, 1);
+	HTEST_ASSERT(single.sample(-1.0f) == values[1] && single.sample(5.0f) == values[1], "sample() with one key");
+	gtrack3f track(times, values, 4);
+	HTEST_ASSERT(track.getCount() == 4 && track.getStartTime() == 0.0f && track.getEndTime() == 4.0f, "getCount(), getStartTime() and getEndTime()");
+	HTEST_ASSERT(track.sample(-1.0f) == values[0] && track.sample(9.0f) == values[3], "sample() clamps to the first and last key");
+	HTEST_ASSERT(track.sample(1.0f) == values[1] && track.sample(3.0f) == values[2], "sample() at keys");
+	HTEST_ASSERT(_equals(track.sample(0.25f), gvec3f(0.5f, 0.0f, 0.0f), E_TOLRANCE), "sample() in the first segment");
+	HTEST_ASSERT(_equals(track.sample(2.5f), gvec3f(2.0f, 3.0f, 0.0f), E_TOLRANCE), "sample() in a longer segment");
+	float duplicateTimes[3] = { 0.0f, 1.0f, 1.0f };
+	gtrack3f duplicate(duplicateTimes, values, 3);
+	HTEST_ASSERT(duplicate.sample(1.0f) == values[2] && duplicate.sample(0.5f) == gvec3f(1.0f, 0.0f, 0.0f), "sample() with keys at the same time");
+}
+
+HTEST_CASE(cursor)
+{
+	float times[50];
+	gvec3f values[50];
+	gquat rotations[50];
+	unsigned long long seed = 3;
+	float time = 0.0f;
+	for (int i = 0; i < 50; ++i)
+	{
+		times[i] = time;
+		time += 0.1f + (float)(_random(seed) % 10) * 0.05f;
+		values[i].set(_randomFloat(seed), _randomFloat(seed), _randomFloat(seed));
+		rotations[i] = _createQuaternion(seed);
+	}
+	gtrack3f track(times, values, 50);
+	gtrackq rotationTrack(times, rotations, 50, gtypes::KeyframeInterpolationSlerp);
+	gtypes::KeyframeCursor cursor;
+	gtypes::KeyframeCursor rotationCursor;
+	bool resultForward = true;
+	for (float t = -0.5f; t < time + 0.5f; t += 0.033f)
+	{
+		resultForward &= (track.sample(t, cursor) == track.sample(t));
+		resultForward &= (rotationTrack.sample(t, rotationCursor) == rotationTrack.sample(t));
+		resultForward &= (cursor.index >= 0 && cursor.index <= 48 && (t < times[cursor.index] ? cursor.index == 0 : true));
+	}
+	HTEST_ASSERT(resultForward, "sample() with a cursor during playback");
+	bool resultJump = true;
+	for (int i = 0; i < 200; ++i)
+	{
+		float t = (_randomFloat(seed) * 0.6f + 0.5f) * time;
+		resultJump &= (track.sample(t, cursor) == track.sample(t));
+		resultJump &= (rotationTrack.sample(t, rotationCursor) == rotationTrack.sample(t));
+	}
+	HTEST_ASSERT(resultJump, "sample() with a cursor after jumps");
+	cursor.index = 1000;
+	HTEST_ASSERT(track.sample(times[7], cursor) == values[7] && cursor.index == 7, "sample() with an invalid cursor");
+}
+
+HTEST_CASE(quaternion)
+{
+	float times[3] = { 0.0f, 1.0f, 2.0f };
+	gquat rotations[3] = { gquat(0.0f, 0.0f, 0.0f, 1.0f), gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 90.0f), gquat::fromAxisAngle(1.0f, 0.0f, 0.0f, 120.0f) };
+	gtrackq empty;
+	HTEST_ASSERT(empty.sample(1.0f) == gquat(0.0f, 0.0f, 0.0f, 1.0f), "sample() without keys is the identity");
+	gtrackq track(times, rotations, 3, gtypes::KeyframeInterpolationSlerp);
+	HTEST_ASSERT(track.sample(0.3f) == gquat::slerp(rotations[0], rotations[1], 0.3f), "sample() with slerp");
+	HTEST_ASSERT(track.sample(1.75f) == gquat::slerp(rotations[1], rotations[2], 0.75f), "sample() with slerp in the second segment");
+	track.setInterpolation(gtypes::KeyframeInterpolationLinear);
+	HTEST_ASSERT(track.getInterpolation() == gtypes::KeyframeInterpolationLinear, "setInterpolation()");
+	HTEST_ASSERT(track.sample(0.3f) == gquat::nlerp(rotations[0], rotations[1], 0.3f), "sample() with nlerp");
+}
+
+HTEST_CASE(catmullRom)
+{
+	float times[5] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f };
+	gvec3f values[5] = { gvec3f(0.0f, 0.0f, 0.0f), gvec3f(1.0f, 2.0f, 0.0f), gvec3f(3.0f, 1.0f, 1.0f), gvec3f(4.0f, 4.0f, 0.0f), gvec3f(5.0f, 3.0f, 2.0f) };
+	gtrack3f track(times, values, 5, gtypes::KeyframeInterpolationCatmullRom);
+	bool resultKeys = true;
+	for (int i = 0; i < 5; ++i)
+	{
+		resultKeys &= _equals(track.sample(times[i]), values[i], E_TOLRANCE);
+	}
+	HTEST_ASSERT(resultKeys, "sample() passes through the keys");
+	// evenly spaced collinear keys have a constant velocity
+	gvec3f line[5];
+	for (int i = 0; i < 5; ++i)
+	{
+		line[i].set((float)i * 2.0f, (float)i, 0.0f);
+	}
+	gtrack3f lineTrack(times, line, 5, gtypes::KeyframeInterpolationCatmullRom);
+	gtrack3f linearTrack(times, line, 5);
+	bool resultLine = true;
+	for (float t = 1.0f; t <= 3.0f; t += 0.1f)
+	{
+		resultLine &= _equals(lineTrack.sample(t), linearTrack.sample(t), E_TOLRANCE);
+	}
+	HTEST_ASSERT(resultLine, "sample() on a line");
+	gquat rotations[5];
+	for (int i = 0; i < 5; ++i)
+	{
+		// alternating signs must not flip the interpolation
+		rotations[i] = gquat::fromAxisAngle(0.0f, 1.0f, 0.0f, (float)i * 30.0f) * (i % 2 == 0 ? 1.0f : -1.0f);
+	}
+	gtrackq rotationTrack(times, rotations, 5, gtypes::KeyframeInterpolationCatmullRom);
+	gquat expected = gquat::fromAxisAngle(0.0f, 1.0f, 0.0f, 45.0f);
+	HTEST_ASSERT(_equals(rotationTrack.sample(1.5f), expected, E_TOLRANCE), "sample() with Quaternions");
+	HTEST_ASSERT(heqf(rotationTrack.sample(2.7f).length(), 1.0f), "sample() with Quaternions has unit length");
+}
+
+HTEST_CASE(compress)
+{
+	float times[20];
+	gvec3f values[20];
+	gquat rotations[20];
+	unsigned long long seed = 7;
+	for (int i = 0; i < 20; ++i)
+	{
+		times[i] = (float)i * 0.5f;
+		values[i].set(_randomFloat(seed) * 10.0f, _randomFloat(seed) * 10.0f, _randomFloat(seed));
+		rotations[i] = _createQuaternion(seed);
+	}
+	gtrack3f track(times, values, 20);
+	gtrackq rotationTrack(times, rotations, 20, gtypes::KeyframeInterpolationSlerp);
+	gtrack3f compressed = track;
+	gtrackq compressedRotations = rotationTrack;
+	compressed.compress();
+	compressedRotations.compress();
+	HTEST_ASSERT(compressed.isCompressed() && !track.isCompressed() && compressed.getCount() == 20, "compress()");
+	bool resultKeys = true;
+	bool resultSamples = true;
+	for (int i = 0; i < 20; ++i)
+	{
+		// 16 bits within a range of 20
+		resultKeys &= _equals(compressed.getValue(i), values[i], 20.0f / 65535.0f);
+		resultKeys &= _equals(compressedRotations.getValue(i), rotations[i], 0.0001f);
+	}
+	for (float t = 0.0f; t < 10.0f; t += 0.13f)
+	{
+		resultSamples &= _equals(compressed.sample(t), track.sample(t), 20.0f / 65535.0f);
+		resultSamples &= _equals(compressedRotations.sample(t), rotationTrack.sample(t), 0.0001f);
+	}
+	HTEST_ASSERT(resultKeys, "getValue() after compress()");
+	HTEST_ASSERT(resultSamples, "sample() after compress()");
+	compressed.set(times, values, 20);
+	HTEST_ASSERT(!compressed.isCompressed() && compressed.getValue(3) == values[3], "set() after compress()");
+}
+
+HTEST_CASE(batch)
+{
+	const int count = 45;
+	float times[10];
+	gquat rotations[10];
+	gtrackq tracks[count];
+	gtypes::KeyframeCursor cursors[count];
+	gtypes::KeyframeCursor singleCursors[count];
+	gquat result[count];
+	unsigned long long seed = 13;
+	for (int i = 0; i < count; ++i)
+	{
+		int keys = i % 10;
+		for (int j = 0; j < keys; ++j)
+		{
+			times[j] = (float)j * 0.4f + (float)(i % 3) * 0.1f;
+			rotations[j] = _createQuaternion(seed);
+		}
+		tracks[i].set(times, rotations, keys, (gtypes::KeyframeInterpolation)(i % 3));
+		if (i % 4 == 0)
+		{
+			tracks[i].compress();
+		}
+	}
+	bool resultBatch = true;
+	for (float t = -0.2f; t < 4.0f; t += 0.05f)
+	{
+		gtrackq::sample(tracks, cursors, count, t, result);
+		for (int i = 0; i < count; ++i)
+		{
+			resultBatch &= _equals(result[i], tracks[i].sample(t, singleCursors[i]), 0.0001f);
+			resultBatch &= (cursors[i].index == singleCursors[i].index);
+		}
+	}
+	HTEST_ASSERT(resultBatch, "sample() of many tracks");
+}
+
+HTEST_SUITE_END
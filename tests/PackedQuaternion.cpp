@@ -0,0 +1,163 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS PackedQuaternion
+#include <math.h>
+#include <string.h>
+
+#include <htest/htest.h>
+
+#include "PackedQuaternion.h"
+#include "Quaternion.h"
+
+#define E_TOLRANCE 0.0001f
+
+static unsigned long long _random(unsigned long long& seed)
+{
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return seed;
+}
+
+static gquat _createQuaternion(unsigned long long& seed)
+{
+	float components[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		components[i] = (float)(_random(seed) >> 40) * (2.0f / 16777216.0f) - 1.0f;
+	}
+	return gquat(components[0], components[1], components[2], components[3]).normalized();
+}
+
+// compares with the sign of the original since q and -q are the same rotation
+static float _maximumError(const gquat& decoded, const gquat& quaternion)
+{
+	gquat original = (decoded.dot(quaternion) < 0.0f ? -quaternion : quaternion);
+	float error = fabsf(decoded.x - original.x);
+	error = (fabsf(decoded.y - original.y) > error ? fabsf(decoded.y - original.y) : error);
+	error = (fabsf(decoded.z - original.z) > error ? fabsf(decoded.z - original.z) : error);
+	return (fabsf(decoded.w - original.w) > error ? fabsf(decoded.w - original.w) : error);
+}
+
+static gtypes::SmallestThree32Quaternion _createPacked(unsigned int a, unsigned int b, unsigned int c, unsigned int index)
+{
+	gtypes::SmallestThree32Quaternion result;
+	result.value = a | (b << 10) | (c << 20) | (index << 30);
+	return result;
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(size)
+{
+	HTEST_ASSERT(sizeof(gtypes::SmallestThree29Quaternion) == 4, "sizeof(SmallestThree29Quaternion)");
+	HTEST_ASSERT(sizeof(gtypes::SmallestThree32Quaternion) == 4, "sizeof(SmallestThree32Quaternion)");
+	HTEST_ASSERT(sizeof(gtypes::SmallestThree48Quaternion) == 6, "sizeof(SmallestThree48Quaternion)");
+}
+
+HTEST_CASE(smallestThree)
+{
+	gquat identity(0.0f, 0.0f, 0.0f, 1.0f);
+	HTEST_ASSERT(gtypes::SmallestThree29Quaternion().toQuaternion() == identity, "SmallestThree29Quaternion() is the identity");
+	HTEST_ASSERT(gtypes::SmallestThree32Quaternion().toQuaternion() == identity, "SmallestThree32Quaternion() is the identity");
+	HTEST_ASSERT(gtypes::SmallestThree48Quaternion().toQuaternion() == identity, "SmallestThree48Quaternion() is the identity");
+	HTEST_ASSERT(gtypes::SmallestThree29Quaternion(identity).value == gtypes::SmallestThree29Quaternion().value, "SmallestThree29Quaternion(identity)");
+	HTEST_ASSERT(gtypes::SmallestThree32Quaternion(identity).value == gtypes::SmallestThree32Quaternion().value, "SmallestThree32Quaternion(identity)");
+	gtypes::SmallestThree48Quaternion packed48(identity);
+	HTEST_ASSERT(packed48.x == 0xBFFF && packed48.y == 0xBFFF && packed48.z == 0x3FFF, "SmallestThree48Quaternion(identity)");
+	float maximumError29 = 0.0f;
+	float maximumError32 = 0.0f;
+	float maximumError48 = 0.0f;
+	bool resultSign = true;
+	bool resultUnit = true;
+	unsigned long long seed = 11;
+	for (int i = 0; i < 1000; ++i)
+	{
+		gquat quaternion = _createQuaternion(seed);
+		gtypes::SmallestThree29Quaternion packed29(quaternion);
+		gtypes::SmallestThree32Quaternion packed32(quaternion);
+		packed48.set(quaternion);
+		gquat decoded29 = packed29.toQuaternion();
+		gquat decoded32 = packed32.toQuaternion();
+		gquat decoded48 = packed48.toQuaternion();
+		float error = _maximumError(decoded29, quaternion);
+		maximumError29 = (error > maximumError29 ? error : maximumError29);
+		error = _maximumError(decoded32, quaternion);
+		maximumError32 = (error > maximumError32 ? error : maximumError32);
+		error = _maximumError(decoded48, quaternion);
+		maximumError48 = (error > maximumError48 ? error : maximumError48);
+		resultSign &= ((packed29.value >> 29) == 0 && (packed48.z & 0x8000) == 0);
+		resultSign &= (gtypes::SmallestThree32Quaternion(-quaternion).value == packed32.value);
+		resultUnit &= (heqf(decoded29.length(), 1.0f) && heqf(decoded32.length(), 1.0f) && heqf(decoded48.length(), 1.0f));
+	}
+	// the largest component is restored from the others, its error is at most 3 times theirs
+	HTEST_ASSERT(maximumError29 < 3.0f / (2.0f * 255.0f * 1.41421356f), "SmallestThree29Quaternion error");
+	HTEST_ASSERT(maximumError32 < 3.0f / (2.0f * 511.0f * 1.41421356f), "SmallestThree32Quaternion error");
+	HTEST_ASSERT(maximumError48 < 3.0f / (2.0f * 16383.0f * 1.41421356f), "SmallestThree48Quaternion error");
+	HTEST_ASSERT(resultSign, "q and -q have the same code, unused bits stay 0");
+	HTEST_ASSERT(resultUnit, "decoded Quaternions have unit length");
+	gtypes::SmallestThree29Quaternion tie(gquat(0.5f, 0.5f, 0.5f, 0.5f));
+	HTEST_ASSERT((tie.value >> 27) == 0, "ties select the lowest index");
+	gquat negative(0.0f, -0.70710678f, 0.70710678f, 0.0f);
+	gquat decoded = gtypes::SmallestThree32Quaternion(negative).toQuaternion();
+	HTEST_ASSERT(heqf(decoded.y, 0.70710678f) && heqf(decoded.z, -0.70710678f), "negative largest component");
+	gquat quaternions[9];
+	gtypes::SmallestThree48Quaternion packed[9];
+	gquat result[9];
+	for (int i = 0; i < 9; ++i)
+	{
+		quaternions[i] = _createQuaternion(seed);
+	}
+	gtypes::SmallestThree48Quaternion::encode(quaternions, packed, 9);
+	gtypes::SmallestThree48Quaternion::decode(packed, result, 9);
+	bool resultBatch = true;
+	for (int i = 0; i < 9; ++i)
+	{
+		resultBatch &= (packed[i].x == gtypes::SmallestThree48Quaternion(quaternions[i]).x && result[i] == packed[i].toQuaternion());
+	}
+	HTEST_ASSERT(resultBatch, "encode() and decode()");
+}
+
+HTEST_CASE(delta)
+{
+	gtypes::SmallestThree32Quaternion baselines[10];
+	gtypes::SmallestThree32Quaternion packed[10];
+	packed[0] = baselines[0];
+	packed[1] = _createPacked(514, 511, 511, 3);
+	packed[2] = _createPacked(511, 411, 511, 3);
+	packed[3] = _createPacked(511, 511, 511, 2);
+	packed[4] = _createPacked(511, 511, 526, 3);
+	packed[5] = _createPacked(495, 520, 500, 3);
+	packed[6] = _createPacked(527, 511, 511, 3);
+	packed[7] = _createPacked(511, 383, 638, 3);
+	packed[8] = _createPacked(511, 639, 511, 3);
+	packed[9] = baselines[9];
+	HTEST_ASSERT(gtypes::SmallestThree32Quaternion::getMaximumDeltaSize(10) == 43, "getMaximumDeltaSize()");
+	unsigned char buffer[43];
+	int size = gtypes::SmallestThree32Quaternion::encodeDelta(packed, baselines, 10, buffer);
+	// 3 control bytes and 0, 2, 3, 4, 2, 2, 3, 3, 4 and 0 payload bytes
+	HTEST_ASSERT(size == 26, "encodeDelta() size");
+	HTEST_ASSERT(buffer[0] == 0xE4 && buffer[1] == 0xA5 && buffer[2] == 0x03, "encodeDelta() tags");
+	gtypes::SmallestThree32Quaternion result[10];
+	HTEST_ASSERT(gtypes::SmallestThree32Quaternion::decodeDelta(buffer, size, baselines, result, 10) == size, "decodeDelta() size");
+	HTEST_ASSERT(memcmp(result, packed, sizeof(packed)) == 0, "decodeDelta()");
+	HTEST_ASSERT(gtypes::SmallestThree32Quaternion::decodeDelta(buffer, size - 1, baselines, result, 10) == -1, "decodeDelta() with missing payload");
+	HTEST_ASSERT(gtypes::SmallestThree32Quaternion::decodeDelta(buffer, 2, baselines, result, 10) == -1, "decodeDelta() with missing control bytes");
+	HTEST_ASSERT(gtypes::SmallestThree32Quaternion::decodeDelta(buffer, size, baselines, baselines, 10) == size && memcmp(baselines, packed, sizeof(packed)) == 0,
+		"decodeDelta() in place");
+	// small rotations of many Quaternions, the typical network update
+	gtypes::SmallestThree32Quaternion states[1000];
+	gtypes::SmallestThree32Quaternion updates[1000];
+	unsigned char data[4250];
+	unsigned long long seed = 5;
+	for (int i = 0; i < 1000; ++i)
+	{
+		gquat quaternion = _createQuaternion(seed);
+		states[i].set(quaternion);
+		gquat rotation = gquat::fromAxisAngle(1.0f, (float)(i % 3), 0.5f, (float)(i % 9) * 0.5f);
+		updates[i].set(i % 5 == 0 ? quaternion : (rotation * quaternion).normalized());
+	}
+	size = gtypes::SmallestThree32Quaternion::encodeDelta(updates, states, 1000, data);
+	HTEST_ASSERT(size < 3000 && size <= gtypes::SmallestThree32Quaternion::getMaximumDeltaSize(1000), "encodeDelta() compresses small changes");
+	HTEST_ASSERT(gtypes::SmallestThree32Quaternion::decodeDelta(data, size, states, states, 1000) == size && memcmp(states, updates, sizeof(updates)) == 0,
+		"decodeDelta() is lossless");
+}
+
+HTEST_SUITE_END
@@ -0,0 +1,117 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS PackedVector3
+#include <math.h>
+
+#include <htest/htest.h>
+
+#include "PackedVector3.h"
+#include "Vector3.h"
+
+#define E_TOLRANCE 0.0001f
+
+static gvec3f _createVector(int index)
+{
+	// evenly spread directions with varying lengths
+	float z = 1.0f - (index + 0.5f) * (2.0f / 1000.0f);
+	float radius = sqrtf(1.0f - z * z);
+	float angle = index * 2.39996323f;
+	return gvec3f(radius * cosf(angle), radius * sinf(angle), z) * (0.25f + (index % 7) * 0.125f);
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(size)
+{
+	HTEST_ASSERT(sizeof(gtypes::HalfVector3) == 6, "sizeof(HalfVector3)");
+	HTEST_ASSERT(sizeof(gtypes::Unorm16Vector3) == 6, "sizeof(Unorm16Vector3)");
+	HTEST_ASSERT(sizeof(gtypes::OctahedralVector3) == 4, "sizeof(OctahedralVector3)");
+	HTEST_ASSERT(sizeof(gtypes::Snorm10Vector3) == 4, "sizeof(Snorm10Vector3)");
+}
+
+HTEST_CASE(half)
+{
+	HTEST_ASSERT(gtypes::HalfVector3::fromFloat(1.0f) == 0x3C00, "fromFloat(1)");
+	HTEST_ASSERT(gtypes::HalfVector3::fromFloat(-2.0f) == 0xC000, "fromFloat(-2)");
+	HTEST_ASSERT(gtypes::HalfVector3::fromFloat(65504.0f) == 0x7BFF, "fromFloat(65504)");
+	HTEST_ASSERT(gtypes::HalfVector3::fromFloat(65520.0f) == 0x7C00, "fromFloat(65520) overflows to infinity");
+	HTEST_ASSERT(gtypes::HalfVector3::fromFloat(5.9604645e-08f) == 0x0001, "fromFloat() smallest subnormal");
+	HTEST_ASSERT(gtypes::HalfVector3::fromFloat(1.0f + 1.0f / 2048.0f) == 0x3C00, "fromFloat() rounds ties to even");
+	HTEST_ASSERT(gtypes::HalfVector3::fromFloat(1.0f + 3.0f / 2048.0f) == 0x3C02, "fromFloat() rounds ties to even");
+	HTEST_ASSERT((gtypes::HalfVector3::fromFloat(sqrtf(-1.0f)) & 0x7FFF) > 0x7C00, "fromFloat(NaN)");
+	HTEST_ASSERT(gtypes::HalfVector3::toFloat(0x3555) == 0.333251953125f, "toFloat()");
+	HTEST_ASSERT(gtypes::HalfVector3::toFloat(0x8001) == -5.9604645e-08f, "toFloat() subnormal");
+	HTEST_ASSERT(gtypes::HalfVector3::toFloat(0xFC00) == -HUGE_VALF, "toFloat() infinity");
+	bool resultRoundTrip = true;
+	for (unsigned int i = 0; i < 0x7C00; ++i)
+	{
+		resultRoundTrip &= (gtypes::HalfVector3::fromFloat(gtypes::HalfVector3::toFloat((unsigned short)i)) == i);
+		resultRoundTrip &= (gtypes::HalfVector3::fromFloat(gtypes::HalfVector3::toFloat((unsigned short)(i | 0x8000))) == (i | 0x8000));
+	}
+	HTEST_ASSERT(resultRoundTrip, "every finite half survives a round trip");
+	bool resultError = true;
+	for (int i = 0; i < 1000; ++i)
+	{
+		gvec3f vector = _createVector(i) * 100.0f;
+		gvec3f decoded = gtypes::HalfVector3(vector).toVector3();
+		resultError &= (fabsf(decoded.x - vector.x) <= fabsf(vector.x) / 2048.0f && fabsf(decoded.y - vector.y) <= fabsf(vector.y) / 2048.0f &&
+			fabsf(decoded.z - vector.z) <= fabsf(vector.z) / 2048.0f);
+	}
+	HTEST_ASSERT(resultError, "relative error");
+}
+
+HTEST_CASE(unorm16)
+{
+	gvec3f minimum(-10.0f, 0.0f, 5.0f);
+	gvec3f maximum(10.0f, 1.0f, 5.0f);
+	gvec3f tolerance = (maximum - minimum) / 131070.0f + gvec3f(2.0e-6f, 1.0e-7f, 0.0f);
+	bool result = true;
+	for (int i = 0; i < 1000; ++i)
+	{
+		gvec3f vector = _createVector(i);
+		vector.set(vector.x * 10.0f, vector.y * 0.5f + 0.5f, 5.0f);
+		gvec3f decoded = gtypes::Unorm16Vector3(vector, minimum, maximum).toVector3(minimum, maximum);
+		result &= (fabsf(decoded.x - vector.x) <= tolerance.x && fabsf(decoded.y - vector.y) <= tolerance.y && decoded.z == 5.0f);
+	}
+	HTEST_ASSERT(result, "error is within half a step");
+	gtypes::Unorm16Vector3 packed(gvec3f(-20.0f, 2.0f, 7.0f), minimum, maximum);
+	HTEST_ASSERT(packed.x == 0 && packed.y == 65535 && packed.z == 0, "components are clamped");
+	HTEST_ASSERT(packed.toVector3(minimum, maximum) == gvec3f(-10.0f, 1.0f, 5.0f), "bounds are exact");
+}
+
+HTEST_CASE(octahedral)
+{
+	float maximumAngle = 0.0f;
+	for (int i = 0; i < 1000; ++i)
+	{
+		gvec3f vector = _createVector(i);
+		gvec3f decoded = gtypes::OctahedralVector3(vector).toVector3();
+		HTEST_ASSERT(heqf(decoded.length(), 1.0f), "decoded vector is normalized");
+		// the cross product is more precise than the dot product for small angles
+		float angle = atan2f(decoded.cross(vector).length(), decoded.dot(vector));
+		maximumAngle = (angle > maximumAngle ? angle : maximumAngle);
+	}
+	HTEST_ASSERT(maximumAngle < 0.004f * 0.0174532925f, "angle error");
+	HTEST_ASSERT(gtypes::OctahedralVector3(gvec3f(0.0f, 0.0f, -3.0f)).toVector3() == gvec3f(0.0f, 0.0f, -1.0f), "negative z axis");
+	HTEST_ASSERT(gtypes::OctahedralVector3(gvec3f(0.0f, 2.0f, 0.0f)).toVector3() == gvec3f(0.0f, 1.0f, 0.0f), "y axis");
+	HTEST_ASSERT(gtypes::OctahedralVector3(gvec3f(0.0f, 0.0f, 0.0f)).toVector3() == gvec3f(0.0f, 0.0f, 1.0f), "zero vector");
+}
+
+HTEST_CASE(snorm10)
+{
+	bool result = true;
+	for (int i = 0; i < 1000; ++i)
+	{
+		gvec3f vector = _createVector(i);
+		gvec3f decoded = gtypes::Snorm10Vector3(vector).toVector3();
+		result &= (fabsf(decoded.x - vector.x) <= 1.0f / 1022.0f && fabsf(decoded.y - vector.y) <= 1.0f / 1022.0f && fabsf(decoded.z - vector.z) <= 1.0f / 1022.0f);
+	}
+	HTEST_ASSERT(result, "error is within half a step");
+	gtypes::Snorm10Vector3 packed(gvec3f(-1.0f, 3.0f, 0.0f), 3);
+	HTEST_ASSERT(packed.value == (0x201u | (0x1FFu << 10) | (3u << 30)), "layout");
+	HTEST_ASSERT(packed.getW() == 3, "getW()");
+	HTEST_ASSERT(packed.toVector3() == gvec3f(-1.0f, 1.0f, 0.0f), "components are clamped");
+	packed.value = 0x200;
+	HTEST_ASSERT(packed.toVector3().x == -1.0f, "-512 decodes as -1");
+}
+
+HTEST_SUITE_END
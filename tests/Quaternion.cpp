@@ -0,0 +1,349 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS Quaternion
+#include <math.h>
+
+#include <htest/htest.h>
+
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+#define E_TOLRANCE 0.0001f
+
+static bool quateqf(const gquat& q1, const gquat& q2)
+{
+	return (heqf(q1.x, q2.x) && heqf(q1.y, q2.y) && heqf(q1.z, q2.z) && heqf(q1.w, q2.w));
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(assignment)
+{
+	gquat q(1.0f, 2.0f, 3.0f, 4.0f);
+	HTEST_ASSERT(q.x == 1.0f && q.y == 2.0f && q.z == 3.0f && q.w == 4.0f, "constructor assignment");
+	q.set(gvec3f(2.0f, 3.0f, 4.0f), 5.0f);
+	HTEST_ASSERT(q.x == 2.0f && q.y == 3.0f && q.z == 4.0f && q.w == 5.0f, "set(gvec3f, float)");
+}
+
+HTEST_CASE(normalize)
+{
+	gquat q(0.0f, 3.0f, 0.0f, 4.0f);
+	HTEST_ASSERT(quateqf(q.normalized(), gquat(0.0f, 0.6f, 0.0f, 0.8f)), "normalized()");
+	HTEST_ASSERT(quateqf(q.normalizedFast(), gquat(0.0f, 0.6f, 0.0f, 0.8f)), "normalizedFast()");
+}
+
+HTEST_CASE(normalizeFastBatch)
+{
+	gquat quaternions[5];
+	for (int i = 0; i < 5; ++i)
+	{
+		quaternions[i].set(i + 1.0f, 2.0f, -1.0f * i, 0.5f);
+	}
+	gquat::normalizeFast(quaternions, 5);
+	for (int i = 0; i < 5; ++i)
+	{
+		HTEST_ASSERT(quateqf(quaternions[i], gquat(i + 1.0f, 2.0f, -1.0f * i, 0.5f).normalized()), "");
+	}
+}
+
+HTEST_CASE(multiply)
+{
+	gquat q1(1.0f, 2.0f, 3.0f, 4.0f);
+	gquat q2(-2.0f, 0.5f, 1.0f, 3.0f);
+	HTEST_ASSERT(quateqf(q1 * q2, gquat(-4.5f, 1.0f, 17.5f, 10.0f)), "operator*(gquat)");
+	q1 *= q2;
+	HTEST_ASSERT(quateqf(q1, gquat(-4.5f, 1.0f, 17.5f, 10.0f)), "operator*=(gquat)");
+	q1.set(1.0f, 2.0f, 3.0f, 4.0f);
+	HTEST_ASSERT(quateqf(q1 * q1.inversed(), gquat(0.0f, 0.0f, 0.0f, 1.0f)), "inversed()");
+	HTEST_ASSERT(heqf(q1.squaredLength(), 30.0f) && heqf(q1.dot(q2), 14.0f), "squaredLength(), dot()");
+	gquat a[3] = { q1, q2, q1 };
+	gquat b[3] = { q2, q1, q1.conjugated() };
+	gquat::multiply(a, b, a, 3);
+	HTEST_ASSERT(quateqf(a[0], q1 * q2) && quateqf(a[1], q2 * q1) && quateqf(a[2], gquat(0.0f, 0.0f, 0.0f, 30.0f)), "multiply()");
+}
+
+HTEST_CASE(rotate)
+{
+	gquat q = gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 90.0f);
+	gvec3f v = q.rotate(gvec3f(1.0f, 0.0f, 0.0f));
+	HTEST_ASSERT(heqf(v.x, 0.0f) && heqf(v.y, 1.0f) && heqf(v.z, 0.0f), "rotate() around Z");
+	q = gquat::fromAxisAngle(1.0f, -2.0f, 0.5f, 73.0f);
+	gvec3f vectors[5];
+	gquat quaternions[5];
+	for (int i = 0; i < 5; ++i)
+	{
+		vectors[i].set(i - 2.0f, 3.0f, i * 0.5f);
+		quaternions[i] = gquat::fromAxisAngle(0.5f, i + 1.0f, -1.0f, i * 40.0f);
+	}
+	bool result = true;
+	for (int i = 0; i < 5; ++i)
+	{
+		// compared with the full product q * v * q^-1
+		gquat sandwich = q * gquat(vectors[i], 0.0f) * q.conjugated();
+		v = q.rotate(vectors[i]);
+		result &= (heqf(v.x, sandwich.x) && heqf(v.y, sandwich.y) && heqf(v.z, sandwich.z));
+	}
+	HTEST_ASSERT(result, "rotate() equals q * v * q^-1");
+	gvec3f rotated[5];
+	gquat::rotate(q, vectors, rotated, 5);
+	result = true;
+	for (int i = 0; i < 5; ++i)
+	{
+		v = q.rotate(vectors[i]);
+		result &= (heqf(rotated[i].x, v.x) && heqf(rotated[i].y, v.y) && heqf(rotated[i].z, v.z));
+	}
+	HTEST_ASSERT(result, "rotate(gquat, ...)");
+	gvec3f expected[5];
+	for (int i = 0; i < 5; ++i)
+	{
+		expected[i] = quaternions[i].rotate(vectors[i]);
+	}
+	gquat::rotate(quaternions, vectors, vectors, 5);
+	result = true;
+	for (int i = 0; i < 5; ++i)
+	{
+		result &= (heqf(vectors[i].x, expected[i].x) && heqf(vectors[i].y, expected[i].y) && heqf(vectors[i].z, expected[i].z));
+	}
+	HTEST_ASSERT(result, "rotate(const gquat*, ...) in place");
+}
+
+HTEST_CASE(slerp)
+{
+	gquat a = gquat::fromAxisAngle(0.3f, 1.0f, -0.2f, 10.0f);
+	bool result = true;
+	float maximumError = 0.0f;
+	for (int angle = 0; angle <= 180; angle += 5)
+	{
+		gquat b = a * gquat::fromAxisAngle(-1.0f, 0.5f, 2.0f, (float)angle);
+		gquat shortest = (a.dot(b) < 0.0f ? -b : b);
+		double theta = acos((double)a.dot(shortest) < 1.0 ? (double)a.dot(shortest) : 1.0);
+		for (int i = 0; i <= 10; ++i)
+		{
+			// compared with the exact formula in double precision
+			float factor = i * 0.1f;
+			double weightA = (theta > 0.0 ? sin((1.0 - factor) * theta) / sin(theta) : 1.0 - factor);
+			double weightB = (theta > 0.0 ? sin(factor * theta) / sin(theta) : factor);
+			gquat q = gquat::slerp(a, b, factor);
+			float errors[4] = { fabsf(q.x - (float)(a.x * weightA + shortest.x * weightB)), fabsf(q.y - (float)(a.y * weightA + shortest.y * weightB)),
+				fabsf(q.z - (float)(a.z * weightA + shortest.z * weightB)), fabsf(q.w - (float)(a.w * weightA + shortest.w * weightB)) };
+			for (int j = 0; j < 4; ++j)
+			{
+				maximumError = (errors[j] > maximumError ? errors[j] : maximumError);
+			}
+			result &= quateqf(gquat::slerp(a, -b, factor), q);
+		}
+	}
+	HTEST_ASSERT(maximumError < 2e-6f, "slerp() accuracy");
+	HTEST_ASSERT(result, "slerp() takes the shorter arc");
+	gquat b = gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 90.0f);
+	gquat identity(0.0f, 0.0f, 0.0f, 1.0f);
+	HTEST_ASSERT(quateqf(gquat::slerp(identity, b, 0.5f), gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 45.0f)), "slerp() halfway");
+	HTEST_ASSERT(quateqf(gquat::slerp(identity, b, 0.0f), identity) && quateqf(gquat::slerp(identity, b, 1.0f), b), "slerp() end points");
+	// a dot-product slightly above 1 must not produce NaNs
+	gquat c(0.0f, 0.0f, 0.0f, 1.0000001f);
+	gquat q = gquat::slerp(c, c, 0.3f);
+	HTEST_ASSERT(q.w == q.w && heqf(q.w, 1.0f), "slerp() of equal Quaternions");
+	q = gquat::nlerp(identity, b, 0.5f);
+	HTEST_ASSERT(quateqf(q, gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 45.0f)), "nlerp() halfway");
+	HTEST_ASSERT(quateqf(gquat::nlerp(identity, -b, 0.5f), q), "nlerp() takes the shorter arc");
+	gquat poseA[5];
+	gquat poseB[5];
+	gquat blended[5];
+	float weights[5] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
+	for (int i = 0; i < 5; ++i)
+	{
+		poseA[i] = gquat::fromAxisAngle(1.0f, (float)i, 0.0f, i * 30.0f);
+		poseB[i] = gquat::fromAxisAngle(0.0f, 1.0f, (float)i, 170.0f - i * 20.0f);
+	}
+	gquat::slerp(poseA, poseB, weights, blended, 5);
+	result = true;
+	for (int i = 0; i < 5; ++i)
+	{
+		result &= quateqf(blended[i], gquat::slerp(poseA[i], poseB[i], weights[i]));
+	}
+	HTEST_ASSERT(result, "slerp(const gquat*, ...)");
+	gquat::nlerp(poseA, poseB, weights, poseA, 5);
+	result = true;
+	for (int i = 0; i < 5; ++i)
+	{
+		result &= quateqf(poseA[i], gquat::nlerp(gquat::fromAxisAngle(1.0f, (float)i, 0.0f, i * 30.0f), poseB[i], weights[i]));
+	}
+	HTEST_ASSERT(result, "nlerp(const gquat*, ...) in place");
+}
+
+HTEST_CASE(eulerAngles)
+{
+	bool resultClosedForm = true;
+	bool resultInverse = true;
+	for (int i = 0; i < 7; ++i)
+	{
+		for (int j = 0; j < 7; ++j)
+		{
+			for (int k = 0; k < 7; ++k)
+			{
+				float yaw = i * 0.9f - 2.7f;
+				float pitch = j * 0.5f - 1.5f;
+				float roll = k * 1.0f - 3.0f;
+				// the rotations -yaw around Y, -pitch around X and -roll around Z
+				gquat expected = gquat(0.0f, -sinf(yaw * 0.5f), 0.0f, cosf(yaw * 0.5f)) * gquat(-sinf(pitch * 0.5f), 0.0f, 0.0f, cosf(pitch * 0.5f)) *
+					gquat(0.0f, 0.0f, -sinf(roll * 0.5f), cosf(roll * 0.5f));
+				gquat q = gquat::fromEulerAngles(yaw, pitch, roll);
+				resultClosedForm &= quateqf(q, expected);
+				gvec3f angles = q.toEulerAngles();
+				resultInverse &= (heqf(angles.x, yaw) && heqf(angles.y, pitch) && heqf(angles.z, roll));
+			}
+		}
+	}
+	HTEST_ASSERT(resultClosedForm, "fromEulerAngles()");
+	HTEST_ASSERT(resultInverse, "toEulerAngles()");
+	// yaw and roll rotate around the same axis, the roll is moved into the yaw
+	gquat q = gquat::fromEulerAngles(0.5f, 1.57079633f, 0.3f);
+	gvec3f angles = q.toEulerAngles();
+	HTEST_ASSERT(heqf(angles.y, 1.57079633f) && angles.z == 0.0f && heqf(fabsf(gquat::fromEulerAngles(angles.x, angles.y, angles.z).dot(q)), 1.0f),
+		"toEulerAngles() at pitch pi / 2");
+	q = gquat::fromEulerAngles(-1.2f, -1.57079633f, 0.4f);
+	angles = q.toEulerAngles();
+	HTEST_ASSERT(heqf(angles.y, -1.57079633f) && angles.z == 0.0f && heqf(fabsf(gquat::fromEulerAngles(angles.x, angles.y, angles.z).dot(q)), 1.0f),
+		"toEulerAngles() at pitch -pi / 2");
+	gvec3f eulerAngles[9];
+	gquat quaternions[9];
+	gvec3f converted[9];
+	for (int i = 0; i < 9; ++i)
+	{
+		eulerAngles[i].set(i * 0.7f - 2.8f, i * 0.3f - 1.2f, 2.5f - i * 0.6f);
+	}
+	eulerAngles[8].set(40.0f, -100.0f, 250.0f);
+	gquat::fromEulerAngles(eulerAngles, quaternions, 9);
+	gquat::toEulerAngles(quaternions, converted, 9);
+	bool resultBatch = true;
+	for (int i = 0; i < 9; ++i)
+	{
+		resultBatch &= quateqf(quaternions[i], gquat::fromEulerAngles(eulerAngles[i].x, eulerAngles[i].y, eulerAngles[i].z));
+		gvec3f expected = quaternions[i].toEulerAngles();
+		resultBatch &= (heqf(converted[i].x, expected.x) && heqf(converted[i].y, expected.y) && heqf(converted[i].z, expected.z));
+	}
+	HTEST_ASSERT(resultBatch, "fromEulerAngles(const gvec3f*, ...) and toEulerAngles(const gquat*, ...)");
+}
+
+HTEST_CASE(fromMatrix)
+{
+	gquat rotations[40];
+	gmat3 matrices3[40];
+	gmat4 matrices4[40];
+	for (int i = 0; i < 36; ++i)
+	{
+		rotations[i] = gquat::fromAxisAngle(gvec3f(i * 0.3f - 5.0f, 1.0f - i * 0.1f, (i % 7) - 3.0f), i * 10.0f);
+	}
+	// half turns, where w is 0 and one of x, y and z is the largest component
+	rotations[36] = gquat::fromAxisAngle(1.0f, 0.0f, 0.0f, 180.0f);
+	rotations[37] = gquat::fromAxisAngle(0.0f, 1.0f, 0.0f, 180.0f);
+	rotations[38] = gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 180.0f);
+	rotations[39] = gquat::fromAxisAngle(0.8f, -1.0f, 0.5f, 180.0f);
+	bool resultMatrix3 = true;
+	bool resultMatrix4 = true;
+	bool resultSign = true;
+	for (int i = 0; i < 40; ++i)
+	{
+		// q and -q are the same rotation, the result has the largest component positive
+		gquat q = gquat::fromMatrix(rotations[i].mat3());
+		gquat expected = (q.dot(rotations[i]) < 0.0f ? -rotations[i] : rotations[i]);
+		resultMatrix3 &= quateqf(q, expected);
+		resultMatrix4 &= quateqf(gquat::fromMatrix(rotations[i].mat4(gvec3f(i * 2.0f, -1.0f, 3.0f))), q);
+		float largest = (fabsf(q.x) > fabsf(q.y) ? q.x : q.y);
+		largest = (fabsf(q.z) > fabsf(largest) ? q.z : largest);
+		largest = (fabsf(q.w) > fabsf(largest) ? q.w : largest);
+		resultSign &= (largest > 0.0f);
+		matrices3[i] = rotations[i].mat3();
+		matrices4[i] = rotations[i].mat4();
+	}
+	HTEST_ASSERT(resultMatrix3, "fromMatrix(const gmat3&)");
+	HTEST_ASSERT(resultMatrix4, "fromMatrix(const gmat4&) ignores the translation");
+	HTEST_ASSERT(resultSign, "fromMatrix() has the largest component positive");
+	gquat drifted = gquat::fromMatrix(rotations[12].mat3() * 1.01f);
+	HTEST_ASSERT(heqf(drifted.length(), 1.0f) && heqf(fabsf(drifted.dot(rotations[12])), 1.0f), "fromMatrix() normalizes the result");
+	gquat result3[40];
+	gquat result4[40];
+	gquat::fromMatrix(matrices3, result3, 40);
+	gquat::fromMatrix(matrices4, result4, 40);
+	bool resultBatch = true;
+	for (int i = 0; i < 40; ++i)
+	{
+		resultBatch &= (quateqf(result3[i], gquat::fromMatrix(matrices3[i])) && quateqf(result4[i], result3[i]));
+	}
+	HTEST_ASSERT(resultBatch, "fromMatrix(const gmat3*, ...) and fromMatrix(const gmat4*, ...)");
+}
+
+HTEST_CASE(logExp)
+{
+	gquat q = gquat::fromAxisAngle(0.0f, 0.6f, 0.8f, 90.0f);
+	gquat logarithm = q.log();
+	HTEST_ASSERT(quateqf(logarithm, gquat(0.0f, 0.6f * 0.78539816f, 0.8f * 0.78539816f, 0.0f)) || quateqf(logarithm, gquat(0.0f, -0.6f * 0.78539816f, -0.8f * 0.78539816f, 0.0f)),
+		"log() is the axis scaled by half the angle");
+	HTEST_ASSERT(quateqf(logarithm.exp(), q), "exp() is the inverse of log()");
+	HTEST_ASSERT(quateqf(gquat(0.0f, 0.0f, 0.0f, 1.0f).log(), gquat(0.0f, 0.0f, 0.0f, 0.0f)) && quateqf(gquat(0.0f, 0.0f, 0.0f, 0.0f).exp(), gquat(0.0f, 0.0f, 0.0f, 1.0f)),
+		"log() of the identity and exp() of 0");
+	gquat scaled(1.0f, -2.0f, 0.5f, 3.0f);
+	HTEST_ASSERT(quateqf(scaled.log().exp(), scaled) && heqf(scaled.log().w, logf(scaled.length())), "log() and exp() of non-unit Quaternions");
+	bool resultHalfTurn = true;
+	for (int i = 0; i < 36; ++i)
+	{
+		gquat rotation = gquat::fromAxisAngle(gvec3f(1.0f, i * 0.2f - 3.0f, 0.5f), i * 10.0f - 175.0f);
+		resultHalfTurn &= quateqf(rotation.log().exp(), rotation);
+	}
+	HTEST_ASSERT(resultHalfTurn, "exp(log()) for all angles");
+	gquat a = gquat::fromAxisAngle(1.0f, 0.0f, 0.0f, 30.0f);
+	gquat b = gquat::fromAxisAngle(0.0f, 1.0f, 0.0f, 70.0f);
+	HTEST_ASSERT(quateqf(gquat::squad(a, b, a, b, 0.3f), gquat::slerp(a, b, 0.3f)), "squad() with the keys as control points is slerp()");
+	HTEST_ASSERT(quateqf(gquat::squad(a, b, gquat::squadControl(a, a, b), gquat::squadControl(a, b, b), 1.0f), b), "squad() ends at b");
+	gquat control = gquat::squadControl(-a, a * 1.0f, b);
+	HTEST_ASSERT(quateqf(control, gquat::squadControl(a, a, -b)), "squadControl() does not depend on the signs of the neighbors");
+}
+
+HTEST_CASE(integrate)
+{
+	// 90 degrees per second around the axis for 1 second
+	gvec3f axis = gvec3f(1.0f, 2.0f, -2.0f).normalized();
+	gvec3f angularVelocity = axis * 1.57079633f;
+	gquat start = gquat::fromAxisAngle(0.0f, 1.0f, 0.0f, 30.0f);
+	gquat expected = gquat::fromAxisAngle(axis, 90.0f) * start;
+	gquat exponential = start;
+	exponential.integrate(angularVelocity, 1.0f, gtypes::QuaternionIntegrationExponential);
+	HTEST_ASSERT(quateqf(exponential, expected), "integrate() with the exponential map is exact for large steps");
+	gquat firstOrder = start;
+	exponential = start;
+	for (int i = 0; i < 1000; ++i)
+	{
+		firstOrder.integrate(angularVelocity, 0.001f);
+		exponential.integrate(angularVelocity, 0.001f, gtypes::QuaternionIntegrationExponential);
+	}
+	HTEST_ASSERT(fabsf(firstOrder.dot(expected)) > 0.99999f && heqf(firstOrder.length(), 1.0f), "integrate() with small first-order steps");
+	HTEST_ASSERT(fabsf(exponential.dot(expected)) > 0.99999f && heqf(exponential.length(), 1.0f), "integrate() with small exponential steps");
+	gquat still = start;
+	still.integrate(gvec3f(), 0.5f, gtypes::QuaternionIntegrationExponential);
+	HTEST_ASSERT(quateqf(still, start), "integrate() without angular velocity");
+	gquat quaternions[19];
+	gquat exponentials[19];
+	gvec3f angularVelocities[19];
+	for (int i = 0; i < 19; ++i)
+	{
+		quaternions[i] = gquat::fromAxisAngle(gvec3f(1.0f, i * 0.2f, -0.3f), i * 19.0f);
+		exponentials[i] = quaternions[i];
+		angularVelocities[i].set(i * 0.5f - 4.0f, (i % 4) * 1.5f, 2.0f - i * 0.1f);
+	}
+	angularVelocities[3] = gvec3f();
+	gquat::integrate(quaternions, angularVelocities, 0.1f, 19);
+	gquat::integrate(exponentials, angularVelocities, 0.1f, 19, gtypes::QuaternionIntegrationExponential);
+	bool resultBatch = true;
+	for (int i = 0; i < 19; ++i)
+	{
+		gquat q = gquat::fromAxisAngle(gvec3f(1.0f, i * 0.2f, -0.3f), i * 19.0f);
+		gquat e = q;
+		q.integrate(angularVelocities[i], 0.1f);
+		e.integrate(angularVelocities[i], 0.1f, gtypes::QuaternionIntegrationExponential);
+		resultBatch &= (quateqf(quaternions[i], q) && quateqf(exponentials[i], e));
+	}
+	HTEST_ASSERT(resultBatch, "integrate(gquat*, ...)");
+}
+
+HTEST_SUITE_END
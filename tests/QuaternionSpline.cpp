@@ -0,0 +1,153 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS QuaternionSpline
+#include <math.h>
+
+#include <htest/htest.h>
+
+#include "Quaternion.h"
+#include "QuaternionSpline.h"
+#include "Vector3.h"
+
+#define E_TOLRANCE 0.0001f
+
+// q and -q are the same rotation
+static bool _equals(const gquat& a, const gquat& b)
+{
+	return heqf(fabsf(a.dot(b)), 1.0f);
+}
+
+// difference between the rotations from a to b and from b to c, 0 if the angular velocity is the same on both sides of b
+static float _velocityChange(const gquat& a, const gquat& b, const gquat& c)
+{
+	gquat before = a.conjugated() * b;
+	gquat after = b.conjugated() * c;
+	before = (before.w < 0.0f ? -before : before);
+	after = (after.w < 0.0f ? -after : after);
+	return (before.log() - after.log()).length();
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(keys)
+{
+	gquatspline empty;
+	HTEST_ASSERT(empty.calcRotation(0.5) == gquat(0.0f, 0.0f, 0.0f, 1.0f) && empty.getLength() == 0.0, "calcRotation() without keys is the identity");
+	gquat rotation = gquat::fromAxisAngle(1.0f, 2.0f, 0.0f, 40.0f);
+	gquatspline single(&rotation, 1, false);
+	HTEST_ASSERT(single.calcRotation(0.3) == rotation, "calcRotation() with one key");
+	// 60 degrees between all neighbors, so the keys split the parameter evenly
+	gquat keys[4];
+	keys[0] = gquat(0.0f, 0.0f, 0.0f, 1.0f);
+	keys[1] = gquat::fromAxisAngle(0.0f, 1.0f, 0.0f, 60.0f);
+	keys[2] = keys[1] * gquat::fromAxisAngle(1.0f, 0.0f, 0.0f, 60.0f);
+	keys[3] = -(keys[2] * gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 60.0f));
+	gquatspline spline(keys, 4, false);
+	HTEST_ASSERT(!spline.isClosed() && spline.getPoints().size() == 4 && spline.getControls().size() == 4, "getPoints() and getControls()");
+	HTEST_ASSERT(heqf((float)spline.getLength(), 3.14159265f), "getLength() is the total angle");
+	HTEST_ASSERT(spline.getPoints()[3] == keys[3] * -1.0f, "keys are moved to the hemisphere of their neighbor");
+	bool resultKeys = true;
+	for (int i = 0; i < 4; ++i)
+	{
+		resultKeys &= _equals(spline.calcRotation(i / 3.0), keys[i]);
+	}
+	HTEST_ASSERT(resultKeys, "calcRotation() passes through the keys");
+	HTEST_ASSERT(_equals(spline.calcRotation(-1.0), keys[0]) && _equals(spline.calcRotation(2.5), keys[3]), "calcRotation() clamps open splines");
+	bool resultUnit = true;
+	for (double t = 0.0; t <= 1.0; t += 0.01)
+	{
+		resultUnit &= heqf(spline.calcRotation(t).length(), 1.0f);
+	}
+	HTEST_ASSERT(resultUnit, "calcRotation() has unit length");
+}
+
+HTEST_CASE(smoothness)
+{
+	gquat keys[4];
+	keys[0] = gquat(0.0f, 0.0f, 0.0f, 1.0f);
+	keys[1] = gquat::fromAxisAngle(0.0f, 1.0f, 0.0f, 60.0f);
+	keys[2] = keys[1] * gquat::fromAxisAngle(1.0f, 0.0f, 0.0f, 60.0f);
+	keys[3] = keys[2] * gquat::fromAxisAngle(0.0f, 0.0f, 1.0f, 60.0f);
+	gquatspline spline(keys, 4, false);
+	double step = 0.01;
+	float squadChange = _velocityChange(spline.calcRotation(1.0 / 3.0 - step), spline.calcRotation(1.0 / 3.0), spline.calcRotation(1.0 / 3.0 + step));
+	float slerpChange = _velocityChange(gquat::slerp(keys[0], keys[1], 0.97f), keys[1], gquat::slerp(keys[1], keys[2], 0.03f));
+	HTEST_ASSERT(squadChange < slerpChange * 0.1f, "the angular velocity is continuous at the keys unlike chained slerp()");
+	gquatspline closed(keys, 4, true);
+	HTEST_ASSERT(closed.isClosed() && closed.getPoints().size() == 5, "closed splines repeat the first key");
+	HTEST_ASSERT(_equals(closed.calcRotation(0.0), keys[0]) && _equals(closed.calcRotation(1.0), keys[0]), "closed splines start and end at the first key");
+	HTEST_ASSERT(closed.calcRotation(1.25) == closed.calcRotation(0.25) && closed.calcRotation(-0.75) == closed.calcRotation(0.25), "closed splines wrap around");
+	step = 0.002;
+	float loopChange = _velocityChange(closed.calcRotation(1.0 - step), closed.calcRotation(0.0), closed.calcRotation(step));
+	float firstChange = _velocityChange(closed.calcRotation(0.5 - step), closed.calcRotation(0.5), closed.calcRotation(0.5 + step));
+	HTEST_ASSERT(loopChange < 0.01f && firstChange < 0.01f, "closed splines are smooth at the first key");
+}
+
+HTEST_CASE(largeSteps)
+{
+	// keys up to 180 degrees apart are valid, the curve must not jump when the squad() terms end up in different hemispheres
+	unsigned int seed = 9;
+	float angles[2] = { 120.0f, 150.0f };
+	float maxChange = 0.0f;
+	gquat keys[6];
+	for (int a = 0; a < 2; ++a)
+	{
+		for (int s = 0; s < 200; ++s)
+		{
+			keys[0] = gquat(0.0f, 0.0f, 0.0f, 1.0f);
+			for (int i = 1; i < 6; ++i)
+			{
+				float axis[3];
+				for (int j = 0; j < 3; ++j)
+				{
+					seed = seed * 1103515245 + 12345;
+					axis[j] = (float)((seed >> 8) % 2001) / 1000.0f - 1.0f;
+				}
+				keys[i] = keys[i - 1] * gquat::fromAxisAngle(axis[0], axis[1], axis[2] + 0.01f, angles[a]);
+			}
+			gquatspline spline(keys, 6, false);
+			gquat previous = spline.calcRotation(0.0);
+			for (int i = 1; i <= 2000; ++i)
+			{
+				gquat current = spline.calcRotation(i / 2000.0);
+				float change = 1.0f - fabsf(previous.dot(current));
+				maxChange = (change > maxChange ? change : maxChange);
+				previous = current;
+			}
+		}
+	}
+	// 1 - |dot| of a jump to a nearly orthogonal rotation is close to 1
+	HTEST_ASSERT(maxChange < 0.01f, "calcRotation() is continuous with keys 120 and 150 degrees apart");
+}
+
+HTEST_CASE(cache)
+{
+	gquat keys[12];
+	for (int i = 0; i < 12; ++i)
+	{
+		keys[i] = gquat::fromAxisAngle(gvec3f(1.0f, i * 0.3f, (i % 3) - 1.0f), i * 25.0f - 100.0f);
+	}
+	gquatspline spline(keys, 12, false);
+	bool resultPlayback = true;
+	for (double t = 0.0; t <= 1.0; t += 0.003)
+	{
+		resultPlayback &= (spline.calcRotation(t) == gquatspline(keys, 12, false).calcRotation(t));
+	}
+	for (double t = 1.0; t >= 0.0; t -= 0.007)
+	{
+		resultPlayback &= (spline.calcRotation(t) == gquatspline(keys, 12, false).calcRotation(t));
+	}
+	HTEST_ASSERT(resultPlayback, "calcRotation() during playback in both directions");
+	bool resultJump = true;
+	for (int i = 0; i < 100; ++i)
+	{
+		double t = ((i * 37) % 101) / 100.0;
+		resultJump &= (spline.calcRotation(t) == gquatspline(keys, 12, false).calcRotation(t));
+	}
+	HTEST_ASSERT(resultJump, "calcRotation() after jumps");
+	// all keys are the same rotation
+	gquat same[3] = { keys[4], -keys[4], keys[4] };
+	gquatspline still(same, 3, false);
+	HTEST_ASSERT(still.getLength() == 0.0 && _equals(still.calcRotation(0.4), keys[4]), "calcRotation() without rotation");
+}
+
+HTEST_SUITE_END
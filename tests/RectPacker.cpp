@@ -0,0 +1,164 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS RectPacker
+#include <algorithm>
+#include <vector>
+
+#include <htest/htest.h>
+
+#include "Rectangle.h"
+#include "RectPacker.h"
+#include "Vector2.h"
+
+#include "RectangleFixture.h"
+
+// glyph-like sizes, mostly a bit taller than wide
+static std::vector<gvec2i> _createSizes(int count, unsigned int seed)
+{
+	std::vector<gvec2i> result;
+	for (int i = 0; i < count; ++i)
+	{
+		int width = 4 + (int)(_random(seed) % 24);
+		result.push_back(gvec2i(width, width + (int)(_random(seed) % 12) - 2));
+	}
+	return result;
+}
+
+struct _LeftOrder
+{
+	const std::vector<grecti>* rectangles;
+
+	inline bool operator()(int a, int b) const
+	{
+		return ((*this->rectangles)[a].x < (*this->rectangles)[b].x);
+	}
+};
+
+// every placed Rectangle has its size or the rotated size, stays inside the area and overlaps no other one
+static bool _checkPacking(const std::vector<gvec2i>& sizes, const std::vector<grecti>& results, int width, int height, bool rotationAllowed)
+{
+	std::vector<int> placed;
+	for (int i = 0; i < (int)results.size(); ++i)
+	{
+		if (results[i].w == 0)
+		{
+			continue;
+		}
+		bool sizeValid = (results[i].getSize() == sizes[i] || (rotationAllowed && results[i].getSize() == gvec2i(sizes[i].y, sizes[i].x)));
+		if (!sizeValid || !grecti(0, 0, width, height).contains(results[i]))
+		{
+			return false;
+		}
+		placed.push_back(i);
+	}
+	_LeftOrder leftOrder;
+	leftOrder.rectangles = &results;
+	std::sort(placed.begin(), placed.end(), leftOrder);
+	for (int i = 0; i < (int)placed.size(); ++i)
+	{
+		const grecti& rectangle = results[placed[i]];
+		for (int j = i + 1; j < (int)placed.size() && results[placed[j]].x < rectangle.x + rectangle.w; ++j)
+		{
+			if (rectangle.intersects(results[placed[j]]))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static long long _sumArea(const std::vector<grecti>& rectangles)
+{
+	long long result = 0;
+	for (int i = 0; i < (int)rectangles.size(); ++i)
+	{
+		result += (long long)rectangles[i].w * rectangles[i].h;
+	}
+	return result;
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(exactFit)
+{
+	gtypes::RectPacker::Method methods[3] = { gtypes::RectPacker::MethodMaxRectsBestShortSideFit, gtypes::RectPacker::MethodMaxRectsContactPoint,
+		gtypes::RectPacker::MethodSkyline };
+	for (int m = 0; m < 3; ++m)
+	{
+		gtypes::RectPacker packer(100, 100, methods[m]);
+		grecti result;
+		bool resultInsert = true;
+		for (int i = 0; i < 4; ++i)
+		{
+			resultInsert &= packer.insert(50, 50, result);
+		}
+		HTEST_ASSERT(resultInsert && packer.getCount() == 4 && packer.getOccupancy() == 1.0f, "insert() fills the area");
+		HTEST_ASSERT(!packer.insert(1, 1, result) && result == grecti(), "insert() into a full area");
+		HTEST_ASSERT(packer.getUsedArea() == 10000 && packer.getUsedBounds() == grecti(0, 0, 100, 100), "getUsedArea() and getUsedBounds()");
+	}
+	gtypes::RectPacker packer(64, 64);
+	grecti result;
+	HTEST_ASSERT(!packer.insert(0, 10, result) && !packer.insert(65, 1, result) && packer.getCount() == 0, "insert() with invalid sizes");
+	HTEST_ASSERT(packer.insert(64, 1, result) && result == grecti(0, 0, 64, 1), "insert() along the edge");
+	packer.reset(32, 32, gtypes::RectPacker::MethodSkyline);
+	HTEST_ASSERT(packer.getCount() == 0 && packer.getWidth() == 32 && packer.getMethod() == gtypes::RectPacker::MethodSkyline, "reset()");
+}
+
+HTEST_CASE(rotation)
+{
+	gtypes::RectPacker::Method methods[3] = { gtypes::RectPacker::MethodMaxRectsBestShortSideFit, gtypes::RectPacker::MethodMaxRectsContactPoint,
+		gtypes::RectPacker::MethodSkyline };
+	for (int m = 0; m < 3; ++m)
+	{
+		gtypes::RectPacker packer(100, 20, methods[m]);
+		grecti result;
+		HTEST_ASSERT(!packer.insert(10, 100, result), "insert() without rotation");
+		packer.setRotationAllowed(true);
+		HTEST_ASSERT(packer.insert(10, 100, result) && result.w == 100 && result.h == 10, "insert() with rotation");
+		HTEST_ASSERT(packer.insert(10, 100, result) && result == grecti(0, 10, 100, 10) && packer.getOccupancy() == 1.0f, "insert() with rotation fills the area");
+	}
+}
+
+HTEST_CASE(incremental)
+{
+	std::vector<gvec2i> sizes = _createSizes(3000, 42);
+	gtypes::RectPacker packer(512, 512, gtypes::RectPacker::MethodMaxRectsBestShortSideFit, true);
+	std::vector<grecti> results(sizes.size());
+	int placed = 0;
+	for (int i = 0; i < (int)sizes.size(); ++i)
+	{
+		if (packer.insert(sizes[i].x, sizes[i].y, results[i]))
+		{
+			++placed;
+		}
+	}
+	HTEST_ASSERT(placed > 0 && placed < 3000 && packer.getCount() == placed, "insert() until the area is full");
+	HTEST_ASSERT(_checkPacking(sizes, results, 512, 512, true), "insert() without overlaps");
+	HTEST_ASSERT(packer.getUsedArea() == _sumArea(results) && heqf(packer.getOccupancy(), (float)((double)_sumArea(results) / (512 * 512))), "getOccupancy()");
+	HTEST_ASSERT(packer.getOccupancy() > 0.9f, "getOccupancy() of a glyph cache");
+}
+
+HTEST_CASE(batch)
+{
+	// 10k glyphs fill about 93% of the area
+	std::vector<gvec2i> sizes = _createSizes(10000, 7);
+	std::vector<grecti> results;
+	gtypes::RectPacker maxRects(2048, 1792, gtypes::RectPacker::MethodMaxRectsBestShortSideFit, true);
+	int placed = maxRects.insert(sizes, results);
+	HTEST_ASSERT(placed == 10000 && maxRects.getCount() == 10000, "insert() of 10k Rectangles with MaxRects");
+	HTEST_ASSERT(_checkPacking(sizes, results, 2048, 1792, true), "insert() of 10k Rectangles with MaxRects without overlaps");
+	HTEST_ASSERT(maxRects.getOccupancy() > 0.9f, "getOccupancy() with MaxRects");
+	gtypes::RectPacker skyline(2048, 1792, gtypes::RectPacker::MethodSkyline, true);
+	placed = skyline.insert(sizes, results);
+	HTEST_ASSERT(placed == 10000, "insert() of 10k Rectangles with Skyline");
+	HTEST_ASSERT(_checkPacking(sizes, results, 2048, 1792, true), "insert() of 10k Rectangles with Skyline without overlaps");
+	HTEST_ASSERT(skyline.getUsedBoundsOccupancy() > 0.9f, "getUsedBoundsOccupancy() with Skyline");
+	// the contact search is more expensive, fewer Rectangles keep the test fast
+	sizes.resize(1500);
+	gtypes::RectPacker contact(512, 512, gtypes::RectPacker::MethodMaxRectsContactPoint, true);
+	placed = contact.insert(sizes, results);
+	HTEST_ASSERT(placed > 0 && _checkPacking(sizes, results, 512, 512, true), "insert() with MaxRects and contact points");
+	HTEST_ASSERT(contact.getOccupancy() > 0.95f, "getOccupancy() with MaxRects and contact points");
+}
+
+HTEST_SUITE_END
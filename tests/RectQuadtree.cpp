@@ -0,0 +1,232 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS RectQuadtree
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <htest/htest.h>
+
+#include "RectQuadtree.h"
+#include "Rectangle.h"
+#include "Vector2.h"
+
+#include "RectangleFixture.h"
+
+static grectf _createRectangle(unsigned int& seed)
+{
+	float x = (float)(_random(seed) % 11000) * 0.1f - 50.0f;
+	float y = (float)(_random(seed) % 11000) * 0.1f - 50.0f;
+	// mostly small with a few large ones that end up in the upper levels
+	float scale = (_random(seed) % 10 == 0 ? 4.0f : 0.2f);
+	float w = (float)(_random(seed) % 100) * scale;
+	float h = (float)(_random(seed) % 100) * scale;
+	return grectf(x, y, w, h);
+}
+
+static double _squaredDistance(cgrectf rectangle, cgvec2f point)
+{
+	double dx = std::max(std::max((double)rectangle.x - point.x, (double)point.x - rectangle.x - rectangle.w), 0.0);
+	double dy = std::max(std::max((double)rectangle.y - point.y, (double)point.y - rectangle.y - rectangle.h), 0.0);
+	return (dx * dx + dy * dy);
+}
+
+static bool _checkQueries(const gquadtreef& tree, const std::vector<grectf>& rectangles, const std::vector<bool>& valid, unsigned int& seed)
+{
+	std::vector<int> result;
+	std::vector<int> expected;
+	for (int i = 0; i < 50; ++i)
+	{
+		grectf query = _createRectangle(seed);
+		tree.findIntersecting(query, result);
+		if (!_isSameResult(result, _findIntersecting(rectangles, query, &valid)))
+		{
+			return false;
+		}
+		gvec2f point(query.x, query.y);
+		tree.findAt(point, result);
+		expected.clear();
+		for (int j = 0; j < (int)rectangles.size(); ++j)
+		{
+			if (valid[j] && rectangles[j].isPointInside(point))
+			{
+				expected.push_back(j);
+			}
+		}
+		if (!_isSameResult(result, expected))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(insertRemove)
+{
+	gquadtreef tree(grectf(0.0f, 0.0f, 1000.0f, 1000.0f), 6);
+	std::vector<grectf> rectangles;
+	std::vector<bool> valid;
+	unsigned int seed = 12345;
+	for (int i = 0; i < 1000; ++i)
+	{
+		rectangles.push_back(_createRectangle(seed));
+		valid.push_back(true);
+		HTEST_ASSERT(tree.insert(rectangles.back()) == i, "insert() returns ascending ids");
+	}
+	HTEST_ASSERT(tree.getCount() == 1000 && tree.getNodeCount() > 1, "getCount() and getNodeCount()");
+	HTEST_ASSERT(_checkQueries(tree, rectangles, valid, seed), "findIntersecting() and findAt() after insert()");
+	for (int i = 0; i < 1000; i += 3)
+	{
+		HTEST_ASSERT(tree.remove(i), "remove()");
+		valid[i] = false;
+	}
+	HTEST_ASSERT(!tree.remove(3) && !tree.remove(-1) && !tree.remove(5000), "remove() with invalid ids");
+	HTEST_ASSERT(tree.getCount() == 666 && !tree.isValid(3) && tree.isValid(4), "getCount() and isValid() after remove()");
+	HTEST_ASSERT(_checkQueries(tree, rectangles, valid, seed), "findIntersecting() and findAt() after remove()");
+	int id = tree.insert(grectf(10.0f, 10.0f, 1.0f, 1.0f));
+	HTEST_ASSERT(id == 999 && tree.getRectangle(id) == grectf(10.0f, 10.0f, 1.0f, 1.0f), "insert() reuses removed ids");
+	for (int i = 0; i < 1000; ++i)
+	{
+		tree.remove(i);
+	}
+	HTEST_ASSERT(tree.getCount() == 0 && tree.getNodeCount() == 1, "remove() releases empty nodes");
+}
+
+HTEST_CASE(nan)
+{
+	float nan = std::numeric_limits<float>::quiet_NaN();
+	gquadtreef tree(grectf(0.0f, 0.0f, 1000.0f, 1000.0f), 6);
+	int inside = tree.insert(grectf(10.0f, 10.0f, 1.0f, 1.0f));
+	int id = tree.insert(grectf(nan, 5.0f, 1.0f, 1.0f));
+	int size = tree.insert(grectf(20.0f, 20.0f, nan, nan));
+	HTEST_ASSERT(tree.getCount() == 3 && tree.isValid(id) && tree.isValid(size), "insert() with NaN");
+	std::vector<int> result;
+	tree.findIntersecting(grectf(0.0f, 0.0f, 1000.0f, 1000.0f), result);
+	HTEST_ASSERT(result.size() == 1 && result[0] == inside, "findIntersecting() skips NaN Rectangles");
+	HTEST_ASSERT(tree.move(inside, grectf(nan, nan, 1.0f, 1.0f)) && tree.move(id, grectf(30.0f, 30.0f, 1.0f, 1.0f)), "move() to and from NaN");
+	tree.findAt(gvec2f(30.5f, 30.5f), result);
+	HTEST_ASSERT(result.size() == 1 && result[0] == id, "findAt() after move() from NaN");
+	HTEST_ASSERT(tree.remove(inside) && tree.remove(size) && tree.getCount() == 1, "remove() of NaN Rectangles");
+}
+
+HTEST_CASE(move)
+{
+	gquadtreef tree(grectf(0.0f, 0.0f, 1000.0f, 1000.0f), 8);
+	std::vector<grectf> rectangles;
+	std::vector<bool> valid(500, true);
+	unsigned int seed = 777;
+	for (int i = 0; i < 500; ++i)
+	{
+		rectangles.push_back(_createRectangle(seed));
+	}
+	tree.build(rectangles);
+	bool resultSmall = true;
+	bool resultLarge = true;
+	for (int step = 0; step < 20; ++step)
+	{
+		for (int i = 0; i < 500; ++i)
+		{
+			rectangles[i].x += (float)(_random(seed) % 21) * 0.1f - 1.0f;
+			rectangles[i].y += (float)(_random(seed) % 21) * 0.1f - 1.0f;
+			tree.move(i, rectangles[i]);
+		}
+		resultSmall &= _checkQueries(tree, rectangles, valid, seed);
+	}
+	HTEST_ASSERT(resultSmall, "move() by small steps");
+	for (int i = 0; i < 500; i += 2)
+	{
+		rectangles[i] = _createRectangle(seed);
+		tree.move(i, rectangles[i]);
+	}
+	resultLarge &= _checkQueries(tree, rectangles, valid, seed);
+	HTEST_ASSERT(resultLarge, "move() to anywhere");
+	HTEST_ASSERT(!tree.move(500, rectangles[0]) && tree.getCount() == 500, "move() with an invalid id");
+}
+
+HTEST_CASE(build)
+{
+	std::vector<grectf> rectangles;
+	unsigned int seed = 4242;
+	for (int i = 0; i < 800; ++i)
+	{
+		rectangles.push_back(_createRectangle(seed));
+	}
+	gquadtreef built(grectf(0.0f, 0.0f, 1000.0f, 1000.0f));
+	built.build(rectangles);
+	gquadtreef inserted(grectf(0.0f, 0.0f, 1000.0f, 1000.0f));
+	for (int i = 0; i < 800; ++i)
+	{
+		inserted.insert(rectangles[i]);
+	}
+	HTEST_ASSERT(built.getCount() == 800 && built.getNodeCount() == inserted.getNodeCount(), "build()");
+	std::vector<bool> valid(800, true);
+	HTEST_ASSERT(_checkQueries(built, rectangles, valid, seed), "findIntersecting() and findAt() after build()");
+	int result[8];
+	grectf everything(-100.0f, -100.0f, 1200.0f, 1200.0f);
+	HTEST_ASSERT(built.findIntersecting(everything, result, 8) == 800, "findIntersecting() with a small buffer");
+	built.clear();
+	HTEST_ASSERT(built.getCount() == 0 && built.findIntersecting(everything, result, 8) == 0, "clear()");
+	gquadtreef unbounded;
+	unbounded.build(rectangles);
+	HTEST_ASSERT(unbounded.getNodeCount() == 1 && _checkQueries(unbounded, rectangles, valid, seed), "build() without bounds");
+}
+
+HTEST_CASE(findNearest)
+{
+	gquadtreef tree(grectf(0.0f, 0.0f, 1000.0f, 1000.0f), 7);
+	std::vector<grectf> rectangles;
+	unsigned int seed = 99;
+	for (int i = 0; i < 600; ++i)
+	{
+		rectangles.push_back(_createRectangle(seed));
+	}
+	tree.build(rectangles);
+	int result[10];
+	double distances[10];
+	std::vector<double> expected(600);
+	bool resultNearest = true;
+	for (int i = 0; i < 50; ++i)
+	{
+		gvec2f point((float)(_random(seed) % 1100) - 50.0f, (float)(_random(seed) % 1100) - 50.0f);
+		for (int j = 0; j < 600; ++j)
+		{
+			expected[j] = _squaredDistance(rectangles[j], point);
+		}
+		std::sort(expected.begin(), expected.end());
+		int found = tree.findNearest(point, 10, result, distances);
+		resultNearest &= (found == 10);
+		for (int j = 0; j < found; ++j)
+		{
+			resultNearest &= (distances[j] == expected[j] && distances[j] == _squaredDistance(rectangles[result[j]], point));
+		}
+	}
+	HTEST_ASSERT(resultNearest, "findNearest()");
+	gquadtreef small(grectf(0.0f, 0.0f, 1000.0f, 1000.0f));
+	small.insert(grectf(10.0f, 10.0f, 5.0f, 5.0f));
+	small.insert(grectf(500.0f, 500.0f, 5.0f, 5.0f));
+	HTEST_ASSERT(small.findNearest(gvec2f(12.0f, 12.0f), 10, result, distances) == 2 && result[0] == 0 && distances[0] == 0.0, "findNearest() with fewer Rectangles");
+}
+
+HTEST_CASE(integer)
+{
+	gquadtreei tree(grecti(0, 0, 640, 480), 5);
+	std::vector<grecti> rectangles;
+	unsigned int seed = 31;
+	for (int i = 0; i < 400; ++i)
+	{
+		rectangles.push_back(grecti((int)(_random(seed) % 700) - 30, (int)(_random(seed) % 520) - 20, (int)(_random(seed) % 40), (int)(_random(seed) % 40)));
+		tree.insert(rectangles.back());
+	}
+	bool result = true;
+	std::vector<int> found;
+	for (int i = 0; i < 40; ++i)
+	{
+		grecti query((int)(_random(seed) % 640), (int)(_random(seed) % 480), (int)(_random(seed) % 100), (int)(_random(seed) % 100));
+		tree.findIntersecting(query, found);
+		result &= _isSameResult(found, _findIntersecting(rectangles, query));
+	}
+	HTEST_ASSERT(result, "findIntersecting() with integer Rectangles");
+}
+
+HTEST_SUITE_END
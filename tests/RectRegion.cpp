@@ -0,0 +1,158 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS RectRegion
+#include <vector>
+
+#include <htest/htest.h>
+
+#include "Rectangle.h"
+#include "RectRegion.h"
+#include "Vector2.h"
+
+#include "RectangleFixture.h"
+
+#define GRID_SIZE 64
+
+// a region of random Rectangles and the same area as pixels
+static grectregioni _createRegion(unsigned int& seed, int rectangleCount, std::vector<char>& pixels)
+{
+	grectregioni result;
+	pixels.assign(GRID_SIZE * GRID_SIZE, 0);
+	for (int i = 0; i < rectangleCount; ++i)
+	{
+		grecti rectangle(_random(seed) % 56, _random(seed) % 56, _random(seed) % 16, _random(seed) % 16);
+		rectangle.clip(grecti(0, 0, GRID_SIZE, GRID_SIZE));
+		result.unite(grectregioni(rectangle));
+		_fillPixels(rectangle, GRID_SIZE, pixels);
+	}
+	return result;
+}
+
+// the Rectangles are sorted into bands, disjoint, joined where possible and match the pixels
+static bool _checkRegion(cgrectregioni region, const std::vector<char>& pixels)
+{
+	const grecti* rectangles = region.getRectangles();
+	int area = 0;
+	for (int i = 0; i < region.getCount(); ++i)
+	{
+		if (rectangles[i].w <= 0 || rectangles[i].h <= 0)
+		{
+			return false;
+		}
+		if (i > 0)
+		{
+			const grecti& previous = rectangles[i - 1];
+			bool sameBand = (previous.y == rectangles[i].y);
+			if (sameBand && (previous.h != rectangles[i].h || previous.x + previous.w >= rectangles[i].x))
+			{
+				return false;
+			}
+			if (!sameBand && previous.y + previous.h > rectangles[i].y)
+			{
+				return false;
+			}
+		}
+		area += rectangles[i].w * rectangles[i].h;
+	}
+	for (int y = 0; y < GRID_SIZE; ++y)
+	{
+		for (int x = 0; x < GRID_SIZE; ++x)
+		{
+			if (region.isPointInside(x, y) != (pixels[y * GRID_SIZE + x] == 1))
+			{
+				return false;
+			}
+		}
+	}
+	return (area == _countPixels(pixels) && region.getArea() == (double)area);
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(basic)
+{
+	grectregioni region(grecti(0, 0, 10, 10));
+	HTEST_ASSERT(region.getCount() == 1 && region.getArea() == 100.0 && region.getExtent() == grecti(0, 0, 10, 10), "constructor");
+	HTEST_ASSERT(grectregioni(grecti(0, 0, 0, 10)).isEmpty() && grectregioni().getExtent() == grecti(), "constructor with an empty Rectangle");
+	region.unite(grectregioni(grecti(10, 0, 10, 10)));
+	HTEST_ASSERT(region.getCount() == 1 && region.getRectangle(0) == grecti(0, 0, 20, 10), "unite() joins touching Rectangles in a band");
+	region.unite(grectregioni(grecti(0, 10, 20, 5)));
+	HTEST_ASSERT(region.getCount() == 1 && region.getRectangle(0) == grecti(0, 0, 20, 15), "unite() joins touching bands");
+	region.subtract(grectregioni(grecti(5, 5, 5, 5)));
+	HTEST_ASSERT(region.getCount() == 4 && region.getArea() == 275.0 && region.getExtent() == grecti(0, 0, 20, 15), "subtract() of a hole");
+	HTEST_ASSERT(region.isPointInside(4, 5) && !region.isPointInside(5, 5) && !region.isPointInside(gvec2i(9, 9)) && region.isPointInside(10, 9), "isPointInside()");
+	HTEST_ASSERT(!region.isPointInside(20, 0) && !region.isPointInside(0, 15) && !region.isPointInside(-1, 0), "isPointInside() at the edges");
+	grectregioni hole = grectregioni(grecti(0, 0, 20, 15)).intersected(grectregioni(grecti(5, 5, 5, 5)));
+	HTEST_ASSERT(hole.getCount() == 1 && hole.getRectangle(0) == grecti(5, 5, 5, 5), "intersected()");
+	HTEST_ASSERT(region.united(hole) == grectregioni(grecti(0, 0, 20, 15)) && region.intersected(hole).isEmpty(), "united() restores the area");
+	HTEST_ASSERT(region.subtracted(region).isEmpty() && region.subtracted(grectregioni()) == region, "subtracted()");
+	grectregionf floats(grectf(0.0f, 0.0f, 1.0f, 1.0f));
+	floats.subtract(grectregionf(grectf(0.25f, 0.25f, 0.5f, 0.5f)));
+	HTEST_ASSERT(floats.getCount() == 4 && heqf((float)floats.getArea(), 0.75f) && floats.isPointInside(gvec2f(0.1f, 0.5f)), "subtract() with floats");
+}
+
+HTEST_CASE(operations)
+{
+	unsigned int seed = 5;
+	std::vector<char> pixelsA;
+	std::vector<char> pixelsB;
+	std::vector<char> expected(GRID_SIZE * GRID_SIZE);
+	bool resultUnion = true;
+	bool resultSubtract = true;
+	bool resultIntersect = true;
+	bool resultIdentity = true;
+	for (int i = 0; i < 40; ++i)
+	{
+		grectregioni a = _createRegion(seed, 1 + i % 12, pixelsA);
+		grectregioni b = _createRegion(seed, 1 + (i * 7) % 12, pixelsB);
+		resultUnion &= _checkRegion(a, pixelsA);
+		for (int j = 0; j < GRID_SIZE * GRID_SIZE; ++j)
+		{
+			expected[j] = (pixelsA[j] | pixelsB[j]);
+		}
+		resultUnion &= _checkRegion(a.united(b), expected);
+		for (int j = 0; j < GRID_SIZE * GRID_SIZE; ++j)
+		{
+			expected[j] = (pixelsA[j] & (1 - pixelsB[j]));
+		}
+		resultSubtract &= _checkRegion(a.subtracted(b), expected);
+		for (int j = 0; j < GRID_SIZE * GRID_SIZE; ++j)
+		{
+			expected[j] = (pixelsA[j] & pixelsB[j]);
+		}
+		resultIntersect &= _checkRegion(a.intersected(b), expected);
+		// equal areas have equal Rectangles no matter how they were built
+		resultIdentity &= (a.subtracted(b).united(a.intersected(b)) == a && a.united(b) == b.united(a));
+		a.intersect(b);
+		resultIdentity &= (a == b.intersected(a));
+	}
+	HTEST_ASSERT(resultUnion, "united()");
+	HTEST_ASSERT(resultSubtract, "subtracted()");
+	HTEST_ASSERT(resultIntersect, "intersected()");
+	HTEST_ASSERT(resultIdentity, "equal areas have equal Rectangles");
+}
+
+HTEST_CASE(storage)
+{
+	// a checkerboard needs many more Rectangles than fit inline
+	grectregioni board;
+	for (int y = 0; y < 8; ++y)
+	{
+		for (int x = (y % 2); x < 8; x += 2)
+		{
+			board.unite(grectregioni(grecti(x, y, 1, 1)));
+		}
+	}
+	HTEST_ASSERT(board.getCount() == 32 && board.getArea() == 32.0 && board.isPointInside(1, 1) && !board.isPointInside(1, 0), "unite() beyond the inline storage");
+	grectregioni copy(board);
+	grectregioni assigned;
+	assigned = board;
+	board.clear();
+	HTEST_ASSERT(copy.getCount() == 32 && copy == assigned && board.isEmpty(), "copy constructor and operator=()");
+	copy.subtract(grectregioni(grecti(0, 0, 8, 7)));
+	HTEST_ASSERT(copy.getCount() == 4 && copy.getExtent() == grecti(1, 7, 7, 1), "subtract() back into the inline storage");
+	copy = assigned;
+	copy.intersect(grectregioni(grecti(0, 0, 2, 2)));
+	HTEST_ASSERT(copy.getCount() == 2, "intersect()");
+}
+
+HTEST_SUITE_END
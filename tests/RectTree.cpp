@@ -0,0 +1,293 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS RectTree
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+#include <htest/htest.h>
+
+#include "Rectangle.h"
+#include "RectTree.h"
+#include "Vector2.h"
+
+#include "RectangleFixture.h"
+
+static std::vector<grectf> _createRectangles(int count, unsigned int& seed)
+{
+	std::vector<grectf> result;
+	for (int i = 0; i < count; ++i)
+	{
+		float x = (float)(_random(seed) % 100000) * 0.01f;
+		float y = (float)(_random(seed) % 100000) * 0.01f;
+		// mostly tiles with a few large collision areas
+		float scale = (_random(seed) % 50 == 0 ? 0.5f : 0.02f);
+		result.push_back(grectf(x, y, (float)(_random(seed) % 100) * scale, (float)(_random(seed) % 100) * scale));
+	}
+	return result;
+}
+
+// the same slab test as the tree, touching counts as a hit
+static bool _intersectRay(cgrectf rectangle, cgvec2f origin, cgvec2f direction, float maxDistance, double& entry)
+{
+	double minimum = 0.0;
+	double maximum = maxDistance;
+	double origins[2] = { origin.x, origin.y };
+	double directions[2] = { direction.x, direction.y };
+	double lower[2] = { rectangle.x, rectangle.y };
+	double upper[2] = { (double)rectangle.x + rectangle.w, (double)rectangle.y + rectangle.h };
+	for (int i = 0; i < 2; ++i)
+	{
+		if (directions[i] == 0.0)
+		{
+			if (origins[i] < lower[i] || origins[i] > upper[i])
+			{
+				return false;
+			}
+			continue;
+		}
+		double enter = (lower[i] - origins[i]) * (1.0 / directions[i]);
+		double leave = (upper[i] - origins[i]) * (1.0 / directions[i]);
+		minimum = std::max(minimum, std::min(enter, leave));
+		maximum = std::min(maximum, std::max(enter, leave));
+	}
+	entry = minimum;
+	return (minimum <= maximum);
+}
+
+static bool _checkQueries(cgrecttreef tree, const std::vector<grectf>& rectangles, unsigned int seed)
+{
+	std::vector<int> result;
+	for (int i = 0; i < 30; ++i)
+	{
+		grectf query((float)(_random(seed) % 1000), (float)(_random(seed) % 1000), (float)(_random(seed) % 50), (float)(_random(seed) % 50));
+		tree.findIntersecting(query, result);
+		if (!_isSameResult(result, _findIntersecting(rectangles, query)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(build)
+{
+	unsigned int seed = 12345;
+	std::vector<grectf> rectangles = _createRectangles(5000, seed);
+	grecttreef tree;
+	HTEST_ASSERT(tree.getCount() == 0 && tree.getNodeCount() == 0 && tree.getBounds() == grectf(), "empty tree");
+	int buffer[4];
+	HTEST_ASSERT(tree.findIntersecting(grectf(0.0f, 0.0f, 10.0f, 10.0f), buffer, 4) == 0, "findIntersecting() on an empty tree");
+	tree.build(rectangles, 8, 1);
+	HTEST_ASSERT(tree.getCount() == 5000 && tree.getNodeSize() == 8 && tree.getNodeCount() == 625 + 79 + 10 + 2 + 1, "build()");
+	HTEST_ASSERT(_checkQueries(tree, rectangles, seed), "findIntersecting()");
+	HTEST_ASSERT(tree.findIntersecting(grectf(-1.0f, -1.0f, 2000.0f, 2000.0f), buffer, 4) == 5000, "findIntersecting() with a small buffer");
+	grectf bounds = tree.getBounds();
+	bool resultBounds = true;
+	for (int i = 0; i < 5000; ++i)
+	{
+		resultBounds &= bounds.contains(rectangles[i]);
+	}
+	HTEST_ASSERT(resultBounds, "getBounds()");
+	grecttreef single;
+	single.build(&rectangles[7], 1);
+	grectf singleBounds = single.getBounds();
+	HTEST_ASSERT(single.getNodeCount() == 1 && singleBounds.getPosition() == rectangles[7].getPosition() && heqf(singleBounds.w, rectangles[7].w) &&
+		heqf(singleBounds.h, rectangles[7].h), "build() with one Rectangle");
+	HTEST_ASSERT(single.findIntersecting(rectangles[7], buffer, 4) == (rectangles[7].w > 0.0f && rectangles[7].h > 0.0f ? 1 : 0), "findIntersecting() with one Rectangle");
+	single.build(&rectangles[7], 0);
+	HTEST_ASSERT(single.getCount() == 0 && single.getNodeCount() == 0, "build() without Rectangles");
+}
+
+HTEST_CASE(parallel)
+{
+	unsigned int seed = 555;
+	std::vector<grectf> rectangles = _createRectangles(150000, seed);
+	grecttreef serial;
+	grecttreef parallel;
+	serial.build(rectangles, 16, 1);
+	parallel.build(rectangles, 16, 4);
+	HTEST_ASSERT(serial.getNodeCount() == parallel.getNodeCount(), "build() on multiple threads");
+	bool resultNodes = true;
+	for (int i = 0; i < serial.getNodeCount(); ++i)
+	{
+		resultNodes &= (serial.getNodes()[i].bounds == parallel.getNodes()[i].bounds && serial.getNodes()[i].first == parallel.getNodes()[i].first);
+	}
+	HTEST_ASSERT(resultNodes, "build() on multiple threads creates the same nodes");
+	HTEST_ASSERT(_checkQueries(parallel, rectangles, seed), "findIntersecting() after building on multiple threads");
+}
+
+HTEST_CASE(ray)
+{
+	unsigned int seed = 99;
+	std::vector<grectf> rectangles = _createRectangles(3000, seed);
+	grecttreef tree;
+	tree.build(rectangles, 6);
+	std::vector<int> result(3000);
+	std::vector<int> expected;
+	bool resultAll = true;
+	bool resultFirst = true;
+	for (int i = 0; i < 60; ++i)
+	{
+		gvec2f origin((float)(_random(seed) % 1000), (float)(_random(seed) % 1000));
+		gvec2f direction((float)(_random(seed) % 200) - 100.0f, (float)(_random(seed) % 200) - 100.0f);
+		// axis-aligned rays take the parallel branch of the slab test
+		if (i % 10 == 0)
+		{
+			direction.y = 0.0f;
+		}
+		float maxDistance = (i % 3 == 0 ? 100.0f : 2.0f);
+		int found = tree.findOnRay(origin, direction, maxDistance, &result[0], (int)result.size());
+		std::sort(result.begin(), result.begin() + found);
+		expected.clear();
+		double closest = maxDistance + 1.0;
+		double entry = 0.0;
+		for (int j = 0; j < 3000; ++j)
+		{
+			if (_intersectRay(rectangles[j], origin, direction, maxDistance, entry))
+			{
+				expected.push_back(j);
+				closest = std::min(closest, entry);
+			}
+		}
+		resultAll &= (std::vector<int>(result.begin(), result.begin() + found) == expected);
+		float distance = -1.0f;
+		int first = tree.findFirstOnRay(origin, direction, maxDistance, distance);
+		if (expected.size() == 0)
+		{
+			resultFirst &= (first == -1 && distance == -1.0f);
+		}
+		else
+		{
+			resultFirst &= (first >= 0 && _intersectRay(rectangles[first], origin, direction, maxDistance, entry) && entry == closest && distance == (float)closest);
+		}
+	}
+	HTEST_ASSERT(resultAll, "findOnRay()");
+	HTEST_ASSERT(resultFirst, "findFirstOnRay()");
+	gvec2f inside = rectangles[0].getCenter();
+	float distance = -1.0f;
+	HTEST_ASSERT(tree.findFirstOnRay(inside, gvec2f(1.0f, 0.0f), 10.0f, distance) >= 0 && distance == 0.0f, "findFirstOnRay() from inside a Rectangle");
+}
+
+HTEST_CASE(saveLoad)
+{
+	unsigned int seed = 2024;
+	std::vector<grectf> rectangles = _createRectangles(4000, seed);
+	grecttreef tree;
+	tree.build(rectangles);
+	std::vector<unsigned char> data;
+	tree.save(data);
+	HTEST_ASSERT(data.size() == tree.getDataSize(), "save()");
+	grecttreef loaded;
+	HTEST_ASSERT(loaded.load(&data[0], data.size()) && !loaded.isAttached(), "load()");
+	HTEST_ASSERT(loaded.getCount() == 4000 && loaded.getNodeCount() == tree.getNodeCount() && _checkQueries(loaded, rectangles, seed), "findIntersecting() after load()");
+	// a vector of ints keeps the block aligned like a memory-mapped file
+	std::vector<int> aligned(data.size() / sizeof(int));
+	memcpy(&aligned[0], &data[0], data.size());
+	grecttreef attached;
+	HTEST_ASSERT(attached.attach((const unsigned char*)&aligned[0], data.size()) && attached.isAttached(), "attach()");
+	HTEST_ASSERT(_checkQueries(attached, rectangles, seed), "findIntersecting() after attach()");
+	grecttreef copy = attached;
+	HTEST_ASSERT(copy.isAttached() && copy.getNodes() == attached.getNodes(), "copy of an attached tree");
+	copy = tree;
+	HTEST_ASSERT(!copy.isAttached() && copy.getNodes() != tree.getNodes() && _checkQueries(copy, rectangles, seed), "copy of a built tree");
+	std::vector<unsigned char> saved;
+	attached.save(saved);
+	HTEST_ASSERT(saved == data, "save() of an attached tree");
+	HTEST_ASSERT(!loaded.load(&data[0], data.size() - 1) && loaded.getCount() == 4000, "load() with a truncated block");
+	grecttreei integer;
+	HTEST_ASSERT(!integer.load(&data[0], data.size()) && !integer.attach((const unsigned char*)&aligned[0], data.size()), "load() with a different type");
+	std::vector<unsigned char> broken = data;
+	// the first child of the root points back at the root
+	int root = 0;
+	memcpy(&broken[6 * sizeof(int) + sizeof(grectf)], &root, sizeof(int));
+	HTEST_ASSERT(!loaded.load(&broken[0], broken.size()), "load() with broken nodes");
+	grecttreef empty;
+	empty.save(data);
+	HTEST_ASSERT(loaded.load(&data[0], data.size()) && loaded.getCount() == 0, "load() of an empty tree");
+}
+
+HTEST_CASE(corruptBlocks)
+{
+	unsigned int seed = 99;
+	std::vector<grectf> rectangles = _createRectangles(1000, seed);
+	grecttreef tree;
+	tree.build(rectangles, 4);
+	std::vector<unsigned char> data;
+	tree.save(data);
+	grecttreef loaded;
+	size_t nodesOffset = 6 * sizeof(int);
+	size_t idsOffset = nodesOffset + tree.getNodeCount() * sizeof(grecttreef::Node) + 1000 * sizeof(grectf);
+	// an id that is not an index into the array of the build
+	std::vector<unsigned char> broken = data;
+	int value = 1000;
+	memcpy(&broken[idsOffset + 17 * sizeof(int)], &value, sizeof(int));
+	HTEST_ASSERT(!loaded.load(&broken[0], broken.size()), "load() with an id out of range");
+	// a leaf that leaves out its last Rectangle
+	broken = data;
+	grecttreef::Node node;
+	memcpy((void*)&node, &broken[nodesOffset + (tree.getNodeCount() - 1) * sizeof(grecttreef::Node)], sizeof(node));
+	--node.count;
+	memcpy(&broken[nodesOffset + (tree.getNodeCount() - 1) * sizeof(grecttreef::Node)], (const void*)&node, sizeof(node));
+	HTEST_ASSERT(!loaded.load(&broken[0], broken.size()), "load() with a different node count");
+	// an inner node that points at the children of its neighbor
+	broken = data;
+	memcpy((void*)&node, &broken[nodesOffset + sizeof(grecttreef::Node)], sizeof(node));
+	node.first += node.count;
+	memcpy(&broken[nodesOffset + sizeof(grecttreef::Node)], (const void*)&node, sizeof(node));
+	HTEST_ASSERT(!loaded.load(&broken[0], broken.size()), "load() with a different first child");
+	broken = data;
+	value = tree.getNodeCount() - 1;
+	memcpy(&broken[5 * sizeof(int)], &value, sizeof(int));
+	HTEST_ASSERT(!loaded.load(&broken[0], broken.size()), "load() with a different leaf start");
+	// a chain of single-child nodes, every child comes after its parent but the queries would recurse once per node
+	int count = 5000;
+	int header[6] = { 0x31545247, (int)sizeof(float) | 0x100, 2, count, count, count - 1 };
+	std::vector<int> chain(6 + count * sizeof(grecttreef::Node) / sizeof(int) + count * (sizeof(grectf) + sizeof(int)) / sizeof(int), 0);
+	memcpy(&chain[0], header, sizeof(header));
+	for (int i = 0; i < count; ++i)
+	{
+		node.bounds.set(0.0f, 0.0f, 10.0f, 10.0f);
+		node.first = (i < count - 1 ? i + 1 : 0);
+		node.count = 1;
+		memcpy((unsigned char*)&chain[6] + i * sizeof(grecttreef::Node), (const void*)&node, sizeof(node));
+	}
+	const unsigned char* block = (const unsigned char*)&chain[0];
+	HTEST_ASSERT(!loaded.load(block, chain.size() * sizeof(int)) && !loaded.attach(block, chain.size() * sizeof(int)), "load() and attach() of a chain of nodes");
+	HTEST_ASSERT(loaded.getCount() == 0, "load() and attach() keep the tree after a broken block");
+}
+
+HTEST_CASE(integer)
+{
+	std::vector<grecti> rectangles;
+	// a tile map with a few holes
+	for (int y = 0; y < 200; ++y)
+	{
+		for (int x = 0; x < 200; ++x)
+		{
+			if ((x * 7 + y * 3) % 11 != 0)
+			{
+				rectangles.push_back(grecti(x * 16, y * 16, 16, 16));
+			}
+		}
+	}
+	grecttreei tree;
+	tree.build(rectangles, 32, 2);
+	bool result = true;
+	std::vector<int> found;
+	unsigned int seed = 17;
+	for (int i = 0; i < 40; ++i)
+	{
+		grecti query((int)(_random(seed) % 3200), (int)(_random(seed) % 3200), (int)(_random(seed) % 64), (int)(_random(seed) % 64));
+		tree.findIntersecting(query, found);
+		result &= _isSameResult(found, _findIntersecting(rectangles, query));
+	}
+	HTEST_ASSERT(result, "findIntersecting() with integer Rectangles");
+	HTEST_ASSERT(tree.getBounds() == grecti(0, 0, 3200, 3200), "getBounds() with integer Rectangles");
+	float distance = 0.0f;
+	int first = tree.findFirstOnRay(gvec2f(-10.0f, 8.0f), gvec2f(1.0f, 0.0f), 100.0f, distance);
+	HTEST_ASSERT(first >= 0 && rectangles[first] == grecti(16, 0, 16, 16) && distance == 26.0f, "findFirstOnRay() with integer Rectangles");
+}
+
+HTEST_SUITE_END
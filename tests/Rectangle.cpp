@@ -132,6 +132,24 @@ HTEST_CASE(pointInside)
 	HTEST_ASSERT(r.isPointInside(v.x, v.y), "isPointInside(float, float)");
 }
 
+HTEST_CASE(pointsInside)
+{
+	grectf r(0.0f, 0.0f, 4.0f, 4.0f);
+	gvec2f points[5] = { gvec2f(1.0f, 2.0f), gvec2f(4.0f, 2.0f), gvec2f(0.0f, 0.0f), gvec2f(-1.0f, 1.0f), gvec2f(3.5f, 3.5f) };
+	unsigned int mask = 0xFFFFFFFF;
+	r.maskPointsInside(points, 5, &mask);
+	HTEST_ASSERT(mask == 0x15, "maskPointsInside()");
+	int result[5];
+	HTEST_ASSERT(r.findPointsInside(points, 5, result) == 3 && result[0] == 0 && result[1] == 2 && result[2] == 4, "findPointsInside()");
+	grectf rectangles[2] = { grectf(0.0f, 0.0f, 1.0f, 1.0f), grectf(3.0f, 1.0f, 2.0f, 2.0f) };
+	HTEST_ASSERT(grectf::findPointsInside(rectangles, 2, points, 5, result) == 2 && result[0] == 1 && result[1] == 2, "findPointsInside() with several Rectangles");
+	grecti ri(0, 0, 4, 4);
+	int x[3] = { 0, 4, 3 };
+	int y[3] = { 3, 3, 3 };
+	ri.maskPointsInside(x, y, 3, &mask);
+	HTEST_ASSERT(mask == 0x5, "maskPointsInside(int*, int*)");
+}
+
 HTEST_CASE(addition)
 {
 	grectf r(0, 0, 4, 4);
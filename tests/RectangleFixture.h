@@ -0,0 +1,82 @@
+/// @file
+/// @version 3.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides the random numbers and brute-force reference results shared by the tests of the Rectangle containers.
+
+#ifndef GTYPES_TESTS_RECTANGLE_FIXTURE_H
+#define GTYPES_TESTS_RECTANGLE_FIXTURE_H
+
+#include <algorithm>
+#include <stddef.h>
+#include <vector>
+
+#include "Rectangle.h"
+
+// an LCG so every platform creates the same test data
+static inline unsigned int _random(unsigned int& seed)
+{
+	seed = seed * 1103515245 + 12345;
+	return (seed >> 8);
+}
+
+// a float in [minimum,maximum] in 65536 steps
+static inline float _randomFloat(unsigned int& seed, float minimum, float maximum)
+{
+	return minimum + (maximum - minimum) * (float)(_random(seed) % 65536) / 65535.0f;
+}
+
+// indices of all Rectangles intersecting a Rectangle by brute force, skips the ones that are not valid if valid flags are given
+template <typename T>
+static inline std::vector<int> _findIntersecting(const std::vector<gtypes::Rectangle<T> >& rectangles, const gtypes::Rectangle<T>& rectangle,
+	const std::vector<bool>* valid = NULL)
+{
+	std::vector<int> result;
+	for (int i = 0; i < (int)rectangles.size(); ++i)
+	{
+		if ((valid == NULL || (*valid)[i]) && rectangles[i].intersects(rectangle))
+		{
+			result.push_back(i);
+		}
+	}
+	return result;
+}
+
+// compares the indices of a query in any order with a sorted brute-force result
+static inline bool _isSameResult(std::vector<int> result, const std::vector<int>& expected)
+{
+	std::sort(result.begin(), result.end());
+	return (result == expected);
+}
+
+// marks the pixels of a Rectangle clipped to a size x size grid
+static inline void _fillPixels(const gtypes::Rectangle<int>& rectangle, int size, std::vector<char>& pixels)
+{
+	gtypes::Rectangle<int> clipped = rectangle.clipped(gtypes::Rectangle<int>(0, 0, size, size));
+	for (int y = clipped.y; y < clipped.y + clipped.h; ++y)
+	{
+		for (int x = clipped.x; x < clipped.x + clipped.w; ++x)
+		{
+			pixels[y * size + x] = 1;
+		}
+	}
+}
+
+// number of marked pixels
+static inline int _countPixels(const std::vector<char>& pixels)
+{
+	int result = 0;
+	for (unsigned int i = 0; i < pixels.size(); ++i)
+	{
+		result += pixels[i];
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,646 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS Simd
+#include <string.h>
+
+#include <htest/htest.h>
+
+#include "gtypesSimd.h"
+#include "DualQuaternion.h"
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "PackedQuaternion.h"
+#include "PackedVector3.h"
+#include "Quaternion.h"
+#include "Rectangle.h"
+#include "SpaceFillingCurve.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+#define E_TOLRANCE 0.0001f
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(levels)
+{
+	gtypes::simd::Level supported = gtypes::simd::getSupportedLevel();
+	HTEST_ASSERT(gtypes::simd::isLevelSupported(gtypes::simd::LevelScalar), "scalar is always supported");
+	HTEST_ASSERT(gtypes::simd::isLevelSupported(supported), "supported level");
+	HTEST_ASSERT(strcmp(gtypes::simd::getLevelName(gtypes::simd::LevelSse41), "sse4.1") == 0, "getLevelName()");
+	gtypes::simd::Level level = gtypes::simd::getLevel();
+	HTEST_ASSERT(gtypes::simd::setLevel(gtypes::simd::LevelScalar), "setLevel(LevelScalar)");
+	HTEST_ASSERT(gtypes::simd::getLevel() == gtypes::simd::LevelScalar, "getLevel()");
+	if (supported == gtypes::simd::LevelNeon)
+	{
+		HTEST_ASSERT(!gtypes::simd::setLevel(gtypes::simd::LevelSse2), "x86 levels are not supported on ARM");
+	}
+	else
+	{
+		HTEST_ASSERT(!gtypes::simd::setLevel(gtypes::simd::LevelNeon), "NEON is not supported on x86");
+	}
+	gtypes::simd::setLevel(level);
+}
+
+HTEST_CASE(normalizeFastAllLevels)
+{
+	// 37 elements so every kernel also runs its remainder loop
+	gvec2f vectors2[37];
+	gvec3f vectors3[37];
+	gquat quaternions[37];
+	gtypes::simd::Level level = gtypes::simd::getLevel();
+	for (int l = 0; l < gtypes::simd::LevelCount; ++l)
+	{
+		if (!gtypes::simd::setLevel((gtypes::simd::Level)l))
+		{
+			continue;
+		}
+		for (int i = 0; i < 37; ++i)
+		{
+			vectors2[i].set(i * 0.5f - 3.0f, 7.0f - i);
+			vectors3[i].set(i * 0.5f - 3.0f, 7.0f - i, (float)(i % 5));
+			quaternions[i].set(i * 0.5f - 3.0f, 7.0f - i, (float)(i % 5), 0.25f);
+		}
+		vectors2[5].set(0.0f, 0.0f);
+		vectors3[11].set(0.0f, 0.0f, 0.0f);
+		quaternions[2].set(0.0f, 0.0f, 0.0f, 0.0f);
+		gvec2f::normalizeFast(vectors2, 37);
+		gvec3f::normalizeFast(vectors3, 37);
+		gquat::normalizeFast(quaternions, 37);
+		bool result2 = true;
+		bool result3 = true;
+		bool resultQuaternion = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gvec2f expected2 = gvec2f(i * 0.5f - 3.0f, 7.0f - i).normalized();
+			gvec3f expected3 = gvec3f(i * 0.5f - 3.0f, 7.0f - i, (float)(i % 5)).normalized();
+			gquat expectedQuaternion = gquat(i * 0.5f - 3.0f, 7.0f - i, (float)(i % 5), 0.25f).normalized();
+			if (i == 5)
+			{
+				expected2.set(0.0f, 0.0f);
+			}
+			if (i == 11)
+			{
+				expected3.set(0.0f, 0.0f, 0.0f);
+			}
+			if (i == 2)
+			{
+				expectedQuaternion.set(0.0f, 0.0f, 0.0f, 0.0f);
+			}
+			result2 &= (heqf(vectors2[i].x, expected2.x) && heqf(vectors2[i].y, expected2.y));
+			result3 &= (heqf(vectors3[i].x, expected3.x) && heqf(vectors3[i].y, expected3.y) && heqf(vectors3[i].z, expected3.z));
+			resultQuaternion &= (heqf(quaternions[i].x, expectedQuaternion.x) && heqf(quaternions[i].y, expectedQuaternion.y) &&
+				heqf(quaternions[i].z, expectedQuaternion.z) && heqf(quaternions[i].w, expectedQuaternion.w));
+		}
+		HTEST_ASSERT(result2, gtypes::simd::getLevelName((gtypes::simd::Level)l));
+		HTEST_ASSERT(result3, gtypes::simd::getLevelName((gtypes::simd::Level)l));
+		HTEST_ASSERT(resultQuaternion, gtypes::simd::getLevelName((gtypes::simd::Level)l));
+	}
+	gtypes::simd::setLevel(level);
+}
+
+HTEST_CASE(anglesAllLevels)
+{
+	// 37 elements so every kernel also runs its remainder loop
+	gvec2f vectors[37];
+	float angles[37];
+	float expected[37];
+	gtypes::simd::Level level = gtypes::simd::getLevel();
+	for (int l = 0; l < gtypes::simd::LevelCount; ++l)
+	{
+		if (!gtypes::simd::setLevel((gtypes::simd::Level)l))
+		{
+			continue;
+		}
+		for (int i = 0; i < 37; ++i)
+		{
+			vectors[i].set(i * 0.5f - 3.0f, 7.0f - i);
+			expected[i] = vectors[i].angle();
+		}
+		vectors[5].set(0.0f, 0.0f);
+		expected[5] = 0.0f;
+		vectors[6].set(-2.0f, 0.0f);
+		expected[6] = vectors[6].angle();
+		gvec2f::angles(vectors, angles, 37);
+		bool resultAngles = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			resultAngles &= (fabsf(angles[i] - expected[i]) < 0.00015f);
+		}
+		HTEST_ASSERT(resultAngles, gtypes::simd::getLevelName((gtypes::simd::Level)l));
+		for (int i = 0; i < 37; ++i)
+		{
+			angles[i] = i * 47.5f - 900.0f;
+		}
+		angles[3] = 45.0f;
+		angles[4] = -135.0f;
+		gvec2f::fromAngles(angles, vectors, 37);
+		bool resultVectors = true;
+		bool resultRoundTrip = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gvec2f expectedVector = gvec2f(1.0f, 0.0f).rotated(-angles[i]);
+			resultVectors &= (heqf(vectors[i].x, expectedVector.x) && heqf(vectors[i].y, expectedVector.y));
+			resultRoundTrip &= heqf(fmodf(vectors[i].angle() - angles[i] + 3600.0f, 360.0f), 0.0f) || heqf(fmodf(vectors[i].angle() - angles[i] + 3600.0f, 360.0f), 360.0f);
+		}
+		HTEST_ASSERT(resultVectors, gtypes::simd::getLevelName((gtypes::simd::Level)l));
+		HTEST_ASSERT(resultRoundTrip, gtypes::simd::getLevelName((gtypes::simd::Level)l));
+	}
+	gtypes::simd::setLevel(level);
+}
+
+HTEST_CASE(pointQueriesAllLevels)
+{
+	// more than one block of 1024 points and not a multiple of 32 so every kernel also runs its remainder loop
+	const int count = 2087;
+	gvec2f* points = new gvec2f[count];
+	float* x = new float[count];
+	float* y = new float[count];
+	int* result = new int[count];
+	unsigned int mask[(count + 31) / 32];
+	grectf rectangles[3] = { grectf(-5.0f, -5.0f, 10.0f, 4.0f), grectf(20.0f, -30.0f, 5.0f, 60.0f), grectf(-2.0f, 2.0f, 3.0f, 3.0f) };
+	for (int i = 0; i < count; ++i)
+	{
+		points[i].set((float)((i * 37) % 61) - 30.0f, (float)((i * 53) % 67) - 33.0f);
+		x[i] = points[i].x;
+		y[i] = points[i].y;
+	}
+	gvec2f center(3.0f, -4.0f);
+	gtypes::simd::Level level = gtypes::simd::getLevel();
+	for (int l = 0; l < gtypes::simd::LevelCount; ++l)
+	{
+		if (!gtypes::simd::setLevel((gtypes::simd::Level)l))
+		{
+			continue;
+		}
+		const char* name = gtypes::simd::getLevelName((gtypes::simd::Level)l);
+		for (int soa = 0; soa < 2; ++soa)
+		{
+			bool resultMask = true;
+			bool resultFind = true;
+			int found = 0;
+			int expectedCount = 0;
+			// circle
+			if (soa == 0)
+			{
+				gvec2f::maskInCircle(points, count, center, 11.0f, mask);
+				found = gvec2f::findInCircle(points, count, center, 11.0f, result);
+			}
+			else
+			{
+				gvec2f::maskInCircle(x, y, count, center, 11.0f, mask);
+				found = gvec2f::findInCircle(x, y, count, center, 11.0f, result);
+			}
+			expectedCount = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				bool inside = points[i].isInCircle(center, 11.0f);
+				resultMask &= (((mask[i / 32] >> (i % 32)) & 1) == (inside ? 1u : 0u));
+				if (inside)
+				{
+					resultFind &= (expectedCount < found && result[expectedCount] == i);
+					++expectedCount;
+				}
+			}
+			resultMask &= ((mask[count / 32] >> (count % 32)) == 0);
+			resultFind &= (found == expectedCount && expectedCount > 0);
+			HTEST_ASSERT(resultMask, name);
+			HTEST_ASSERT(resultFind, name);
+			// several Rectangles
+			if (soa == 0)
+			{
+				grectf::maskPointsInside(rectangles, 3, points, count, mask);
+				found = grectf::findPointsInside(rectangles, 3, points, count, result);
+			}
+			else
+			{
+				grectf::maskPointsInside(rectangles, 3, x, y, count, mask);
+				found = grectf::findPointsInside(rectangles, 3, x, y, count, result);
+			}
+			resultMask = true;
+			resultFind = true;
+			expectedCount = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				bool inside = (rectangles[0].isPointInside(points[i]) || rectangles[1].isPointInside(points[i]) || rectangles[2].isPointInside(points[i]));
+				resultMask &= (((mask[i / 32] >> (i % 32)) & 1) == (inside ? 1u : 0u));
+				if (inside)
+				{
+					resultFind &= (expectedCount < found && result[expectedCount] == i);
+					++expectedCount;
+				}
+			}
+			resultMask &= ((mask[count / 32] >> (count % 32)) == 0);
+			resultFind &= (found == expectedCount && expectedCount > 0);
+			HTEST_ASSERT(resultMask, name);
+			HTEST_ASSERT(resultFind, name);
+		}
+		// compressMask() alone with an offset and sparse, dense and empty words
+		for (int i = 0; i < (count + 31) / 32; ++i)
+		{
+			mask[i] = (i % 3 == 0 ? 0 : (i % 3 == 1 ? 0x80000001u : 0xFFFFFFFFu));
+		}
+		mask[count / 32] &= (1u << (count % 32)) - 1;
+		int found = gtypes::simd::compressMask(mask, count, 100, result);
+		bool resultCompress = true;
+		int expectedCount = 0;
+		for (int i = 0; i < count; ++i)
+		{
+			if (((mask[i / 32] >> (i % 32)) & 1) != 0)
+			{
+				resultCompress &= (expectedCount < found && result[expectedCount] == i + 100);
+				++expectedCount;
+			}
+		}
+		HTEST_ASSERT(resultCompress && found == expectedCount, name);
+	}
+	gtypes::simd::setLevel(level);
+	delete[] points;
+	delete[] x;
+	delete[] y;
+	delete[] result;
+}
+
+HTEST_CASE(packedVector3AllLevels)
+{
+	// 37 elements so every kernel also runs its remainder loop
+	gvec3f vectors[37];
+	gvec3f result[37];
+	gtypes::HalfVector3 halves[37];
+	gtypes::Unorm16Vector3 unorms[37];
+	gtypes::OctahedralVector3 octahedrals[37];
+	gtypes::Snorm10Vector3 snorms[37];
+	gvec3f nans[6];
+	unsigned int nanBits[18];
+	gvec3f minimum(-4.0f, -20.0f, 0.0f);
+	gvec3f maximum(4.0f, 20.0f, 0.0f);
+	for (int i = 0; i < 37; ++i)
+	{
+		vectors[i].set(i * 0.25f - 4.5f, 19.0f - i * 1.1f, (i % 5) * 0.3f - 0.7f);
+	}
+	vectors[3].set(0.0f, 0.0f, 0.0f);
+	vectors[4].set(1.0e-6f, -70000.0f, 2049.0f);
+	vectors[7].set(0.0f, 0.0f, -1.0f);
+	gtypes::simd::Level level = gtypes::simd::getLevel();
+	for (int l = 0; l < gtypes::simd::LevelCount; ++l)
+	{
+		if (!gtypes::simd::setLevel((gtypes::simd::Level)l))
+		{
+			continue;
+		}
+		const char* name = gtypes::simd::getLevelName((gtypes::simd::Level)l);
+		gtypes::HalfVector3::encode(vectors, halves, 37);
+		gtypes::HalfVector3::decode(halves, result, 37);
+		bool resultEncode = true;
+		bool resultDecode = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gtypes::HalfVector3 expected(vectors[i]);
+			resultEncode &= (halves[i].x == expected.x && halves[i].y == expected.y && halves[i].z == expected.z);
+			resultDecode &= (result[i] == expected.toVector3());
+		}
+		HTEST_ASSERT(resultEncode, name);
+		HTEST_ASSERT(resultDecode, name);
+		// signaling, quiet and negative NaNs with payloads, enough for a full F16C batch on every level
+		for (int i = 0; i < 6; ++i)
+		{
+			nanBits[i * 3] = 0x7F800001u + i;
+			nanBits[i * 3 + 1] = 0x7FC12345u + (i << 16);
+			nanBits[i * 3 + 2] = 0xFFFFE000u - i;
+		}
+		memcpy(nans, nanBits, sizeof(nans));
+		gtypes::HalfVector3::encode(nans, halves, 6);
+		resultEncode = true;
+		for (int i = 0; i < 6; ++i)
+		{
+			gtypes::HalfVector3 expected(nans[i]);
+			resultEncode &= (halves[i].x == expected.x && halves[i].y == expected.y && halves[i].z == expected.z);
+		}
+		HTEST_ASSERT(resultEncode, name);
+		gtypes::Unorm16Vector3::encode(vectors, unorms, 37, minimum, maximum);
+		gtypes::Unorm16Vector3::decode(unorms, result, 37, minimum, maximum);
+		resultEncode = true;
+		resultDecode = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gtypes::Unorm16Vector3 expected(vectors[i], minimum, maximum);
+			resultEncode &= (unorms[i].x == expected.x && unorms[i].y == expected.y && unorms[i].z == expected.z);
+			resultDecode &= (result[i] == expected.toVector3(minimum, maximum));
+		}
+		HTEST_ASSERT(resultEncode, name);
+		HTEST_ASSERT(resultDecode, name);
+		gtypes::OctahedralVector3::encode(vectors, octahedrals, 37);
+		gtypes::OctahedralVector3::decode(octahedrals, result, 37);
+		resultEncode = true;
+		resultDecode = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gtypes::OctahedralVector3 expected(vectors[i]);
+			gvec3f expectedVector = expected.toVector3();
+			resultEncode &= (octahedrals[i].x == expected.x && octahedrals[i].y == expected.y);
+			resultDecode &= (heqf(result[i].x, expectedVector.x) && heqf(result[i].y, expectedVector.y) && heqf(result[i].z, expectedVector.z));
+		}
+		HTEST_ASSERT(resultEncode, name);
+		HTEST_ASSERT(resultDecode, name);
+		gtypes::Snorm10Vector3::encode(vectors, snorms, 37, 2);
+		gtypes::Snorm10Vector3::decode(snorms, result, 37);
+		resultEncode = true;
+		resultDecode = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gtypes::Snorm10Vector3 expected(vectors[i], 2);
+			resultEncode &= (snorms[i].value == expected.value);
+			resultDecode &= (result[i] == expected.toVector3());
+		}
+		HTEST_ASSERT(resultEncode, name);
+		HTEST_ASSERT(resultDecode, name);
+	}
+	gtypes::simd::setLevel(level);
+}
+
+HTEST_CASE(mortonAllLevels)
+{
+	gvec2i vectors2[37];
+	gvec3i vectors3[37];
+	gvec2i result2[37];
+	gvec3i result3[37];
+	unsigned long long keys[37];
+	for (int i = 0; i < 37; ++i)
+	{
+		vectors2[i].set(i * 123457 - 2000000, 1000000000 - i * 54321001);
+		vectors3[i].set(i * 28001 - 0x100000, 0xFFFFF - i * 9973, (i % 3) - 1);
+	}
+	gtypes::simd::Level level = gtypes::simd::getLevel();
+	for (int l = 0; l < gtypes::simd::LevelCount; ++l)
+	{
+		if (!gtypes::simd::setLevel((gtypes::simd::Level)l))
+		{
+			continue;
+		}
+		const char* name = gtypes::simd::getLevelName((gtypes::simd::Level)l);
+		gtypes::SpaceFillingCurve::encodeMorton(vectors2, keys, 37);
+		gtypes::SpaceFillingCurve::decodeMorton(keys, result2, 37);
+		bool result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			result &= (keys[i] == gtypes::SpaceFillingCurve::encodeMorton(vectors2[i]) && result2[i] == vectors2[i]);
+		}
+		HTEST_ASSERT(result, name);
+		gtypes::SpaceFillingCurve::encodeMorton(vectors3, keys, 37);
+		gtypes::SpaceFillingCurve::decodeMorton(keys, result3, 37);
+		result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			result &= (keys[i] == gtypes::SpaceFillingCurve::encodeMorton(vectors3[i]) && result3[i] == vectors3[i]);
+		}
+		HTEST_ASSERT(result, name);
+	}
+	gtypes::simd::setLevel(level);
+}
+
+HTEST_CASE(quaternionAllLevels)
+{
+	gquat a[37];
+	gquat b[37];
+	gquat product[37];
+	gvec3f vectors[37];
+	gvec3f rotated[37];
+	float factors[37];
+	gmat3 matrices3[37];
+	gmat4 matrices4[37];
+	for (int i = 0; i < 37; ++i)
+	{
+		factors[i] = (i % 11) * 0.1f;
+		a[i] = gquat::fromAxisAngle(gvec3f(1.0f, i * 0.1f, -0.5f), i * 9.0f);
+		b[i] = gquat::fromAxisAngle(gvec3f(-0.2f * i, 1.0f, 0.3f), 90.0f - i * 5.0f);
+		vectors[i].set(i * 0.5f - 9.0f, 3.0f - i * 0.25f, (i % 5) - 2.0f);
+		// every case of Shepperd's method
+		matrices3[i] = (i % 4 == 0 ? gquat::fromAxisAngle(gvec3f((i % 3) == 0, (i % 3) == 1, (i % 3) == 2), 180.0f) : b[i]).mat3();
+		matrices4[i] = a[i].mat4(vectors[i]);
+	}
+	gtypes::simd::Level level = gtypes::simd::getLevel();
+	for (int l = 0; l < gtypes::simd::LevelCount; ++l)
+	{
+		if (!gtypes::simd::setLevel((gtypes::simd::Level)l))
+		{
+			continue;
+		}
+		const char* name = gtypes::simd::getLevelName((gtypes::simd::Level)l);
+		gquat::multiply(a, b, product, 37);
+		bool result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gquat expected = a[i] * b[i];
+			result &= (heqf(product[i].x, expected.x) && heqf(product[i].y, expected.y) && heqf(product[i].z, expected.z) && heqf(product[i].w, expected.w));
+		}
+		HTEST_ASSERT(result, name);
+		gquat::slerp(a, b, factors, product, 37);
+		result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gquat expected = gquat::slerp(a[i], b[i], factors[i]);
+			result &= (heqf(product[i].x, expected.x) && heqf(product[i].y, expected.y) && heqf(product[i].z, expected.z) && heqf(product[i].w, expected.w));
+		}
+		HTEST_ASSERT(result, name);
+		gquat::nlerp(a, b, factors, product, 37);
+		result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gquat expected = gquat::nlerp(a[i], b[i], factors[i]);
+			result &= (heqf(product[i].x, expected.x) && heqf(product[i].y, expected.y) && heqf(product[i].z, expected.z) && heqf(product[i].w, expected.w));
+		}
+		HTEST_ASSERT(result, name);
+		gquat::rotate(a[7], vectors, rotated, 37);
+		result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gvec3f expected = a[7].rotate(vectors[i]);
+			result &= (heqf(rotated[i].x, expected.x) && heqf(rotated[i].y, expected.y) && heqf(rotated[i].z, expected.z));
+		}
+		HTEST_ASSERT(result, name);
+		gquat::rotate(a, vectors, rotated, 37);
+		result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gvec3f expected = a[i].rotate(vectors[i]);
+			result &= (heqf(rotated[i].x, expected.x) && heqf(rotated[i].y, expected.y) && heqf(rotated[i].z, expected.z));
+		}
+		HTEST_ASSERT(result, name);
+		gquat::fromEulerAngles(vectors, product, 37);
+		result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gquat expected = gquat::fromEulerAngles(vectors[i].x, vectors[i].y, vectors[i].z);
+			result &= (heqf(product[i].x, expected.x) && heqf(product[i].y, expected.y) && heqf(product[i].z, expected.z) && heqf(product[i].w, expected.w));
+		}
+		HTEST_ASSERT(result, name);
+		// includes the gimbal lock, where only the rotation is unique
+		product[5] = gquat::fromEulerAngles(0.5f, 1.57079633f, 0.3f);
+		product[20] = gquat::fromEulerAngles(0.5f, -1.57079633f, 0.3f);
+		gquat::toEulerAngles(product, rotated, 37);
+		result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gvec3f expected = product[i].toEulerAngles();
+			result &= (heqf(rotated[i].y, expected.y) && heqf(fabsf(gquat::fromEulerAngles(rotated[i].x, rotated[i].y, rotated[i].z).dot(product[i])), 1.0f));
+		}
+		HTEST_ASSERT(result, name);
+		gquat::fromMatrix(matrices3, product, 37);
+		result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gquat expected = gquat::fromMatrix(matrices3[i]);
+			result &= (heqf(product[i].x, expected.x) && heqf(product[i].y, expected.y) && heqf(product[i].z, expected.z) && heqf(product[i].w, expected.w));
+		}
+		HTEST_ASSERT(result, name);
+		gquat::fromMatrix(matrices4, product, 37);
+		result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			gquat expected = gquat::fromMatrix(matrices4[i]);
+			result &= (heqf(product[i].x, expected.x) && heqf(product[i].y, expected.y) && heqf(product[i].z, expected.z) && heqf(product[i].w, expected.w));
+		}
+		HTEST_ASSERT(result, name);
+		for (int mode = gtypes::QuaternionIntegrationFirstOrder; mode <= gtypes::QuaternionIntegrationExponential; ++mode)
+		{
+			for (int i = 0; i < 37; ++i)
+			{
+				product[i] = a[i];
+			}
+			gquat::integrate(product, vectors, 0.05f, 37, (gtypes::QuaternionIntegration)mode);
+			result = true;
+			for (int i = 0; i < 37; ++i)
+			{
+				gquat expected = a[i];
+				expected.integrate(vectors[i], 0.05f, (gtypes::QuaternionIntegration)mode);
+				result &= (heqf(product[i].x, expected.x) && heqf(product[i].y, expected.y) && heqf(product[i].z, expected.z) && heqf(product[i].w, expected.w));
+			}
+			HTEST_ASSERT(result, name);
+		}
+	}
+	gtypes::simd::setLevel(level);
+}
+
+HTEST_CASE(dualQuaternionAllLevels)
+{
+	gdualquat bones[5];
+	for (int i = 0; i < 5; ++i)
+	{
+		bones[i].set(gquat::fromAxisAngle(gvec3f(1.0f, i * 0.5f, -0.5f), i * 80.0f - 150.0f), gvec3f(i - 2.0f, 0.5f * i, 1.0f));
+	}
+	int indices[37 * 3];
+	float weights[37 * 3];
+	gvec3f positions[37];
+	gvec3f normals[37];
+	gvec3f expectedPositions[37];
+	gvec3f expectedNormals[37];
+	gvec3f resultPositions[37];
+	gvec3f resultNormals[37];
+	for (int i = 0; i < 37; ++i)
+	{
+		for (int j = 0; j < 3; ++j)
+		{
+			indices[i * 3 + j] = (i + j * 2) % 5;
+			weights[i * 3 + j] = ((i + j) % 4) * 0.25f;
+		}
+		positions[i].set(i * 0.5f - 9.0f, 3.0f - i * 0.25f, (i % 5) - 2.0f);
+		normals[i] = gvec3f(1.0f, i * 0.1f, -0.5f).normalized();
+	}
+	gtypes::simd::Level level = gtypes::simd::getLevel();
+	gtypes::simd::setLevel(gtypes::simd::LevelScalar);
+	gdualquat::skin(bones, indices, weights, 3, positions, normals, expectedPositions, expectedNormals, 37);
+	for (int l = 0; l < gtypes::simd::LevelCount; ++l)
+	{
+		if (!gtypes::simd::setLevel((gtypes::simd::Level)l))
+		{
+			continue;
+		}
+		const char* name = gtypes::simd::getLevelName((gtypes::simd::Level)l);
+		gdualquat::skin(bones, indices, weights, 3, positions, normals, resultPositions, resultNormals, 37);
+		bool result = true;
+		for (int i = 0; i < 37; ++i)
+		{
+			result &= (heqf(resultPositions[i].x, expectedPositions[i].x) && heqf(resultPositions[i].y, expectedPositions[i].y) && heqf(resultPositions[i].z, expectedPositions[i].z));
+			result &= (heqf(resultNormals[i].x, expectedNormals[i].x) && heqf(resultNormals[i].y, expectedNormals[i].y) && heqf(resultNormals[i].z, expectedNormals[i].z));
+		}
+		HTEST_ASSERT(result, name);
+	}
+	gtypes::simd::setLevel(level);
+}
+
+HTEST_CASE(packedQuaternionAllLevels)
+{
+	gquat quaternions[37];
+	gtypes::SmallestThree29Quaternion expected29[37];
+	gtypes::SmallestThree32Quaternion expected32[37];
+	gtypes::SmallestThree48Quaternion expected48[37];
+	gtypes::SmallestThree32Quaternion baselines[37];
+	for (int i = 0; i < 37; ++i)
+	{
+		quaternions[i] = gquat::fromAxisAngle(gvec3f(1.0f, i * 0.25f - 4.0f, (i % 3) - 1.0f), i * 37.0f - 600.0f);
+		expected29[i].set(quaternions[i]);
+		expected32[i].set(quaternions[i]);
+		expected48[i].set(quaternions[i]);
+		// every delta tag and group layout, the index changes for some
+		baselines[i] = (i % 4 == 0 ? expected32[i] : gtypes::SmallestThree32Quaternion(gquat::fromAxisAngle(gvec3f(1.0f, i * 0.25f - 4.0f, (i % 3) - 1.0f),
+			i * 37.0f - 600.0f + (i % 7) * (i % 7) * 0.6f)));
+	}
+	gtypes::SmallestThree29Quaternion packed29[37];
+	gtypes::SmallestThree32Quaternion packed32[37];
+	gtypes::SmallestThree48Quaternion packed48[37];
+	gtypes::SmallestThree32Quaternion decodedDelta[37];
+	gquat result[37];
+	unsigned char expectedBuffer[157];
+	unsigned char buffer[157];
+	gtypes::simd::Level level = gtypes::simd::getLevel();
+	gtypes::simd::setLevel(gtypes::simd::LevelScalar);
+	int expectedSize = gtypes::SmallestThree32Quaternion::encodeDelta(expected32, baselines, 37, expectedBuffer);
+	for (int l = 0; l < gtypes::simd::LevelCount; ++l)
+	{
+		if (!gtypes::simd::setLevel((gtypes::simd::Level)l))
+		{
+			continue;
+		}
+		const char* name = gtypes::simd::getLevelName((gtypes::simd::Level)l);
+		gtypes::SmallestThree29Quaternion::encode(quaternions, packed29, 37);
+		gtypes::SmallestThree32Quaternion::encode(quaternions, packed32, 37);
+		gtypes::SmallestThree48Quaternion::encode(quaternions, packed48, 37);
+		bool resultEncode = (memcmp(packed29, expected29, sizeof(packed29)) == 0 && memcmp(packed32, expected32, sizeof(packed32)) == 0 &&
+			memcmp(packed48, expected48, sizeof(packed48)) == 0);
+		HTEST_ASSERT(resultEncode, name);
+		bool resultDecode = true;
+		gtypes::SmallestThree29Quaternion::decode(packed29, result, 37);
+		for (int i = 0; i < 37; ++i)
+		{
+			gquat decoded = packed29[i].toQuaternion();
+			resultDecode &= (heqf(result[i].x, decoded.x) && heqf(result[i].y, decoded.y) && heqf(result[i].z, decoded.z) && heqf(result[i].w, decoded.w));
+		}
+		gtypes::SmallestThree32Quaternion::decode(packed32, result, 37);
+		for (int i = 0; i < 37; ++i)
+		{
+			gquat decoded = packed32[i].toQuaternion();
+			resultDecode &= (heqf(result[i].x, decoded.x) && heqf(result[i].y, decoded.y) && heqf(result[i].z, decoded.z) && heqf(result[i].w, decoded.w));
+		}
+		gtypes::SmallestThree48Quaternion::decode(packed48, result, 37);
+		for (int i = 0; i < 37; ++i)
+		{
+			gquat decoded = packed48[i].toQuaternion();
+			resultDecode &= (heqf(result[i].x, decoded.x) && heqf(result[i].y, decoded.y) && heqf(result[i].z, decoded.z) && heqf(result[i].w, decoded.w));
+		}
+		HTEST_ASSERT(resultDecode, name);
+		int size = gtypes::SmallestThree32Quaternion::encodeDelta(expected32, baselines, 37, buffer);
+		HTEST_ASSERT(size == expectedSize && memcmp(buffer, expectedBuffer, size) == 0, name);
+		// once with room behind the data and once with the exact size
+		bool resultDelta = (gtypes::SmallestThree32Quaternion::decodeDelta(buffer, (int)sizeof(buffer), baselines, decodedDelta, 37) == size &&
+			memcmp(decodedDelta, expected32, sizeof(decodedDelta)) == 0);
+		for (int i = 0; i < 37; ++i)
+		{
+			decodedDelta[i] = gtypes::SmallestThree32Quaternion();
+		}
+		resultDelta &= (gtypes::SmallestThree32Quaternion::decodeDelta(buffer, size, baselines, decodedDelta, 37) == size &&
+			memcmp(decodedDelta, expected32, sizeof(decodedDelta)) == 0);
+		resultDelta &= (gtypes::SmallestThree32Quaternion::decodeDelta(buffer, size - 1, baselines, decodedDelta, 37) == -1);
+		HTEST_ASSERT(resultDelta, name);
+	}
+	gtypes::simd::setLevel(level);
+}
+
+HTEST_SUITE_END
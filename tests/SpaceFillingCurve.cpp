@@ -0,0 +1,162 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS SpaceFillingCurve
+#include <stdlib.h>
+#include <vector>
+
+#include <htest/htest.h>
+
+#include "SpaceFillingCurve.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+static unsigned long long _random(unsigned long long& seed)
+{
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return seed;
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(morton)
+{
+	unsigned long long origin = gtypes::SpaceFillingCurve::encodeMorton(gvec2i(0, 0));
+	HTEST_ASSERT(origin == 0xC000000000000000ULL, "encodeMorton(Vector2<int>) flips the sign bits");
+	HTEST_ASSERT(gtypes::SpaceFillingCurve::encodeMorton(gvec2i(1, 0)) == origin + 1, "encodeMorton(Vector2<int>) x");
+	HTEST_ASSERT(gtypes::SpaceFillingCurve::encodeMorton(gvec2i(0, 1)) == origin + 2, "encodeMorton(Vector2<int>) y");
+	HTEST_ASSERT(gtypes::SpaceFillingCurve::encodeMorton(gvec2i(-1, -1)) < origin, "encodeMorton(Vector2<int>) negative");
+	HTEST_ASSERT(gtypes::SpaceFillingCurve::encodeMorton(gvec3i(-0x100000, -0x100000, -0x100000)) == 0, "encodeMorton(Vector3<int>) minimum");
+	HTEST_ASSERT(gtypes::SpaceFillingCurve::encodeMorton(gvec3i(0xFFFFF, 0xFFFFF, 0xFFFFF)) == 0x7FFFFFFFFFFFFFFFULL, "encodeMorton(Vector3<int>) maximum");
+	HTEST_ASSERT(gtypes::SpaceFillingCurve::encodeMorton(gvec3i(-0x100000, -0x100000, 1 - 0x100000)) == 4, "encodeMorton(Vector3<int>) z");
+	unsigned long long seed = 7;
+	bool result2 = true;
+	bool result3 = true;
+	for (int i = 0; i < 1000; ++i)
+	{
+		gvec2i vector2((int)_random(seed), (int)_random(seed));
+		result2 &= (gtypes::SpaceFillingCurve::decodeMorton2(gtypes::SpaceFillingCurve::encodeMorton(vector2)) == vector2);
+		gvec3i vector3((int)(_random(seed) % 0x200000) - 0x100000, (int)(_random(seed) % 0x200000) - 0x100000, (int)(_random(seed) % 0x200000) - 0x100000);
+		result3 &= (gtypes::SpaceFillingCurve::decodeMorton3(gtypes::SpaceFillingCurve::encodeMorton(vector3)) == vector3);
+	}
+	HTEST_ASSERT(result2, "decodeMorton2()");
+	HTEST_ASSERT(result3, "decodeMorton3()");
+}
+
+HTEST_CASE(hilbert)
+{
+	// every step along the curve moves to a neighbor cell, the first 4096 keys cover a 64x64 square or a 16x16x16 cube
+	bool adjacent2 = true;
+	bool adjacent3 = true;
+	bool roundTrip = true;
+	gvec2i previous2 = gtypes::SpaceFillingCurve::decodeHilbert2(0);
+	gvec3i previous3 = gtypes::SpaceFillingCurve::decodeHilbert3(0);
+	HTEST_ASSERT(previous2 == gvec2i(-0x7FFFFFFF - 1, -0x7FFFFFFF - 1), "decodeHilbert2(0)");
+	HTEST_ASSERT(previous3 == gvec3i(-0x100000, -0x100000, -0x100000), "decodeHilbert3(0)");
+	for (unsigned long long key = 1; key < 4096; ++key)
+	{
+		gvec2i current2 = gtypes::SpaceFillingCurve::decodeHilbert2(key);
+		gvec3i current3 = gtypes::SpaceFillingCurve::decodeHilbert3(key);
+		adjacent2 &= (abs(current2.x - previous2.x) + abs(current2.y - previous2.y) == 1);
+		adjacent2 &= (current2.x - previous2.x < 64 && current2.y - previous2.y < 64);
+		adjacent3 &= (abs(current3.x - previous3.x) + abs(current3.y - previous3.y) + abs(current3.z - previous3.z) == 1);
+		roundTrip &= (gtypes::SpaceFillingCurve::encodeHilbert(current2) == key && gtypes::SpaceFillingCurve::encodeHilbert(current3) == key);
+		previous2 = current2;
+		previous3 = current3;
+	}
+	HTEST_ASSERT(adjacent2, "2D curve is continuous");
+	HTEST_ASSERT(adjacent3, "3D curve is continuous");
+	HTEST_ASSERT(roundTrip, "encodeHilbert()");
+	unsigned long long seed = 11;
+	bool result2 = true;
+	bool result3 = true;
+	for (int i = 0; i < 1000; ++i)
+	{
+		gvec2i vector2((int)_random(seed), (int)_random(seed));
+		result2 &= (gtypes::SpaceFillingCurve::decodeHilbert2(gtypes::SpaceFillingCurve::encodeHilbert(vector2)) == vector2);
+		gvec3i vector3((int)(_random(seed) % 0x200000) - 0x100000, (int)(_random(seed) % 0x200000) - 0x100000, (int)(_random(seed) % 0x200000) - 0x100000);
+		result3 &= (gtypes::SpaceFillingCurve::decodeHilbert3(gtypes::SpaceFillingCurve::encodeHilbert(vector3)) == vector3);
+	}
+	HTEST_ASSERT(result2, "decodeHilbert2()");
+	HTEST_ASSERT(result3, "decodeHilbert3()");
+}
+
+HTEST_CASE(sortKeys)
+{
+	// more than one thread's worth of keys, with few distinct high bits so equal keys test the stability
+	const int count = 200003;
+	std::vector<unsigned long long> keys(count);
+	unsigned long long seed = 3;
+	for (int i = 0; i < count; ++i)
+	{
+		keys[i] = (_random(seed) % 5000) << 40 | (_random(seed) & 0xFF);
+	}
+	for (int threadCount = 1; threadCount <= 4; threadCount += 3)
+	{
+		std::vector<int> permutation(count, -1);
+		gtypes::SpaceFillingCurve::sortKeys(&keys[0], count, &permutation[0], threadCount);
+		std::vector<bool> used(count, false);
+		bool result = true;
+		for (int i = 0; i < count; ++i)
+		{
+			result &= (permutation[i] >= 0 && permutation[i] < count && !used[permutation[i]]);
+			if (result)
+			{
+				used[permutation[i]] = true;
+			}
+			if (i > 0 && result)
+			{
+				result &= (keys[permutation[i - 1]] < keys[permutation[i]] || (keys[permutation[i - 1]] == keys[permutation[i]] && permutation[i - 1] < permutation[i]));
+			}
+		}
+		HTEST_ASSERT(result, "sorted and stable");
+	}
+	int permutation[3] = { -1, -1, -1 };
+	unsigned long long equal[3] = { 5, 5, 5 };
+	gtypes::SpaceFillingCurve::sortKeys(equal, 3, permutation, 0);
+	HTEST_ASSERT(permutation[0] == 0 && permutation[1] == 1 && permutation[2] == 2, "equal keys");
+}
+
+HTEST_CASE(reorderByLocality)
+{
+	// a shuffled 64x64 grid of points
+	std::vector<gvec2f> positions;
+	for (int i = 0; i < 4096; ++i)
+	{
+		positions.push_back(gvec2f((float)(i % 64), (float)(i / 64)));
+	}
+	unsigned long long seed = 5;
+	for (int i = (int)positions.size() - 1; i > 0; --i)
+	{
+		std::swap(positions[i], positions[(int)(_random(seed) % (unsigned long long)(i + 1))]);
+	}
+	std::vector<gvec2f> original = positions;
+	std::vector<int> permutation;
+	gtypes::SpaceFillingCurve::reorderByLocality(&positions[0], (int)positions.size(), permutation, gtypes::SpaceFillingCurve::CurveHilbert);
+	HTEST_ASSERT(permutation.size() == positions.size(), "permutation size");
+	bool result = true;
+	for (int i = 0; i < (int)positions.size(); ++i)
+	{
+		result &= (positions[i] == original[permutation[i]]);
+		if (i > 0)
+		{
+			result &= ((positions[i] - positions[i - 1]).squaredLength() == 1.0f);
+		}
+	}
+	HTEST_ASSERT(result, "Hilbert order walks the grid cell by cell");
+	gtypes::SpaceFillingCurve::reorderByLocality(&positions[0], (int)positions.size(), permutation);
+	HTEST_ASSERT(positions[0] == gvec2f(0.0f, 0.0f) && positions[1] == gvec2f(1.0f, 0.0f) && positions[2] == gvec2f(0.0f, 1.0f), "Morton order");
+	std::vector<int> values(permutation.size());
+	for (int i = 0; i < (int)values.size(); ++i)
+	{
+		values[i] = i * 3;
+	}
+	gtypes::SpaceFillingCurve::permute(&values[0], &permutation[0], (int)values.size());
+	HTEST_ASSERT(values[10] == permutation[10] * 3, "permute()");
+	std::vector<gvec3i> cells;
+	cells.push_back(gvec3i(1000000000, 0, 0));
+	cells.push_back(gvec3i(-1000000000, 0, 0));
+	cells.push_back(gvec3i(0, 5, 0));
+	gtypes::SpaceFillingCurve::reorderByLocality(&cells[0], (int)cells.size(), permutation);
+	HTEST_ASSERT(cells[0].x == -1000000000 && cells[2].x == 1000000000, "large int ranges are scaled down");
+}
+
+HTEST_SUITE_END
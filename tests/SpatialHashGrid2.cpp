@@ -0,0 +1,123 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS SpatialHashGrid2
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <htest/htest.h>
+
+#include "SpatialHashGrid2.h"
+#include "Vector2.h"
+
+static std::vector<gvec2f> _createPositions(int count)
+{
+	std::vector<gvec2f> result;
+	unsigned int seed = 12345;
+	for (int i = 0; i < count; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		float x = (float)((seed >> 8) % 10000) * 0.01f - 50.0f;
+		seed = seed * 1103515245 + 12345;
+		float y = (float)((seed >> 8) % 10000) * 0.01f - 50.0f;
+		result.push_back(gvec2f(x, y));
+	}
+	return result;
+}
+
+static std::vector<int> _findInCircle(const std::vector<gvec2f>& positions, cgvec2f center, float radius)
+{
+	std::vector<int> result;
+	for (int i = 0; i < (int)positions.size(); ++i)
+	{
+		if (positions[i].isInCircle(center, radius))
+		{
+			result.push_back(i);
+		}
+	}
+	return result;
+}
+
+static bool _checkQueries(const gtypes::SpatialHashGrid2& grid, const std::vector<gvec2f>& positions)
+{
+	std::vector<int> result;
+	std::vector<int> expected;
+	for (int i = 0; i < 40; ++i)
+	{
+		gvec2f center = positions[i * 7];
+		float radius = 0.5f + i * 0.4f;
+		grid.findInCircle(center, radius, result);
+		std::sort(result.begin(), result.end());
+		expected = _findInCircle(positions, center, radius);
+		if (result != expected)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(findInCircle)
+{
+	std::vector<gvec2f> positions = _createPositions(2000);
+	gtypes::SpatialHashGrid2 grid(2.5f);
+	grid.rebuild(positions);
+	HTEST_ASSERT(grid.getCount() == 2000, "rebuild()");
+	HTEST_ASSERT(_checkQueries(grid, positions), "findInCircle()");
+	// a tiny table makes many cells share entries
+	gtypes::SpatialHashGrid2 smallGrid(2.5f, 16);
+	smallGrid.rebuild(positions);
+	HTEST_ASSERT(_checkQueries(smallGrid, positions), "findInCircle() with shared table entries");
+	std::vector<int> result;
+	grid.findInCircle(gvec2f(0.0f, 0.0f), 1000.0f, result);
+	HTEST_ASSERT(result.size() == 2000, "findInCircle() covering everything");
+	grid.findInCircle(gvec2f(500.0f, 500.0f), 1.0f, result);
+	HTEST_ASSERT(result.size() == 0, "findInCircle() outside");
+}
+
+HTEST_CASE(candidates)
+{
+	std::vector<gvec2f> positions = _createPositions(1000);
+	gtypes::SpatialHashGrid2 grid(4.0f);
+	grid.rebuild(positions);
+	int candidates[1000];
+	int count = grid.findCandidates(gvec2f(1.0f, -2.0f), 5.0f, candidates, 1000);
+	std::vector<int> expected = _findInCircle(positions, gvec2f(1.0f, -2.0f), 5.0f);
+	HTEST_ASSERT(count >= (int)expected.size(), "findCandidates()");
+	count = gtypes::SpatialHashGrid2::filterInCircle(&positions[0], candidates, count, gvec2f(1.0f, -2.0f), 5.0f, candidates);
+	std::sort(candidates, candidates + count);
+	HTEST_ASSERT(std::vector<int>(candidates, candidates + count) == expected, "filterInCircle()");
+	int buffer[4];
+	HTEST_ASSERT(grid.findInCircle(gvec2f(1.0f, -2.0f), 5.0f, buffer, 4) == (int)expected.size(), "findInCircle() with small buffer");
+}
+
+HTEST_CASE(extremes)
+{
+	std::vector<gvec2f> positions = _createPositions(500);
+	positions.push_back(gvec2f(1.0e20f, -1.0e20f));
+	gtypes::SpatialHashGrid2 grid(0.001f);
+	grid.rebuild(positions);
+	std::vector<int> result;
+	grid.findInCircle(gvec2f(0.0f, 0.0f), 1.0e30f, result);
+	HTEST_ASSERT(result.size() == 501, "findInCircle() with a radius beyond the int range of cells");
+	grid.findInCircle(gvec2f(0.0f, 0.0f), std::numeric_limits<float>::infinity(), result);
+	HTEST_ASSERT(result.size() == 501, "findInCircle() with an infinite radius");
+	grid.findInCircle(gvec2f(1.0e20f, -1.0e20f), 1.0f, result);
+	HTEST_ASSERT(result.size() == 1 && result[0] == 500, "findInCircle() far outside the int range of cells");
+}
+
+HTEST_CASE(clear)
+{
+	gtypes::SpatialHashGrid2 grid(1.0f);
+	std::vector<gvec2f> positions = _createPositions(10);
+	grid.rebuild(positions);
+	grid.clear();
+	std::vector<int> result;
+	grid.findInCircle(gvec2f(0.0f, 0.0f), 100.0f, result);
+	HTEST_ASSERT(grid.getCount() == 0 && result.size() == 0, "clear()");
+	grid.rebuild(NULL, 0);
+	HTEST_ASSERT(grid.getCount() == 0, "rebuild() without points");
+}
+
+HTEST_SUITE_END
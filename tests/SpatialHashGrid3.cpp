@@ -0,0 +1,125 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS SpatialHashGrid3
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <htest/htest.h>
+
+#include "SpatialHashGrid3.h"
+#include "Vector3.h"
+
+static std::vector<gvec3f> _createPositions(int count)
+{
+	std::vector<gvec3f> result;
+	unsigned int seed = 12345;
+	for (int i = 0; i < count; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		float x = (float)((seed >> 8) % 10000) * 0.01f - 50.0f;
+		seed = seed * 1103515245 + 12345;
+		float y = (float)((seed >> 8) % 10000) * 0.01f - 50.0f;
+		seed = seed * 1103515245 + 12345;
+		float z = (float)((seed >> 8) % 10000) * 0.002f - 10.0f;
+		result.push_back(gvec3f(x, y, z));
+	}
+	return result;
+}
+
+static std::vector<int> _findInSphere(const std::vector<gvec3f>& positions, cgvec3f center, float radius)
+{
+	std::vector<int> result;
+	for (int i = 0; i < (int)positions.size(); ++i)
+	{
+		if ((positions[i] - center).squaredLength() <= radius * radius)
+		{
+			result.push_back(i);
+		}
+	}
+	return result;
+}
+
+static bool _checkQueries(const gtypes::SpatialHashGrid3& grid, const std::vector<gvec3f>& positions)
+{
+	std::vector<int> result;
+	std::vector<int> expected;
+	for (int i = 0; i < 40; ++i)
+	{
+		gvec3f center = positions[i * 7];
+		float radius = 0.5f + i * 0.4f;
+		grid.findInSphere(center, radius, result);
+		std::sort(result.begin(), result.end());
+		expected = _findInSphere(positions, center, radius);
+		if (result != expected)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(findInSphere)
+{
+	std::vector<gvec3f> positions = _createPositions(2000);
+	gtypes::SpatialHashGrid3 grid(2.5f);
+	grid.rebuild(positions);
+	HTEST_ASSERT(grid.getCount() == 2000, "rebuild()");
+	HTEST_ASSERT(_checkQueries(grid, positions), "findInSphere()");
+	// a tiny table makes many cells share entries
+	gtypes::SpatialHashGrid3 smallGrid(2.5f, 16);
+	smallGrid.rebuild(positions);
+	HTEST_ASSERT(_checkQueries(smallGrid, positions), "findInSphere() with shared table entries");
+	std::vector<int> result;
+	grid.findInSphere(gvec3f(0.0f, 0.0f, 0.0f), 1000.0f, result);
+	HTEST_ASSERT(result.size() == 2000, "findInSphere() covering everything");
+	grid.findInSphere(gvec3f(500.0f, 500.0f, 0.0f), 1.0f, result);
+	HTEST_ASSERT(result.size() == 0, "findInSphere() outside");
+}
+
+HTEST_CASE(candidates)
+{
+	std::vector<gvec3f> positions = _createPositions(1000);
+	gtypes::SpatialHashGrid3 grid(4.0f);
+	grid.rebuild(positions);
+	int candidates[1000];
+	int count = grid.findCandidates(gvec3f(1.0f, -2.0f, 3.0f), 5.0f, candidates, 1000);
+	std::vector<int> expected = _findInSphere(positions, gvec3f(1.0f, -2.0f, 3.0f), 5.0f);
+	HTEST_ASSERT(count >= (int)expected.size(), "findCandidates()");
+	count = gtypes::SpatialHashGrid3::filterInSphere(&positions[0], candidates, count, gvec3f(1.0f, -2.0f, 3.0f), 5.0f, candidates);
+	std::sort(candidates, candidates + count);
+	HTEST_ASSERT(std::vector<int>(candidates, candidates + count) == expected, "filterInSphere()");
+	int buffer[4];
+	HTEST_ASSERT(grid.findInSphere(gvec3f(1.0f, -2.0f, 3.0f), 5.0f, buffer, 4) == (int)expected.size(), "findInSphere() with small buffer");
+}
+
+HTEST_CASE(extremes)
+{
+	std::vector<gvec3f> positions = _createPositions(500);
+	positions.push_back(gvec3f(1.0e20f, -1.0e20f, 1.0e20f));
+	gtypes::SpatialHashGrid3 grid(0.001f);
+	grid.rebuild(positions);
+	std::vector<int> result;
+	grid.findInSphere(gvec3f(0.0f, 0.0f, 0.0f), 1.0e30f, result);
+	HTEST_ASSERT(result.size() == 501, "findInSphere() with a radius beyond the int range of cells");
+	grid.findInSphere(gvec3f(0.0f, 0.0f, 0.0f), std::numeric_limits<float>::infinity(), result);
+	HTEST_ASSERT(result.size() == 501, "findInSphere() with an infinite radius");
+	grid.findInSphere(gvec3f(1.0e20f, -1.0e20f, 1.0e20f), 1.0f, result);
+	HTEST_ASSERT(result.size() == 1 && result[0] == 500, "findInSphere() far outside the int range of cells");
+}
+
+HTEST_CASE(clear)
+{
+	gtypes::SpatialHashGrid3 grid(1.0f);
+	std::vector<gvec3f> positions = _createPositions(10);
+	grid.rebuild(positions);
+	grid.clear();
+	std::vector<int> result;
+	grid.findInSphere(gvec3f(0.0f, 0.0f, 0.0f), 100.0f, result);
+	HTEST_ASSERT(grid.getCount() == 0 && result.size() == 0, "clear()");
+	grid.rebuild(NULL, 0);
+	HTEST_ASSERT(grid.getCount() == 0, "rebuild() without points");
+}
+
+HTEST_SUITE_END
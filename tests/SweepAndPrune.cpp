@@ -0,0 +1,211 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS SweepAndPrune
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <htest/htest.h>
+
+#include "Rectangle.h"
+#include "SweepAndPrune.h"
+
+#include "RectangleFixture.h"
+
+typedef std::set<std::pair<int, int> > _PairSet;
+
+static _PairSet _toSet(const std::vector<gtypes::SweepAndPrune::Pair>& pairs)
+{
+	_PairSet result;
+	for (unsigned int i = 0; i < pairs.size(); ++i)
+	{
+		result.insert(std::make_pair(pairs[i].first, pairs[i].second));
+	}
+	return result;
+}
+
+// brute force over the valid ids
+static _PairSet _findPairs(const gtypes::SweepAndPrune& broadphase, int idCount)
+{
+	_PairSet result;
+	for (int i = 0; i < idCount; ++i)
+	{
+		for (int j = i + 1; j < idCount; ++j)
+		{
+			if (broadphase.isValid(i) && broadphase.isValid(j) && broadphase.getRectangle(i).intersects(broadphase.getRectangle(j)))
+			{
+				result.insert(std::make_pair(i, j));
+			}
+		}
+	}
+	return result;
+}
+
+// applies reported changes to a tracked set, fails if a change does not fit the set
+static bool _applyChanges(_PairSet& pairs, const std::vector<gtypes::SweepAndPrune::Pair>& added, const std::vector<gtypes::SweepAndPrune::Pair>& removed)
+{
+	for (unsigned int i = 0; i < removed.size(); ++i)
+	{
+		if (pairs.erase(std::make_pair(removed[i].first, removed[i].second)) == 0)
+		{
+			return false;
+		}
+	}
+	for (unsigned int i = 0; i < added.size(); ++i)
+	{
+		if (added[i].first >= added[i].second || !pairs.insert(std::make_pair(added[i].first, added[i].second)).second)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(pairs)
+{
+	gtypes::SweepAndPrune broadphase;
+	std::vector<gtypes::SweepAndPrune::Pair> added;
+	std::vector<gtypes::SweepAndPrune::Pair> removed;
+	int a = broadphase.insert(grectf(0.0f, 0.0f, 10.0f, 10.0f));
+	int b = broadphase.insert(grectf(5.0f, 5.0f, 10.0f, 10.0f));
+	int c = broadphase.insert(grectf(10.0f, 0.0f, 10.0f, 6.0f));
+	HTEST_ASSERT(broadphase.getCount() == 3 && broadphase.getPairCount() == 0, "insert() takes effect with update()");
+	broadphase.update(added, removed);
+	HTEST_ASSERT(added.size() == 2 && removed.size() == 0 && broadphase.getPairCount() == 2, "update() after insert()");
+	HTEST_ASSERT(broadphase.isOverlapping(a, b) && broadphase.isOverlapping(c, b) && !broadphase.isOverlapping(a, c), "isOverlapping() with touching edges");
+	broadphase.move(a, grectf(-20.0f, 0.0f, 10.0f, 10.0f));
+	broadphase.update(added, removed);
+	HTEST_ASSERT(added.size() == 0 && removed.size() == 1 && removed[0].first == a && removed[0].second == b, "update() after move()");
+	broadphase.move(a, grectf(12.0f, 1.0f, 1.0f, 1.0f));
+	broadphase.update(added, removed);
+	std::vector<gtypes::SweepAndPrune::Pair> pairs;
+	broadphase.getPairs(pairs);
+	HTEST_ASSERT(added.size() == 1 && removed.size() == 0 && _toSet(pairs) == _findPairs(broadphase, 3), "update() after a jump over other Rectangles");
+	HTEST_ASSERT(broadphase.remove(b) && !broadphase.remove(b) && !broadphase.isValid(b) && broadphase.getCount() == 2, "remove()");
+	int d = broadphase.insert(grectf(0.0f, 0.0f, 100.0f, 100.0f));
+	HTEST_ASSERT(d != b, "remove() keeps the id until update()");
+	broadphase.update(added, removed);
+	HTEST_ASSERT(removed.size() == 1 && added.size() == 2 && broadphase.getPairCount() == 3, "update() after remove() and insert()");
+	HTEST_ASSERT(broadphase.insert(grectf()) == b, "insert() reuses ids");
+	broadphase.clear();
+	HTEST_ASSERT(broadphase.getCount() == 0 && broadphase.getPairCount() == 0, "clear()");
+}
+
+HTEST_CASE(update)
+{
+	unsigned int seed = 42;
+	gtypes::SweepAndPrune broadphase;
+	std::vector<grectf> velocities;
+	std::vector<gtypes::SweepAndPrune::Pair> added;
+	std::vector<gtypes::SweepAndPrune::Pair> removed;
+	_PairSet tracked;
+	bool resultChanges = true;
+	bool resultPairs = true;
+	int idCount = 0;
+	for (int i = 0; i < 1000; ++i)
+	{
+		broadphase.insert(grectf(_randomFloat(seed, 0.0f, 200.0f), _randomFloat(seed, 0.0f, 200.0f), _randomFloat(seed, 0.0f, 8.0f), _randomFloat(seed, 0.0f, 8.0f)));
+		velocities.push_back(grectf(_randomFloat(seed, -1.0f, 1.0f), _randomFloat(seed, -1.0f, 1.0f), 0.0f, 0.0f));
+	}
+	idCount = 1000;
+	for (int step = 0; step < 40; ++step)
+	{
+		for (int i = 0; i < idCount; ++i)
+		{
+			if (!broadphase.isValid(i))
+			{
+				continue;
+			}
+			grectf rectangle = broadphase.getRectangle(i);
+			// mostly small movements on a grid so that edges often end up on the same positions, some teleports
+			if (_random(seed) % 100 == 0)
+			{
+				rectangle.x = (float)(int)_randomFloat(seed, 0.0f, 200.0f);
+			}
+			else
+			{
+				rectangle.x = (float)(int)(rectangle.x + velocities[i].x * 2.0f);
+				rectangle.y = (float)(int)(rectangle.y + velocities[i].y * 2.0f);
+			}
+			broadphase.move(i, rectangle);
+		}
+		for (int i = 0; i < 10; ++i)
+		{
+			broadphase.remove((int)(_random(seed) % idCount));
+			int id = broadphase.insert(grectf(_randomFloat(seed, 0.0f, 200.0f), _randomFloat(seed, 0.0f, 200.0f), 4.0f, 0.0f));
+			idCount = std::max(idCount, id + 1);
+		}
+		broadphase.update(added, removed);
+		resultChanges &= _applyChanges(tracked, added, removed);
+		resultPairs &= (tracked == _findPairs(broadphase, idCount));
+	}
+	HTEST_ASSERT(resultChanges, "update() reports consistent changes");
+	HTEST_ASSERT(resultPairs, "update() finds all pairs");
+	std::vector<gtypes::SweepAndPrune::Pair> pairs;
+	broadphase.getPairs(pairs);
+	HTEST_ASSERT(_toSet(pairs) == tracked && (int)pairs.size() == broadphase.getPairCount(), "getPairs()");
+	broadphase.rebuild(added, removed);
+	HTEST_ASSERT(added.size() == 0 && removed.size() == 0, "rebuild() after update() finds the same pairs");
+}
+
+HTEST_CASE(rebuild)
+{
+	unsigned int seed = 7;
+	gtypes::SweepAndPrune broadphase;
+	std::vector<gtypes::SweepAndPrune::Pair> added;
+	std::vector<gtypes::SweepAndPrune::Pair> removed;
+	for (int i = 0; i < 1000; ++i)
+	{
+		broadphase.insert(grectf(_randomFloat(seed, -100.0f, 100.0f), _randomFloat(seed, -100.0f, 100.0f), _randomFloat(seed, 0.0f, 10.0f), _randomFloat(seed, 0.0f, 10.0f)));
+	}
+	broadphase.rebuild(added, removed);
+	_PairSet tracked = _toSet(added);
+	HTEST_ASSERT(removed.size() == 0 && tracked == _findPairs(broadphase, 1000), "rebuild() after insert()");
+	// teleport everything, then the reported changes have to lead to the new pairs
+	for (int i = 0; i < 1000; ++i)
+	{
+		broadphase.move(i, grectf(_randomFloat(seed, -100.0f, 100.0f), _randomFloat(seed, -100.0f, 100.0f), 6.0f, 6.0f));
+	}
+	broadphase.remove(3);
+	broadphase.rebuild(added, removed, 4);
+	HTEST_ASSERT(_applyChanges(tracked, added, removed) && tracked == _findPairs(broadphase, 1000), "rebuild() after teleports");
+	broadphase.update(added, removed);
+	HTEST_ASSERT(added.size() == 0 && removed.size() == 0, "update() after rebuild()");
+}
+
+HTEST_CASE(coherent)
+{
+	// 50k Rectangles moving a little per step, rebuild() checks the incremental result
+	unsigned int seed = 1;
+	gtypes::SweepAndPrune broadphase;
+	std::vector<gtypes::SweepAndPrune::Pair> added;
+	std::vector<gtypes::SweepAndPrune::Pair> removed;
+	std::vector<float> velocities;
+	for (int i = 0; i < 50000; ++i)
+	{
+		broadphase.insert(grectf(_randomFloat(seed, 0.0f, 2000.0f), _randomFloat(seed, 0.0f, 2000.0f), _randomFloat(seed, 1.0f, 10.0f), _randomFloat(seed, 1.0f, 10.0f)));
+		velocities.push_back(_randomFloat(seed, -0.5f, 0.5f));
+	}
+	broadphase.rebuild(added, removed, 4);
+	_PairSet tracked = _toSet(added);
+	bool resultChanges = true;
+	for (int step = 0; step < 10; ++step)
+	{
+		for (int i = 0; i < 50000; ++i)
+		{
+			grectf rectangle = broadphase.getRectangle(i);
+			rectangle.x += velocities[i];
+			rectangle.y -= velocities[i];
+			broadphase.move(i, rectangle);
+		}
+		broadphase.update(added, removed);
+		resultChanges &= _applyChanges(tracked, added, removed);
+	}
+	HTEST_ASSERT(resultChanges && (int)tracked.size() == broadphase.getPairCount(), "update() of 50k Rectangles reports consistent changes");
+	broadphase.rebuild(added, removed, 4);
+	HTEST_ASSERT(added.size() == 0 && removed.size() == 0, "update() of 50k Rectangles finds the same pairs as rebuild()");
+}
+
+HTEST_SUITE_END
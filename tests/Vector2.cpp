@@ -4,6 +4,10 @@
 
 #include "Vector2.h"
 
+#ifdef GTYPES_STD_HASH
+#include <unordered_set>
+#endif
+
 #define E_TOLRANCE 0.0001f
 
 //static float _habs(float value)
@@ -62,6 +66,38 @@ HTEST_CASE(angle)
 	HTEST_ASSERT(v.angle() == 0, "");
 }
 
+HTEST_CASE(angleFast)
+{
+	bool result = true;
+	gvec2f v;
+	for (int i = 0; i < 720; ++i)
+	{
+		v.set(cosf(i * 0.5f) * (i + 1), sinf(i * 0.5f) * (i + 1));
+		result &= (fabsf(v.angleFast() - v.angle()) < 0.00015f);
+	}
+	HTEST_ASSERT(result, "");
+	HTEST_ASSERT(gvec2f(1.0f, 0.0f).angleFast() == 0.0f, "");
+	HTEST_ASSERT(heqf(gvec2f(0.0f, -1.0f).angleFast(), 90.0f), "");
+	HTEST_ASSERT(heqf(gvec2f(-1.0f, 0.0f).angleFast(), gvec2f(-1.0f, 0.0f).angle()), "");
+	HTEST_ASSERT(gvec2f(0.0f, 0.0f).angleFast() == 0.0f, "");
+}
+
+HTEST_CASE(inCircle)
+{
+	gvec2f points[5] = { gvec2f(1.0f, 0.0f), gvec2f(2.0f, 2.0f), gvec2f(0.0f, -2.0f), gvec2f(0.5f, 0.5f), gvec2f(-3.0f, 0.0f) };
+	unsigned int mask = 0xFFFFFFFF;
+	gvec2f::maskInCircle(points, 5, gvec2f(0.0f, 0.0f), 2.0f, &mask);
+	HTEST_ASSERT(mask == 0xD, "maskInCircle()");
+	int result[5];
+	HTEST_ASSERT(gvec2f::findInCircle(points, 5, gvec2f(0.0f, 0.0f), 2.0f, result) == 3 && result[0] == 0 && result[1] == 2 && result[2] == 3, "findInCircle()");
+	float x[3] = { 0.0f, 5.0f, 1.0f };
+	float y[3] = { 0.0f, 5.0f, 1.0f };
+	HTEST_ASSERT(gvec2f::findInCircle(x, y, 3, gvec2f(1.0f, 1.0f), 1.5f, result) == 2 && result[0] == 0 && result[1] == 2, "findInCircle(float*, float*)");
+	gvec2i pointsInt[2] = { gvec2i(1, 1), gvec2i(3, 0) };
+	gvec2i::maskInCircle(pointsInt, 2, gvec2i(0, 0), 2.0f, &mask);
+	HTEST_ASSERT(mask == 0x1, "maskInCircle() with int");
+}
+
 HTEST_CASE(normalize)
 {
 	gvec2f v1(2, 0);
@@ -204,4 +240,56 @@ HTEST_CASE(notEqual)
 	HTEST_ASSERT(v1 != v2, "");
 }
 
+HTEST_CASE(normalizeFast)
+{
+	gvec2f v1(2, 0);
+	gvec2f v2(1, 0);
+	HTEST_ASSERT(vec2eqf(v1.normalizedFast(), v2), "normalizedFast()");
+	v1.normalizeFast();
+	HTEST_ASSERT(vec2eqf(v1, v2), "normalizeFast()");
+	gvec2f vectors[6];
+	for (int i = 0; i < 6; ++i)
+	{
+		vectors[i].set(i + 1.0f, -3.0f * i);
+	}
+	vectors[2].set(0.0f, 0.0f);
+	gvec2f::normalizeFast(vectors, 6);
+	for (int i = 0; i < 6; ++i)
+	{
+		if (i == 2)
+		{
+			HTEST_ASSERT(vectors[i].isNull(), "zero-length");
+		}
+		else
+		{
+			HTEST_ASSERT(vec2eqf(vectors[i], gvec2f(i + 1.0f, -3.0f * i).normalized()), "batch");
+		}
+	}
+}
+
+HTEST_CASE(integer)
+{
+	gvec2i v(3, 4);
+	HTEST_ASSERT(v.length() == 5.0f, "length()");
+	HTEST_ASSERT(gvec2i(0, -1).angle() == 90.0f, "angle()");
+	v.set(10, 0);
+	v.rotate(90.0f);
+	HTEST_ASSERT(v.x == 0 && v.y == 10, "rotate()");
+}
+
+#ifdef GTYPES_STD_HASH
+HTEST_CASE(hash)
+{
+	std::hash<gvec2f> hasher;
+	HTEST_ASSERT(hasher(gvec2f(1.0f, 2.0f)) == hasher(gvec2f(1.0f, 2.0f)), "equal hashes");
+	HTEST_ASSERT(hasher(gvec2f(0.0f, 1.0f)) == hasher(gvec2f(-0.0f, 1.0f)), "0 and -0");
+	HTEST_ASSERT(hasher(gvec2f(1.0f, 2.0f)) != hasher(gvec2f(2.0f, 1.0f)), "component order");
+	std::unordered_set<gvec2i> set;
+	set.insert(gvec2i(1, 2));
+	set.insert(gvec2i(2, 1));
+	set.insert(gvec2i(1, 2));
+	HTEST_ASSERT(set.size() == 2 && set.count(gvec2i(2, 1)) == 1, "unordered_set");
+}
+#endif
+
 HTEST_SUITE_END
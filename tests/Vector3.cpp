@@ -183,4 +183,31 @@ HTEST_CASE(notEqual)
 	HTEST_ASSERT(v1 != v2, "");
 }
 
+HTEST_CASE(normalizeFast)
+{
+	gvec3f v1(2.0f, 0.0f, 0.0f);
+	gvec3f v2(1.0f, 0.0f, 0.0f);
+	HTEST_ASSERT(vec3eqf(v1.normalizedFast(), v2), "normalizedFast()");
+	v1.normalizeFast();
+	HTEST_ASSERT(vec3eqf(v1, v2), "normalizeFast()");
+	gvec3f vectors[7];
+	for (int i = 0; i < 7; ++i)
+	{
+		vectors[i].set(i + 1.0f, -2.0f * i, 0.5f);
+	}
+	vectors[5].set(0.0f, 0.0f, 0.0f);
+	gvec3f::normalizeFast(vectors, 7);
+	for (int i = 0; i < 7; ++i)
+	{
+		if (i == 5)
+		{
+			HTEST_ASSERT(vectors[i].isNull(), "zero-length");
+		}
+		else
+		{
+			HTEST_ASSERT(vec3eqf(vectors[i], gvec3f(i + 1.0f, -2.0f * i, 0.5f).normalized()), "batch");
+		}
+	}
+}
+
 HTEST_SUITE_END
@@ -0,0 +1,108 @@
+#define _HTEST_LIB gtypes
+#define _HTEST_CLASS Vector4
+#include <htest/htest.h>
+
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+#define E_TOLRANCE 0.0001f
+
+static bool vec4eqf(const gvec4f& v1, const gvec4f& v2)
+{
+	return (heqf(v1.x, v2.x) && heqf(v1.y, v2.y) && heqf(v1.z, v2.z) && heqf(v1.w, v2.w));
+}
+
+HTEST_SUITE_BEGIN
+
+HTEST_CASE(assignment)
+{
+	gvec4f v(1.0f, 2.0f, 3.0f, 4.0f);
+	HTEST_ASSERT(v.x == 1.0f && v.y == 2.0f && v.z == 3.0f && v.w == 4.0f, "constructor assignment");
+	v.set(2.0f, 3.0f, 4.0f, 5.0f);
+	HTEST_ASSERT(v.x == 2.0f && v.y == 3.0f && v.z == 4.0f && v.w == 5.0f, "set()");
+	v.set(gvec3f(1.0f, 2.0f, 3.0f), 1.0f);
+	HTEST_ASSERT(v.x == 1.0f && v.y == 2.0f && v.z == 3.0f && v.w == 1.0f, "set(gvec3f, float)");
+	HTEST_ASSERT(sizeof(gvec4f) == 16, "size");
+}
+
+HTEST_CASE(arithmetic)
+{
+	gvec4f v1(1.0f, 2.0f, 3.0f, 4.0f), v2(2.0f, 4.0f, 6.0f, 8.0f);
+	HTEST_ASSERT(v1 + v2 == gvec4f(3.0f, 6.0f, 9.0f, 12.0f), "addition");
+	HTEST_ASSERT(v2 - v1 == v1, "substraction");
+	HTEST_ASSERT(v1 * v2 == gvec4f(2.0f, 8.0f, 18.0f, 32.0f), "multiplication");
+	HTEST_ASSERT(v2 / v1 == gvec4f(2.0f, 2.0f, 2.0f, 2.0f), "division");
+	HTEST_ASSERT(v1 * 2.0f == v2, "multiplication factor");
+	HTEST_ASSERT(v2 / 2.0f == v1, "division factor");
+	HTEST_ASSERT(-v1 == gvec4f(-1.0f, -2.0f, -3.0f, -4.0f), "negation");
+	v1 += v1;
+	HTEST_ASSERT(v1 == v2, "addition assign");
+	gvec4i vi(1, 2, 3, 4);
+	HTEST_ASSERT(vi * 2 == gvec4i(2, 4, 6, 8), "int");
+}
+
+HTEST_CASE(dot)
+{
+	gvec4f v1(1.0f, 2.0f, 3.0f, 4.0f), v2(4.0f, 3.0f, 2.0f, 1.0f);
+	HTEST_ASSERT(v1.dot(v2) == 20.0f, "");
+	HTEST_ASSERT(v1.squaredLength() == 30.0f, "squaredLength");
+	HTEST_ASSERT(gvec4f(0.0f, 3.0f, 0.0f, 4.0f).length() == 5.0f, "length");
+}
+
+HTEST_CASE(normalize)
+{
+	gvec4f v(0.0f, 3.0f, 0.0f, 4.0f);
+	HTEST_ASSERT(vec4eqf(v.normalized(), gvec4f(0.0f, 0.6f, 0.0f, 0.8f)), "");
+}
+
+HTEST_CASE(minMax)
+{
+	gvec4f v1(1.0f, 5.0f, 3.0f, -4.0f), v2(2.0f, 4.0f, 3.0f, 8.0f);
+	HTEST_ASSERT(v1.componentMin(v2) == gvec4f(1.0f, 4.0f, 3.0f, -4.0f), "componentMin");
+	HTEST_ASSERT(v1.componentMax(v2) == gvec4f(2.0f, 5.0f, 3.0f, 8.0f), "componentMax");
+}
+
+HTEST_CASE(swizzle)
+{
+	gvec4f v(1.0f, 2.0f, 3.0f, 4.0f);
+	HTEST_ASSERT((v.swizzled<3, 2, 1, 0>() == gvec4f(4.0f, 3.0f, 2.0f, 1.0f)), "reverse");
+	HTEST_ASSERT((v.swizzled<0, 0, 2, 2>() == gvec4f(1.0f, 1.0f, 3.0f, 3.0f)), "duplicate");
+	HTEST_ASSERT(v.xyz() == gvec3f(1.0f, 2.0f, 3.0f), "xyz");
+	HTEST_ASSERT(v.xy() == gvec2f(1.0f, 2.0f), "xy");
+}
+
+HTEST_CASE(project)
+{
+	gvec4f v(2.0f, 4.0f, 6.0f, 2.0f);
+	HTEST_ASSERT(v.project() == gvec3f(1.0f, 2.0f, 3.0f), "");
+}
+
+HTEST_CASE(matrix4)
+{
+	gmat4 m;
+	m.setTranslation(1.0f, 2.0f, 3.0f);
+	HTEST_ASSERT(m * gvec4f(1.0f, 1.0f, 1.0f, 1.0f) == gvec4f(2.0f, 3.0f, 4.0f, 1.0f), "point");
+	HTEST_ASSERT(m * gvec4f(1.0f, 1.0f, 1.0f, 0.0f) == gvec4f(1.0f, 1.0f, 1.0f, 0.0f), "direction");
+	m.setPerspective(90.0f, 1.0f, 1.0f, 10.0f);
+	gvec4f v = m * gvec4f(0.0f, 0.0f, -5.0f, 1.0f);
+	HTEST_ASSERT(heqf(v.w, 5.0f), "perspective");
+}
+
+HTEST_CASE(quaternion)
+{
+	gquat q(1.0f, 2.0f, 3.0f, 4.0f);
+	HTEST_ASSERT(q.vec4() == gvec4f(1.0f, 2.0f, 3.0f, 4.0f), "vec4()");
+	HTEST_ASSERT(gquat(q.vec4()) == q, "constructor");
+}
+
+HTEST_CASE(normalizeFast)
+{
+	gvec4f v(0.0f, 3.0f, 0.0f, 4.0f);
+	HTEST_ASSERT(vec4eqf(v.normalizedFast(), gvec4f(0.0f, 0.6f, 0.0f, 0.8f)), "normalizedFast()");
+	v.normalizeFast();
+	HTEST_ASSERT(vec4eqf(v, gvec4f(0.0f, 0.6f, 0.0f, 0.8f)), "normalizeFast()");
+}
+
+HTEST_SUITE_END